@@ -479,6 +479,7 @@ ezResult ezVisualScriptCompiler::Compile(ezStringView sDebugAstOutputPath)
 
     DumpAST(pEntryAstNode, sDebugAstOutputPath, function.m_sName, "_01_Replaced");
 
+    EZ_SUCCEED_OR_RETURN(FoldConstants(pEntryAstNode));
     EZ_SUCCEED_OR_RETURN(InlineConstants(pEntryAstNode));
     EZ_SUCCEED_OR_RETURN(InsertTypeConversions(pEntryAstNode));
     EZ_SUCCEED_OR_RETURN(InlineVariables(pEntryAstNode));
@@ -1217,6 +1218,103 @@ ezResult ezVisualScriptCompiler::InsertTypeConversions(AstNode* pEntryAstNode)
     });
 }
 
+ezResult ezVisualScriptCompiler::FoldConstants(AstNode* pEntryAstNode)
+{
+  auto EvaluateNode = [](const AstNode& node, ezArrayPtr<const ezVariant> inputs, ezVariant& out_result) -> bool
+  {
+    using NodeType = ezVisualScriptNodeDescription::Type;
+
+    switch (node.m_Type)
+    {
+      case NodeType::Builtin_And:
+        out_result = inputs[0].ConvertTo<bool>() && inputs[1].ConvertTo<bool>();
+        return true;
+      case NodeType::Builtin_Or:
+        out_result = inputs[0].ConvertTo<bool>() || inputs[1].ConvertTo<bool>();
+        return true;
+      case NodeType::Builtin_Not:
+        out_result = !inputs[0].ConvertTo<bool>();
+        return true;
+      default:
+        break;
+    }
+
+    // Arithmetic is only folded for plain numbers where ezVariant computes the same result as the runtime node
+    if (ezVisualScriptDataType::IsNumber(node.m_DeductedDataType) == false || node.m_DeductedDataType == ezVisualScriptDataType::Bool)
+      return false;
+
+    switch (node.m_Type)
+    {
+      case NodeType::Builtin_Add:
+        out_result = inputs[0] + inputs[1];
+        return true;
+      case NodeType::Builtin_Subtract:
+        out_result = inputs[0] - inputs[1];
+        return true;
+      case NodeType::Builtin_Multiply:
+        out_result = inputs[0] * inputs[1];
+        return true;
+      case NodeType::Builtin_Divide:
+        // Leave division by zero to the runtime so it behaves the same regardless of whether the inputs are constant
+        if (inputs[1].ConvertTo<double>() == 0.0)
+          return false;
+        out_result = inputs[0] / inputs[1];
+        return true;
+      default:
+        return false;
+    }
+  };
+
+  bool bFoldedAny = false;
+  do
+  {
+    bFoldedAny = false;
+
+    EZ_SUCCEED_OR_RETURN(TraverseAllConnections(pEntryAstNode,
+      [&](const Connection& connection)
+      {
+        AstNode* pNode = connection.m_pTarget;
+        if (pNode->m_bImplicitExecution == false || pNode->m_Inputs.IsEmpty() || pNode->m_Outputs.GetCount() != 1)
+          return VisitorResult::Continue;
+
+        ezHybridArray<ezVariant, 4> inputs;
+        for (auto& dataInput : pNode->m_Inputs)
+        {
+          auto pSourceNode = dataInput.m_pSourceNode;
+          if (pSourceNode == nullptr || pSourceNode->m_Type != ezVisualScriptNodeDescription::Type::Builtin_Constant || m_PinIdToDataDesc.Contains(dataInput.m_uiId))
+            return VisitorResult::Continue;
+
+          ezResult conversionResult = EZ_FAILURE;
+          inputs.PushBack(pSourceNode->m_Value.ConvertTo(ezVisualScriptDataType::GetVariantType(dataInput.m_DataType), &conversionResult));
+          if (conversionResult.Failed())
+            return VisitorResult::Continue;
+        }
+
+        ezVariant result;
+        if (EvaluateNode(*pNode, inputs, result) == false)
+          return VisitorResult::Continue;
+
+        auto& dataOutput = pNode->m_Outputs[0];
+        ezResult conversionResult = EZ_FAILURE;
+        result = result.ConvertTo(ezVisualScriptDataType::GetVariantType(dataOutput.m_DataType), &conversionResult);
+        if (conversionResult.Failed())
+          return VisitorResult::Continue;
+
+        // Turn the node into a constant, it is then inlined into the constant data like any other constant.
+        pNode->m_Type = ezVisualScriptNodeDescription::Type::Builtin_Constant;
+        pNode->m_DeductedDataType = dataOutput.m_DataType;
+        pNode->m_Value = result;
+        pNode->m_Inputs.Clear();
+
+        bFoldedAny = true;
+        return VisitorResult::Continue;
+      }));
+
+  } while (bFoldedAny);
+
+  return EZ_SUCCESS;
+}
+
 ezResult ezVisualScriptCompiler::InlineConstants(AstNode* pEntryAstNode)
 {
   return TraverseAllConnections(pEntryAstNode,
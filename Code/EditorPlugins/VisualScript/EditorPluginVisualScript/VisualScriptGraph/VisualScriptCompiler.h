@@ -137,6 +137,7 @@ private:
   ezResult ReplaceUnsupportedNodes(AstNode* pEntryAstNode);
   ezResult ReplaceLoop(Connection& connection);
   ezResult InsertTypeConversions(AstNode* pEntryAstNode);
+  ezResult FoldConstants(AstNode* pEntryAstNode);
   ezResult InlineConstants(AstNode* pEntryAstNode);
   ezResult InlineVariables(AstNode* pEntryAstNode);
   ezResult BuildDataStack(AstNode* pEntryAstNode, ezDynamicArray<AstNode*>& out_Stack);
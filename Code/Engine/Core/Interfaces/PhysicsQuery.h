@@ -37,6 +37,79 @@ struct ezPhysicsCastResultArray
   ezHybridArray<ezPhysicsCastResult, 16> m_Results;
 };
 
+/// \brief Describes a single ray for batched raycasts, see ezPhysicsWorldModuleInterface::RaycastBatch()
+struct ezPhysicsRay
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezVec3 m_vStart;
+  ezVec3 m_vDir; ///< Normalized ray direction
+  float m_fDistance;
+};
+
+/// \brief The shape that is used by batched sweep and overlap tests, see ezPhysicsWorldModuleInterface::SweepTestBatch()
+struct ezPhysicsQueryShape
+{
+  EZ_DECLARE_POD_TYPE();
+
+  enum class Type : ezUInt8
+  {
+    Sphere,
+    Box,
+    Capsule,
+  };
+
+  static ezPhysicsQueryShape MakeSphere(float fRadius)
+  {
+    ezPhysicsQueryShape shape;
+    shape.m_Type = Type::Sphere;
+    shape.m_fRadius = fRadius;
+    return shape;
+  }
+
+  static ezPhysicsQueryShape MakeBox(const ezVec3& vBoxExtents)
+  {
+    ezPhysicsQueryShape shape;
+    shape.m_Type = Type::Box;
+    shape.m_vBoxExtents = vBoxExtents;
+    return shape;
+  }
+
+  static ezPhysicsQueryShape MakeCapsule(float fRadius, float fHeight)
+  {
+    ezPhysicsQueryShape shape;
+    shape.m_Type = Type::Capsule;
+    shape.m_fRadius = fRadius;
+    shape.m_fCapsuleHeight = fHeight;
+    return shape;
+  }
+
+  Type m_Type = Type::Sphere;
+  float m_fRadius = 0.0f;        ///< Radius of spheres and capsules
+  float m_fCapsuleHeight = 0.0f; ///< Height of the cylindrical part of capsules
+  ezVec3 m_vBoxExtents;          ///< Full extents of boxes
+};
+
+/// \brief Describes a single shape sweep for batched sweep tests, see ezPhysicsWorldModuleInterface::SweepTestBatch()
+struct ezPhysicsSweep
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezPhysicsQueryShape m_Shape;
+  ezTransform m_Transform; ///< Start position and rotation of the shape. Spheres only use the position.
+  ezVec3 m_vDir;           ///< Normalized sweep direction
+  float m_fDistance;
+};
+
+/// \brief Describes a single overlap test for batched overlap tests, see ezPhysicsWorldModuleInterface::OverlapTestBatch()
+struct ezPhysicsOverlap
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezPhysicsQueryShape m_Shape;
+  ezTransform m_Transform; ///< Position and rotation of the shape. Spheres only use the position.
+};
+
 /// \brief Used to report overlap query results
 struct ezPhysicsOverlapResult
 {
@@ -89,5 +89,94 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMsgBuildStaticMesh, 1, ezRTTIDefaultAllocator<
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 // clang-format on
 
+ezUInt32 ezPhysicsWorldModuleInterface::RaycastBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsRay> rays, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection /*= ezPhysicsHitCollection::Closest*/) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() == rays.GetCount() && out_hits.GetCount() == rays.GetCount(), "Number of results ({}) and hits ({}) must match the number of rays ({})", out_results.GetCount(), out_hits.GetCount(), rays.GetCount());
+
+  ezUInt32 uiNumHits = 0;
+  for (ezUInt32 i = 0; i < rays.GetCount(); ++i)
+  {
+    const ezPhysicsRay& ray = rays[i];
+    out_hits[i] = Raycast(out_results[i], ray.m_vStart, ray.m_vDir, ray.m_fDistance, params, collection);
+    uiNumHits += out_hits[i] ? 1 : 0;
+  }
+
+  return uiNumHits;
+}
+
+ezUInt32 ezPhysicsWorldModuleInterface::SweepTestBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsSweep> sweeps, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection /*= ezPhysicsHitCollection::Closest*/) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() == sweeps.GetCount() && out_hits.GetCount() == sweeps.GetCount(), "Number of results ({}) and hits ({}) must match the number of sweeps ({})", out_results.GetCount(), out_hits.GetCount(), sweeps.GetCount());
+
+  ezUInt32 uiNumHits = 0;
+  for (ezUInt32 i = 0; i < sweeps.GetCount(); ++i)
+  {
+    const ezPhysicsSweep& sweep = sweeps[i];
+    const ezPhysicsQueryShape& shape = sweep.m_Shape;
+
+    switch (shape.m_Type)
+    {
+      case ezPhysicsQueryShape::Type::Sphere:
+        out_hits[i] = SweepTestSphere(out_results[i], shape.m_fRadius, sweep.m_Transform.m_vPosition, sweep.m_vDir, sweep.m_fDistance, params, collection);
+        break;
+
+      case ezPhysicsQueryShape::Type::Box:
+        out_hits[i] = SweepTestBox(out_results[i], shape.m_vBoxExtents, sweep.m_Transform, sweep.m_vDir, sweep.m_fDistance, params, collection);
+        break;
+
+      case ezPhysicsQueryShape::Type::Capsule:
+        out_hits[i] = SweepTestCapsule(out_results[i], shape.m_fRadius, shape.m_fCapsuleHeight, sweep.m_Transform, sweep.m_vDir, sweep.m_fDistance, params, collection);
+        break;
+
+        EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
+    }
+
+    uiNumHits += out_hits[i] ? 1 : 0;
+  }
+
+  return uiNumHits;
+}
+
+ezUInt32 ezPhysicsWorldModuleInterface::OverlapTestBatch(ezArrayPtr<bool> out_overlaps, ezArrayPtr<const ezPhysicsOverlap> overlaps, const ezPhysicsQueryParameters& params) const
+{
+  EZ_ASSERT_DEV(out_overlaps.GetCount() == overlaps.GetCount(), "Number of results ({}) must match the number of overlap tests ({})", out_overlaps.GetCount(), overlaps.GetCount());
+
+  ezUInt32 uiNumOverlaps = 0;
+  for (ezUInt32 i = 0; i < overlaps.GetCount(); ++i)
+  {
+    const ezPhysicsOverlap& overlap = overlaps[i];
+    const ezPhysicsQueryShape& shape = overlap.m_Shape;
+
+    switch (shape.m_Type)
+    {
+      case ezPhysicsQueryShape::Type::Sphere:
+        out_overlaps[i] = OverlapTestSphere(shape.m_fRadius, overlap.m_Transform.m_vPosition, params);
+        break;
+
+      case ezPhysicsQueryShape::Type::Capsule:
+        out_overlaps[i] = OverlapTestCapsule(shape.m_fRadius, shape.m_fCapsuleHeight, overlap.m_Transform, params);
+        break;
+
+      default:
+        EZ_REPORT_FAILURE("Box overlap tests are not supported by this physics integration.");
+        out_overlaps[i] = false;
+        break;
+    }
+
+    uiNumOverlaps += out_overlaps[i] ? 1 : 0;
+  }
+
+  return uiNumOverlaps;
+}
+
+void ezPhysicsWorldModuleInterface::QueryShapesInSphereBatch(ezArrayPtr<ezPhysicsOverlapResultArray> out_results, ezArrayPtr<const ezBoundingSphere> spheres, const ezPhysicsQueryParameters& params) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() == spheres.GetCount(), "Number of results ({}) must match the number of spheres ({})", out_results.GetCount(), spheres.GetCount());
+
+  for (ezUInt32 i = 0; i < spheres.GetCount(); ++i)
+  {
+    QueryShapesInSphere(out_results[i], spheres[i].m_fRadius, spheres[i].m_vCenter, params);
+  }
+}
 
 EZ_STATICLINK_FILE(Core, Core_Interfaces_PhysicsWorldModule);
@@ -29,6 +29,15 @@ public:
 
   virtual bool RaycastAll(ezPhysicsCastResultArray& out_results, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params) const = 0;
 
+  /// \brief Casts all given rays and reports the closest (or any) hit of each ray.
+  ///
+  /// out_results and out_hits must have the same number of elements as rays. out_hits[i] is set to true if rays[i] hit something,
+  /// in which case out_results[i] contains the hit information. Returns the number of rays that hit something.
+  ///
+  /// Physics integrations can implement this more efficiently than individual Raycast() calls, e.g. by sharing the broadphase work
+  /// between rays that are close to each other. The default implementation calls Raycast() for each ray.
+  virtual ezUInt32 RaycastBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsRay> rays, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const;
+
   virtual bool SweepTestSphere(ezPhysicsCastResult& out_result, float fSphereRadius, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const = 0;
 
   virtual bool SweepTestBox(ezPhysicsCastResult& out_result, ezVec3 vBoxExtends, const ezTransform& transform, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const = 0;
@@ -41,6 +50,23 @@ public:
 
   virtual void QueryShapesInSphere(ezPhysicsOverlapResultArray& out_results, float fSphereRadius, const ezVec3& vPosition, const ezPhysicsQueryParameters& params) const = 0;
 
+  /// \brief Sweeps all given shapes and reports the closest (or any) hit of each sweep.
+  ///
+  /// Works like RaycastBatch(): out_results and out_hits must have the same number of elements as sweeps and the number of sweeps that hit
+  /// something is returned. The default implementation calls SweepTestSphere(), SweepTestBox() or SweepTestCapsule() for each sweep.
+  virtual ezUInt32 SweepTestBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsSweep> sweeps, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const;
+
+  /// \brief Checks for each of the given shapes whether it overlaps with anything.
+  ///
+  /// out_overlaps must have the same number of elements as overlaps. Returns the number of shapes that overlap with something.
+  /// The default implementation calls OverlapTestSphere() or OverlapTestCapsule() for each shape, it doesn't support boxes.
+  virtual ezUInt32 OverlapTestBatch(ezArrayPtr<bool> out_overlaps, ezArrayPtr<const ezPhysicsOverlap> overlaps, const ezPhysicsQueryParameters& params) const;
+
+  /// \brief Reports all shapes that overlap with each of the given spheres.
+  ///
+  /// out_results must have the same number of elements as spheres. The default implementation calls QueryShapesInSphere() for each sphere.
+  virtual void QueryShapesInSphereBatch(ezArrayPtr<ezPhysicsOverlapResultArray> out_results, ezArrayPtr<const ezBoundingSphere> spheres, const ezPhysicsQueryParameters& params) const;
+
   virtual ezVec3 GetGravity() const = 0;
 
   //////////////////////////////////////////////////////////////////////////
@@ -8,10 +8,34 @@
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Profiling/Profiling.h>
 
+/// Reads the path prefix from a small buffer and the file content directly from the memory-mapped data directory.
+class MappedFileResourceStreamReader : public ezStreamReader
+{
+public:
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+  {
+    ezUInt8* pBuffer = static_cast<ezUInt8*>(pReadBuffer);
+
+    const ezUInt64 uiPrefixBytes = m_Prefix.ReadBytes(pBuffer, uiBytesToRead);
+    return uiPrefixBytes + m_Content.ReadBytes(pBuffer != nullptr ? pBuffer + uiPrefixBytes : nullptr, uiBytesToRead - uiPrefixBytes);
+  }
+
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override
+  {
+    const ezUInt64 uiPrefixBytes = m_Prefix.SkipBytes(uiBytesToSkip);
+    return uiPrefixBytes + m_Content.SkipBytes(uiBytesToSkip - uiPrefixBytes);
+  }
+
+  ezRawMemoryStreamReader m_Prefix;
+  ezRawMemoryStreamReader m_Content;
+};
+
 struct FileResourceLoadData
 {
+  ezFileReader m_File; // only kept open for mapped reads, the mapped memory is only guaranteed to stay valid while the file is open
   ezBlob m_Storage;
   ezRawMemoryStreamReader m_Reader;
+  MappedFileResourceStreamReader m_MappedReader;
 };
 
 ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pResource)
@@ -20,9 +44,14 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
   ezResourceLoadData res;
 
-  ezFileReader File;
+  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
+
+  ezFileReader& File = pData->m_File;
   if (File.Open(pResource->GetResourceID()).Failed())
+  {
+    EZ_DEFAULT_DELETE(pData);
     return res;
+  }
 
   res.m_sResourceDescription = File.GetFilePathRelative().GetData();
 
@@ -35,10 +64,33 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
 #endif
 
-  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
-
   const ezUInt64 uiFileSize = File.GetFileSize();
 
+  if (File.SupportsZeroCopyReads())
+  {
+    // the file content is available in mapped memory (uncompressed archive entry), only the path needs to be stored
+    // the file stays open until CloseDataStream(), so that the data directory can't release the mapped memory while it is read
+    const ezString128 sAbsolutePath = File.GetFilePathAbsolute();
+
+    const ezUInt64 uiPrefixCapacity = sAbsolutePath.GetElementCount() + 8; // +8 for the string overhead
+    pData->m_Storage.SetCountUninitialized(uiPrefixCapacity);
+
+    ezUInt8* pPrefixPtr = pData->m_Storage.GetBlobPtr<ezUInt8>().GetPtr();
+
+    ezRawMemoryStreamWriter w(pPrefixPtr, uiPrefixCapacity);
+    w << sAbsolutePath;
+
+    pData->m_MappedReader.m_Prefix.Reset(pPrefixPtr, w.GetNumWrittenBytes());
+
+    const ezConstByteArrayPtr content = File.ReadBytesZeroCopy(static_cast<ezUInt32>(uiFileSize));
+    pData->m_MappedReader.m_Content.Reset(content.GetPtr(), content.GetCount());
+
+    res.m_pDataStream = &pData->m_MappedReader;
+    res.m_pCustomLoaderData = pData;
+
+    return res;
+  }
+
   const ezUInt64 uiBlobCapacity = uiFileSize + File.GetFilePathAbsolute().GetElementCount() + 8; // +8 for the string overhead
   pData->m_Storage.SetCountUninitialized(uiBlobCapacity);
 
@@ -52,6 +104,7 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
   const ezUInt64 uiOffset = w.GetNumWrittenBytes();
 
   File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+  File.Close();
 
   pData->m_Reader.Reset(pBlobPtr, w.GetNumWrittenBytes() + uiFileSize);
   res.m_pDataStream = &pData->m_Reader;
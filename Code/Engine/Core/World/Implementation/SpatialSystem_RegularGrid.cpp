@@ -538,6 +538,50 @@ namespace ezInternal
       ezSpatialSystem::IsOccludedFunc m_IsOccludedCB;
     };
 
+    template <bool UseOcclusionCallback>
+    static void AddVisibleObjects(const ezSpatialSystem_RegularGrid::Cell& cell, const ezUInt32* pCandidates, ezUInt32 uiNumCandidates, ezUInt64 uiFrameIdxAndType, ezSpatialSystem_RegularGrid::Stats& ref_stats, FrustumQueryData* pQueryData)
+    {
+      if (uiNumCandidates == 0)
+        return;
+
+      auto boundingSpheres = cell.m_BoundingSpheres.GetData();
+      auto objectPointers = cell.m_ObjectPointers.GetData();
+      auto lastVisibleFrameIdxAndVisType = cell.m_LastVisibleFrameIdxAndVisType.GetData();
+
+      ezUInt32 uiOccludedMask = 0;
+
+      if constexpr (UseOcclusionCallback)
+      {
+        // test all candidates with one call, so that the occlusion test can project them together
+        auto boundingBoxHalfExtents = cell.m_BoundingBoxHalfExtents.GetData();
+
+        ezSimdBBox boxes[32];
+        for (ezUInt32 c = 0; c < uiNumCandidates; ++c)
+        {
+          const ezUInt32 i = pCandidates[c];
+          boxes[c] = ezSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
+        }
+
+        uiOccludedMask = pQueryData->m_IsOccludedCB(ezArrayPtr<const ezSimdBBox>(boxes, uiNumCandidates));
+      }
+
+      for (ezUInt32 c = 0; c < uiNumCandidates; ++c)
+      {
+        if constexpr (UseOcclusionCallback)
+        {
+          if ((uiOccludedMask & (1u << c)) != 0)
+            continue;
+        }
+
+        const ezUInt32 i = pCandidates[c];
+
+        lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
+        pQueryData->m_pOutObjects->PushBack(objectPointers[i]);
+
+        ref_stats.m_uiNumObjectsPassed++;
+      }
+    }
+
     template <bool UseTagsFilter, bool UseOcclusionCallback>
     static ezVisitorExecution::Enum FrustumQueryCallback(const ezSpatialSystem_RegularGrid::Cell& cell, const ezSpatialSystem::QueryParams& queryParams, ezSpatialSystem_RegularGrid::Stats& ref_stats, void* pUserData, ezVisibilityState visType)
     {
@@ -550,17 +594,15 @@ namespace ezInternal
 
       if constexpr (UseOcclusionCallback)
       {
-        if (pQueryData->m_IsOccludedCB(cell.m_Bounds.GetBox()))
+        const ezSimdBBox cellBox = cell.m_Bounds.GetBox();
+        if (pQueryData->m_IsOccludedCB(ezArrayPtr<const ezSimdBBox>(&cellBox, 1)) != 0)
         {
           return ezVisitorExecution::Continue;
         }
       }
 
       auto boundingSpheres = cell.m_BoundingSpheres.GetData();
-      auto boundingBoxHalfExtents = cell.m_BoundingBoxHalfExtents.GetData();
       auto tagSets = cell.m_TagSets.GetData();
-      auto objectPointers = cell.m_ObjectPointers.GetData();
-      auto lastVisibleFrameIdxAndVisType = cell.m_LastVisibleFrameIdxAndVisType.GetData();
 
       const ezUInt32 numSpheres = cell.m_BoundingSpheres.GetCount();
       ref_stats.m_uiNumObjectsTested += numSpheres;
@@ -568,6 +610,10 @@ namespace ezInternal
       ezUInt32 currentIndex = 0;
       const ezUInt64 uiFrameIdxAndType = (pQueryData->m_uiFrameCounter << 4) | static_cast<ezUInt64>(visType);
 
+      // objects that passed the frustum and tag tests, these are then tested for occlusion in one batch
+      ezUInt32 candidates[32];
+      ezUInt32 uiNumCandidates = 0;
+
       while (currentIndex < numSpheres)
       {
         if (numSpheres - currentIndex >= 32)
@@ -582,6 +628,8 @@ namespace ezInternal
             mask |= SphereFrustumIntersect(objectSphereA, objectSphereB, planeData) << i;
           }
 
+          uiNumCandidates = 0;
+
           while (mask > 0)
           {
             ezUInt32 i = ezMath::FirstBitLow(mask) + currentIndex;
@@ -596,54 +644,38 @@ namespace ezInternal
               }
             }
 
-            if constexpr (UseOcclusionCallback)
-            {
-              const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
-              if (pQueryData->m_IsOccludedCB(bbox))
-              {
-                continue;
-              }
-            }
-
-            lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
-            pQueryData->m_pOutObjects->PushBack(objectPointers[i]);
-
-            ref_stats.m_uiNumObjectsPassed++;
+            candidates[uiNumCandidates++] = i;
           }
 
+          AddVisibleObjects<UseOcclusionCallback>(cell, candidates, uiNumCandidates, uiFrameIdxAndType, ref_stats, pQueryData);
+
           currentIndex += 32;
         }
         else
         {
-          ezUInt32 i = currentIndex;
-          ++currentIndex;
-
-          if (!SphereFrustumIntersect(boundingSpheres[i], planeData))
-            continue;
+          // less than 32 objects are left, so they all fit into one batch
+          uiNumCandidates = 0;
 
-          if constexpr (UseTagsFilter)
+          for (ezUInt32 i = currentIndex; i < numSpheres; ++i)
           {
-            if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
-            {
-              ref_stats.m_uiNumObjectsFiltered++;
+            if (!SphereFrustumIntersect(boundingSpheres[i], planeData))
               continue;
-            }
-          }
 
-          if constexpr (UseOcclusionCallback)
-          {
-            const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
-
-            if (pQueryData->m_IsOccludedCB(bbox))
+            if constexpr (UseTagsFilter)
             {
-              continue;
+              if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+              {
+                ref_stats.m_uiNumObjectsFiltered++;
+                continue;
+              }
             }
+
+            candidates[uiNumCandidates++] = i;
           }
 
-          lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
-          pQueryData->m_pOutObjects->PushBack(objectPointers[i]);
+          AddVisibleObjects<UseOcclusionCallback>(cell, candidates, uiNumCandidates, uiFrameIdxAndType, ref_stats, pQueryData);
 
-          ref_stats.m_uiNumObjectsPassed++;
+          currentIndex = numSpheres;
         }
       }
 
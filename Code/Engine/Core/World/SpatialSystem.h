@@ -63,7 +63,8 @@ public:
   /// \name Visibility Queries
   ///@{
 
-  using IsOccludedFunc = ezDelegate<bool(const ezSimdBBox&)>;
+  /// \brief Tests a batch of at most 32 bounding boxes for occlusion. Returns a bit mask in which bit i is set if boxes[i] is occluded.
+  using IsOccludedFunc = ezDelegate<ezUInt32(ezArrayPtr<const ezSimdBBox> boxes)>;
 
   virtual void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_objects, IsOccludedFunc isOccluded, ezVisibilityState visType) const = 0;
 
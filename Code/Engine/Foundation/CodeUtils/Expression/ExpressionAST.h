@@ -86,6 +86,8 @@ public:
       Lerp,
       SmoothStep,
       SmootherStep,
+      MultiplyAdd,
+      MultiplySubtract,
       LastTernary,
 
       Constant,
@@ -286,6 +288,7 @@ public:
   Node* ReplaceUnsupportedInstructions(Node* pNode);
   Node* FoldConstants(Node* pNode);
   Node* CommonSubexpressionElimination(Node* pNode);
+  Node* FuseInstructions(Node* pNode);
   Node* Validate(Node* pNode);
 
   ezResult ScalarizeInputs();
@@ -47,6 +47,8 @@ public:
       IToF_R,
       FToI_R,
 
+      SatF_R,
+
       LastUnary,
 
       FirstBinary,
@@ -157,6 +159,10 @@ public:
       SelI_RRR,
       SelB_RRR,
 
+      MulAddF_RRR,
+      MulSubF_RRR,
+      LerpF_RRR,
+
       LastTernary,
 
       FirstSpecial,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/CodeUtils/Expression/ExpressionByteCode.h>
+#include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/UniquePtr.h>
 
 class EZ_FOUNDATION_DLL ezExpressionVM
@@ -20,6 +21,7 @@ public:
     {
       MapStreamsByName = EZ_BIT(0),
       ScalarizeStreams = EZ_BIT(1),
+      DisableAvx2 = EZ_BIT(2), ///< Always use the Simd4 implementation, even if the CPU supports AVX2. Mainly useful for testing.
 
       UserFriendly = MapStreamsByName | ScalarizeStreams,
       BestPerformance = 0,
@@ -31,12 +33,23 @@ public:
     {
       StorageType MapStreamsByName : 1;
       StorageType ScalarizeStreams : 1;
+      StorageType DisableAvx2 : 1;
     };
   };
 
   ezResult Execute(const ezExpressionByteCode& byteCode, ezArrayPtr<const ezProcessingStream> inputs, ezArrayPtr<ezProcessingStream> outputs, ezUInt32 uiNumInstances, const ezExpression::GlobalData& globalData = ezExpression::GlobalData(), ezBitflags<Flags> flags = Flags::Default);
 
+  /// \brief Same as Execute but splits the instances into chunks that are processed in parallel by the ezTaskSystem.
+  ///
+  /// Each task takes its register scratch memory from a pool of the VM and returns it afterwards, so the memory is reused across tasks and calls.
+  /// The pool is protected by a mutex and no other state of the VM is modified, so it is safe to call this function from multiple threads at the same time. However, all functions referenced by the byte code must be thread-safe
+  /// and functions must not be registered or unregistered while an execution is in flight.
+  /// If uiNumInstances is smaller than uiMinInstancesPerTask, all instances are executed on the calling thread.
+  ezResult ExecuteParallel(const ezExpressionByteCode& byteCode, ezArrayPtr<const ezProcessingStream> inputs, ezArrayPtr<ezProcessingStream> outputs, ezUInt32 uiNumInstances, const ezExpression::GlobalData& globalData = ezExpression::GlobalData(), ezBitflags<Flags> flags = Flags::Default, ezUInt32 uiMinInstancesPerTask = 1024) const;
+
 private:
+  using RegisterArray = ezDynamicArray<ezExpression::Register, ezAlignedAllocatorWrapper>;
+
   void RegisterDefaultFunctions();
 
   static ezResult ScalarizeStreams(ezArrayPtr<const ezProcessingStream> streams, ezDynamicArray<ezProcessingStream>& out_ScalarizedStreams);
@@ -45,9 +58,17 @@ private:
 
   template <typename T>
   static ezResult MapStreams(ezArrayPtr<const ezExpression::StreamDesc> streamDescs, ezArrayPtr<T> streams, ezStringView sStreamType, ezUInt32 uiNumInstances, ezBitflags<Flags> flags, ezDynamicArray<T*>& out_MappedStreams);
-  ezResult MapFunctions(ezArrayPtr<const ezExpression::FunctionDesc> functionDescs, const ezExpression::GlobalData& globalData);
+  ezResult MapFunctions(ezArrayPtr<const ezExpression::FunctionDesc> functionDescs, const ezExpression::GlobalData& globalData, ezDynamicArray<const ezExpressionFunction*>& out_MappedFunctions) const;
+
+  static ezResult ExecuteInstances(const ezExpressionByteCode& byteCode, ezArrayPtr<const ezProcessingStream*> inputs, ezArrayPtr<ezProcessingStream*> outputs, ezArrayPtr<const ezExpressionFunction*> functions, ezUInt32 uiNumInstances, const ezExpression::GlobalData& globalData, ezBitflags<Flags> flags, RegisterArray& ref_registers);
 
-  ezDynamicArray<ezExpression::Register, ezAlignedAllocatorWrapper> m_Registers;
+  ezUniquePtr<RegisterArray> AcquireRegisters() const;
+  void ReleaseRegisters(ezUniquePtr<RegisterArray>&& pRegisters) const;
+
+  RegisterArray m_Registers;
+
+  mutable ezMutex m_RegisterPoolMutex;
+  mutable ezDynamicArray<ezUniquePtr<RegisterArray>> m_RegisterPool; ///< Register arrays of ExecuteParallel() that are currently not used by any task.
 
   ezDynamicArray<ezProcessingStream> m_ScalarizedInputs;
   ezDynamicArray<ezProcessingStream> m_ScalarizedOutputs;
@@ -59,3 +80,5 @@ private:
   ezDynamicArray<ezExpressionFunction> m_Functions;
   ezHashTable<ezHashedString, ezUInt32> m_FunctionNamesToIndex;
 };
+
+EZ_DECLARE_FLAGS_OPERATORS(ezExpressionVM::Flags);
@@ -150,6 +150,8 @@ namespace
     "Lerp",
     "SmoothStep",
     "SmootherStep",
+    "MultiplyAdd",
+    "MultiplySubtract",
     "",
 
     "Constant",
@@ -266,6 +268,8 @@ namespace
     {SIG3(Float, Float, Float, Float)},                                                         // Lerp,
     {SIG3(Float, Float, Float, Float)},                                                         // SmoothStep,
     {SIG3(Float, Float, Float, Float)},                                                         // SmootherStep,
+    {SIG3(Float, Float, Float, Float)},                                                         // MultiplyAdd,
+    {SIG3(Float, Float, Float, Float)},                                                         // MultiplySubtract,
     {},                                                                                         // LastTernary,
 
     {},                                                                                         // Constant,
@@ -924,6 +924,11 @@ ezExpressionAST::Node* ezExpressionAST::FoldConstants(Node* pNode)
       // Nothing to do here since these nodes will be replaced at a later step anyways
       return pNode;
     }
+    else if (nodeType == NodeType::MultiplyAdd || nodeType == NodeType::MultiplySubtract)
+    {
+      // Fused nodes are only created after constant folding so there is nothing left to fold here
+      return pNode;
+    }
     else if (nodeType == NodeType::Select)
     {
       if (NodeType::IsConstant(pTernaryNode->m_pFirstOperand->m_Type))
@@ -961,6 +966,103 @@ ezExpressionAST::Node* ezExpressionAST::CommonSubexpressionElimination(Node* pNo
   return pNode;
 }
 
+ezExpressionAST::Node* ezExpressionAST::FuseInstructions(Node* pNode)
+{
+  const NodeType::Enum nodeType = pNode->m_Type;
+  if (NodeType::IsBinary(nodeType) == false || pNode->m_ReturnType != DataType::Float)
+    return pNode;
+
+  auto pBinaryNode = static_cast<const BinaryOperator*>(pNode);
+  auto pLeftOperand = pBinaryNode->m_pLeftOperand;
+  auto pRightOperand = pBinaryNode->m_pRightOperand;
+
+  auto IsConstantValue = [](const Node* pOperand, float fValue)
+  {
+    return NodeType::IsConstant(pOperand->m_Type) && static_cast<const Constant*>(pOperand)->m_Value.Get<float>() == fValue;
+  };
+
+  // Saturate and clamp(x, 0, 1) are lowered to max(0, min(1, x)), turn that back into a single saturate instruction.
+  if (nodeType == NodeType::Max || nodeType == NodeType::Min)
+  {
+    const NodeType::Enum innerType = nodeType == NodeType::Max ? NodeType::Min : NodeType::Max;
+    const float fOuterValue = nodeType == NodeType::Max ? 0.0f : 1.0f;
+    const float fInnerValue = nodeType == NodeType::Max ? 1.0f : 0.0f;
+
+    Node* pInner = IsConstantValue(pLeftOperand, fOuterValue) ? pRightOperand : (IsConstantValue(pRightOperand, fOuterValue) ? pLeftOperand : nullptr);
+    if (pInner != nullptr && pInner->m_Type == innerType)
+    {
+      auto pInnerNode = static_cast<const BinaryOperator*>(pInner);
+      Node* pValue = IsConstantValue(pInnerNode->m_pLeftOperand, fInnerValue) ? pInnerNode->m_pRightOperand : (IsConstantValue(pInnerNode->m_pRightOperand, fInnerValue) ? pInnerNode->m_pLeftOperand : nullptr);
+      if (pValue != nullptr && NodeType::IsConstant(pValue->m_Type) == false)
+      {
+        return CreateUnaryOperator(NodeType::Saturate, pValue);
+      }
+    }
+
+    return pNode;
+  }
+
+  if (nodeType != NodeType::Add && nodeType != NodeType::Subtract)
+    return pNode;
+
+  // Only fuse multiplications with register operands. A constant operand would need an extra mov instruction
+  // and would thus be slower than the separate mul and add instructions that take the constant in place.
+  auto IsFusableMultiply = [](const Node* pOperand)
+  {
+    if (pOperand->m_Type != NodeType::Multiply || pOperand->m_ReturnType != DataType::Float)
+      return false;
+
+    auto pMultiply = static_cast<const BinaryOperator*>(pOperand);
+    return NodeType::IsConstant(pMultiply->m_pLeftOperand->m_Type) == false && NodeType::IsConstant(pMultiply->m_pRightOperand->m_Type) == false;
+  };
+
+  // Lerp is lowered to a + s * (b - a), which would otherwise end up as a sub and a multiply add.
+  auto TryFuseLerp = [&](Node* pA, Node* pMultiplyNode) -> Node*
+  {
+    auto pMultiply = static_cast<const BinaryOperator*>(pMultiplyNode);
+    for (ezUInt32 i = 0; i < 2; ++i)
+    {
+      Node* pSub = i == 0 ? pMultiply->m_pLeftOperand : pMultiply->m_pRightOperand;
+      Node* pS = i == 0 ? pMultiply->m_pRightOperand : pMultiply->m_pLeftOperand;
+      if (pSub->m_Type != NodeType::Subtract || pSub->m_ReturnType != DataType::Float)
+        continue;
+
+      auto pSubNode = static_cast<const BinaryOperator*>(pSub);
+      if (pSubNode->m_pRightOperand == pA && NodeType::IsConstant(pSubNode->m_pLeftOperand->m_Type) == false)
+      {
+        return CreateTernaryOperator(NodeType::Lerp, pA, pSubNode->m_pLeftOperand, pS);
+      }
+    }
+    return nullptr;
+  };
+
+  // a * b + c or a * b - c
+  if (IsFusableMultiply(pLeftOperand) && NodeType::IsConstant(pRightOperand->m_Type) == false)
+  {
+    if (nodeType == NodeType::Add)
+    {
+      if (Node* pLerp = TryFuseLerp(pRightOperand, pLeftOperand))
+        return pLerp;
+    }
+
+    auto pMultiply = static_cast<const BinaryOperator*>(pLeftOperand);
+    const NodeType::Enum fusedType = nodeType == NodeType::Add ? NodeType::MultiplyAdd : NodeType::MultiplySubtract;
+    return CreateTernaryOperator(fusedType, pMultiply->m_pLeftOperand, pMultiply->m_pRightOperand, pRightOperand);
+  }
+
+  // c + a * b
+  if (nodeType == NodeType::Add && IsFusableMultiply(pRightOperand) && NodeType::IsConstant(pLeftOperand->m_Type) == false)
+  {
+    if (Node* pLerp = TryFuseLerp(pLeftOperand, pRightOperand))
+      return pLerp;
+
+    auto pMultiply = static_cast<const BinaryOperator*>(pRightOperand);
+    return CreateTernaryOperator(NodeType::MultiplyAdd, pMultiply->m_pLeftOperand, pMultiply->m_pRightOperand, pLeftOperand);
+  }
+
+  return pNode;
+}
+
 ezExpressionAST::Node* ezExpressionAST::Validate(Node* pNode)
 {
   const NodeType::Enum nodeType = pNode->m_Type;
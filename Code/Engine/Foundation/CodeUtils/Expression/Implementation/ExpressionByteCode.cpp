@@ -42,6 +42,8 @@ namespace
     "IToF_R",
     "FToI_R",
 
+    "SatF_R",
+
     "",
     "",
 
@@ -149,6 +151,10 @@ namespace
     "SelI_RRR",
     "SelB_RRR",
 
+    "MulAddF_RRR",
+    "MulSubF_RRR",
+    "LerpF_RRR",
+
     "",
     "",
 
@@ -390,7 +396,7 @@ void ezExpressionByteCode::Disassemble(ezStringBuilder& out_sDisassembly) const
   }
 }
 
-static constexpr ezTypeVersion s_uiByteCodeVersion = 6;
+static constexpr ezTypeVersion s_uiByteCodeVersion = 8;
 
 ezResult ezExpressionByteCode::Save(ezStreamWriter& inout_stream) const
 {
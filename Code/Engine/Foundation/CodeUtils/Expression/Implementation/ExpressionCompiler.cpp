@@ -65,6 +65,9 @@ namespace
       case ezExpressionAST::NodeType::TypeConversion:
         return bFloat ? ezExpressionByteCode::OpCode::IToF_R : ezExpressionByteCode::OpCode::FToI_R;
 
+      case ezExpressionAST::NodeType::Saturate:
+        return ezExpressionByteCode::OpCode::SatF_R;
+
       case ezExpressionAST::NodeType::Add:
         return ADD_OFFSET(bFloat ? ezExpressionByteCode::OpCode::AddF_RR : ezExpressionByteCode::OpCode::AddI_RR);
       case ezExpressionAST::NodeType::Subtract:
@@ -125,6 +128,13 @@ namespace
         else
           return ezExpressionByteCode::OpCode::SelB_RRR;
 
+      case ezExpressionAST::NodeType::MultiplyAdd:
+        return ezExpressionByteCode::OpCode::MulAddF_RRR;
+      case ezExpressionAST::NodeType::MultiplySubtract:
+        return ezExpressionByteCode::OpCode::MulSubF_RRR;
+      case ezExpressionAST::NodeType::Lerp:
+        return ezExpressionByteCode::OpCode::LerpF_RRR;
+
       case ezExpressionAST::NodeType::Constant:
         return ezExpressionByteCode::OpCode::MovX_C;
       case ezExpressionAST::NodeType::Input:
@@ -187,8 +197,11 @@ ezResult ezExpressionCompiler::TransformAndOptimizeAST(ezExpressionAST& ast, ezS
   DumpAST(ast, sDebugAstOutputPath, "_06_ConstantFolded2");
 
   EZ_SUCCEED_OR_RETURN(TransformASTPostOrder(ast, ezMakeDelegate(&ezExpressionAST::CommonSubexpressionElimination, &ast)));
+  DumpAST(ast, sDebugAstOutputPath, "_07_CSE");
+
+  EZ_SUCCEED_OR_RETURN(TransformASTPostOrder(ast, ezMakeDelegate(&ezExpressionAST::FuseInstructions, &ast)));
   EZ_SUCCEED_OR_RETURN(TransformASTPreOrder(ast, ezMakeDelegate(&ezExpressionAST::Validate, &ast)));
-  DumpAST(ast, sDebugAstOutputPath, "_07_Optimized");
+  DumpAST(ast, sDebugAstOutputPath, "_08_Optimized");
 
   return EZ_SUCCESS;
 }
@@ -4,7 +4,9 @@
 #include <Foundation/CodeUtils/Expression/ExpressionByteCode.h>
 #include <Foundation/CodeUtils/Expression/ExpressionVM.h>
 #include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperations.h>
+#include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperationsAVX2.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 ezExpressionVM::ezExpressionVM()
 {
@@ -57,29 +59,168 @@ ezResult ezExpressionVM::Execute(const ezExpressionByteCode& byteCode, ezArrayPt
   EZ_SUCCEED_OR_RETURN(MapStreams(byteCode.GetInputs(), inputs, "Input", uiNumInstances, flags, m_MappedInputs));
   EZ_SUCCEED_OR_RETURN(MapStreams(byteCode.GetOutputs(), outputs, "Output", uiNumInstances, flags, m_MappedOutputs));
 
-  EZ_SUCCEED_OR_RETURN(MapFunctions(byteCode.GetFunctions(), globalData));
+  EZ_SUCCEED_OR_RETURN(MapFunctions(byteCode.GetFunctions(), globalData, m_MappedFunctions));
 
-  const ezUInt32 uiTotalNumRegisters = byteCode.GetNumTempRegisters() * ((uiNumInstances + 3) / 4);
-  m_Registers.SetCountUninitialized(uiTotalNumRegisters);
+  return ExecuteInstances(byteCode, m_MappedInputs, m_MappedOutputs, m_MappedFunctions, uiNumInstances, globalData, flags, m_Registers);
+}
+
+namespace
+{
+  template <typename T>
+  void MakeSubStreams(ezArrayPtr<T*> streams, ezUInt32 uiFirstInstance, ezUInt32 uiNumInstances, ezDynamicArray<ezProcessingStream>& out_SubStreams)
+  {
+    out_SubStreams.Clear();
+    out_SubStreams.Reserve(streams.GetCount());
+
+    for (auto pStream : streams)
+    {
+      const ezUInt64 uiStride = pStream->GetElementStride();
+      const ezUInt64 uiOffset = uiStride * uiFirstInstance;
+      const ezUInt64 uiSize = uiStride * (uiNumInstances - 1) + pStream->GetElementSize();
+
+      ezUInt8* pData = static_cast<ezUInt8*>(const_cast<void*>(pStream->GetData())) + uiOffset;
+      out_SubStreams.PushBack(ezProcessingStream(pStream->GetName(), ezMakeArrayPtr(pData, static_cast<ezUInt32>(uiSize)), pStream->GetDataType(), pStream->GetElementStride()));
+    }
+  }
+
+  struct ParallelExecutionData
+  {
+    const ezExpressionByteCode* m_pByteCode = nullptr;
+    ezArrayPtr<const ezProcessingStream*> m_Inputs;
+    ezArrayPtr<ezProcessingStream*> m_Outputs;
+    ezArrayPtr<const ezExpressionFunction*> m_Functions;
+    ezUInt32 m_uiNumInstances = 0;
+    const ezExpression::GlobalData* m_pGlobalData = nullptr;
+    ezBitflags<ezExpressionVM::Flags> m_Flags;
+    ezAtomicBool m_bFailed;
+  };
+
+  // Chunks start at multiples of this so only the very last chunk has to deal with remainder instances.
+  constexpr ezUInt32 s_uiInstancesPerBlock = 8;
+} // namespace
+
+ezResult ezExpressionVM::ExecuteParallel(const ezExpressionByteCode& byteCode, ezArrayPtr<const ezProcessingStream> inputs,
+  ezArrayPtr<ezProcessingStream> outputs, ezUInt32 uiNumInstances, const ezExpression::GlobalData& globalData, ezBitflags<Flags> flags, ezUInt32 uiMinInstancesPerTask) const
+{
+  ezHybridArray<ezProcessingStream, 16> scalarizedInputs;
+  ezHybridArray<ezProcessingStream, 16> scalarizedOutputs;
+
+  if (flags.IsSet(Flags::ScalarizeStreams))
+  {
+    EZ_SUCCEED_OR_RETURN(ScalarizeStreams(inputs, scalarizedInputs));
+    EZ_SUCCEED_OR_RETURN(ScalarizeStreams(outputs, scalarizedOutputs));
+
+    inputs = scalarizedInputs;
+    outputs = scalarizedOutputs;
+  }
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  else
+  {
+    AreStreamsScalarized(inputs).AssertSuccess("Input streams are not scalarized");
+    AreStreamsScalarized(outputs).AssertSuccess("Output streams are not scalarized");
+  }
+#endif
+
+  ezHybridArray<const ezProcessingStream*, 16> mappedInputs;
+  ezHybridArray<ezProcessingStream*, 16> mappedOutputs;
+  ezHybridArray<const ezExpressionFunction*, 16> mappedFunctions;
+
+  EZ_SUCCEED_OR_RETURN(MapStreams(byteCode.GetInputs(), inputs, "Input", uiNumInstances, flags, mappedInputs));
+  EZ_SUCCEED_OR_RETURN(MapStreams(byteCode.GetOutputs(), outputs, "Output", uiNumInstances, flags, mappedOutputs));
+
+  EZ_SUCCEED_OR_RETURN(MapFunctions(byteCode.GetFunctions(), globalData, mappedFunctions));
+
+  if (uiNumInstances == 0)
+    return EZ_SUCCESS;
+
+  ParallelExecutionData data;
+  data.m_pByteCode = &byteCode;
+  data.m_Inputs = mappedInputs;
+  data.m_Outputs = mappedOutputs;
+  data.m_Functions = mappedFunctions;
+  data.m_uiNumInstances = uiNumInstances;
+  data.m_pGlobalData = &globalData;
+  data.m_Flags = flags;
+
+  const ezUInt32 uiNumBlocks = (uiNumInstances + s_uiInstancesPerBlock - 1) / s_uiInstancesPerBlock;
+
+  ezParallelForParams params;
+  params.m_uiBinSize = ezMath::Max(uiMinInstancesPerTask / s_uiInstancesPerBlock, 1u);
+
+  ezTaskSystem::ParallelForIndexed(
+    0, uiNumBlocks, [this, pData = &data](ezUInt32 uiStartBlock, ezUInt32 uiEndBlock) {
+      const ezUInt32 uiFirstInstance = uiStartBlock * s_uiInstancesPerBlock;
+      const ezUInt32 uiNumTaskInstances = ezMath::Min(uiEndBlock * s_uiInstancesPerBlock, pData->m_uiNumInstances) - uiFirstInstance;
+
+      ezHybridArray<ezProcessingStream, 16> subInputs;
+      ezHybridArray<ezProcessingStream, 16> subOutputs;
+      MakeSubStreams(pData->m_Inputs, uiFirstInstance, uiNumTaskInstances, subInputs);
+      MakeSubStreams(pData->m_Outputs, uiFirstInstance, uiNumTaskInstances, subOutputs);
+
+      ezHybridArray<const ezProcessingStream*, 16> subInputPtrs;
+      for (auto& subInput : subInputs)
+      {
+        subInputPtrs.PushBack(&subInput);
+      }
+
+      ezHybridArray<ezProcessingStream*, 16> subOutputPtrs;
+      for (auto& subOutput : subOutputs)
+      {
+        subOutputPtrs.PushBack(&subOutput);
+      }
+
+      // per task register scratch memory
+      ezUniquePtr<RegisterArray> pRegisters = AcquireRegisters();
+
+      if (ExecuteInstances(*pData->m_pByteCode, subInputPtrs, subOutputPtrs, pData->m_Functions, uiNumTaskInstances, *pData->m_pGlobalData, pData->m_Flags, *pRegisters).Failed())
+      {
+        pData->m_bFailed = true;
+      }
+
+      ReleaseRegisters(std::move(pRegisters));
+    },
+    "ExpressionVM::ExecuteParallel", ezTaskNesting::Never, params);
+
+  return data.m_bFailed ? EZ_FAILURE : EZ_SUCCESS;
+}
+
+ezResult ezExpressionVM::ExecuteInstances(const ezExpressionByteCode& byteCode, ezArrayPtr<const ezProcessingStream*> inputs, ezArrayPtr<ezProcessingStream*> outputs,
+  ezArrayPtr<const ezExpressionFunction*> functions, ezUInt32 uiNumInstances, const ezExpression::GlobalData& globalData, ezBitflags<Flags> flags, RegisterArray& ref_registers)
+{
+  const ezUInt32 uiNumSimd4Instances = (uiNumInstances + 3) / 4;
+
+  const OpFunc* pFuncs = s_Simd4Funcs;
+  ezUInt32 uiRegisterStride = uiNumSimd4Instances;
+#if EZ_ENABLED(EZ_EXPRESSIONVM_AVX2_SUPPORT)
+  if (IsAvx2Available() && !flags.IsSet(Flags::DisableAvx2))
+  {
+    pFuncs = s_Avx2Funcs;
+    uiRegisterStride = GetAvx2RegisterStride(uiNumSimd4Instances);
+  }
+#endif
+
+  const ezUInt32 uiTotalNumRegisters = byteCode.GetNumTempRegisters() * uiRegisterStride;
+  ref_registers.SetCountUninitialized(uiTotalNumRegisters);
 
   // Execute bytecode
   const ezExpressionByteCode::StorageType* pByteCode = byteCode.GetByteCodeStart();
   const ezExpressionByteCode::StorageType* pByteCodeEnd = byteCode.GetByteCodeEnd();
 
   ExecutionContext context;
-  context.m_pRegisters = m_Registers.GetData();
+  context.m_pRegisters = ref_registers.GetData();
   context.m_uiNumInstances = uiNumInstances;
-  context.m_uiNumSimd4Instances = (uiNumInstances + 3) / 4;
-  context.m_Inputs = m_MappedInputs;
-  context.m_Outputs = m_MappedOutputs;
-  context.m_Functions = m_MappedFunctions;
+  context.m_uiNumSimd4Instances = uiNumSimd4Instances;
+  context.m_uiRegisterStride = uiRegisterStride;
+  context.m_Inputs = inputs;
+  context.m_Outputs = outputs;
+  context.m_Functions = functions;
   context.m_pGlobalData = &globalData;
 
   while (pByteCode < pByteCodeEnd)
   {
     ezExpressionByteCode::OpCode::Enum opCode = ezExpressionByteCode::GetOpCode(pByteCode);
 
-    OpFunc func = s_Simd4Funcs[opCode];
+    OpFunc func = pFuncs[opCode];
     if (func != nullptr)
     {
       func(pByteCode, context);
@@ -95,6 +236,27 @@ ezResult ezExpressionVM::Execute(const ezExpressionByteCode& byteCode, ezArrayPt
   return EZ_SUCCESS;
 }
 
+ezUniquePtr<ezExpressionVM::RegisterArray> ezExpressionVM::AcquireRegisters() const
+{
+  EZ_LOCK(m_RegisterPoolMutex);
+
+  if (m_RegisterPool.IsEmpty())
+  {
+    return EZ_DEFAULT_NEW(RegisterArray);
+  }
+
+  ezUniquePtr<RegisterArray> pRegisters = std::move(m_RegisterPool.PeekBack());
+  m_RegisterPool.PopBack();
+  return pRegisters;
+}
+
+void ezExpressionVM::ReleaseRegisters(ezUniquePtr<RegisterArray>&& pRegisters) const
+{
+  EZ_LOCK(m_RegisterPoolMutex);
+
+  m_RegisterPool.PushBack(std::move(pRegisters));
+}
+
 void ezExpressionVM::RegisterDefaultFunctions()
 {
   RegisterFunction(ezDefaultExpressionFunctions::s_RandomFunc);
@@ -224,10 +386,10 @@ ezResult ezExpressionVM::MapStreams(ezArrayPtr<const ezExpression::StreamDesc> s
   return EZ_SUCCESS;
 }
 
-ezResult ezExpressionVM::MapFunctions(ezArrayPtr<const ezExpression::FunctionDesc> functionDescs, const ezExpression::GlobalData& globalData)
+ezResult ezExpressionVM::MapFunctions(ezArrayPtr<const ezExpression::FunctionDesc> functionDescs, const ezExpression::GlobalData& globalData, ezDynamicArray<const ezExpressionFunction*>& out_MappedFunctions) const
 {
-  m_MappedFunctions.Clear();
-  m_MappedFunctions.Reserve(functionDescs.GetCount());
+  out_MappedFunctions.Clear();
+  out_MappedFunctions.Reserve(functionDescs.GetCount());
 
   for (auto& functionDesc : functionDescs)
   {
@@ -256,7 +418,7 @@ ezResult ezExpressionVM::MapFunctions(ezArrayPtr<const ezExpression::FunctionDes
       }
     }
 
-    m_MappedFunctions.PushBack(&registeredFunction);
+    out_MappedFunctions.PushBack(&registeredFunction);
   }
 
   return EZ_SUCCESS;
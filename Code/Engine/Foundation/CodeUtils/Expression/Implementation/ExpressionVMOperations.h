@@ -11,6 +11,7 @@ namespace
     ezExpression::Register* m_pRegisters = nullptr;
     ezUInt32 m_uiNumInstances = 0;
     ezUInt32 m_uiNumSimd4Instances = 0;
+    ezUInt32 m_uiRegisterStride = 0; // In Simd4 registers, might be larger than m_uiNumSimd4Instances to allow for wider execution
     ezArrayPtr<const ezProcessingStream*> m_Inputs;
     ezArrayPtr<ezProcessingStream*> m_Outputs;
     ezArrayPtr<const ezExpressionFunction*> m_Functions;
@@ -21,12 +22,12 @@ namespace
   using OpFunc = void (*)(const ByteCodeType*& pByteCode, ExecutionContext& context);
 
 #define DEFINE_TARGET_REGISTER()                                                                                                        \
-  ezExpression::Register* r = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances; \
-  ezExpression::Register* re = r + context.m_uiNumSimd4Instances;                                                                       \
+  ezExpression::Register* r = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiRegisterStride; \
+  ezExpression::Register* re = r + context.m_uiNumSimd4Instances;                                                                   \
   EZ_IGNORE_UNUSED(re);
 
 #define DEFINE_OP_REGISTER(name) \
-  const ezExpression::Register* name = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances;
+  const ezExpression::Register* name = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiRegisterStride;
 
 #define DEFINE_CONSTANT(name)                                                      \
   const ezUInt32 EZ_PP_CONCAT(name, Raw) = *pByteCode;                             \
@@ -78,7 +79,7 @@ namespace
     }                                                                                                               \
     else                                                                                                            \
     {                                                                                                               \
-      b = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances; \
+      b = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiRegisterStride;    \
     }                                                                                                               \
     while (r != re)                                                                                                 \
     {                                                                                                               \
@@ -136,6 +137,8 @@ namespace
   DEFINE_UNARY_OP(IToF, r->f = a->i.ToFloat());
   DEFINE_UNARY_OP(FToI, r->i = ezSimdVec4i::Truncate(a->f));
 
+  DEFINE_UNARY_OP(SatF, r->f = a->f.CompMin(ezSimdVec4f(1.0f)).CompMax(ezSimdVec4f::MakeZero()));
+
   DEFINE_BINARY_OP(AddF, r->f = a->f + b->f);
   DEFINE_BINARY_OP(AddI, r->i = a->i + b->i);
 
@@ -189,6 +192,10 @@ namespace
   DEFINE_TERNARY_OP(SelI, r->i = ezSimdVec4i::Select(a->b, b->i, c->i));
   DEFINE_TERNARY_OP(SelB, r->b = ezSimdVec4b::Select(a->b, b->b, c->b));
 
+  DEFINE_TERNARY_OP(MulAddF, r->f = ezSimdVec4f::MulAdd(a->f, b->f, c->f));
+  DEFINE_TERNARY_OP(MulSubF, r->f = ezSimdVec4f::MulSub(a->f, b->f, c->f));
+  DEFINE_TERNARY_OP(LerpF, r->f = ezSimdVec4f::MulAdd(c->f, b->f - a->f, a->f));
+
   void VM_MovX_R_4(const ByteCodeType*& pByteCode, ExecutionContext& context)
   {
     DEFINE_TARGET_REGISTER();
@@ -478,6 +485,8 @@ namespace
     &IToF_4,         // IToF_R,
     &FToI_4,         // FToI_R,
 
+    &SatF_4,         // SatF_R,
+
     nullptr,         // LastUnary,
     nullptr,         // FirstBinary,
 
@@ -585,6 +594,10 @@ namespace
     &SelI_4,         // SelI_RRR,
     &SelB_4,         // SelB_RRR,
 
+    &MulAddF_4,      // MulAddF_RRR,
+    &MulSubF_4,      // MulSubF_RRR,
+    &LerpF_4,        // LerpF_RRR,
+
     nullptr,         // LastTernary,
     nullptr,         // FirstSpecial,
 
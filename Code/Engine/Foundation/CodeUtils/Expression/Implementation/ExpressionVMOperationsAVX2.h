@@ -0,0 +1,399 @@
+#pragma once
+
+#include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperations.h>
+#include <Foundation/System/SystemInformation.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86) && EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+#  define EZ_EXPRESSIONVM_AVX2_SUPPORT EZ_ON
+#else
+#  define EZ_EXPRESSIONVM_AVX2_SUPPORT EZ_OFF
+#endif
+
+#if EZ_ENABLED(EZ_EXPRESSIONVM_AVX2_SUPPORT)
+
+#  include <immintrin.h>
+
+// The engine itself is only compiled for SSE 4.1, so the AVX2 code path has to be enabled per function.
+// MSVC allows the use of all intrinsics without any special flags.
+#  if EZ_ENABLED(EZ_COMPILER_MSVC_PURE)
+#    define EZ_AVX2_TARGET
+#  else
+#    define EZ_AVX2_TARGET __attribute__((target("avx2,fma")))
+#  endif
+
+namespace
+{
+  // The AVX2 backend always processes two consecutive Simd4 registers at once. For this to work the register stride is rounded up
+  // to an even number of Simd4 registers. The padding register might contain garbage but it is never written to any output stream.
+  // All instructions that don't have an 8-wide implementation fall back to the Simd4 implementation which works on the same register layout.
+
+  EZ_ALWAYS_INLINE ezUInt32 GetAvx2RegisterStride(ezUInt32 uiNumSimd4Instances)
+  {
+    return (uiNumSimd4Instances + 1) & ~1u;
+  }
+
+  bool IsAvx2Available()
+  {
+    // the AVX2 code is compiled with FMA enabled and uses FMA instructions for MulAddF / MulSubF,
+    // there are CPUs that support AVX2 but not FMA3, these have to use the Simd4 implementation
+    static const bool s_bAvx2Available = ezSystemInformation::Get().GetCpuFeatures().IsAvx2Available() && ezSystemInformation::Get().GetCpuFeatures().HW_FMA3;
+    return s_bAvx2Available;
+  }
+
+#  define DEFINE_TARGET_REGISTER_8()                                                                                                               \
+    float* r = reinterpret_cast<float*>(context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiRegisterStride); \
+    float* re = r + context.m_uiRegisterStride * 4;
+
+#  define DEFINE_OP_REGISTER_8(name) \
+    const float* name = reinterpret_cast<const float*>(context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiRegisterStride);
+
+#  define AS_INT(x) _mm256_castps_si256(x)
+#  define AS_FLOAT(x) _mm256_castsi256_ps(x)
+#  define ALL_BITS_SET() _mm256_castsi256_ps(_mm256_set1_epi32(-1))
+
+#  define DEFINE_UNARY_OP_8(name, code)                                     \
+    struct EZ_PP_CONCAT(name, _Op8)                                         \
+    {                                                                       \
+      EZ_AVX2_TARGET static EZ_ALWAYS_INLINE __m256 Do(__m256 a) { code; } \
+    };
+
+#  define DEFINE_BINARY_OP_8(name, code)                                              \
+    struct EZ_PP_CONCAT(name, _Op8)                                                   \
+    {                                                                                 \
+      EZ_AVX2_TARGET static EZ_ALWAYS_INLINE __m256 Do(__m256 a, __m256 b) { code; } \
+    };
+
+#  define DEFINE_TERNARY_OP_8(name, code)                                                       \
+    struct EZ_PP_CONCAT(name, _Op8)                                                             \
+    {                                                                                           \
+      EZ_AVX2_TARGET static EZ_ALWAYS_INLINE __m256 Do(__m256 a, __m256 b, __m256 c) { code; } \
+    };
+
+  template <typename Op>
+  EZ_AVX2_TARGET void Unary_8(const ByteCodeType*& pByteCode, ExecutionContext& context)
+  {
+    DEFINE_TARGET_REGISTER_8();
+    DEFINE_OP_REGISTER_8(a);
+    while (r != re)
+    {
+      _mm256_storeu_ps(r, Op::Do(_mm256_loadu_ps(a)));
+      r += 8;
+      a += 8;
+    }
+  }
+
+  template <typename Op, bool RightIsConstant>
+  EZ_AVX2_TARGET void Binary_8(const ByteCodeType*& pByteCode, ExecutionContext& context)
+  {
+    DEFINE_TARGET_REGISTER_8();
+    DEFINE_OP_REGISTER_8(a);
+    if constexpr (RightIsConstant)
+    {
+      const ezExpression::Register bConstant = ezExpressionByteCode::GetConstant(pByteCode);
+      const __m256 b = _mm256_broadcast_ps(&bConstant.f.m_v);
+      while (r != re)
+      {
+        _mm256_storeu_ps(r, Op::Do(_mm256_loadu_ps(a), b));
+        r += 8;
+        a += 8;
+      }
+    }
+    else
+    {
+      DEFINE_OP_REGISTER_8(b);
+      while (r != re)
+      {
+        _mm256_storeu_ps(r, Op::Do(_mm256_loadu_ps(a), _mm256_loadu_ps(b)));
+        r += 8;
+        a += 8;
+        b += 8;
+      }
+    }
+  }
+
+  template <typename Op>
+  EZ_AVX2_TARGET void Ternary_8(const ByteCodeType*& pByteCode, ExecutionContext& context)
+  {
+    DEFINE_TARGET_REGISTER_8();
+    DEFINE_OP_REGISTER_8(a);
+    DEFINE_OP_REGISTER_8(b);
+    DEFINE_OP_REGISTER_8(c);
+    while (r != re)
+    {
+      _mm256_storeu_ps(r, Op::Do(_mm256_loadu_ps(a), _mm256_loadu_ps(b), _mm256_loadu_ps(c)));
+      r += 8;
+      a += 8;
+      b += 8;
+      c += 8;
+    }
+  }
+
+  DEFINE_UNARY_OP_8(AbsF, return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a));
+  DEFINE_UNARY_OP_8(AbsI, return AS_FLOAT(_mm256_abs_epi32(AS_INT(a))));
+  DEFINE_UNARY_OP_8(SqrtF, return _mm256_sqrt_ps(a));
+
+  DEFINE_UNARY_OP_8(RoundF, return _mm256_round_ps(a, _MM_FROUND_NINT));
+  DEFINE_UNARY_OP_8(FloorF, return _mm256_round_ps(a, _MM_FROUND_FLOOR));
+  DEFINE_UNARY_OP_8(CeilF, return _mm256_round_ps(a, _MM_FROUND_CEIL));
+  DEFINE_UNARY_OP_8(TruncF, return _mm256_round_ps(a, _MM_FROUND_TRUNC));
+
+  DEFINE_UNARY_OP_8(NotI, return _mm256_xor_ps(a, ALL_BITS_SET()));
+  DEFINE_UNARY_OP_8(NotB, return _mm256_xor_ps(a, ALL_BITS_SET()));
+
+  DEFINE_UNARY_OP_8(IToF, return _mm256_cvtepi32_ps(AS_INT(a)));
+  DEFINE_UNARY_OP_8(FToI, return AS_FLOAT(_mm256_cvttps_epi32(a)));
+
+  DEFINE_UNARY_OP_8(SatF, return _mm256_max_ps(_mm256_min_ps(a, _mm256_set1_ps(1.0f)), _mm256_setzero_ps()));
+
+  DEFINE_BINARY_OP_8(AddF, return _mm256_add_ps(a, b));
+  DEFINE_BINARY_OP_8(AddI, return AS_FLOAT(_mm256_add_epi32(AS_INT(a), AS_INT(b))));
+
+  DEFINE_BINARY_OP_8(SubF, return _mm256_sub_ps(a, b));
+  DEFINE_BINARY_OP_8(SubI, return AS_FLOAT(_mm256_sub_epi32(AS_INT(a), AS_INT(b))));
+
+  DEFINE_BINARY_OP_8(MulF, return _mm256_mul_ps(a, b));
+  DEFINE_BINARY_OP_8(MulI, return AS_FLOAT(_mm256_mullo_epi32(AS_INT(a), AS_INT(b))));
+
+  DEFINE_BINARY_OP_8(DivF, return _mm256_div_ps(a, b));
+
+  DEFINE_BINARY_OP_8(MinF, return _mm256_min_ps(a, b));
+  DEFINE_BINARY_OP_8(MinI, return AS_FLOAT(_mm256_min_epi32(AS_INT(a), AS_INT(b))));
+
+  DEFINE_BINARY_OP_8(MaxF, return _mm256_max_ps(a, b));
+  DEFINE_BINARY_OP_8(MaxI, return AS_FLOAT(_mm256_max_epi32(AS_INT(a), AS_INT(b))));
+
+  DEFINE_BINARY_OP_8(AndI, return _mm256_and_ps(a, b));
+  DEFINE_BINARY_OP_8(XorI, return _mm256_xor_ps(a, b));
+  DEFINE_BINARY_OP_8(OrI, return _mm256_or_ps(a, b));
+
+  // The compare predicates match the semantics of the corresponding SSE instructions used by ezSimdVec4f
+  DEFINE_BINARY_OP_8(EqF, return _mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+  DEFINE_BINARY_OP_8(EqI, return AS_FLOAT(_mm256_cmpeq_epi32(AS_INT(a), AS_INT(b))));
+  DEFINE_BINARY_OP_8(EqB, return _mm256_xor_ps(_mm256_xor_ps(a, b), ALL_BITS_SET()));
+
+  DEFINE_BINARY_OP_8(NEqF, return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ));
+  DEFINE_BINARY_OP_8(NEqI, return _mm256_xor_ps(AS_FLOAT(_mm256_cmpeq_epi32(AS_INT(a), AS_INT(b))), ALL_BITS_SET()));
+  DEFINE_BINARY_OP_8(NEqB, return _mm256_xor_ps(a, b));
+
+  DEFINE_BINARY_OP_8(LtF, return _mm256_cmp_ps(a, b, _CMP_LT_OS));
+  DEFINE_BINARY_OP_8(LtI, return AS_FLOAT(_mm256_cmpgt_epi32(AS_INT(b), AS_INT(a))));
+
+  DEFINE_BINARY_OP_8(LEqF, return _mm256_cmp_ps(a, b, _CMP_LE_OS));
+  DEFINE_BINARY_OP_8(LEqI, return _mm256_xor_ps(AS_FLOAT(_mm256_cmpgt_epi32(AS_INT(a), AS_INT(b))), ALL_BITS_SET()));
+
+  DEFINE_BINARY_OP_8(GtF, return _mm256_cmp_ps(a, b, _CMP_GT_OS));
+  DEFINE_BINARY_OP_8(GtI, return AS_FLOAT(_mm256_cmpgt_epi32(AS_INT(a), AS_INT(b))));
+
+  DEFINE_BINARY_OP_8(GEqF, return _mm256_cmp_ps(a, b, _CMP_GE_OS));
+  DEFINE_BINARY_OP_8(GEqI, return _mm256_xor_ps(AS_FLOAT(_mm256_cmpgt_epi32(AS_INT(b), AS_INT(a))), ALL_BITS_SET()));
+
+  DEFINE_BINARY_OP_8(AndB, return _mm256_and_ps(a, b));
+  DEFINE_BINARY_OP_8(OrB, return _mm256_or_ps(a, b));
+
+  DEFINE_TERNARY_OP_8(Sel, return _mm256_blendv_ps(c, b, a));
+
+  DEFINE_TERNARY_OP_8(MulAddF, return _mm256_fmadd_ps(a, b, c));
+  DEFINE_TERNARY_OP_8(MulSubF, return _mm256_fmsub_ps(a, b, c));
+  DEFINE_TERNARY_OP_8(LerpF, return _mm256_fmadd_ps(c, _mm256_sub_ps(b, a), a));
+
+  EZ_AVX2_TARGET void VM_MovX_R_8(const ByteCodeType*& pByteCode, ExecutionContext& context)
+  {
+    DEFINE_TARGET_REGISTER_8();
+    DEFINE_OP_REGISTER_8(a);
+    while (r != re)
+    {
+      _mm256_storeu_ps(r, _mm256_loadu_ps(a));
+      r += 8;
+      a += 8;
+    }
+  }
+
+  EZ_AVX2_TARGET void VM_MovX_C_8(const ByteCodeType*& pByteCode, ExecutionContext& context)
+  {
+    DEFINE_TARGET_REGISTER_8();
+    const ezExpression::Register aConstant = ezExpressionByteCode::GetConstant(pByteCode);
+    const __m256 a = _mm256_broadcast_ps(&aConstant.f.m_v);
+    while (r != re)
+    {
+      _mm256_storeu_ps(r, a);
+      r += 8;
+    }
+  }
+
+  static constexpr OpFunc s_Avx2Funcs[] = {
+    nullptr,                        // Nop,
+
+    nullptr,                        // FirstUnary,
+
+    &Unary_8<AbsF_Op8>,             // AbsF_R,
+    &Unary_8<AbsI_Op8>,             // AbsI_R,
+    &Unary_8<SqrtF_Op8>,            // SqrtF_R,
+
+    &ExpF_4,                        // ExpF_R,
+    &LnF_4,                         // LnF_R,
+    &Log2F_4,                       // Log2F_R,
+    &Log2I_4,                       // Log2I_R,
+    &Log10F_4,                      // Log10F_R,
+    &Pow2F_4,                       // Pow2F_R,
+
+    &SinF_4,                        // SinF_R,
+    &CosF_4,                        // CosF_R,
+    &TanF_4,                        // TanF_R,
+
+    &ASinF_4,                       // ASinF_R,
+    &ACosF_4,                       // ACosF_R,
+    &ATanF_4,                       // ATanF_R,
+
+    &Unary_8<RoundF_Op8>,           // RoundF_R,
+    &Unary_8<FloorF_Op8>,           // FloorF_R,
+    &Unary_8<CeilF_Op8>,            // CeilF_R,
+    &Unary_8<TruncF_Op8>,           // TruncF_R,
+
+    &Unary_8<NotI_Op8>,             // NotI_R,
+    &Unary_8<NotB_Op8>,             // NotB_R,
+
+    &Unary_8<IToF_Op8>,             // IToF_R,
+    &Unary_8<FToI_Op8>,             // FToI_R,
+
+    &Unary_8<SatF_Op8>,             // SatF_R,
+
+    nullptr,                        // LastUnary,
+    nullptr,                        // FirstBinary,
+
+    &Binary_8<AddF_Op8, false>,     // AddF_RR,
+    &Binary_8<AddI_Op8, false>,     // AddI_RR,
+
+    &Binary_8<SubF_Op8, false>,     // SubF_RR,
+    &Binary_8<SubI_Op8, false>,     // SubI_RR,
+
+    &Binary_8<MulF_Op8, false>,     // MulF_RR,
+    &Binary_8<MulI_Op8, false>,     // MulI_RR,
+
+    &Binary_8<DivF_Op8, false>,     // DivF_RR,
+    &DivI_4<false>,                 // DivI_RR,
+
+    &Binary_8<MinF_Op8, false>,     // MinF_RR,
+    &Binary_8<MinI_Op8, false>,     // MinI_RR,
+
+    &Binary_8<MaxF_Op8, false>,     // MaxF_RR,
+    &Binary_8<MaxI_Op8, false>,     // MaxI_RR,
+
+    &ShlI_4<false>,                 // ShlI_RR,
+    &ShrI_4<false>,                 // ShrI_RR,
+    &Binary_8<AndI_Op8, false>,     // AndI_RR,
+    &Binary_8<XorI_Op8, false>,     // XorI_RR,
+    &Binary_8<OrI_Op8, false>,      // OrI_RR,
+
+    &Binary_8<EqF_Op8, false>,      // EqF_RR,
+    &Binary_8<EqI_Op8, false>,      // EqI_RR,
+    &Binary_8<EqB_Op8, false>,      // EqB_RR,
+
+    &Binary_8<NEqF_Op8, false>,     // NEqF_RR,
+    &Binary_8<NEqI_Op8, false>,     // NEqI_RR,
+    &Binary_8<NEqB_Op8, false>,     // NEqB_RR,
+
+    &Binary_8<LtF_Op8, false>,      // LtF_RR,
+    &Binary_8<LtI_Op8, false>,      // LtI_RR,
+
+    &Binary_8<LEqF_Op8, false>,     // LEqF_RR,
+    &Binary_8<LEqI_Op8, false>,     // LEqI_RR,
+
+    &Binary_8<GtF_Op8, false>,      // GtF_RR,
+    &Binary_8<GtI_Op8, false>,      // GtI_RR,
+
+    &Binary_8<GEqF_Op8, false>,     // GEqF_RR,
+    &Binary_8<GEqI_Op8, false>,     // GEqI_RR,
+
+    &Binary_8<AndB_Op8, false>,     // AndB_RR,
+    &Binary_8<OrB_Op8, false>,      // OrB_RR,
+
+    nullptr,                        // LastBinary,
+    nullptr,                        // FirstBinaryWithConstant,
+
+    &Binary_8<AddF_Op8, true>,      // AddF_RC,
+    &Binary_8<AddI_Op8, true>,      // AddI_RC,
+
+    &Binary_8<SubF_Op8, true>,      // SubF_RC,
+    &Binary_8<SubI_Op8, true>,      // SubI_RC,
+
+    &Binary_8<MulF_Op8, true>,      // MulF_RC,
+    &Binary_8<MulI_Op8, true>,      // MulI_RC,
+
+    &Binary_8<DivF_Op8, true>,      // DivF_RC,
+    &DivI_4<true>,                  // DivI_RC,
+
+    &Binary_8<MinF_Op8, true>,      // MinF_RC,
+    &Binary_8<MinI_Op8, true>,      // MinI_RC,
+
+    &Binary_8<MaxF_Op8, true>,      // MaxF_RC,
+    &Binary_8<MaxI_Op8, true>,      // MaxI_RC,
+
+    &ShlI_C_4<true>,                // ShlI_RC,
+    &ShrI_C_4<true>,                // ShrI_RC,
+    &Binary_8<AndI_Op8, true>,      // AndI_RC,
+    &Binary_8<XorI_Op8, true>,      // XorI_RC,
+    &Binary_8<OrI_Op8, true>,       // OrI_RC,
+
+    &Binary_8<EqF_Op8, true>,       // EqF_RC,
+    &Binary_8<EqI_Op8, true>,       // EqI_RC,
+    &Binary_8<EqB_Op8, true>,       // EqB_RC
+
+    &Binary_8<NEqF_Op8, true>,      // NEqF_RC,
+    &Binary_8<NEqI_Op8, true>,      // NEqI_RC,
+    &Binary_8<NEqB_Op8, true>,      // NEqB_RC
+
+    &Binary_8<LtF_Op8, true>,       // LtF_RC,
+    &Binary_8<LtI_Op8, true>,       // LtI_RC
+
+    &Binary_8<LEqF_Op8, true>,      // LEqF_RC,
+    &Binary_8<LEqI_Op8, true>,      // LEqI_RC
+
+    &Binary_8<GtF_Op8, true>,       // GtF_RC,
+    &Binary_8<GtI_Op8, true>,       // GtI_RC
+
+    &Binary_8<GEqF_Op8, true>,      // GEqF_RC,
+    &Binary_8<GEqI_Op8, true>,      // GEqI_RC
+
+    &Binary_8<AndB_Op8, true>,      // AndB_RC,
+    &Binary_8<OrB_Op8, true>,       // OrB_RC,
+
+    nullptr,                        // LastBinaryWithConstant,
+    nullptr,                        // FirstTernary,
+
+    &Ternary_8<Sel_Op8>,            // SelF_RRR,
+    &Ternary_8<Sel_Op8>,            // SelI_RRR,
+    &Ternary_8<Sel_Op8>,            // SelB_RRR,
+
+    &Ternary_8<MulAddF_Op8>,        // MulAddF_RRR,
+    &Ternary_8<MulSubF_Op8>,        // MulSubF_RRR,
+    &Ternary_8<LerpF_Op8>,          // LerpF_RRR,
+
+    nullptr,                        // LastTernary,
+    nullptr,                        // FirstSpecial,
+
+    &VM_MovX_R_8,                   // MovX_R,
+    &VM_MovX_C_8,                   // MovX_C,
+    &VM_LoadF_4,                    // LoadF,
+    &VM_LoadI_4,                    // LoadI,
+    &VM_StoreF_4,                   // StoreF,
+    &VM_StoreI_4,                   // StoreI,
+
+    &VM_Call,                       // Call,
+
+    nullptr,                        // LastSpecial,
+  };
+
+  static_assert(EZ_ARRAY_SIZE(s_Avx2Funcs) == ezExpressionByteCode::OpCode::Count);
+
+} // namespace
+
+#  undef DEFINE_TARGET_REGISTER_8
+#  undef DEFINE_OP_REGISTER_8
+#  undef AS_INT
+#  undef AS_FLOAT
+#  undef ALL_BITS_SET
+#  undef DEFINE_UNARY_OP_8
+#  undef DEFINE_BINARY_OP_8
+#  undef DEFINE_TERNARY_OP_8
+
+#endif
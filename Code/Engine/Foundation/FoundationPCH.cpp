@@ -22,14 +22,17 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_LogEntry);
   EZ_STATICLINK_REFERENCE(Foundation_Math_Implementation_Math);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_FrameAllocator);
+  EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_MemoryTrackerSampling);
   EZ_STATICLINK_REFERENCE(Foundation_Platform_Win_DirectoryWatcher_Win);
   EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_Profiling);
+  EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_ProfilingStream);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyAttributes);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyPath);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_RTTI);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_StandardTypes);
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_AbstractObjectGraph);
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_GraphVersioning);
+  EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_ReflectionLayout);
   EZ_STATICLINK_REFERENCE(Foundation_System_Implementation_StackTracer);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskSystem);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_ThreadUtils);
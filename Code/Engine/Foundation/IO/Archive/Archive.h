@@ -12,6 +12,8 @@ enum class ezArchiveCompressionMode : ezUInt8
   Uncompressed,
   Compressed_zstd,
   Compressed_zip,
+  Compressed_zstd_blocks, ///< Stored as independently zstd compressed blocks with a block table in front, see ezArchiveBlockTable. Allows random access.
+  Compressed_zstd_dict,   ///< A single zstd frame compressed with the archive's shared dictionary (ezArchiveTOC::m_CompressionDictionary). Used for small files.
 };
 
 /// \brief Data for a single file entry in an ezArchive file
@@ -103,6 +105,8 @@ public:
   ezHashTable<ezArchiveStoredString, ezUInt32> m_PathToEntryIndex;
   /// one large array holding all path strings for the file entries, to reduce allocations
   ezDynamicArray<ezUInt8> m_AllPathStrings;
+  /// the zstd dictionary for all ezArchiveCompressionMode::Compressed_zstd_dict entries, empty if the archive uses none
+  ezDynamicArray<ezUInt8> m_CompressionDictionary;
 
   /// \brief Returns the entry index for the given file or ezInvalidIndex, if not found.
   ezUInt32 FindEntry(ezStringView sFile) const;
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/IO/Stream.h>
+
+/// \brief Read-only view of the block table that precedes the data of ezArchiveCompressionMode::Compressed_zstd_blocks entries.
+///
+/// The stored data of such an entry starts with the uncompressed block size and the number of blocks (two ezUInt32),
+/// followed by one ezUInt64 offset per block plus one end offset. The offsets are relative to the end of the table.
+/// Every block is compressed independently, so any block can be decompressed without touching the others.
+/// A block whose stored size equals its uncompressed size is stored without compression.
+class EZ_FOUNDATION_DLL ezArchiveBlockTable
+{
+public:
+  /// \brief Validates the block table at the start of \a pStoredData and sets up the view. The data must stay valid while the view is in use.
+  ezResult Initialize(const void* pStoredData, ezUInt64 uiStoredDataSize, ezUInt64 uiUncompressedDataSize);
+
+  /// \brief Returns the number of bytes that the block table for the given number of blocks takes up in front of the block data.
+  static constexpr ezUInt64 GetTableSize(ezUInt32 uiNumBlocks) { return 2 * sizeof(ezUInt32) + (static_cast<ezUInt64>(uiNumBlocks) + 1) * sizeof(ezUInt64); }
+
+  ezUInt64 GetUncompressedDataSize() const { return m_uiUncompressedDataSize; }
+  ezUInt32 GetBlockSize() const { return m_uiBlockSize; }
+  ezUInt32 GetNumBlocks() const { return m_uiNumBlocks; }
+
+  /// \brief Returns the index of the block that contains the given uncompressed byte offset.
+  ezUInt32 GetBlockIndex(ezUInt64 uiUncompressedOffset) const { return static_cast<ezUInt32>(uiUncompressedOffset / m_uiBlockSize); }
+
+  /// \brief Returns the number of uncompressed bytes in the given block. Only the last block may be smaller than GetBlockSize().
+  ezUInt32 GetUncompressedBlockSize(ezUInt32 uiBlock) const;
+
+  /// \brief Returns the (potentially compressed) data that is stored for the given block.
+  ezConstByteArrayPtr GetStoredBlock(ezUInt32 uiBlock) const;
+
+  /// \brief Decompresses the given block into \a out_data, which must be exactly GetUncompressedBlockSize() bytes large.
+  ///
+  /// This function is thread-safe, different blocks can be decompressed in parallel.
+  ezResult DecompressBlock(ezUInt32 uiBlock, ezByteArrayPtr out_data) const;
+
+private:
+  ezUInt64 GetBlockOffset(ezUInt32 uiIndex) const;
+
+  const ezUInt8* m_pTable = nullptr;
+  const ezUInt8* m_pBlocks = nullptr;
+  ezUInt64 m_uiUncompressedDataSize = 0;
+  ezUInt32 m_uiBlockSize = 0;
+  ezUInt32 m_uiNumBlocks = 0;
+};
+
+/// \brief Stream reader for ezArchiveCompressionMode::Compressed_zstd_blocks entries.
+///
+/// Only decompresses the blocks that are actually read. Skipping and repositioning the reader is cheap,
+/// since skipped blocks are never decompressed.
+class EZ_FOUNDATION_DLL ezArchiveBlockReader : public ezStreamReader
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezArchiveBlockReader);
+
+public:
+  ezArchiveBlockReader();
+  ~ezArchiveBlockReader();
+
+  /// \brief Sets up the reader for the stored data of an entry. Resets the read position to the start.
+  ezResult Initialize(const void* pStoredData, ezUInt64 uiStoredDataSize, ezUInt64 uiUncompressedDataSize);
+
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override;
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override;
+
+  /// \brief Moves the read position to the given uncompressed byte offset.
+  void SetReadPosition(ezUInt64 uiReadPosition);
+  ezUInt64 GetReadPosition() const { return m_uiReadPosition; }
+
+  const ezArchiveBlockTable& GetBlockTable() const { return m_BlockTable; }
+
+private:
+  ezArchiveBlockTable m_BlockTable;
+  ezDynamicArray<ezUInt8> m_CachedBlock;
+  ezUInt32 m_uiCachedBlock = ezInvalidIndex;
+  ezUInt64 m_uiReadPosition = 0;
+};
@@ -22,6 +22,18 @@ public:
   // all the source files from disk that should be put into the ezArchive
   ezDeque<SourceEntry> m_Entries;
 
+  /// \brief If enabled, a zstd dictionary is assembled from the small zstd compressed files and stored in the archive.
+  ///
+  /// All zstd compressed files up to m_uiDictionaryFileSizeThreshold bytes are then compressed with that dictionary,
+  /// which greatly improves the compression ratio for many small, similar files.
+  bool m_bUseCompressionDictionary = false;
+
+  /// \brief Files up to this size are compressed with the dictionary, if m_bUseCompressionDictionary is enabled.
+  ezUInt32 m_uiDictionaryFileSizeThreshold = 32 * 1024;
+
+  /// \brief The maximum size of the compression dictionary.
+  ezUInt32 m_uiMaxDictionarySize = 112 * 1024;
+
   enum class InclusionMode
   {
     Exclude,               ///< Do not add this file to the archive
@@ -39,6 +51,7 @@ public:
   /// \brief Iterates over all files in a folder and adds them to m_Entries for later.
   ///
   /// The callback can be used to exclude certain files or to deactivate compression on them.
+  /// If \a defaultMode is ezArchiveCompressionMode::Compressed_zstd_blocks, files that the callback wants compressed are stored block compressed.
   /// \note If no callback is given, the default is to store all files uncompressed!
   void AddFolder(ezStringView sAbsFolderPath, ezArchiveCompressionMode defaultMode = ezArchiveCompressionMode::Uncompressed, InclusionCallback callback = InclusionCallback());
 
@@ -46,13 +59,17 @@ public:
   ezResult WriteArchive(ezStringView sFile) const;
 
   /// \brief Writes the previously gathered files to the file stream
+  ///
+  /// The files are read and compressed in parallel, but written to the stream in the order of m_Entries.
+  /// Uncompressed and very large files are streamed to the output on the calling thread instead.
+  /// All callbacks are executed on the calling thread.
   ezResult WriteArchive(ezStreamWriter& inout_stream) const;
 
 protected:
   /// Override this to get a callback when the next file is being written to the output. Return 'true' to continue, 'false' to cancel the entire archive generation.
   virtual bool WriteNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, ezStringView sSourceFile) const;
 
-  /// Override this to get a progress report for writing a single file to the output
+  /// Override this to get a progress report for writing a single file to the output. Files that are compressed in parallel only report once they are done.
   virtual bool WriteFileProgressCallback(ezUInt64 bytesWritten, ezUInt64 bytesTotal) const;
 
   /// Override this to get a callback after a file has been processed. Gets additional information about the compression result and duration.
@@ -65,4 +82,7 @@ protected:
     EZ_IGNORE_UNUSED(uiStoredSize);
     EZ_IGNORE_UNUSED(duration);
   }
+
+private:
+  ezResult BuildCompressionDictionary(ezDynamicArray<ezUInt8>& out_dictionaryData) const;
 };
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Threading/Mutex.h>
+
+/// \brief A zstd dictionary that is shared by all ezArchiveCompressionMode::Compressed_zstd_dict entries of an archive.
+///
+/// Small files compress poorly on their own, because there is no earlier data in which zstd could find matches.
+/// A dictionary provides that history up front. The dictionary data is stored once in the archive TOC.
+///
+/// The dictionary is used as raw content, ie. it is simply a collection of typical data, that zstd can reference
+/// as if it preceded every compressed file.
+class EZ_FOUNDATION_DLL ezArchiveDictionary
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezArchiveDictionary);
+
+public:
+  ezArchiveDictionary();
+  ~ezArchiveDictionary();
+
+  /// \brief Assembles dictionary data of at most \a uiMaxDictionarySize bytes from the given sample data.
+  ///
+  /// If all samples fit, they are concatenated. Otherwise evenly distributed samples contribute their first bytes,
+  /// since file headers and common preambles are what small files of the same type typically share.
+  static void BuildDictionaryData(ezArrayPtr<const ezConstByteArrayPtr> samples, ezUInt32 uiMaxDictionarySize, ezDynamicArray<ezUInt8>& out_dictionaryData);
+
+  /// \brief Prepares the dictionary for compressing data with the given zstd compression level.
+  ezResult InitializeForCompression(ezConstByteArrayPtr dictionaryData, ezInt32 iCompressionLevel);
+
+  /// \brief Prepares the dictionary for decompressing data.
+  ezResult InitializeForDecompression(ezConstByteArrayPtr dictionaryData);
+
+  /// \brief Releases all dictionary data.
+  void Clear();
+
+  bool CanCompress() const { return m_pCompressionDict != nullptr; }
+  bool CanDecompress() const { return m_pDecompressionDict != nullptr; }
+
+  /// \brief Compresses \a data with the dictionary and writes the result to \a out_compressedData.
+  ///
+  /// This function is thread-safe.
+  ezResult Compress(ezConstByteArrayPtr data, ezDynamicArray<ezUInt8>& out_compressedData) const;
+
+  /// \brief Decompresses \a compressedData into \a out_data, which must have exactly the size of the uncompressed data.
+  ///
+  /// This function is thread-safe.
+  ezResult Decompress(ezConstByteArrayPtr compressedData, ezByteArrayPtr out_data) const;
+
+private:
+  void* m_pCompressionDict = nullptr;   // ZSTD_CDict
+  void* m_pDecompressionDict = nullptr; // ZSTD_DDict
+
+  // zstd contexts are expensive to create, so they are reused across calls
+  mutable ezMutex m_ContextMutex;
+  mutable ezHybridArray<void*, 4> m_FreeCompressionContexts;   // ZSTD_CCtx
+  mutable ezHybridArray<void*, 4> m_FreeDecompressionContexts; // ZSTD_DCtx
+};
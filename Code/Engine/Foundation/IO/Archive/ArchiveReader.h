@@ -1,9 +1,11 @@
 #pragma once
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Archive/ArchiveDictionary.h>
 #include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/Types/UniquePtr.h>
 
+class ezArchiveBlockReader;
 class ezRawMemoryStreamReader;
 class ezStreamReader;
 
@@ -17,6 +19,9 @@ public:
   /// \brief Returns the table-of-contents for the previously opened archive.
   const ezArchiveTOC& GetArchiveTOC();
 
+  /// \brief Returns the dictionary that is needed for ezArchiveCompressionMode::Compressed_zstd_dict entries.
+  const ezArchiveDictionary& GetCompressionDictionary() const { return m_CompressionDictionary; }
+
   /// \brief Extracts the given entry to the target folder.
   ///
   /// Calls ExtractFileProgressCallback() to report progress.
@@ -30,9 +35,23 @@ public:
   /// \brief Sets up \a memReader for reading the raw (potentially compressed) data that is stored for the given entry in the archive.
   void ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawMemoryStreamReader& ref_memReader) const;
 
+  /// \brief Returns a view of the raw (potentially compressed) data that is stored for the given entry in the memory-mapped archive.
+  ///
+  /// Returns an empty view for entries that are too large to be represented by an ezArrayPtr.
+  ezConstByteArrayPtr GetRawEntryData(ezUInt32 uiEntryIdx) const;
+
+  /// \brief Sets up \a ref_blockReader for reading the given entry, which must use ezArchiveCompressionMode::Compressed_zstd_blocks.
+  ezResult ConfigureBlockReader(ezUInt32 uiEntryIdx, ezArchiveBlockReader& ref_blockReader) const;
+
   /// \brief Creates a reader that will decompress the given file entry.
   ezUniquePtr<ezStreamReader> CreateEntryReader(ezUInt32 uiEntryIdx) const;
 
+  /// \brief Reads the uncompressed bytes starting at \a uiOffset of the given entry into \a out_data. Returns the number of bytes read.
+  ///
+  /// Block compressed entries only decompress the affected blocks, which allows cheap partial reads.
+  /// \sa ezArchiveUtils::ReadEntryData()
+  ezUInt64 ReadEntryData(ezUInt32 uiEntryIdx, ezUInt64 uiOffset, ezByteArrayPtr out_data) const;
+
 protected:
   /// \brief Called by ExtractAllFiles() for progress reporting. Return false to abort.
   virtual bool ExtractNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, ezStringView sSourceFile) const;
@@ -42,6 +61,7 @@ protected:
 
   ezMemoryMappedFile m_MemFile;
   ezArchiveTOC m_ArchiveTOC;
+  ezArchiveDictionary m_CompressionDictionary;
   ezUInt8 m_uiArchiveVersion = 0;
   const void* m_pDataStart = nullptr;
   ezUInt64 m_uiMemFileSize = 0;
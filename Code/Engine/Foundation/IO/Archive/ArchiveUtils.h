@@ -9,6 +9,7 @@ class ezStreamWriter;
 class ezMemoryMappedFile;
 class ezArchiveTOC;
 class ezArchiveEntry;
+class ezArchiveDictionary;
 class ezRawMemoryStreamReader;
 
 /// \brief Utilities for working with ezArchive files
@@ -17,6 +18,7 @@ namespace ezArchiveUtils
   using FileWriteProgressCallback = ezDelegate<bool(ezUInt64, ezUInt64)>;
   constexpr ezUInt32 ArchiveHeaderSize = 16;
   constexpr ezUInt32 ArchiveTOCMetaMaxFooterSize = 14 + 12; //< note that it's the MAX size, i.e. toc meta can be smaller
+  constexpr ezUInt32 ArchiveBlockSize = 64 * 1024;           //< uncompressed size of a single block for ezArchiveCompressionMode::Compressed_zstd_blocks
 
   struct TOCMeta
   {
@@ -85,7 +87,15 @@ namespace ezArchiveUtils
   /// \brief Creates a new stream reader which allows to read the uncompressed data for the given archive entry.
   ///
   /// Under the hood it may create different types of stream readers to uncompress or decode the data.
-  EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData);
+  /// Entries that use ezArchiveCompressionMode::Compressed_zstd_dict require the archive's dictionary.
+  EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData, const ezArchiveDictionary* pDictionary = nullptr);
+
+  /// \brief Reads the uncompressed bytes starting at \a uiOffset of the given archive entry into \a out_data.
+  ///
+  /// For block compressed entries only the affected blocks are decompressed and larger ranges are decompressed in parallel.
+  /// Other entries are decoded sequentially from the start. Returns the number of bytes that were read.
+  /// Entries that use ezArchiveCompressionMode::Compressed_zstd_dict require the archive's dictionary.
+  EZ_FOUNDATION_DLL ezUInt64 ReadEntryData(const ezArchiveEntry& entry, const void* pStartOfArchiveData, ezUInt64 uiOffset, ezByteArrayPtr out_data, const ezArchiveDictionary* pDictionary = nullptr);
 
   EZ_FOUNDATION_DLL ezResult ReadZipHeader(ezStreamReader& inout_stream, ezUInt8& out_uiVersion);
   EZ_FOUNDATION_DLL ezResult ExtractZipTOC(const ezMemoryMappedFile& memFile, ezArchiveTOC& ref_toc);
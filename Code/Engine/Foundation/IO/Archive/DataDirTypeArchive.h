@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/IO/Archive/ArchiveBlockReader.h>
 #include <Foundation/IO/Archive/ArchiveReader.h>
 #include <Foundation/IO/CompressedStreamZlib.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
@@ -15,6 +16,8 @@ namespace ezDataDirectory
   class ArchiveReaderUncompressed;
   class ArchiveReaderZstd;
   class ArchiveReaderZip;
+  class ArchiveReaderBlocks;
+  class ArchiveReaderDict;
 
   class EZ_FOUNDATION_DLL ArchiveType : public ezDataDirectoryType
   {
@@ -47,6 +50,10 @@ namespace ezDataDirectory
     ezMutex m_ReaderMutex;
     ezHybridArray<ezUniquePtr<ArchiveReaderUncompressed>, 4> m_ReadersUncompressed;
     ezHybridArray<ArchiveReaderUncompressed*, 4> m_FreeReadersUncompressed;
+    ezHybridArray<ezUniquePtr<ArchiveReaderBlocks>, 4> m_ReadersBlocks;
+    ezHybridArray<ArchiveReaderBlocks*, 4> m_FreeReadersBlocks;
+    ezHybridArray<ezUniquePtr<ArchiveReaderDict>, 4> m_ReadersDict;
+    ezHybridArray<ArchiveReaderDict*, 4> m_FreeReadersDict;
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
     ezHybridArray<ezUniquePtr<ArchiveReaderZstd>, 4> m_ReadersZstd;
@@ -84,10 +91,57 @@ namespace ezDataDirectory
 
     virtual ezUInt64 Skip(ezUInt64 uiBytes) override;
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+    virtual ezConstByteArrayPtr GetMappedData() const override { return m_MappedData; }
 
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
     virtual void InternalClose() override;
+
+    friend class ArchiveType;
+
+    ezConstByteArrayPtr m_MappedData;
+  };
+
+  /// \brief Reads block compressed entries. Skipping does not decompress the skipped blocks.
+  class EZ_FOUNDATION_DLL ArchiveReaderBlocks : public ArchiveReaderCommon
+  {
+    EZ_DISALLOW_COPY_AND_ASSIGN(ArchiveReaderBlocks);
+
+  public:
+    ArchiveReaderBlocks(ezInt32 iDataDirUserData);
+
+    virtual ezUInt64 Skip(ezUInt64 uiBytes) override;
+    virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+
+  protected:
+    virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
+    virtual void InternalClose() override;
+
+    friend class ArchiveType;
+
+    ezArchiveBlockReader m_BlockReader;
+  };
+
+  /// \brief Reads dictionary compressed entries. These are small, so they get decompressed entirely when the file is opened.
+  class EZ_FOUNDATION_DLL ArchiveReaderDict : public ArchiveReaderCommon
+  {
+    EZ_DISALLOW_COPY_AND_ASSIGN(ArchiveReaderDict);
+
+  public:
+    ArchiveReaderDict(ezInt32 iDataDirUserData);
+
+    virtual ezUInt64 Skip(ezUInt64 uiBytes) override;
+    virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+    virtual ezConstByteArrayPtr GetMappedData() const override { return m_DecompressedData; }
+
+  protected:
+    virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
+    virtual void InternalClose() override;
+
+    friend class ArchiveType;
+
+    ezDynamicArray<ezUInt8> m_DecompressedData;
+    ezRawMemoryStreamReader m_DecompressedReader;
   };
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
@@ -120,6 +174,7 @@ namespace ezDataDirectory
     ~ArchiveReaderZip();
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+    virtual ezConstByteArrayPtr GetMappedData() const override { return ezConstByteArrayPtr(); }
 
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
@@ -0,0 +1,178 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/IO/Archive/ArchiveBlockReader.h>
+#include <Foundation/Logging/Log.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+#  include <zstd/zstd.h>
+#endif
+
+ezResult ezArchiveBlockTable::Initialize(const void* pStoredData, ezUInt64 uiStoredDataSize, ezUInt64 uiUncompressedDataSize)
+{
+  *this = ezArchiveBlockTable();
+
+  if (uiStoredDataSize < GetTableSize(0))
+  {
+    ezLog::Error("Archive is corrupt. Block table is missing.");
+    return EZ_FAILURE;
+  }
+
+  const ezUInt8* pTable = static_cast<const ezUInt8*>(pStoredData);
+
+  ezUInt32 uiBlockSize = 0;
+  ezUInt32 uiNumBlocks = 0;
+  ezMemoryUtils::RawByteCopy(&uiBlockSize, pTable, sizeof(ezUInt32));
+  ezMemoryUtils::RawByteCopy(&uiNumBlocks, pTable + sizeof(ezUInt32), sizeof(ezUInt32));
+
+  if (uiBlockSize == 0 || GetTableSize(uiNumBlocks) > uiStoredDataSize || static_cast<ezUInt64>(uiNumBlocks) * uiBlockSize < uiUncompressedDataSize ||
+      (uiNumBlocks > 0 && static_cast<ezUInt64>(uiNumBlocks - 1) * uiBlockSize >= uiUncompressedDataSize))
+  {
+    ezLog::Error("Archive is corrupt. Invalid block table.");
+    return EZ_FAILURE;
+  }
+
+  m_pTable = pTable;
+  m_pBlocks = pTable + GetTableSize(uiNumBlocks);
+  m_uiUncompressedDataSize = uiUncompressedDataSize;
+  m_uiBlockSize = uiBlockSize;
+  m_uiNumBlocks = uiNumBlocks;
+
+  const ezUInt64 uiMaxBlockData = uiStoredDataSize - GetTableSize(uiNumBlocks);
+
+  for (ezUInt32 i = 0; i < uiNumBlocks; ++i)
+  {
+    const ezUInt64 uiStart = GetBlockOffset(i);
+    const ezUInt64 uiEnd = GetBlockOffset(i + 1);
+
+    if (uiStart > uiEnd || uiEnd > uiMaxBlockData || uiEnd - uiStart > GetUncompressedBlockSize(i))
+    {
+      *this = ezArchiveBlockTable();
+
+      ezLog::Error("Archive is corrupt. Invalid block range.");
+      return EZ_FAILURE;
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezUInt32 ezArchiveBlockTable::GetUncompressedBlockSize(ezUInt32 uiBlock) const
+{
+  EZ_ASSERT_DEBUG(uiBlock < m_uiNumBlocks, "Invalid block index {} (only {} blocks)", uiBlock, m_uiNumBlocks);
+
+  const ezUInt64 uiBlockStart = static_cast<ezUInt64>(uiBlock) * m_uiBlockSize;
+  return static_cast<ezUInt32>(ezMath::Min<ezUInt64>(m_uiBlockSize, m_uiUncompressedDataSize - uiBlockStart));
+}
+
+ezConstByteArrayPtr ezArchiveBlockTable::GetStoredBlock(ezUInt32 uiBlock) const
+{
+  EZ_ASSERT_DEBUG(uiBlock < m_uiNumBlocks, "Invalid block index {} (only {} blocks)", uiBlock, m_uiNumBlocks);
+
+  const ezUInt64 uiStart = GetBlockOffset(uiBlock);
+  const ezUInt64 uiEnd = GetBlockOffset(uiBlock + 1);
+
+  return ezConstByteArrayPtr(m_pBlocks + uiStart, static_cast<ezUInt32>(uiEnd - uiStart));
+}
+
+ezResult ezArchiveBlockTable::DecompressBlock(ezUInt32 uiBlock, ezByteArrayPtr out_data) const
+{
+  EZ_ASSERT_DEV(out_data.GetCount() == GetUncompressedBlockSize(uiBlock), "Output buffer must match the uncompressed block size");
+
+  const ezConstByteArrayPtr storedBlock = GetStoredBlock(uiBlock);
+
+  if (storedBlock.GetCount() == out_data.GetCount())
+  {
+    ezMemoryUtils::RawByteCopy(out_data.GetPtr(), storedBlock.GetPtr(), storedBlock.GetCount());
+    return EZ_SUCCESS;
+  }
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  const size_t res = ZSTD_decompress(out_data.GetPtr(), out_data.GetCount(), storedBlock.GetPtr(), storedBlock.GetCount());
+
+  if (ZSTD_isError(res) || res != out_data.GetCount())
+  {
+    ezLog::Error("Decompressing archive block {} failed: '{}'", uiBlock, ZSTD_isError(res) ? ZSTD_getErrorName(res) : "size mismatch");
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+#else
+  ezLog::Error("Archive block {} is zstd compressed, but zstd support is not compiled in.", uiBlock);
+  return EZ_FAILURE;
+#endif
+}
+
+ezUInt64 ezArchiveBlockTable::GetBlockOffset(ezUInt32 uiIndex) const
+{
+  ezUInt64 uiOffset = 0;
+  ezMemoryUtils::RawByteCopy(&uiOffset, m_pTable + 2 * sizeof(ezUInt32) + static_cast<ezUInt64>(uiIndex) * sizeof(ezUInt64), sizeof(ezUInt64));
+  return uiOffset;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezArchiveBlockReader::ezArchiveBlockReader() = default;
+ezArchiveBlockReader::~ezArchiveBlockReader() = default;
+
+ezResult ezArchiveBlockReader::Initialize(const void* pStoredData, ezUInt64 uiStoredDataSize, ezUInt64 uiUncompressedDataSize)
+{
+  m_uiCachedBlock = ezInvalidIndex;
+  m_uiReadPosition = 0;
+
+  EZ_SUCCEED_OR_RETURN(m_BlockTable.Initialize(pStoredData, uiStoredDataSize, uiUncompressedDataSize));
+
+  m_CachedBlock.SetCountUninitialized(m_BlockTable.GetNumBlocks() > 0 ? m_BlockTable.GetBlockSize() : 0);
+  return EZ_SUCCESS;
+}
+
+ezUInt64 ezArchiveBlockReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
+{
+  ezUInt8* pOutput = static_cast<ezUInt8*>(pReadBuffer);
+  ezUInt64 uiBytesRead = 0;
+
+  uiBytesToRead = ezMath::Min(uiBytesToRead, m_BlockTable.GetUncompressedDataSize() - m_uiReadPosition);
+
+  while (uiBytesRead < uiBytesToRead)
+  {
+    const ezUInt32 uiBlock = m_BlockTable.GetBlockIndex(m_uiReadPosition);
+    const ezUInt32 uiBlockSize = m_BlockTable.GetUncompressedBlockSize(uiBlock);
+    const ezUInt32 uiOffsetInBlock = static_cast<ezUInt32>(m_uiReadPosition - static_cast<ezUInt64>(uiBlock) * m_BlockTable.GetBlockSize());
+    const ezUInt32 uiBytesFromBlock = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiBlockSize - uiOffsetInBlock, uiBytesToRead - uiBytesRead));
+
+    if (uiOffsetInBlock == 0 && uiBytesFromBlock == uiBlockSize && uiBlock != m_uiCachedBlock)
+    {
+      // the entire block is requested, decompress it directly into the output
+      if (m_BlockTable.DecompressBlock(uiBlock, ezByteArrayPtr(pOutput + uiBytesRead, uiBlockSize)).Failed())
+        break;
+    }
+    else
+    {
+      if (uiBlock != m_uiCachedBlock)
+      {
+        if (m_BlockTable.DecompressBlock(uiBlock, m_CachedBlock.GetArrayPtr().GetSubArray(0, uiBlockSize)).Failed())
+          break;
+
+        m_uiCachedBlock = uiBlock;
+      }
+
+      ezMemoryUtils::RawByteCopy(pOutput + uiBytesRead, m_CachedBlock.GetData() + uiOffsetInBlock, uiBytesFromBlock);
+    }
+
+    uiBytesRead += uiBytesFromBlock;
+    m_uiReadPosition += uiBytesFromBlock;
+  }
+
+  return uiBytesRead;
+}
+
+ezUInt64 ezArchiveBlockReader::SkipBytes(ezUInt64 uiBytesToSkip)
+{
+  const ezUInt64 uiBytesSkipped = ezMath::Min(uiBytesToSkip, m_BlockTable.GetUncompressedDataSize() - m_uiReadPosition);
+  m_uiReadPosition += uiBytesSkipped;
+  return uiBytesSkipped;
+}
+
+void ezArchiveBlockReader::SetReadPosition(ezUInt64 uiReadPosition)
+{
+  m_uiReadPosition = ezMath::Min(uiReadPosition, m_BlockTable.GetUncompressedDataSize());
+}
@@ -1,11 +1,16 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Containers/Map.h>
 #include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveDictionary.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
 
 void ezArchiveBuilder::AddFolder(ezStringView sAbsFolderPath, ezArchiveCompressionMode defaultMode /*= ezArchiveCompressionMode::Uncompressed*/, InclusionCallback callback /*= InclusionCallback()*/)
@@ -19,6 +24,11 @@ void ezArchiveBuilder::AddFolder(ezStringView sAbsFolderPath, ezArchiveCompressi
   ezStringBuilder fullPath;
   ezStringBuilder relPath;
 
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  // the zstd inclusion modes use block compression, if that is requested as the default
+  const ezArchiveCompressionMode zstdMode = (defaultMode == ezArchiveCompressionMode::Compressed_zstd_blocks) ? ezArchiveCompressionMode::Compressed_zstd_blocks : ezArchiveCompressionMode::Compressed_zstd;
+#  endif
+
   for (fileIt.StartSearch(sBasePath, ezFileSystemIteratorFlags::ReportFilesRecursive); fileIt.IsValid(); fileIt.Next())
   {
     const auto& stat = fileIt.GetStats();
@@ -44,23 +54,23 @@ void ezArchiveBuilder::AddFolder(ezStringView sAbsFolderPath, ezArchiveCompressi
 
 #  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
           case InclusionMode::Compress_zstd_fastest:
-            compression = ezArchiveCompressionMode::Compressed_zstd;
+            compression = zstdMode;
             iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::Fastest);
             break;
           case InclusionMode::Compress_zstd_fast:
-            compression = ezArchiveCompressionMode::Compressed_zstd;
+            compression = zstdMode;
             iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::Fast);
             break;
           case InclusionMode::Compress_zstd_average:
-            compression = ezArchiveCompressionMode::Compressed_zstd;
+            compression = zstdMode;
             iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::Average);
             break;
           case InclusionMode::Compress_zstd_high:
-            compression = ezArchiveCompressionMode::Compressed_zstd;
+            compression = zstdMode;
             iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::High);
             break;
           case InclusionMode::Compress_zstd_highest:
-            compression = ezArchiveCompressionMode::Compressed_zstd;
+            compression = zstdMode;
             iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::Highest);
             break;
 #  endif
@@ -97,38 +107,249 @@ ezResult ezArchiveBuilder::WriteArchive(ezStringView sFile) const
   return WriteArchive(file);
 }
 
+namespace
+{
+  struct PreparedEntry
+  {
+    ezDefaultMemoryStreamStorage m_Storage;
+    ezArchiveEntry m_Entry;
+    ezUInt32 m_uiPathStringOffset = 0;
+    bool m_bWriteDirectly = false;
+    ezResult m_Result = EZ_SUCCESS;
+    ezTime m_Duration;
+  };
+
+  using DictionaryMap = ezMap<ezInt32, ezUniquePtr<ezArchiveDictionary>>;
+
+  struct PrepareTaskData
+  {
+    const ezDeque<ezArchiveBuilder::SourceEntry>* m_pEntries = nullptr;
+    ezUniquePtr<PreparedEntry>* m_pPrepared = nullptr;
+    ezUInt32 m_uiBatchStart = 0;
+    const DictionaryMap* m_pDictionaries = nullptr;
+    ezUInt32 m_uiDictionaryFileSizeThreshold = 0;
+  };
+} // namespace
+
+static ezResult CompressEntryWithDictionary(ezFileReader& inout_file, const ezArchiveDictionary& dictionary, PreparedEntry& inout_prepared)
+{
+  const ezUInt32 uiFileSize = static_cast<ezUInt32>(inout_file.GetFileSize());
+
+  ezDynamicArray<ezUInt8> data;
+  data.SetCountUninitialized(uiFileSize);
+
+  if (inout_file.ReadBytes(data.GetData(), uiFileSize) != uiFileSize)
+  {
+    ezLog::Error("Failed to read '{}'", inout_file.GetFilePathAbsolute().GetView());
+    return EZ_FAILURE;
+  }
+
+  ezDynamicArray<ezUInt8> compressed;
+  EZ_SUCCEED_OR_RETURN(dictionary.Compress(data, compressed));
+
+  ezMemoryStreamWriter writer(&inout_prepared.m_Storage);
+  ezUInt64 uiStreamPos = 0;
+
+  if (compressed.GetCount() * 12 >= data.GetCount() * 10)
+  {
+    // less than 20% size saving -> go uncompressed
+    return ezArchiveUtils::WriteEntryPreprocessed(writer, data, inout_prepared.m_uiPathStringOffset, ezArchiveCompressionMode::Uncompressed, uiFileSize, inout_prepared.m_Entry, uiStreamPos);
+  }
+
+  return ezArchiveUtils::WriteEntryPreprocessed(writer, compressed, inout_prepared.m_uiPathStringOffset, ezArchiveCompressionMode::Compressed_zstd_dict, uiFileSize, inout_prepared.m_Entry, uiStreamPos);
+}
+
+static ezUInt64 GetSourceFileSize(ezStringView sAbsSourcePath)
+{
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
+  ezFileStats stats;
+  if (ezOSFile::GetFileStats(sAbsSourcePath, stats).Succeeded())
+    return stats.m_uiFileSize;
+#else
+  EZ_IGNORE_UNUSED(sAbsSourcePath);
+#endif
+
+  return 0;
+}
+
+static ezResult PrepareEntry(const ezArchiveBuilder::SourceEntry& entry, const ezArchiveDictionary* pDictionary, ezUInt32 uiDictionaryFileSizeThreshold, PreparedEntry& inout_prepared)
+{
+  if (pDictionary != nullptr)
+  {
+    ezFileReader file;
+    EZ_SUCCEED_OR_RETURN(file.Open(entry.m_sAbsSourcePath));
+
+    if (file.GetFileSize() <= uiDictionaryFileSizeThreshold)
+    {
+      return CompressEntryWithDictionary(file, *pDictionary, inout_prepared);
+    }
+  }
+
+  // the entry is compressed into memory at stream position zero, the final position is patched when it gets written out
+  ezMemoryStreamWriter writer(&inout_prepared.m_Storage);
+  ezUInt64 uiStreamPos = 0;
+  return ezArchiveUtils::WriteEntryOptimal(writer, entry.m_sAbsSourcePath, inout_prepared.m_uiPathStringOffset, entry.m_CompressionMode, entry.m_iCompressionLevel, inout_prepared.m_Entry, uiStreamPos);
+}
+
 ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
 {
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteHeader(inout_stream));
 
   ezArchiveTOC toc;
 
+  DictionaryMap dictionaries;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (m_bUseCompressionDictionary)
+  {
+    EZ_SUCCEED_OR_RETURN(BuildCompressionDictionary(toc.m_CompressionDictionary));
+
+    if (!toc.m_CompressionDictionary.IsEmpty())
+    {
+      // a digested dictionary is specific to a compression level
+      for (const SourceEntry& e : m_Entries)
+      {
+        if (e.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd || dictionaries.Contains(e.m_iCompressionLevel))
+          continue;
+
+        ezUniquePtr<ezArchiveDictionary>& pDictionary = dictionaries[e.m_iCompressionLevel];
+        pDictionary = EZ_DEFAULT_NEW(ezArchiveDictionary);
+        EZ_SUCCEED_OR_RETURN(pDictionary->InitializeForCompression(toc.m_CompressionDictionary, e.m_iCompressionLevel));
+      }
+    }
+  }
+#endif
+
   ezStringBuilder sHashablePath;
 
   ezUInt64 uiStreamSize = 0;
   const ezUInt32 uiNumEntries = m_Entries.GetCount();
 
-  ezStopwatch sw;
+  // Entries are compressed into memory in parallel, a few per worker thread at a time.
+  // A batch is closed early once its source files add up to uiMaxBatchBytes, so that many large files can't pile up in memory.
+  // Files above uiWriteDirectlyThreshold are compressed one at a time on this thread when they are written, which also reports their progress.
+  constexpr ezUInt64 uiMaxBatchBytes = 64 * 1024 * 1024;
+  constexpr ezUInt64 uiWriteDirectlyThreshold = 8 * 1024 * 1024;
+  const ezUInt32 uiBatchSize = ezMath::Min(ezMath::Max(ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks), 1u) * 4, ezMath::Max(uiNumEntries, 1u));
 
-  for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+  ezDynamicArray<ezUniquePtr<PreparedEntry>> prepared;
+  prepared.SetCount(uiBatchSize);
+  for (auto& pPrepared : prepared)
   {
-    const SourceEntry& e = m_Entries[i];
+    pPrepared = EZ_DEFAULT_NEW(PreparedEntry);
+  }
+
+  PrepareTaskData taskData;
+  taskData.m_pEntries = &m_Entries;
+  taskData.m_pPrepared = prepared.GetData();
+  taskData.m_pDictionaries = &dictionaries;
+  taskData.m_uiDictionaryFileSizeThreshold = m_uiDictionaryFileSizeThreshold;
 
-    const ezUInt32 uiPathStringOffset = toc.AddPathString(e.m_sRelTargetPath);
+  ezParallelForParams params;
+  params.m_uiBinSize = 1;
+  params.m_uiMaxTasksPerThread = 4;
 
-    sHashablePath = e.m_sRelTargetPath;
-    sHashablePath.ToLower();
+  for (ezUInt32 uiBatchStart = 0, uiBatchEnd = 0; uiBatchStart < uiNumEntries; uiBatchStart = uiBatchEnd)
+  {
+    ezUInt64 uiBatchBytes = 0;
+
+    for (; uiBatchEnd < uiNumEntries && uiBatchEnd - uiBatchStart < uiBatchSize && uiBatchBytes < uiMaxBatchBytes; ++uiBatchEnd)
+    {
+      const ezUInt32 i = uiBatchEnd;
+      const SourceEntry& e = m_Entries[i];
 
-    toc.m_PathToEntryIndex[ezArchiveStoredString(ezHashingUtils::StringHash(sHashablePath), uiPathStringOffset)] = toc.m_Entries.GetCount();
+      const ezUInt32 uiPathStringOffset = toc.AddPathString(e.m_sRelTargetPath);
 
-    if (!WriteNextFileCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath))
-      return EZ_FAILURE;
+      sHashablePath = e.m_sRelTargetPath;
+      sHashablePath.ToLower();
+
+      toc.m_PathToEntryIndex[ezArchiveStoredString(ezHashingUtils::StringHash(sHashablePath), uiPathStringOffset)] = i;
+
+      if (!WriteNextFileCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath))
+        return EZ_FAILURE;
+
+      PreparedEntry& p = *prepared[i - uiBatchStart];
+      p.m_Storage.Clear();
+      p.m_Entry = ezArchiveEntry();
+      p.m_uiPathStringOffset = uiPathStringOffset;
+      p.m_Result = EZ_SUCCESS;
+      p.m_Duration = ezTime::MakeZero();
 
-    ezArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
+      // uncompressed and large files are streamed straight to the output, buffering them would only cost memory
+      // small files that may use the compression dictionary are always prepared in parallel
+      const ezUInt64 uiFileSize = GetSourceFileSize(e.m_sAbsSourcePath);
+      const bool bMayUseDictionary = !dictionaries.IsEmpty() && uiFileSize <= m_uiDictionaryFileSizeThreshold;
+      p.m_bWriteDirectly = (e.m_CompressionMode == ezArchiveCompressionMode::Uncompressed) || (uiFileSize > uiWriteDirectlyThreshold && !bMayUseDictionary);
 
-    EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, e.m_iCompressionLevel, tocEntry, uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this)));
+      if (!p.m_bWriteDirectly)
+      {
+        uiBatchBytes += uiFileSize;
+      }
+    }
+
+    taskData.m_uiBatchStart = uiBatchStart;
+
+    ezTaskSystem::ParallelForIndexed(
+      uiBatchStart, uiBatchEnd - uiBatchStart, [pData = &taskData](ezUInt32 uiStart, ezUInt32 uiEnd) {
+        for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+        {
+          PreparedEntry& p = *pData->m_pPrepared[i - pData->m_uiBatchStart];
+
+          if (p.m_bWriteDirectly)
+            continue;
 
-    WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, sw.Checkpoint());
+          const SourceEntry& e = (*pData->m_pEntries)[i];
+
+          const ezArchiveDictionary* pDictionary = nullptr;
+          if (e.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd)
+          {
+            if (auto it = pData->m_pDictionaries->Find(e.m_iCompressionLevel); it.IsValid())
+            {
+              pDictionary = it.Value().Borrow();
+            }
+          }
+
+          const ezTime tStart = ezTime::Now();
+          p.m_Result = PrepareEntry(e, pDictionary, pData->m_uiDictionaryFileSizeThreshold, p);
+          p.m_Duration = ezTime::Now() - tStart;
+        }
+      },
+      "CompressArchiveEntries", ezTaskNesting::Maybe, params);
+
+    // write the entries in order
+    for (ezUInt32 i = uiBatchStart; i < uiBatchEnd; ++i)
+    {
+      const SourceEntry& e = m_Entries[i];
+      PreparedEntry& p = *prepared[i - uiBatchStart];
+
+      if (p.m_Result.Failed())
+      {
+        ezLog::Error("Failed to compress '{}'", e.m_sAbsSourcePath);
+        return EZ_FAILURE;
+      }
+
+      ezArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
+
+      if (p.m_bWriteDirectly)
+      {
+        ezStopwatch sw;
+        EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, p.m_uiPathStringOffset, e.m_CompressionMode, e.m_iCompressionLevel, tocEntry, uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this)));
+        p.m_Duration = sw.GetRunningTotal();
+      }
+      else
+      {
+        tocEntry = p.m_Entry;
+        tocEntry.m_uiDataStartOffset = uiStreamSize;
+
+        EZ_SUCCEED_OR_RETURN(p.m_Storage.CopyToStream(inout_stream));
+        uiStreamSize += tocEntry.m_uiStoredDataSize;
+
+        if (!WriteFileProgressCallback(tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiUncompressedDataSize))
+          return EZ_FAILURE;
+      }
+
+      WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, p.m_Duration);
+    }
   }
 
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::AppendTOC(inout_stream, toc));
@@ -136,6 +357,69 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
   return EZ_SUCCESS;
 }
 
+ezResult ezArchiveBuilder::BuildCompressionDictionary(ezDynamicArray<ezUInt8>& out_dictionaryData) const
+{
+  out_dictionaryData.Clear();
+
+  // only files that will actually be compressed with the dictionary are used as samples
+  ezDynamicArray<ezUInt32> candidates;
+
+  for (ezUInt32 i = 0; i < m_Entries.GetCount(); ++i)
+  {
+    const SourceEntry& e = m_Entries[i];
+
+    if (e.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd)
+      continue;
+
+    ezFileReader file;
+    if (file.Open(e.m_sAbsSourcePath).Failed())
+    {
+      ezLog::Error("Failed to open '{}'", e.m_sAbsSourcePath);
+      return EZ_FAILURE;
+    }
+
+    if (file.GetFileSize() > 0 && file.GetFileSize() <= m_uiDictionaryFileSizeThreshold)
+    {
+      candidates.PushBack(i);
+    }
+  }
+
+  if (candidates.IsEmpty())
+    return EZ_SUCCESS;
+
+  // reading more samples than can contribute to the dictionary would only waste time
+  constexpr ezUInt32 uiMinBytesPerSample = 256;
+  const ezUInt32 uiNumSamples = ezMath::Clamp(m_uiMaxDictionarySize / uiMinBytesPerSample, 1u, candidates.GetCount());
+
+  ezDynamicArray<ezDynamicArray<ezUInt8>> sampleData;
+  sampleData.SetCount(uiNumSamples);
+
+  ezDynamicArray<ezConstByteArrayPtr> samples;
+  samples.Reserve(uiNumSamples);
+
+  for (ezUInt32 i = 0; i < uiNumSamples; ++i)
+  {
+    const ezUInt32 uiEntry = candidates[static_cast<ezUInt32>(static_cast<ezUInt64>(i) * candidates.GetCount() / uiNumSamples)];
+
+    ezFileReader file;
+    if (file.Open(m_Entries[uiEntry].m_sAbsSourcePath).Failed())
+    {
+      ezLog::Error("Failed to open '{}'", m_Entries[uiEntry].m_sAbsSourcePath);
+      return EZ_FAILURE;
+    }
+
+    sampleData[i].SetCountUninitialized(static_cast<ezUInt32>(file.GetFileSize()));
+    sampleData[i].SetCountUninitialized(static_cast<ezUInt32>(file.ReadBytes(sampleData[i].GetData(), sampleData[i].GetCount())));
+
+    samples.PushBack(sampleData[i]);
+  }
+
+  ezArchiveDictionary::BuildDictionaryData(samples, m_uiMaxDictionarySize, out_dictionaryData);
+
+  ezLog::Dev("Built a {} compression dictionary from {} of {} small files.", ezArgFileSize(out_dictionaryData.GetCount()), uiNumSamples, candidates.GetCount());
+  return EZ_SUCCESS;
+}
+
 bool ezArchiveBuilder::WriteNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, ezStringView sSourceFile) const
 {
   EZ_IGNORE_UNUSED(uiCurEntry);
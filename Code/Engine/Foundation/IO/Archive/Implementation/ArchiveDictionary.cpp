@@ -0,0 +1,235 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/IO/Archive/ArchiveDictionary.h>
+#include <Foundation/Logging/Log.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+#  include <zstd/zstd.h>
+#endif
+
+ezArchiveDictionary::ezArchiveDictionary() = default;
+
+ezArchiveDictionary::~ezArchiveDictionary()
+{
+  Clear();
+}
+
+void ezArchiveDictionary::BuildDictionaryData(ezArrayPtr<const ezConstByteArrayPtr> samples, ezUInt32 uiMaxDictionarySize, ezDynamicArray<ezUInt8>& out_dictionaryData)
+{
+  out_dictionaryData.Clear();
+
+  if (samples.IsEmpty() || uiMaxDictionarySize == 0)
+    return;
+
+  ezUInt64 uiTotalSize = 0;
+  for (const auto& sample : samples)
+  {
+    uiTotalSize += sample.GetCount();
+  }
+
+  // smaller prefixes than this hardly contain anything worth referencing
+  constexpr ezUInt32 uiMinPrefixSize = 256;
+
+  const ezUInt32 uiNumSamples = samples.GetCount();
+  ezUInt32 uiPrefixSize = ezMath::MaxValue<ezUInt32>();
+  ezUInt32 uiNumUsedSamples = uiNumSamples;
+
+  if (uiTotalSize > uiMaxDictionarySize)
+  {
+    uiPrefixSize = ezMath::Max(uiMaxDictionarySize / uiNumSamples, uiMinPrefixSize);
+    uiNumUsedSamples = ezMath::Clamp(uiMaxDictionarySize / uiPrefixSize, 1u, uiNumSamples);
+  }
+
+  out_dictionaryData.Reserve(static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiTotalSize, uiMaxDictionarySize)));
+
+  for (ezUInt32 i = 0; i < uiNumUsedSamples; ++i)
+  {
+    // pick the samples evenly distributed, so that all kinds of files are represented
+    const ezConstByteArrayPtr sample = samples[static_cast<ezUInt32>(static_cast<ezUInt64>(i) * uiNumSamples / uiNumUsedSamples)];
+
+    const ezUInt32 uiRemaining = uiMaxDictionarySize - out_dictionaryData.GetCount();
+    const ezUInt32 uiBytes = ezMath::Min(sample.GetCount(), uiPrefixSize, uiRemaining);
+
+    out_dictionaryData.PushBackRange(sample.GetSubArray(0, uiBytes));
+
+    if (out_dictionaryData.GetCount() == uiMaxDictionarySize)
+      break;
+  }
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (out_dictionaryData.GetCount() >= sizeof(ezUInt32))
+  {
+    ezUInt32 uiMagic = 0;
+    ezMemoryUtils::RawByteCopy(&uiMagic, out_dictionaryData.GetData(), sizeof(ezUInt32));
+
+    // zstd would interpret data starting with the dictionary magic number as a structured dictionary
+    if (uiMagic == ZSTD_MAGIC_DICTIONARY)
+    {
+      out_dictionaryData.RemoveAtAndCopy(0);
+    }
+  }
+#endif
+}
+
+ezResult ezArchiveDictionary::InitializeForCompression(ezConstByteArrayPtr dictionaryData, ezInt32 iCompressionLevel)
+{
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  EZ_ASSERT_DEV(m_pCompressionDict == nullptr, "Compression dictionary is already initialized");
+
+  m_pCompressionDict = ZSTD_createCDict(dictionaryData.GetPtr(), dictionaryData.GetCount(), iCompressionLevel);
+
+  if (m_pCompressionDict == nullptr)
+  {
+    ezLog::Error("Creating the zstd compression dictionary failed.");
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+#else
+  EZ_IGNORE_UNUSED(dictionaryData);
+  EZ_IGNORE_UNUSED(iCompressionLevel);
+  ezLog::Error("Compression dictionaries require zstd support, which is not compiled in.");
+  return EZ_FAILURE;
+#endif
+}
+
+ezResult ezArchiveDictionary::InitializeForDecompression(ezConstByteArrayPtr dictionaryData)
+{
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  EZ_ASSERT_DEV(m_pDecompressionDict == nullptr, "Decompression dictionary is already initialized");
+
+  m_pDecompressionDict = ZSTD_createDDict(dictionaryData.GetPtr(), dictionaryData.GetCount());
+
+  if (m_pDecompressionDict == nullptr)
+  {
+    ezLog::Error("Creating the zstd decompression dictionary failed.");
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+#else
+  EZ_IGNORE_UNUSED(dictionaryData);
+  ezLog::Error("Compression dictionaries require zstd support, which is not compiled in.");
+  return EZ_FAILURE;
+#endif
+}
+
+void ezArchiveDictionary::Clear()
+{
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  EZ_LOCK(m_ContextMutex);
+
+  for (void* pContext : m_FreeCompressionContexts)
+  {
+    ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(pContext));
+  }
+
+  for (void* pContext : m_FreeDecompressionContexts)
+  {
+    ZSTD_freeDCtx(static_cast<ZSTD_DCtx*>(pContext));
+  }
+
+  ZSTD_freeCDict(static_cast<ZSTD_CDict*>(m_pCompressionDict));
+  ZSTD_freeDDict(static_cast<ZSTD_DDict*>(m_pDecompressionDict));
+#endif
+
+  m_FreeCompressionContexts.Clear();
+  m_FreeDecompressionContexts.Clear();
+  m_pCompressionDict = nullptr;
+  m_pDecompressionDict = nullptr;
+}
+
+ezResult ezArchiveDictionary::Compress(ezConstByteArrayPtr data, ezDynamicArray<ezUInt8>& out_compressedData) const
+{
+  EZ_ASSERT_DEV(CanCompress(), "Compression dictionary is not initialized");
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  ZSTD_CCtx* pContext = nullptr;
+
+  {
+    EZ_LOCK(m_ContextMutex);
+
+    if (!m_FreeCompressionContexts.IsEmpty())
+    {
+      pContext = static_cast<ZSTD_CCtx*>(m_FreeCompressionContexts.PeekBack());
+      m_FreeCompressionContexts.PopBack();
+    }
+  }
+
+  if (pContext == nullptr)
+  {
+    pContext = ZSTD_createCCtx();
+  }
+
+  out_compressedData.SetCountUninitialized(static_cast<ezUInt32>(ZSTD_compressBound(data.GetCount())));
+
+  const size_t res = ZSTD_compress_usingCDict(pContext, out_compressedData.GetData(), out_compressedData.GetCount(), data.GetPtr(), data.GetCount(), static_cast<const ZSTD_CDict*>(m_pCompressionDict));
+
+  {
+    EZ_LOCK(m_ContextMutex);
+    m_FreeCompressionContexts.PushBack(pContext);
+  }
+
+  if (ZSTD_isError(res))
+  {
+    ezLog::Error("Compressing with dictionary failed: '{}'", ZSTD_getErrorName(res));
+    out_compressedData.Clear();
+    return EZ_FAILURE;
+  }
+
+  out_compressedData.SetCountUninitialized(static_cast<ezUInt32>(res));
+  return EZ_SUCCESS;
+#else
+  EZ_IGNORE_UNUSED(data);
+  EZ_IGNORE_UNUSED(out_compressedData);
+  return EZ_FAILURE;
+#endif
+}
+
+ezResult ezArchiveDictionary::Decompress(ezConstByteArrayPtr compressedData, ezByteArrayPtr out_data) const
+{
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (!CanDecompress())
+  {
+    ezLog::Error("Archive entry requires a compression dictionary, but the archive has none.");
+    return EZ_FAILURE;
+  }
+
+  ZSTD_DCtx* pContext = nullptr;
+
+  {
+    EZ_LOCK(m_ContextMutex);
+
+    if (!m_FreeDecompressionContexts.IsEmpty())
+    {
+      pContext = static_cast<ZSTD_DCtx*>(m_FreeDecompressionContexts.PeekBack());
+      m_FreeDecompressionContexts.PopBack();
+    }
+  }
+
+  if (pContext == nullptr)
+  {
+    pContext = ZSTD_createDCtx();
+  }
+
+  const size_t res = ZSTD_decompress_usingDDict(pContext, out_data.GetPtr(), out_data.GetCount(), compressedData.GetPtr(), compressedData.GetCount(), static_cast<const ZSTD_DDict*>(m_pDecompressionDict));
+
+  {
+    EZ_LOCK(m_ContextMutex);
+    m_FreeDecompressionContexts.PushBack(pContext);
+  }
+
+  if (ZSTD_isError(res) || res != out_data.GetCount())
+  {
+    ezLog::Error("Decompressing with dictionary failed: '{}'", ZSTD_isError(res) ? ZSTD_getErrorName(res) : "size mismatch");
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+#else
+  EZ_IGNORE_UNUSED(compressedData);
+  EZ_IGNORE_UNUSED(out_data);
+  ezLog::Error("Archive entry is zstd compressed with a dictionary, but zstd support is not compiled in.");
+  return EZ_FAILURE;
+#endif
+}
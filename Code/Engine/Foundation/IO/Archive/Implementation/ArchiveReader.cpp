@@ -1,5 +1,6 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/IO/Archive/ArchiveBlockReader.h>
 #include <Foundation/IO/Archive/ArchiveReader.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 
@@ -16,6 +17,8 @@ ezResult ezArchiveReader::OpenArchive(ezStringView sPath)
 #if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
   EZ_LOG_BLOCK("OpenArchive", sPath);
 
+  m_CompressionDictionary.Clear();
+
   EZ_SUCCEED_OR_RETURN(m_MemFile.Open(sPath, ezMemoryMappedFile::Mode::ReadOnly));
   m_uiMemFileSize = m_MemFile.GetFileSize();
 
@@ -32,6 +35,11 @@ ezResult ezArchiveReader::OpenArchive(ezStringView sPath)
       m_pDataStart = m_MemFile.GetReadPointer(ezArchiveUtils::ArchiveHeaderSize, ezMemoryMappedFile::OffsetBase::Start);
 
       EZ_SUCCEED_OR_RETURN(ezArchiveUtils::ExtractTOC(m_MemFile, m_ArchiveTOC, m_uiArchiveVersion));
+
+      if (!m_ArchiveTOC.m_CompressionDictionary.IsEmpty())
+      {
+        EZ_SUCCEED_OR_RETURN(m_CompressionDictionary.InitializeForDecompression(m_ArchiveTOC.m_CompressionDictionary));
+      }
     }
 #  ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
     else if (extension == "zip" || extension == "apk")
@@ -71,12 +79,19 @@ ezResult ezArchiveReader::OpenArchive(ezStringView sPath)
         return EZ_FAILURE;
       }
 
-      if (e.m_uiUncompressedDataSize < e.m_uiStoredDataSize)
+      // block compressed entries additionally store the block table
+      if (e.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd_blocks && e.m_uiUncompressedDataSize < e.m_uiStoredDataSize)
       {
         ezLog::Error("Archive is corrupt. Invalid compression info.");
         return EZ_FAILURE;
       }
 
+      if (e.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_dict && (!m_CompressionDictionary.CanDecompress() || e.m_uiUncompressedDataSize > ezMath::MaxValue<ezUInt32>()))
+      {
+        ezLog::Error("Archive is corrupt. Invalid dictionary compression info.");
+        return EZ_FAILURE;
+      }
+
       if (e.m_uiPathStringOffset >= uiMaxPathString)
       {
         ezLog::Error("Archive is corrupt. Invalid entry path-string offset.");
@@ -122,9 +137,34 @@ void ezArchiveReader::ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawM
   ezArchiveUtils::ConfigureRawMemoryStreamReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, ref_memReader);
 }
 
+ezConstByteArrayPtr ezArchiveReader::GetRawEntryData(ezUInt32 uiEntryIdx) const
+{
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+  if (entry.m_uiStoredDataSize > ezMath::MaxValue<ezUInt32>())
+    return ezConstByteArrayPtr();
+
+  const void* pStoredData = ezMemoryUtils::AddByteOffset(m_pDataStart, static_cast<std::ptrdiff_t>(entry.m_uiDataStartOffset));
+  return ezConstByteArrayPtr(static_cast<const ezUInt8*>(pStoredData), static_cast<ezUInt32>(entry.m_uiStoredDataSize));
+}
+
+ezResult ezArchiveReader::ConfigureBlockReader(ezUInt32 uiEntryIdx, ezArchiveBlockReader& ref_blockReader) const
+{
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+  EZ_ASSERT_DEV(entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_blocks, "Archive entry is not block compressed");
+
+  const void* pStoredData = ezMemoryUtils::AddByteOffset(m_pDataStart, static_cast<std::ptrdiff_t>(entry.m_uiDataStartOffset));
+  return ref_blockReader.Initialize(pStoredData, entry.m_uiStoredDataSize, entry.m_uiUncompressedDataSize);
+}
+
 ezUniquePtr<ezStreamReader> ezArchiveReader::CreateEntryReader(ezUInt32 uiEntryIdx) const
 {
-  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
+  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, &m_CompressionDictionary);
+}
+
+ezUInt64 ezArchiveReader::ReadEntryData(ezUInt32 uiEntryIdx, ezUInt64 uiOffset, ezByteArrayPtr out_data) const
+{
+  return ezArchiveUtils::ReadEntryData(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, uiOffset, out_data, &m_CompressionDictionary);
 }
 
 ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, ezStringView sTargetFolder) const
@@ -134,6 +174,9 @@ ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, ezStringView sTargetF
 
   ezUniquePtr<ezStreamReader> pReader = CreateEntryReader(uiEntryIdx);
 
+  if (pReader == nullptr)
+    return EZ_FAILURE;
+
   ezStringBuilder sOutputFile = sTargetFolder;
   sOutputFile.AppendPath(sFilePath);
 
@@ -3,12 +3,20 @@
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 
 #include <Foundation/Algorithm/HashStream.h>
+#include <Foundation/IO/Archive/ArchiveBlockReader.h>
+#include <Foundation/IO/Archive/ArchiveDictionary.h>
 #include <Foundation/IO/CompressedStreamZlib.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Types/ScopeExit.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+#  include <zstd/zstd.h>
+#endif
 
 ezHybridArray<ezString, 4, ezStaticsAllocatorWrapper>& ezArchiveUtils::GetAcceptedArchiveFileExtensions()
 {
@@ -40,11 +48,13 @@ ezResult ezArchiveUtils::WriteHeader(ezStreamWriter& inout_stream)
   const char* szTag = "EZARCHIVE";
   EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(szTag, 10));
 
-  const ezUInt8 uiArchiveVersion = 4;
+  const ezUInt8 uiArchiveVersion = 6;
 
   // Version 2: Added end-of-file marker for file corruption (cutoff) detection
   // Version 3: HashedStrings changed from MurmurHash to xxHash
   // Version 4: use 64 Bit string hashes
+  // Version 5: added block compressed entries
+  // Version 6: added compression dictionary to the TOC
   inout_stream << uiArchiveVersion;
 
   const ezUInt8 uiPadding[5] = {0, 0, 0, 0, 0};
@@ -67,7 +77,7 @@ ezResult ezArchiveUtils::ReadHeader(ezStreamReader& inout_stream, ezUInt8& out_u
   out_uiVersion = 0;
   inout_stream >> out_uiVersion;
 
-  if (out_uiVersion != 1 && out_uiVersion != 2 && out_uiVersion != 3 && out_uiVersion != 4)
+  if (out_uiVersion < 1 || out_uiVersion > 6)
   {
     ezLog::Error("Unsupported archive version '{}'.", out_uiVersion);
     return EZ_FAILURE;
@@ -106,6 +116,91 @@ ezResult ezArchiveUtils::WriteEntryPreprocessed(ezStreamWriter& inout_stream, ez
   return EZ_SUCCESS;
 }
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+static ezResult WriteBlockCompressedEntry(ezStreamWriter& inout_stream, ezStreamReader& inout_file, ezUInt64 uiMaxBytes, ezInt32 iCompressionLevel, ezArchiveEntry& inout_tocEntry, ezArchiveUtils::FileWriteProgressCallback progress)
+{
+  constexpr ezUInt32 uiBlockSize = ezArchiveUtils::ArchiveBlockSize;
+
+  ezDynamicArray<ezUInt8> uncompressedBlock;
+  uncompressedBlock.SetCountUninitialized(uiBlockSize);
+
+  ezDynamicArray<ezUInt8> compressedBlock;
+  compressedBlock.SetCountUninitialized(static_cast<ezUInt32>(ZSTD_compressBound(uiBlockSize)));
+
+  ZSTD_CCtx* pContext = ZSTD_createCCtx();
+  EZ_SCOPE_EXIT(ZSTD_freeCCtx(pContext));
+
+  // the block table is stored in front of the blocks, so the compressed blocks need to be gathered first
+  ezDefaultMemoryStreamStorage blockStorage;
+  ezMemoryStreamWriter blockWriter(&blockStorage);
+  ezDynamicArray<ezUInt64> blockOffsets;
+
+  while (true)
+  {
+    // every block except the last one must be completely filled
+    ezUInt32 uiRead = 0;
+    while (uiRead < uiBlockSize)
+    {
+      const ezUInt64 uiChunk = inout_file.ReadBytes(uncompressedBlock.GetData() + uiRead, uiBlockSize - uiRead);
+
+      if (uiChunk == 0)
+        break;
+
+      uiRead += static_cast<ezUInt32>(uiChunk);
+    }
+
+    if (uiRead == 0)
+      break;
+
+    blockOffsets.PushBack(blockStorage.GetStorageSize64());
+
+    const size_t uiCompressedSize = ZSTD_compressCCtx(pContext, compressedBlock.GetData(), compressedBlock.GetCount(), uncompressedBlock.GetData(), uiRead, iCompressionLevel);
+
+    if (ZSTD_isError(uiCompressedSize))
+    {
+      ezLog::Error("Compressing archive block failed: '{}'", ZSTD_getErrorName(uiCompressedSize));
+      return EZ_FAILURE;
+    }
+
+    if (uiCompressedSize < uiRead)
+    {
+      EZ_SUCCEED_OR_RETURN(blockWriter.WriteBytes(compressedBlock.GetData(), uiCompressedSize));
+    }
+    else
+    {
+      // compression does not help for this block, store it as is
+      EZ_SUCCEED_OR_RETURN(blockWriter.WriteBytes(uncompressedBlock.GetData(), uiRead));
+    }
+
+    inout_tocEntry.m_uiUncompressedDataSize += uiRead;
+
+    if (progress.IsValid())
+    {
+      if (!progress(inout_tocEntry.m_uiUncompressedDataSize, uiMaxBytes))
+        return EZ_FAILURE;
+    }
+
+    if (uiRead < uiBlockSize)
+      break;
+  }
+
+  blockOffsets.PushBack(blockStorage.GetStorageSize64());
+
+  const ezUInt32 uiNumBlocks = blockOffsets.GetCount() - 1;
+
+  inout_stream << uiBlockSize;
+  inout_stream << uiNumBlocks;
+  EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(blockOffsets.GetData(), blockOffsets.GetCount() * sizeof(ezUInt64)));
+  EZ_SUCCEED_OR_RETURN(blockStorage.CopyToStream(inout_stream));
+
+  inout_tocEntry.m_uiStoredDataSize = ezArchiveBlockTable::GetTableSize(uiNumBlocks) + blockStorage.GetStorageSize64();
+
+  return EZ_SUCCESS;
+}
+
+#endif
+
 ezResult ezArchiveUtils::WriteEntry(
   ezStreamWriter& inout_stream, ezStringView sAbsSourcePath, ezUInt32 uiPathStringOffset, ezArchiveCompressionMode compression,
   ezInt32 iCompressionLevel, ezArchiveEntry& inout_tocEntry, ezUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
@@ -154,6 +249,15 @@ ezResult ezArchiveUtils::WriteEntry(
       pWriter = &zstdWriter;
     }
     break;
+
+    case ezArchiveCompressionMode::Compressed_zstd_blocks:
+    {
+      inout_tocEntry.m_CompressionMode = compression;
+      EZ_SUCCEED_OR_RETURN(WriteBlockCompressedEntry(inout_stream, file, uiMaxBytes, iCompressionLevel, inout_tocEntry, progress));
+
+      inout_uiCurrentStreamPosition += inout_tocEntry.m_uiStoredDataSize;
+      return EZ_SUCCESS;
+    }
 #endif
 
     default:
@@ -244,6 +348,25 @@ public:
 
 #endif
 
+// dictionary compressed entries are small, so they are decompressed entirely up front
+class ezArchiveDictEntryReader : public ezRawMemoryStreamReader
+{
+public:
+  ezDynamicArray<ezUInt8> m_Data;
+};
+
+static ezResult DecompressDictEntry(const ezArchiveEntry& entry, const void* pStartOfArchiveData, const ezArchiveDictionary* pDictionary, ezByteArrayPtr out_data)
+{
+  if (pDictionary == nullptr)
+  {
+    ezLog::Error("Archive entry is compressed with a dictionary, but no dictionary is available.");
+    return EZ_FAILURE;
+  }
+
+  const void* pStoredData = ezMemoryUtils::AddByteOffset(pStartOfArchiveData, static_cast<std::ptrdiff_t>(entry.m_uiDataStartOffset));
+  return pDictionary->Decompress(ezConstByteArrayPtr(static_cast<const ezUInt8*>(pStoredData), static_cast<ezUInt32>(entry.m_uiStoredDataSize)), out_data);
+}
+
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
 
 class ezCompressedStreamReaderZipWithSource : public ezCompressedStreamReaderZip
@@ -254,7 +377,7 @@ public:
 
 #endif
 
-ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData)
+ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData, const ezArchiveDictionary* pDictionary /*= nullptr*/)
 {
   ezUniquePtr<ezStreamReader> reader;
 
@@ -278,6 +401,35 @@ ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEnt
       break;
     }
 #endif
+    case ezArchiveCompressionMode::Compressed_zstd_blocks:
+    {
+      reader = EZ_DEFAULT_NEW(ezArchiveBlockReader);
+      ezArchiveBlockReader* pBlockReader = static_cast<ezArchiveBlockReader*>(reader.Borrow());
+      const void* pStoredData = ezMemoryUtils::AddByteOffset(pStartOfArchiveData, static_cast<std::ptrdiff_t>(entry.m_uiDataStartOffset));
+
+      if (pBlockReader->Initialize(pStoredData, entry.m_uiStoredDataSize, entry.m_uiUncompressedDataSize).Failed())
+      {
+        reader.Clear();
+      }
+      break;
+    }
+
+    case ezArchiveCompressionMode::Compressed_zstd_dict:
+    {
+      reader = EZ_DEFAULT_NEW(ezArchiveDictEntryReader);
+      ezArchiveDictEntryReader* pDictReader = static_cast<ezArchiveDictEntryReader*>(reader.Borrow());
+      pDictReader->m_Data.SetCountUninitialized(static_cast<ezUInt32>(entry.m_uiUncompressedDataSize));
+
+      if (DecompressDictEntry(entry, pStartOfArchiveData, pDictionary, pDictReader->m_Data.GetArrayPtr()).Failed())
+      {
+        reader.Clear();
+        break;
+      }
+
+      pDictReader->Reset(pDictReader->m_Data.GetData(), pDictReader->m_Data.GetCount());
+      break;
+    }
+
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
     case ezArchiveCompressionMode::Compressed_zip:
     {
@@ -297,6 +449,133 @@ ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEnt
   return std::move(reader);
 }
 
+ezUInt64 ezArchiveUtils::ReadEntryData(const ezArchiveEntry& entry, const void* pStartOfArchiveData, ezUInt64 uiOffset, ezByteArrayPtr out_data, const ezArchiveDictionary* pDictionary /*= nullptr*/)
+{
+  if (uiOffset >= entry.m_uiUncompressedDataSize || out_data.IsEmpty())
+    return 0;
+
+  const ezUInt32 uiBytesToRead = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(out_data.GetCount(), entry.m_uiUncompressedDataSize - uiOffset));
+  const ezUInt8* pStoredData = static_cast<const ezUInt8*>(ezMemoryUtils::AddByteOffset(pStartOfArchiveData, static_cast<std::ptrdiff_t>(entry.m_uiDataStartOffset)));
+
+  if (entry.m_CompressionMode == ezArchiveCompressionMode::Uncompressed)
+  {
+    ezMemoryUtils::RawByteCopy(out_data.GetPtr(), pStoredData + uiOffset, uiBytesToRead);
+    return uiBytesToRead;
+  }
+
+  if (entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_dict)
+  {
+    if (uiOffset == 0 && uiBytesToRead == entry.m_uiUncompressedDataSize)
+    {
+      // the entire entry is requested, decompress it directly into the output
+      return DecompressDictEntry(entry, pStartOfArchiveData, pDictionary, out_data.GetSubArray(0, uiBytesToRead)).Succeeded() ? uiBytesToRead : 0;
+    }
+
+    ezDynamicArray<ezUInt8> tempData;
+    tempData.SetCountUninitialized(static_cast<ezUInt32>(entry.m_uiUncompressedDataSize));
+
+    if (DecompressDictEntry(entry, pStartOfArchiveData, pDictionary, tempData.GetArrayPtr()).Failed())
+      return 0;
+
+    ezMemoryUtils::RawByteCopy(out_data.GetPtr(), tempData.GetData() + uiOffset, uiBytesToRead);
+    return uiBytesToRead;
+  }
+
+  if (entry.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd_blocks)
+  {
+    // stream compressed data can only be decoded from the start
+    ezUniquePtr<ezStreamReader> pReader = CreateEntryReader(entry, pStartOfArchiveData);
+
+    if (pReader == nullptr || pReader->SkipBytes(uiOffset) != uiOffset)
+      return 0;
+
+    return pReader->ReadBytes(out_data.GetPtr(), uiBytesToRead);
+  }
+
+  ezArchiveBlockTable blockTable;
+  if (blockTable.Initialize(pStoredData, entry.m_uiStoredDataSize, entry.m_uiUncompressedDataSize).Failed())
+    return 0;
+
+  const ezUInt64 uiBlockSize = blockTable.GetBlockSize();
+  const ezUInt64 uiEnd = uiOffset + uiBytesToRead;
+  const ezUInt32 uiFirstBlock = blockTable.GetBlockIndex(uiOffset);
+  const ezUInt32 uiLastBlock = blockTable.GetBlockIndex(uiEnd - 1);
+
+  // blocks that are completely covered by the range get decompressed directly into the output
+  const ezUInt32 uiFirstFullBlock = (uiFirstBlock * uiBlockSize == uiOffset) ? uiFirstBlock : uiFirstBlock + 1;
+  const ezUInt32 uiEndFullBlock = (uiLastBlock * uiBlockSize + blockTable.GetUncompressedBlockSize(uiLastBlock) == uiEnd) ? uiLastBlock + 1 : uiLastBlock;
+
+  // the remaining blocks at the borders of the range go through a temporary buffer
+  {
+    const ezUInt32 borderBlocks[2] = {uiFirstBlock, uiLastBlock};
+    const ezUInt32 uiNumBorderBlocks = (uiFirstBlock == uiLastBlock) ? 1 : 2;
+
+    ezDynamicArray<ezUInt8> tempBlock;
+
+    for (ezUInt32 i = 0; i < uiNumBorderBlocks; ++i)
+    {
+      const ezUInt32 uiBlock = borderBlocks[i];
+
+      if (uiBlock >= uiFirstFullBlock && uiBlock < uiEndFullBlock)
+        continue;
+
+      const ezUInt32 uiUncompressedBlockSize = blockTable.GetUncompressedBlockSize(uiBlock);
+      tempBlock.SetCountUninitialized(uiUncompressedBlockSize);
+
+      if (blockTable.DecompressBlock(uiBlock, tempBlock.GetArrayPtr()).Failed())
+        return 0;
+
+      const ezUInt64 uiBlockStart = uiBlock * uiBlockSize;
+      const ezUInt64 uiCopyStart = ezMath::Max(uiBlockStart, uiOffset);
+      const ezUInt64 uiCopyEnd = ezMath::Min(uiBlockStart + uiUncompressedBlockSize, uiEnd);
+
+      ezMemoryUtils::RawByteCopy(out_data.GetPtr() + (uiCopyStart - uiOffset), tempBlock.GetData() + (uiCopyStart - uiBlockStart), static_cast<size_t>(uiCopyEnd - uiCopyStart));
+    }
+  }
+
+  if (uiFirstFullBlock < uiEndFullBlock)
+  {
+    struct BlockTaskData
+    {
+      const ezArchiveBlockTable* m_pBlockTable;
+      ezUInt8* m_pOutput;
+      ezUInt64 m_uiOffset;
+      ezAtomicInteger32 m_iNumFailed;
+    };
+
+    BlockTaskData data;
+    data.m_pBlockTable = &blockTable;
+    data.m_pOutput = out_data.GetPtr();
+    data.m_uiOffset = uiOffset;
+
+    ezParallelForParams params;
+    params.m_uiBinSize = 4;
+    params.m_uiMaxTasksPerThread = 1;
+
+    ezTaskSystem::ParallelForIndexed(
+      uiFirstFullBlock, uiEndFullBlock - uiFirstFullBlock, [pData = &data](ezUInt32 uiStartBlock, ezUInt32 uiEndBlock) {
+        const ezArchiveBlockTable& blockTable = *pData->m_pBlockTable;
+
+        for (ezUInt32 uiBlock = uiStartBlock; uiBlock < uiEndBlock; ++uiBlock)
+        {
+          const ezUInt64 uiBlockStart = static_cast<ezUInt64>(uiBlock) * blockTable.GetBlockSize();
+          ezByteArrayPtr output(pData->m_pOutput + (uiBlockStart - pData->m_uiOffset), blockTable.GetUncompressedBlockSize(uiBlock));
+
+          if (blockTable.DecompressBlock(uiBlock, output).Failed())
+          {
+            pData->m_iNumFailed.Increment();
+          }
+        }
+      },
+      "ReadArchiveBlocks", ezTaskNesting::Maybe, params);
+
+    if (data.m_iNumFailed > 0)
+      return 0;
+  }
+
+  return uiBytesToRead;
+}
+
 void ezArchiveUtils::ConfigureRawMemoryStreamReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData, ezRawMemoryStreamReader& ref_memReader)
 {
   ref_memReader.Reset(ezMemoryUtils::AddByteOffset(pStartOfArchiveData, static_cast<std::ptrdiff_t>(entry.m_uiDataStartOffset)), entry.m_uiStoredDataSize);
@@ -57,8 +57,10 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
   const ezArchiveEntry* pEntry = &toc.m_Entries[uiEntryIndex];
 
   ArchiveReaderCommon* pReader = nullptr;
+  ArchiveReaderDict* pDictReader = nullptr;
 
   {
+    // only the reader lookup is locked, the entry data is prepared afterwards, so that other files can be opened in parallel
     EZ_LOCK(m_ReaderMutex);
 
     switch (pEntry->m_CompressionMode)
@@ -75,6 +77,46 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
           m_ReadersUncompressed.PushBack(EZ_DEFAULT_NEW(ArchiveReaderUncompressed, 0));
           pReader = m_ReadersUncompressed.PeekBack().Borrow();
         }
+
+        static_cast<ArchiveReaderUncompressed*>(pReader)->m_MappedData = m_ArchiveReader.GetRawEntryData(uiEntryIndex);
+        break;
+      }
+
+      case ezArchiveCompressionMode::Compressed_zstd_blocks:
+      {
+        if (!m_FreeReadersBlocks.IsEmpty())
+        {
+          pReader = m_FreeReadersBlocks.PeekBack();
+          m_FreeReadersBlocks.PopBack();
+        }
+        else
+        {
+          m_ReadersBlocks.PushBack(EZ_DEFAULT_NEW(ArchiveReaderBlocks, 3));
+          pReader = m_ReadersBlocks.PeekBack().Borrow();
+        }
+
+        if (m_ArchiveReader.ConfigureBlockReader(uiEntryIndex, static_cast<ArchiveReaderBlocks*>(pReader)->m_BlockReader).Failed())
+        {
+          m_FreeReadersBlocks.PushBack(static_cast<ArchiveReaderBlocks*>(pReader));
+          return nullptr;
+        }
+        break;
+      }
+
+      case ezArchiveCompressionMode::Compressed_zstd_dict:
+      {
+        if (!m_FreeReadersDict.IsEmpty())
+        {
+          pReader = m_FreeReadersDict.PeekBack();
+          m_FreeReadersDict.PopBack();
+        }
+        else
+        {
+          m_ReadersDict.PushBack(EZ_DEFAULT_NEW(ArchiveReaderDict, 4));
+          pReader = m_ReadersDict.PeekBack().Borrow();
+        }
+
+        pDictReader = static_cast<ArchiveReaderDict*>(pReader);
         break;
       }
 
@@ -117,6 +159,19 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
     }
   }
 
+  if (pDictReader != nullptr)
+  {
+    // dictionary compressed entries are decompressed entirely when they are opened
+    pDictReader->m_DecompressedData.SetCountUninitialized(static_cast<ezUInt32>(pEntry->m_uiUncompressedDataSize));
+
+    if (m_ArchiveReader.ReadEntryData(uiEntryIndex, 0, pDictReader->m_DecompressedData.GetArrayPtr()) != pEntry->m_uiUncompressedDataSize)
+    {
+      EZ_LOCK(m_ReaderMutex);
+      m_FreeReadersDict.PushBack(pDictReader);
+      return nullptr;
+    }
+  }
+
   pReader->m_uiUncompressedSize = pEntry->m_uiUncompressedDataSize;
   pReader->m_uiCompressedSize = pEntry->m_uiStoredDataSize;
 
@@ -249,6 +304,18 @@ void ezDataDirectory::ArchiveType::OnReaderWriterClose(ezDataDirectoryReaderWrit
     return;
   }
 
+  if (pClosed->GetDataDirUserData() == 3)
+  {
+    m_FreeReadersBlocks.PushBack(static_cast<ArchiveReaderBlocks*>(pClosed));
+    return;
+  }
+
+  if (pClosed->GetDataDirUserData() == 4)
+  {
+    m_FreeReadersDict.PushBack(static_cast<ArchiveReaderDict*>(pClosed));
+    return;
+  }
+
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
   if (pClosed->GetDataDirUserData() == 1)
   {
@@ -313,6 +380,70 @@ void ezDataDirectory::ArchiveReaderUncompressed::InternalClose()
 
 //////////////////////////////////////////////////////////////////////////
 
+ezDataDirectory::ArchiveReaderBlocks::ArchiveReaderBlocks(ezInt32 iDataDirUserData)
+  : ArchiveReaderCommon(iDataDirUserData)
+{
+}
+
+ezUInt64 ezDataDirectory::ArchiveReaderBlocks::Skip(ezUInt64 uiBytes)
+{
+  return m_BlockReader.SkipBytes(uiBytes);
+}
+
+ezUInt64 ezDataDirectory::ArchiveReaderBlocks::Read(void* pBuffer, ezUInt64 uiBytes)
+{
+  return m_BlockReader.ReadBytes(pBuffer, uiBytes);
+}
+
+ezResult ezDataDirectory::ArchiveReaderBlocks::InternalOpen(ezFileShareMode::Enum FileShareMode)
+{
+  EZ_IGNORE_UNUSED(FileShareMode);
+  EZ_ASSERT_DEBUG(FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
+
+  // the block reader is configured by ArchiveType::OpenFileToRead()
+  return EZ_SUCCESS;
+}
+
+void ezDataDirectory::ArchiveReaderBlocks::InternalClose()
+{
+  // nothing to do
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezDataDirectory::ArchiveReaderDict::ArchiveReaderDict(ezInt32 iDataDirUserData)
+  : ArchiveReaderCommon(iDataDirUserData)
+{
+}
+
+ezUInt64 ezDataDirectory::ArchiveReaderDict::Skip(ezUInt64 uiBytes)
+{
+  return m_DecompressedReader.SkipBytes(uiBytes);
+}
+
+ezUInt64 ezDataDirectory::ArchiveReaderDict::Read(void* pBuffer, ezUInt64 uiBytes)
+{
+  return m_DecompressedReader.ReadBytes(pBuffer, uiBytes);
+}
+
+ezResult ezDataDirectory::ArchiveReaderDict::InternalOpen(ezFileShareMode::Enum FileShareMode)
+{
+  EZ_IGNORE_UNUSED(FileShareMode);
+  EZ_ASSERT_DEBUG(FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
+
+  // the data was already decompressed by ArchiveType::OpenFileToRead()
+  m_DecompressedReader.Reset(m_DecompressedData.GetData(), m_DecompressedData.GetCount());
+  return EZ_SUCCESS;
+}
+
+void ezDataDirectory::ArchiveReaderDict::InternalClose()
+{
+  // keep the buffer around, the reader gets reused for other files
+  m_DecompressedReader.Reset(nullptr, 0);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
 ezDataDirectory::ArchiveReaderZstd::ArchiveReaderZstd(ezInt32 iDataDirUserData)
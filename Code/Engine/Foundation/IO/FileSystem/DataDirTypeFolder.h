@@ -1,10 +1,14 @@
 #pragma once
 
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
+#include <Foundation/IO/DirectoryWatcher.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/ReadWriteLock.h>
+#include <Foundation/Types/UniquePtr.h>
 
 namespace ezDataDirectory
 {
@@ -14,6 +18,10 @@ namespace ezDataDirectory
   /// \brief A data directory type to handle access to ordinary files.
   ///
   /// Register the 'Factory' function at ezFileSystem to allow it to mount local directories.
+  ///
+  /// If s_bCacheExistingFiles is enabled, the data directory remembers which files exist and which don't, so that looking up the same
+  /// file again doesn't need to query the OS. Changes that are made through the data directory update the cache directly, all other
+  /// changes are detected with an ezDirectoryWatcher.
   class EZ_FOUNDATION_DLL FolderType : public ezDataDirectoryType
   {
   public:
@@ -39,6 +47,18 @@ namespace ezDataDirectory
 
     virtual const ezString128& GetRedirectedDataDirectoryPath() const override { return m_sRedirectedDataDirPath; }
 
+    /// \brief Whether data directories that are mounted from now on cache which files exist.
+    ///
+    /// Only has an effect on platforms that support EZ_SUPPORTS_DIRECTORY_WATCHER, since the cache relies on a directory watcher
+    /// to notice files that are added or removed by other processes. The watcher reports these changes asynchronously, so a file that
+    /// another process just wrote may still be reported as missing for a short while. Every data directory also gets its own recursive
+    /// watcher. Therefore this is disabled by default and should only be enabled when the data doesn't change while the application runs,
+    /// e.g. for packaged games.
+    static bool s_bCacheExistingFiles;
+
+    /// \brief Forgets everything that was cached about which files exist.
+    void ClearFileCache();
+
   protected:
     // The implementations of the abstract functions.
 
@@ -49,6 +69,7 @@ namespace ezDataDirectory
     virtual void RemoveDataDirectory() override;
     virtual void DeleteFile(ezStringView sFile) override;
     virtual bool ExistsFile(ezStringView sFile, bool bOneSpecificDataDir) override;
+    virtual ezResult ResolveFile(ezStringView sFile, bool bSpecificallyThisDataDir, ezStringBuilder& out_sDataDirRelativePath) override;
     virtual ezResult GetFileStats(ezStringView sFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats) override;
     virtual FolderReader* CreateFolderReader() const;
     virtual FolderWriter* CreateFolderWriter() const;
@@ -61,6 +82,12 @@ namespace ezDataDirectory
 
     void LoadRedirectionFile();
 
+    bool IsFileCacheEnabled() const;
+    void GetFileCacheKey(ezStringView sFile, ezStringBuilder& out_sKey) const;
+    bool LookupFileCache(ezStringView sKey, bool& out_bExists, ezUInt32& out_uiGeneration);
+    void StoreInFileCache(ezStringView sKey, bool bExists, ezUInt32 uiGeneration);
+    void ProcessDirectoryChanges();
+
     mutable ezMutex m_ReaderWriterMutex; ///< Locks m_Readers / m_Writers as well as the m_bIsInUse flag of each reader / writer.
     ezHybridArray<ezDataDirectory::FolderReader*, 4> m_Readers;
     ezHybridArray<ezDataDirectory::FolderWriter*, 4> m_Writers;
@@ -68,6 +95,15 @@ namespace ezDataDirectory
     mutable ezMutex m_RedirectionMutex;
     ezMap<ezString, ezString> m_FileRedirection;
     ezString128 m_sRedirectedDataDirPath;
+
+    mutable ezReadWriteLock m_FileCacheLock; ///< Locks m_FileCache and m_uiFileCacheGeneration.
+    ezHashTable<ezString, bool> m_FileCache; ///< Maps absolute file paths to whether the file exists.
+    ezUInt32 m_uiFileCacheGeneration = 0;    ///< Incremented whenever entries are invalidated, so that outdated results are not stored.
+
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    ezMutex m_WatcherMutex;
+    ezUniquePtr<ezDirectoryWatcher> m_pWatcher; ///< Only set when the file cache is enabled.
+#endif
   };
 
 
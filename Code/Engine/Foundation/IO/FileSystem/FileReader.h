@@ -35,12 +35,26 @@ public:
 
   /// \brief Helper method to skip a number of bytes. Returns the actual number of bytes skipped.
   virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override;
+
+  /// \brief Returns whether the file content is directly accessible in memory-mapped storage, see ReadBytesZeroCopy().
+  ///
+  /// This is the case for files that are stored uncompressed in an ezArchive.
+  bool SupportsZeroCopyReads() const { return !m_MappedData.IsEmpty(); }
+
+  /// \brief Returns a view of the next \a uiBytesToRead bytes of the file without copying them and advances the read position accordingly.
+  ///
+  /// Must only be called when SupportsZeroCopyReads() returns true. The view is smaller than requested, if the end of the file is reached.
+  /// The memory is only guaranteed to stay valid until the file is closed, so keep the reader open for as long as the view is used.
+  ezConstByteArrayPtr ReadBytesZeroCopy(ezUInt32 uiBytesToRead);
+
   /// \brief Whether the end of the file was reached during reading.
   ///
   /// \note This is not 100% accurate, it does not guarantee that if it returns false, that the next read will return any data.
   bool IsEOF() const { return m_bEOF; }
 
 private:
+  ezConstByteArrayPtr m_MappedData;
+  ezUInt32 m_uiMappedReadPosition = 0;
   ezUInt64 m_uiBytesCached = 0;
   ezUInt64 m_uiCacheReadPosition = 0;
   ezDynamicArray<ezUInt8> m_Cache;
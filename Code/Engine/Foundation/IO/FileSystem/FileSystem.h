@@ -6,6 +6,7 @@
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/ReadWriteLock.h>
 
 /// \brief The ezFileSystem provides high-level functionality to manage files in a virtual file system.
 ///
@@ -34,11 +35,14 @@
 /// This allows to hook into the system and implement stuff like automatic asset transformations before/after certain
 /// file accesses, checking out files from revision control systems, or simply logging all file activity.
 ///
-/// All operations that go through the ezFileSystem are protected by a mutex, which means that opening, closing, deleting
-/// files, as well as adding or removing data directories etc. will be synchronized and cannot happen in parallel.
-/// Reading/writing file streams can happen in parallel, only the administrative tasks need to be protected.
+/// Operations that only look files up (opening files for reading, ExistsFile, GetFileStats, ResolvePath, etc.) can run on
+/// many threads in parallel. Operations that modify files (opening files for writing, deleting files) are protected by a mutex
+/// and are synchronized with each other. Adding or removing data directories waits until no other thread accesses the
+/// file system. Reading/writing file streams can happen in parallel, only the administrative tasks need to be protected.
 /// File events are broadcast as they occur, that means they will be executed on whichever thread triggered them.
-/// Since they are executed from within the filesystem mutex, they cannot occur in parallel.
+/// The event is protected by its own mutex, so handlers are never executed in parallel. However, events about file lookups
+/// (e.g. OpenFileAttempt) are broadcast while the data directories are locked for reading, and other threads may look up files at the same time.
+/// Therefore event handlers must not add or remove data directories, that would dead-lock (and asserts in development builds).
 class EZ_FOUNDATION_DLL ezFileSystem
 {
 public:
@@ -185,6 +189,9 @@ public:
 
   /// \brief Returns the (recursive) mutex that is used internally by the file system which can be used to guard bundled operations on the file
   /// system.
+  ///
+  /// The mutex synchronizes all operations that modify files or data directories. Operations that only look files up (e.g. opening
+  /// files for reading or ExistsFile()) don't lock it.
   static ezMutex& GetMutex();
 
 #if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
@@ -300,7 +307,8 @@ private:
     ezHybridArray<ezDataDirectoryInfo, 16> m_DataDirectories;
 
     ezEvent<const FileEvent&, ezMutex> m_Event;
-    ezMutex m_FsMutex;
+    ezMutex m_FsMutex;                     ///< Serializes operations that modify files or data directories.
+    mutable ezReadWriteLock m_DataDirLock; ///< Held shared while data directories are accessed, exclusively while they are added or removed.
   };
 
   /// \brief Extracts the root name in a rooted path, e.g. for ":bin/stuff" it would extract "bin". Returns the relative path (here "stuff") or an empty string if it is a root only.
@@ -27,6 +27,17 @@ bool ezDataDirectoryType::ExistsFile(ezStringView sFile, bool bOneSpecificDataDi
   return ezOSFile::ExistsFile(sPath);
 }
 
+ezResult ezDataDirectoryType::ResolveFile(ezStringView sFile, bool bSpecificallyThisDataDir, ezStringBuilder& out_sDataDirRelativePath)
+{
+  ezDataDirectoryReader* pReader = OpenFileToRead(sFile, ezFileShareMode::SharedReads, bSpecificallyThisDataDir);
+  if (pReader == nullptr)
+    return EZ_FAILURE;
+
+  out_sDataDirRelativePath = pReader->GetFilePath();
+  pReader->Close();
+  return EZ_SUCCESS;
+}
+
 void ezDataDirectoryReaderWriterBase::Close()
 {
   InternalClose();
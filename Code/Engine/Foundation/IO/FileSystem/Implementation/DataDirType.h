@@ -97,6 +97,13 @@ protected:
   /// An optimized implementation might look this information up in some hash-map.
   virtual bool ExistsFile(ezStringView sFile, bool bOneSpecificDataDir);
 
+  /// \brief Checks whether the given file exists in this data directory and returns its path relative to the data directory, after
+  /// asset redirection. Used by ezFileSystem::ResolvePath.
+  ///
+  /// The default implementation opens the file for reading. Data directory types that know more cheaply whether a file exists should
+  /// override this.
+  virtual ezResult ResolveFile(ezStringView sFile, bool bSpecificallyThisDataDir, ezStringBuilder& out_sDataDirRelativePath);
+
   /// \brief Upon success returns the ezFileStats for a file in this data directory.
   virtual ezResult GetFileStats(ezStringView sFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats) = 0;
 
@@ -212,6 +219,12 @@ public:
 
     return uiBytesSkipped;
   }
+
+  /// \brief Returns the entire content of the file, if it is available uncompressed in memory-mapped storage. Returns an empty view otherwise.
+  ///
+  /// The returned memory is only guaranteed to stay valid until the reader is closed, since closed readers may be reused for other files.
+  /// Readers that return a view here allow ezFileReader to read without copying the data into an intermediate cache.
+  virtual ezConstByteArrayPtr GetMappedData() const { return ezConstByteArrayPtr(); }
 };
 
 /// \brief A base class for writers that handle writing to a (virtual) file inside a data directory.
@@ -23,6 +23,10 @@ namespace ezDataDirectory
 {
   ezString FolderType::s_sRedirectionFile;
   ezString FolderType::s_sRedirectionPrefix;
+  bool FolderType::s_bCacheExistingFiles = false;
+
+  // Caching negative results for arbitrary lookups could grow the cache without limit, so it is simply cleared when it gets this large.
+  static constexpr ezUInt32 s_uiMaxFileCacheEntries = 1024 * 64;
 
   ezResult FolderReader::InternalOpen(ezFileShareMode::Enum FileShareMode)
   {
@@ -128,10 +132,24 @@ namespace ezDataDirectory
     sPath.AppendPath(sFile);
 
     ezOSFile::DeleteFile(sPath.GetData()).IgnoreResult();
+
+    if (IsFileCacheEnabled())
+    {
+      ezStringBuilder sKey;
+      GetFileCacheKey(sFile, sKey);
+
+      EZ_LOCK(m_FileCacheLock);
+      ++m_uiFileCacheGeneration;
+      m_FileCache[sKey] = false;
+    }
   }
 
   FolderType::~FolderType()
   {
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    m_pWatcher.Clear();
+#endif
+
     EZ_LOCK(m_ReaderWriterMutex);
     for (ezUInt32 i = 0; i < m_Readers.GetCount(); ++i)
       EZ_DEFAULT_DELETE(m_Readers[i]);
@@ -205,14 +223,123 @@ namespace ezDataDirectory
 
   bool FolderType::ExistsFile(ezStringView sFile, bool bOneSpecificDataDir)
   {
-    EZ_IGNORE_UNUSED(bOneSpecificDataDir);
-
     ezStringBuilder sRedirectedAsset;
-    ResolveAssetRedirection(sFile, sRedirectedAsset);
+    return ResolveFile(sFile, bOneSpecificDataDir, sRedirectedAsset).Succeeded();
+  }
 
-    ezStringBuilder sPath = GetRedirectedDataDirectoryPath();
-    sPath.AppendPath(sRedirectedAsset);
-    return ezOSFile::ExistsFile(sPath);
+  ezResult FolderType::ResolveFile(ezStringView sFile, bool bSpecificallyThisDataDir, ezStringBuilder& out_sDataDirRelativePath)
+  {
+    EZ_IGNORE_UNUSED(bSpecificallyThisDataDir);
+
+    ResolveAssetRedirection(sFile, out_sDataDirRelativePath);
+
+    if (!IsFileCacheEnabled())
+    {
+      ezStringBuilder sPath = GetRedirectedDataDirectoryPath();
+      sPath.AppendPath(out_sDataDirRelativePath);
+      return ezOSFile::ExistsFile(sPath) ? EZ_SUCCESS : EZ_FAILURE;
+    }
+
+    ezStringBuilder sKey;
+    GetFileCacheKey(out_sDataDirRelativePath, sKey);
+
+    bool bExists = false;
+    ezUInt32 uiGeneration = 0;
+    if (!LookupFileCache(sKey, bExists, uiGeneration))
+    {
+      bExists = ezOSFile::ExistsFile(sKey);
+      StoreInFileCache(sKey, bExists, uiGeneration);
+    }
+
+    return bExists ? EZ_SUCCESS : EZ_FAILURE;
+  }
+
+  bool FolderType::IsFileCacheEnabled() const
+  {
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    return m_pWatcher != nullptr;
+#else
+    return false;
+#endif
+  }
+
+  void FolderType::GetFileCacheKey(ezStringView sFile, ezStringBuilder& out_sKey) const
+  {
+    out_sKey = GetRedirectedDataDirectoryPath();
+    out_sKey.AppendPath(sFile);
+    out_sKey.MakeCleanPath();
+
+#if EZ_ENABLED(EZ_SUPPORTS_CASE_INSENSITIVE_PATHS)
+    out_sKey.ToLower();
+#endif
+  }
+
+  bool FolderType::LookupFileCache(ezStringView sKey, bool& out_bExists, ezUInt32& out_uiGeneration)
+  {
+    ProcessDirectoryChanges();
+
+    EZ_LOCK_SHARED(m_FileCacheLock);
+    out_uiGeneration = m_uiFileCacheGeneration;
+    return m_FileCache.TryGetValue(sKey, out_bExists);
+  }
+
+  void FolderType::StoreInFileCache(ezStringView sKey, bool bExists, ezUInt32 uiGeneration)
+  {
+    EZ_LOCK(m_FileCacheLock);
+
+    // something was invalidated since the OS was queried, the result may already be outdated
+    if (uiGeneration != m_uiFileCacheGeneration)
+      return;
+
+    if (m_FileCache.GetCount() >= s_uiMaxFileCacheEntries)
+    {
+      m_FileCache.Clear();
+    }
+
+    m_FileCache[sKey] = bExists;
+  }
+
+  void FolderType::ClearFileCache()
+  {
+    EZ_LOCK(m_FileCacheLock);
+    ++m_uiFileCacheGeneration;
+    m_FileCache.Clear();
+  }
+
+  void FolderType::ProcessDirectoryChanges()
+  {
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    // if another thread is already polling the watcher, there is no need to wait for it
+    if (m_WatcherMutex.TryLock().Failed())
+      return;
+
+    ezStringBuilder sKey;
+    m_pWatcher->EnumerateChanges([&](ezStringView sFilename, ezDirectoryWatcherAction action, ezDirectoryWatcherType type)
+      {
+        if (action == ezDirectoryWatcherAction::None || action == ezDirectoryWatcherAction::Modified)
+          return;
+
+        if (type == ezDirectoryWatcherType::Directory)
+        {
+          // whole directories were added, removed or renamed, don't bother figuring out which entries are affected
+          ClearFileCache();
+          return;
+        }
+
+        sKey = sFilename;
+        sKey.MakeCleanPath();
+
+#  if EZ_ENABLED(EZ_SUPPORTS_CASE_INSENSITIVE_PATHS)
+        sKey.ToLower();
+#  endif
+
+        EZ_LOCK(m_FileCacheLock);
+        ++m_uiFileCacheGeneration;
+        m_FileCache.Remove(sKey);
+      });
+
+    m_WatcherMutex.Unlock();
+#endif
   }
 
   ezResult FolderType::GetFileStats(ezStringView sFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats)
@@ -265,6 +392,19 @@ namespace ezDataDirectory
 
     ReloadExternalConfigs();
 
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    if (s_bCacheExistingFiles)
+    {
+      m_pWatcher = EZ_DEFAULT_NEW(ezDirectoryWatcher);
+
+      // without a watcher, changes from other processes would go unnoticed, so the cache stays disabled
+      if (m_pWatcher->OpenDirectory(m_sRedirectedDataDirPath, ezDirectoryWatcher::Watch::Creates | ezDirectoryWatcher::Watch::Deletes | ezDirectoryWatcher::Watch::Renames | ezDirectoryWatcher::Watch::Subdirectories).Failed())
+      {
+        m_pWatcher.Clear();
+      }
+    }
+#endif
+
     return EZ_SUCCESS;
   }
 
@@ -304,6 +444,23 @@ namespace ezDataDirectory
     if (ezConversionUtils::IsStringUuid(sFileToOpen))
       return nullptr;
 
+    const bool bUseFileCache = IsFileCacheEnabled();
+    bool bIsCached = false;
+    ezUInt32 uiGeneration = 0;
+    ezStringBuilder sKey;
+
+    if (bUseFileCache)
+    {
+      GetFileCacheKey(sFileToOpen, sKey);
+
+      bool bExists = false;
+      bIsCached = LookupFileCache(sKey, bExists, uiGeneration);
+
+      // this file is known not to exist, the OS doesn't need to be asked again
+      if (bIsCached && !bExists)
+        return nullptr;
+    }
+
     FolderReader* pReader = nullptr;
     {
       EZ_LOCK(m_ReaderWriterMutex);
@@ -324,11 +481,25 @@ namespace ezDataDirectory
     // if opening the file fails, the reader's m_bIsInUse needs to be reset.
     if (pReader->Open(sFileToOpen, this, FileShareMode) == EZ_FAILURE)
     {
-      EZ_LOCK(m_ReaderWriterMutex);
-      pReader->m_bIsInUse = false;
+      {
+        EZ_LOCK(m_ReaderWriterMutex);
+        pReader->m_bIsInUse = false;
+      }
+
+      // opening may also fail for existing files (e.g. due to the share mode), so only remember it as missing, if it really is
+      if (bUseFileCache && !bIsCached)
+      {
+        StoreInFileCache(sKey, ezOSFile::ExistsFile(sKey), uiGeneration);
+      }
+
       return nullptr;
     }
 
+    if (bUseFileCache && !bIsCached)
+    {
+      StoreInFileCache(sKey, true, uiGeneration);
+    }
+
     // if it succeeds, we return the reader
     return pReader;
   }
@@ -389,6 +560,16 @@ namespace ezDataDirectory
       return nullptr;
     }
 
+    if (IsFileCacheEnabled())
+    {
+      ezStringBuilder sKey;
+      GetFileCacheKey(sFile, sKey);
+
+      EZ_LOCK(m_FileCacheLock);
+      ++m_uiFileCacheGeneration;
+      m_FileCache[sKey] = true;
+    }
+
     // if it succeeds, we return the reader
     return pWriter;
   }
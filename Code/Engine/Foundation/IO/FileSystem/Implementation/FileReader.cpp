@@ -14,7 +14,11 @@ ezResult ezFileReader::Open(ezStringView sFile, ezUInt32 uiCacheSize /*= 1024 *
   if (!m_pDataDirReader)
     return EZ_FAILURE;
 
-  m_Cache.SetCountUninitialized(uiCacheSize);
+  // if the file is available in mapped memory, it is read from there directly and no cache is needed
+  m_MappedData = m_pDataDirReader->GetMappedData();
+  m_uiMappedReadPosition = 0;
+
+  m_Cache.SetCountUninitialized(m_MappedData.IsEmpty() ? uiCacheSize : 0);
 
   m_uiCacheReadPosition = 0;
   m_uiBytesCached = 0;
@@ -29,15 +33,38 @@ void ezFileReader::Close()
     m_pDataDirReader->Close();
 
   m_pDataDirReader = nullptr;
+  m_MappedData = ezConstByteArrayPtr();
   m_bEOF = true;
 }
 
+ezConstByteArrayPtr ezFileReader::ReadBytesZeroCopy(ezUInt32 uiBytesToRead)
+{
+  EZ_ASSERT_DEV(m_pDataDirReader != nullptr, "The file has not been opened (successfully).");
+  EZ_ASSERT_DEV(SupportsZeroCopyReads(), "Zero-copy reads are not supported for file '{}'", m_pDataDirReader->GetFilePath().GetView());
+
+  const ezUInt32 uiBytesRead = ezMath::Min(uiBytesToRead, m_MappedData.GetCount() - m_uiMappedReadPosition);
+  const ezConstByteArrayPtr result = m_MappedData.GetSubArray(m_uiMappedReadPosition, uiBytesRead);
+
+  m_uiMappedReadPosition += uiBytesRead;
+  m_bEOF = m_uiMappedReadPosition == m_MappedData.GetCount();
+
+  return result;
+}
+
 ezUInt64 ezFileReader::SkipBytes(ezUInt64 uiBytesToSkip)
 {
   EZ_ASSERT_DEV(m_pDataDirReader != nullptr, "The file has not been opened (successfully).");
   if (m_bEOF)
     return 0;
 
+  if (!m_MappedData.IsEmpty())
+  {
+    const ezUInt32 uiBytesSkipped = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiBytesToSkip, m_MappedData.GetCount() - m_uiMappedReadPosition));
+    m_uiMappedReadPosition += uiBytesSkipped;
+    m_bEOF = m_uiMappedReadPosition == m_MappedData.GetCount();
+    return uiBytesSkipped;
+  }
+
   ezUInt64 uiSkipPosition = 0; // how much was skipped, yet
 
   // if any data is still in the cache, skip that first
@@ -72,6 +99,15 @@ ezUInt64 ezFileReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
   if (m_bEOF)
     return 0;
 
+  if (!m_MappedData.IsEmpty())
+  {
+    const ezUInt32 uiBytesRead = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiBytesToRead, m_MappedData.GetCount() - m_uiMappedReadPosition));
+    ezMemoryUtils::RawByteCopy(pReadBuffer, m_MappedData.GetPtr() + m_uiMappedReadPosition, uiBytesRead);
+    m_uiMappedReadPosition += uiBytesRead;
+    m_bEOF = m_uiMappedReadPosition == m_MappedData.GetCount();
+    return uiBytesRead;
+  }
+
   ezUInt64 uiBufferPosition = 0; // how much was read, yet
   ezUInt8* pBuffer = (ezUInt8*)pReadBuffer;
 
@@ -34,6 +34,7 @@ void ezFileSystem::RegisterDataDirectoryFactory(ezDataDirFactory factory, float
   // The code would crash below anyways but asserts are easier to see in automated testing on e.g. CI.
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
+  EZ_LOCK(s_pData->m_DataDirLock);
   EZ_LOCK(s_pData->m_FsMutex);
 
   auto& data = s_pData->m_DataDirFactories.ExpandAndGetRef();
@@ -92,6 +93,7 @@ ezResult ezFileSystem::AddDataDirectory(ezStringView sDataDirectory, ezStringVie
   ezStringBuilder sCleanRootName = sRootName;
   CleanUpRootName(sCleanRootName);
 
+  EZ_LOCK(s_pData->m_DataDirLock);
   EZ_LOCK(s_pData->m_FsMutex);
 
   bool failed = false;
@@ -156,6 +158,7 @@ bool ezFileSystem::RemoveDataDirectory(ezStringView sRootName)
   CleanUpRootName(sCleanRootName);
 
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
+  EZ_LOCK(s_pData->m_DataDirLock);
   EZ_LOCK(s_pData->m_FsMutex);
 
   for (ezUInt32 i = 0; i < s_pData->m_DataDirectories.GetCount();)
@@ -191,6 +194,7 @@ ezUInt32 ezFileSystem::RemoveDataDirectoryGroup(ezStringView sGroup)
   if (s_pData == nullptr)
     return 0;
 
+  EZ_LOCK(s_pData->m_DataDirLock);
   EZ_LOCK(s_pData->m_FsMutex);
 
   ezUInt32 uiRemoved = 0;
@@ -225,6 +229,7 @@ void ezFileSystem::ClearAllDataDirectories()
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
+  EZ_LOCK(s_pData->m_DataDirLock);
   EZ_LOCK(s_pData->m_FsMutex);
 
   for (ezInt32 i = s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
@@ -251,7 +256,7 @@ const ezDataDirectoryInfo* ezFileSystem::FindDataDirectoryWithRoot(ezStringView
     return nullptr;
 
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_SHARED(s_pData->m_DataDirLock);
 
   for (const auto& dd : s_pData->m_DataDirectories)
   {
@@ -288,7 +293,7 @@ const ezDataDirectoryInfo& ezFileSystem::GetDataDirectoryInfo(ezUInt32 uiDataDir
 ezStringView ezFileSystem::GetDataDirRelativePath(ezStringView sPath, ezUInt32 uiDataDir)
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_SHARED(s_pData->m_DataDirLock);
 
   // if an absolute path is given, this will check whether the absolute path would fall into this data directory
   // if yes, the prefix path is removed and then only the relative path is given to the data directory type
@@ -335,7 +340,7 @@ ezStringView ezFileSystem::GetDataDirRelativePath(ezStringView sPath, ezUInt32 u
 ezDataDirectoryInfo* ezFileSystem::GetDataDirForRoot(const ezString& sRoot)
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_SHARED(s_pData->m_DataDirLock);
 
   for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
@@ -365,6 +370,7 @@ void ezFileSystem::DeleteFile(ezStringView sFile)
   if (sRootName.IsEmpty())
     return;
 
+  EZ_LOCK_SHARED(s_pData->m_DataDirLock);
   EZ_LOCK(s_pData->m_FsMutex);
 
   for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
@@ -402,7 +408,7 @@ bool ezFileSystem::ExistsFile(ezStringView sFile)
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_SHARED(s_pData->m_DataDirLock);
 
   for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
@@ -423,7 +429,7 @@ ezResult ezFileSystem::GetFileStats(ezStringView sFileOrFolder, ezFileStats& out
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_SHARED(s_pData->m_DataDirLock);
 
   if (sFileOrFolder.IsEmpty())
   {
@@ -467,7 +473,7 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(ezStringView sFile, ezFileSha
   if (sFile.IsEmpty())
     return nullptr;
 
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_SHARED(s_pData->m_DataDirLock);
 
   ezString sRootName;
   sFile = ExtractRootName(sFile, sRootName);
@@ -538,6 +544,7 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(ezStringView sFile, ezFileSha
   if (sFile.IsEmpty())
     return nullptr;
 
+  EZ_LOCK_SHARED(s_pData->m_DataDirLock);
   EZ_LOCK(s_pData->m_FsMutex);
 
   ezString sRootName;
@@ -614,7 +621,7 @@ ezResult ezFileSystem::ResolvePath(ezStringView sPath, ezStringBuilder* out_pAbs
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_SHARED(s_pData->m_DataDirLock);
 
   ezStringBuilder absPath, relPath;
 
@@ -668,31 +675,48 @@ ezResult ezFileSystem::ResolvePath(ezStringView sPath, ezStringBuilder* out_pAbs
   }
   else
   {
-    // try to get a reader -> if we get one, the file does indeed exist
-    ezDataDirectoryReader* pReader = ezFileSystem::GetFileReader(sPath, ezFileShareMode::SharedReads, true);
-
-    if (!pReader)
-      return EZ_FAILURE;
+    // clean up the path to get rid of ".." etc.
+    ezStringBuilder sCleanPath = sPath;
+    sCleanPath.MakeCleanPath();
 
-    if (out_pDataDir != nullptr)
+    // same order and events as GetFileReader(), but the data directories may know whether the file exists without opening it
+    const ezDataDirectoryInfo* pFoundDataDir = nullptr;
+    for (ezUInt32 dd = s_pData->m_DataDirectories.GetCount(); dd > 0; --dd)
     {
-      for (ezUInt32 dd = s_pData->m_DataDirectories.GetCount(); dd > 0; --dd)
+      auto& dir = s_pData->m_DataDirectories[dd - 1];
+      ezStringView sRelPath = GetDataDirRelativePath(sCleanPath, dd - 1);
+
+      FileEvent fe;
+      fe.m_EventType = FileEventType::OpenFileAttempt;
+      fe.m_sFileOrDirectory = sRelPath;
+      fe.m_pDataDir = dir.m_pDataDirType;
+      s_pData->m_Event.Broadcast(fe);
+
+      if (dir.m_pDataDirType->ResolveFile(sRelPath, false, relPath).Succeeded())
       {
-        auto& dir = s_pData->m_DataDirectories[dd - 1];
+        fe.m_EventType = FileEventType::OpenFileSucceeded;
+        s_pData->m_Event.Broadcast(fe);
 
-        if (dir.m_pDataDirType == pReader->GetDataDirectory())
-        {
-          *out_pDataDir = &dir;
-        }
+        pFoundDataDir = &dir;
+        break;
       }
     }
 
-    relPath = pReader->GetFilePath();
+    if (pFoundDataDir == nullptr)
+    {
+      FileEvent fe;
+      fe.m_EventType = FileEventType::OpenFileFailed;
+      fe.m_sFileOrDirectory = sCleanPath;
+      s_pData->m_Event.Broadcast(fe);
+
+      return EZ_FAILURE;
+    }
+
+    if (out_pDataDir != nullptr)
+      *out_pDataDir = pFoundDataDir;
 
-    absPath = pReader->GetDataDirectory()->GetRedirectedDataDirectoryPath(); /// \todo We might also need the none-redirected path as an output
+    absPath = pFoundDataDir->m_pDataDirType->GetRedirectedDataDirectoryPath(); /// \todo We might also need the none-redirected path as an output
     absPath.AppendPath(relPath);
-
-    pReader->Close();
   }
 
   if (out_pAbsolutePath)
@@ -784,7 +808,7 @@ ezResult ezFileSystem::FindFolderWithSubPath(ezStringBuilder& out_sResult, ezStr
 bool ezFileSystem::ResolveAssetRedirection(ezStringView sPathOrAssetGuid, ezStringBuilder& out_sRedirection)
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_SHARED(s_pData->m_DataDirLock);
 
   for (auto& dd : s_pData->m_DataDirectories)
   {
@@ -843,6 +867,7 @@ void ezFileSystem::ReloadAllExternalDataDirectoryConfigs()
   EZ_LOG_BLOCK("ReloadAllExternalDataDirectoryConfigs");
 
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
+  EZ_LOCK_SHARED(s_pData->m_DataDirLock);
   EZ_LOCK(s_pData->m_FsMutex);
 
   for (auto& dd : s_pData->m_DataDirectories)
@@ -860,6 +885,7 @@ void ezFileSystem::Shutdown()
 {
   {
     EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
+    EZ_LOCK(s_pData->m_DataDirLock);
     EZ_LOCK(s_pData->m_FsMutex);
 
     s_pData->m_DataDirFactories.Clear();
@@ -1007,6 +1033,7 @@ ezMutex& ezFileSystem::GetMutex()
 void ezFileSystem::StartSearch(ezFileSystemIterator& ref_iterator, ezStringView sSearchTerm, ezBitflags<ezFileSystemIteratorFlags> flags /*= ezFileSystemIteratorFlags::Default*/)
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
+  EZ_LOCK_SHARED(s_pData->m_DataDirLock);
   EZ_LOCK(s_pData->m_FsMutex);
 
   ezHybridArray<ezString, 16> folders;
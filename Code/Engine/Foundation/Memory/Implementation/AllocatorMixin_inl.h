@@ -84,6 +84,10 @@ void* ezInternal::ezAllocatorImpl<A, TrackingMode>::Allocate(size_t uiSize, size
   {
     ezMemoryTracker::AddAllocation(this->m_Id, TrackingMode, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
   }
+  else if constexpr (TrackingMode == ezAllocatorTrackingMode::Sampling)
+  {
+    ezMemoryTracker::SampleAllocation(ptr, uiSize);
+  }
 
   return ptr;
 }
@@ -95,6 +99,10 @@ void ezInternal::ezAllocatorImpl<A, TrackingMode>::Deallocate(void* pPtr)
   {
     ezMemoryTracker::RemoveAllocation(this->m_Id, pPtr);
   }
+  else if constexpr (TrackingMode == ezAllocatorTrackingMode::Sampling)
+  {
+    ezMemoryTracker::SampleDeallocation(pPtr);
+  }
 
   m_allocator.Deallocate(pPtr);
 }
@@ -159,6 +167,10 @@ void* ezInternal::ezAllocatorMixinReallocate<A, TrackingMode, true>::Reallocate(
     ezMemoryTracker::RemoveAllocation(this->m_Id, pPtr);
     fAllocationTime = ezTime::Now();
   }
+  else if constexpr (TrackingMode == ezAllocatorTrackingMode::Sampling)
+  {
+    ezMemoryTracker::SampleDeallocation(pPtr);
+  }
 
   void* pNewMem = this->m_allocator.Reallocate(pPtr, uiCurrentSize, uiNewSize, uiAlign);
 
@@ -166,6 +178,10 @@ void* ezInternal::ezAllocatorMixinReallocate<A, TrackingMode, true>::Reallocate(
   {
     ezMemoryTracker::AddAllocation(this->m_Id, TrackingMode, pNewMem, uiNewSize, uiAlign, ezTime::Now() - fAllocationTime);
   }
+  else if constexpr (TrackingMode == ezAllocatorTrackingMode::Sampling)
+  {
+    ezMemoryTracker::SampleAllocation(pNewMem, uiNewSize);
+  }
 
   return pNewMem;
 }
@@ -5,6 +5,7 @@
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Memory/AllocatorWithPolicy.h>
 #include <Foundation/Memory/Policies/AllocPolicyHeap.h>
+#include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Strings/String.h>
 #include <Foundation/System/StackTracer.h>
 #include <Foundation/Threading/Lock.h>
@@ -203,10 +204,14 @@ void ezMemoryTracker::AddAllocation(ezAllocatorId allocatorId, ezAllocatorTracki
     ezMemoryUtils::Copy(stackTrace.GetPtr(), pBuffer, uiNumTraces);
   }
 
+  // the allocator is alive while it allocates, so its name can be used after the lock is released
+  const char* szAllocatorName = nullptr;
+
   {
     EZ_LOCK(*s_pTrackerData);
 
     AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+    szAllocatorName = data.m_sName.GetData();
     data.m_Stats.m_uiNumAllocations++;
     data.m_Stats.m_uiAllocationSize += uiSize;
     data.m_Stats.m_uiPerFrameAllocationSize += uiSize;
@@ -226,12 +231,16 @@ void ezMemoryTracker::AddAllocation(ezAllocatorId allocatorId, ezAllocatorTracki
       EZ_TRACY_ALLOC(pPtr, uiSize, data.m_sName.GetData());
     }
   }
+
+  ezProfilingSystem::AddMemoryEvent(szAllocatorName, uiSize, true);
 }
 
 // static
 void ezMemoryTracker::RemoveAllocation(ezAllocatorId allocatorId, const void* pPtr)
 {
   ezArrayPtr<void*> stackTrace;
+  const char* szAllocatorName = nullptr;
+  ezUInt64 uiSize = 0;
 
   {
     EZ_LOCK(*s_pTrackerData);
@@ -244,6 +253,9 @@ void ezMemoryTracker::RemoveAllocation(ezAllocatorId allocatorId, const void* pP
       data.m_Stats.m_uiNumDeallocations++;
       data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
 
+      szAllocatorName = data.m_sName.GetData();
+      uiSize = info.m_uiSize;
+
       stackTrace = info.GetStackTrace();
 
       if (data.m_TrackingMode >= ezAllocatorTrackingMode::AllocationStatsAndStacktraces)
@@ -261,6 +273,11 @@ void ezMemoryTracker::RemoveAllocation(ezAllocatorId allocatorId, const void* pP
     }
   }
 
+  if (szAllocatorName != nullptr)
+  {
+    ezProfilingSystem::AddMemoryEvent(szAllocatorName, uiSize, false);
+  }
+
   EZ_DELETE_ARRAY(s_pTrackerDataAllocator, stackTrace);
 }
 
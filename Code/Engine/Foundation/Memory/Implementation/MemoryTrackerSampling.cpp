@@ -0,0 +1,631 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/IO/Stream.h>
+#include <Foundation/Memory/AllocatorWithPolicy.h>
+#include <Foundation/Memory/MemoryTracker.h>
+#include <Foundation/Memory/Policies/AllocPolicyHeap.h>
+#include <Foundation/System/StackTracer.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  // the sampling data must not be sampled itself
+  using SamplingDataAllocator = ezAllocatorWithPolicy<ezAllocPolicyHeap, ezAllocatorTrackingMode::Nothing>;
+
+  SamplingDataAllocator* GetSamplingDataAllocator()
+  {
+    // never destroyed, allocations may be sampled until the very end of the process
+    alignas(EZ_ALIGNMENT_OF(SamplingDataAllocator)) static ezUInt8 s_AllocatorBuffer[sizeof(SamplingDataAllocator)];
+    static SamplingDataAllocator* s_pAllocator = new (s_AllocatorBuffer) SamplingDataAllocator("MemorySampling");
+    return s_pAllocator;
+  }
+
+  struct SamplingDataAllocatorWrapper
+  {
+    EZ_ALWAYS_INLINE static ezAllocator* GetAllocator() { return GetSamplingDataAllocator(); }
+  };
+
+  enum
+  {
+    MAX_STACK_DEPTH = 32,
+    RING_SIZE = 128,         ///< Number of records in the buffer of every thread.
+    FILTER_SIZE = 64 * 1024, ///< Number of counters in the filter of sampled addresses.
+  };
+
+  struct SampleRecord
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const void* m_pPtr;
+    ezUInt64 m_uiSize;
+    ezInt64 m_iSequence;
+    ezUInt32 m_uiStackTraceLength;
+    bool m_bAllocation;
+    void* m_StackTrace[MAX_STACK_DEPTH];
+  };
+
+  /// \brief A ring buffer with a single producer, the owning thread, and a single consumer, whoever holds the mutex of the sampling data.
+  struct ThreadSamples
+  {
+    ezAtomicInteger64 m_iWriteIndex;
+    ezAtomicInteger64 m_iReadIndex;
+    SampleRecord m_Records[RING_SIZE];
+  };
+
+  struct StackTraceData
+  {
+    ezUInt32 m_uiFirstFrame = 0;
+    ezUInt32 m_uiNumFrames = 0;
+    ezUInt64 m_uiLiveCount = 0;
+    ezUInt64 m_uiLiveBytes = 0;
+    ezUInt64 m_uiTotalCount = 0;
+    ezUInt64 m_uiTotalBytes = 0;
+  };
+
+  struct LiveSample
+  {
+    ezUInt64 m_uiSize = 0;
+    ezInt64 m_iSequence = 0;
+    ezUInt32 m_uiStackTrace = 0;
+  };
+
+  /// \brief A deallocation for which no allocation is known (yet).
+  struct OrphanedFree
+  {
+    ezInt64 m_iSequence = 0;
+    ezUInt64 m_uiDrainCount = 0;
+  };
+
+  struct SamplingData
+  {
+    ezMutex m_Mutex;
+    ezDynamicArray<ThreadSamples*, SamplingDataAllocatorWrapper> m_Threads;
+    ezDynamicArray<SampleRecord, SamplingDataAllocatorWrapper> m_Incoming;
+
+    ezHashTable<ezUInt64, ezUInt32, ezHashHelper<ezUInt64>, SamplingDataAllocatorWrapper> m_StackTraceIndices;
+    ezDynamicArray<StackTraceData, SamplingDataAllocatorWrapper> m_StackTraces;
+    ezDynamicArray<void*, SamplingDataAllocatorWrapper> m_Frames;
+
+    ezHashTable<const void*, LiveSample, ezHashHelper<const void*>, SamplingDataAllocatorWrapper> m_LiveSamples;
+    ezHashTable<const void*, OrphanedFree, ezHashHelper<const void*>, SamplingDataAllocatorWrapper> m_OrphanedFrees;
+
+    ezUInt64 m_uiDrainCount = 0;
+    ezUInt64 m_uiNumSamples = 0;
+  };
+
+  SamplingData& GetSamplingData()
+  {
+    alignas(EZ_ALIGNMENT_OF(SamplingData)) static ezUInt8 s_DataBuffer[sizeof(SamplingData)];
+    static SamplingData* s_pData = new (s_DataBuffer) SamplingData();
+    return *s_pData;
+  }
+
+  // All of these are plain data, so that they are zero initialized before any allocation can happen.
+
+  /// Average number of bytes between two samples.
+  ezInt32 s_iSamplingInterval = 512 * 1024;
+
+  /// Orders the records of all threads. Allocations take their number after the memory was allocated,
+  /// deallocations before it is freed, so a reused address always has a higher number than its previous free.
+  ezInt64 s_iSequence = 0;
+
+  /// Counts the live samples per address hash. Deallocations of addresses with a zero count can't be sampled and are ignored
+  /// without touching any shared data. The counts are decremented only once the deallocation was processed, so they may be
+  /// too high for a while, which just means that a few more deallocations are recorded.
+  ezInt32 s_SampledAddressFilter[FILTER_SIZE];
+
+  thread_local ezInt64 s_iBytesUntilSample = 0;
+  thread_local ezUInt64 s_uiRandomState = 0;
+  thread_local ThreadSamples* s_pThreadSamples = nullptr;
+  thread_local bool s_bThreadExited = false;
+
+  EZ_ALWAYS_INLINE ezInt32& GetFilterCounter(const void* pPtr)
+  {
+    const ezUInt32 uiHash = static_cast<ezUInt32>((reinterpret_cast<size_t>(pPtr) >> 4) * 2654435761u);
+    return s_SampledAddressFilter[uiHash >> 16];
+  }
+
+  /// \brief Returns the number of bytes until the next sample. The distances are exponentially distributed, which makes
+  /// sampling a memoryless process: every allocated byte has the same chance to trigger a sample.
+  ezInt64 GetNextSampleDistance()
+  {
+    if (s_uiRandomState == 0)
+    {
+      s_uiRandomState = ezHashingUtils::xxHash64(&s_pThreadSamples, sizeof(void*), (ezUInt64)ezThreadUtils::GetCurrentThreadID()) | 1;
+    }
+
+    // xorshift64*
+    s_uiRandomState ^= s_uiRandomState >> 12;
+    s_uiRandomState ^= s_uiRandomState << 25;
+    s_uiRandomState ^= s_uiRandomState >> 27;
+    const ezUInt64 uiRandom = s_uiRandomState * 0x2545F4914F6CDD1DULL;
+
+    // uniform in (0, 1]
+    const float fUniform = static_cast<float>((uiRandom >> 40) + 1) / static_cast<float>(1 << 24);
+    const float fInterval = static_cast<float>(ezAtomicUtils::Read(s_iSamplingInterval));
+
+    return ezMath::Max<ezInt64>(static_cast<ezInt64>(-ezMath::Ln(fUniform) * fInterval), 1);
+  }
+
+  void CollectRecords(SamplingData& ref_data, ThreadSamples& ref_samples)
+  {
+    const ezInt64 iWriteIndex = ref_samples.m_iWriteIndex;
+
+    for (ezInt64 i = ref_samples.m_iReadIndex; i < iWriteIndex; ++i)
+    {
+      ref_data.m_Incoming.PushBack(ref_samples.m_Records[i % RING_SIZE]);
+    }
+
+    ref_samples.m_iReadIndex = iWriteIndex;
+  }
+
+  ezUInt32 InternStackTrace(SamplingData& ref_data, const SampleRecord& record)
+  {
+    const ezUInt64 uiHash = ezHashingUtils::xxHash64(record.m_StackTrace, record.m_uiStackTraceLength * sizeof(void*));
+
+    // 64 bit hash collisions are unlikely enough to be ignored, the worst case is a wrongly attributed sample
+    ezUInt32 uiIndex = 0;
+    if (!ref_data.m_StackTraceIndices.TryGetValue(uiHash, uiIndex))
+    {
+      uiIndex = ref_data.m_StackTraces.GetCount();
+      ref_data.m_StackTraceIndices.Insert(uiHash, uiIndex);
+
+      StackTraceData& stackTrace = ref_data.m_StackTraces.ExpandAndGetRef();
+      stackTrace.m_uiFirstFrame = ref_data.m_Frames.GetCount();
+      stackTrace.m_uiNumFrames = record.m_uiStackTraceLength;
+      ref_data.m_Frames.PushBackRange(ezArrayPtr<void* const>(record.m_StackTrace, record.m_uiStackTraceLength));
+    }
+
+    return uiIndex;
+  }
+
+  void RemoveLiveSample(SamplingData& ref_data, const void* pPtr, const LiveSample& sample)
+  {
+    StackTraceData& stackTrace = ref_data.m_StackTraces[sample.m_uiStackTrace];
+    stackTrace.m_uiLiveCount--;
+    stackTrace.m_uiLiveBytes -= sample.m_uiSize;
+
+    ref_data.m_LiveSamples.Remove(pPtr);
+    ezAtomicUtils::Decrement(GetFilterCounter(pPtr));
+  }
+
+  void ApplyAllocation(SamplingData& ref_data, const SampleRecord& record)
+  {
+    const ezUInt32 uiStackTrace = InternStackTrace(ref_data, record);
+    ref_data.m_StackTraces[uiStackTrace].m_uiTotalCount++;
+    ref_data.m_StackTraces[uiStackTrace].m_uiTotalBytes += record.m_uiSize;
+    ref_data.m_uiNumSamples++;
+
+    // the allocating thread was drained after the thread that already freed the memory again
+    OrphanedFree orphan;
+    if (ref_data.m_OrphanedFrees.Remove(record.m_pPtr, &orphan) && orphan.m_iSequence > record.m_iSequence)
+    {
+      ezAtomicUtils::Decrement(GetFilterCounter(record.m_pPtr));
+      return;
+    }
+
+    if (const LiveSample* pExisting = ref_data.m_LiveSamples.GetValue(record.m_pPtr))
+    {
+      if (pExisting->m_iSequence > record.m_iSequence)
+      {
+        // a newer allocation at the same address is known, so this one is already dead
+        ezAtomicUtils::Decrement(GetFilterCounter(record.m_pPtr));
+        return;
+      }
+
+      // the address was reused before the deallocation of the previous sample was processed
+      const LiveSample previous = *pExisting;
+      RemoveLiveSample(ref_data, record.m_pPtr, previous);
+    }
+
+    LiveSample sample;
+    sample.m_uiSize = record.m_uiSize;
+    sample.m_iSequence = record.m_iSequence;
+    sample.m_uiStackTrace = uiStackTrace;
+    ref_data.m_LiveSamples.Insert(record.m_pPtr, sample);
+
+    StackTraceData& stackTrace = ref_data.m_StackTraces[uiStackTrace];
+    stackTrace.m_uiLiveCount++;
+    stackTrace.m_uiLiveBytes += record.m_uiSize;
+  }
+
+  void ApplyDeallocation(SamplingData& ref_data, const SampleRecord& record)
+  {
+    const LiveSample* pExisting = ref_data.m_LiveSamples.GetValue(record.m_pPtr);
+    if (pExisting != nullptr && pExisting->m_iSequence < record.m_iSequence)
+    {
+      const LiveSample sample = *pExisting;
+      RemoveLiveSample(ref_data, record.m_pPtr, sample);
+      return;
+    }
+
+    // either the address was never sampled, or its allocation is still in the buffer of a thread that was drained too early
+    OrphanedFree& orphan = ref_data.m_OrphanedFrees[record.m_pPtr];
+    orphan.m_iSequence = ezMath::Max(orphan.m_iSequence, record.m_iSequence);
+    orphan.m_uiDrainCount = ref_data.m_uiDrainCount;
+  }
+
+  /// \brief Processes the records of all threads. The mutex of the sampling data must be locked.
+  void DrainAll(SamplingData& ref_data)
+  {
+    ref_data.m_Incoming.Clear();
+
+    for (ThreadSamples* pSamples : ref_data.m_Threads)
+    {
+      CollectRecords(ref_data, *pSamples);
+    }
+
+    ref_data.m_Incoming.Sort([](const SampleRecord& a, const SampleRecord& b)
+      { return a.m_iSequence < b.m_iSequence; });
+
+    for (const SampleRecord& record : ref_data.m_Incoming)
+    {
+      if (record.m_bAllocation)
+      {
+        ApplyAllocation(ref_data, record);
+      }
+      else
+      {
+        ApplyDeallocation(ref_data, record);
+      }
+    }
+
+    ref_data.m_Incoming.Clear();
+    ref_data.m_uiDrainCount++;
+
+    // a missing allocation always shows up in the next drain, older orphans were deallocations of addresses that were never sampled
+    for (auto it = ref_data.m_OrphanedFrees.GetIterator(); it.IsValid();)
+    {
+      if (it.Value().m_uiDrainCount + 2 <= ref_data.m_uiDrainCount)
+      {
+        it = ref_data.m_OrphanedFrees.Remove(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  struct ThreadSamplesOwner
+  {
+    ~ThreadSamplesOwner()
+    {
+      s_bThreadExited = true;
+
+      if (s_pThreadSamples == nullptr)
+        return;
+
+      SamplingData& data = GetSamplingData();
+      EZ_LOCK(data.m_Mutex);
+
+      DrainAll(data);
+      data.m_Threads.RemoveAndSwap(s_pThreadSamples);
+      EZ_DELETE(GetSamplingDataAllocator(), s_pThreadSamples);
+    }
+  };
+
+  thread_local ThreadSamplesOwner s_ThreadSamplesOwner;
+
+  ThreadSamples* GetThreadSamples()
+  {
+    if (s_pThreadSamples == nullptr && !s_bThreadExited)
+    {
+      // registers the destructor that hands the remaining records over when the thread exits
+      EZ_IGNORE_UNUSED(&s_ThreadSamplesOwner);
+
+      ThreadSamples* pSamples = EZ_NEW(GetSamplingDataAllocator(), ThreadSamples);
+
+      SamplingData& data = GetSamplingData();
+      EZ_LOCK(data.m_Mutex);
+      data.m_Threads.PushBack(pSamples);
+      s_pThreadSamples = pSamples;
+    }
+
+    return s_pThreadSamples;
+  }
+
+  /// \brief Returns the next free record of the current thread. If the buffer is full, all buffers are processed first.
+  SampleRecord& BeginRecord(ThreadSamples& ref_samples)
+  {
+    if (ref_samples.m_iWriteIndex - ref_samples.m_iReadIndex >= RING_SIZE)
+    {
+      SamplingData& data = GetSamplingData();
+      EZ_LOCK(data.m_Mutex);
+      DrainAll(data);
+    }
+
+    return ref_samples.m_Records[ref_samples.m_iWriteIndex % RING_SIZE];
+  }
+
+  void AppendText(ezDynamicArray<char, SamplingDataAllocatorWrapper>& ref_text, const char* szFormat, ...)
+  {
+    char szBuffer[256];
+
+    va_list args;
+    va_start(args, szFormat);
+    const int iLength = ezStringUtils::vsnprintf(szBuffer, EZ_ARRAY_SIZE(szBuffer), szFormat, args);
+    va_end(args);
+
+    ref_text.PushBackRange(ezArrayPtr<const char>(szBuffer, static_cast<ezUInt32>(ezMath::Clamp(iLength, 0, (int)EZ_ARRAY_SIZE(szBuffer) - 1))));
+  }
+
+  class OSFileStreamWriter : public ezStreamWriter
+  {
+  public:
+    OSFileStreamWriter(ezOSFile& ref_file)
+      : m_File(ref_file)
+    {
+    }
+
+    virtual ezResult WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite) override { return m_File.Write(pWriteBuffer, uiBytesToWrite); }
+
+  private:
+    ezOSFile& m_File;
+  };
+
+  class HeapProfileDumpThread : public ezThread
+  {
+  public:
+    HeapProfileDumpThread()
+      : ezThread("Heap Profile Dumps")
+    {
+    }
+
+    ezString m_sDirectory;
+    ezTime m_Interval;
+    ezThreadSignal m_Signal;
+    ezAtomicBool m_bStop;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      ezStringBuilder sPath;
+
+      for (ezUInt32 uiDumpIndex = 0; true; ++uiDumpIndex)
+      {
+        m_Signal.WaitForSignal(m_Interval);
+
+        if (m_bStop)
+          break;
+
+        sPath.SetFormat("{}/heap_{}.prof", m_sDirectory, ezArgU(uiDumpIndex, 4, true));
+
+        ezOSFile file;
+        if (file.Open(sPath, ezFileOpenMode::Write).Failed())
+          continue;
+
+        OSFileStreamWriter writer(file);
+        ezMemoryTracker::WriteHeapProfile(writer).IgnoreResult();
+      }
+
+      return 0;
+    }
+  };
+
+  ezMutex s_DumpThreadMutex;
+  ezUniquePtr<HeapProfileDumpThread> s_pDumpThread;
+} // namespace
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, MemorySampling)
+
+  // no dependencies
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezMemoryTracker::StopHeapProfileDumps();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+// static
+void ezMemoryTracker::SetSamplingInterval(ezUInt32 uiBytes)
+{
+  ezAtomicUtils::Set(s_iSamplingInterval, static_cast<ezInt32>(ezMath::Clamp<ezUInt32>(uiBytes, 1, 0x7FFFFFFF)));
+}
+
+// static
+ezUInt32 ezMemoryTracker::GetSamplingInterval()
+{
+  return static_cast<ezUInt32>(ezAtomicUtils::Read(s_iSamplingInterval));
+}
+
+// static
+void ezMemoryTracker::SampleAllocation(const void* pPtr, size_t uiSize)
+{
+  s_iBytesUntilSample -= static_cast<ezInt64>(uiSize);
+  if (s_iBytesUntilSample > 0)
+    return;
+
+  // the initial countdown of every thread is zero, draw a random one instead of always sampling the first allocation
+  if (s_uiRandomState == 0)
+  {
+    s_iBytesUntilSample += GetNextSampleDistance();
+    if (s_iBytesUntilSample > 0)
+      return;
+  }
+
+  s_iBytesUntilSample = GetNextSampleDistance();
+
+  ThreadSamples* pSamples = GetThreadSamples();
+  if (pSamples == nullptr)
+    return;
+
+  SampleRecord& record = BeginRecord(*pSamples);
+  record.m_pPtr = pPtr;
+  record.m_uiSize = uiSize;
+  record.m_bAllocation = true;
+
+  ezArrayPtr<void*> stackTrace(record.m_StackTrace);
+  record.m_uiStackTraceLength = ezStackTracer::GetStackTrace(stackTrace);
+
+  ezAtomicUtils::Increment(GetFilterCounter(pPtr));
+  record.m_iSequence = ezAtomicUtils::Increment(s_iSequence);
+
+  pSamples->m_iWriteIndex.Increment();
+}
+
+// static
+void ezMemoryTracker::SampleDeallocation(const void* pPtr)
+{
+  if (pPtr == nullptr || ezAtomicUtils::Read(GetFilterCounter(pPtr)) == 0)
+    return;
+
+  ThreadSamples* pSamples = GetThreadSamples();
+  if (pSamples == nullptr)
+    return;
+
+  SampleRecord& record = BeginRecord(*pSamples);
+  record.m_pPtr = pPtr;
+  record.m_uiSize = 0;
+  record.m_bAllocation = false;
+  record.m_uiStackTraceLength = 0;
+  record.m_iSequence = ezAtomicUtils::Increment(s_iSequence);
+
+  pSamples->m_iWriteIndex.Increment();
+}
+
+// static
+ezMemoryTracker::SamplingStats ezMemoryTracker::GetSamplingStats()
+{
+  SamplingData& data = GetSamplingData();
+  EZ_LOCK(data.m_Mutex);
+
+  DrainAll(data);
+
+  const double fInterval = static_cast<double>(GetSamplingInterval());
+
+  SamplingStats stats;
+  stats.m_uiNumSamples = data.m_uiNumSamples;
+  stats.m_uiNumDistinctStackTraces = data.m_StackTraces.GetCount();
+
+  double fEstimatedBytes = 0.0;
+  for (auto it = data.m_LiveSamples.GetIterator(); it.IsValid(); ++it)
+  {
+    const double fSize = static_cast<double>(it.Value().m_uiSize);
+
+    stats.m_uiNumLiveSamples++;
+    stats.m_uiSampledLiveBytes += it.Value().m_uiSize;
+
+    // an allocation of this size is sampled with a probability of 1 - e^(-size / interval)
+    fEstimatedBytes += fSize / (1.0 - ezMath::Exp(static_cast<float>(-fSize / fInterval)));
+  }
+
+  stats.m_uiEstimatedLiveBytes = static_cast<ezUInt64>(fEstimatedBytes);
+  return stats;
+}
+
+// static
+ezResult ezMemoryTracker::WriteHeapProfile(ezStreamWriter& inout_stream)
+{
+  ezDynamicArray<char, SamplingDataAllocatorWrapper> text;
+
+  {
+    SamplingData& data = GetSamplingData();
+    EZ_LOCK(data.m_Mutex);
+
+    DrainAll(data);
+
+    ezUInt64 uiLiveCount = 0;
+    ezUInt64 uiLiveBytes = 0;
+    ezUInt64 uiTotalCount = 0;
+    ezUInt64 uiTotalBytes = 0;
+
+    ezDynamicArray<ezUInt32, SamplingDataAllocatorWrapper> order;
+    order.Reserve(data.m_StackTraces.GetCount());
+
+    for (ezUInt32 i = 0; i < data.m_StackTraces.GetCount(); ++i)
+    {
+      const StackTraceData& stackTrace = data.m_StackTraces[i];
+      uiLiveCount += stackTrace.m_uiLiveCount;
+      uiLiveBytes += stackTrace.m_uiLiveBytes;
+      uiTotalCount += stackTrace.m_uiTotalCount;
+      uiTotalBytes += stackTrace.m_uiTotalBytes;
+      order.PushBack(i);
+    }
+
+    // the largest users first, which makes the file readable without tools
+    order.Sort([&](ezUInt32 a, ezUInt32 b)
+      { return data.m_StackTraces[a].m_uiLiveBytes > data.m_StackTraces[b].m_uiLiveBytes; });
+
+    AppendText(text, "heap profile: %6llu: %8llu [%6llu: %8llu] @ heap_v2/%u\n", uiLiveCount, uiLiveBytes, uiTotalCount, uiTotalBytes, GetSamplingInterval());
+
+    for (ezUInt32 uiIndex : order)
+    {
+      const StackTraceData& stackTrace = data.m_StackTraces[uiIndex];
+      AppendText(text, "%6llu: %8llu [%6llu: %8llu] @", stackTrace.m_uiLiveCount, stackTrace.m_uiLiveBytes, stackTrace.m_uiTotalCount, stackTrace.m_uiTotalBytes);
+
+      for (ezUInt32 i = 0; i < stackTrace.m_uiNumFrames; ++i)
+      {
+        AppendText(text, " 0x%016llx", static_cast<ezUInt64>(reinterpret_cast<size_t>(data.m_Frames[stackTrace.m_uiFirstFrame + i])));
+      }
+
+      AppendText(text, "\n");
+    }
+  }
+
+  // writing may allocate from sampled allocators, so it happens after the lock is released
+  EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(text.GetData(), text.GetCount()));
+
+  const char szMappedLibraries[] = "\nMAPPED_LIBRARIES:\n";
+  EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(szMappedLibraries, sizeof(szMappedLibraries) - 1));
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+  ezOSFile maps;
+  if (maps.Open("/proc/self/maps", ezFileOpenMode::Read).Succeeded())
+  {
+    // the file size of proc files is reported as zero, so read until the end
+    ezUInt8 buffer[4096];
+    while (const ezUInt64 uiRead = maps.Read(buffer, sizeof(buffer)))
+    {
+      EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(buffer, uiRead));
+    }
+  }
+#endif
+
+  return EZ_SUCCESS;
+}
+
+// static
+ezResult ezMemoryTracker::StartHeapProfileDumps(ezStringView sDirectory, ezTime interval)
+{
+  StopHeapProfileDumps();
+
+  EZ_SUCCEED_OR_RETURN(ezOSFile::CreateDirectoryStructure(sDirectory));
+
+  EZ_LOCK(s_DumpThreadMutex);
+
+  s_pDumpThread = EZ_DEFAULT_NEW(HeapProfileDumpThread);
+  s_pDumpThread->m_sDirectory = sDirectory;
+  s_pDumpThread->m_Interval = interval;
+  s_pDumpThread->Start();
+
+  return EZ_SUCCESS;
+}
+
+// static
+void ezMemoryTracker::StopHeapProfileDumps()
+{
+  EZ_LOCK(s_DumpThreadMutex);
+
+  if (s_pDumpThread == nullptr)
+    return;
+
+  s_pDumpThread->m_bStop = true;
+  s_pDumpThread->m_Signal.RaiseSignal();
+  s_pDumpThread->Join();
+  s_pDumpThread.Clear();
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_MemoryTrackerSampling);
@@ -6,10 +6,13 @@
 #include <Foundation/Types/ArrayPtr.h>
 #include <Foundation/Types/Bitflags.h>
 
+class ezStreamWriter;
+
 enum class ezAllocatorTrackingMode : ezUInt32
 {
   Nothing,                       ///< The allocator doesn't track anything. Use this for best performance.
   Basics,                        ///< The allocator will be known to the system, so it can show up in debugging tools, but barely anything more.
+  Sampling,                      ///< Records stack traces for a random sample of the allocated bytes. Cheap enough for production. See ezMemoryTracker::WriteHeapProfile().
   AllocationStats,               ///< The allocator keeps track of how many allocations and deallocations it did and how large its memory usage is.
   AllocationStatsIgnoreLeaks,    ///< Same as AllocationStats, but any remaining allocations at shutdown are not reported as leaks.
   AllocationStatsAndStacktraces, ///< The allocator will record stack traces for each allocation, which can be used to find memory leaks.
@@ -101,4 +104,50 @@ public:
   ///
   /// This is useful to call at the end of an application, to get a debug breakpoint in case of memory leaks.
   static void DumpMemoryLeaks();
+
+  /// \name Sampling
+  ///
+  /// Allocators with ezAllocatorTrackingMode::Sampling don't track every allocation. Instead, every thread counts down a random
+  /// number of bytes, with an average of the sampling interval, and records the allocation that reaches zero together with its
+  /// stack trace. Large allocations are therefore (almost) always recorded, small ones rarely. The samples are collected in
+  /// lock-free per-thread buffers and only merged when the buffers are full or a heap profile is requested.
+  ///
+  /// Sampled allocators have no allocation stats, ie. ezAllocator::GetStats() and AllocatedSize() return zero.
+  ///@{
+
+  struct SamplingStats
+  {
+    ezUInt64 m_uiNumLiveSamples = 0;         ///< Number of sampled allocations that were not freed yet.
+    ezUInt64 m_uiSampledLiveBytes = 0;       ///< Size of all sampled allocations that were not freed yet.
+    ezUInt64 m_uiEstimatedLiveBytes = 0;     ///< Estimated size of all live allocations of sampled allocators.
+    ezUInt64 m_uiNumSamples = 0;             ///< Number of allocations that were sampled in total.
+    ezUInt32 m_uiNumDistinctStackTraces = 0; ///< Number of distinct stack traces of all samples.
+  };
+
+  /// \brief Sets the average number of allocated bytes between two samples. The default is 512 KB.
+  static void SetSamplingInterval(ezUInt32 uiBytes);
+  static ezUInt32 GetSamplingInterval();
+
+  /// \brief Called by allocators with ezAllocatorTrackingMode::Sampling for every allocation.
+  static void SampleAllocation(const void* pPtr, size_t uiSize);
+
+  /// \brief Called by allocators with ezAllocatorTrackingMode::Sampling for every deallocation.
+  static void SampleDeallocation(const void* pPtr);
+
+  static SamplingStats GetSamplingStats();
+
+  /// \brief Writes all live samples as a heap profile in the text format of gperftools ('heap_v2').
+  ///
+  /// Samples with the same stack trace are merged. Two profiles can be compared with 'pprof --base=old.heap binary new.heap',
+  /// which shows where memory was allocated and not freed in between. On Linux the memory map of the process is appended,
+  /// so that pprof can symbolize the addresses.
+  static ezResult WriteHeapProfile(ezStreamWriter& inout_stream);
+
+  /// \brief Starts a background thread that writes a heap profile to 'heap_NNNN.prof' in the given absolute directory at the given interval.
+  static ezResult StartHeapProfileDumps(ezStringView sDirectory, ezTime interval);
+
+  /// \brief Stops writing periodic heap profiles. Happens automatically at shutdown.
+  static void StopHeapProfileDumps();
+
+  ///@}
 };
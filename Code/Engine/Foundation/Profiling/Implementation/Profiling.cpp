@@ -8,7 +8,9 @@
 #include <Foundation/Containers/StaticRingBuffer.h>
 #include <Foundation/IO/JSONWriter.h>
 #include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Memory/MemoryTracker.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Profiling/ProfilingStream.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
 #if EZ_ENABLED(EZ_USE_PROFILING)
@@ -33,6 +35,10 @@ static ezProfileCaptureDataTransfer s_ProfileCaptureDataTransfer;
 namespace
 {
   static ezEventSubscriptionID s_PluginEventSubscription = 0;
+
+  /// Mutexes are locked and memory is allocated long before the profiling system is started, these events are ignored until then.
+  static bool s_bRecordSystemEvents = false;
+
   void PluginEvent(const ezPluginEvent& e)
   {
     if (e.m_EventType == ezPluginEvent::AfterUnloading)
@@ -57,9 +63,11 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingSystem)
   { 
     s_PluginEventSubscription = ezPlugin::Events().AddEventHandler(&PluginEvent);
     s_ProfileCaptureDataTransfer.EnableDataTransfer("Profiling Capture");
+    s_bRecordSystemEvents = true;
   }
   ON_CORESYSTEMS_SHUTDOWN
   {
+    s_bRecordSystemEvents = false;
     s_ProfileCaptureDataTransfer.DisableDataTransfer();
     ezPlugin::Events().RemoveEventHandler(s_PluginEventSubscription);
     ezProfilingSystem::Reset();
@@ -82,6 +90,8 @@ namespace
   };
 
   using GPUScopesBuffer = ezStaticRingBuffer<ezProfilingSystem::GPUScope, BUFFER_SIZE_OTHER_THREAD / sizeof(ezProfilingSystem::GPUScope)>;
+  using CountersBuffer = ezStaticRingBuffer<ezProfilingSystem::Counter, BUFFER_SIZE_OTHER_THREAD / sizeof(ezProfilingSystem::Counter)>;
+  using MemoryEventsBuffer = ezStaticRingBuffer<ezProfilingSystem::MemoryEvent, BUFFER_SIZE_OTHER_THREAD / sizeof(ezProfilingSystem::MemoryEvent)>;
 
   static ezUInt64 s_MainThreadId = 0;
 
@@ -112,6 +122,9 @@ namespace
   }
 
   ezCVarFloat cvar_ProfilingDiscardThresholdMS("Profiling.DiscardThresholdMS", 0.1f, ezCVarFlags::Default, "Discard profiling scopes if their duration is shorter than this in milliseconds.");
+  ezCVarBool cvar_ProfilingMemoryCounters("Profiling.MemoryCounters", false, ezCVarFlags::Default, "Record the memory usage and the number of allocations as counters once per frame. Iterates over all allocators every frame.");
+  ezCVarBool cvar_ProfilingMutexWaits("Profiling.MutexWaits", false, ezCVarFlags::Default, "Measure how long threads wait for mutexes that are held by other threads, as 'Mutex Wait' scopes and a counter per frame.");
+  ezCVarInt cvar_ProfilingMemoryEventThresholdKB("Profiling.MemoryEventThresholdKB", 256, ezCVarFlags::Default, "Record allocations and deallocations of at least this size in KB as memory events. Negative values disable memory events.");
 
   ezStaticRingBuffer<ezTime, BUFFER_SIZE_FRAMES> s_FrameStartTimes;
   ezUInt64 s_uiFrameCount = 0;
@@ -123,6 +136,8 @@ namespace
 #  if EZ_ENABLED(EZ_PLATFORM_64BIT)
   static_assert(sizeof(ezProfilingSystem::CPUScope) == 64);
   static_assert(sizeof(ezProfilingSystem::GPUScope) == 64);
+  static_assert(sizeof(ezProfilingSystem::Counter) == 64);
+  static_assert(sizeof(ezProfilingSystem::MemoryEvent) == 64);
 #  endif
 
   static thread_local CpuScopesBufferBase* s_CpuScopes = nullptr;
@@ -131,6 +146,153 @@ namespace
   static ezProfilingSystem::ScopeTimeoutDelegate s_ScopeTimeoutCallback;
 
   static ezDynamicArray<ezUniquePtr<GPUScopesBuffer>> s_GPUScopes;
+
+  static ezUniquePtr<CountersBuffer> s_pCounters;
+  static ezMutex s_CountersMutex;
+
+  static ezUniquePtr<MemoryEventsBuffer> s_pMemoryEvents;
+  static ezMutex s_MemoryEventsMutex;
+
+  /// Total time that all threads waited for mutexes since the last frame.
+  static ezAtomicInteger64 s_iMutexWaitNanoseconds;
+  static ezUInt64 s_uiLastNumAllocations = ezInvalidIndex;
+
+  // Memory events and mutex waits are reported while the thread may hold arbitrary mutexes, also ones that the profiling system or
+  // its allocators use. Adding them to the ring buffers or the streaming capture right away could deadlock, because those allocate
+  // memory and lock mutexes themselves. Therefore they are queued first and only added once it is safe.
+  enum
+  {
+    MAX_PENDING_EVENTS = 32,
+    MAX_PENDING_MUTEX_WAITS = 64,
+  };
+
+  /// Memory events are added by AddPendingEvents() with the next scope or frame of the thread.
+  static thread_local ezProfilingSystem::MemoryEvent s_PendingMemoryEvents[MAX_PENDING_EVENTS];
+  static thread_local ezUInt32 s_uiNumPendingMemoryEvents = 0;
+  static thread_local bool s_bAddingPendingEvents = false;
+
+  EZ_ALWAYS_INLINE bool HasPendingEvents()
+  {
+    return s_uiNumPendingMemoryEvents != 0;
+  }
+
+  struct MutexWait
+  {
+    ezTime m_BeginTime;
+    ezTime m_EndTime;
+    ezUInt64 m_uiThreadId = 0;
+  };
+
+  using MutexWaitsBuffer = ezStaticRingBuffer<MutexWait, BUFFER_SIZE_OTHER_THREAD / sizeof(MutexWait)>;
+
+  /// \brief The mutex waits of one thread that were not added yet.
+  ///
+  /// Mutex waits are added at the end of every frame by FlushMutexWaits(), so that they don't depend on the thread recording more scopes.
+  /// Only the owning thread appends to the queue and only the thread that holds s_MutexWaitsMutex takes from it, so appending doesn't lock.
+  /// The queue is also registered without locking, since the thread may hold any mutex, including one that s_MutexWaitsMutex's holder needs.
+  struct ThreadMutexWaits
+  {
+    ~ThreadMutexWaits();
+
+    ThreadMutexWaits* m_pNext = nullptr;
+    ezUInt64 m_uiThreadId = 0;
+    bool m_bRegistered = false;
+    ezInt32 m_iWriteIndex = 0; ///< Only modified by the owning thread.
+    ezInt32 m_iReadIndex = 0;  ///< Only modified while s_MutexWaitsMutex is held.
+    MutexWait m_Waits[MAX_PENDING_MUTEX_WAITS];
+  };
+
+  static ezMutex s_MutexWaitsMutex;
+  static void* s_pAllThreadMutexWaits = nullptr; ///< Linked through ThreadMutexWaits::m_pNext. New threads are added with atomic operations.
+  static ezUniquePtr<MutexWaitsBuffer> s_pMutexWaits;
+  static thread_local ThreadMutexWaits s_ThreadMutexWaits;
+
+  /// \brief Moves the queued mutex waits of the given thread to out_waits. s_MutexWaitsMutex must be held.
+  template <typename ArrayType>
+  void TakeMutexWaits(ThreadMutexWaits& ref_waits, ArrayType& out_waits)
+  {
+    const ezInt32 iWriteIndex = ezAtomicUtils::Read(ref_waits.m_iWriteIndex);
+
+    for (ezInt32 i = ref_waits.m_iReadIndex; i < iWriteIndex; ++i)
+    {
+      out_waits.PushBack(ref_waits.m_Waits[i % MAX_PENDING_MUTEX_WAITS]);
+    }
+
+    ezAtomicUtils::Set(ref_waits.m_iReadIndex, iWriteIndex);
+  }
+
+  template <typename ArrayType>
+  void StoreMutexWaits(const ArrayType& waits)
+  {
+    if (s_pMutexWaits == nullptr)
+    {
+      s_pMutexWaits = EZ_DEFAULT_NEW(MutexWaitsBuffer);
+    }
+
+    for (const MutexWait& wait : waits)
+    {
+      if (!s_pMutexWaits->CanAppend())
+      {
+        s_pMutexWaits->PopFront();
+      }
+
+      s_pMutexWaits->PushBack(wait);
+    }
+  }
+
+  EZ_ALWAYS_INLINE ThreadMutexWaits* GetFirstThreadMutexWaits()
+  {
+    return static_cast<ThreadMutexWaits*>(*static_cast<void* volatile*>(&s_pAllThreadMutexWaits));
+  }
+
+  void RegisterThreadMutexWaits(ThreadMutexWaits& ref_waits)
+  {
+    ThreadMutexWaits* pHead = nullptr;
+    do
+    {
+      pHead = GetFirstThreadMutexWaits();
+      ref_waits.m_pNext = pHead;
+    } while (!ezAtomicUtils::TestAndSet(&s_pAllThreadMutexWaits, pHead, &ref_waits));
+  }
+
+  ThreadMutexWaits::~ThreadMutexWaits()
+  {
+    if (!m_bRegistered)
+      return;
+
+    EZ_LOCK(s_MutexWaitsMutex);
+
+    // the thread is gone before the end of the frame, so its last waits are stored right away
+    ezHybridArray<MutexWait, MAX_PENDING_MUTEX_WAITS> waits;
+    TakeMutexWaits(*this, waits);
+    StoreMutexWaits(waits);
+
+    // other threads may add themselves in front at any time, but only while s_MutexWaitsMutex is held, queues are removed
+    if (ezAtomicUtils::TestAndSet(&s_pAllThreadMutexWaits, this, m_pNext))
+      return;
+
+    for (ThreadMutexWaits* pWaits = GetFirstThreadMutexWaits(); pWaits != nullptr; pWaits = pWaits->m_pNext)
+    {
+      if (pWaits->m_pNext == this)
+      {
+        pWaits->m_pNext = m_pNext;
+        break;
+      }
+    }
+  }
+
+  const char* GetCounterUnit(ezProfilingSystem::CounterType type)
+  {
+    switch (type)
+    {
+      case ezProfilingSystem::CounterType::Bytes:
+        return "bytes";
+      case ezProfilingSystem::CounterType::Milliseconds:
+        return "ms";
+      default:
+        return "value";
+    }
+  }
 } // namespace
 
 void ezProfilingSystem::ProfilingData::Clear()
@@ -143,6 +305,8 @@ void ezProfilingSystem::ProfilingData::Clear()
   m_FrameStartTimes.Clear();
   m_GPUScopes.Clear();
   m_ThreadInfos.Clear();
+  m_Counters.Clear();
+  m_MemoryEvents.Clear();
 }
 
 void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_merged, ezArrayPtr<const ProfilingData*> inputs)
@@ -175,6 +339,8 @@ void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_merged, ezArrayP
     {
       out_merged.m_FrameStartTimes.PushBackRange(pd->m_FrameStartTimes);
       out_merged.m_GPUScopes.PushBackRange(pd->m_GPUScopes);
+      out_merged.m_Counters.PushBackRange(pd->m_Counters);
+      out_merged.m_MemoryEvents.PushBackRange(pd->m_MemoryEvents);
     }
   }
 
@@ -532,6 +698,52 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& ref_outputStrea
       }
     }
 
+    // counters
+    for (const Counter& c : m_Counters)
+    {
+      writer.BeginObject();
+      writer.AddVariableString("name", static_cast<const char*>(c.m_szName));
+      writer.AddVariableUInt32("pid", m_uiProcessID);
+      writer.AddVariableUInt64("ts", static_cast<ezUInt64>(c.m_Time.GetMicroseconds()));
+      writer.AddVariableString("ph", "C");
+
+      writer.BeginObject("args");
+      writer.AddVariableDouble(GetCounterUnit(c.m_Type), c.m_fValue);
+      writer.EndObject();
+
+      writer.EndObject();
+
+      if (writer.HadWriteError())
+      {
+        return EZ_FAILURE;
+      }
+    }
+
+    // memory events are shown as instant events on the thread that did the allocation
+    for (const MemoryEvent& e : m_MemoryEvents)
+    {
+      writer.BeginObject();
+      writer.AddVariableString("name", e.m_bAllocation ? "Allocation" : "Deallocation");
+      writer.AddVariableString("cat", "memory");
+      writer.AddVariableUInt32("pid", m_uiProcessID);
+      writer.AddVariableUInt64("tid", e.m_uiThreadId + uiGpuCount + 1);
+      writer.AddVariableUInt64("ts", static_cast<ezUInt64>(e.m_Time.GetMicroseconds()));
+      writer.AddVariableString("ph", "i");
+      writer.AddVariableString("s", "t");
+
+      writer.BeginObject("args");
+      writer.AddVariableString("allocator", static_cast<const char*>(e.m_szAllocatorName));
+      writer.AddVariableUInt64("size", e.m_uiSize);
+      writer.EndObject();
+
+      writer.EndObject();
+
+      if (writer.HadWriteError())
+      {
+        return EZ_FAILURE;
+      }
+    }
+
     writer.EndArray();
   }
 
@@ -567,6 +779,30 @@ void ezProfilingSystem::Clear()
       gpuScopes->Clear();
     }
   }
+
+  {
+    EZ_LOCK(s_CountersMutex);
+    if (s_pCounters != nullptr)
+    {
+      s_pCounters->Clear();
+    }
+  }
+
+  {
+    EZ_LOCK(s_MemoryEventsMutex);
+    if (s_pMemoryEvents != nullptr)
+    {
+      s_pMemoryEvents->Clear();
+    }
+  }
+
+  {
+    EZ_LOCK(s_MutexWaitsMutex);
+    if (s_pMutexWaits != nullptr)
+    {
+      s_pMutexWaits->Clear();
+    }
+  }
 }
 
 // static
@@ -649,6 +885,66 @@ void ezProfilingSystem::Capture(ezProfilingSystem::ProfilingData& ref_profilingD
     }
   }
 
+  {
+    EZ_LOCK(s_CountersMutex);
+    if (s_pCounters != nullptr)
+    {
+      ref_profilingData.m_Counters.SetCountUninitialized(s_pCounters->GetCount());
+      for (ezUInt32 i = 0; i < s_pCounters->GetCount(); ++i)
+      {
+        ref_profilingData.m_Counters[i] = (*s_pCounters)[i];
+      }
+    }
+  }
+
+  {
+    EZ_LOCK(s_MemoryEventsMutex);
+    if (s_pMemoryEvents != nullptr)
+    {
+      ref_profilingData.m_MemoryEvents.SetCountUninitialized(s_pMemoryEvents->GetCount());
+      for (ezUInt32 i = 0; i < s_pMemoryEvents->GetCount(); ++i)
+      {
+        ref_profilingData.m_MemoryEvents[i] = (*s_pMemoryEvents)[i];
+      }
+    }
+  }
+
+  // mutex waits are shown as scopes on the thread that waited
+  FlushMutexWaits();
+
+  {
+    EZ_LOCK(s_MutexWaitsMutex);
+    if (s_pMutexWaits != nullptr)
+    {
+      for (ezUInt32 i = 0; i < s_pMutexWaits->GetCount(); ++i)
+      {
+        const MutexWait& wait = (*s_pMutexWaits)[i];
+
+        CPUScopesBufferFlat* pEventBuffer = nullptr;
+        for (CPUScopesBufferFlat& eventBuffer : ref_profilingData.m_AllEventBuffers)
+        {
+          if (eventBuffer.m_uiThreadId == wait.m_uiThreadId)
+          {
+            pEventBuffer = &eventBuffer;
+            break;
+          }
+        }
+
+        if (pEventBuffer == nullptr)
+        {
+          pEventBuffer = &ref_profilingData.m_AllEventBuffers.ExpandAndGetRef();
+          pEventBuffer->m_uiThreadId = wait.m_uiThreadId;
+        }
+
+        CPUScope& scope = pEventBuffer->m_Data.ExpandAndGetRef();
+        scope.m_szFunctionName = nullptr;
+        scope.m_BeginTime = wait.m_BeginTime;
+        scope.m_EndTime = wait.m_EndTime;
+        ezStringUtils::Copy(scope.m_szName, CPUScope::NAME_SIZE, "Mutex Wait");
+      }
+    }
+  }
+
   if (bClearAfterCapture)
   {
     Clear();
@@ -675,6 +971,13 @@ ezUInt64 ezProfilingSystem::GetFrameCount()
 // static
 void ezProfilingSystem::StartNewFrame()
 {
+  if (HasPendingEvents())
+  {
+    AddPendingEvents();
+  }
+
+  FlushMutexWaits();
+
   ++s_uiFrameCount;
 
   if (!s_FrameStartTimes.CanAppend())
@@ -682,20 +985,100 @@ void ezProfilingSystem::StartNewFrame()
     s_FrameStartTimes.PopFront();
   }
 
-  s_FrameStartTimes.PushBack(ezTime::Now());
+  const ezTime now = ezTime::Now();
+  s_FrameStartTimes.PushBack(now);
+
+  if (ezProfilingStream::IsCapturing())
+  {
+    ezProfilingStream::AddFrame(s_uiFrameCount, now);
+  }
+
+  // counters that are sampled once per frame
+  {
+    if (cvar_ProfilingMutexWaits)
+    {
+      SetCounter("Mutex Wait Time", ezTime::MakeFromNanoseconds(static_cast<double>(s_iMutexWaitNanoseconds.Set(0))).GetMilliseconds(), CounterType::Milliseconds);
+    }
+
+    if (cvar_ProfilingMemoryCounters)
+    {
+      ezUInt64 uiMemoryUsage = 0;
+      ezUInt64 uiNumAllocations = 0;
+
+      for (auto it = ezMemoryTracker::GetIterator(); it.IsValid(); ++it)
+      {
+        // child allocators typically get their memory from their parent, so only the root allocators are counted
+        if (it.ParentId().IsInvalidated())
+        {
+          uiMemoryUsage += it.Stats().m_uiAllocationSize;
+          uiNumAllocations += it.Stats().m_uiNumAllocations;
+        }
+      }
+
+      if (s_uiLastNumAllocations == ezInvalidIndex)
+      {
+        s_uiLastNumAllocations = uiNumAllocations;
+      }
+
+      SetCounter("Memory Usage", static_cast<double>(uiMemoryUsage), CounterType::Bytes);
+      SetCounter("Allocations", static_cast<double>(uiNumAllocations - s_uiLastNumAllocations));
+      s_uiLastNumAllocations = uiNumAllocations;
+    }
+  }
 
   EZ_PROFILER_FRAME_MARKER();
 }
 
+// static
+void ezProfilingSystem::SetCounter(ezStringView sName, double fValue, CounterType type)
+{
+  Counter counter;
+  counter.m_Time = ezTime::Now();
+  counter.m_fValue = fValue;
+  counter.m_Type = type;
+  ezStringUtils::Copy(counter.m_szName, EZ_ARRAY_SIZE(counter.m_szName), sName.GetStartPointer(), sName.GetEndPointer());
+
+  {
+    EZ_LOCK(s_CountersMutex);
+
+    if (s_pCounters == nullptr)
+    {
+      s_pCounters = EZ_DEFAULT_NEW(CountersBuffer);
+    }
+
+    if (!s_pCounters->CanAppend())
+    {
+      s_pCounters->PopFront();
+    }
+
+    s_pCounters->PushBack(counter);
+  }
+
+  if (ezProfilingStream::IsCapturing())
+  {
+    ezProfilingStream::AddCounter(sName, fValue, type, counter.m_Time);
+  }
+}
+
 // static
 void ezProfilingSystem::AddCPUScope(ezStringView sName, const char* szFunctionName, ezTime beginTime, ezTime endTime, ezTime scopeTimeout)
 {
+  if (HasPendingEvents())
+  {
+    AddPendingEvents();
+  }
+
   const ezTime duration = endTime - beginTime;
 
   // discard?
   if (duration < ezTime::MakeFromMilliseconds(cvar_ProfilingDiscardThresholdMS))
     return;
 
+  if (ezProfilingStream::IsCapturing())
+  {
+    ezProfilingStream::AddCPUScope(sName, szFunctionName, beginTime, endTime);
+  }
+
   ::CpuScopesBufferBase* pScopes = s_CpuScopes;
 
   if (pScopes == nullptr)
@@ -810,6 +1193,146 @@ void ezProfilingSystem::RemoveThread()
   s_DeadThreadIDs.PushBack((ezUInt64)ezThreadUtils::GetCurrentThreadID());
 }
 
+// static
+void ezProfilingSystem::GetThreadInfos(ezHybridArray<ThreadInfo, 16>& out_threadInfos)
+{
+  EZ_LOCK(s_ThreadInfosMutex);
+
+  out_threadInfos = s_ThreadInfos;
+}
+
+// static
+ezUInt32 ezProfilingSystem::GetGPUCount()
+{
+  return s_GPUScopes.GetCount();
+}
+
+// static
+void ezProfilingSystem::AddMemoryEvent(ezStringView sAllocatorName, ezUInt64 uiSize, bool bAllocation)
+{
+  if (!s_bRecordSystemEvents || s_bAddingPendingEvents || s_uiNumPendingMemoryEvents == MAX_PENDING_EVENTS)
+    return;
+
+  const ezInt32 iThresholdKB = cvar_ProfilingMemoryEventThresholdKB;
+  if (iThresholdKB < 0 || uiSize < static_cast<ezUInt64>(iThresholdKB) * 1024)
+    return;
+
+  MemoryEvent& e = s_PendingMemoryEvents[s_uiNumPendingMemoryEvents++];
+  e.m_Time = ezTime::Now();
+  e.m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+  e.m_uiSize = uiSize;
+  e.m_bAllocation = bAllocation;
+  ezStringUtils::Copy(e.m_szAllocatorName, EZ_ARRAY_SIZE(e.m_szAllocatorName), sAllocatorName.GetStartPointer(), sAllocatorName.GetEndPointer());
+}
+
+// static
+bool ezProfilingSystem::IsRecordingMutexWaits()
+{
+  return s_bRecordSystemEvents && cvar_ProfilingMutexWaits;
+}
+
+// static
+void ezProfilingSystem::AddMutexWait(ezTime beginTime, ezTime endTime)
+{
+  if (!s_bRecordSystemEvents)
+    return;
+
+  const ezTime duration = endTime - beginTime;
+  s_iMutexWaitNanoseconds.Add(static_cast<ezInt64>(duration.GetNanoseconds()));
+
+  // short waits only contribute to the per frame counter
+  if (duration < ezTime::MakeFromMilliseconds(cvar_ProfilingDiscardThresholdMS))
+    return;
+
+  ThreadMutexWaits& waits = s_ThreadMutexWaits;
+
+  if (!waits.m_bRegistered)
+  {
+    waits.m_bRegistered = true;
+    waits.m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+    RegisterThreadMutexWaits(waits);
+  }
+
+  if (waits.m_iWriteIndex - ezAtomicUtils::Read(waits.m_iReadIndex) >= MAX_PENDING_MUTEX_WAITS)
+    return;
+
+  MutexWait& wait = waits.m_Waits[waits.m_iWriteIndex % MAX_PENDING_MUTEX_WAITS];
+  wait.m_BeginTime = beginTime;
+  wait.m_EndTime = endTime;
+  wait.m_uiThreadId = waits.m_uiThreadId;
+
+  // publishes the wait to FlushMutexWaits()
+  ezAtomicUtils::Set(waits.m_iWriteIndex, waits.m_iWriteIndex + 1);
+}
+
+// static
+void ezProfilingSystem::FlushMutexWaits()
+{
+  ezHybridArray<MutexWait, 64> waits;
+
+  {
+    EZ_LOCK(s_MutexWaitsMutex);
+
+    for (ThreadMutexWaits* pWaits = GetFirstThreadMutexWaits(); pWaits != nullptr; pWaits = pWaits->m_pNext)
+    {
+      TakeMutexWaits(*pWaits, waits);
+    }
+
+    StoreMutexWaits(waits);
+  }
+
+  if (ezProfilingStream::IsCapturing())
+  {
+    for (const MutexWait& wait : waits)
+    {
+      ezProfilingStream::AddMutexWait(wait.m_uiThreadId, wait.m_BeginTime, wait.m_EndTime);
+    }
+  }
+}
+
+// static
+void ezProfilingSystem::AddPendingEvents()
+{
+  if (s_bAddingPendingEvents)
+    return;
+
+  s_bAddingPendingEvents = true;
+
+  if (s_uiNumPendingMemoryEvents > 0)
+  {
+    {
+      EZ_LOCK(s_MemoryEventsMutex);
+
+      if (s_pMemoryEvents == nullptr)
+      {
+        s_pMemoryEvents = EZ_DEFAULT_NEW(MemoryEventsBuffer);
+      }
+
+      for (ezUInt32 i = 0; i < s_uiNumPendingMemoryEvents; ++i)
+      {
+        if (!s_pMemoryEvents->CanAppend())
+        {
+          s_pMemoryEvents->PopFront();
+        }
+
+        s_pMemoryEvents->PushBack(s_PendingMemoryEvents[i]);
+      }
+    }
+
+    if (ezProfilingStream::IsCapturing())
+    {
+      for (ezUInt32 i = 0; i < s_uiNumPendingMemoryEvents; ++i)
+      {
+        ezProfilingStream::AddMemoryEvent(s_PendingMemoryEvents[i]);
+      }
+    }
+
+    s_uiNumPendingMemoryEvents = 0;
+  }
+
+  s_bAddingPendingEvents = false;
+}
+
 // static
 void ezProfilingSystem::InitializeGPUData(ezUInt32 uiGpuCount)
 {
@@ -833,6 +1356,11 @@ void ezProfilingSystem::AddGPUScope(ezStringView sName, ezTime beginTime, ezTime
   if (endTime - beginTime < ezTime::MakeFromMilliseconds(cvar_ProfilingDiscardThresholdMS))
     return;
 
+  if (ezProfilingStream::IsCapturing())
+  {
+    ezProfilingStream::AddGPUScope(sName, beginTime, endTime, uiGpuIndex);
+  }
+
   if (!s_GPUScopes[uiGpuIndex]->CanAppend())
   {
     s_GPUScopes[uiGpuIndex]->PopFront();
@@ -941,6 +1469,45 @@ void ezProfilingSystem::SetThreadName(ezStringView sThreadName)
 
 void ezProfilingSystem::RemoveThread() {}
 
+void ezProfilingSystem::GetThreadInfos(ezHybridArray<ThreadInfo, 16>& out_threadInfos)
+{
+  out_threadInfos.Clear();
+}
+
+ezUInt32 ezProfilingSystem::GetGPUCount()
+{
+  return 0;
+}
+
+void ezProfilingSystem::SetCounter(ezStringView sName, double fValue, CounterType type)
+{
+  EZ_IGNORE_UNUSED(sName);
+  EZ_IGNORE_UNUSED(fValue);
+  EZ_IGNORE_UNUSED(type);
+}
+
+void ezProfilingSystem::AddMemoryEvent(ezStringView sAllocatorName, ezUInt64 uiSize, bool bAllocation)
+{
+  EZ_IGNORE_UNUSED(sAllocatorName);
+  EZ_IGNORE_UNUSED(uiSize);
+  EZ_IGNORE_UNUSED(bAllocation);
+}
+
+void ezProfilingSystem::AddMutexWait(ezTime beginTime, ezTime endTime)
+{
+  EZ_IGNORE_UNUSED(beginTime);
+  EZ_IGNORE_UNUSED(endTime);
+}
+
+bool ezProfilingSystem::IsRecordingMutexWaits()
+{
+  return false;
+}
+
+void ezProfilingSystem::FlushMutexWaits() {}
+
+void ezProfilingSystem::AddPendingEvents() {}
+
 void ezProfilingSystem::InitializeGPUData(ezUInt32 gpuCount)
 {
   EZ_IGNORE_UNUSED(gpuCount);
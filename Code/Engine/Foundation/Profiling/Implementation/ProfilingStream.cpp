@@ -0,0 +1,1383 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Application/Application.h>
+#include <Foundation/Configuration/Plugin.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/JSONWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Profiling/ProfilingStream.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+ezAtomicBool ezProfilingStream::s_bCapturing;
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+
+namespace
+{
+  // File layout:
+  //   header: magic, version, process ID, application name, GPU count
+  //   a sequence of blocks, each starting with its BlockType
+  //   BlockType::End
+  //
+  // Every events block contains the events of one thread. The first timestamp in a block is relative to zero,
+  // all others are relative to the previous one, so every block can be decoded on its own.
+  // Names are always written before the first block that references them.
+
+  constexpr ezUInt32 s_uiCaptureMagic = 0x53505A45; // 'EZPS'
+  constexpr ezUInt8 s_uiCaptureVersion = 2; // 2: MutexWait events
+
+  enum class BlockType : ezUInt8
+  {
+    End = 0,
+    Names = 1,   ///< ezUInt32 count, then pairs of ezUInt32 ID and string
+    Events = 2,  ///< ezUInt64 thread ID, ezUInt32 event count, ezUInt32 byte size, then the encoded events
+    Threads = 3, ///< ezUInt32 count, then pairs of ezUInt64 thread ID and string
+  };
+
+  enum class EventType : ezUInt8
+  {
+    CPUScope = 1, ///< name ID, function name ID (0 for none), begin timestamp, duration
+    GPUScope = 2, ///< GPU index, name ID, begin timestamp, duration
+    Frame = 3,    ///< frame count, start timestamp
+    Counter = 4,  ///< name ID, ezUInt8 counter type, timestamp, 8 bytes double value
+    Memory = 5,    ///< allocator name ID, ezUInt8 1 for allocations and 0 for deallocations, size, timestamp
+    MutexWait = 6, ///< ID of the thread that waited, which may differ from the thread of the block, begin timestamp, duration
+  };
+
+  enum
+  {
+    CHUNK_SIZE = 64 * 1024,
+    MAX_EVENT_SIZE = 64, ///< Upper bound of the encoded size of a single event.
+  };
+
+  /// Partially filled chunks are written when they are older than this, so that idle threads don't hold back their events.
+  const ezTime s_FlushInterval = ezTime::MakeFromMilliseconds(500);
+
+  struct EventChunk
+  {
+    EventChunk* m_pNext = nullptr; ///< Links the full chunks that wait for the writer thread.
+    ezUInt64 m_uiThreadId = 0;
+    ezUInt32 m_uiNumEvents = 0;
+    ezUInt32 m_uiSize = 0;
+    ezTime m_CreationTime;
+    ezUInt8 m_Data[CHUNK_SIZE];
+  };
+
+  /// Number of chunks that are allocated when a capture starts. More are only allocated when the writer thread can't keep up.
+  constexpr ezUInt32 s_uiNumPreallocatedChunks = 16;
+
+  /// Stored as the chunk of a thread that currently has none.
+  ezUInt8 s_NoChunkTag = 0;
+  void* const s_pNoChunk = &s_NoChunkTag;
+
+  /// \brief The data of one thread that records events.
+  ///
+  /// Only the owning thread writes events into its chunk. While it does, it takes the chunk out of m_pChunk, so the writer thread
+  /// can only take a partially filled chunk away in between two events and never has to wait for, or block, the owning thread.
+  struct ThreadState
+  {
+    void* m_pChunk = s_pNoChunk; ///< The current EventChunk, s_pNoChunk, or nullptr while the owning thread writes an event.
+    ezUInt64 m_uiThreadId = 0;
+    ezInt32 m_iCacheGeneration = -1;
+    ezInt64 m_iLastTimestamp = 0;
+
+    // caches of the global name IDs, to avoid locking for names that this thread already used
+    ezHashTable<ezUInt64, ezUInt32, ezHashHelper<ezUInt64>, ezStaticsAllocatorWrapper> m_NameIds;
+    ezHashTable<const void*, ezUInt32, ezHashHelper<const void*>, ezStaticsAllocatorWrapper> m_FunctionNameIds;
+  };
+
+  struct PendingName
+  {
+    ezUInt32 m_uiId = 0;
+    ezString m_sName;
+  };
+
+  class ezProfilingStreamWriterThread : public ezThread
+  {
+  public:
+    ezProfilingStreamWriterThread()
+      : ezThread("Profiling Stream Writer")
+    {
+    }
+
+  private:
+    virtual ezUInt32 Run() override;
+  };
+
+  struct StreamData
+  {
+    ezMutex m_ControlMutex; ///< Serializes StartCapture() and StopCapture().
+
+    ezMutex m_Mutex; ///< Protects the thread states and the names.
+    ezDynamicArray<ThreadState*, ezStaticsAllocatorWrapper> m_ThreadStates;
+    ezHashTable<ezUInt64, ezUInt32, ezHashHelper<ezUInt64>, ezStaticsAllocatorWrapper> m_NameIds;
+    ezDynamicArray<PendingName, ezStaticsAllocatorWrapper> m_PendingNames;
+    ezUInt32 m_uiNextNameId = 1;
+
+    void* m_pFullChunks = nullptr; ///< The full chunks, linked through EventChunk::m_pNext. Only modified with atomic operations.
+
+    ezMutex m_PoolMutex; ///< Protects m_FreeChunks. Only locked once per chunk.
+    ezDynamicArray<EventChunk*, ezStaticsAllocatorWrapper> m_FreeChunks;
+
+    // only accessed by the writer thread while it is running
+    ezUniquePtr<ezFileWriter> m_pFile;
+    ezUInt64 m_uiNumBytes = 0;
+    ezUInt64 m_uiNumEvents = 0;
+    bool m_bWriteError = false;
+
+    ezThreadSignal m_WriterSignal;
+    ezAtomicBool m_bStopWriter;
+    ezUniquePtr<ezProfilingStreamWriterThread> m_pWriterThread;
+  };
+
+  StreamData& GetStreamData()
+  {
+    static StreamData s_Data;
+    return s_Data;
+  }
+
+  /// \brief Incremented when a capture starts and when plugins are unloaded, which invalidates the name caches of all threads.
+  ezAtomicInteger32 s_iCacheGeneration;
+
+  thread_local ThreadState* s_pThreadState = nullptr;
+  thread_local bool s_bThreadExited = false;
+
+  void PluginEventHandler(const ezPluginEvent& e)
+  {
+    // function names are cached by pointer, an unloaded plugin's strings may be replaced by different ones at the same address
+    if (e.m_EventType == ezPluginEvent::AfterUnloading)
+    {
+      s_iCacheGeneration.Increment();
+    }
+  }
+
+  EZ_ALWAYS_INLINE ezInt64 ToTimestamp(ezTime time)
+  {
+    return static_cast<ezInt64>(time.GetNanoseconds());
+  }
+
+  EZ_ALWAYS_INLINE ezUInt8* WriteVarUInt(ezUInt8* pData, ezUInt64 uiValue)
+  {
+    while (uiValue >= 0x80)
+    {
+      *pData++ = static_cast<ezUInt8>(uiValue | 0x80);
+      uiValue >>= 7;
+    }
+
+    *pData++ = static_cast<ezUInt8>(uiValue);
+    return pData;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt8* WriteVarInt(ezUInt8* pData, ezInt64 iValue)
+  {
+    // zig-zag encoding, so that small negative values also only need few bytes
+    return WriteVarUInt(pData, (static_cast<ezUInt64>(iValue) << 1) ^ static_cast<ezUInt64>(iValue >> 63));
+  }
+
+  bool ReadVarUInt(const ezUInt8*& ref_pData, const ezUInt8* pEnd, ezUInt64& out_uiValue)
+  {
+    out_uiValue = 0;
+
+    for (ezUInt32 uiShift = 0; uiShift < 64 && ref_pData < pEnd; uiShift += 7)
+    {
+      const ezUInt8 uiByte = *ref_pData++;
+      out_uiValue |= static_cast<ezUInt64>(uiByte & 0x7F) << uiShift;
+
+      if ((uiByte & 0x80) == 0)
+        return true;
+    }
+
+    return false;
+  }
+
+  bool ReadVarInt(const ezUInt8*& ref_pData, const ezUInt8* pEnd, ezInt64& out_iValue)
+  {
+    ezUInt64 uiValue = 0;
+    if (!ReadVarUInt(ref_pData, pEnd, uiValue))
+      return false;
+
+    out_iValue = static_cast<ezInt64>(uiValue >> 1) ^ -static_cast<ezInt64>(uiValue & 1);
+    return true;
+  }
+
+  EZ_ALWAYS_INLINE void* ReadPointer(void* const& pPointer)
+  {
+    return *static_cast<void* const volatile*>(&pPointer);
+  }
+
+  /// \brief Hands a full chunk to the writer thread.
+  void PushFullChunk(StreamData& ref_data, EventChunk* pChunk)
+  {
+    // chunks are only ever pushed one by one and the writer thread always takes the whole list, so there is no ABA problem
+    void* pHead = nullptr;
+    do
+    {
+      pHead = ReadPointer(ref_data.m_pFullChunks);
+      pChunk->m_pNext = static_cast<EventChunk*>(pHead);
+    } while (!ezAtomicUtils::TestAndSet(&ref_data.m_pFullChunks, pHead, pChunk));
+
+    ref_data.m_WriterSignal.RaiseSignal();
+  }
+
+  /// \brief Takes all full chunks, in the order in which they were pushed.
+  template <typename ArrayType>
+  void TakeFullChunks(StreamData& ref_data, ArrayType& inout_chunks)
+  {
+    void* pHead = nullptr;
+    do
+    {
+      pHead = ReadPointer(ref_data.m_pFullChunks);
+    } while (!ezAtomicUtils::TestAndSet(&ref_data.m_pFullChunks, pHead, nullptr));
+
+    const ezUInt32 uiFirstChunk = inout_chunks.GetCount();
+    for (EventChunk* pChunk = static_cast<EventChunk*>(pHead); pChunk != nullptr; pChunk = pChunk->m_pNext)
+    {
+      inout_chunks.PushBack(pChunk);
+    }
+
+    // the list is in reverse order
+    for (ezUInt32 i = uiFirstChunk, j = inout_chunks.GetCount(); i + 1 < j; ++i, --j)
+    {
+      ezMath::Swap(inout_chunks[i], inout_chunks[j - 1]);
+    }
+  }
+
+  EventChunk* AllocateChunk(StreamData& ref_data)
+  {
+    {
+      EZ_LOCK(ref_data.m_PoolMutex);
+
+      if (!ref_data.m_FreeChunks.IsEmpty())
+      {
+        EventChunk* pChunk = ref_data.m_FreeChunks.PeekBack();
+        ref_data.m_FreeChunks.PopBack();
+        return pChunk;
+      }
+    }
+
+    // if the writer can't keep up, chunks pile up in memory instead of dropping events
+    return EZ_DEFAULT_NEW(EventChunk);
+  }
+
+  struct ThreadStateOwner
+  {
+    ~ThreadStateOwner()
+    {
+      s_bThreadExited = true;
+
+      if (s_pThreadState == nullptr)
+        return;
+
+      auto& data = GetStreamData();
+      EZ_LOCK(data.m_Mutex);
+
+      // the writer thread only takes chunks while it holds the mutex, so nobody else accesses the chunk anymore
+      void* pChunk = s_pThreadState->m_pChunk;
+      if (pChunk != s_pNoChunk)
+      {
+        PushFullChunk(data, static_cast<EventChunk*>(pChunk));
+      }
+
+      data.m_ThreadStates.RemoveAndSwap(s_pThreadState);
+      EZ_DELETE(ezFoundation::GetStaticsAllocator(), s_pThreadState);
+    }
+  };
+
+  thread_local ThreadStateOwner s_ThreadStateOwner;
+
+  /// \brief Returns the state of the current thread, or nullptr if the thread is already shutting down.
+  ThreadState* GetThreadState()
+  {
+    if (s_pThreadState == nullptr && !s_bThreadExited)
+    {
+      // registers the destructor that hands the remaining events over and deallocates the state when the thread exits
+      EZ_IGNORE_UNUSED(&s_ThreadStateOwner);
+
+      ThreadState* pState = EZ_NEW(ezFoundation::GetStaticsAllocator(), ThreadState);
+      pState->m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+
+      auto& data = GetStreamData();
+      EZ_LOCK(data.m_Mutex);
+      data.m_ThreadStates.PushBack(pState);
+
+      s_pThreadState = pState;
+    }
+
+    return s_pThreadState;
+  }
+
+  ezUInt32 InternName(ThreadState& ref_state, ezStringView sName)
+  {
+    const ezUInt64 uiHash = ezHashingUtils::xxHash64String(sName);
+
+    ezUInt32 uiId = 0;
+    if (ref_state.m_NameIds.TryGetValue(uiHash, uiId))
+      return uiId;
+
+    {
+      auto& data = GetStreamData();
+      EZ_LOCK(data.m_Mutex);
+
+      if (!data.m_NameIds.TryGetValue(uiHash, uiId))
+      {
+        uiId = data.m_uiNextNameId++;
+        data.m_NameIds.Insert(uiHash, uiId);
+
+        PendingName& name = data.m_PendingNames.ExpandAndGetRef();
+        name.m_uiId = uiId;
+        name.m_sName = sName;
+      }
+    }
+
+    ref_state.m_NameIds.Insert(uiHash, uiId);
+    return uiId;
+  }
+
+  ezUInt32 InternFunctionName(ThreadState& ref_state, const char* szFunctionName)
+  {
+    if (szFunctionName == nullptr)
+      return 0;
+
+    // function names are string literals, so they can be cached by address
+    ezUInt32 uiId = 0;
+    if (!ref_state.m_FunctionNameIds.TryGetValue(szFunctionName, uiId))
+    {
+      uiId = InternName(ref_state, szFunctionName);
+      ref_state.m_FunctionNameIds.Insert(szFunctionName, uiId);
+    }
+
+    return uiId;
+  }
+
+  void ValidateCaches(ThreadState& ref_state)
+  {
+    const ezInt32 iGeneration = s_iCacheGeneration;
+    if (ref_state.m_iCacheGeneration != iGeneration)
+    {
+      ref_state.m_NameIds.Clear();
+      ref_state.m_FunctionNameIds.Clear();
+      ref_state.m_iCacheGeneration = iGeneration;
+    }
+  }
+
+  /// \brief Gives the current thread exclusive access to its chunk while it writes one event.
+  ///
+  /// Names must be interned before, since that locks StreamData::m_Mutex, which StopCapture() holds while it waits for the chunks.
+  class EventScope
+  {
+  public:
+    EZ_ALWAYS_INLINE explicit EventScope(ThreadState& ref_state)
+      : m_State(ref_state)
+    {
+      // only the writer thread replaces the chunk in the meantime, which happens at most every s_FlushInterval
+      do
+      {
+        m_pChunk = ReadPointer(m_State.m_pChunk);
+        EZ_ASSERT_DEBUG(m_pChunk != nullptr, "Profiling stream events must not be recorded recursively.");
+      } while (!ezAtomicUtils::TestAndSet(&m_State.m_pChunk, m_pChunk, nullptr));
+
+      // StopCapture() resets the flag before it takes the chunks, so when it is still set here, this event ends up in the capture
+      m_bCapturing = ezProfilingStream::IsCapturing();
+    }
+
+    EZ_ALWAYS_INLINE ~EventScope()
+    {
+      // nobody else modifies the slot while it is empty
+      ezAtomicUtils::TestAndSet(&m_State.m_pChunk, nullptr, m_pChunk);
+    }
+
+    EZ_ALWAYS_INLINE bool IsCapturing() const { return m_bCapturing; }
+
+    EZ_ALWAYS_INLINE ezUInt8* BeginEvent(EventType type)
+    {
+      if (m_pChunk == s_pNoChunk || static_cast<EventChunk*>(m_pChunk)->m_uiSize + MAX_EVENT_SIZE > CHUNK_SIZE)
+      {
+        SwapChunk();
+      }
+
+      EventChunk* pChunk = static_cast<EventChunk*>(m_pChunk);
+      ezUInt8* pData = pChunk->m_Data + pChunk->m_uiSize;
+      *pData = static_cast<ezUInt8>(type);
+      return pData + 1;
+    }
+
+    EZ_ALWAYS_INLINE void EndEvent(ezUInt8* pDataEnd)
+    {
+      EventChunk* pChunk = static_cast<EventChunk*>(m_pChunk);
+      pChunk->m_uiSize = static_cast<ezUInt32>(pDataEnd - pChunk->m_Data);
+      pChunk->m_uiNumEvents++;
+    }
+
+    EZ_ALWAYS_INLINE ezUInt8* WriteTimestamp(ezUInt8* pData, ezInt64 iTimestamp)
+    {
+      pData = WriteVarInt(pData, iTimestamp - m_State.m_iLastTimestamp);
+      m_State.m_iLastTimestamp = iTimestamp;
+      return pData;
+    }
+
+  private:
+    void SwapChunk()
+    {
+      auto& data = GetStreamData();
+
+      if (m_pChunk != s_pNoChunk)
+      {
+        PushFullChunk(data, static_cast<EventChunk*>(m_pChunk));
+      }
+
+      EventChunk* pNewChunk = AllocateChunk(data);
+      pNewChunk->m_pNext = nullptr;
+      pNewChunk->m_uiThreadId = m_State.m_uiThreadId;
+      pNewChunk->m_uiNumEvents = 0;
+      pNewChunk->m_uiSize = 0;
+      pNewChunk->m_CreationTime = ezTime::Now();
+
+      m_pChunk = pNewChunk;
+      m_State.m_iLastTimestamp = 0;
+    }
+
+    ThreadState& m_State;
+    void* m_pChunk = nullptr;
+    bool m_bCapturing = false;
+  };
+
+  void WriteToFile(StreamData& ref_data, const void* pData, ezUInt64 uiSize)
+  {
+    if (ref_data.m_pFile->WriteBytes(pData, uiSize).Failed())
+    {
+      ref_data.m_bWriteError = true;
+    }
+
+    ref_data.m_uiNumBytes += uiSize;
+  }
+
+  template <typename T>
+  void WriteToFile(StreamData& ref_data, const T& value)
+  {
+    WriteToFile(ref_data, &value, sizeof(T));
+  }
+
+  void WriteStringToFile(StreamData& ref_data, ezStringView sString)
+  {
+    const ezUInt32 uiLength = sString.GetElementCount();
+    WriteToFile(ref_data, uiLength);
+    WriteToFile(ref_data, sString.GetStartPointer(), uiLength);
+  }
+
+  /// \brief Takes the partially filled chunks of all threads that are older than s_FlushInterval, or all of them.
+  ///
+  /// Chunks are only taken in between events. With bAllChunks, this waits for threads that are writing an event right now.
+  template <typename ArrayType>
+  void TakeThreadChunks(StreamData& ref_data, bool bAllChunks, ArrayType& inout_chunks)
+  {
+    const ezTime now = ezTime::Now();
+
+    // exiting threads remove their state while holding the mutex
+    EZ_LOCK(ref_data.m_Mutex);
+
+    for (ThreadState* pState : ref_data.m_ThreadStates)
+    {
+      while (true)
+      {
+        void* pChunk = ReadPointer(pState->m_pChunk);
+
+        if (pChunk == nullptr)
+        {
+          if (!bAllChunks)
+            break;
+
+          ezThreadUtils::YieldTimeSlice();
+          continue;
+        }
+
+        if (pChunk == s_pNoChunk || (!bAllChunks && now - static_cast<EventChunk*>(pChunk)->m_CreationTime <= s_FlushInterval))
+          break;
+
+        if (ezAtomicUtils::TestAndSet(&pState->m_pChunk, pChunk, s_pNoChunk))
+        {
+          inout_chunks.PushBack(static_cast<EventChunk*>(pChunk));
+          break;
+        }
+      }
+    }
+  }
+
+  /// \brief Writes all full chunks to the file, and the partially filled ones that are older than s_FlushInterval or all of them.
+  void FlushChunks(bool bAllChunks)
+  {
+    auto& data = GetStreamData();
+
+    ezHybridArray<EventChunk*, 16> chunks;
+    TakeThreadChunks(data, bAllChunks, chunks);
+
+    // taken after the chunks of the threads, which exiting threads hand over as full chunks
+    TakeFullChunks(data, chunks);
+
+    // names have to be taken after the chunks, so that all names referenced by the chunks are written first
+    ezDynamicArray<PendingName> names;
+
+    {
+      EZ_LOCK(data.m_Mutex);
+      names.Reserve(data.m_PendingNames.GetCount());
+
+      for (PendingName& name : data.m_PendingNames)
+      {
+        names.PushBack(std::move(name));
+      }
+
+      data.m_PendingNames.Clear();
+    }
+
+    if (!names.IsEmpty())
+    {
+      WriteToFile(data, BlockType::Names);
+      WriteToFile(data, names.GetCount());
+
+      for (const PendingName& name : names)
+      {
+        WriteToFile(data, name.m_uiId);
+        WriteStringToFile(data, name.m_sName);
+      }
+    }
+
+    for (EventChunk* pChunk : chunks)
+    {
+      WriteToFile(data, BlockType::Events);
+      WriteToFile(data, pChunk->m_uiThreadId);
+      WriteToFile(data, pChunk->m_uiNumEvents);
+      WriteToFile(data, pChunk->m_uiSize);
+      WriteToFile(data, pChunk->m_Data, pChunk->m_uiSize);
+
+      data.m_uiNumEvents += pChunk->m_uiNumEvents;
+    }
+
+    if (!chunks.IsEmpty())
+    {
+      EZ_LOCK(data.m_PoolMutex);
+      data.m_FreeChunks.PushBackRange(chunks);
+    }
+  }
+
+  ezUInt32 ezProfilingStreamWriterThread::Run()
+  {
+    auto& data = GetStreamData();
+
+    while (!data.m_bStopWriter)
+    {
+      data.m_WriterSignal.WaitForSignal(s_FlushInterval);
+      FlushChunks(false);
+    }
+
+    return 0;
+  }
+} // namespace
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingStream)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "ProfilingSystem"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_STARTUP
+  {
+    ezPlugin::Events().AddEventHandler(PluginEventHandler);
+  }
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    if (ezProfilingStream::IsCapturing())
+    {
+      ezProfilingStream::StopCapture().IgnoreResult();
+    }
+
+    ezPlugin::Events().RemoveEventHandler(PluginEventHandler);
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+// static
+ezResult ezProfilingStream::StartCapture(ezStringView sFile)
+{
+  auto& data = GetStreamData();
+  EZ_LOCK(data.m_ControlMutex);
+
+  if (s_bCapturing)
+  {
+    ezLog::Error("Can't start streaming profiling capture '{}', another capture is already running.", sFile);
+    return EZ_FAILURE;
+  }
+
+  data.m_pFile = EZ_DEFAULT_NEW(ezFileWriter);
+  if (data.m_pFile->Open(sFile).Failed())
+  {
+    ezLog::Error("Could not open '{}' for the streaming profiling capture.", sFile);
+    data.m_pFile.Clear();
+    return EZ_FAILURE;
+  }
+
+  {
+    EZ_LOCK(data.m_Mutex);
+    data.m_NameIds.Clear();
+    data.m_PendingNames.Clear();
+    data.m_uiNextNameId = 1;
+  }
+
+  // IDs are only valid within one capture
+  s_iCacheGeneration.Increment();
+
+  {
+    EZ_LOCK(data.m_PoolMutex);
+
+    while (data.m_FreeChunks.GetCount() < s_uiNumPreallocatedChunks)
+    {
+      data.m_FreeChunks.PushBack(EZ_DEFAULT_NEW(EventChunk));
+    }
+  }
+
+  data.m_uiNumBytes = 0;
+  data.m_uiNumEvents = 0;
+  data.m_bWriteError = false;
+
+  ezOsProcessID uiProcessID = 0;
+#  if EZ_ENABLED(EZ_SUPPORTS_PROCESSES)
+  uiProcessID = ezProcess::GetCurrentProcessID();
+#  endif
+
+  WriteToFile(data, s_uiCaptureMagic);
+  WriteToFile(data, s_uiCaptureVersion);
+  WriteToFile(data, static_cast<ezUInt32>(uiProcessID));
+  WriteStringToFile(data, ezApplication::GetApplicationInstance() ? ezApplication::GetApplicationInstance()->GetApplicationName().GetView() : ezStringView("ezEngine"));
+  WriteToFile(data, ezProfilingSystem::GetGPUCount());
+
+  data.m_bStopWriter = false;
+  data.m_pWriterThread = EZ_DEFAULT_NEW(ezProfilingStreamWriterThread);
+  data.m_pWriterThread->Start();
+
+  s_bCapturing = true;
+
+  ezLog::Info("Started streaming profiling capture to '{}'.", data.m_pFile->GetFilePathAbsolute().GetData());
+  return EZ_SUCCESS;
+}
+
+// static
+ezResult ezProfilingStream::StopCapture()
+{
+  auto& data = GetStreamData();
+  EZ_LOCK(data.m_ControlMutex);
+
+  if (!s_bCapturing)
+    return EZ_FAILURE;
+
+  // threads check this again after taking their chunk, so no events are added after their final chunks were taken
+  s_bCapturing = false;
+
+  data.m_bStopWriter = true;
+  data.m_WriterSignal.RaiseSignal();
+  data.m_pWriterThread->Join();
+  data.m_pWriterThread.Clear();
+
+  FlushChunks(true);
+
+  {
+    ezHybridArray<ezProfilingSystem::ThreadInfo, 16> threadInfos;
+    ezProfilingSystem::GetThreadInfos(threadInfos);
+
+    WriteToFile(data, BlockType::Threads);
+    WriteToFile(data, threadInfos.GetCount());
+
+    for (const auto& info : threadInfos)
+    {
+      WriteToFile(data, info.m_uiThreadId);
+      WriteStringToFile(data, info.m_sName);
+    }
+  }
+
+  WriteToFile(data, BlockType::End);
+
+  data.m_pFile->Close();
+  data.m_pFile.Clear();
+
+  {
+    EZ_LOCK(data.m_PoolMutex);
+
+    for (EventChunk* pChunk : data.m_FreeChunks)
+    {
+      EZ_DEFAULT_DELETE(pChunk);
+    }
+
+    data.m_FreeChunks.Clear();
+    data.m_FreeChunks.Compact();
+  }
+
+  {
+    EZ_LOCK(data.m_Mutex);
+    data.m_NameIds.Clear();
+    data.m_NameIds.Compact();
+  }
+
+  if (data.m_bWriteError)
+  {
+    ezLog::Error("Writing the streaming profiling capture failed.");
+    return EZ_FAILURE;
+  }
+
+  ezLog::Info("Streaming profiling capture finished: {} events, {} bytes.", data.m_uiNumEvents, data.m_uiNumBytes);
+  return EZ_SUCCESS;
+}
+
+// static
+ezProfilingStream::Stats ezProfilingStream::GetStats()
+{
+  auto& data = GetStreamData();
+
+  Stats stats;
+  stats.m_uiNumEvents = data.m_uiNumEvents;
+  stats.m_uiNumBytes = data.m_uiNumBytes;
+
+  EZ_LOCK(data.m_Mutex);
+  stats.m_uiNumNames = data.m_uiNextNameId - 1;
+  return stats;
+}
+
+// static
+void ezProfilingStream::AddCPUScope(ezStringView sName, const char* szFunctionName, ezTime beginTime, ezTime endTime)
+{
+  ThreadState* pState = GetThreadState();
+  if (pState == nullptr)
+    return;
+
+  ValidateCaches(*pState);
+
+  const ezUInt32 uiNameId = InternName(*pState, sName);
+  const ezUInt32 uiFunctionId = InternFunctionName(*pState, szFunctionName);
+  const ezInt64 iBegin = ToTimestamp(beginTime);
+
+  EventScope scope(*pState);
+
+  // the capture may have been stopped after the caller checked IsCapturing()
+  if (!scope.IsCapturing())
+    return;
+
+  ezUInt8* pData = scope.BeginEvent(EventType::CPUScope);
+  pData = WriteVarUInt(pData, uiNameId);
+  pData = WriteVarUInt(pData, uiFunctionId);
+  pData = scope.WriteTimestamp(pData, iBegin);
+  pData = WriteVarUInt(pData, static_cast<ezUInt64>(ezMath::Max<ezInt64>(ToTimestamp(endTime) - iBegin, 0)));
+  scope.EndEvent(pData);
+}
+
+// static
+void ezProfilingStream::AddGPUScope(ezStringView sName, ezTime beginTime, ezTime endTime, ezUInt32 uiGpuIndex)
+{
+  ThreadState* pState = GetThreadState();
+  if (pState == nullptr)
+    return;
+
+  ValidateCaches(*pState);
+
+  const ezUInt32 uiNameId = InternName(*pState, sName);
+  const ezInt64 iBegin = ToTimestamp(beginTime);
+
+  EventScope scope(*pState);
+  if (!scope.IsCapturing())
+    return;
+
+  ezUInt8* pData = scope.BeginEvent(EventType::GPUScope);
+  pData = WriteVarUInt(pData, uiGpuIndex);
+  pData = WriteVarUInt(pData, uiNameId);
+  pData = scope.WriteTimestamp(pData, iBegin);
+  pData = WriteVarUInt(pData, static_cast<ezUInt64>(ezMath::Max<ezInt64>(ToTimestamp(endTime) - iBegin, 0)));
+  scope.EndEvent(pData);
+}
+
+// static
+void ezProfilingStream::AddFrame(ezUInt64 uiFrameCount, ezTime startTime)
+{
+  ThreadState* pState = GetThreadState();
+  if (pState == nullptr)
+    return;
+
+  EventScope scope(*pState);
+  if (!scope.IsCapturing())
+    return;
+
+  ezUInt8* pData = scope.BeginEvent(EventType::Frame);
+  pData = WriteVarUInt(pData, uiFrameCount);
+  pData = scope.WriteTimestamp(pData, ToTimestamp(startTime));
+  scope.EndEvent(pData);
+}
+
+// static
+void ezProfilingStream::AddCounter(ezStringView sName, double fValue, ezProfilingSystem::CounterType type, ezTime time)
+{
+  ThreadState* pState = GetThreadState();
+  if (pState == nullptr)
+    return;
+
+  ValidateCaches(*pState);
+
+  const ezUInt32 uiNameId = InternName(*pState, sName);
+
+  EventScope scope(*pState);
+  if (!scope.IsCapturing())
+    return;
+
+  ezUInt8* pData = scope.BeginEvent(EventType::Counter);
+  pData = WriteVarUInt(pData, uiNameId);
+  *pData++ = static_cast<ezUInt8>(type);
+  pData = scope.WriteTimestamp(pData, ToTimestamp(time));
+  ezMemoryUtils::Copy(pData, reinterpret_cast<const ezUInt8*>(&fValue), sizeof(fValue));
+  scope.EndEvent(pData + sizeof(fValue));
+}
+
+// static
+void ezProfilingStream::AddMemoryEvent(const ezProfilingSystem::MemoryEvent& memoryEvent)
+{
+  ThreadState* pState = GetThreadState();
+  if (pState == nullptr)
+    return;
+
+  ValidateCaches(*pState);
+
+  const ezUInt32 uiNameId = InternName(*pState, static_cast<const char*>(memoryEvent.m_szAllocatorName));
+
+  EventScope scope(*pState);
+  if (!scope.IsCapturing())
+    return;
+
+  ezUInt8* pData = scope.BeginEvent(EventType::Memory);
+  pData = WriteVarUInt(pData, uiNameId);
+  *pData++ = memoryEvent.m_bAllocation ? 1 : 0;
+  pData = WriteVarUInt(pData, memoryEvent.m_uiSize);
+  pData = scope.WriteTimestamp(pData, ToTimestamp(memoryEvent.m_Time));
+  scope.EndEvent(pData);
+}
+
+// static
+void ezProfilingStream::AddMutexWait(ezUInt64 uiThreadId, ezTime beginTime, ezTime endTime)
+{
+  ThreadState* pState = GetThreadState();
+  if (pState == nullptr)
+    return;
+
+  const ezInt64 iBegin = ToTimestamp(beginTime);
+
+  EventScope scope(*pState);
+  if (!scope.IsCapturing())
+    return;
+
+  ezUInt8* pData = scope.BeginEvent(EventType::MutexWait);
+  pData = WriteVarUInt(pData, uiThreadId);
+  pData = scope.WriteTimestamp(pData, iBegin);
+  pData = WriteVarUInt(pData, static_cast<ezUInt64>(ezMath::Max<ezInt64>(ToTimestamp(endTime) - iBegin, 0)));
+  scope.EndEvent(pData);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  struct DecodedScope
+  {
+    ezUInt32 m_uiNameId = 0;
+    ezUInt32 m_uiFunctionId = 0;
+    ezUInt32 m_uiGpuIndex = 0;
+    ezInt64 m_iBegin = 0;
+    ezInt64 m_iEnd = 0;
+  };
+
+  /// \brief Writes a streaming capture as JSON in the format of ezProfilingSystem::ProfilingData::Write().
+  class ezStreamingCaptureConverter
+  {
+  public:
+    ezStreamingCaptureConverter(ezStreamReader& inout_stream, ezStreamWriter& inout_json)
+      : m_Stream(inout_stream)
+    {
+      m_Writer.SetWhitespaceMode(ezJSONWriter::WhitespaceMode::None);
+      m_Writer.SetOutputStream(&inout_json);
+    }
+
+    ezResult Convert()
+    {
+      EZ_SUCCEED_OR_RETURN(ReadHeader());
+
+      m_Writer.BeginObject();
+      m_Writer.BeginArray("traceEvents");
+
+      WriteMetadata("process_name", nullptr, m_sAppName);
+      WriteSortIndex("process_sort_index", nullptr, 0);
+
+      const ezUInt64 uiFramesThreadId = 0;
+      WriteMetadata("thread_name", &uiFramesThreadId, "Frames");
+      WriteSortIndex("thread_sort_index", &uiFramesThreadId, -1);
+
+      // Since there are no actual threads, we assign 1..uiGpuCount as the respective threadID
+      ezStringBuilder sGpuName;
+      for (ezUInt64 uiGpuThreadId = 1; uiGpuThreadId <= m_uiGpuCount; ++uiGpuThreadId)
+      {
+        sGpuName.SetFormat("GPU {}", uiGpuThreadId - 1);
+        WriteMetadata("thread_name", &uiGpuThreadId, sGpuName);
+        WriteSortIndex("thread_sort_index", &uiGpuThreadId, -2);
+      }
+
+      while (true)
+      {
+        BlockType blockType;
+        if (m_Stream.ReadBytes(&blockType, sizeof(blockType)) != sizeof(blockType))
+        {
+          // a capture of an application that crashed has no end marker, convert everything that is there
+          ezLog::Warning("Streaming profiling capture is incomplete.");
+          break;
+        }
+
+        if (blockType == BlockType::End)
+          break;
+
+        switch (blockType)
+        {
+          case BlockType::Names:
+            EZ_SUCCEED_OR_RETURN(ReadNames());
+            break;
+
+          case BlockType::Events:
+            EZ_SUCCEED_OR_RETURN(ReadEvents());
+            break;
+
+          case BlockType::Threads:
+            EZ_SUCCEED_OR_RETURN(ReadThreads());
+            break;
+
+          default:
+            ezLog::Error("Invalid block type {} in streaming profiling capture.", static_cast<ezUInt32>(blockType));
+            return EZ_FAILURE;
+        }
+
+        if (m_Writer.HadWriteError())
+          return EZ_FAILURE;
+      }
+
+      m_Writer.EndArray();
+      m_Writer.EndObject();
+
+      return m_Writer.HadWriteError() ? EZ_FAILURE : EZ_SUCCESS;
+    }
+
+  private:
+    ezResult ReadHeader()
+    {
+      ezUInt32 uiMagic = 0;
+      ezUInt8 uiVersion = 0;
+      EZ_SUCCEED_OR_RETURN(m_Stream.ReadDWordValue(&uiMagic));
+
+      if (uiMagic != s_uiCaptureMagic || m_Stream.ReadBytes(&uiVersion, 1) != 1 || uiVersion == 0 || uiVersion > s_uiCaptureVersion)
+      {
+        ezLog::Error("Data is not a streaming profiling capture or has an unsupported version.");
+        return EZ_FAILURE;
+      }
+
+      EZ_SUCCEED_OR_RETURN(m_Stream.ReadDWordValue(&m_uiProcessId));
+      EZ_SUCCEED_OR_RETURN(ReadString(m_sAppName));
+      EZ_SUCCEED_OR_RETURN(m_Stream.ReadDWordValue(&m_uiGpuCount));
+      return EZ_SUCCESS;
+    }
+
+    ezResult ReadString(ezStringBuilder& out_sString)
+    {
+      ezUInt32 uiLength = 0;
+      EZ_SUCCEED_OR_RETURN(m_Stream.ReadDWordValue(&uiLength));
+
+      m_TempData.SetCountUninitialized(uiLength);
+      if (m_Stream.ReadBytes(m_TempData.GetData(), uiLength) != uiLength)
+        return EZ_FAILURE;
+
+      out_sString = ezStringView(reinterpret_cast<const char*>(m_TempData.GetData()), uiLength);
+      return EZ_SUCCESS;
+    }
+
+    ezResult ReadNames()
+    {
+      ezUInt32 uiCount = 0;
+      EZ_SUCCEED_OR_RETURN(m_Stream.ReadDWordValue(&uiCount));
+
+      ezStringBuilder sName;
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        ezUInt32 uiId = 0;
+        EZ_SUCCEED_OR_RETURN(m_Stream.ReadDWordValue(&uiId));
+        EZ_SUCCEED_OR_RETURN(ReadString(sName));
+
+        if (uiId >= m_Names.GetCount())
+        {
+          m_Names.SetCount(uiId + 1);
+        }
+
+        m_Names[uiId] = sName;
+      }
+
+      return EZ_SUCCESS;
+    }
+
+    ezResult ReadThreads()
+    {
+      ezUInt32 uiCount = 0;
+      EZ_SUCCEED_OR_RETURN(m_Stream.ReadDWordValue(&uiCount));
+
+      ezStringBuilder sName;
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        ezUInt64 uiThreadId = 0;
+        EZ_SUCCEED_OR_RETURN(m_Stream.ReadQWordValue(&uiThreadId));
+        EZ_SUCCEED_OR_RETURN(ReadString(sName));
+
+        // Since we introduced fake thread IDs via the GPUs, we simply shift all real thread IDs to be in a different range to avoid collisions.
+        uiThreadId += m_uiGpuCount + 1;
+        WriteMetadata("thread_name", &uiThreadId, sName);
+        WriteSortIndex("thread_sort_index", &uiThreadId, static_cast<ezInt32>(i));
+      }
+
+      return EZ_SUCCESS;
+    }
+
+    ezResult ReadEvents()
+    {
+      ezUInt64 uiThreadId = 0;
+      ezUInt32 uiNumEvents = 0;
+      ezUInt32 uiSize = 0;
+      EZ_SUCCEED_OR_RETURN(m_Stream.ReadQWordValue(&uiThreadId));
+      EZ_SUCCEED_OR_RETURN(m_Stream.ReadDWordValue(&uiNumEvents));
+      EZ_SUCCEED_OR_RETURN(m_Stream.ReadDWordValue(&uiSize));
+
+      if (uiSize > CHUNK_SIZE)
+        return EZ_FAILURE;
+
+      m_TempData.SetCountUninitialized(uiSize);
+      if (m_Stream.ReadBytes(m_TempData.GetData(), uiSize) != uiSize)
+        return EZ_FAILURE;
+
+      m_CPUScopes.Clear();
+      m_GPUScopes.Clear();
+
+      const ezUInt8* pData = m_TempData.GetData();
+      const ezUInt8* pEnd = pData + uiSize;
+      ezInt64 iLastTimestamp = 0;
+
+      auto ReadTimestamp = [&](ezInt64& out_iTimestamp)
+      {
+        ezInt64 iDelta = 0;
+        if (!ReadVarInt(pData, pEnd, iDelta))
+          return false;
+
+        iLastTimestamp += iDelta;
+        out_iTimestamp = iLastTimestamp;
+        return true;
+      };
+
+      while (pData < pEnd)
+      {
+        const EventType type = static_cast<EventType>(*pData++);
+        ezUInt64 uiValue0 = 0;
+        ezUInt64 uiValue1 = 0;
+        ezInt64 iTimestamp = 0;
+        bool bValid = ReadVarUInt(pData, pEnd, uiValue0);
+
+        if (type == EventType::CPUScope || type == EventType::GPUScope)
+        {
+          ezUInt64 uiDuration = 0;
+          bValid = bValid && ReadVarUInt(pData, pEnd, uiValue1) && ReadTimestamp(iTimestamp) && ReadVarUInt(pData, pEnd, uiDuration);
+
+          DecodedScope& scope = (type == EventType::CPUScope) ? m_CPUScopes.ExpandAndGetRef() : m_GPUScopes.ExpandAndGetRef();
+          scope.m_uiNameId = static_cast<ezUInt32>(type == EventType::CPUScope ? uiValue0 : uiValue1);
+          scope.m_uiFunctionId = static_cast<ezUInt32>(type == EventType::CPUScope ? uiValue1 : 0);
+          scope.m_uiGpuIndex = static_cast<ezUInt32>(type == EventType::GPUScope ? uiValue0 : 0);
+          scope.m_iBegin = iTimestamp;
+          scope.m_iEnd = iTimestamp + static_cast<ezInt64>(uiDuration);
+        }
+        else if (type == EventType::Frame)
+        {
+          bValid = bValid && ReadTimestamp(iTimestamp);
+
+          if (bValid && m_bHasFrame)
+          {
+            ezStringBuilder sFrameName;
+            sFrameName.SetFormat("Frame {}", uiValue0);
+            WriteScope(sFrameName, {}, 0, m_iLastFrameStart, iTimestamp);
+          }
+
+          m_bHasFrame = true;
+          m_iLastFrameStart = iTimestamp;
+        }
+        else if (type == EventType::Counter)
+        {
+          double fValue = 0.0;
+          bValid = bValid && pData < pEnd;
+          const ezUInt8 uiCounterType = bValid ? *pData++ : 0;
+          bValid = bValid && ReadTimestamp(iTimestamp) && (pEnd - pData) >= static_cast<ptrdiff_t>(sizeof(fValue));
+
+          if (bValid)
+          {
+            ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&fValue), pData, sizeof(fValue));
+            pData += sizeof(fValue);
+            WriteCounter(GetName(static_cast<ezUInt32>(uiValue0)), static_cast<ezProfilingSystem::CounterType>(uiCounterType), iTimestamp, fValue);
+          }
+        }
+        else if (type == EventType::MutexWait)
+        {
+          ezUInt64 uiDuration = 0;
+          bValid = bValid && ReadTimestamp(iTimestamp) && ReadVarUInt(pData, pEnd, uiDuration);
+
+          if (bValid)
+          {
+            WriteScope("Mutex Wait", {}, uiValue0 + m_uiGpuCount + 1, iTimestamp, iTimestamp + static_cast<ezInt64>(uiDuration));
+          }
+        }
+        else if (type == EventType::Memory)
+        {
+          bValid = bValid && pData < pEnd;
+          const bool bAllocation = bValid && *pData++ != 0;
+          ezUInt64 uiSize = 0;
+          bValid = bValid && ReadVarUInt(pData, pEnd, uiSize) && ReadTimestamp(iTimestamp);
+
+          if (bValid)
+          {
+            WriteMemoryEvent(GetName(static_cast<ezUInt32>(uiValue0)), bAllocation, uiSize, uiThreadId + m_uiGpuCount + 1, iTimestamp);
+          }
+        }
+        else
+        {
+          bValid = false;
+        }
+
+        if (!bValid)
+        {
+          ezLog::Error("Invalid event data in streaming profiling capture.");
+          return EZ_FAILURE;
+        }
+      }
+
+      // See the comment about sorting scopes in ezProfilingSystem::ProfilingData::Write().
+      auto SortByDuration = [](const DecodedScope& a, const DecodedScope& b)
+      { return (a.m_iEnd - a.m_iBegin) > (b.m_iEnd - b.m_iBegin); };
+
+      m_CPUScopes.Sort(SortByDuration);
+      m_GPUScopes.Sort(SortByDuration);
+
+      for (const DecodedScope& scope : m_CPUScopes)
+      {
+        WriteScope(GetName(scope.m_uiNameId), scope.m_uiFunctionId != 0 ? GetName(scope.m_uiFunctionId) : ezStringView(), uiThreadId + m_uiGpuCount + 1, scope.m_iBegin, scope.m_iEnd);
+      }
+
+      for (const DecodedScope& scope : m_GPUScopes)
+      {
+        WriteScope(GetName(scope.m_uiNameId), {}, scope.m_uiGpuIndex + 1, scope.m_iBegin, scope.m_iEnd);
+      }
+
+      return EZ_SUCCESS;
+    }
+
+    ezStringView GetName(ezUInt32 uiId) const
+    {
+      return uiId < m_Names.GetCount() ? m_Names[uiId].GetView() : ezStringView("<unknown>");
+    }
+
+    void WriteScope(ezStringView sName, ezStringView sFunctionName, ezUInt64 uiThreadId, ezInt64 iBegin, ezInt64 iEnd)
+    {
+      m_Writer.BeginObject();
+      m_Writer.AddVariableString("name", sName);
+      m_Writer.AddVariableUInt32("pid", m_uiProcessId);
+      m_Writer.AddVariableUInt64("tid", uiThreadId);
+      m_Writer.AddVariableUInt64("ts", static_cast<ezUInt64>(ezTime::MakeFromNanoseconds(static_cast<double>(iBegin)).GetMicroseconds()));
+      m_Writer.AddVariableString("ph", "B");
+
+      if (!sFunctionName.IsEmpty())
+      {
+        m_Writer.BeginObject("args");
+        m_Writer.AddVariableString("function", sFunctionName);
+        m_Writer.EndObject();
+      }
+
+      m_Writer.EndObject();
+
+      m_Writer.BeginObject();
+      m_Writer.AddVariableString("name", sName);
+      m_Writer.AddVariableUInt32("pid", m_uiProcessId);
+      m_Writer.AddVariableUInt64("tid", uiThreadId);
+      m_Writer.AddVariableUInt64("ts", static_cast<ezUInt64>(ezTime::MakeFromNanoseconds(static_cast<double>(iEnd)).GetMicroseconds()));
+      m_Writer.AddVariableString("ph", "E");
+      m_Writer.EndObject();
+    }
+
+    void WriteCounter(ezStringView sName, ezProfilingSystem::CounterType type, ezInt64 iTimestamp, double fValue)
+    {
+      const char* szUnit = "value";
+      if (type == ezProfilingSystem::CounterType::Bytes)
+        szUnit = "bytes";
+      else if (type == ezProfilingSystem::CounterType::Milliseconds)
+        szUnit = "ms";
+
+      m_Writer.BeginObject();
+      m_Writer.AddVariableString("name", sName);
+      m_Writer.AddVariableUInt32("pid", m_uiProcessId);
+      m_Writer.AddVariableUInt64("ts", static_cast<ezUInt64>(ezTime::MakeFromNanoseconds(static_cast<double>(iTimestamp)).GetMicroseconds()));
+      m_Writer.AddVariableString("ph", "C");
+
+      m_Writer.BeginObject("args");
+      m_Writer.AddVariableDouble(szUnit, fValue);
+      m_Writer.EndObject();
+      m_Writer.EndObject();
+    }
+
+    void WriteMemoryEvent(ezStringView sAllocatorName, bool bAllocation, ezUInt64 uiSize, ezUInt64 uiThreadId, ezInt64 iTimestamp)
+    {
+      m_Writer.BeginObject();
+      m_Writer.AddVariableString("name", bAllocation ? "Allocation" : "Deallocation");
+      m_Writer.AddVariableString("cat", "memory");
+      m_Writer.AddVariableUInt32("pid", m_uiProcessId);
+      m_Writer.AddVariableUInt64("tid", uiThreadId);
+      m_Writer.AddVariableUInt64("ts", static_cast<ezUInt64>(ezTime::MakeFromNanoseconds(static_cast<double>(iTimestamp)).GetMicroseconds()));
+      m_Writer.AddVariableString("ph", "i");
+      m_Writer.AddVariableString("s", "t");
+
+      m_Writer.BeginObject("args");
+      m_Writer.AddVariableString("allocator", sAllocatorName);
+      m_Writer.AddVariableUInt64("size", uiSize);
+      m_Writer.EndObject();
+      m_Writer.EndObject();
+    }
+
+    void WriteMetadata(ezStringView sMetadataName, const ezUInt64* pThreadId, ezStringView sValue)
+    {
+      m_Writer.BeginObject();
+      m_Writer.AddVariableString("name", sMetadataName);
+      m_Writer.AddVariableString("cat", "__metadata");
+      m_Writer.AddVariableUInt32("pid", m_uiProcessId);
+      if (pThreadId != nullptr)
+      {
+        m_Writer.AddVariableUInt64("tid", *pThreadId);
+      }
+      m_Writer.AddVariableString("ph", "M");
+
+      m_Writer.BeginObject("args");
+      m_Writer.AddVariableString("name", sValue);
+      m_Writer.EndObject();
+      m_Writer.EndObject();
+    }
+
+    void WriteSortIndex(ezStringView sMetadataName, const ezUInt64* pThreadId, ezInt32 iSortIndex)
+    {
+      m_Writer.BeginObject();
+      m_Writer.AddVariableString("name", sMetadataName);
+      m_Writer.AddVariableString("cat", "__metadata");
+      m_Writer.AddVariableUInt32("pid", m_uiProcessId);
+      if (pThreadId != nullptr)
+      {
+        m_Writer.AddVariableUInt64("tid", *pThreadId);
+      }
+      m_Writer.AddVariableString("ph", "M");
+
+      m_Writer.BeginObject("args");
+      m_Writer.AddVariableInt32("sort_index", iSortIndex);
+      m_Writer.EndObject();
+      m_Writer.EndObject();
+    }
+
+    ezStreamReader& m_Stream;
+    ezStandardJSONWriter m_Writer;
+
+    ezUInt32 m_uiProcessId = 0;
+    ezUInt32 m_uiGpuCount = 0;
+    ezStringBuilder m_sAppName;
+
+    ezDynamicArray<ezString> m_Names;
+    ezDynamicArray<ezUInt8> m_TempData;
+    ezDynamicArray<DecodedScope> m_CPUScopes;
+    ezDynamicArray<DecodedScope> m_GPUScopes;
+
+    bool m_bHasFrame = false;
+    ezInt64 m_iLastFrameStart = 0;
+  };
+} // namespace
+
+// static
+ezResult ezProfilingStream::ConvertToJson(ezStreamReader& inout_stream, ezStreamWriter& inout_json)
+{
+  ezStreamingCaptureConverter converter(inout_stream, inout_json);
+  return converter.Convert();
+}
+
+#else
+
+ezResult ezProfilingStream::StartCapture(ezStringView sFile)
+{
+  EZ_IGNORE_UNUSED(sFile);
+  return EZ_FAILURE;
+}
+
+ezResult ezProfilingStream::StopCapture()
+{
+  return EZ_FAILURE;
+}
+
+ezProfilingStream::Stats ezProfilingStream::GetStats()
+{
+  return Stats();
+}
+
+ezResult ezProfilingStream::ConvertToJson(ezStreamReader& inout_stream, ezStreamWriter& inout_json)
+{
+  EZ_IGNORE_UNUSED(inout_stream);
+  EZ_IGNORE_UNUSED(inout_json);
+  return EZ_FAILURE;
+}
+
+void ezProfilingStream::AddCPUScope(ezStringView sName, const char* szFunctionName, ezTime beginTime, ezTime endTime)
+{
+  EZ_IGNORE_UNUSED(sName);
+  EZ_IGNORE_UNUSED(szFunctionName);
+  EZ_IGNORE_UNUSED(beginTime);
+  EZ_IGNORE_UNUSED(endTime);
+}
+
+void ezProfilingStream::AddGPUScope(ezStringView sName, ezTime beginTime, ezTime endTime, ezUInt32 uiGpuIndex)
+{
+  EZ_IGNORE_UNUSED(sName);
+  EZ_IGNORE_UNUSED(beginTime);
+  EZ_IGNORE_UNUSED(endTime);
+  EZ_IGNORE_UNUSED(uiGpuIndex);
+}
+
+void ezProfilingStream::AddFrame(ezUInt64 uiFrameCount, ezTime startTime)
+{
+  EZ_IGNORE_UNUSED(uiFrameCount);
+  EZ_IGNORE_UNUSED(startTime);
+}
+
+void ezProfilingStream::AddCounter(ezStringView sName, double fValue, ezProfilingSystem::CounterType type, ezTime time)
+{
+  EZ_IGNORE_UNUSED(sName);
+  EZ_IGNORE_UNUSED(fValue);
+  EZ_IGNORE_UNUSED(type);
+  EZ_IGNORE_UNUSED(time);
+}
+
+void ezProfilingStream::AddMemoryEvent(const ezProfilingSystem::MemoryEvent& memoryEvent)
+{
+  EZ_IGNORE_UNUSED(memoryEvent);
+}
+
+void ezProfilingStream::AddMutexWait(ezUInt64 uiThreadId, ezTime beginTime, ezTime endTime)
+{
+  EZ_IGNORE_UNUSED(uiThreadId);
+  EZ_IGNORE_UNUSED(beginTime);
+  EZ_IGNORE_UNUSED(endTime);
+}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Profiling_Implementation_ProfilingStream);
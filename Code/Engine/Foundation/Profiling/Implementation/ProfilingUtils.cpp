@@ -4,6 +4,7 @@
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Profiling/ProfilingStream.h>
 #include <Foundation/Profiling/ProfilingUtils.h>
 
 ezResult ezProfilingUtils::SaveProfilingCapture(ezStringView sCapturePath)
@@ -74,3 +75,29 @@ ezResult ezProfilingUtils::MergeProfilingCaptures(ezStringView sCapturePath1, ez
   ezLog::Info("Merged profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
   return EZ_SUCCESS;
 }
+
+ezResult ezProfilingUtils::ConvertStreamingCapture(ezStringView sStreamingCapturePath, ezStringView sJsonCapturePath)
+{
+  ezFileReader reader;
+  if (reader.Open(sStreamingCapturePath).Failed())
+  {
+    ezLog::Error("Failed to read streaming profiling capture: {}.", sStreamingCapturePath);
+    return EZ_FAILURE;
+  }
+
+  ezFileWriter fileWriter;
+  if (fileWriter.Open(sJsonCapturePath).Failed())
+  {
+    ezLog::Error("Could not write profiling capture to '{0}'.", sJsonCapturePath);
+    return EZ_FAILURE;
+  }
+
+  if (ezProfilingStream::ConvertToJson(reader, fileWriter).Failed())
+  {
+    ezLog::Error("Failed to convert streaming profiling capture: {}.", sStreamingCapturePath);
+    return EZ_FAILURE;
+  }
+
+  ezLog::Info("Profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
+  return EZ_SUCCESS;
+}
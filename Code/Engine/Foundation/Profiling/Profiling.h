@@ -95,6 +95,41 @@ public:
     char m_szName[NAME_SIZE];
   };
 
+  /// \brief Describes how the value of a counter is interpreted.
+  enum class CounterType : ezUInt8
+  {
+    Value,        ///< A plain number, e.g. the number of draw calls.
+    Bytes,        ///< A memory size in bytes.
+    Milliseconds, ///< A duration in milliseconds.
+  };
+
+  /// \brief One sample of a counter track.
+  struct Counter
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    static constexpr ezUInt32 NAME_SIZE = 47;
+
+    ezTime m_Time;
+    double m_fValue;
+    CounterType m_Type;
+    char m_szName[NAME_SIZE];
+  };
+
+  /// \brief A large allocation or deallocation that was reported by ezMemoryTracker.
+  struct MemoryEvent
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    static constexpr ezUInt32 NAME_SIZE = 39;
+
+    ezTime m_Time;
+    ezUInt64 m_uiThreadId;
+    ezUInt64 m_uiSize;
+    bool m_bAllocation;
+    char m_szAllocatorName[NAME_SIZE];
+  };
+
   struct EZ_FOUNDATION_DLL ProfilingData
   {
     ezUInt32 m_uiFramesThreadID = 0;
@@ -110,6 +145,9 @@ public:
 
     ezDynamicArray<ezDynamicArray<GPUScope>> m_GPUScopes;
 
+    ezDynamicArray<Counter> m_Counters;
+    ezDynamicArray<MemoryEvent> m_MemoryEvents;
+
     /// \brief Writes profiling data as JSON to the output stream.
     ezResult Write(ezStreamWriter& ref_outputStream) const;
 
@@ -141,9 +179,19 @@ public:
   /// \brief Get current frame counter
   static ezUInt64 GetFrameCount();
 
+  /// \brief Adds a sample with the current time to the counter track with the given name.
+  ///
+  /// Counters are shown as graphs next to the scopes in the capture. Some counters can be recorded automatically in StartNewFrame():
+  /// the time that threads spent waiting for mutexes held by other threads (see cvar 'Profiling.MutexWaits'), and the memory usage
+  /// and number of allocations reported by ezMemoryTracker (see cvar 'Profiling.MemoryCounters'). Both are disabled by default.
+  static void SetCounter(ezStringView sName, double fValue, CounterType type = CounterType::Value);
+
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, ProfilingSystem);
   friend ezUInt32 RunThread(ezThread* pThread);
+  friend class ezProfilingStream;
+  friend class ezMemoryTracker;
+  friend class ezMutex;
 
   static void Initialize();
   /// \brief Removes profiling data of dead threads.
@@ -155,6 +203,35 @@ private:
   ///  Needs to be called before the thread exits to be able to release profiling memory of dead threads on Reset.
   static void RemoveThread();
 
+  /// \brief Returns the names of all threads that are known to the profiling system.
+  static void GetThreadInfos(ezHybridArray<ThreadInfo, 16>& out_threadInfos);
+  /// \brief Returns the number of GPUs passed to InitializeGPUData().
+  static ezUInt32 GetGPUCount();
+
+  /// \brief Called by ezMemoryTracker after it recorded an allocation or deallocation of a tracked allocator.
+  ///
+  /// Only sizes of at least the cvar 'Profiling.MemoryEventThresholdKB' are recorded, negative values disable memory events.
+  /// The events are queued per thread until AddPendingEvents(). While the queue is full, further events are dropped.
+  static void AddMemoryEvent(ezStringView sAllocatorName, ezUInt64 uiSize, bool bAllocation);
+
+  /// \brief Whether ezMutex should measure contended locks, see cvar 'Profiling.MutexWaits'.
+  static bool IsRecordingMutexWaits();
+
+  /// \brief Called by ezMutex when the calling thread had to wait for a mutex that was held by another thread.
+  ///
+  /// The wait time is added to the per frame counter. Waits that are not discarded (see SetDiscardThreshold()) are queued per thread
+  /// and added as 'Mutex Wait' scopes by FlushMutexWaits().
+  static void AddMutexWait(ezTime beginTime, ezTime endTime);
+
+  /// \brief Adds the queued mutex waits of all threads. Called at the end of every frame and by Capture().
+  static void FlushMutexWaits();
+
+  /// \brief Adds the memory events that were recorded by the calling thread since the last call.
+  ///
+  /// Memory events may be reported while the thread holds arbitrary mutexes, so they are only stored in a thread local buffer at first,
+  /// and added once the thread records its next scope or frame.
+  static void AddPendingEvents();
+
 public:
   /// \brief Initialized internal data structures for GPU profiling data. Needs to be called before adding any data.
   static void InitializeGPUData(ezUInt32 uiGpuCount = 1);
@@ -209,12 +286,19 @@ public:
 /// \brief Used to indicate that a frame is finished and another starts.
 #  define EZ_PROFILER_FRAME_MARKER()
 
+/// \brief Adds a sample to the counter track with the given name.
+///
+/// \sa ezProfilingSystem::SetCounter()
+#  define EZ_PROFILE_COUNTER(CounterName, Value) \
+    ezProfilingSystem::SetCounter(CounterName, static_cast<double>(Value))
+
 #else
 #  define EZ_PROFILE_SCOPE(ScopeName)
 #  define EZ_PROFILE_SCOPE_WITH_TIMEOUT(ScopeName, Timeout)
 #  define EZ_PROFILE_LIST_SCOPE(ListName, FirstSectionName)
 #  define EZ_PROFILE_LIST_NEXT_SECTION(NextSectionName)
 #  define EZ_PROFILER_FRAME_MARKER()
+#  define EZ_PROFILE_COUNTER(CounterName, Value)
 #endif
 
 // Let Tracy override the macros.
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Time/Time.h>
+
+class ezStreamReader;
+class ezStreamWriter;
+
+/// \brief Continuously writes all profiling events to a file, for captures that span a long time.
+///
+/// ezProfilingSystem::Capture() only returns the most recent events that still fit into its ring buffers. A streaming capture instead
+/// records every CPU scope, GPU scope, frame, counter and memory event from StartCapture() to StopCapture().
+///
+/// Events are stored in a compact binary format. Scope and function names are interned, ie. every distinct name is stored only once
+/// and events reference it by ID. Timestamps are delta encoded. Every thread appends its events to its own buffer without locking, full
+/// buffers are written to disk by a background thread and then reused, so recording an event never waits for file I/O.
+///
+/// Use ConvertToJson() or ezProfilingUtils::ConvertStreamingCapture() to turn a streaming capture into the same JSON format that
+/// ezProfilingSystem::ProfilingData::Write() produces.
+class EZ_FOUNDATION_DLL ezProfilingStream
+{
+public:
+  struct Stats
+  {
+    ezUInt64 m_uiNumEvents = 0; ///< Number of events that were written to the file so far.
+    ezUInt64 m_uiNumBytes = 0;  ///< Number of bytes that were written to the file so far.
+    ezUInt32 m_uiNumNames = 0;  ///< Number of distinct scope and function names.
+  };
+
+  /// \brief Starts writing all profiling events to the given file. Fails if a capture is already running or the file can't be opened.
+  static ezResult StartCapture(ezStringView sFile);
+
+  /// \brief Writes all remaining events and closes the file.
+  ///
+  /// Returns EZ_FAILURE if any data could not be written.
+  static ezResult StopCapture();
+
+  /// \brief Whether a streaming capture is currently running.
+  static bool IsCapturing() { return s_bCapturing; }
+
+  /// \brief Returns statistics about the running or the last capture.
+  static Stats GetStats();
+
+  /// \brief Reads a streaming capture and writes it as JSON to \a inout_json.
+  static ezResult ConvertToJson(ezStreamReader& inout_stream, ezStreamWriter& inout_json);
+
+private:
+  friend class ezProfilingSystem;
+
+  static void AddCPUScope(ezStringView sName, const char* szFunctionName, ezTime beginTime, ezTime endTime);
+  static void AddGPUScope(ezStringView sName, ezTime beginTime, ezTime endTime, ezUInt32 uiGpuIndex);
+  static void AddFrame(ezUInt64 uiFrameCount, ezTime startTime);
+  static void AddCounter(ezStringView sName, double fValue, ezProfilingSystem::CounterType type, ezTime time);
+  static void AddMemoryEvent(const ezProfilingSystem::MemoryEvent& memoryEvent);
+  static void AddMutexWait(ezUInt64 uiThreadId, ezTime beginTime, ezTime endTime);
+
+  static ezAtomicBool s_bCapturing;
+};
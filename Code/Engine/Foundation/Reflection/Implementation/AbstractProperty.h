@@ -572,6 +572,25 @@ public:
   /// it is impossible to pass along a nullptr.
   virtual void Execute(void* pInstance, ezArrayPtr<ezVariant> arguments, ezVariant& out_returnValue) const = 0;
 
+  /// \brief Returns whether the function can be called through ExecuteTyped.
+  ///
+  /// This is the case if all arguments are passed by value or const reference and neither the arguments nor the return value are
+  /// pointers, enums or bitflags.
+  virtual bool SupportsTypedExecution() const { return false; }
+
+  /// \brief Calls the function without boxing the arguments and the return value into ezVariant.
+  ///
+  /// Must only be called if SupportsTypedExecution returns true. arguments must be the size of GetArgumentCount and each entry must point
+  /// to an instance of exactly the type returned by GetArgumentType. pReturnValue is either nullptr or points to an instance of
+  /// GetReturnType which is then assigned the return value.
+  virtual void ExecuteTyped(void* pInstance, ezArrayPtr<const void* const> arguments, void* pReturnValue) const
+  {
+    EZ_IGNORE_UNUSED(pInstance);
+    EZ_IGNORE_UNUSED(arguments);
+    EZ_IGNORE_UNUSED(pReturnValue);
+    EZ_ASSERT_NOT_IMPLEMENTED;
+  }
+
   virtual const ezRTTI* GetSpecificType() const override { return GetReturnType(); }
 
   /// \brief Adds flags to the property. Returns itself to allow to be called during initialization.
@@ -46,6 +46,43 @@ public:
   {
     return GetParameterFlagsImpl(uiParamIndex, std::make_index_sequence<sizeof...(Args)>{});
   }
+
+protected:
+  template <typename T>
+  static constexpr bool IsTypedType()
+  {
+    if constexpr (std::is_pointer<typename std::remove_reference<T>::type>::value)
+      return false;
+    else
+      return std::is_same<typename ezCleanType<T>::Type, typename ezCleanType<T>::RttiType>::value;
+  }
+
+  template <typename T>
+  static constexpr bool IsTypedArgument()
+  {
+    // Out parameters can't be passed as const void*.
+    if constexpr (std::is_rvalue_reference<T>::value || (std::is_lvalue_reference<T>::value && !std::is_const<typename std::remove_reference<T>::type>::value))
+      return false;
+    else
+      return IsTypedType<T>();
+  }
+
+  template <typename T>
+  static constexpr bool IsTypedReturnType()
+  {
+    if constexpr (std::is_same<T, void>::value)
+      return true;
+    else
+      return IsTypedType<T>();
+  }
+
+  static constexpr bool s_bSupportsTypedExecution = IsTypedReturnType<R>() && (IsTypedArgument<Args>() && ...);
+
+  template <typename T>
+  static EZ_ALWAYS_INLINE const typename ezCleanType<T>::Type& GetTypedArgument(const void* pArgument)
+  {
+    return *static_cast<const typename ezCleanType<T>::Type*>(pArgument);
+  }
 };
 
 template <typename FUNC>
@@ -91,6 +128,39 @@ public:
     ExecuteImpl(pInstance, out_returnValue, arguments, std::make_index_sequence<sizeof...(Args)>{});
   }
 
+  virtual bool SupportsTypedExecution() const override { return ezTypedFunctionProperty<R, Args...>::s_bSupportsTypedExecution; }
+
+  template <std::size_t... I>
+  EZ_FORCE_INLINE void ExecuteTypedImpl(void* pInstance, ezArrayPtr<const void* const> arguments, void* pReturnValue, std::index_sequence<I...>) const
+  {
+    CLASS* pTargetInstance = static_cast<CLASS*>(pInstance);
+    if constexpr (std::is_same<R, void>::value)
+    {
+      EZ_IGNORE_UNUSED(pReturnValue);
+      (pTargetInstance->*m_Function)(ezTypedFunctionProperty<R, Args...>::template GetTypedArgument<Args>(arguments[I])...);
+    }
+    else if (pReturnValue != nullptr)
+    {
+      *static_cast<typename ezCleanType<R>::Type*>(pReturnValue) = (pTargetInstance->*m_Function)(ezTypedFunctionProperty<R, Args...>::template GetTypedArgument<Args>(arguments[I])...);
+    }
+    else
+    {
+      (pTargetInstance->*m_Function)(ezTypedFunctionProperty<R, Args...>::template GetTypedArgument<Args>(arguments[I])...);
+    }
+  }
+
+  virtual void ExecuteTyped(void* pInstance, ezArrayPtr<const void* const> arguments, void* pReturnValue) const override
+  {
+    if constexpr (ezTypedFunctionProperty<R, Args...>::s_bSupportsTypedExecution)
+    {
+      ExecuteTypedImpl(pInstance, arguments, pReturnValue, std::make_index_sequence<sizeof...(Args)>{});
+    }
+    else
+    {
+      ezAbstractFunctionProperty::ExecuteTyped(pInstance, arguments, pReturnValue);
+    }
+  }
+
 private:
   TargetFunction m_Function;
 };
@@ -134,6 +204,39 @@ public:
     ExecuteImpl(pInstance, out_returnValue, arguments, std::make_index_sequence<sizeof...(Args)>{});
   }
 
+  virtual bool SupportsTypedExecution() const override { return ezTypedFunctionProperty<R, Args...>::s_bSupportsTypedExecution; }
+
+  template <std::size_t... I>
+  EZ_FORCE_INLINE void ExecuteTypedImpl(const void* pInstance, ezArrayPtr<const void* const> arguments, void* pReturnValue, std::index_sequence<I...>) const
+  {
+    const CLASS* pTargetInstance = static_cast<const CLASS*>(pInstance);
+    if constexpr (std::is_same<R, void>::value)
+    {
+      EZ_IGNORE_UNUSED(pReturnValue);
+      (pTargetInstance->*m_Function)(ezTypedFunctionProperty<R, Args...>::template GetTypedArgument<Args>(arguments[I])...);
+    }
+    else if (pReturnValue != nullptr)
+    {
+      *static_cast<typename ezCleanType<R>::Type*>(pReturnValue) = (pTargetInstance->*m_Function)(ezTypedFunctionProperty<R, Args...>::template GetTypedArgument<Args>(arguments[I])...);
+    }
+    else
+    {
+      (pTargetInstance->*m_Function)(ezTypedFunctionProperty<R, Args...>::template GetTypedArgument<Args>(arguments[I])...);
+    }
+  }
+
+  virtual void ExecuteTyped(void* pInstance, ezArrayPtr<const void* const> arguments, void* pReturnValue) const override
+  {
+    if constexpr (ezTypedFunctionProperty<R, Args...>::s_bSupportsTypedExecution)
+    {
+      ExecuteTypedImpl(pInstance, arguments, pReturnValue, std::make_index_sequence<sizeof...(Args)>{});
+    }
+    else
+    {
+      ezAbstractFunctionProperty::ExecuteTyped(pInstance, arguments, pReturnValue);
+    }
+  }
+
 private:
   TargetFunction m_Function;
 };
@@ -172,6 +275,39 @@ public:
     ExecuteImpl(ezTraitInt<std::is_same<R, void>::value>(), out_returnValue, arguments, std::make_index_sequence<sizeof...(Args)>{});
   }
 
+  virtual bool SupportsTypedExecution() const override { return ezTypedFunctionProperty<R, Args...>::s_bSupportsTypedExecution; }
+
+  template <std::size_t... I>
+  EZ_FORCE_INLINE void ExecuteTypedImpl(ezArrayPtr<const void* const> arguments, void* pReturnValue, std::index_sequence<I...>) const
+  {
+    if constexpr (std::is_same<R, void>::value)
+    {
+      EZ_IGNORE_UNUSED(pReturnValue);
+      (*m_Function)(ezTypedFunctionProperty<R, Args...>::template GetTypedArgument<Args>(arguments[I])...);
+    }
+    else if (pReturnValue != nullptr)
+    {
+      *static_cast<typename ezCleanType<R>::Type*>(pReturnValue) = (*m_Function)(ezTypedFunctionProperty<R, Args...>::template GetTypedArgument<Args>(arguments[I])...);
+    }
+    else
+    {
+      (*m_Function)(ezTypedFunctionProperty<R, Args...>::template GetTypedArgument<Args>(arguments[I])...);
+    }
+  }
+
+  virtual void ExecuteTyped(void* pInstance, ezArrayPtr<const void* const> arguments, void* pReturnValue) const override
+  {
+    if constexpr (ezTypedFunctionProperty<R, Args...>::s_bSupportsTypedExecution)
+    {
+      EZ_IGNORE_UNUSED(pInstance);
+      ExecuteTypedImpl(arguments, pReturnValue, std::make_index_sequence<sizeof...(Args)>{});
+    }
+    else
+    {
+      ezAbstractFunctionProperty::ExecuteTyped(pInstance, arguments, pReturnValue);
+    }
+  }
+
 private:
   TargetFunction m_Function;
 };
@@ -6,6 +6,69 @@
 #include <Foundation/Communication/Message.h>
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/Containers/HashTable.h>
+#include <Foundation/Threading/AtomicInteger.h>
+
+/// \brief Immutable snapshot of all registered types, used to look up types by name hash without locking.
+///
+/// A snapshot is never modified after it was published. When types are added or removed, the current snapshot is discarded
+/// and the next lookup builds a new one. While plugins are being loaded or unloaded, lookups go through the locked hash table
+/// instead, so that the snapshot isn't rebuilt for every single type that a plugin registers.
+struct ezTypeLookupTable
+{
+  struct Entry
+  {
+    ezUInt64 m_uiNameHash = 0;
+    const ezRTTI* m_pType = nullptr;
+  };
+
+  // the table is kept at most a quarter full, so that almost all lookups succeed with the first probe
+  static constexpr ezUInt32 s_uiSlotsPerType = 4;
+
+  ezUInt32 m_uiMask = 0;
+  ezUInt32 m_uiMaxProbes = 0;
+  ezDynamicArray<Entry, ezStaticsAllocatorWrapper> m_Entries;
+
+  void Build(ezArrayPtr<ezRTTI* const> types)
+  {
+    const ezUInt32 uiNumSlots = ezMath::PowerOfTwo_Ceil(ezMath::Max(types.GetCount() * s_uiSlotsPerType, 64u));
+
+    m_uiMask = uiNumSlots - 1;
+    m_uiMaxProbes = 0;
+    m_Entries.SetCount(uiNumSlots);
+
+    for (const ezRTTI* pType : types)
+    {
+      for (ezUInt32 uiProbe = 0; uiProbe < uiNumSlots; ++uiProbe)
+      {
+        Entry& entry = m_Entries[(static_cast<ezUInt32>(pType->GetTypeNameHash()) + uiProbe) & m_uiMask];
+
+        if (entry.m_pType == nullptr)
+        {
+          entry.m_uiNameHash = pType->GetTypeNameHash();
+          entry.m_pType = pType;
+          m_uiMaxProbes = ezMath::Max(m_uiMaxProbes, uiProbe + 1);
+          break;
+        }
+      }
+    }
+  }
+
+  const ezRTTI* Find(ezUInt64 uiNameHash) const
+  {
+    for (ezUInt32 uiProbe = 0; uiProbe < m_uiMaxProbes; ++uiProbe)
+    {
+      const Entry& entry = m_Entries[(static_cast<ezUInt32>(uiNameHash) + uiProbe) & m_uiMask];
+
+      if (entry.m_pType == nullptr)
+        return nullptr;
+
+      if (entry.m_uiNameHash == uiNameHash)
+        return entry.m_pType;
+    }
+
+    return nullptr;
+  }
+};
 
 struct ezTypeData
 {
@@ -13,6 +76,19 @@ struct ezTypeData
   ezHashTable<ezUInt64, ezRTTI*, ezHashHelper<ezUInt64>, ezStaticsAllocatorWrapper> m_TypeNameHashToType;
   ezDynamicArray<ezRTTI*> m_AllTypes;
 
+  /// The current ezTypeLookupTable or zero, if types were added or removed since it was built.
+  ezAtomicInteger64 m_iLookupTable;
+
+  /// Discarded snapshots are only freed on shutdown, because other threads may still be reading from them.
+  /// A snapshot is only built on the first lookup after types changed, so there is at most one retired table per batch of type changes.
+  ezDynamicArray<ezTypeLookupTable*, ezStaticsAllocatorWrapper> m_RetiredLookupTables;
+
+  /// The lookup table is only built after startup, to not rebuild it for every type that is registered during static initialization.
+  bool m_bLookupTableEnabled = false;
+
+  /// Set between ezPluginEvent::BeforePluginChanges and ezPluginEvent::AfterPluginChanges, no lookup table is built in between.
+  bool m_bPluginsChanging = false;
+
   bool m_bIterating = false;
 };
 
@@ -31,6 +107,58 @@ ezTypeData* GetTypeData()
   return pData;
 }
 
+namespace
+{
+  EZ_ALWAYS_INLINE const ezTypeLookupTable* GetLookupTable(const ezTypeData* pData)
+  {
+    return reinterpret_cast<const ezTypeLookupTable*>(static_cast<size_t>(pData->m_iLookupTable));
+  }
+
+  /// \brief Discards the current lookup table, the next lookup builds a new one.
+  ///
+  /// Must be called with the type data mutex locked.
+  void InvalidateLookupTable(ezTypeData* pData)
+  {
+    const ezInt64 iOldTable = pData->m_iLookupTable.Set(0);
+
+    if (iOldTable != 0)
+    {
+      pData->m_RetiredLookupTables.PushBack(reinterpret_cast<ezTypeLookupTable*>(static_cast<size_t>(iOldTable)));
+    }
+  }
+
+  /// \brief Builds and publishes a new lookup table, if none exists.
+  ///
+  /// Must be called with the type data mutex locked.
+  void RebuildLookupTable(ezTypeData* pData)
+  {
+    if (!pData->m_bLookupTableEnabled || pData->m_bPluginsChanging || pData->m_iLookupTable != 0)
+      return;
+
+    ezTypeLookupTable* pTable = EZ_NEW(ezFoundation::GetStaticsAllocator(), ezTypeLookupTable);
+    pTable->Build(pData->m_AllTypes);
+
+    // publishing the pointer is a full barrier, so readers never see a partially built table
+    pData->m_iLookupTable.Set(static_cast<ezInt64>(reinterpret_cast<size_t>(pTable)));
+  }
+
+  /// \brief Frees the current and all retired lookup tables. Only safe to call when no other thread can look up types anymore.
+  ///
+  /// Must be called with the type data mutex locked.
+  void FreeLookupTables(ezTypeData* pData)
+  {
+    InvalidateLookupTable(pData);
+
+    for (ezTypeLookupTable* pTable : pData->m_RetiredLookupTables)
+    {
+      EZ_DELETE(ezFoundation::GetStaticsAllocator(), pTable);
+    }
+
+    pData->m_RetiredLookupTables.Clear();
+    pData->m_RetiredLookupTables.Compact();
+  }
+} // namespace
+
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, Reflection)
 
@@ -42,11 +170,21 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, Reflection)
   {
     ezPlugin::Events().AddEventHandler(ezRTTI::PluginEventHandler);
     ezRTTI::AssignPlugin("Static");
+
+    auto pData = GetTypeData();
+    EZ_LOCK(pData->m_Mutex);
+    pData->m_bLookupTableEnabled = true;
+    RebuildLookupTable(pData);
   }
 
   ON_CORESYSTEMS_SHUTDOWN
   {
     ezPlugin::Events().RemoveEventHandler(ezRTTI::PluginEventHandler);
+
+    auto pData = GetTypeData();
+    EZ_LOCK(pData->m_Mutex);
+    pData->m_bLookupTableEnabled = false;
+    FreeLookupTables(pData);
   }
 
 EZ_END_SUBSYSTEM_DECLARATION;
@@ -217,6 +355,7 @@ void ezRTTI::RegisterType()
 
   auto pData = GetTypeData();
   EZ_LOCK(pData->m_Mutex);
+  InvalidateLookupTable(pData);
   pData->m_TypeNameHashToType.Insert(m_uiTypeNameHash, this);
 
   m_uiTypeIndex = pData->m_AllTypes.GetCount();
@@ -227,6 +366,7 @@ void ezRTTI::UnregisterType()
 {
   auto pData = GetTypeData();
   EZ_LOCK(pData->m_Mutex);
+  InvalidateLookupTable(pData);
   pData->m_TypeNameHashToType.Remove(m_uiTypeNameHash);
 
   EZ_ASSERT_DEV(pData->m_bIterating == false, "Unregistering types while iterating over types might cause unexpected behavior");
@@ -249,20 +389,21 @@ void ezRTTI::GetAllProperties(ezDynamicArray<const ezAbstractProperty*>& out_pro
 
 const ezRTTI* ezRTTI::FindTypeByName(ezStringView sName)
 {
-  ezUInt64 uiNameHash = ezHashingUtils::StringHash(sName);
-
-  auto pData = GetTypeData();
-  EZ_LOCK(pData->m_Mutex);
-
-  ezRTTI* pType = nullptr;
-  pData->m_TypeNameHashToType.TryGetValue(uiNameHash, pType);
-  return pType;
+  return FindTypeByNameHash(ezHashingUtils::StringHash(sName));
 }
 
 const ezRTTI* ezRTTI::FindTypeByNameHash(ezUInt64 uiNameHash)
 {
   auto pData = GetTypeData();
+
+  if (const ezTypeLookupTable* pTable = GetLookupTable(pData))
+  {
+    return pTable->Find(uiNameHash);
+  }
+
+  // types were registered or unregistered since the last lookup (e.g. phantom types), build a new table for the following lookups
   EZ_LOCK(pData->m_Mutex);
+  RebuildLookupTable(pData);
 
   ezRTTI* pType = nullptr;
   pData->m_TypeNameHashToType.TryGetValue(uiNameHash, pType);
@@ -544,6 +685,25 @@ void ezRTTI::PluginEventHandler(const ezPluginEvent& EventData)
     }
     break;
 
+    case ezPluginEvent::BeforePluginChanges:
+    {
+      // plugins register and unregister their types while they are loaded and unloaded,
+      // don't rebuild the lookup table for every single one of them
+      auto pData = GetTypeData();
+      EZ_LOCK(pData->m_Mutex);
+      pData->m_bPluginsChanging = true;
+    }
+    break;
+
+    case ezPluginEvent::AfterPluginChanges:
+    {
+      auto pData = GetTypeData();
+      EZ_LOCK(pData->m_Mutex);
+      pData->m_bPluginsChanging = false;
+      RebuildLookupTable(pData);
+    }
+    break;
+
     default:
       break;
   }
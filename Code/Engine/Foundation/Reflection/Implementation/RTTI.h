@@ -99,9 +99,13 @@ public:
   EZ_ALWAYS_INLINE const ezBitflags<ezTypeFlags>& GetTypeFlags() const { return m_TypeFlags; } // [tested]
 
   /// \brief Searches all ezRTTI instances for the one with the given name, or nullptr if no such type exists.
+  ///
+  /// Lookups don't lock, except for the first lookup after types were registered or unregistered and while plugins are being loaded or unloaded.
   static const ezRTTI* FindTypeByName(ezStringView sName); // [tested]
 
   /// \brief Searches all ezRTTI instances for the one with the given hashed name, or nullptr if no such type exists.
+  ///
+  /// Lookups don't lock, except for the first lookup after types were registered or unregistered and while plugins are being loaded or unloaded.
   static const ezRTTI* FindTypeByNameHash(ezUInt64 uiNameHash); // [tested]
   static const ezRTTI* FindTypeByNameHash32(ezUInt32 uiNameHash);
 
@@ -0,0 +1,288 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Configuration/Plugin.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Reflection/ReflectionUtils.h>
+#include <Foundation/Serialization/ReflectionLayout.h>
+
+namespace
+{
+  struct ezReflectionLayoutCache
+  {
+    ezMutex m_Mutex;
+    ezHashTable<const ezRTTI*, ezReflectionLayout*, ezHashHelper<const ezRTTI*>, ezStaticsAllocatorWrapper> m_Layouts;
+  };
+
+  ezReflectionLayoutCache& GetLayoutCache()
+  {
+    static ezReflectionLayoutCache s_Cache;
+    return s_Cache;
+  }
+
+  void PluginEventHandler(const ezPluginEvent& e)
+  {
+    // types of unloaded plugins are gone and new types may be allocated at the same address
+    if (e.m_EventType == ezPluginEvent::AfterUnloading)
+    {
+      ezReflectionLayout::ClearCache();
+    }
+  }
+
+  /// \brief Returns true for types that are trivially copyable and have the same size on all platforms.
+  bool IsPlainDataType(ezVariantType::Enum type)
+  {
+    switch (type)
+    {
+      case ezVariantType::Bool:
+      case ezVariantType::Int8:
+      case ezVariantType::UInt8:
+      case ezVariantType::Int16:
+      case ezVariantType::UInt16:
+      case ezVariantType::Int32:
+      case ezVariantType::UInt32:
+      case ezVariantType::Int64:
+      case ezVariantType::UInt64:
+      case ezVariantType::Float:
+      case ezVariantType::Double:
+      case ezVariantType::Color:
+      case ezVariantType::Vector2:
+      case ezVariantType::Vector3:
+      case ezVariantType::Vector4:
+      case ezVariantType::Vector2I:
+      case ezVariantType::Vector3I:
+      case ezVariantType::Vector4I:
+      case ezVariantType::Vector2U:
+      case ezVariantType::Vector3U:
+      case ezVariantType::Vector4U:
+      case ezVariantType::Quaternion:
+      case ezVariantType::Matrix3:
+      case ezVariantType::Matrix4:
+      case ezVariantType::Transform:
+      case ezVariantType::Time:
+      case ezVariantType::Uuid:
+      case ezVariantType::Angle:
+      case ezVariantType::ColorGamma:
+        return true;
+
+      default:
+        return false;
+    }
+  }
+} // namespace
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ReflectionLayout)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "Reflection"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_STARTUP
+  {
+    ezPlugin::Events().AddEventHandler(PluginEventHandler);
+  }
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezPlugin::Events().RemoveEventHandler(PluginEventHandler);
+    ezReflectionLayout::ClearCache();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+ezReflectionLayout::ezReflectionLayout() = default;
+ezReflectionLayout::~ezReflectionLayout() = default;
+
+const ezReflectionLayout* ezReflectionLayout::GetLayout(const ezRTTI* pType, const void* pInstance)
+{
+  auto& cache = GetLayoutCache();
+  EZ_LOCK(cache.m_Mutex);
+
+  ezReflectionLayout* pLayout = nullptr;
+  if (!cache.m_Layouts.TryGetValue(pType, pLayout))
+  {
+    // the mutex is recursive, nested types are added to the cache while the outer type is built
+    pLayout = BuildLayout(pType, pInstance);
+    cache.m_Layouts.Insert(pType, pLayout);
+  }
+
+  return pLayout;
+}
+
+void ezReflectionLayout::ClearCache()
+{
+  auto& cache = GetLayoutCache();
+  EZ_LOCK(cache.m_Mutex);
+
+  for (auto it : cache.m_Layouts)
+  {
+    EZ_DEFAULT_DELETE(it.Value());
+  }
+
+  cache.m_Layouts.Clear();
+  cache.m_Layouts.Compact();
+}
+
+ezArrayPtr<const ezUInt32> ezReflectionLayout::GetFieldMapping(ezUInt64 uiStoredSchemaHash, ezArrayPtr<const ezStringView> storedFieldNames) const
+{
+  EZ_LOCK(m_FieldMappingMutex);
+
+  bool bExisted = false;
+  auto it = m_FieldMappings.FindOrAdd(uiStoredSchemaHash, &bExisted);
+
+  if (!bExisted)
+  {
+    ezDynamicArray<ezUInt32>& mapping = it.Value();
+    mapping.SetCount(storedFieldNames.GetCount(), ezInvalidIndex);
+
+    for (ezUInt32 uiStored = 0; uiStored < storedFieldNames.GetCount(); ++uiStored)
+    {
+      for (ezUInt32 uiField = 0; uiField < m_Fields.GetCount(); ++uiField)
+      {
+        if (m_Fields[uiField].m_pProperty->GetPropertyName() == storedFieldNames[uiStored])
+        {
+          mapping[uiStored] = uiField;
+          break;
+        }
+      }
+    }
+  }
+
+  // ezMap nodes never move, so the array stays valid after the lock is released
+  return it.Value();
+}
+
+ezReflectionLayout* ezReflectionLayout::BuildLayout(const ezRTTI* pType, const void* pInstance)
+{
+  ezReflectionLayout* pLayout = EZ_DEFAULT_NEW(ezReflectionLayout);
+  pLayout->m_pType = pType;
+  pLayout->AddFields(pType, pInstance);
+  pLayout->Finalize();
+  return pLayout;
+}
+
+void ezReflectionLayout::AddFields(const ezRTTI* pType, const void* pInstance)
+{
+  if (pType->GetParentType() != nullptr)
+  {
+    AddFields(pType->GetParentType(), pInstance);
+  }
+
+  const ezUInt8* pInstanceData = static_cast<const ezUInt8*>(pInstance);
+
+  for (const ezAbstractProperty* pProp : pType->GetProperties())
+  {
+    const ezBitflags<ezPropertyFlags> flags = pProp->GetFlags();
+
+    // read-only properties can neither be cloned nor restored
+    if (flags.IsSet(ezPropertyFlags::ReadOnly))
+      continue;
+
+    Field field;
+    field.m_pProperty = pProp;
+
+    const ezRTTI* pPropType = pProp->GetSpecificType();
+    const bool bIsValueType = ezReflectionUtils::IsValueType(pProp);
+
+    switch (pProp->GetCategory())
+    {
+      case ezPropertyCategory::Member:
+      {
+        if (flags.IsSet(ezPropertyFlags::Pointer))
+          break;
+
+        const ezUInt8* pMember = static_cast<const ezUInt8*>(static_cast<const ezAbstractMemberProperty*>(pProp)->GetPropertyPointer(pInstance));
+        const ezVariantType::Enum variantType = pPropType->GetVariantType();
+
+        if (pMember != nullptr && flags.IsSet(ezPropertyFlags::StandardType) && IsPlainDataType(variantType))
+        {
+          field.m_Type = FieldType::PlainData;
+          field.m_uiOffset = static_cast<ezUInt32>(pMember - pInstanceData);
+          field.m_uiSize = pPropType->GetTypeSize();
+          field.m_uiVariantType = static_cast<ezUInt8>(variantType);
+        }
+        else if (bIsValueType || flags.IsAnySet(ezPropertyFlags::IsEnum | ezPropertyFlags::Bitflags))
+        {
+          field.m_Type = FieldType::Value;
+        }
+        else if (pMember != nullptr && flags.IsSet(ezPropertyFlags::Class))
+        {
+          field.m_Type = FieldType::Nested;
+          field.m_uiOffset = static_cast<ezUInt32>(pMember - pInstanceData);
+          field.m_pNestedLayout = GetLayout(pPropType, pMember);
+        }
+      }
+      break;
+
+      case ezPropertyCategory::Array:
+      {
+        if (bIsValueType)
+        {
+          field.m_Type = FieldType::ValueArray;
+        }
+      }
+      break;
+
+      case ezPropertyCategory::Set:
+      case ezPropertyCategory::Map:
+        break;
+
+      default:
+        // constants and functions don't hold any data
+        continue;
+    }
+
+    m_Fields.PushBack(field);
+  }
+}
+
+void ezReflectionLayout::Finalize()
+{
+  const ezUInt32 uiTypeVersion = m_pType->GetTypeVersion();
+  m_uiSchemaHash = ezHashingUtils::xxHash64String(m_pType->GetTypeName());
+  m_uiSchemaHash = ezHashingUtils::xxHash64(&uiTypeVersion, sizeof(uiTypeVersion), m_uiSchemaHash);
+  m_bCanSerialize = true;
+
+  for (ezUInt32 i = 0; i < m_Fields.GetCount(); ++i)
+  {
+    const Field& field = m_Fields[i];
+
+    const ezUInt64 uiFieldDesc = static_cast<ezUInt64>(field.m_Type) | (static_cast<ezUInt64>(field.m_uiVariantType) << 8) | (static_cast<ezUInt64>(field.m_uiSize) << 16);
+    m_uiSchemaHash = ezHashingUtils::xxHash64String(field.m_pProperty->GetPropertyName(), m_uiSchemaHash);
+    m_uiSchemaHash = ezHashingUtils::xxHash64(&uiFieldDesc, sizeof(uiFieldDesc), m_uiSchemaHash);
+
+    if (field.m_Type == FieldType::Other || (field.m_Type == FieldType::Nested && !field.m_pNestedLayout->CanSerialize()))
+    {
+      m_bCanSerialize = false;
+    }
+
+    if (field.m_Type == FieldType::Nested)
+    {
+      m_uiSchemaHash = ezHashingUtils::xxHash64String(field.m_pNestedLayout->GetType()->GetTypeName(), m_uiSchemaHash);
+    }
+
+    // merge plain data members that directly follow each other in memory into a single copy operation
+    if (field.m_Type == FieldType::PlainData && !m_Operations.IsEmpty())
+    {
+      Operation& prevOp = m_Operations.PeekBack();
+
+      if (prevOp.m_Type == FieldType::PlainData && prevOp.m_uiOffset + prevOp.m_uiSize == field.m_uiOffset)
+      {
+        prevOp.m_uiNumFields++;
+        prevOp.m_uiSize += field.m_uiSize;
+        continue;
+      }
+    }
+
+    Operation& op = m_Operations.ExpandAndGetRef();
+    op.m_Type = field.m_Type;
+    op.m_uiFirstField = i;
+    op.m_uiNumFields = 1;
+    op.m_uiOffset = field.m_uiOffset;
+    op.m_uiSize = field.m_uiSize;
+  }
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Serialization_Implementation_ReflectionLayout);
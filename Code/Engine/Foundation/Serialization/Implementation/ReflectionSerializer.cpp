@@ -5,11 +5,541 @@
 #include <Foundation/Reflection/ReflectionUtils.h>
 #include <Foundation/Serialization/BinarySerializer.h>
 #include <Foundation/Serialization/DdlSerializer.h>
+#include <Foundation/Serialization/GraphVersioning.h>
+#include <Foundation/Serialization/ReflectionLayout.h>
 #include <Foundation/Serialization/ReflectionSerializer.h>
 #include <Foundation/Serialization/RttiConverter.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Types/VariantTypeRegistry.h>
 
+////////////////////////////////////////////////////////////////////////
+// Compiled binary format
+////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  // Binary data written by the ezAbstractGraphBinarySerializer starts with its version number instead.
+  constexpr char s_CompiledBinaryTag[4] = {'E', 'Z', 'R', 'L'};
+  constexpr ezUInt8 s_uiCompiledBinaryVersion = 2;
+
+  // Plain data is copied straight from memory, so data written on a platform with a different byte order or pointer size can't be read.
+  constexpr ezUInt8 s_uiCompiledBinaryPlatform = (EZ_ENABLED(EZ_PLATFORM_BIG_ENDIAN) ? 0x80 : 0x00) | static_cast<ezUInt8>(sizeof(void*));
+
+  using FieldType = ezReflectionLayout::FieldType;
+
+  /// \brief Replays the bytes that were read to detect the format, before continuing with the actual stream.
+  class ezPrefixedStreamReader : public ezStreamReader
+  {
+  public:
+    ezPrefixedStreamReader(ezStreamReader& ref_stream, ezArrayPtr<const ezUInt8> prefix)
+      : m_pStream(&ref_stream)
+      , m_Prefix(prefix)
+    {
+    }
+
+    virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+    {
+      ezUInt8* pOutput = static_cast<ezUInt8*>(pReadBuffer);
+      ezUInt64 uiBytesRead = 0;
+
+      while (m_uiPrefixPos < m_Prefix.GetCount() && uiBytesRead < uiBytesToRead)
+      {
+        pOutput[uiBytesRead++] = m_Prefix[m_uiPrefixPos++];
+      }
+
+      if (uiBytesRead < uiBytesToRead)
+      {
+        uiBytesRead += m_pStream->ReadBytes(pOutput + uiBytesRead, uiBytesToRead - uiBytesRead);
+      }
+
+      return uiBytesRead;
+    }
+
+  private:
+    ezStreamReader* m_pStream = nullptr;
+    ezArrayPtr<const ezUInt8> m_Prefix;
+    ezUInt32 m_uiPrefixPos = 0;
+  };
+
+  struct PlainDataToVariantFunc
+  {
+    template <typename T>
+    EZ_ALWAYS_INLINE void operator()()
+    {
+      if constexpr (std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value)
+      {
+        if (m_Data.GetCount() == sizeof(T))
+        {
+          T value;
+          ezMemoryUtils::RawByteCopy(&value, m_Data.GetPtr(), sizeof(T));
+          m_Result = value;
+        }
+      }
+    }
+
+    ezArrayPtr<const ezUInt8> m_Data;
+    ezVariant m_Result;
+  };
+
+  void CollectLayouts(const ezReflectionLayout* pLayout, ezDynamicArray<const ezReflectionLayout*>& inout_layouts)
+  {
+    if (inout_layouts.Contains(pLayout))
+      return;
+
+    inout_layouts.PushBack(pLayout);
+
+    for (const auto& field : pLayout->GetFields())
+    {
+      if (field.m_Type == FieldType::Nested)
+      {
+        CollectLayouts(field.m_pNestedLayout, inout_layouts);
+      }
+    }
+  }
+
+  void WriteObjectData(ezStreamWriter& inout_stream, const ezReflectionLayout* pLayout, const void* pObject)
+  {
+    const ezUInt8* pData = static_cast<const ezUInt8*>(pObject);
+
+    for (const auto& op : pLayout->GetOperations())
+    {
+      const ezReflectionLayout::Field& field = pLayout->GetFields()[op.m_uiFirstField];
+
+      switch (op.m_Type)
+      {
+        case FieldType::PlainData:
+          inout_stream.WriteBytes(pData + op.m_uiOffset, op.m_uiSize).AssertSuccess();
+          break;
+
+        case FieldType::Nested:
+          WriteObjectData(inout_stream, field.m_pNestedLayout, pData + field.m_uiOffset);
+          break;
+
+        case FieldType::Value:
+          inout_stream << ezReflectionUtils::GetMemberPropertyValue(static_cast<const ezAbstractMemberProperty*>(field.m_pProperty), pObject);
+          break;
+
+        case FieldType::ValueArray:
+        {
+          auto pArrayProp = static_cast<const ezAbstractArrayProperty*>(field.m_pProperty);
+          const ezUInt32 uiCount = pArrayProp->GetCount(pObject);
+          inout_stream << uiCount;
+
+          for (ezUInt32 i = 0; i < uiCount; ++i)
+          {
+            inout_stream << ezReflectionUtils::GetArrayPropertyValue(pArrayProp, pObject, i);
+          }
+        }
+        break;
+
+        default:
+          EZ_ASSERT_NOT_IMPLEMENTED;
+          break;
+      }
+    }
+  }
+
+  /// \brief Writes the schema of all involved types, followed by the object data in the order of the layout operations.
+  void WriteCompiledBinary(ezStreamWriter& inout_stream, const ezReflectionLayout* pLayout, const void* pObject)
+  {
+    ezHybridArray<const ezReflectionLayout*, 16> layouts;
+    CollectLayouts(pLayout, layouts);
+
+    inout_stream.WriteBytes(s_CompiledBinaryTag, sizeof(s_CompiledBinaryTag)).AssertSuccess();
+    inout_stream << s_uiCompiledBinaryVersion;
+    inout_stream << s_uiCompiledBinaryPlatform;
+
+    inout_stream << layouts.GetCount();
+    for (const ezReflectionLayout* pTypeLayout : layouts)
+    {
+      inout_stream << pTypeLayout->GetType()->GetTypeName();
+      inout_stream << pTypeLayout->GetType()->GetTypeVersion();
+      inout_stream << pTypeLayout->GetSchemaHash();
+      inout_stream << pTypeLayout->GetFields().GetCount();
+
+      for (const auto& field : pTypeLayout->GetFields())
+      {
+        inout_stream << field.m_pProperty->GetPropertyName();
+        inout_stream << static_cast<ezUInt8>(field.m_Type);
+        inout_stream << field.m_uiVariantType;
+        inout_stream << field.m_uiSize;
+        inout_stream << (field.m_Type == FieldType::Nested ? layouts.IndexOf(field.m_pNestedLayout) : ezInvalidIndex);
+      }
+    }
+
+    WriteObjectData(inout_stream, pLayout, pObject);
+  }
+
+  /// \brief Reads data written by WriteCompiledBinary.
+  ///
+  /// If the stored schema of a type matches the current layout, the data is read straight into the object.
+  /// Otherwise the stored fields are matched by name and converted where necessary, unknown fields are skipped.
+  /// Data that was written with a different version of any of its types can't be read directly, since graph patches may need
+  /// to be applied. ReadGraph() converts it to an object graph for the regular versioning path instead.
+  class ezCompiledBinaryReader
+  {
+  public:
+    ezCompiledBinaryReader(ezStreamReader& ref_stream)
+      : m_Stream(ref_stream)
+    {
+    }
+
+    /// \brief Reads the schema. Expects that the format tag was already read.
+    ezResult ReadSchema()
+    {
+      ezUInt8 uiVersion = 0;
+      m_Stream >> uiVersion;
+
+      if (uiVersion != s_uiCompiledBinaryVersion)
+      {
+        ezLog::Error("Unsupported reflection binary format version {0}.", uiVersion);
+        return EZ_FAILURE;
+      }
+
+      ezUInt8 uiPlatform = 0;
+      m_Stream >> uiPlatform;
+
+      if (uiPlatform != s_uiCompiledBinaryPlatform)
+      {
+        ezLog::Error("Reflection binary data was written on a platform with a different memory layout.");
+        return EZ_FAILURE;
+      }
+
+      ezUInt32 uiNumTypes = 0;
+      m_Stream >> uiNumTypes;
+      m_Types.SetCount(uiNumTypes);
+
+      for (StoredType& type : m_Types)
+      {
+        ezUInt32 uiNumFields = 0;
+        m_Stream >> type.m_sTypeName;
+        m_Stream >> type.m_uiTypeVersion;
+        m_Stream >> type.m_uiSchemaHash;
+        m_Stream >> uiNumFields;
+
+        type.m_pType = ezRTTI::FindTypeByName(type.m_sTypeName);
+        type.m_Fields.SetCount(uiNumFields);
+
+        if (type.m_pType != nullptr && type.m_pType->GetTypeVersion() != type.m_uiTypeVersion)
+        {
+          m_bNeedsPatching = true;
+        }
+        type.m_FieldNames.SetCount(uiNumFields);
+
+        for (ezUInt32 i = 0; i < uiNumFields; ++i)
+        {
+          StoredField& field = type.m_Fields[i];
+
+          ezUInt8 uiFieldType = 0;
+          m_Stream >> field.m_sName;
+          m_Stream >> uiFieldType;
+          m_Stream >> field.m_uiVariantType;
+          m_Stream >> field.m_uiSize;
+          m_Stream >> field.m_uiNestedType;
+
+          field.m_Type = static_cast<FieldType>(uiFieldType);
+          type.m_FieldNames[i] = field.m_sName;
+
+          if (uiFieldType >= static_cast<ezUInt8>(FieldType::Other) || (field.m_Type == FieldType::Nested && field.m_uiNestedType >= uiNumTypes))
+          {
+            ezLog::Error("Reflection binary data is corrupt.");
+            return EZ_FAILURE;
+          }
+        }
+      }
+
+      if (m_Types.IsEmpty())
+      {
+        ezLog::Error("Reflection binary data is corrupt.");
+        return EZ_FAILURE;
+      }
+
+      return EZ_SUCCESS;
+    }
+
+    /// \brief The type of the root object, or nullptr if it doesn't exist (anymore).
+    const ezRTTI* GetRootType() const { return m_Types[0].m_pType; }
+    ezStringView GetRootTypeName() const { return m_Types[0].m_sTypeName; }
+
+    /// \brief Whether any type was stored with a different version than the current one. The data has to be read with ReadGraph() then.
+    bool NeedsPatching() const { return m_bNeedsPatching; }
+
+    void ReadRootObject(const ezRTTI* pType, void* pObject)
+    {
+      EZ_ASSERT_DEBUG(!m_bNeedsPatching, "Data of outdated types has to be read with ReadGraph()");
+      ReadObject(0, pObject, ezReflectionLayout::GetLayout(pType, pObject));
+    }
+
+    /// \brief Converts the data to an object graph with a root node called "root" and applies all graph patches.
+    void ReadGraph(ezAbstractObjectGraph& ref_graph)
+    {
+      AddObjectToGraph(ref_graph, 0, "root");
+      ezGraphVersioning::GetSingleton()->PatchGraph(&ref_graph);
+    }
+
+  private:
+    struct StoredField
+    {
+      ezString m_sName;
+      FieldType m_Type = FieldType::Other;
+      ezUInt8 m_uiVariantType = 0;
+      ezUInt32 m_uiSize = 0;
+      ezUInt32 m_uiNestedType = ezInvalidIndex;
+    };
+
+    struct StoredType
+    {
+      ezString m_sTypeName;
+      ezUInt32 m_uiTypeVersion = 0;
+      ezUInt64 m_uiSchemaHash = 0;
+      const ezRTTI* m_pType = nullptr;
+      ezDynamicArray<StoredField> m_Fields;
+      ezDynamicArray<ezStringView> m_FieldNames;
+    };
+
+    /// \brief Reads the data of one object of the given stored type as a node of the graph. Nested objects become nodes of their own.
+    ezUuid AddObjectToGraph(ezAbstractObjectGraph& ref_graph, ezUInt32 uiStoredType, ezStringView sNodeName)
+    {
+      const StoredType& stored = m_Types[uiStoredType];
+
+      const ezUuid guid = ezUuid::MakeUuid();
+      ezAbstractObjectNode* pNode = ref_graph.AddNode(guid, stored.m_sTypeName, stored.m_uiTypeVersion, sNodeName);
+
+      for (const StoredField& storedField : stored.m_Fields)
+      {
+        switch (storedField.m_Type)
+        {
+          case FieldType::PlainData:
+          {
+            ezHybridArray<ezUInt8, 64> data;
+            data.SetCountUninitialized(storedField.m_uiSize);
+            m_Stream.ReadBytes(data.GetData(), storedField.m_uiSize);
+
+            PlainDataToVariantFunc func;
+            func.m_Data = data;
+            ezVariant::DispatchTo(func, static_cast<ezVariantType::Enum>(storedField.m_uiVariantType));
+
+            if (func.m_Result.IsValid())
+            {
+              pNode->AddProperty(storedField.m_sName, func.m_Result);
+            }
+          }
+          break;
+
+          case FieldType::Value:
+          {
+            ezVariant value;
+            m_Stream >> value;
+            pNode->AddProperty(storedField.m_sName, value);
+          }
+          break;
+
+          case FieldType::ValueArray:
+          {
+            ezUInt32 uiCount = 0;
+            m_Stream >> uiCount;
+
+            ezVariantArray values;
+            values.SetCount(uiCount);
+            for (ezVariant& value : values)
+            {
+              m_Stream >> value;
+            }
+
+            pNode->AddProperty(storedField.m_sName, values);
+          }
+          break;
+
+          case FieldType::Nested:
+            pNode->AddProperty(storedField.m_sName, AddObjectToGraph(ref_graph, storedField.m_uiNestedType, {}));
+            break;
+
+          default:
+            break;
+        }
+      }
+
+      return guid;
+    }
+
+    /// \brief Reads the data of one object of the given stored type. If pObject is nullptr, the data is skipped.
+    void ReadObject(ezUInt32 uiStoredType, void* pObject, const ezReflectionLayout* pLayout)
+    {
+      const StoredType& stored = m_Types[uiStoredType];
+
+      // the schema hash includes the type version, so the data has exactly the current layout
+      if (pLayout != nullptr && stored.m_pType == pLayout->GetType() && stored.m_uiSchemaHash == pLayout->GetSchemaHash())
+      {
+        ReadObjectWithLayout(stored, pObject, pLayout);
+        return;
+      }
+
+      ezArrayPtr<const ezUInt32> mapping;
+      if (pLayout != nullptr)
+      {
+        mapping = pLayout->GetFieldMapping(stored.m_uiSchemaHash, stored.m_FieldNames);
+      }
+
+      ezUInt8* pData = static_cast<ezUInt8*>(pObject);
+
+      for (ezUInt32 i = 0; i < stored.m_Fields.GetCount(); ++i)
+      {
+        const StoredField& storedField = stored.m_Fields[i];
+        const ezReflectionLayout::Field* pTarget = nullptr;
+
+        if (!mapping.IsEmpty() && mapping[i] != ezInvalidIndex)
+        {
+          pTarget = &pLayout->GetFields()[mapping[i]];
+        }
+
+        const bool bTargetIsMember = pTarget != nullptr && (pTarget->m_Type == FieldType::PlainData || pTarget->m_Type == FieldType::Value);
+
+        switch (storedField.m_Type)
+        {
+          case FieldType::PlainData:
+          {
+            ezHybridArray<ezUInt8, 64> data;
+            data.SetCountUninitialized(storedField.m_uiSize);
+            m_Stream.ReadBytes(data.GetData(), storedField.m_uiSize);
+
+            if (pTarget != nullptr && pTarget->m_Type == FieldType::PlainData && pTarget->m_uiVariantType == storedField.m_uiVariantType && pTarget->m_uiSize == storedField.m_uiSize)
+            {
+              ezMemoryUtils::RawByteCopy(pData + pTarget->m_uiOffset, data.GetData(), data.GetCount());
+            }
+            else if (bTargetIsMember)
+            {
+              PlainDataToVariantFunc func;
+              func.m_Data = data;
+              ezVariant::DispatchTo(func, static_cast<ezVariantType::Enum>(storedField.m_uiVariantType));
+
+              if (func.m_Result.IsValid())
+              {
+                ezReflectionUtils::SetMemberPropertyValue(static_cast<const ezAbstractMemberProperty*>(pTarget->m_pProperty), pObject, func.m_Result);
+              }
+            }
+          }
+          break;
+
+          case FieldType::Value:
+          {
+            ezVariant value;
+            m_Stream >> value;
+
+            if (bTargetIsMember)
+            {
+              ezReflectionUtils::SetMemberPropertyValue(static_cast<const ezAbstractMemberProperty*>(pTarget->m_pProperty), pObject, value);
+            }
+          }
+          break;
+
+          case FieldType::ValueArray:
+          {
+            ezUInt32 uiCount = 0;
+            m_Stream >> uiCount;
+
+            ezHybridArray<ezVariant, 16> values;
+            values.SetCount(uiCount);
+            for (ezVariant& value : values)
+            {
+              m_Stream >> value;
+            }
+
+            if (pTarget != nullptr && pTarget->m_Type == FieldType::ValueArray)
+            {
+              auto pArrayProp = static_cast<const ezAbstractArrayProperty*>(pTarget->m_pProperty);
+              pArrayProp->SetCount(pObject, uiCount);
+
+              for (ezUInt32 j = 0; j < uiCount; ++j)
+              {
+                ezReflectionUtils::SetArrayPropertyValue(pArrayProp, pObject, j, values[j]);
+              }
+            }
+          }
+          break;
+
+          case FieldType::Nested:
+          {
+            if (pTarget != nullptr && pTarget->m_Type == FieldType::Nested && pTarget->m_pNestedLayout->GetType() == m_Types[storedField.m_uiNestedType].m_pType)
+            {
+              ReadObject(storedField.m_uiNestedType, pData + pTarget->m_uiOffset, pTarget->m_pNestedLayout);
+            }
+            else
+            {
+              ReadObject(storedField.m_uiNestedType, nullptr, nullptr);
+            }
+          }
+          break;
+
+          default:
+            break;
+        }
+      }
+    }
+
+    /// \brief Fast path for data that was written with exactly the given layout.
+    void ReadObjectWithLayout(const StoredType& stored, void* pObject, const ezReflectionLayout* pLayout)
+    {
+      ezUInt8* pData = static_cast<ezUInt8*>(pObject);
+
+      for (const auto& op : pLayout->GetOperations())
+      {
+        const ezReflectionLayout::Field& field = pLayout->GetFields()[op.m_uiFirstField];
+
+        switch (op.m_Type)
+        {
+          case FieldType::PlainData:
+            m_Stream.ReadBytes(pData + op.m_uiOffset, op.m_uiSize);
+            break;
+
+          case FieldType::Nested:
+            ReadObject(stored.m_Fields[op.m_uiFirstField].m_uiNestedType, pData + field.m_uiOffset, field.m_pNestedLayout);
+            break;
+
+          case FieldType::Value:
+          {
+            ezVariant value;
+            m_Stream >> value;
+            ezReflectionUtils::SetMemberPropertyValue(static_cast<const ezAbstractMemberProperty*>(field.m_pProperty), pObject, value);
+          }
+          break;
+
+          case FieldType::ValueArray:
+          {
+            auto pArrayProp = static_cast<const ezAbstractArrayProperty*>(field.m_pProperty);
+
+            ezUInt32 uiCount = 0;
+            m_Stream >> uiCount;
+            pArrayProp->SetCount(pObject, uiCount);
+
+            ezVariant value;
+            for (ezUInt32 i = 0; i < uiCount; ++i)
+            {
+              m_Stream >> value;
+              ezReflectionUtils::SetArrayPropertyValue(pArrayProp, pObject, i, value);
+            }
+          }
+          break;
+
+          default:
+            EZ_ASSERT_NOT_IMPLEMENTED;
+            break;
+        }
+      }
+    }
+
+    ezStreamReader& m_Stream;
+    ezHybridArray<StoredType, 8> m_Types;
+    bool m_bNeedsPatching = false;
+  };
+
+  /// \brief Reads the format tag. Returns true for the compiled binary format, otherwise \a out_prefix contains the bytes that were read.
+  bool IsCompiledBinary(ezStreamReader& inout_stream, ezUInt8 (&out_prefix)[4], ezUInt32& out_uiPrefixSize)
+  {
+    out_uiPrefixSize = static_cast<ezUInt32>(inout_stream.ReadBytes(out_prefix, sizeof(out_prefix)));
+    return out_uiPrefixSize == sizeof(s_CompiledBinaryTag) && ezMemoryUtils::RawByteCompare(out_prefix, s_CompiledBinaryTag, sizeof(s_CompiledBinaryTag)) == 0;
+  }
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////
 // ezReflectionSerializer public static functions
 ////////////////////////////////////////////////////////////////////////
@@ -43,8 +573,19 @@ void ezReflectionSerializer::WriteObjectToDDL(ezOpenDdlWriter& ref_ddl, const ez
   ezAbstractGraphDdlSerializer::Write(ref_ddl, &graph, nullptr);
 }
 
-void ezReflectionSerializer::WriteObjectToBinary(ezStreamWriter& inout_stream, const ezRTTI* pRtti, const void* pObject)
+void ezReflectionSerializer::WriteObjectToBinary(ezStreamWriter& inout_stream, const ezRTTI* pRtti, const void* pObject, BinaryFormat format /*= BinaryFormat::Portable*/)
 {
+  if (format == BinaryFormat::Compiled && pObject != nullptr)
+  {
+    const ezReflectionLayout* pLayout = ezReflectionLayout::GetLayout(pRtti, pObject);
+
+    if (pLayout->CanSerialize())
+    {
+      WriteCompiledBinary(inout_stream, pLayout, pObject);
+      return;
+    }
+  }
+
   ezAbstractObjectGraph graph;
   ezRttiConverterContext context;
   ezRttiConverterWriter conv(&graph, &context, false, true);
@@ -90,10 +631,45 @@ void* ezReflectionSerializer::ReadObjectFromDDL(const ezOpenDdlReaderElement* pR
 
 void* ezReflectionSerializer::ReadObjectFromBinary(ezStreamReader& inout_stream, const ezRTTI*& ref_pRtti)
 {
+  ezUInt8 prefix[4];
+  ezUInt32 uiPrefixSize = 0;
+
   ezAbstractObjectGraph graph;
-  ezRttiConverterContext context;
 
-  ezAbstractGraphBinarySerializer::Read(inout_stream, &graph);
+  if (IsCompiledBinary(inout_stream, prefix, uiPrefixSize))
+  {
+    ezCompiledBinaryReader reader(inout_stream);
+    ref_pRtti = nullptr;
+
+    if (reader.ReadSchema().Failed())
+      return nullptr;
+
+    if (reader.NeedsPatching())
+    {
+      reader.ReadGraph(graph);
+    }
+    else
+    {
+      ref_pRtti = reader.GetRootType();
+
+      if (ref_pRtti == nullptr || !ref_pRtti->GetAllocator()->CanAllocate())
+      {
+        ezLog::Error("Can't create an object of type '{0}'.", reader.GetRootTypeName());
+        return nullptr;
+      }
+
+      void* pTarget = ref_pRtti->GetAllocator()->Allocate<void>();
+      reader.ReadRootObject(ref_pRtti, pTarget);
+      return pTarget;
+    }
+  }
+  else
+  {
+    ezPrefixedStreamReader graphStream(inout_stream, ezArrayPtr<const ezUInt8>(prefix, uiPrefixSize));
+    ezAbstractGraphBinarySerializer::Read(graphStream, &graph);
+  }
+
+  ezRttiConverterContext context;
 
   ezRttiConverterReader convRead(&graph, &context);
   auto* pRootNode = graph.GetNodeByName("root");
@@ -129,10 +705,34 @@ void ezReflectionSerializer::ReadObjectPropertiesFromDDL(ezStreamReader& inout_s
 
 void ezReflectionSerializer::ReadObjectPropertiesFromBinary(ezStreamReader& inout_stream, const ezRTTI& rtti, void* pObject)
 {
+  ezUInt8 prefix[4];
+  ezUInt32 uiPrefixSize = 0;
+
   ezAbstractObjectGraph graph;
-  ezRttiConverterContext context;
 
-  ezAbstractGraphBinarySerializer::Read(inout_stream, &graph);
+  if (IsCompiledBinary(inout_stream, prefix, uiPrefixSize))
+  {
+    ezCompiledBinaryReader reader(inout_stream);
+
+    if (reader.ReadSchema().Failed())
+      return;
+
+    // data of another type would be matched against the layout of rtti, leave that to the property matching of the graph converter
+    if (!reader.NeedsPatching() && reader.GetRootType() == &rtti)
+    {
+      reader.ReadRootObject(&rtti, pObject);
+      return;
+    }
+
+    reader.ReadGraph(graph);
+  }
+  else
+  {
+    ezPrefixedStreamReader graphStream(inout_stream, ezArrayPtr<const ezUInt8>(prefix, uiPrefixSize));
+    ezAbstractGraphBinarySerializer::Read(graphStream, &graph);
+  }
+
+  ezRttiConverterContext context;
 
   ezRttiConverterReader convRead(&graph, &context);
   auto* pRootNode = graph.GetNodeByName("root");
@@ -371,14 +971,29 @@ namespace
     }
   }
 
-  static void CloneProperties(const void* pObject, void* pClone, const ezRTTI* pType)
+  static void CloneObject(const ezReflectionLayout* pLayout, const void* pObject, void* pClone)
   {
-    if (pType->GetParentType())
-      CloneProperties(pObject, pClone, pType->GetParentType());
+    const ezUInt8* pData = static_cast<const ezUInt8*>(pObject);
+    ezUInt8* pCloneData = static_cast<ezUInt8*>(pClone);
 
-    for (auto* pProp : pType->GetProperties())
+    for (const auto& op : pLayout->GetOperations())
     {
-      CloneProperty(pObject, pClone, pProp);
+      const ezReflectionLayout::Field& field = pLayout->GetFields()[op.m_uiFirstField];
+
+      switch (op.m_Type)
+      {
+        case ezReflectionLayout::FieldType::PlainData:
+          ezMemoryUtils::RawByteCopy(pCloneData + op.m_uiOffset, pData + op.m_uiOffset, op.m_uiSize);
+          break;
+
+        case ezReflectionLayout::FieldType::Nested:
+          CloneObject(field.m_pNestedLayout, pData + field.m_uiOffset, pCloneData + field.m_uiOffset);
+          break;
+
+        default:
+          CloneProperty(pObject, pClone, field.m_pProperty);
+          break;
+      }
     }
   }
 } // namespace
@@ -397,7 +1012,7 @@ void* ezReflectionSerializer::Clone(const void* pObject, const ezRTTI* pType)
 
   EZ_ASSERT_DEV(pType->GetAllocator()->CanAllocate(), "The type '{0}' can't be cloned!", pType->GetTypeName());
   void* pClone = pType->GetAllocator()->Allocate<void>();
-  CloneProperties(pObject, pClone, pType);
+  CloneObject(ezReflectionLayout::GetLayout(pType, pObject), pObject, pClone);
   return pClone;
 }
 
@@ -412,5 +1027,5 @@ void ezReflectionSerializer::Clone(const void* pObject, void* pClone, const ezRT
     EZ_ASSERT_DEV(pType == static_cast<ezReflectedClass*>(pClone)->GetDynamicRTTI(), "Object '{0}' and clone '{1}' have mismatching types!", pType->GetTypeName(), static_cast<ezReflectedClass*>(pClone)->GetDynamicRTTI()->GetTypeName());
   }
 
-  CloneProperties(pObject, pClone, pType);
+  CloneObject(ezReflectionLayout::GetLayout(pType, pObject), pObject, pClone);
 }
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/Map.h>
+#include <Foundation/Reflection/Reflection.h>
+#include <Foundation/Threading/Mutex.h>
+
+/// \brief Compiled description of how the reflected properties of a type map to the memory of its instances.
+///
+/// Layouts are built once per type and cached. Members of plain data types (numbers, vectors, colors, etc.) that are stored
+/// directly in the object are described by their byte offset, and consecutive ones are merged into runs that can be copied
+/// with a single memcpy. Embedded structs reference the layout of their own type. All other properties are still accessed
+/// through the regular reflection interface.
+///
+/// ezReflectionSerializer uses layouts for Clone() and the binary serialization functions.
+class EZ_FOUNDATION_DLL ezReflectionLayout
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezReflectionLayout);
+
+public:
+  ezReflectionLayout();
+  ~ezReflectionLayout();
+
+  enum class FieldType : ezUInt8
+  {
+    PlainData,  ///< A member of a plain data type, that can be copied with memcpy.
+    Nested,     ///< An embedded struct or class with direct member access, described by its own layout.
+    Value,      ///< A member that is read and written as an ezVariant.
+    ValueArray, ///< An array of values that are read and written as ezVariant.
+    Other,      ///< Anything else (pointers, sets, maps, arrays of classes, ...). Only supported by Clone().
+  };
+
+  /// \brief Describes one reflected property of the type or one of its base types.
+  struct Field
+  {
+    const ezAbstractProperty* m_pProperty = nullptr;
+    const ezReflectionLayout* m_pNestedLayout = nullptr; ///< The layout of the member type for FieldType::Nested.
+    ezUInt32 m_uiOffset = 0;                             ///< The byte offset from the start of the object for FieldType::PlainData and FieldType::Nested.
+    ezUInt32 m_uiSize = 0;                               ///< The size in bytes for FieldType::PlainData.
+    FieldType m_Type = FieldType::Other;
+    ezUInt8 m_uiVariantType = ezVariantType::Invalid; ///< The ezVariantType of FieldType::PlainData members.
+  };
+
+  /// \brief One step to process an object. A FieldType::PlainData operation may cover several consecutive fields, all others cover exactly one.
+  struct Operation
+  {
+    ezUInt32 m_uiFirstField = 0;
+    ezUInt32 m_uiNumFields = 0;
+    ezUInt32 m_uiOffset = 0; ///< Byte offset of the memory that a FieldType::PlainData operation copies.
+    ezUInt32 m_uiSize = 0;   ///< Number of bytes that a FieldType::PlainData operation copies.
+    FieldType m_Type = FieldType::Other;
+  };
+
+  /// \brief Returns the cached layout for the given type or builds it.
+  ///
+  /// \a pInstance must point to an instance of \a pType. It is only used to determine the member offsets when the layout is built.
+  static const ezReflectionLayout* GetLayout(const ezRTTI* pType, const void* pInstance);
+
+  /// \brief Deletes all cached layouts. Happens automatically when plugins are unloaded.
+  ///
+  /// Must not be called while other threads may use layouts.
+  static void ClearCache();
+
+  const ezRTTI* GetType() const { return m_pType; }
+  ezArrayPtr<const Field> GetFields() const { return m_Fields; }
+  ezArrayPtr<const Operation> GetOperations() const { return m_Operations; }
+
+  /// \brief Whether objects of this type can be written with the compiled binary format, ie. there are no FieldType::Other fields.
+  bool CanSerialize() const { return m_bCanSerialize; }
+
+  /// \brief Hash over the type name, the type version and the name and type of all fields. Serialized data with the same schema hash has exactly this layout.
+  ezUInt64 GetSchemaHash() const { return m_uiSchemaHash; }
+
+  /// \brief Maps the fields of serialized data with a different schema to the fields of this layout.
+  ///
+  /// Returns for every stored field the index of the field in this layout with the same name, or ezInvalidIndex.
+  /// The mapping is cached per stored schema hash, so it is only computed once per layout and version of the stored type.
+  ezArrayPtr<const ezUInt32> GetFieldMapping(ezUInt64 uiStoredSchemaHash, ezArrayPtr<const ezStringView> storedFieldNames) const;
+
+private:
+  static ezReflectionLayout* BuildLayout(const ezRTTI* pType, const void* pInstance);
+  void AddFields(const ezRTTI* pType, const void* pInstance);
+  void Finalize();
+
+  const ezRTTI* m_pType = nullptr;
+  ezDynamicArray<Field> m_Fields;
+  ezDynamicArray<Operation> m_Operations;
+  ezUInt64 m_uiSchemaHash = 0;
+  bool m_bCanSerialize = true;
+
+  mutable ezMutex m_FieldMappingMutex;
+  mutable ezMap<ezUInt64, ezDynamicArray<ezUInt32>> m_FieldMappings;
+};
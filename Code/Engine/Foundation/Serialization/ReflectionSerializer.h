@@ -24,8 +24,18 @@ public:
   /// \brief Overload of WriteObjectToDDL that takes an existing DDL writer to output to.
   static void WriteObjectToDDL(ezOpenDdlWriter& ref_ddl, const ezRTTI* pRtti, const void* pObject, ezUuid guid = ezUuid()); // [tested]
 
+  /// \brief Selects how WriteObjectToBinary() stores the object.
+  enum class BinaryFormat
+  {
+    Portable, ///< The object graph format. It doesn't depend on the memory layout of the types, so use it for anything that is stored or sent to another process.
+    Compiled, ///< Copies runs of plain data members directly from memory. Only use it for data that is read back by the same build on the same platform, e.g. within one process.
+  };
+
   /// \brief Same as WriteObjectToDDL but binary.
-  static void WriteObjectToBinary(ezStreamWriter& inout_stream, const ezRTTI* pRtti, const void* pObject); // [tested]
+  ///
+  /// The compiled format is only used if all properties of the type support it, otherwise the portable format is written.
+  /// Both formats can be read with ReadObjectFromBinary() and ReadObjectPropertiesFromBinary().
+  static void WriteObjectToBinary(ezStreamWriter& inout_stream, const ezRTTI* pRtti, const void* pObject, BinaryFormat format = BinaryFormat::Portable); // [tested]
 
   /// \brief Reads the entire DDL data in the stream and restores a reflected object.
   ///
@@ -51,6 +61,9 @@ public:
   static void ReadObjectPropertiesFromDDL(ezStreamReader& inout_stream, const ezRTTI& rtti, void* pObject); // [tested]
 
   /// \brief Same as ReadObjectPropertiesFromDDL but binary.
+  ///
+  /// Compiled data is only read directly into the object if it was written for exactly the type \a rtti. Otherwise it is converted
+  /// to an object graph first and the properties are matched by name.
   static void ReadObjectPropertiesFromBinary(ezStreamReader& inout_stream, const ezRTTI& rtti, void* pObject); // [tested]
 
   /// \brief Clones pObject of type pType and returns it.
@@ -5,15 +5,159 @@
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
+namespace
+{
+  // strings are distributed over several shards by their hash, so that threads that add different strings rarely contend
+  constexpr ezUInt32 s_uiNumShards = 16;
+
+  // Every shard additionally has an open-addressing index for looking up existing strings without taking the mutex.
+  // Entries are only ever added (under the shard mutex) and never change afterwards, so readers only need to check the published hash.
+  // With ref-counting enabled, strings may get removed by ClearUnusedStrings(), so the index is not used in that case.
+  constexpr ezUInt32 s_uiInitialIndexSize = 256;
+  constexpr ezUInt32 s_uiMaxIndexProbes = 16;
+
+  struct IndexEntry
+  {
+    ezAtomicInteger64 m_iHash; // zero means empty, written last to publish the entry
+    ezHashedString::HashedType m_Data;
+  };
+
+  /// When an index gets too full, a table of twice the size is built from the shard's strings and published instead.
+  /// Other threads may still be reading from the old table, so it is kept alive. Strings are never removed in this configuration
+  /// anyway and all retired tables of a shard together are smaller than its current one.
+  struct IndexTable
+  {
+    ezUInt32 m_uiMask = 0;
+    ezUInt32 m_uiNumEntries = 0; // only accessed with the shard mutex locked
+    IndexTable* m_pRetired = nullptr;
+    ezArrayPtr<IndexEntry> m_Entries;
+  };
+
+  // aligned to a cache line, so that threads working on different shards do not interfere
+  struct alignas(64) HashedStringShard
+  {
+    ezMutex m_Mutex;
+    ezHashedString::StringStorage m_Storage;
+
+#if EZ_DISABLED(EZ_HASHED_STRING_REF_COUNTING)
+    ezAtomicInteger64 m_iIndex; // the current IndexTable or zero, if no string was added yet
+#endif
+  };
+} // namespace
+
 struct HashedStringData
 {
-  ezMutex m_Mutex;
-  ezHashedString::StringStorage m_Storage;
+  HashedStringShard m_Shards[s_uiNumShards];
   ezHashedString::HashedType m_Empty;
 };
 
 static HashedStringData* s_pHSData;
 
+EZ_ALWAYS_INLINE static HashedStringShard& GetShard(ezUInt64 uiHash)
+{
+  return s_pHSData->m_Shards[uiHash >> 60];
+}
+
+static_assert(s_uiNumShards == 16, "GetShard() uses the upper 4 bits of the hash");
+
+#if EZ_DISABLED(EZ_HASHED_STRING_REF_COUNTING)
+
+EZ_ALWAYS_INLINE static IndexTable* GetIndexTable(const HashedStringShard& shard)
+{
+  return reinterpret_cast<IndexTable*>(static_cast<size_t>(shard.m_iIndex));
+}
+
+static bool FindInIndex(const HashedStringShard& shard, ezUInt64 uiHash, ezHashedString::HashedType& out_data)
+{
+  const IndexTable* pTable = GetIndexTable(shard);
+
+  // a hash of zero marks empty entries, such strings are never in the index
+  if (pTable == nullptr || uiHash == 0)
+    return false;
+
+  for (ezUInt32 i = 0; i < s_uiMaxIndexProbes; ++i)
+  {
+    const IndexEntry& entry = pTable->m_Entries[static_cast<ezUInt32>(uiHash + i) & pTable->m_uiMask];
+    const ezUInt64 uiEntryHash = static_cast<ezUInt64>(static_cast<ezInt64>(entry.m_iHash));
+
+    if (uiEntryHash == uiHash)
+    {
+      out_data = entry.m_Data;
+      return true;
+    }
+
+    if (uiEntryHash == 0)
+      return false;
+  }
+
+  return false;
+}
+
+/// \brief Returns false, if there was no free entry within the maximum number of probes.
+static bool InsertIntoIndexTable(IndexTable& ref_table, ezUInt64 uiHash, const ezHashedString::HashedType& data)
+{
+  for (ezUInt32 i = 0; i < s_uiMaxIndexProbes; ++i)
+  {
+    IndexEntry& entry = ref_table.m_Entries[static_cast<ezUInt32>(uiHash + i) & ref_table.m_uiMask];
+    const ezUInt64 uiEntryHash = static_cast<ezUInt64>(static_cast<ezInt64>(entry.m_iHash));
+
+    if (uiEntryHash == uiHash)
+      return true;
+
+    if (uiEntryHash == 0)
+    {
+      entry.m_Data = data;
+      entry.m_iHash.Set(static_cast<ezInt64>(uiHash));
+      ++ref_table.m_uiNumEntries;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void GrowIndex(HashedStringShard& ref_shard)
+{
+  IndexTable* pOldTable = GetIndexTable(ref_shard);
+  const ezUInt32 uiSize = pOldTable != nullptr ? (pOldTable->m_uiMask + 1) * 2 : s_uiInitialIndexSize;
+
+  IndexTable* pTable = EZ_NEW(ezFoundation::GetStaticsAllocator(), IndexTable);
+  pTable->m_uiMask = uiSize - 1;
+  pTable->m_pRetired = pOldTable;
+  pTable->m_Entries = EZ_NEW_ARRAY(ezFoundation::GetStaticsAllocator(), IndexEntry, uiSize);
+
+  // strings that didn't fit into the old table are added as well
+  for (auto it = ref_shard.m_Storage.GetIterator(); it.IsValid(); ++it)
+  {
+    if (it.Key() != 0)
+    {
+      InsertIntoIndexTable(*pTable, it.Key(), it);
+    }
+  }
+
+  // publishing the pointer is a full barrier, so readers never see a partially built table
+  ref_shard.m_iIndex.Set(static_cast<ezInt64>(reinterpret_cast<size_t>(pTable)));
+}
+
+static void AddToIndex(HashedStringShard& ref_shard, ezUInt64 uiHash, const ezHashedString::HashedType& data)
+{
+  EZ_ASSERT_DEBUG(ref_shard.m_Mutex.IsLocked(), "The shard must be locked to modify its index");
+
+  if (uiHash == 0)
+    return;
+
+  IndexTable* pTable = GetIndexTable(ref_shard);
+
+  // keep the index at most half full, so that lookups rarely need more than a few probes
+  if (pTable == nullptr || pTable->m_uiNumEntries >= (pTable->m_uiMask + 1) / 2 || !InsertIntoIndexTable(*pTable, uiHash, data))
+  {
+    // the new table is built from the storage, which already contains the new string
+    GrowIndex(ref_shard);
+  }
+}
+
+#endif
+
 EZ_MSVC_ANALYSIS_WARNING_PUSH
 EZ_MSVC_ANALYSIS_WARNING_DISABLE(6011) // Disable warning for null pointer dereference as InitHashedString() will ensure that s_pHSData is set
 
@@ -23,11 +167,31 @@ ezHashedString::HashedType ezHashedString::AddHashedString(ezStringView sString,
   if (s_pHSData == nullptr)
     InitHashedString();
 
-  EZ_LOCK(s_pHSData->m_Mutex);
+  HashedStringShard& shard = GetShard(uiHash);
+
+#if EZ_DISABLED(EZ_HASHED_STRING_REF_COUNTING)
+  // fast path, most strings already exist
+  {
+    HashedType ret;
+    if (FindInIndex(shard, uiHash, ret))
+    {
+#  if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      if (ret.Value().m_sString != sString)
+      {
+        ezLog::Error("Hash collision encountered: Strings \"{}\" and \"{}\" both hash to {}.", ezArgSensitive(ret.Value().m_sString), ezArgSensitive(sString), uiHash);
+      }
+#  endif
+
+      return ret;
+    }
+  }
+#endif
+
+  EZ_LOCK(shard.m_Mutex);
 
   // try to find the existing string
   bool bExisted = false;
-  auto ret = s_pHSData->m_Storage.FindOrAdd(uiHash, &bExisted);
+  auto ret = shard.m_Storage.FindOrAdd(uiHash, &bExisted);
 
   // if it already exists, just increase the refcount
   if (bExisted)
@@ -53,6 +217,10 @@ ezHashedString::HashedType ezHashedString::AddHashedString(ezStringView sString,
     d.m_sString = sString;
   }
 
+#if EZ_DISABLED(EZ_HASHED_STRING_REF_COUNTING)
+  AddToIndex(shard, uiHash, ret);
+#endif
+
   return ret;
 }
 
@@ -79,19 +247,22 @@ void ezHashedString::InitHashedString()
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
 ezUInt32 ezHashedString::ClearUnusedStrings()
 {
-  EZ_LOCK(s_pHSData->m_Mutex);
-
   ezUInt32 uiDeleted = 0;
 
-  for (auto it = s_pHSData->m_Storage.GetIterator(); it.IsValid();)
+  for (HashedStringShard& shard : s_pHSData->m_Shards)
   {
-    if (it.Value().m_iRefCount == 0)
+    EZ_LOCK(shard.m_Mutex);
+
+    for (auto it = shard.m_Storage.GetIterator(); it.IsValid();)
     {
-      it = s_pHSData->m_Storage.Remove(it);
-      ++uiDeleted;
+      if (it.Value().m_iRefCount == 0)
+      {
+        it = shard.m_Storage.Remove(it);
+        ++uiDeleted;
+      }
+      else
+        ++it;
     }
-    else
-      ++it;
   }
 
   return uiDeleted;
@@ -142,8 +313,10 @@ void ezHashedString::Clear()
 
 ezResult ezHashedString::LookupStringHash(ezUInt64 uiHash, ezStringView& out_sResult)
 {
-  EZ_LOCK(s_pHSData->m_Mutex);
-  auto it = s_pHSData->m_Storage.Find(uiHash);
+  HashedStringShard& shard = GetShard(uiHash);
+
+  EZ_LOCK(shard.m_Mutex);
+  auto it = shard.m_Storage.Find(uiHash);
 
   if (!it.IsValid())
     return EZ_FAILURE;
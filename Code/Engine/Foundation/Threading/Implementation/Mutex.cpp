@@ -0,0 +1,23 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Threading/Mutex.h>
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+
+#  include <Foundation/Profiling/Profiling.h>
+#  include <Foundation/Time/Time.h>
+
+void ezMutex::LockContended()
+{
+  if (!ezProfilingSystem::IsRecordingMutexWaits())
+  {
+    LockNative();
+    return;
+  }
+
+  const ezTime beginTime = ezTime::Now();
+  LockNative();
+  ezProfilingSystem::AddMutexWait(beginTime, ezTime::Now());
+}
+
+#endif
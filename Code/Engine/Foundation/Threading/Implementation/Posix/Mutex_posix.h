@@ -15,22 +15,16 @@ EZ_ALWAYS_INLINE ezMutex::~ezMutex()
   pthread_mutex_destroy(&m_hHandle);
 }
 
-EZ_ALWAYS_INLINE void ezMutex::Lock()
+EZ_ALWAYS_INLINE void ezMutex::LockNative()
 {
   pthread_mutex_lock(&m_hHandle);
-  ++m_iLockCount;
 }
 
-EZ_ALWAYS_INLINE ezResult ezMutex::TryLock()
+EZ_ALWAYS_INLINE bool ezMutex::TryLockNative()
 {
-  if (pthread_mutex_trylock(&m_hHandle) == 0)
-  {
-    ++m_iLockCount;
-    return EZ_SUCCESS;
-  }
-
-  return EZ_FAILURE;
+  return pthread_mutex_trylock(&m_hHandle) == 0;
 }
+
 EZ_ALWAYS_INLINE void ezMutex::Unlock()
 {
   --m_iLockCount;
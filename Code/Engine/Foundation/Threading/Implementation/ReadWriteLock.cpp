@@ -0,0 +1,186 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Threading/ReadWriteLock.h>
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+
+namespace
+{
+  /// Remembers which shared locks the current thread holds, to detect attempts to upgrade a shared lock to an exclusive one.
+  /// A thread rarely holds more than a few shared locks at a time, locks beyond the first few are only counted.
+  struct ezHeldSharedLocks
+  {
+    static constexpr ezUInt32 s_uiMaxTrackedLocks = 16;
+
+    const ezReadWriteLock* m_Locks[s_uiMaxTrackedLocks];
+    ezUInt32 m_uiNumTrackedLocks;
+    ezUInt32 m_uiNumUntrackedLocks;
+
+    void Add(const ezReadWriteLock* pLock)
+    {
+      if (m_uiNumTrackedLocks < s_uiMaxTrackedLocks)
+        m_Locks[m_uiNumTrackedLocks++] = pLock;
+      else
+        ++m_uiNumUntrackedLocks;
+    }
+
+    void Remove(const ezReadWriteLock* pLock)
+    {
+      for (ezUInt32 i = m_uiNumTrackedLocks; i > 0; --i)
+      {
+        if (m_Locks[i - 1] == pLock)
+        {
+          m_Locks[i - 1] = m_Locks[--m_uiNumTrackedLocks];
+          return;
+        }
+      }
+
+      if (m_uiNumUntrackedLocks > 0)
+        --m_uiNumUntrackedLocks;
+    }
+
+    bool Contains(const ezReadWriteLock* pLock) const
+    {
+      for (ezUInt32 i = 0; i < m_uiNumTrackedLocks; ++i)
+      {
+        if (m_Locks[i] == pLock)
+          return true;
+      }
+
+      return false;
+    }
+  };
+
+  thread_local ezHeldSharedLocks tl_HeldSharedLocks;
+} // namespace
+
+#endif
+
+ezReadWriteLock::ezReadWriteLock() = default;
+
+ezReadWriteLock::~ezReadWriteLock()
+{
+  EZ_ASSERT_DEV(m_iState == 0, "ezReadWriteLock is destroyed while it is still locked.");
+}
+
+bool ezReadWriteLock::IsLockedByThisThread() const
+{
+  // Other threads may write m_WriterThread concurrently, but it can only ever contain the ID of the current thread,
+  // if the current thread wrote it itself.
+  return m_iState == s_iWriterActive && m_WriterThread == ezThreadUtils::GetCurrentThreadID();
+}
+
+void ezReadWriteLock::WakeUpWaitingThreads()
+{
+  // m_iNumWaiting is incremented before a thread checks m_iState and goes to sleep,
+  // so if it is zero after m_iState was changed, nobody can miss the change
+  if (m_iNumWaiting > 0)
+  {
+    EZ_LOCK(m_Signal);
+    m_Signal.SignalAll();
+  }
+}
+
+void ezReadWriteLock::LockShared()
+{
+  while (true)
+  {
+    const ezInt32 iState = m_iState;
+
+    if (iState != s_iWriterActive)
+    {
+      if (m_iState.TestAndSet(iState, iState + 1))
+        break;
+
+      // another reader came in between, try again
+      continue;
+    }
+
+    if (IsLockedByThisThread())
+    {
+      // the writer may read as well
+      ++m_uiWriterRecursion;
+      return;
+    }
+
+    EZ_LOCK(m_Signal);
+    m_iNumWaiting.Increment();
+
+    while (m_iState == s_iWriterActive)
+    {
+      m_Signal.UnlockWaitForSignalAndLock();
+    }
+
+    m_iNumWaiting.Decrement();
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  tl_HeldSharedLocks.Add(this);
+#endif
+}
+
+void ezReadWriteLock::UnlockShared()
+{
+  if (IsLockedByThisThread())
+  {
+    --m_uiWriterRecursion;
+    EZ_ASSERT_DEBUG(m_uiWriterRecursion > 0, "The shared lock of the writer thread was released more often than it was acquired.");
+    return;
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  tl_HeldSharedLocks.Remove(this);
+#endif
+
+  const ezInt32 iState = m_iState.Decrement();
+  EZ_ASSERT_DEV(iState >= 0, "Cannot release a shared lock that was not acquired before.");
+
+  if (iState == 0)
+  {
+    // a writer may wait for the last reader
+    WakeUpWaitingThreads();
+  }
+}
+
+void ezReadWriteLock::Lock()
+{
+  if (IsLockedByThisThread())
+  {
+    ++m_uiWriterRecursion;
+    return;
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  EZ_ASSERT_DEV(!tl_HeldSharedLocks.Contains(this), "This thread holds the shared lock and tries to acquire the exclusive lock. Upgrading a shared lock would dead-lock.");
+#endif
+
+  while (!m_iState.TestAndSet(0, s_iWriterActive))
+  {
+    EZ_LOCK(m_Signal);
+    m_iNumWaiting.Increment();
+
+    while (m_iState != 0)
+    {
+      m_Signal.UnlockWaitForSignalAndLock();
+    }
+
+    m_iNumWaiting.Decrement();
+  }
+
+  m_WriterThread = ezThreadUtils::GetCurrentThreadID();
+  m_uiWriterRecursion = 1;
+}
+
+void ezReadWriteLock::Unlock()
+{
+  EZ_ASSERT_DEV(IsLockedByThisThread(), "Cannot release an exclusive lock that is not held by this thread.");
+  --m_uiWriterRecursion;
+
+  if (m_uiWriterRecursion == 0)
+  {
+    m_WriterThread = {};
+    m_iState.Set(0);
+
+    WakeUpWaitingThreads();
+  }
+}
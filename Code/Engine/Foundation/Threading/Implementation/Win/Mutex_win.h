@@ -28,10 +28,9 @@ extern "C"
 #  endif
 }
 
-inline void ezMutex::Lock()
+inline void ezMutex::LockNative()
 {
   ezWinEnterCriticalSection(&m_hHandle);
-  ++m_iLockCount;
 }
 
 inline void ezMutex::Unlock()
@@ -40,25 +39,18 @@ inline void ezMutex::Unlock()
   ezWinLeaveCriticalSection(&m_hHandle);
 }
 
-inline ezResult ezMutex::TryLock()
+inline bool ezMutex::TryLockNative()
 {
-  if (ezWinTryEnterCriticalSection(&m_hHandle) != 0)
-  {
-    ++m_iLockCount;
-    return EZ_SUCCESS;
-  }
-
-  return EZ_FAILURE;
+  return ezWinTryEnterCriticalSection(&m_hHandle) != 0;
 }
 
 #else
 
 #  include <Foundation/Basics/Platform/Win/IncludeWindows.h>
 
-inline void ezMutex::Lock()
+inline void ezMutex::LockNative()
 {
   EnterCriticalSection((CRITICAL_SECTION*)&m_hHandle);
-  ++m_iLockCount;
 }
 
 inline void ezMutex::Unlock()
@@ -67,15 +59,9 @@ inline void ezMutex::Unlock()
   LeaveCriticalSection((CRITICAL_SECTION*)&m_hHandle);
 }
 
-inline ezResult ezMutex::TryLock()
+inline bool ezMutex::TryLockNative()
 {
-  if (TryEnterCriticalSection((CRITICAL_SECTION*)&m_hHandle) != 0)
-  {
-    ++m_iLockCount;
-    return EZ_SUCCESS;
-  }
-
-  return EZ_FAILURE;
+  return TryEnterCriticalSection((CRITICAL_SECTION*)&m_hHandle) != 0;
 }
 
 #endif
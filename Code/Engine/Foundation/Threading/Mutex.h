@@ -37,6 +37,17 @@ public:
   ezMutexHandle& GetMutexHandle() { return m_hHandle; }
 
 private:
+  /// \brief Blocks until the lock is acquired, without updating the lock count.
+  void LockNative();
+
+  /// \brief Tries to acquire the lock without blocking and without updating the lock count.
+  bool TryLockNative();
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  /// \brief Waits for a mutex that is held by another thread and reports the wait time to ezProfilingSystem, if the cvar 'Profiling.MutexWaits' is enabled.
+  void LockContended();
+#endif
+
   ezMutexHandle m_hHandle;
   ezInt32 m_iLockCount = 0;
 };
@@ -67,3 +78,29 @@ public:
 #else
 #  error "Mutex is not implemented on current platform"
 #endif
+
+EZ_ALWAYS_INLINE void ezMutex::Lock()
+{
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  // only the contended case is measured, an uncontended lock costs the same as before
+  if (!TryLockNative())
+  {
+    LockContended();
+  }
+#else
+  LockNative();
+#endif
+
+  ++m_iLockCount;
+}
+
+EZ_ALWAYS_INLINE ezResult ezMutex::TryLock()
+{
+  if (TryLockNative())
+  {
+    ++m_iLockCount;
+    return EZ_SUCCESS;
+  }
+
+  return EZ_FAILURE;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/ConditionVariable.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+/// \brief A lock that can be held by any number of readers at the same time, or by a single writer.
+///
+/// Use LockShared() / UnlockShared() (or EZ_LOCK_SHARED) for operations that only read the protected state
+/// and Lock() / Unlock() (or EZ_LOCK) for operations that modify it.
+///
+/// As long as no writer holds the lock, acquiring and releasing the shared lock is a single atomic operation and readers never block each other.
+/// Threads only go to sleep on an internal condition variable, when they have to wait for a writer or a writer has to wait for readers.
+///
+/// Shared locks may be taken recursively. The thread that holds the exclusive lock may take both the exclusive and the shared lock
+/// again. A thread that holds a shared lock must not try to take the exclusive lock though, that would dead-lock.
+/// In development builds such an attempt to upgrade the lock triggers an assert.
+///
+/// Readers never wait for writers that have not acquired the lock yet, which is what makes recursive shared locking safe.
+/// Consequently the exclusive lock should only be used for rare operations, since a steady stream of readers can delay a writer.
+class EZ_FOUNDATION_DLL ezReadWriteLock
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezReadWriteLock);
+
+public:
+  ezReadWriteLock();
+  ~ezReadWriteLock();
+
+  /// \brief Acquires the lock for reading. Blocks while another thread holds the exclusive lock.
+  void LockShared();
+
+  /// \brief Releases a lock that was acquired with LockShared().
+  void UnlockShared();
+
+  /// \brief Acquires the lock exclusively. Blocks until no other thread holds the lock, neither shared nor exclusively.
+  void Lock();
+
+  /// \brief Releases a lock that was acquired with Lock().
+  void Unlock();
+
+private:
+  bool IsLockedByThisThread() const;
+  void WakeUpWaitingThreads();
+
+  static constexpr ezInt32 s_iWriterActive = -1;
+
+  ezAtomicInteger32 m_iState;      ///< The number of shared locks that are held, or s_iWriterActive while a writer holds the lock.
+  ezAtomicInteger32 m_iNumWaiting; ///< The number of threads that sleep on m_Signal.
+  ezConditionVariable m_Signal;
+  ezUInt32 m_uiWriterRecursion = 0;
+  ezThreadID m_WriterThread = {};
+};
+
+/// \brief Acquires a shared lock (e.g. of an ezReadWriteLock) and releases it as the lock object goes out of scope.
+template <typename T>
+class ezSharedLock
+{
+public:
+  EZ_ALWAYS_INLINE explicit ezSharedLock(T& ref_lock)
+    : m_Lock(ref_lock)
+  {
+    m_Lock.LockShared();
+  }
+
+  EZ_ALWAYS_INLINE ~ezSharedLock() { m_Lock.UnlockShared(); }
+
+private:
+  ezSharedLock();
+  ezSharedLock(const ezSharedLock<T>& rhs);
+  void operator=(const ezSharedLock<T>& rhs);
+
+  T& m_Lock;
+};
+
+/// \brief Shortcut for ezSharedLock<Type> l(lock)
+#define EZ_LOCK_SHARED(lock) ezSharedLock<decltype(lock)> EZ_PP_CONCAT(l_, EZ_SOURCE_LINE)(lock)
@@ -1,11 +1,82 @@
 #pragma once
 
 #include <Core/Graphics/Camera.h>
+#include <Foundation/Containers/HashSet.h>
+#include <Foundation/Containers/HashTable.h>
 #include <RendererCore/Debug/DebugRendererContext.h>
 #include <RendererCore/Pipeline/RenderData.h>
 #include <RendererCore/Pipeline/RenderDataBatch.h>
 #include <RendererCore/Pipeline/ViewData.h>
 
+/// \brief Render data of static objects that is kept sorted across frames.
+///
+/// An extractor can keep an instance of this over multiple frames and only add or remove the render data of objects whose visibility
+/// changed. ezExtractedRenderData::SortAndBatch then merges the already sorted data with the render data of the current frame, instead of
+/// sorting everything again. The sorting keys are only recomputed when the camera changes.
+///
+/// The render data has to stay valid as long as it is in the list, so only cached render data should be added.
+/// \sa ezRenderWorld::GetDeletedCachedRenderDataOwners()
+class EZ_RENDERERCORE_DLL ezStaticRenderDataList
+{
+public:
+  ezStaticRenderDataList();
+  ~ezStaticRenderDataList();
+
+  /// \brief Removes all render data.
+  void Clear();
+
+  /// \brief Adds render data of the given owner. The data is sorted into the list on the next call to Update().
+  void AddRenderData(const ezGameObjectHandle& hOwner, const ezRenderData* pRenderData, ezRenderData::Category category);
+
+  /// \brief Removes all render data of the given owner on the next call to Update().
+  void RemoveRenderData(const ezGameObjectHandle& hOwner);
+
+  /// \brief Applies all additions and removals and recomputes the sorting keys if the camera changed since the last update.
+  void Update(const ezCamera& camera);
+
+  /// \brief Returns the number of render data entries after the last update.
+  ezUInt32 GetCount() const;
+
+  /// \brief Removes the render data of all owners whose cached render data was deleted since the last call on the next call to Update().
+  ///
+  /// The affected owners are returned in out_deletedOwners, so that the caller can add their new render data again.
+  /// Returns false if the deletions aren't known anymore, see ezRenderWorld::GetDeletedCachedRenderDataOwners(). In that case the list was
+  /// cleared and everything needs to be added again.
+  bool RemoveDeletedCachedRenderData(ezDynamicArray<ezGameObjectHandle>& out_deletedOwners);
+
+private:
+  friend class ezExtractedRenderData;
+
+  struct Entry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const ezRenderData* m_pRenderData;
+    ezUInt64 m_uiSortingKey;
+    ezGameObjectHandle m_hOwner;
+  };
+
+  struct DataPerCategory
+  {
+    ezDynamicArray<Entry> m_SortedData;
+    ezDynamicArray<Entry> m_NewData;
+  };
+
+  bool HasSameSortingCamera(const ezCamera& camera) const;
+
+  ezHybridArray<DataPerCategory, 16> m_DataPerCategory;
+  ezHashSet<ezGameObjectHandle> m_RemovedOwners;
+  ezDynamicArray<Entry> m_TempData;
+  ezUInt64 m_uiCacheChangeIndex = 0;
+
+  bool m_bHasCamera = false;
+  ezVec3 m_vCameraPosition;
+  ezVec3 m_vCameraDirection;
+  float m_fCameraNearPlane = 0.0f;
+  float m_fCameraFarPlane = 0.0f;
+  float m_fCameraFovOrDim = 0.0f;
+};
+
 class EZ_RENDERERCORE_DLL ezExtractedRenderData
 {
 public:
@@ -32,6 +103,17 @@ public:
   void AddRenderData(const ezRenderData* pRenderData, ezRenderData::Category category);
   void AddFrameData(const ezRenderData* pFrameData);
 
+  /// \brief Appends all render data and frame data of the other extracted data. The sorting keys are taken over as they are,
+  /// so both need to use the same camera.
+  ///
+  /// Used to merge the per task buckets of a parallel extraction before SortAndBatch is called.
+  void AppendRenderData(const ezExtractedRenderData& other);
+
+  /// \brief Sets persistent, already sorted render data that is merged with the render data of this frame in SortAndBatch.
+  ///
+  /// The list must not be modified until SortAndBatch has been called.
+  void SetStaticRenderData(const ezStaticRenderDataList* pStaticRenderData);
+
   void SortAndBatch();
 
   void Clear();
@@ -47,6 +129,7 @@ public:
 
 private:
   const ezRenderData* GetFrameData(const ezRTTI* pRtti) const;
+  void GroupBatches(ezDynamicArray<ezRenderDataBatch::SortableRenderData>& ref_data);
 
   struct DataPerCategory
   {
@@ -64,4 +147,13 @@ private:
 
   ezHybridArray<DataPerCategory, 16> m_DataPerCategory;
   ezHybridArray<const ezRenderData*, 16> m_FrameData;
+
+  const ezStaticRenderDataList* m_pStaticRenderData = nullptr;
+  ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_TempSortableRenderData;
+
+  // Temporary data for GroupBatches
+  ezHashTable<ezUInt64, ezUInt32> m_BatchGroups;
+  ezHybridArray<const ezRTTI*, 8> m_BatchGroupTypes;
+  ezDynamicArray<ezUInt32> m_BatchGroupOffsets;
+  ezDynamicArray<ezUInt32> m_RunGroups;
 };
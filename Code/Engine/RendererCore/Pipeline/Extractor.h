@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Types/UniquePtr.h>
 #include <RendererCore/Pipeline/RenderData.h>
 
 class ezStreamWriter;
@@ -45,12 +47,21 @@ protected:
   ezHybridArray<ezHashedString, 4> m_DependsOn;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  mutable ezUInt32 m_uiNumCachedRenderData;
-  mutable ezUInt32 m_uiNumUncachedRenderData;
+  mutable ezAtomicInteger32 m_uiNumCachedRenderData;
+  mutable ezAtomicInteger32 m_uiNumUncachedRenderData;
 #endif
 };
 
 
+/// \brief Extracts the render data of all visible objects of a view.
+///
+/// With Rendering.Multithreading enabled and enough visible objects, the objects are split into chunks that are extracted in parallel.
+/// Every chunk writes into its own ezExtractedRenderData bucket and the buckets are appended to the view's data in chunk order,
+/// so the result is the same as with a serial extraction.
+///
+/// The render data of static objects whose render data is completely cached is kept in a persistent, sorted list across frames
+/// (see ezStaticRenderDataList). Only objects that became visible or invisible since the last frame are added to or removed from this list,
+/// all other static objects are neither extracted nor sorted again. This can be disabled with Rendering.Caching.StaticRenderList.
 class EZ_RENDERERCORE_DLL ezVisibleObjectsExtractor : public ezExtractor
 {
   EZ_ADD_DYNAMIC_REFLECTION(ezVisibleObjectsExtractor, ezExtractor);
@@ -62,6 +73,18 @@ public:
   virtual void Extract(const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& ref_extractedRenderData) override;
   virtual ezResult Serialize(ezStreamWriter& inout_stream) const override;
   virtual ezResult Deserialize(ezStreamReader& inout_stream) override;
+
+private:
+  struct StaticRenderListState;
+
+  void UpdateStaticRenderList(const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& ref_extractedRenderData);
+  void ExtractChunk(const ezView& view, ezArrayPtr<const ezGameObject* const> objects, ezExtractedRenderData& ref_extractedRenderData) const;
+
+  // Kept across frames to avoid re-allocating the buckets. A render pipeline only extracts one view at a time, so no locking is needed.
+  ezDynamicArray<ezUniquePtr<ezExtractedRenderData>> m_ChunkData;
+
+  ezUniquePtr<StaticRenderListState> m_pStaticRenderList;
+  ezDynamicArray<const ezGameObject*> m_ObjectsToExtract;
 };
 
 class EZ_RENDERERCORE_DLL ezSelectedObjectsExtractorBase : public ezExtractor
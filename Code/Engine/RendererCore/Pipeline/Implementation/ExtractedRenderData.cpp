@@ -1,7 +1,184 @@
 #include <RendererCore/RendererCorePCH.h>
 
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+
+ezCVarBool cvar_RenderingAutoInstancing("Rendering.AutoInstancing", true, ezCVarFlags::Default, "Moves render data with the same batch id into one batch, so that it is rendered with one instanced draw call.");
+
+namespace
+{
+  template <typename A, typename B>
+  EZ_FORCE_INLINE bool IsRenderDataLess(const A& a, const B& b)
+  {
+    if (a.m_uiSortingKey == b.m_uiSortingKey)
+    {
+      return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
+    }
+
+    return a.m_uiSortingKey < b.m_uiSortingKey;
+  }
+
+  struct RenderDataComparer
+  {
+    template <typename T>
+    EZ_FORCE_INLINE bool Less(const T& a, const T& b) const
+    {
+      return IsRenderDataLess(a, b);
+    }
+  };
+} // namespace
+
+ezStaticRenderDataList::ezStaticRenderDataList() = default;
+ezStaticRenderDataList::~ezStaticRenderDataList() = default;
+
+void ezStaticRenderDataList::Clear()
+{
+  for (auto& dataPerCategory : m_DataPerCategory)
+  {
+    dataPerCategory.m_SortedData.Clear();
+    dataPerCategory.m_NewData.Clear();
+  }
+
+  m_RemovedOwners.Clear();
+  m_bHasCamera = false;
+}
+
+void ezStaticRenderDataList::AddRenderData(const ezGameObjectHandle& hOwner, const ezRenderData* pRenderData, ezRenderData::Category category)
+{
+  m_DataPerCategory.EnsureCount(category.m_uiValue + 1);
+
+  auto& entry = m_DataPerCategory[category.m_uiValue].m_NewData.ExpandAndGetRef();
+  entry.m_pRenderData = pRenderData;
+  entry.m_uiSortingKey = 0;
+  entry.m_hOwner = hOwner;
+}
+
+void ezStaticRenderDataList::RemoveRenderData(const ezGameObjectHandle& hOwner)
+{
+  m_RemovedOwners.Insert(hOwner);
+}
+
+void ezStaticRenderDataList::Update(const ezCamera& camera)
+{
+  EZ_PROFILE_SCOPE("Update Static Render Data");
+
+  const bool bCameraChanged = !HasSameSortingCamera(camera);
+  if (bCameraChanged)
+  {
+    m_bHasCamera = true;
+    m_vCameraPosition = camera.GetPosition();
+    m_vCameraDirection = camera.GetDirForwards();
+    m_fCameraNearPlane = camera.GetNearPlane();
+    m_fCameraFarPlane = camera.GetFarPlane();
+    m_fCameraFovOrDim = camera.GetFovOrDim();
+  }
+
+  for (ezUInt32 uiCategory = 0; uiCategory < m_DataPerCategory.GetCount(); ++uiCategory)
+  {
+    const ezRenderData::Category category(static_cast<ezUInt16>(uiCategory));
+    auto& sortedData = m_DataPerCategory[uiCategory].m_SortedData;
+    auto& newData = m_DataPerCategory[uiCategory].m_NewData;
+
+    // Removals only apply to data that was added before, the order of the remaining data is kept.
+    if (!m_RemovedOwners.IsEmpty())
+    {
+      ezUInt32 uiNumRemaining = 0;
+      for (ezUInt32 i = 0; i < sortedData.GetCount(); ++i)
+      {
+        if (!m_RemovedOwners.Contains(sortedData[i].m_hOwner))
+        {
+          sortedData[uiNumRemaining] = sortedData[i];
+          ++uiNumRemaining;
+        }
+      }
+
+      sortedData.SetCountUninitialized(uiNumRemaining);
+    }
+
+    for (auto& entry : newData)
+    {
+      entry.m_uiSortingKey = entry.m_pRenderData->GetCategorySortingKey(category, camera);
+    }
+
+    if (bCameraChanged)
+    {
+      for (auto& entry : sortedData)
+      {
+        entry.m_uiSortingKey = entry.m_pRenderData->GetCategorySortingKey(category, camera);
+      }
+
+      sortedData.PushBackRange(newData);
+      sortedData.Sort(RenderDataComparer());
+    }
+    else if (!newData.IsEmpty())
+    {
+      newData.Sort(RenderDataComparer());
+
+      m_TempData.Clear();
+      m_TempData.Reserve(sortedData.GetCount() + newData.GetCount());
+
+      ezUInt32 a = 0;
+      ezUInt32 b = 0;
+      while (a < sortedData.GetCount() && b < newData.GetCount())
+      {
+        if (IsRenderDataLess(newData[b], sortedData[a]))
+          m_TempData.PushBack(newData[b++]);
+        else
+          m_TempData.PushBack(sortedData[a++]);
+      }
+
+      m_TempData.PushBackRange(sortedData.GetArrayPtr().GetSubArray(a));
+      m_TempData.PushBackRange(newData.GetArrayPtr().GetSubArray(b));
+
+      sortedData.Swap(m_TempData);
+    }
+
+    newData.Clear();
+  }
+
+  m_RemovedOwners.Clear();
+}
+
+ezUInt32 ezStaticRenderDataList::GetCount() const
+{
+  ezUInt32 uiCount = 0;
+  for (auto& dataPerCategory : m_DataPerCategory)
+  {
+    uiCount += dataPerCategory.m_SortedData.GetCount();
+  }
+
+  return uiCount;
+}
+
+bool ezStaticRenderDataList::RemoveDeletedCachedRenderData(ezDynamicArray<ezGameObjectHandle>& out_deletedOwners)
+{
+  out_deletedOwners.Clear();
+
+  // The list points to cached render data, so the data of owners whose cache was deleted must not be used anymore.
+  if (!ezRenderWorld::GetDeletedCachedRenderDataOwners(m_uiCacheChangeIndex, out_deletedOwners))
+  {
+    out_deletedOwners.Clear();
+    Clear();
+    return false;
+  }
+
+  for (const ezGameObjectHandle& hOwner : out_deletedOwners)
+  {
+    m_RemovedOwners.Insert(hOwner);
+  }
+
+  return true;
+}
+
+bool ezStaticRenderDataList::HasSameSortingCamera(const ezCamera& camera) const
+{
+  return m_bHasCamera && m_vCameraPosition == camera.GetPosition() && m_vCameraDirection == camera.GetDirForwards() &&
+         m_fCameraNearPlane == camera.GetNearPlane() && m_fCameraFarPlane == camera.GetFarPlane() && m_fCameraFovOrDim == camera.GetFovOrDim();
+}
+
+//////////////////////////////////////////////////////////////////////////
 
 ezExtractedRenderData::ezExtractedRenderData() = default;
 
@@ -19,32 +196,77 @@ void ezExtractedRenderData::AddFrameData(const ezRenderData* pFrameData)
   m_FrameData.PushBack(pFrameData);
 }
 
+void ezExtractedRenderData::AppendRenderData(const ezExtractedRenderData& other)
+{
+  m_DataPerCategory.EnsureCount(other.m_DataPerCategory.GetCount());
+
+  for (ezUInt32 uiCategory = 0; uiCategory < other.m_DataPerCategory.GetCount(); ++uiCategory)
+  {
+    m_DataPerCategory[uiCategory].m_SortableRenderData.PushBackRange(other.m_DataPerCategory[uiCategory].m_SortableRenderData);
+  }
+
+  m_FrameData.PushBackRange(other.m_FrameData);
+}
+
+void ezExtractedRenderData::SetStaticRenderData(const ezStaticRenderDataList* pStaticRenderData)
+{
+  m_pStaticRenderData = pStaticRenderData;
+}
+
 void ezExtractedRenderData::SortAndBatch()
 {
   EZ_PROFILE_SCOPE("SortAndBatch");
 
-  struct RenderDataComparer
+  if (m_pStaticRenderData != nullptr)
   {
-    EZ_FORCE_INLINE bool Less(const ezRenderDataBatch::SortableRenderData& a, const ezRenderDataBatch::SortableRenderData& b) const
+    m_DataPerCategory.EnsureCount(m_pStaticRenderData->m_DataPerCategory.GetCount());
+  }
+
+  for (ezUInt32 uiCategory = 0; uiCategory < m_DataPerCategory.GetCount(); ++uiCategory)
+  {
+    auto& dataPerCategory = m_DataPerCategory[uiCategory];
+    auto& data = dataPerCategory.m_SortableRenderData;
+
+    // Sort
+    data.Sort(RenderDataComparer());
+
+    // Merge with the static data which is already sorted
+    if (m_pStaticRenderData != nullptr && uiCategory < m_pStaticRenderData->m_DataPerCategory.GetCount())
     {
-      if (a.m_uiSortingKey == b.m_uiSortingKey)
+      const auto& staticData = m_pStaticRenderData->m_DataPerCategory[uiCategory].m_SortedData;
+      if (!staticData.IsEmpty())
       {
-        return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
-      }
+        m_TempSortableRenderData.Clear();
+        m_TempSortableRenderData.Reserve(data.GetCount() + staticData.GetCount());
 
-      return a.m_uiSortingKey < b.m_uiSortingKey;
+        ezUInt32 a = 0;
+        ezUInt32 b = 0;
+        while (a < data.GetCount() || b < staticData.GetCount())
+        {
+          if (b == staticData.GetCount() || (a < data.GetCount() && !IsRenderDataLess(staticData[b], data[a])))
+          {
+            m_TempSortableRenderData.PushBack(data[a++]);
+          }
+          else
+          {
+            auto& sortableRenderData = m_TempSortableRenderData.ExpandAndGetRef();
+            sortableRenderData.m_pRenderData = staticData[b].m_pRenderData;
+            sortableRenderData.m_uiSortingKey = staticData[b].m_uiSortingKey;
+            ++b;
+          }
+        }
+
+        data.Swap(m_TempSortableRenderData);
+      }
     }
-  };
 
-  for (auto& dataPerCategory : m_DataPerCategory)
-  {
-    if (dataPerCategory.m_SortableRenderData.IsEmpty())
+    if (data.IsEmpty())
       continue;
 
-    auto& data = dataPerCategory.m_SortableRenderData;
-
-    // Sort
-    data.Sort(RenderDataComparer());
+    if (cvar_RenderingAutoInstancing && ezRenderData::GetCategoryFlags(ezRenderData::Category(static_cast<ezUInt16>(uiCategory))).IsSet(ezRenderData::CategoryFlags::GroupBatches))
+    {
+      GroupBatches(data);
+    }
 
     // Find batches
     ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
@@ -67,6 +289,98 @@ void ezExtractedRenderData::SortAndBatch()
 
     dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
   }
+
+  m_pStaticRenderData = nullptr;
+}
+
+void ezExtractedRenderData::GroupBatches(ezDynamicArray<ezRenderDataBatch::SortableRenderData>& ref_data)
+{
+  // Render data with the same batch id only ends up in one batch if sorting places it next to each other. That isn't the case if the
+  // sorting key doesn't identify the batch, e.g. through hash collisions or sorting keys that only contain the material.
+  // Every run of equal batch id and type gets a group, runs with the same batch id and type share the group.
+  m_BatchGroups.Clear();
+  m_BatchGroupTypes.Clear();
+  m_BatchGroupOffsets.Clear();
+  m_RunGroups.Clear();
+
+  auto IsSameBatch = [](const ezRenderData* a, const ezRenderData* b)
+  {
+    return a->m_uiBatchId == b->m_uiBatchId && a->GetDynamicRTTI() == b->GetDynamicRTTI();
+  };
+
+  const ezUInt32 uiCount = ref_data.GetCount();
+  bool bAnyBatchSplit = false;
+
+  for (ezUInt32 uiRunStart = 0; uiRunStart < uiCount;)
+  {
+    const ezRenderData* pRenderData = ref_data[uiRunStart].m_pRenderData;
+
+    ezUInt32 uiRunEnd = uiRunStart + 1;
+    while (uiRunEnd < uiCount && IsSameBatch(ref_data[uiRunEnd].m_pRenderData, pRenderData))
+    {
+      ++uiRunEnd;
+    }
+
+    const ezRTTI* pType = pRenderData->GetDynamicRTTI();
+    ezUInt32 uiTypeIndex = m_BatchGroupTypes.IndexOf(pType);
+    if (uiTypeIndex == ezInvalidIndex)
+    {
+      uiTypeIndex = m_BatchGroupTypes.GetCount();
+      m_BatchGroupTypes.PushBack(pType);
+    }
+
+    const ezUInt64 uiKey = (static_cast<ezUInt64>(uiTypeIndex) << 32) | pRenderData->m_uiBatchId;
+
+    ezUInt32 uiGroup = 0;
+    if (m_BatchGroups.TryGetValue(uiKey, uiGroup))
+    {
+      bAnyBatchSplit = true;
+    }
+    else
+    {
+      uiGroup = m_BatchGroupOffsets.GetCount();
+      m_BatchGroups.Insert(uiKey, uiGroup);
+      m_BatchGroupOffsets.PushBack(0);
+    }
+
+    m_BatchGroupOffsets[uiGroup] += uiRunEnd - uiRunStart;
+    m_RunGroups.PushBack(uiGroup);
+
+    uiRunStart = uiRunEnd;
+  }
+
+  if (!bAnyBatchSplit)
+    return;
+
+  EZ_PROFILE_SCOPE("GroupBatches");
+
+  // The groups keep the order of their first occurrence, the data within a group keeps its sorted order.
+  ezUInt32 uiOffset = 0;
+  for (ezUInt32& uiGroupOffset : m_BatchGroupOffsets)
+  {
+    const ezUInt32 uiGroupCount = uiGroupOffset;
+    uiGroupOffset = uiOffset;
+    uiOffset += uiGroupCount;
+  }
+
+  m_TempSortableRenderData.SetCountUninitialized(uiCount);
+
+  ezUInt32 uiRunIndex = 0;
+  for (ezUInt32 uiRunStart = 0; uiRunStart < uiCount; ++uiRunIndex)
+  {
+    const ezRenderData* pRenderData = ref_data[uiRunStart].m_pRenderData;
+    ezUInt32& uiGroupOffset = m_BatchGroupOffsets[m_RunGroups[uiRunIndex]];
+
+    ezUInt32 i = uiRunStart;
+    do
+    {
+      m_TempSortableRenderData[uiGroupOffset++] = ref_data[i++];
+    } while (i < uiCount && IsSameBatch(ref_data[i].m_pRenderData, pRenderData));
+
+    uiRunStart = i;
+  }
+
+  ref_data.Swap(m_TempSortableRenderData);
 }
 
 void ezExtractedRenderData::Clear()
@@ -78,6 +392,7 @@ void ezExtractedRenderData::Clear()
   }
 
   m_FrameData.Clear();
+  m_pStaticRenderData = nullptr;
 
   // TODO: intelligent compact
 }
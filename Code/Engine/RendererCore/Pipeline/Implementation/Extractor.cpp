@@ -4,6 +4,7 @@
 #include <Core/World/World.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/TypeVersionContext.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/Extractor.h>
@@ -21,6 +22,13 @@ ezCVarString cvar_SpatialVisDataOnlyObject("Spatial.VisData.OnlyObject", "", ezC
 ezCVarBool cvar_SpatialExtractionShowStats("Spatial.Extraction.ShowStats", false, ezCVarFlags::Default, "Display some stats of the render data extraction");
 #endif
 
+ezCVarInt cvar_RenderingExtractionMinObjectsPerTask("Rendering.Extraction.MinObjectsPerTask", 256, ezCVarFlags::Default, "Minimum number of visible objects that are extracted by one task. Views with fewer objects are extracted serially.");
+
+ezCVarBool cvar_RenderingCachingStaticRenderList("Rendering.Caching.StaticRenderList", true, ezCVarFlags::Default, "Keeps the sorted render data of visible static objects across frames and only applies visibility changes");
+
+extern ezCVarBool cvar_RenderingMultithreading;
+extern ezCVarBool cvar_RenderingCachingStaticObjects;
+
 namespace
 {
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -160,7 +168,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
     }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    m_uiNumUncachedRenderData += msg.m_ExtractedRenderData.GetCount();
+    m_uiNumUncachedRenderData.Add(msg.m_ExtractedRenderData.GetCount());
 #endif
   };
 
@@ -196,7 +204,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
           extractedRenderData.AddRenderData(cacheEntry.m_pRenderData, msg.m_OverrideCategory != ezInvalidRenderDataCategory ? msg.m_OverrideCategory : ezRenderData::Category(cacheEntry.m_uiCategory));
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-          ++m_uiNumCachedRenderData;
+          m_uiNumCachedRenderData.Increment();
 #endif
         }
         ++uiCacheIndex;
@@ -291,9 +299,103 @@ ezResult ezExtractor::Deserialize(ezStreamReader& inout_stream)
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezVisibleObjectsExtractor, 1, ezRTTIDefaultAllocator<ezVisibleObjectsExtractor>)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 
+struct ezVisibleObjectsExtractor::StaticRenderListState
+{
+  struct VisibleObject
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const ezGameObject* m_pObject;
+    ezGameObjectHandle m_hObject;
+    ezUInt16 m_uiComponentVersion;
+    bool m_bInRenderList;
+    bool m_bHasInactiveExtractors; ///< Activating a component doesn't change the component version, so these objects are checked every frame.
+  };
+
+  void Reset()
+  {
+    m_RenderList.Clear();
+    m_VisibleObjects.Clear();
+    m_pWorld = nullptr;
+  }
+
+  ezStaticRenderDataList m_RenderList;
+
+  // The visible static objects of the last frame in the order of the visibility query.
+  ezDynamicArray<VisibleObject> m_VisibleObjects;
+  ezDynamicArray<VisibleObject> m_NewVisibleObjects;
+  ezHashTable<ezGameObjectHandle, ezUInt32> m_PreviousObjectIndices;
+  ezDynamicArray<bool> m_PreviousObjectKept;
+  ezDynamicArray<ezGameObjectHandle> m_DeletedCacheOwners;
+  ezHashSet<ezGameObjectHandle> m_DeletedCacheOwnerSet;
+
+  const ezWorld* m_pWorld = nullptr;
+  ezViewHandle m_hView;
+};
+
+namespace
+{
+  /// Returns whether every active component of the object that extracts render data has cached render data.
+  /// Components that don't handle ezMsgExtractRenderData or are inactive don't contribute anything and thus don't need a cache entry.
+  bool IsCacheComplete(const ezGameObject* pObject, ezArrayPtr<const ezInternal::RenderDataCacheEntry> cachedRenderData, bool& out_bHasInactiveExtractors)
+  {
+    out_bHasInactiveExtractors = false;
+
+    ezUInt32 uiCacheIndex = 0;
+    auto components = pObject->GetComponents();
+    const ezUInt32 uiNumComponents = components.GetCount();
+    for (ezUInt32 uiComponentIndex = 0; uiComponentIndex < uiNumComponents; ++uiComponentIndex)
+    {
+      bool bCacheFound = false;
+      while (uiCacheIndex < cachedRenderData.GetCount() && cachedRenderData[uiCacheIndex].m_uiComponentIndex == uiComponentIndex)
+      {
+        ++uiCacheIndex;
+        bCacheFound = true;
+      }
+
+      if (bCacheFound)
+        continue;
+
+      const ezComponent* pComponent = components[uiComponentIndex];
+      if (!pComponent->GetDynamicRTTI()->CanHandleMessage<ezMsgExtractRenderData>())
+        continue;
+
+      if (!pComponent->IsActiveAndInitialized())
+      {
+        out_bHasInactiveExtractors = true;
+        continue;
+      }
+
+      // Would need to be extracted every frame, see ezExtractor::ExtractRenderData.
+      return false;
+    }
+
+    return true;
+  }
+
+  /// Adds the cached render data of the object to the list, if its cache is complete.
+  bool AddCachedRenderData(const ezView& view, const ezGameObject* pObject, ezUInt16 uiComponentVersion, ezStaticRenderDataList& ref_renderList, bool& out_bHasInactiveExtractors)
+  {
+    auto cachedRenderData = ezRenderWorld::GetCachedRenderData(view, pObject->GetHandle(), uiComponentVersion);
+    if (!IsCacheComplete(pObject, cachedRenderData, out_bHasInactiveExtractors))
+      return false;
+
+    for (auto& cacheEntry : cachedRenderData)
+    {
+      if (cacheEntry.m_pRenderData != nullptr)
+      {
+        ref_renderList.AddRenderData(pObject->GetHandle(), cacheEntry.m_pRenderData, ezRenderData::Category(cacheEntry.m_uiCategory));
+      }
+    }
+
+    return true;
+  }
+} // namespace
+
 ezVisibleObjectsExtractor::ezVisibleObjectsExtractor(const char* szName)
   : ezExtractor(szName)
 {
+  m_pStaticRenderList = EZ_DEFAULT_NEW(StaticRenderListState);
 }
 
 ezVisibleObjectsExtractor::~ezVisibleObjectsExtractor() = default;
@@ -301,9 +403,6 @@ ezVisibleObjectsExtractor::~ezVisibleObjectsExtractor() = default;
 void ezVisibleObjectsExtractor::Extract(
   const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& ref_extractedRenderData)
 {
-  ezMsgExtractRenderData msg;
-  msg.m_pView = &view;
-
   EZ_LOCK(view.GetWorld()->GetReadMarker());
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -313,21 +412,77 @@ void ezVisibleObjectsExtractor::Extract(
   m_uiNumUncachedRenderData = 0;
 #endif
 
-  for (auto pObject : visibleObjects)
+  bool bUseStaticRenderList = cvar_RenderingCachingStaticRenderList && cvar_RenderingCachingStaticObjects;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  // The debug visualization needs to see every extracted object.
+  bUseStaticRenderList = bUseStaticRenderList && !cvar_SpatialVisBounds && !cvar_SpatialVisLocalBBox && !cvar_SpatialVisData;
+#endif
+
+  ezArrayPtr<const ezGameObject* const> objectsToExtract = visibleObjects;
+  if (bUseStaticRenderList)
   {
-    ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+    UpdateStaticRenderList(view, visibleObjects, ref_extractedRenderData);
+    objectsToExtract = m_ObjectsToExtract;
+  }
+  else
+  {
+    m_pStaticRenderList->Reset();
+  }
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (cvar_SpatialVisBounds || cvar_SpatialVisLocalBBox || cvar_SpatialVisData)
+  const ezUInt32 uiNumObjects = objectsToExtract.GetCount();
+  const ezUInt32 uiMinObjectsPerTask = static_cast<ezUInt32>(ezMath::Max(cvar_RenderingExtractionMinObjectsPerTask.GetValue(), 1));
+
+  ezUInt32 uiNumChunks = 1;
+  if (cvar_RenderingMultithreading)
+  {
+    const ezUInt32 uiMaxChunks = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) * 2;
+    uiNumChunks = ezMath::Clamp(uiNumObjects / uiMinObjectsPerTask, 1u, ezMath::Max(uiMaxChunks, 1u));
+  }
+
+  if (uiNumChunks == 1)
+  {
+    ExtractChunk(view, objectsToExtract, ref_extractedRenderData);
+  }
+  else
+  {
+    EZ_PROFILE_SCOPE("Parallel Extraction");
+
+    while (m_ChunkData.GetCount() < uiNumChunks)
     {
-      if ((cvar_SpatialVisDataOnlyObject.GetValue().IsEmpty() ||
-            pObject->GetName().FindSubString_NoCase(cvar_SpatialVisDataOnlyObject.GetValue()) != nullptr) &&
-          !cvar_SpatialVisDataOnlySelected)
+      m_ChunkData.PushBack(EZ_DEFAULT_NEW(ezExtractedRenderData));
+    }
+
+    const ezUInt32 uiObjectsPerChunk = (uiNumObjects + uiNumChunks - 1) / uiNumChunks;
+
+    // The sorting keys depend on the camera, so every bucket needs the same one as the view's data.
+    for (ezUInt32 i = 0; i < uiNumChunks; ++i)
+    {
+      m_ChunkData[i]->Clear();
+      m_ChunkData[i]->SetCamera(ref_extractedRenderData.GetCamera());
+    }
+
+    // The world stays locked for reading by this thread while the tasks are running.
+    auto extractChunks = [&](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk)
+    {
+      for (ezUInt32 uiChunk = uiStartChunk; uiChunk < uiEndChunk; ++uiChunk)
       {
-        VisualizeObject(view, pObject);
+        const ezUInt32 uiFirstObject = uiChunk * uiObjectsPerChunk;
+        const ezUInt32 uiChunkSize = ezMath::Min(uiObjectsPerChunk, uiNumObjects - uiFirstObject);
+
+        ExtractChunk(view, objectsToExtract.GetSubArray(uiFirstObject, uiChunkSize), *m_ChunkData[uiChunk]);
       }
+    };
+
+    ezParallelForParams params;
+    params.m_uiBinSize = 1;
+    params.m_uiMaxTasksPerThread = 2;
+
+    ezTaskSystem::ParallelForIndexed(0u, uiNumChunks, extractChunks, "ExtractVisibleObjects", ezTaskNesting::Never, params);
+
+    for (ezUInt32 i = 0; i < uiNumChunks; ++i)
+    {
+      ref_extractedRenderData.AppendRenderData(*m_ChunkData[i]);
     }
-#endif
   }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -341,15 +496,187 @@ void ezVisibleObjectsExtractor::Extract(
 
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", "Extraction Stats:");
 
-    sb.SetFormat("Num Cached Render Data: {0}", m_uiNumCachedRenderData);
+    sb.SetFormat("Num Cached Render Data: {0}", static_cast<ezInt32>(m_uiNumCachedRenderData));
+    ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", sb);
+
+    sb.SetFormat("Num Uncached Render Data: {0}", static_cast<ezInt32>(m_uiNumUncachedRenderData));
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", sb);
 
-    sb.SetFormat("Num Uncached Render Data: {0}", m_uiNumUncachedRenderData);
+    sb.SetFormat("Num Extraction Tasks: {0}", uiNumChunks);
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", sb);
   }
 #endif
 }
 
+void ezVisibleObjectsExtractor::UpdateStaticRenderList(const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& ref_extractedRenderData)
+{
+  EZ_PROFILE_SCOPE("Update Static Render List");
+
+  StaticRenderListState& state = *m_pStaticRenderList;
+
+  const bool bCacheKnown = state.m_RenderList.RemoveDeletedCachedRenderData(state.m_DeletedCacheOwners);
+  if (!bCacheKnown || state.m_pWorld != view.GetWorld() || state.m_hView != view.GetHandle())
+  {
+    state.Reset();
+    state.m_pWorld = view.GetWorld();
+    state.m_hView = view.GetHandle();
+  }
+
+  m_ObjectsToExtract.Clear();
+  state.m_NewVisibleObjects.Clear();
+
+  for (auto pObject : visibleObjects)
+  {
+    if (pObject->IsStatic())
+    {
+      auto& visibleObject = state.m_NewVisibleObjects.ExpandAndGetRef();
+      visibleObject.m_pObject = pObject;
+      visibleObject.m_hObject = pObject->GetHandle();
+      visibleObject.m_uiComponentVersion = pObject->GetComponentVersion();
+      visibleObject.m_bInRenderList = false;
+      visibleObject.m_bHasInactiveExtractors = false;
+    }
+    else
+    {
+      m_ObjectsToExtract.PushBack(pObject);
+    }
+  }
+
+  auto& previousObjects = state.m_VisibleObjects;
+  auto& currentObjects = state.m_NewVisibleObjects;
+
+  // The visibility query returns objects in a stable order, so usually the list is identical to the one of the last frame.
+  bool bVisibilityChanged = previousObjects.GetCount() != currentObjects.GetCount();
+  for (ezUInt32 i = 0; !bVisibilityChanged && i < currentObjects.GetCount(); ++i)
+  {
+    bVisibilityChanged = previousObjects[i].m_hObject != currentObjects[i].m_hObject || previousObjects[i].m_uiComponentVersion != currentObjects[i].m_uiComponentVersion;
+  }
+
+  if (!bVisibilityChanged)
+  {
+    for (ezUInt32 i = 0; i < currentObjects.GetCount(); ++i)
+    {
+      currentObjects[i].m_bInRenderList = previousObjects[i].m_bInRenderList;
+      currentObjects[i].m_bHasInactiveExtractors = previousObjects[i].m_bHasInactiveExtractors;
+    }
+  }
+  else
+  {
+    EZ_PROFILE_SCOPE("Apply Visibility Changes");
+
+    state.m_PreviousObjectIndices.Clear();
+    state.m_PreviousObjectKept.Clear();
+    state.m_PreviousObjectKept.SetCount(previousObjects.GetCount(), false);
+
+    for (ezUInt32 i = 0; i < previousObjects.GetCount(); ++i)
+    {
+      if (previousObjects[i].m_bInRenderList)
+      {
+        state.m_PreviousObjectIndices.Insert(previousObjects[i].m_hObject, i);
+      }
+    }
+
+    for (auto& visibleObject : currentObjects)
+    {
+      ezUInt32 uiPreviousIndex = 0;
+      if (state.m_PreviousObjectIndices.TryGetValue(visibleObject.m_hObject, uiPreviousIndex) &&
+          previousObjects[uiPreviousIndex].m_uiComponentVersion == visibleObject.m_uiComponentVersion)
+      {
+        visibleObject.m_bInRenderList = true;
+        visibleObject.m_bHasInactiveExtractors = previousObjects[uiPreviousIndex].m_bHasInactiveExtractors;
+        state.m_PreviousObjectKept[uiPreviousIndex] = true;
+      }
+    }
+
+    for (ezUInt32 i = 0; i < previousObjects.GetCount(); ++i)
+    {
+      if (previousObjects[i].m_bInRenderList && !state.m_PreviousObjectKept[i])
+      {
+        state.m_RenderList.RemoveRenderData(previousObjects[i].m_hObject);
+      }
+    }
+  }
+
+  // The list doesn't contain the render data of objects whose cache was deleted anymore, they are added again like new objects.
+  if (!state.m_DeletedCacheOwners.IsEmpty())
+  {
+    state.m_DeletedCacheOwnerSet.Clear();
+    for (const ezGameObjectHandle& hOwner : state.m_DeletedCacheOwners)
+    {
+      state.m_DeletedCacheOwnerSet.Insert(hOwner);
+    }
+
+    for (auto& visibleObject : currentObjects)
+    {
+      if (visibleObject.m_bInRenderList && state.m_DeletedCacheOwnerSet.Contains(visibleObject.m_hObject))
+      {
+        visibleObject.m_bInRenderList = false;
+      }
+    }
+  }
+
+  // Objects that are not completely cached yet are extracted as usual until their render data has been cached.
+  for (auto& visibleObject : currentObjects)
+  {
+    if (visibleObject.m_bInRenderList)
+    {
+      if (!visibleObject.m_bHasInactiveExtractors)
+        continue;
+
+      auto cachedRenderData = ezRenderWorld::GetCachedRenderData(view, visibleObject.m_hObject, visibleObject.m_uiComponentVersion);
+      if (IsCacheComplete(visibleObject.m_pObject, cachedRenderData, visibleObject.m_bHasInactiveExtractors))
+        continue;
+
+      // A component was activated and needs to be extracted until its render data has been cached.
+      state.m_RenderList.RemoveRenderData(visibleObject.m_hObject);
+      visibleObject.m_bInRenderList = false;
+      m_ObjectsToExtract.PushBack(visibleObject.m_pObject);
+      continue;
+    }
+
+    if (AddCachedRenderData(view, visibleObject.m_pObject, visibleObject.m_uiComponentVersion, state.m_RenderList, visibleObject.m_bHasInactiveExtractors))
+    {
+      visibleObject.m_bInRenderList = true;
+    }
+    else
+    {
+      m_ObjectsToExtract.PushBack(visibleObject.m_pObject);
+    }
+  }
+
+  previousObjects.Swap(currentObjects);
+
+  state.m_RenderList.Update(ref_extractedRenderData.GetCamera());
+  ref_extractedRenderData.SetStaticRenderData(&state.m_RenderList);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  m_uiNumCachedRenderData.Add(state.m_RenderList.GetCount());
+#endif
+}
+
+void ezVisibleObjectsExtractor::ExtractChunk(const ezView& view, ezArrayPtr<const ezGameObject* const> objects, ezExtractedRenderData& ref_extractedRenderData) const
+{
+  ezMsgExtractRenderData msg;
+  msg.m_pView = &view;
+
+  for (auto pObject : objects)
+  {
+    ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    if (cvar_SpatialVisBounds || cvar_SpatialVisLocalBBox || cvar_SpatialVisData)
+    {
+      if ((cvar_SpatialVisDataOnlyObject.GetValue().IsEmpty() ||
+            pObject->GetName().FindSubString_NoCase(cvar_SpatialVisDataOnlyObject.GetValue()) != nullptr) &&
+          !cvar_SpatialVisDataOnlySelected)
+      {
+        VisualizeObject(view, pObject);
+      }
+    }
+#endif
+  }
+}
+
 ezResult ezVisibleObjectsExtractor::Serialize(ezStreamWriter& inout_stream) const
 {
   EZ_SUCCEED_OR_RETURN(SUPER::Serialize(inout_stream));
@@ -49,6 +49,12 @@ EZ_FORCE_INLINE ezHashedString ezRenderData::GetCategoryName(Category category)
   return ezHashedString();
 }
 
+// static
+EZ_FORCE_INLINE ezBitflags<ezRenderData::CategoryFlags> ezRenderData::GetCategoryFlags(Category category)
+{
+  return s_CategoryData[category.m_uiValue].m_Flags;
+}
+
 EZ_FORCE_INLINE ezUInt64 ezRenderData::GetCategorySortingKey(Category category, const ezCamera& camera) const
 {
   return s_CategoryData[category.m_uiValue].m_sortingKeyFunc(this, camera);
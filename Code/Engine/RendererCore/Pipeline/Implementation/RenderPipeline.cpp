@@ -1028,15 +1028,12 @@ void ezRenderPipeline::FindVisibleObjects(const ezView& view)
   {
     EZ_PROFILE_SCOPE("Occlusion::FindVisibleObjects");
 
-    auto IsOccluded = [=](const ezSimdBBox& aabb)
-    {
-      // grow the bbox by some percent to counter the lower precision of the occlusion buffer
-
-      const ezSimdVec4f c = aabb.GetCenter();
-      const ezSimdVec4f e = aabb.GetHalfExtents();
-      const ezSimdBBox aabb2 = ezSimdBBox::MakeFromCenterAndHalfExtents(c, e.CompMul(ezSimdVec4f(1.0f + cvar_SpatialCullingOcclusionBoundsInlation)));
+    // grow the bboxes by some percent to counter the lower precision of the occlusion buffer
+    const float fExtentsScale = 1.0f + cvar_SpatialCullingOcclusionBoundsInlation;
 
-      return !pRasterizer->IsVisible(aabb2);
+    auto IsOccluded = [=](ezArrayPtr<const ezSimdBBox> boxes)
+    {
+      return pRasterizer->ComputeOccludedMask(boxes, fExtentsScale);
     };
 
     m_VisibleObjects.Clear();
@@ -36,7 +36,8 @@ EZ_END_DYNAMIC_REFLECTED_TYPE;
 
 ezView::ezView()
 {
-  m_pExtractTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "", ezTaskNesting::Never, ezMakeDelegate(&ezView::ExtractData, this));
+  // Extraction may wait for the tasks of a parallel extraction, see ezVisibleObjectsExtractor.
+  m_pExtractTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "", ezTaskNesting::Maybe, ezMakeDelegate(&ezView::ExtractData, this));
 }
 
 ezView::~ezView() = default;
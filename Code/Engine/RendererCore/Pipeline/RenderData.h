@@ -36,12 +36,32 @@ public:
     };
   };
 
+  struct CategoryFlags
+  {
+    using StorageType = ezUInt8;
+
+    enum Enum
+    {
+      None = 0,
+      GroupBatches = EZ_BIT(0), ///< The render order of data with the same batch id doesn't matter. SortAndBatch moves all of it into one batch, so that it can be rendered with a single instanced draw call.
+
+      Default = None
+    };
+
+    struct Bits
+    {
+      StorageType GroupBatches : 1;
+    };
+  };
+
   /// \brief This function generates a 64bit sorting key for the given render data. Data with lower sorting key is rendered first.
   using SortingKeyFunc = ezUInt64 (*)(const ezRenderData*, const ezCamera&);
 
-  static Category RegisterCategory(const char* szCategoryName, SortingKeyFunc sortingKeyFunc);
+  static Category RegisterCategory(const char* szCategoryName, SortingKeyFunc sortingKeyFunc, ezBitflags<CategoryFlags> flags = CategoryFlags::Default);
   static Category FindCategory(ezTempHashedString sCategoryName);
 
+  static ezBitflags<CategoryFlags> GetCategoryFlags(Category category);
+
   static void GetAllCategoryNames(ezDynamicArray<ezHashedString>& out_categoryNames);
 
   static const ezRenderer* GetCategoryRenderer(Category category, const ezRTTI* pRenderDataType);
@@ -76,6 +96,7 @@ private:
   {
     ezHashedString m_sName;
     SortingKeyFunc m_sortingKeyFunc;
+    ezBitflags<CategoryFlags> m_Flags;
 
     ezHashTable<const ezRTTI*, ezUInt32> m_TypeToRendererIndex;
   };
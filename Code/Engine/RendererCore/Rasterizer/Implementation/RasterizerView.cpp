@@ -5,13 +5,32 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdBBox.h>
 #include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Rasterizer/RasterizerObject.h>
 #include <RendererCore/Rasterizer/RasterizerView.h>
 #include <RendererCore/Rasterizer/Thirdparty/Occluder.h>
 #include <RendererCore/Rasterizer/Thirdparty/Rasterizer.h>
 
 ezCVarInt cvar_SpatialCullingOcclusionMaxResolution("Spatial.Occlusion.MaxResolution", 512, ezCVarFlags::Default, "Max resolution for occlusion buffers.");
-ezCVarInt cvar_SpatialCullingOcclusionMaxOccluders("Spatial.Occlusion.MaxOccluders", 64, ezCVarFlags::Default, "Max number of occluders to rasterize per frame.");
+ezCVarInt cvar_SpatialCullingOcclusionMaxOccluders("Spatial.Occlusion.MaxOccluders", 64, ezCVarFlags::Default, "Max number of occluders to rasterize per frame. Occluders that cover more of the screen are preferred.");
+ezCVarFloat cvar_SpatialCullingOcclusionMinScreenSize("Spatial.Occlusion.MinScreenSize", 0.001f, ezCVarFlags::Default, "Occluders that cover less than this fraction of the screen are not rasterized.");
+ezCVarBool cvar_SpatialCullingOcclusionMultithreaded("Spatial.Occlusion.Multithreaded", true, ezCVarFlags::Default, "Rasterize horizontal bands of the occlusion buffer in parallel.");
+
+// Every band should have a few block rows, otherwise walking the binned occluders of each band dominates.
+static constexpr ezUInt32 s_uiMinBlockRowsPerBand = 4;
+
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+struct ezRasterizerView::BinnedPrimitives
+{
+  /// The primitives of all selected occluders. Each occluder owns the range starting at PreparedOccluder::m_uiFirstPrimitive.
+  ezDynamicArray<Rasterizer::Primitive, ezAlignedAllocatorWrapper> m_Primitives;
+  ezDynamicArray<Band> m_Bands;
+};
+#else
+struct ezRasterizerView::BinnedPrimitives
+{
+};
+#endif
 
 ezRasterizerView::ezRasterizerView() = default;
 ezRasterizerView::~ezRasterizerView() = default;
@@ -59,83 +78,281 @@ void ezRasterizerView::EndScene()
 
   EZ_PROFILE_SCOPE("Occlusion::RasterizeScene");
 
-  SortObjectsFrontToBack();
-
   UpdateViewProjectionMatrix();
 
-  // only rasterize a limited number of the closest objects
-  RasterizeObjects(cvar_SpatialCullingOcclusionMaxOccluders);
+  // only rasterize a limited number of the largest objects
+  SelectOccluders(cvar_SpatialCullingOcclusionMaxOccluders);
+
+  RasterizeOccluders();
 
   m_Instances.Clear();
+  m_Occluders.Clear();
 
   m_pRasterizer->setModelViewProjection(m_mViewProjection.m_fElementsCM);
 }
 
-void ezRasterizerView::RasterizeObjects(ezUInt32 uiMaxObjects)
+void ezRasterizerView::SelectOccluders(ezUInt32 uiMaxOccluders)
 {
 #if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+  EZ_PROFILE_SCOPE("Occlusion::SelectOccluders");
 
-  EZ_PROFILE_SCOPE("Occlusion::RasterizeObjects");
+  const ezVec3 camPos = m_pCamera->GetCenterPosition();
+  const float fScreenArea = float(m_uiResolutionX * m_uiResolutionY);
+  const float fMinScreenArea = fScreenArea * cvar_SpatialCullingOcclusionMinScreenSize;
+
+  m_Occluders.Clear();
+  m_Occluders.Reserve(m_Instances.GetCount());
 
   for (const Instance& inst : m_Instances)
   {
-    ApplyModelViewProjectionMatrix(inst.m_Transform);
-
-    bool bNeedsClipping;
+    const ezMat4 mMVP = m_mViewProjection * inst.m_Transform.GetAsMat4();
     const Occluder& occluder = inst.m_pObject->m_Occluder;
 
-    if (m_pRasterizer->queryVisibility(occluder.m_boundsMin, occluder.m_boundsMax, bNeedsClipping))
+    PreparedOccluder& occ = m_Occluders.ExpandAndGetRef();
+    occ.m_pObject = inst.m_pObject;
+    occ.m_fDistanceSquared = (inst.m_Transform.m_vPosition - camPos).GetLengthSquared();
+
+    m_pRasterizer->bakeModelViewProjection(mMVP.m_fElementsCM, occ.m_BakedMatrix);
+
+    if (!m_pRasterizer->projectBounds(occ.m_BakedMatrix, occluder.m_boundsMin, occluder.m_boundsMax, occ.m_bNeedsClipping, occ.m_ScreenBounds, occ.m_uiMaxZ))
     {
-      m_bAnyOccludersRasterized = true;
+      // not on screen
+      m_Occluders.PopBack();
+      continue;
+    }
 
-      if (bNeedsClipping)
-      {
-        m_pRasterizer->rasterize<true>(occluder);
-      }
-      else
-      {
-        m_pRasterizer->rasterize<false>(occluder);
-      }
+    if (occ.m_bNeedsClipping)
+    {
+      // intersects the near plane, so it is right in front of the camera and may cover the entire screen
+      occ.m_fScreenArea = fScreenArea;
+      occ.m_ScreenBounds[0] = 0;
+      occ.m_ScreenBounds[1] = m_uiResolutionX - 1;
+      occ.m_ScreenBounds[2] = 0;
+      occ.m_ScreenBounds[3] = m_uiResolutionY - 1;
+      continue;
+    }
 
-      if (--uiMaxObjects == 0)
-        return;
+    occ.m_fScreenArea = float(occ.m_ScreenBounds[1] - occ.m_ScreenBounds[0] + 1) * float(occ.m_ScreenBounds[3] - occ.m_ScreenBounds[2] + 1);
+
+    if (occ.m_fScreenArea < fMinScreenArea)
+    {
+      // too small to hide anything worth culling
+      m_Occluders.PopBack();
+      continue;
     }
   }
+
+  if (m_Occluders.GetCount() > uiMaxOccluders)
+  {
+    m_Occluders.Sort([](const PreparedOccluder& a, const PreparedOccluder& b)
+      { return a.m_fScreenArea > b.m_fScreenArea; });
+
+    m_Occluders.SetCount(uiMaxOccluders);
+  }
+
+  // rasterizing front to back allows to skip occluders that are hidden by closer ones
+  m_Occluders.Sort([](const PreparedOccluder& a, const PreparedOccluder& b)
+    { return a.m_fDistanceSquared < b.m_fDistanceSquared; });
 #endif
 }
 
-void ezRasterizerView::UpdateViewProjectionMatrix()
+void ezRasterizerView::RasterizeOccluders()
 {
-  ezMat4 mProjection;
-  m_pCamera->GetProjectionMatrix(m_fAspectRation, mProjection, ezCameraEye::Left, ezClipSpaceDepthRange::ZeroToOne);
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+  if (m_Occluders.IsEmpty())
+    return;
 
-  m_mViewProjection = mProjection * m_pCamera->GetViewMatrix();
+  EZ_PROFILE_SCOPE("Occlusion::RasterizeObjects");
+
+  if (m_pBinnedPrimitives == nullptr)
+  {
+    m_pBinnedPrimitives = EZ_DEFAULT_NEW(BinnedPrimitives);
+  }
+
+  // The screen is split into horizontal bands of 8x8 pixel blocks. The bands don't share any memory, so they can be rasterized in parallel.
+  const ezUInt32 uiBlocksY = m_pRasterizer->getBlocksY();
+
+  ezUInt32 uiNumBands = 1;
+  if (cvar_SpatialCullingOcclusionMultithreaded)
+  {
+    uiNumBands = ezMath::Min(ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks), uiBlocksY / s_uiMinBlockRowsPerBand);
+    uiNumBands = ezMath::Max(uiNumBands, 1u);
+  }
+
+  SetupPrimitives();
+  BinPrimitives(uiNumBands);
+
+  ezAtomicInteger32 iNumRasterized;
+
+  auto rasterizeBands = [&](ezUInt32 uiStartBand, ezUInt32 uiEndBand)
+  {
+    for (ezUInt32 uiBand = uiStartBand; uiBand < uiEndBand; ++uiBand)
+    {
+      iNumRasterized.Add(RasterizeBand(uiBand));
+    }
+  };
+
+  if (uiNumBands > 1)
+  {
+    ezParallelForParams params;
+    params.m_uiBinSize = 1;
+    params.m_uiMaxTasksPerThread = 1;
+
+    ezTaskSystem::ParallelForIndexed(0u, uiNumBands, rasterizeBands, "RasterizeOcclusionBands", ezTaskNesting::Never, params);
+  }
+  else
+  {
+    rasterizeBands(0, 1);
+  }
+
+  m_bAnyOccludersRasterized = iNumRasterized > 0;
+#endif
 }
 
-void ezRasterizerView::ApplyModelViewProjectionMatrix(const ezTransform& modelTransform)
+void ezRasterizerView::SetupPrimitives()
 {
-  const ezMat4 mModel = modelTransform.GetAsMat4();
-  const ezMat4 mMVP = m_mViewProjection * mModel;
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+  EZ_PROFILE_SCOPE("Occlusion::SetupPrimitives");
+
+  // every occluder gets a range for the maximum number of primitives it can produce, so they can be set up in parallel
+  ezUInt32 uiMaxPrimitives = 0;
+  for (PreparedOccluder& occ : m_Occluders)
+  {
+    occ.m_uiFirstPrimitive = uiMaxPrimitives;
+    uiMaxPrimitives += Rasterizer::getMaxPrimitiveCount(occ.m_pObject->m_Occluder);
+  }
+
+  auto& primitives = m_pBinnedPrimitives->m_Primitives;
+  primitives.SetCountUninitialized(uiMaxPrimitives);
+
+  auto setupOccluders = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+  {
+    for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+    {
+      PreparedOccluder& occ = m_Occluders[i];
+      Rasterizer::Primitive* pPrimitives = primitives.GetData() + occ.m_uiFirstPrimitive;
 
-  m_pRasterizer->setModelViewProjection(mMVP.m_fElementsCM);
+      if (occ.m_bNeedsClipping)
+        occ.m_uiNumPrimitives = m_pRasterizer->setupPrimitives<true>(occ.m_pObject->m_Occluder, occ.m_BakedMatrix, pPrimitives);
+      else
+        occ.m_uiNumPrimitives = m_pRasterizer->setupPrimitives<false>(occ.m_pObject->m_Occluder, occ.m_BakedMatrix, pPrimitives);
+    }
+  };
+
+  if (cvar_SpatialCullingOcclusionMultithreaded)
+  {
+    ezTaskSystem::ParallelForIndexed(0u, m_Occluders.GetCount(), setupOccluders, "SetupOcclusionPrimitives");
+  }
+  else
+  {
+    setupOccluders(0, m_Occluders.GetCount());
+  }
+#endif
 }
 
-void ezRasterizerView::SortObjectsFrontToBack()
+void ezRasterizerView::BinPrimitives(ezUInt32 uiNumBands)
 {
 #if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
-  EZ_PROFILE_SCOPE("Occlusion::SortObjects");
+  EZ_PROFILE_SCOPE("Occlusion::BinPrimitives");
 
-  const ezVec3 camPos = m_pCamera->GetCenterPosition();
+  const ezUInt32 uiBlocksY = m_pRasterizer->getBlocksY();
+
+  auto& bands = m_pBinnedPrimitives->m_Bands;
+  bands.SetCount(uiNumBands);
+
+  for (ezUInt32 uiBand = 0; uiBand < uiNumBands; ++uiBand)
+  {
+    Band& band = bands[uiBand];
+    band.m_uiBlockMinY = uiBand * uiBlocksY / uiNumBands;
+    band.m_uiBlockMaxY = (uiBand + 1) * uiBlocksY / uiNumBands;
+    band.m_PrimitiveIndices.Clear();
+    band.m_Occluders.Clear();
+  }
 
-  m_Instances.Sort([&](const Instance& i1, const Instance& i2)
+  // inverse of the band start computation above
+  auto GetBandOfBlockRow = [&](ezUInt32 uiBlockY)
+  {
+    return ezMath::Min(((uiBlockY + 1) * uiNumBands - 1) / uiBlocksY, uiNumBands - 1);
+  };
+
+  const Rasterizer::Primitive* pPrimitives = m_pBinnedPrimitives->m_Primitives.GetData();
+
+  // occluders are visited front to back, so every band keeps that order
+  for (ezUInt32 uiOccluder = 0; uiOccluder < m_Occluders.GetCount(); ++uiOccluder)
+  {
+    const PreparedOccluder& occ = m_Occluders[uiOccluder];
+
+    for (ezUInt32 uiPrimitive = occ.m_uiFirstPrimitive; uiPrimitive < occ.m_uiFirstPrimitive + occ.m_uiNumPrimitives; ++uiPrimitive)
     {
-      const float d1 = (i1.m_Transform.m_vPosition - camPos).GetLengthSquared();
-      const float d2 = (i2.m_Transform.m_vPosition - camPos).GetLengthSquared();
+      const Rasterizer::Primitive& primitive = pPrimitives[uiPrimitive];
+      const ezUInt32 uiFirstBand = GetBandOfBlockRow(primitive.m_blockMinY);
+      const ezUInt32 uiLastBand = GetBandOfBlockRow(primitive.m_blockMinY + primitive.m_blockRangeY - 1);
+
+      for (ezUInt32 uiBand = uiFirstBand; uiBand <= uiLastBand; ++uiBand)
+      {
+        Band& band = bands[uiBand];
 
-      return d1 < d2; });
+        if (band.m_Occluders.IsEmpty() || band.m_Occluders.PeekBack().m_uiOccluder != uiOccluder)
+        {
+          BinnedOccluder& binned = band.m_Occluders.ExpandAndGetRef();
+          binned.m_uiOccluder = uiOccluder;
+          binned.m_uiFirstIndex = band.m_PrimitiveIndices.GetCount();
+        }
+
+        band.m_PrimitiveIndices.PushBack(uiPrimitive);
+        band.m_Occluders.PeekBack().m_uiNumIndices++;
+      }
+    }
+  }
 #endif
 }
 
+ezUInt32 ezRasterizerView::RasterizeBand(ezUInt32 uiBand)
+{
+  ezUInt32 uiNumRasterized = 0;
+
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+  const Band& band = m_pBinnedPrimitives->m_Bands[uiBand];
+  const Rasterizer::Primitive* pPrimitives = m_pBinnedPrimitives->m_Primitives.GetData();
+
+  const ezUInt32 uiMinY = band.m_uiBlockMinY * 8;
+  const ezUInt32 uiMaxY = band.m_uiBlockMaxY * 8 - 1;
+
+  for (const BinnedOccluder& binned : band.m_Occluders)
+  {
+    const PreparedOccluder& occ = m_Occluders[binned.m_uiOccluder];
+    const ezUInt32* pIndices = band.m_PrimitiveIndices.GetData() + binned.m_uiFirstIndex;
+
+    if (occ.m_bNeedsClipping)
+    {
+      m_pRasterizer->rasterizePrimitives<true>(pPrimitives, pIndices, binned.m_uiNumIndices, band.m_uiBlockMinY, band.m_uiBlockMaxY);
+      ++uiNumRasterized;
+      continue;
+    }
+
+    // skip occluders that are already hidden by closer ones, within this band
+    const ezUInt32 uiOccluderMinY = ezMath::Max(occ.m_ScreenBounds[2], uiMinY);
+    const ezUInt32 uiOccluderMaxY = ezMath::Min(occ.m_ScreenBounds[3], uiMaxY);
+    if (uiOccluderMinY <= uiOccluderMaxY && !m_pRasterizer->query2D(occ.m_ScreenBounds[0], occ.m_ScreenBounds[1], uiOccluderMinY, uiOccluderMaxY, occ.m_uiMaxZ))
+      continue;
+
+    m_pRasterizer->rasterizePrimitives<false>(pPrimitives, pIndices, binned.m_uiNumIndices, band.m_uiBlockMinY, band.m_uiBlockMaxY);
+    ++uiNumRasterized;
+  }
+#endif
+
+  return uiNumRasterized;
+}
+
+
+void ezRasterizerView::UpdateViewProjectionMatrix()
+{
+  ezMat4 mProjection;
+  m_pCamera->GetProjectionMatrix(m_fAspectRation, mProjection, ezCameraEye::Left, ezClipSpaceDepthRange::ZeroToOne);
+
+  m_mViewProjection = mProjection * m_pCamera->GetViewMatrix();
+}
+
 bool ezRasterizerView::IsVisible(const ezSimdBBox& aabb) const
 {
 #if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
@@ -159,6 +376,45 @@ bool ezRasterizerView::IsVisible(const ezSimdBBox& aabb) const
 #endif
 }
 
+ezUInt32 ezRasterizerView::ComputeOccludedMask(ezArrayPtr<const ezSimdBBox> boxes, float fExtentsScale) const
+{
+  EZ_ASSERT_DEBUG(boxes.GetCount() <= 32, "Only up to 32 boxes can be checked at once.");
+
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+  if (!m_bAnyOccludersRasterized)
+    return 0; // assume that people already do frustum culling anyway
+
+  // no profiling scope, this is called for every batch of 32 objects, the caller covers the whole query instead
+  const ezSimdVec4f vScale(fExtentsScale);
+
+  // the SW rasterizer requires W to be 1
+  __m128 boundsMin[32];
+  __m128 boundsMax[32];
+
+  for (ezUInt32 i = 0; i < boxes.GetCount(); ++i)
+  {
+    const ezSimdVec4f vCenter = boxes[i].GetCenter();
+    const ezSimdVec4f vHalfExtents = boxes[i].GetHalfExtents().CompMul(vScale);
+
+    ezSimdVec4f vmin = vCenter - vHalfExtents;
+    ezSimdVec4f vmax = vCenter + vHalfExtents;
+    vmin.SetW(1);
+    vmax.SetW(1);
+
+    boundsMin[i] = vmin.m_v;
+    boundsMax[i] = vmax.m_v;
+  }
+
+  const ezUInt32 uiVisibleMask = m_pRasterizer->queryVisibilityBatch(boundsMin, boundsMax, boxes.GetCount());
+  const ezUInt32 uiBoxMask = static_cast<ezUInt32>((ezUInt64(1) << boxes.GetCount()) - 1);
+  const ezUInt32 uiOccludedMask = ~uiVisibleMask & uiBoxMask;
+
+  return uiOccludedMask;
+#else
+  return 0;
+#endif
+}
+
 ezRasterizerView* ezRasterizerViewPool::GetRasterizerView(ezUInt32 uiWidth, ezUInt32 uiHeight, float fAspectRatio)
 {
   EZ_PROFILE_SCOPE("Occlusion::GetViewFromPool");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Math/Transform.h>
 #include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/ArrayPtr.h>
@@ -56,6 +57,12 @@ public:
   /// Note: This only works after EndScene().
   bool IsVisible(const ezSimdBBox& aabb) const;
 
+  /// \brief Checks up to 32 boxes at once and returns a bit mask in which bit i is set if boxes[i] is fully occluded.
+  ///
+  /// The half extents of all boxes are scaled by fExtentsScale first, to counter the low resolution of the occlusion buffer.
+  /// Note: This only works after EndScene().
+  ezUInt32 ComputeOccludedMask(ezArrayPtr<const ezSimdBBox> boxes, float fExtentsScale = 1.0f) const;
+
   /// \brief Wether any occluder was actually added and also rasterized. If not, no need to do any visibility checks.
   bool HasRasterizedAnyOccluders() const
   {
@@ -63,10 +70,12 @@ public:
   }
 
 private:
-  void SortObjectsFrontToBack();
-  void RasterizeObjects(ezUInt32 uiMaxObjects);
+  void SelectOccluders(ezUInt32 uiMaxOccluders);
+  void RasterizeOccluders();
+  void SetupPrimitives();
+  void BinPrimitives(ezUInt32 uiNumBands);
+  ezUInt32 RasterizeBand(ezUInt32 uiBand);
   void UpdateViewProjectionMatrix();
-  void ApplyModelViewProjectionMatrix(const ezTransform& modelTransform);
 
   bool m_bAnyOccludersRasterized = false;
   const ezCamera* m_pCamera = nullptr;
@@ -83,6 +92,42 @@ private:
 
   ezDeque<Instance> m_Instances;
   ezMat4 m_mViewProjection;
+
+  /// An instance that was projected to the screen and selected for rasterization.
+  struct PreparedOccluder
+  {
+    float m_BakedMatrix[16];
+    const ezRasterizerObject* m_pObject = nullptr;
+    float m_fDistanceSquared = 0.0f;
+    float m_fScreenArea = 0.0f;
+    ezUInt32 m_ScreenBounds[4]; ///< Min x, max x, min y and max y in pixels.
+    ezUInt16 m_uiMaxZ = 0;
+    bool m_bNeedsClipping = false;
+    ezUInt32 m_uiFirstPrimitive = 0;
+    ezUInt32 m_uiNumPrimitives = 0;
+  };
+
+  ezDynamicArray<PreparedOccluder> m_Occluders;
+
+  /// The primitives of one occluder that overlap a band.
+  struct BinnedOccluder
+  {
+    ezUInt32 m_uiOccluder = 0;
+    ezUInt32 m_uiFirstIndex = 0;
+    ezUInt32 m_uiNumIndices = 0;
+  };
+
+  /// A horizontal range of block rows with the primitives that overlap it, grouped by occluder in front to back order.
+  struct Band
+  {
+    ezUInt32 m_uiBlockMinY = 0;
+    ezUInt32 m_uiBlockMaxY = 0;
+    ezDynamicArray<ezUInt32> m_PrimitiveIndices;
+    ezDynamicArray<BinnedOccluder> m_Occluders;
+  };
+
+  struct BinnedPrimitives;
+  ezUniquePtr<BinnedPrimitives> m_pBinnedPrimitives;
 };
 
 class ezRasterizerViewPool
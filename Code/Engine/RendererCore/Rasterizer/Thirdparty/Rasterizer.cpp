@@ -317,6 +317,18 @@ void Rasterizer::setModelViewProjection(const float* matrix)
   _mm_storeu_ps(m_modelViewProjectionRaw + 8, mat2);
   _mm_storeu_ps(m_modelViewProjectionRaw + 12, mat3);
 
+  bakeModelViewProjection(matrix, m_modelViewProjection);
+}
+
+void Rasterizer::bakeModelViewProjection(const float* matrix, float* bakedMatrix) const
+{
+  __m128 mat0 = _mm_loadu_ps(matrix + 0);
+  __m128 mat1 = _mm_loadu_ps(matrix + 4);
+  __m128 mat2 = _mm_loadu_ps(matrix + 8);
+  __m128 mat3 = _mm_loadu_ps(matrix + 12);
+
+  _MM_TRANSPOSE4_PS(mat0, mat1, mat2, mat3);
+
   // Bake viewport transform into matrix and 6shift by half a block
   mat0 = _mm_mul_ps(_mm_add_ps(mat0, mat3), _mm_set1_ps(m_width * 0.5f - 4.0f));
   mat1 = _mm_mul_ps(_mm_add_ps(mat1, mat3), _mm_set1_ps(m_height * 0.5f - 4.0f));
@@ -327,10 +339,10 @@ void Rasterizer::setModelViewProjection(const float* matrix)
   _MM_TRANSPOSE4_PS(mat0, mat1, mat2, mat3);
 
   // Store prebaked cols
-  _mm_storeu_ps(m_modelViewProjection + 0, mat0);
-  _mm_storeu_ps(m_modelViewProjection + 4, mat1);
-  _mm_storeu_ps(m_modelViewProjection + 8, mat2);
-  _mm_storeu_ps(m_modelViewProjection + 12, mat3);
+  _mm_storeu_ps(bakedMatrix + 0, mat0);
+  _mm_storeu_ps(bakedMatrix + 4, mat1);
+  _mm_storeu_ps(bakedMatrix + 8, mat2);
+  _mm_storeu_ps(bakedMatrix + 12, mat3);
 }
 
 void Rasterizer::clear()
@@ -349,7 +361,158 @@ void Rasterizer::clear()
   }
 }
 
-bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping)
+bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping) const
+{
+  uint32_t screenBounds[4];
+  uint16_t maxZ;
+
+  if (!projectBounds(m_modelViewProjection, boundsMin, boundsMax, needsClipping, screenBounds, maxZ))
+  {
+    return false;
+  }
+
+  if (needsClipping)
+  {
+    return true;
+  }
+
+  return query2D(screenBounds[0], screenBounds[1], screenBounds[2], screenBounds[3], maxZ);
+}
+
+uint32_t Rasterizer::queryVisibilityBatch(const __m128* boundsMin, const __m128* boundsMax, uint32_t count) const
+{
+  assert(count <= 32);
+
+  // Same as queryVisibility(), but the boxes are projected eight at a time in SoA form, one box per lane
+  const float* matrix = m_modelViewProjection;
+
+  __m256 col[16];
+  for (uint32_t i = 0; i < 16; ++i)
+  {
+    col[i] = _mm256_broadcast_ss(matrix + i);
+  }
+
+  const __m256 minClamp = _mm256_setzero_ps();
+  const __m256 maxClampX = _mm256_set1_ps(float(m_width - 1));
+  const __m256 maxClampY = _mm256_set1_ps(float(m_height - 1));
+  const __m256 inc = _mm256_set1_ps(2.0f);
+
+  uint32_t visibleMask = 0;
+
+  for (uint32_t firstBox = 0; firstBox < count; firstBox += 8)
+  {
+    const uint32_t numBoxes = std::min(count - firstBox, 8u);
+
+    // Transpose into SoA, unused lanes repeat the last box
+    alignas(32) float boxMin[3][8];
+    alignas(32) float boxMax[3][8];
+    for (uint32_t lane = 0; lane < 8; ++lane)
+    {
+      const uint32_t box = firstBox + std::min(lane, numBoxes - 1);
+
+      alignas(16) float tmpMin[4];
+      alignas(16) float tmpMax[4];
+      _mm_store_ps(tmpMin, boundsMin[box]);
+      _mm_store_ps(tmpMax, boundsMax[box]);
+
+      for (uint32_t axis = 0; axis < 3; ++axis)
+      {
+        boxMin[axis][lane] = tmpMin[axis];
+        boxMax[axis][lane] = tmpMax[axis];
+      }
+    }
+
+    __m256 bounds[2][3];
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+      bounds[0][axis] = _mm256_load_ps(boxMin[axis]);
+      bounds[1][axis] = _mm256_load_ps(boxMax[axis]);
+    }
+
+    __m256 maxExtent = _mm256_max_ps(_mm256_sub_ps(bounds[1][0], bounds[0][0]), _mm256_max_ps(_mm256_sub_ps(bounds[1][1], bounds[0][1]), _mm256_sub_ps(bounds[1][2], bounds[0][2])));
+    __m256 nearPlaneEpsilon = _mm256_mul_ps(maxExtent, _mm256_set1_ps(0.001f));
+
+    __m256 closeToNearPlane = _mm256_setzero_ps();
+    __m256 minX = _mm256_set1_ps(+std::numeric_limits<float>::max());
+    __m256 minY = _mm256_set1_ps(+std::numeric_limits<float>::max());
+    __m256 maxX = _mm256_set1_ps(-std::numeric_limits<float>::max());
+    __m256 maxY = _mm256_set1_ps(-std::numeric_limits<float>::max());
+    __m256 maxZ = _mm256_set1_ps(-std::numeric_limits<float>::max());
+
+    for (uint32_t corner = 0; corner < 8; ++corner)
+    {
+      const __m256 x = bounds[corner & 1][0];
+      const __m256 y = bounds[(corner >> 1) & 1][1];
+      const __m256 z = bounds[(corner >> 2) & 1][2];
+
+      __m256 X = _mm256_fmadd_ps(col[0], x, _mm256_fmadd_ps(col[4], y, _mm256_fmadd_ps(col[8], z, col[12])));
+      __m256 Y = _mm256_fmadd_ps(col[1], x, _mm256_fmadd_ps(col[5], y, _mm256_fmadd_ps(col[9], z, col[13])));
+      __m256 Z = _mm256_fmadd_ps(col[2], x, _mm256_fmadd_ps(col[6], y, _mm256_fmadd_ps(col[10], z, col[14])));
+      __m256 W = _mm256_fmadd_ps(col[3], x, _mm256_fmadd_ps(col[7], y, _mm256_fmadd_ps(col[11], z, col[15])));
+
+      closeToNearPlane = _mm256_or_ps(closeToNearPlane, _mm256_cmp_ps(W, nearPlaneEpsilon, _CMP_LT_OQ));
+
+      __m256 invW = _mm256_rcp_ps(W);
+      X = _mm256_mul_ps(X, invW);
+      Y = _mm256_mul_ps(Y, invW);
+      Z = _mm256_mul_ps(Z, invW);
+
+      minX = _mm256_min_ps(minX, X);
+      maxX = _mm256_max_ps(maxX, X);
+      minY = _mm256_min_ps(minY, Y);
+      maxY = _mm256_max_ps(maxY, Y);
+      maxZ = _mm256_max_ps(maxZ, Z);
+    }
+
+    // Inflate, clamp and round like projectBounds()
+    minX = _mm256_round_ps(_mm256_max_ps(_mm256_sub_ps(minX, inc), minClamp), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    minY = _mm256_round_ps(_mm256_max_ps(_mm256_sub_ps(minY, inc), minClamp), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    maxX = _mm256_round_ps(_mm256_min_ps(_mm256_add_ps(maxX, inc), maxClampX), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    maxY = _mm256_round_ps(_mm256_min_ps(_mm256_add_ps(maxY, inc), maxClampY), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+
+    // No intersection between quad and screen area
+    __m256 onScreen = _mm256_and_ps(_mm256_cmp_ps(minX, maxX, _CMP_LT_OQ), _mm256_cmp_ps(minY, maxY, _CMP_LT_OQ));
+
+    const uint32_t laneMask = (1u << numBoxes) - 1;
+    const uint32_t clippedMask = _mm256_movemask_ps(closeToNearPlane) & laneMask;
+    const uint32_t queryMask = _mm256_movemask_ps(onScreen) & ~clippedMask & laneMask;
+
+    // Boxes close to the near plane are treated as visible
+    visibleMask |= clippedMask << firstBox;
+
+    if (queryMask == 0)
+    {
+      continue;
+    }
+
+    alignas(32) int32_t screenBounds[4][8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(screenBounds[0]), _mm256_cvttps_epi32(minX));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(screenBounds[1]), _mm256_cvttps_epi32(maxX));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(screenBounds[2]), _mm256_cvttps_epi32(minY));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(screenBounds[3]), _mm256_cvttps_epi32(maxY));
+
+    // Packing is monotonic, so the packed maximum depth is the maximum of the packed corner depths
+    uint16_t depthBounds[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(depthBounds), packDepthPremultiplied(maxZ));
+
+    // Hi-Z and depth lookups
+    unsigned long lane;
+    uint32_t remainingMask = queryMask;
+    while (_BitScanForward(&lane, remainingMask))
+    {
+      remainingMask &= remainingMask - 1;
+
+      if (query2D(screenBounds[0][lane], screenBounds[1][lane], screenBounds[2][lane], screenBounds[3][lane], depthBounds[lane]))
+      {
+        visibleMask |= 1u << (firstBox + lane);
+      }
+    }
+  }
+
+  return visibleMask;
+}
+
+bool Rasterizer::projectBounds(const float* bakedMatrix, __m128 boundsMin, __m128 boundsMax, bool& needsClipping, uint32_t* screenBounds, uint16_t& maxZ) const
 {
   // Frustum culling is not necessary, because EZ only calls this functions for objects that are definitely inside the frustum
   //
@@ -398,10 +561,10 @@ bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needs
   // }
 
   // Load prebaked projection matrix
-  __m128 col0 = _mm_loadu_ps(m_modelViewProjection + 0);
-  __m128 col1 = _mm_loadu_ps(m_modelViewProjection + 4);
-  __m128 col2 = _mm_loadu_ps(m_modelViewProjection + 8);
-  __m128 col3 = _mm_loadu_ps(m_modelViewProjection + 12);
+  __m128 col0 = _mm_loadu_ps(bakedMatrix + 0);
+  __m128 col1 = _mm_loadu_ps(bakedMatrix + 4);
+  __m128 col2 = _mm_loadu_ps(bakedMatrix + 8);
+  __m128 col3 = _mm_loadu_ps(bakedMatrix + 12);
 
   // Transform edges
   __m128 egde0 = _mm_mul_ps(col0, _mm_broadcastss_ps(extents));
@@ -500,19 +663,14 @@ bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needs
     return false;
   }
 
-  uint32_t minX = bounds[0];
-  uint32_t maxX = bounds[1];
-  uint32_t minY = bounds[2];
-  uint32_t maxY = bounds[3];
+  screenBounds[0] = bounds[0];
+  screenBounds[1] = bounds[1];
+  screenBounds[2] = bounds[2];
+  screenBounds[3] = bounds[3];
 
   __m128i depth = packDepthPremultiplied(corners[2], corners[6]);
 
-  uint16_t maxZ = uint16_t(0xFFFF ^ _mm_extract_epi16(_mm_minpos_epu16(_mm_xor_si128(depth, _mm_set1_epi16(-1))), 0));
-
-  if (!query2D(minX, maxX, minY, maxY, maxZ))
-  {
-    return false;
-  }
+  maxZ = uint16_t(0xFFFF ^ _mm_extract_epi16(_mm_minpos_epu16(_mm_xor_si128(depth, _mm_set1_epi16(-1))), 0));
 
   return true;
 }
@@ -852,20 +1010,13 @@ void Rasterizer::precomputeRasterizationTable()
   }
 }
 
-template <bool possiblyNearClipped>
-void Rasterizer::rasterize(const Occluder& occluder)
+void Rasterizer::prepareOccluderTransform(const Occluder& occluder, const float* bakedMatrix, OccluderTransform& transform)
 {
-  const __m256i* vertexData = occluder.m_vertexData;
-  size_t packetCount = occluder.m_packetCount;
-
-  __m256i maskY = _mm256_set1_epi32(2047 << 10);
-  __m256i maskZ = _mm256_set1_epi32(1023);
-
   // Note that unaligned loads do not have a latency penalty on CPUs with SSE4 support
-  __m128 mat0 = _mm_loadu_ps(m_modelViewProjection + 0);
-  __m128 mat1 = _mm_loadu_ps(m_modelViewProjection + 4);
-  __m128 mat2 = _mm_loadu_ps(m_modelViewProjection + 8);
-  __m128 mat3 = _mm_loadu_ps(m_modelViewProjection + 12);
+  __m128 mat0 = _mm_loadu_ps(bakedMatrix + 0);
+  __m128 mat1 = _mm_loadu_ps(bakedMatrix + 4);
+  __m128 mat2 = _mm_loadu_ps(bakedMatrix + 8);
+  __m128 mat3 = _mm_loadu_ps(bakedMatrix + 12);
 
   __m128 boundsMin = occluder.m_refMin;
   __m128 boundsExtents = _mm_sub_ps(occluder.m_refMax, boundsMin);
@@ -903,648 +1054,753 @@ void Rasterizer::rasterize(const Occluder& occluder)
     _mm_store_ss(&c1, _mm_fnmadd_ps(_mm_div_ps(_mm_sub_ps(Za, Zb), _mm_sub_ps(Wa, Wb)), Wa, Za));
   }
 
-  for (uint32_t packetIdx = 0; packetIdx < packetCount; packetIdx += 4)
+  transform.m_mat0 = mat0;
+  transform.m_mat1 = mat1;
+  transform.m_mat3 = mat3;
+  transform.m_c0 = c0;
+  transform.m_c1 = c1;
+}
+
+template <bool possiblyNearClipped>
+uint32_t Rasterizer::setupPacket(const __m256i* packet, const OccluderTransform& transform, Primitive* primitives) const
+{
+  __m256i maskY = _mm256_set1_epi32(2047 << 10);
+  __m256i maskZ = _mm256_set1_epi32(1023);
+
+  const __m128 mat0 = transform.m_mat0;
+  const __m128 mat1 = transform.m_mat1;
+  const __m128 mat3 = transform.m_mat3;
+  const float c0 = transform.m_c0;
+  const float c1 = transform.m_c1;
+
+  // Load data - only needed once per frame, so use streaming load
+  __m256i I0 = _mm256_stream_load_si256(packet + 0);
+  __m256i I1 = _mm256_stream_load_si256(packet + 1);
+  __m256i I2 = _mm256_stream_load_si256(packet + 2);
+  __m256i I3 = _mm256_stream_load_si256(packet + 3);
+
+  // Vertex transformation - first W, then X & Y after camera plane culling, then Z after backface culling
+  __m256 Xf0 = _mm256_cvtepi32_ps(I0);
+  __m256 Xf1 = _mm256_cvtepi32_ps(I1);
+  __m256 Xf2 = _mm256_cvtepi32_ps(I2);
+  __m256 Xf3 = _mm256_cvtepi32_ps(I3);
+
+  __m256 Yf0 = _mm256_cvtepi32_ps(_mm256_and_si256(I0, maskY));
+  __m256 Yf1 = _mm256_cvtepi32_ps(_mm256_and_si256(I1, maskY));
+  __m256 Yf2 = _mm256_cvtepi32_ps(_mm256_and_si256(I2, maskY));
+  __m256 Yf3 = _mm256_cvtepi32_ps(_mm256_and_si256(I3, maskY));
+
+  __m256 Zf0 = _mm256_cvtepi32_ps(_mm256_and_si256(I0, maskZ));
+  __m256 Zf1 = _mm256_cvtepi32_ps(_mm256_and_si256(I1, maskZ));
+  __m256 Zf2 = _mm256_cvtepi32_ps(_mm256_and_si256(I2, maskZ));
+  __m256 Zf3 = _mm256_cvtepi32_ps(_mm256_and_si256(I3, maskZ));
+
+  __m256 mat00 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat0) + 0);
+  __m256 mat01 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat0) + 1);
+  __m256 mat02 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat0) + 2);
+  __m256 mat03 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat0) + 3);
+
+  __m256 X0 = _mm256_fmadd_ps(Xf0, mat00, _mm256_fmadd_ps(Yf0, mat01, _mm256_fmadd_ps(Zf0, mat02, mat03)));
+  __m256 X1 = _mm256_fmadd_ps(Xf1, mat00, _mm256_fmadd_ps(Yf1, mat01, _mm256_fmadd_ps(Zf1, mat02, mat03)));
+  __m256 X2 = _mm256_fmadd_ps(Xf2, mat00, _mm256_fmadd_ps(Yf2, mat01, _mm256_fmadd_ps(Zf2, mat02, mat03)));
+  __m256 X3 = _mm256_fmadd_ps(Xf3, mat00, _mm256_fmadd_ps(Yf3, mat01, _mm256_fmadd_ps(Zf3, mat02, mat03)));
+
+  __m256 mat10 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat1) + 0);
+  __m256 mat11 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat1) + 1);
+  __m256 mat12 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat1) + 2);
+  __m256 mat13 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat1) + 3);
+
+  __m256 Y0 = _mm256_fmadd_ps(Xf0, mat10, _mm256_fmadd_ps(Yf0, mat11, _mm256_fmadd_ps(Zf0, mat12, mat13)));
+  __m256 Y1 = _mm256_fmadd_ps(Xf1, mat10, _mm256_fmadd_ps(Yf1, mat11, _mm256_fmadd_ps(Zf1, mat12, mat13)));
+  __m256 Y2 = _mm256_fmadd_ps(Xf2, mat10, _mm256_fmadd_ps(Yf2, mat11, _mm256_fmadd_ps(Zf2, mat12, mat13)));
+  __m256 Y3 = _mm256_fmadd_ps(Xf3, mat10, _mm256_fmadd_ps(Yf3, mat11, _mm256_fmadd_ps(Zf3, mat12, mat13)));
+
+  __m256 mat30 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat3) + 0);
+  __m256 mat31 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat3) + 1);
+  __m256 mat32 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat3) + 2);
+  __m256 mat33 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat3) + 3);
+
+  __m256 W0 = _mm256_fmadd_ps(Xf0, mat30, _mm256_fmadd_ps(Yf0, mat31, _mm256_fmadd_ps(Zf0, mat32, mat33)));
+  __m256 W1 = _mm256_fmadd_ps(Xf1, mat30, _mm256_fmadd_ps(Yf1, mat31, _mm256_fmadd_ps(Zf1, mat32, mat33)));
+  __m256 W2 = _mm256_fmadd_ps(Xf2, mat30, _mm256_fmadd_ps(Yf2, mat31, _mm256_fmadd_ps(Zf2, mat32, mat33)));
+  __m256 W3 = _mm256_fmadd_ps(Xf3, mat30, _mm256_fmadd_ps(Yf3, mat31, _mm256_fmadd_ps(Zf3, mat32, mat33)));
+
+  __m256 invW0, invW1, invW2, invW3;
+  // Clamp W and invert
+  if (possiblyNearClipped)
   {
-    // Load data - only needed once per frame, so use streaming load
-    __m256i I0 = _mm256_stream_load_si256(vertexData + packetIdx + 0);
-    __m256i I1 = _mm256_stream_load_si256(vertexData + packetIdx + 1);
-    __m256i I2 = _mm256_stream_load_si256(vertexData + packetIdx + 2);
-    __m256i I3 = _mm256_stream_load_si256(vertexData + packetIdx + 3);
-
-    // Vertex transformation - first W, then X & Y after camera plane culling, then Z after backface culling
-    __m256 Xf0 = _mm256_cvtepi32_ps(I0);
-    __m256 Xf1 = _mm256_cvtepi32_ps(I1);
-    __m256 Xf2 = _mm256_cvtepi32_ps(I2);
-    __m256 Xf3 = _mm256_cvtepi32_ps(I3);
-
-    __m256 Yf0 = _mm256_cvtepi32_ps(_mm256_and_si256(I0, maskY));
-    __m256 Yf1 = _mm256_cvtepi32_ps(_mm256_and_si256(I1, maskY));
-    __m256 Yf2 = _mm256_cvtepi32_ps(_mm256_and_si256(I2, maskY));
-    __m256 Yf3 = _mm256_cvtepi32_ps(_mm256_and_si256(I3, maskY));
-
-    __m256 Zf0 = _mm256_cvtepi32_ps(_mm256_and_si256(I0, maskZ));
-    __m256 Zf1 = _mm256_cvtepi32_ps(_mm256_and_si256(I1, maskZ));
-    __m256 Zf2 = _mm256_cvtepi32_ps(_mm256_and_si256(I2, maskZ));
-    __m256 Zf3 = _mm256_cvtepi32_ps(_mm256_and_si256(I3, maskZ));
-
-    __m256 mat00 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat0) + 0);
-    __m256 mat01 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat0) + 1);
-    __m256 mat02 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat0) + 2);
-    __m256 mat03 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat0) + 3);
-
-    __m256 X0 = _mm256_fmadd_ps(Xf0, mat00, _mm256_fmadd_ps(Yf0, mat01, _mm256_fmadd_ps(Zf0, mat02, mat03)));
-    __m256 X1 = _mm256_fmadd_ps(Xf1, mat00, _mm256_fmadd_ps(Yf1, mat01, _mm256_fmadd_ps(Zf1, mat02, mat03)));
-    __m256 X2 = _mm256_fmadd_ps(Xf2, mat00, _mm256_fmadd_ps(Yf2, mat01, _mm256_fmadd_ps(Zf2, mat02, mat03)));
-    __m256 X3 = _mm256_fmadd_ps(Xf3, mat00, _mm256_fmadd_ps(Yf3, mat01, _mm256_fmadd_ps(Zf3, mat02, mat03)));
-
-    __m256 mat10 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat1) + 0);
-    __m256 mat11 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat1) + 1);
-    __m256 mat12 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat1) + 2);
-    __m256 mat13 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat1) + 3);
-
-    __m256 Y0 = _mm256_fmadd_ps(Xf0, mat10, _mm256_fmadd_ps(Yf0, mat11, _mm256_fmadd_ps(Zf0, mat12, mat13)));
-    __m256 Y1 = _mm256_fmadd_ps(Xf1, mat10, _mm256_fmadd_ps(Yf1, mat11, _mm256_fmadd_ps(Zf1, mat12, mat13)));
-    __m256 Y2 = _mm256_fmadd_ps(Xf2, mat10, _mm256_fmadd_ps(Yf2, mat11, _mm256_fmadd_ps(Zf2, mat12, mat13)));
-    __m256 Y3 = _mm256_fmadd_ps(Xf3, mat10, _mm256_fmadd_ps(Yf3, mat11, _mm256_fmadd_ps(Zf3, mat12, mat13)));
-
-    __m256 mat30 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat3) + 0);
-    __m256 mat31 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat3) + 1);
-    __m256 mat32 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat3) + 2);
-    __m256 mat33 = _mm256_broadcast_ss(reinterpret_cast<const float*>(&mat3) + 3);
-
-    __m256 W0 = _mm256_fmadd_ps(Xf0, mat30, _mm256_fmadd_ps(Yf0, mat31, _mm256_fmadd_ps(Zf0, mat32, mat33)));
-    __m256 W1 = _mm256_fmadd_ps(Xf1, mat30, _mm256_fmadd_ps(Yf1, mat31, _mm256_fmadd_ps(Zf1, mat32, mat33)));
-    __m256 W2 = _mm256_fmadd_ps(Xf2, mat30, _mm256_fmadd_ps(Yf2, mat31, _mm256_fmadd_ps(Zf2, mat32, mat33)));
-    __m256 W3 = _mm256_fmadd_ps(Xf3, mat30, _mm256_fmadd_ps(Yf3, mat31, _mm256_fmadd_ps(Zf3, mat32, mat33)));
-
-    __m256 invW0, invW1, invW2, invW3;
-    // Clamp W and invert
-    if (possiblyNearClipped)
-    {
-      __m256 lowerBound = _mm256_set1_ps(-maxInvW);
-      __m256 upperBound = _mm256_set1_ps(+maxInvW);
-      invW0 = _mm256_min_ps(upperBound, _mm256_max_ps(lowerBound, _mm256_rcp_ps(W0)));
-      invW1 = _mm256_min_ps(upperBound, _mm256_max_ps(lowerBound, _mm256_rcp_ps(W1)));
-      invW2 = _mm256_min_ps(upperBound, _mm256_max_ps(lowerBound, _mm256_rcp_ps(W2)));
-      invW3 = _mm256_min_ps(upperBound, _mm256_max_ps(lowerBound, _mm256_rcp_ps(W3)));
-    }
-    else
-    {
-      invW0 = _mm256_rcp_ps(W0);
-      invW1 = _mm256_rcp_ps(W1);
-      invW2 = _mm256_rcp_ps(W2);
-      invW3 = _mm256_rcp_ps(W3);
-    }
+    __m256 lowerBound = _mm256_set1_ps(-maxInvW);
+    __m256 upperBound = _mm256_set1_ps(+maxInvW);
+    invW0 = _mm256_min_ps(upperBound, _mm256_max_ps(lowerBound, _mm256_rcp_ps(W0)));
+    invW1 = _mm256_min_ps(upperBound, _mm256_max_ps(lowerBound, _mm256_rcp_ps(W1)));
+    invW2 = _mm256_min_ps(upperBound, _mm256_max_ps(lowerBound, _mm256_rcp_ps(W2)));
+    invW3 = _mm256_min_ps(upperBound, _mm256_max_ps(lowerBound, _mm256_rcp_ps(W3)));
+  }
+  else
+  {
+    invW0 = _mm256_rcp_ps(W0);
+    invW1 = _mm256_rcp_ps(W1);
+    invW2 = _mm256_rcp_ps(W2);
+    invW3 = _mm256_rcp_ps(W3);
+  }
 
-    // Round to integer coordinates to improve culling of zero-area triangles
-    __m256 x0 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(X0, invW0), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
-    __m256 x1 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(X1, invW1), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
-    __m256 x2 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(X2, invW2), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
-    __m256 x3 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(X3, invW3), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
-
-    __m256 y0 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(Y0, invW0), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
-    __m256 y1 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(Y1, invW1), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
-    __m256 y2 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(Y2, invW2), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
-    __m256 y3 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(Y3, invW3), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
-
-    // Compute unnormalized edge directions
-    __m256 edgeNormalsX0 = _mm256_sub_ps(y1, y0);
-    __m256 edgeNormalsX1 = _mm256_sub_ps(y2, y1);
-    __m256 edgeNormalsX2 = _mm256_sub_ps(y3, y2);
-    __m256 edgeNormalsX3 = _mm256_sub_ps(y0, y3);
-
-    __m256 edgeNormalsY0 = _mm256_sub_ps(x0, x1);
-    __m256 edgeNormalsY1 = _mm256_sub_ps(x1, x2);
-    __m256 edgeNormalsY2 = _mm256_sub_ps(x2, x3);
-    __m256 edgeNormalsY3 = _mm256_sub_ps(x3, x0);
-
-    __m256 area0 = _mm256_fmsub_ps(edgeNormalsX0, edgeNormalsY1, _mm256_mul_ps(edgeNormalsX1, edgeNormalsY0));
-    __m256 area1 = _mm256_fmsub_ps(edgeNormalsX1, edgeNormalsY2, _mm256_mul_ps(edgeNormalsX2, edgeNormalsY1));
-    __m256 area2 = _mm256_fmsub_ps(edgeNormalsX2, edgeNormalsY3, _mm256_mul_ps(edgeNormalsX3, edgeNormalsY2));
-    __m256 area3 = _mm256_sub_ps(_mm256_add_ps(area0, area2), area1);
-
-    __m256 minusZero256 = _mm256_set1_ps(-0.0f);
-
-    __m256 wSign0, wSign1, wSign2, wSign3;
-    if (possiblyNearClipped)
-    {
-      wSign0 = _mm256_and_ps(invW0, minusZero256);
-      wSign1 = _mm256_and_ps(invW1, minusZero256);
-      wSign2 = _mm256_and_ps(invW2, minusZero256);
-      wSign3 = _mm256_and_ps(invW3, minusZero256);
-    }
-    else
-    {
-      wSign0 = _mm256_setzero_ps();
-      wSign1 = _mm256_setzero_ps();
-      wSign2 = _mm256_setzero_ps();
-      wSign3 = _mm256_setzero_ps();
-    }
+  // Round to integer coordinates to improve culling of zero-area triangles
+  __m256 x0 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(X0, invW0), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
+  __m256 x1 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(X1, invW1), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
+  __m256 x2 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(X2, invW2), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
+  __m256 x3 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(X3, invW3), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
 
-    // Compute signs of areas. We treat 0 as negative as this allows treating primitives with zero area as backfacing.
-    __m256 areaSign0, areaSign1, areaSign2, areaSign3;
-    if (possiblyNearClipped)
-    {
-      // Flip areas for each vertex with W < 0. This needs to be done before comparison against 0 rather than afterwards to make sure zero-are triangles are handled correctly.
-      areaSign0 = _mm256_cmp_ps(_mm256_xor_ps(_mm256_xor_ps(area0, wSign0), _mm256_xor_ps(wSign1, wSign2)), _mm256_setzero_ps(), _CMP_LE_OQ);
-      areaSign1 = _mm256_and_ps(minusZero256, _mm256_cmp_ps(_mm256_xor_ps(_mm256_xor_ps(area1, wSign1), _mm256_xor_ps(wSign2, wSign3)), _mm256_setzero_ps(), _CMP_LE_OQ));
-      areaSign2 = _mm256_and_ps(minusZero256, _mm256_cmp_ps(_mm256_xor_ps(_mm256_xor_ps(area2, wSign0), _mm256_xor_ps(wSign2, wSign3)), _mm256_setzero_ps(), _CMP_LE_OQ));
-      areaSign3 = _mm256_and_ps(minusZero256, _mm256_cmp_ps(_mm256_xor_ps(_mm256_xor_ps(area3, wSign1), _mm256_xor_ps(wSign0, wSign3)), _mm256_setzero_ps(), _CMP_LE_OQ));
-    }
-    else
-    {
-      areaSign0 = _mm256_cmp_ps(area0, _mm256_setzero_ps(), _CMP_LE_OQ);
-      areaSign1 = _mm256_and_ps(minusZero256, _mm256_cmp_ps(area1, _mm256_setzero_ps(), _CMP_LE_OQ));
-      areaSign2 = _mm256_and_ps(minusZero256, _mm256_cmp_ps(area2, _mm256_setzero_ps(), _CMP_LE_OQ));
-      areaSign3 = _mm256_and_ps(minusZero256, _mm256_cmp_ps(area3, _mm256_setzero_ps(), _CMP_LE_OQ));
-    }
+  __m256 y0 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(Y0, invW0), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
+  __m256 y1 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(Y1, invW1), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
+  __m256 y2 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(Y2, invW2), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
+  __m256 y3 = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(Y3, invW3), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(0.125f));
 
-    __m256i config = _mm256_or_si256(
-      _mm256_or_si256(_mm256_srli_epi32(_mm256_castps_si256(areaSign3), 28), _mm256_srli_epi32(_mm256_castps_si256(areaSign2), 29)),
-      _mm256_or_si256(_mm256_srli_epi32(_mm256_castps_si256(areaSign1), 30), _mm256_srli_epi32(_mm256_castps_si256(areaSign0), 31)));
+  // Compute unnormalized edge directions
+  __m256 edgeNormalsX0 = _mm256_sub_ps(y1, y0);
+  __m256 edgeNormalsX1 = _mm256_sub_ps(y2, y1);
+  __m256 edgeNormalsX2 = _mm256_sub_ps(y3, y2);
+  __m256 edgeNormalsX3 = _mm256_sub_ps(y0, y3);
 
-    if (possiblyNearClipped)
-    {
-      config = _mm256_or_si256(config,
-        _mm256_or_si256(
-          _mm256_or_si256(_mm256_srli_epi32(_mm256_castps_si256(wSign3), 24), _mm256_srli_epi32(_mm256_castps_si256(wSign2), 25)),
-          _mm256_or_si256(_mm256_srli_epi32(_mm256_castps_si256(wSign1), 26), _mm256_srli_epi32(_mm256_castps_si256(wSign0), 27))));
-    }
+  __m256 edgeNormalsY0 = _mm256_sub_ps(x0, x1);
+  __m256 edgeNormalsY1 = _mm256_sub_ps(x1, x2);
+  __m256 edgeNormalsY2 = _mm256_sub_ps(x2, x3);
+  __m256 edgeNormalsY3 = _mm256_sub_ps(x3, x0);
 
-    __m256i modes = _mm256_i32gather_epi32(modeTable, config, 4);
-    if (_mm256_testz_si256(modes, modes))
-    {
-      continue;
-    }
+  __m256 area0 = _mm256_fmsub_ps(edgeNormalsX0, edgeNormalsY1, _mm256_mul_ps(edgeNormalsX1, edgeNormalsY0));
+  __m256 area1 = _mm256_fmsub_ps(edgeNormalsX1, edgeNormalsY2, _mm256_mul_ps(edgeNormalsX2, edgeNormalsY1));
+  __m256 area2 = _mm256_fmsub_ps(edgeNormalsX2, edgeNormalsY3, _mm256_mul_ps(edgeNormalsX3, edgeNormalsY2));
+  __m256 area3 = _mm256_sub_ps(_mm256_add_ps(area0, area2), area1);
 
-    __m256i primitiveValid = _mm256_cmpgt_epi32(modes, _mm256_setzero_si256());
+  __m256 minusZero256 = _mm256_set1_ps(-0.0f);
 
-    uint32_t primModes[8];
-    _mm256_storeu_si256(reinterpret_cast<__m256i*>(primModes), modes);
+  __m256 wSign0, wSign1, wSign2, wSign3;
+  if (possiblyNearClipped)
+  {
+    wSign0 = _mm256_and_ps(invW0, minusZero256);
+    wSign1 = _mm256_and_ps(invW1, minusZero256);
+    wSign2 = _mm256_and_ps(invW2, minusZero256);
+    wSign3 = _mm256_and_ps(invW3, minusZero256);
+  }
+  else
+  {
+    wSign0 = _mm256_setzero_ps();
+    wSign1 = _mm256_setzero_ps();
+    wSign2 = _mm256_setzero_ps();
+    wSign3 = _mm256_setzero_ps();
+  }
 
-    __m256 minFx, minFy, maxFx, maxFy;
+  // Compute signs of areas. We treat 0 as negative as this allows treating primitives with zero area as backfacing.
+  __m256 areaSign0, areaSign1, areaSign2, areaSign3;
+  if (possiblyNearClipped)
+  {
+    // Flip areas for each vertex with W < 0. This needs to be done before comparison against 0 rather than afterwards to make sure zero-are triangles are handled correctly.
+    areaSign0 = _mm256_cmp_ps(_mm256_xor_ps(_mm256_xor_ps(area0, wSign0), _mm256_xor_ps(wSign1, wSign2)), _mm256_setzero_ps(), _CMP_LE_OQ);
+    areaSign1 = _mm256_and_ps(minusZero256, _mm256_cmp_ps(_mm256_xor_ps(_mm256_xor_ps(area1, wSign1), _mm256_xor_ps(wSign2, wSign3)), _mm256_setzero_ps(), _CMP_LE_OQ));
+    areaSign2 = _mm256_and_ps(minusZero256, _mm256_cmp_ps(_mm256_xor_ps(_mm256_xor_ps(area2, wSign0), _mm256_xor_ps(wSign2, wSign3)), _mm256_setzero_ps(), _CMP_LE_OQ));
+    areaSign3 = _mm256_and_ps(minusZero256, _mm256_cmp_ps(_mm256_xor_ps(_mm256_xor_ps(area3, wSign1), _mm256_xor_ps(wSign0, wSign3)), _mm256_setzero_ps(), _CMP_LE_OQ));
+  }
+  else
+  {
+    areaSign0 = _mm256_cmp_ps(area0, _mm256_setzero_ps(), _CMP_LE_OQ);
+    areaSign1 = _mm256_and_ps(minusZero256, _mm256_cmp_ps(area1, _mm256_setzero_ps(), _CMP_LE_OQ));
+    areaSign2 = _mm256_and_ps(minusZero256, _mm256_cmp_ps(area2, _mm256_setzero_ps(), _CMP_LE_OQ));
+    areaSign3 = _mm256_and_ps(minusZero256, _mm256_cmp_ps(area3, _mm256_setzero_ps(), _CMP_LE_OQ));
+  }
 
-    if (possiblyNearClipped)
-    {
-      // Clipless bounding box computation
-      __m256 infP = _mm256_set1_ps(+10000.0f);
-      __m256 infN = _mm256_set1_ps(-10000.0f);
-
-      // Find interval of points with W > 0
-      __m256 minPx0 = _mm256_blendv_ps(x0, infP, wSign0);
-      __m256 minPx1 = _mm256_blendv_ps(x1, infP, wSign1);
-      __m256 minPx2 = _mm256_blendv_ps(x2, infP, wSign2);
-      __m256 minPx3 = _mm256_blendv_ps(x3, infP, wSign3);
-
-      __m256 minPx = _mm256_min_ps(
-        _mm256_min_ps(minPx0, minPx1),
-        _mm256_min_ps(minPx2, minPx3));
-
-      __m256 minPy0 = _mm256_blendv_ps(y0, infP, wSign0);
-      __m256 minPy1 = _mm256_blendv_ps(y1, infP, wSign1);
-      __m256 minPy2 = _mm256_blendv_ps(y2, infP, wSign2);
-      __m256 minPy3 = _mm256_blendv_ps(y3, infP, wSign3);
-
-      __m256 minPy = _mm256_min_ps(
-        _mm256_min_ps(minPy0, minPy1),
-        _mm256_min_ps(minPy2, minPy3));
-
-      __m256 maxPx0 = _mm256_xor_ps(minPx0, wSign0);
-      __m256 maxPx1 = _mm256_xor_ps(minPx1, wSign1);
-      __m256 maxPx2 = _mm256_xor_ps(minPx2, wSign2);
-      __m256 maxPx3 = _mm256_xor_ps(minPx3, wSign3);
-
-      __m256 maxPx = _mm256_max_ps(
-        _mm256_max_ps(maxPx0, maxPx1),
-        _mm256_max_ps(maxPx2, maxPx3));
-
-      __m256 maxPy0 = _mm256_xor_ps(minPy0, wSign0);
-      __m256 maxPy1 = _mm256_xor_ps(minPy1, wSign1);
-      __m256 maxPy2 = _mm256_xor_ps(minPy2, wSign2);
-      __m256 maxPy3 = _mm256_xor_ps(minPy3, wSign3);
-
-      __m256 maxPy = _mm256_max_ps(
-        _mm256_max_ps(maxPy0, maxPy1),
-        _mm256_max_ps(maxPy2, maxPy3));
-
-      // Find interval of points with W < 0
-      __m256 minNx0 = _mm256_blendv_ps(infP, x0, wSign0);
-      __m256 minNx1 = _mm256_blendv_ps(infP, x1, wSign1);
-      __m256 minNx2 = _mm256_blendv_ps(infP, x2, wSign2);
-      __m256 minNx3 = _mm256_blendv_ps(infP, x3, wSign3);
-
-      __m256 minNx = _mm256_min_ps(
-        _mm256_min_ps(minNx0, minNx1),
-        _mm256_min_ps(minNx2, minNx3));
-
-      __m256 minNy0 = _mm256_blendv_ps(infP, y0, wSign0);
-      __m256 minNy1 = _mm256_blendv_ps(infP, y1, wSign1);
-      __m256 minNy2 = _mm256_blendv_ps(infP, y2, wSign2);
-      __m256 minNy3 = _mm256_blendv_ps(infP, y3, wSign3);
-
-      __m256 minNy = _mm256_min_ps(
-        _mm256_min_ps(minNy0, minNy1),
-        _mm256_min_ps(minNy2, minNy3));
-
-      __m256 maxNx0 = _mm256_blendv_ps(infN, x0, wSign0);
-      __m256 maxNx1 = _mm256_blendv_ps(infN, x1, wSign1);
-      __m256 maxNx2 = _mm256_blendv_ps(infN, x2, wSign2);
-      __m256 maxNx3 = _mm256_blendv_ps(infN, x3, wSign3);
-
-      __m256 maxNx = _mm256_max_ps(
-        _mm256_max_ps(maxNx0, maxNx1),
-        _mm256_max_ps(maxNx2, maxNx3));
-
-      __m256 maxNy0 = _mm256_blendv_ps(infN, y0, wSign0);
-      __m256 maxNy1 = _mm256_blendv_ps(infN, y1, wSign1);
-      __m256 maxNy2 = _mm256_blendv_ps(infN, y2, wSign2);
-      __m256 maxNy3 = _mm256_blendv_ps(infN, y3, wSign3);
-
-      __m256 maxNy = _mm256_max_ps(
-        _mm256_max_ps(maxNy0, maxNy1),
-        _mm256_max_ps(maxNy2, maxNy3));
-
-      // Include interval bounds resp. infinity depending on ordering of intervals
-      __m256 incAx = _mm256_blendv_ps(minPx, infN, _mm256_cmp_ps(maxNx, minPx, _CMP_GT_OQ));
-      __m256 incAy = _mm256_blendv_ps(minPy, infN, _mm256_cmp_ps(maxNy, minPy, _CMP_GT_OQ));
-
-      __m256 incBx = _mm256_blendv_ps(maxPx, infP, _mm256_cmp_ps(maxPx, minNx, _CMP_GT_OQ));
-      __m256 incBy = _mm256_blendv_ps(maxPy, infP, _mm256_cmp_ps(maxPy, minNy, _CMP_GT_OQ));
-
-      minFx = _mm256_min_ps(incAx, incBx);
-      minFy = _mm256_min_ps(incAy, incBy);
-
-      maxFx = _mm256_max_ps(incAx, incBx);
-      maxFy = _mm256_max_ps(incAy, incBy);
-    }
-    else
-    {
-      // Standard bounding box inclusion
-      minFx = _mm256_min_ps(_mm256_min_ps(x0, x1), _mm256_min_ps(x2, x3));
-      minFy = _mm256_min_ps(_mm256_min_ps(y0, y1), _mm256_min_ps(y2, y3));
+  __m256i config = _mm256_or_si256(
+    _mm256_or_si256(_mm256_srli_epi32(_mm256_castps_si256(areaSign3), 28), _mm256_srli_epi32(_mm256_castps_si256(areaSign2), 29)),
+    _mm256_or_si256(_mm256_srli_epi32(_mm256_castps_si256(areaSign1), 30), _mm256_srli_epi32(_mm256_castps_si256(areaSign0), 31)));
 
-      maxFx = _mm256_max_ps(_mm256_max_ps(x0, x1), _mm256_max_ps(x2, x3));
-      maxFy = _mm256_max_ps(_mm256_max_ps(y0, y1), _mm256_max_ps(y2, y3));
-    }
+  if (possiblyNearClipped)
+  {
+    config = _mm256_or_si256(config,
+      _mm256_or_si256(
+        _mm256_or_si256(_mm256_srli_epi32(_mm256_castps_si256(wSign3), 24), _mm256_srli_epi32(_mm256_castps_si256(wSign2), 25)),
+        _mm256_or_si256(_mm256_srli_epi32(_mm256_castps_si256(wSign1), 26), _mm256_srli_epi32(_mm256_castps_si256(wSign0), 27))));
+  }
 
-    // Clamp and round
-    __m256i minX, minY, maxX, maxY;
-    minX = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_add_ps(minFx, _mm256_set1_ps(4.9999f / 8.0f))), _mm256_setzero_si256());
-    minY = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_add_ps(minFy, _mm256_set1_ps(4.9999f / 8.0f))), _mm256_setzero_si256());
-    maxX = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFx, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(m_blocksX));
-    maxY = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFy, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(m_blocksY));
+  __m256i modes = _mm256_i32gather_epi32(modeTable, config, 4);
+  if (_mm256_testz_si256(modes, modes))
+  {
+    return 0;
+  }
 
-    // Check overlap between bounding box and frustum
-    __m256i inFrustum = _mm256_and_si256(_mm256_cmpgt_epi32(maxX, minX), _mm256_cmpgt_epi32(maxY, minY));
-    primitiveValid = _mm256_and_si256(inFrustum, primitiveValid);
+  __m256i primitiveValid = _mm256_cmpgt_epi32(modes, _mm256_setzero_si256());
 
-    if (_mm256_testz_si256(primitiveValid, primitiveValid))
-    {
-      continue;
-    }
+  uint32_t primModes[8];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(primModes), modes);
 
-    // Convert bounds from [min, max] to [min, range]
-    __m256i rangeX = _mm256_sub_epi32(maxX, minX);
-    __m256i rangeY = _mm256_sub_epi32(maxY, minY);
+  __m256 minFx, minFy, maxFx, maxFy;
 
-    // Compute Z from linear relation with 1/W
-    __m256 z0, z1, z2, z3;
-    __m256 C0 = _mm256_broadcast_ss(&c0);
-    __m256 C1 = _mm256_broadcast_ss(&c1);
-    z0 = _mm256_fmadd_ps(invW0, C1, C0);
-    z1 = _mm256_fmadd_ps(invW1, C1, C0);
-    z2 = _mm256_fmadd_ps(invW2, C1, C0);
-    z3 = _mm256_fmadd_ps(invW3, C1, C0);
+  if (possiblyNearClipped)
+  {
+    // Clipless bounding box computation
+    __m256 infP = _mm256_set1_ps(+10000.0f);
+    __m256 infN = _mm256_set1_ps(-10000.0f);
+
+    // Find interval of points with W > 0
+    __m256 minPx0 = _mm256_blendv_ps(x0, infP, wSign0);
+    __m256 minPx1 = _mm256_blendv_ps(x1, infP, wSign1);
+    __m256 minPx2 = _mm256_blendv_ps(x2, infP, wSign2);
+    __m256 minPx3 = _mm256_blendv_ps(x3, infP, wSign3);
+
+    __m256 minPx = _mm256_min_ps(
+      _mm256_min_ps(minPx0, minPx1),
+      _mm256_min_ps(minPx2, minPx3));
+
+    __m256 minPy0 = _mm256_blendv_ps(y0, infP, wSign0);
+    __m256 minPy1 = _mm256_blendv_ps(y1, infP, wSign1);
+    __m256 minPy2 = _mm256_blendv_ps(y2, infP, wSign2);
+    __m256 minPy3 = _mm256_blendv_ps(y3, infP, wSign3);
+
+    __m256 minPy = _mm256_min_ps(
+      _mm256_min_ps(minPy0, minPy1),
+      _mm256_min_ps(minPy2, minPy3));
+
+    __m256 maxPx0 = _mm256_xor_ps(minPx0, wSign0);
+    __m256 maxPx1 = _mm256_xor_ps(minPx1, wSign1);
+    __m256 maxPx2 = _mm256_xor_ps(minPx2, wSign2);
+    __m256 maxPx3 = _mm256_xor_ps(minPx3, wSign3);
+
+    __m256 maxPx = _mm256_max_ps(
+      _mm256_max_ps(maxPx0, maxPx1),
+      _mm256_max_ps(maxPx2, maxPx3));
+
+    __m256 maxPy0 = _mm256_xor_ps(minPy0, wSign0);
+    __m256 maxPy1 = _mm256_xor_ps(minPy1, wSign1);
+    __m256 maxPy2 = _mm256_xor_ps(minPy2, wSign2);
+    __m256 maxPy3 = _mm256_xor_ps(minPy3, wSign3);
+
+    __m256 maxPy = _mm256_max_ps(
+      _mm256_max_ps(maxPy0, maxPy1),
+      _mm256_max_ps(maxPy2, maxPy3));
+
+    // Find interval of points with W < 0
+    __m256 minNx0 = _mm256_blendv_ps(infP, x0, wSign0);
+    __m256 minNx1 = _mm256_blendv_ps(infP, x1, wSign1);
+    __m256 minNx2 = _mm256_blendv_ps(infP, x2, wSign2);
+    __m256 minNx3 = _mm256_blendv_ps(infP, x3, wSign3);
+
+    __m256 minNx = _mm256_min_ps(
+      _mm256_min_ps(minNx0, minNx1),
+      _mm256_min_ps(minNx2, minNx3));
+
+    __m256 minNy0 = _mm256_blendv_ps(infP, y0, wSign0);
+    __m256 minNy1 = _mm256_blendv_ps(infP, y1, wSign1);
+    __m256 minNy2 = _mm256_blendv_ps(infP, y2, wSign2);
+    __m256 minNy3 = _mm256_blendv_ps(infP, y3, wSign3);
+
+    __m256 minNy = _mm256_min_ps(
+      _mm256_min_ps(minNy0, minNy1),
+      _mm256_min_ps(minNy2, minNy3));
+
+    __m256 maxNx0 = _mm256_blendv_ps(infN, x0, wSign0);
+    __m256 maxNx1 = _mm256_blendv_ps(infN, x1, wSign1);
+    __m256 maxNx2 = _mm256_blendv_ps(infN, x2, wSign2);
+    __m256 maxNx3 = _mm256_blendv_ps(infN, x3, wSign3);
+
+    __m256 maxNx = _mm256_max_ps(
+      _mm256_max_ps(maxNx0, maxNx1),
+      _mm256_max_ps(maxNx2, maxNx3));
+
+    __m256 maxNy0 = _mm256_blendv_ps(infN, y0, wSign0);
+    __m256 maxNy1 = _mm256_blendv_ps(infN, y1, wSign1);
+    __m256 maxNy2 = _mm256_blendv_ps(infN, y2, wSign2);
+    __m256 maxNy3 = _mm256_blendv_ps(infN, y3, wSign3);
+
+    __m256 maxNy = _mm256_max_ps(
+      _mm256_max_ps(maxNy0, maxNy1),
+      _mm256_max_ps(maxNy2, maxNy3));
+
+    // Include interval bounds resp. infinity depending on ordering of intervals
+    __m256 incAx = _mm256_blendv_ps(minPx, infN, _mm256_cmp_ps(maxNx, minPx, _CMP_GT_OQ));
+    __m256 incAy = _mm256_blendv_ps(minPy, infN, _mm256_cmp_ps(maxNy, minPy, _CMP_GT_OQ));
+
+    __m256 incBx = _mm256_blendv_ps(maxPx, infP, _mm256_cmp_ps(maxPx, minNx, _CMP_GT_OQ));
+    __m256 incBy = _mm256_blendv_ps(maxPy, infP, _mm256_cmp_ps(maxPy, minNy, _CMP_GT_OQ));
+
+    minFx = _mm256_min_ps(incAx, incBx);
+    minFy = _mm256_min_ps(incAy, incBy);
+
+    maxFx = _mm256_max_ps(incAx, incBx);
+    maxFy = _mm256_max_ps(incAy, incBy);
+  }
+  else
+  {
+    // Standard bounding box inclusion
+    minFx = _mm256_min_ps(_mm256_min_ps(x0, x1), _mm256_min_ps(x2, x3));
+    minFy = _mm256_min_ps(_mm256_min_ps(y0, y1), _mm256_min_ps(y2, y3));
 
-    __m256 maxZ = _mm256_max_ps(_mm256_max_ps(z0, z1), _mm256_max_ps(z2, z3));
+    maxFx = _mm256_max_ps(_mm256_max_ps(x0, x1), _mm256_max_ps(x2, x3));
+    maxFy = _mm256_max_ps(_mm256_max_ps(y0, y1), _mm256_max_ps(y2, y3));
+  }
 
-    // If any W < 0, assume maxZ = 1 (effectively disabling Hi-Z)
-    if (possiblyNearClipped)
-    {
-      maxZ = _mm256_blendv_ps(maxZ, _mm256_set1_ps(1.0f), _mm256_or_ps(_mm256_or_ps(wSign0, wSign1), _mm256_or_ps(wSign2, wSign3)));
-    }
+  // Clamp and round
+  __m256i minX, minY, maxX, maxY;
+  minX = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_add_ps(minFx, _mm256_set1_ps(4.9999f / 8.0f))), _mm256_setzero_si256());
+  minY = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_add_ps(minFy, _mm256_set1_ps(4.9999f / 8.0f))), _mm256_setzero_si256());
+  maxX = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFx, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(m_blocksX));
+  maxY = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFy, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(m_blocksY));
 
-    __m128i packedDepthBounds = packDepthPremultiplied(maxZ);
+  // Check overlap between bounding box and frustum
+  __m256i inFrustum = _mm256_and_si256(_mm256_cmpgt_epi32(maxX, minX), _mm256_cmpgt_epi32(maxY, minY));
+  primitiveValid = _mm256_and_si256(inFrustum, primitiveValid);
 
-    uint16_t depthBounds[8];
-    _mm_storeu_si128(reinterpret_cast<__m128i*>(depthBounds), packedDepthBounds);
+  if (_mm256_testz_si256(primitiveValid, primitiveValid))
+  {
+    return 0;
+  }
 
-    // Compute screen space depth plane
-    __m256 greaterArea = _mm256_cmp_ps(_mm256_andnot_ps(minusZero256, area0), _mm256_andnot_ps(minusZero256, area2), _CMP_LT_OQ);
+  // Convert bounds from [min, max] to [min, range]
+  __m256i rangeX = _mm256_sub_epi32(maxX, minX);
+  __m256i rangeY = _mm256_sub_epi32(maxY, minY);
 
-    // Force triangle area to be picked in the relevant mode.
-    __m256 modeTriangle0 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(modes, _mm256_set1_epi32(Triangle0)));
-    __m256 modeTriangle1 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(modes, _mm256_set1_epi32(Triangle1)));
-    greaterArea = _mm256_andnot_ps(modeTriangle0, _mm256_or_ps(modeTriangle1, greaterArea));
+  // Compute Z from linear relation with 1/W
+  __m256 z0, z1, z2, z3;
+  __m256 C0 = _mm256_broadcast_ss(&c0);
+  __m256 C1 = _mm256_broadcast_ss(&c1);
+  z0 = _mm256_fmadd_ps(invW0, C1, C0);
+  z1 = _mm256_fmadd_ps(invW1, C1, C0);
+  z2 = _mm256_fmadd_ps(invW2, C1, C0);
+  z3 = _mm256_fmadd_ps(invW3, C1, C0);
 
+  __m256 maxZ = _mm256_max_ps(_mm256_max_ps(z0, z1), _mm256_max_ps(z2, z3));
 
-    __m256 invArea;
-    if (possiblyNearClipped)
-    {
-      // Do a precise divison to reduce error in depth plane. Note that the area computed here
-      // differs from the rasterized region if W < 0, so it can be very small for large covered screen regions.
-      invArea = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_blendv_ps(area0, area2, greaterArea));
-    }
-    else
-    {
-      invArea = _mm256_rcp_ps(_mm256_blendv_ps(area0, area2, greaterArea));
-    }
+  // If any W < 0, assume maxZ = 1 (effectively disabling Hi-Z)
+  if (possiblyNearClipped)
+  {
+    maxZ = _mm256_blendv_ps(maxZ, _mm256_set1_ps(1.0f), _mm256_or_ps(_mm256_or_ps(wSign0, wSign1), _mm256_or_ps(wSign2, wSign3)));
+  }
 
-    __m256 z12 = _mm256_sub_ps(z1, z2);
-    __m256 z20 = _mm256_sub_ps(z2, z0);
-    __m256 z30 = _mm256_sub_ps(z3, z0);
+  __m128i packedDepthBounds = packDepthPremultiplied(maxZ);
 
+  uint16_t depthBounds[8];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(depthBounds), packedDepthBounds);
 
-    __m256 edgeNormalsX4 = _mm256_sub_ps(y0, y2);
-    __m256 edgeNormalsY4 = _mm256_sub_ps(x2, x0);
+  // Compute screen space depth plane
+  __m256 greaterArea = _mm256_cmp_ps(_mm256_andnot_ps(minusZero256, area0), _mm256_andnot_ps(minusZero256, area2), _CMP_LT_OQ);
 
-    __m256 depthPlane0, depthPlane1, depthPlane2;
-    depthPlane1 = _mm256_mul_ps(invArea, _mm256_blendv_ps(_mm256_fmsub_ps(z20, edgeNormalsX1, _mm256_mul_ps(z12, edgeNormalsX4)), _mm256_fnmadd_ps(z20, edgeNormalsX3, _mm256_mul_ps(z30, edgeNormalsX4)), greaterArea));
-    depthPlane2 = _mm256_mul_ps(invArea, _mm256_blendv_ps(_mm256_fmsub_ps(z20, edgeNormalsY1, _mm256_mul_ps(z12, edgeNormalsY4)), _mm256_fnmadd_ps(z20, edgeNormalsY3, _mm256_mul_ps(z30, edgeNormalsY4)), greaterArea));
+  // Force triangle area to be picked in the relevant mode.
+  __m256 modeTriangle0 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(modes, _mm256_set1_epi32(Triangle0)));
+  __m256 modeTriangle1 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(modes, _mm256_set1_epi32(Triangle1)));
+  greaterArea = _mm256_andnot_ps(modeTriangle0, _mm256_or_ps(modeTriangle1, greaterArea));
 
-    x0 = _mm256_sub_ps(x0, _mm256_cvtepi32_ps(minX));
-    y0 = _mm256_sub_ps(y0, _mm256_cvtepi32_ps(minY));
 
-    depthPlane0 = _mm256_fnmadd_ps(x0, depthPlane1, _mm256_fnmadd_ps(y0, depthPlane2, z0));
+  __m256 invArea;
+  if (possiblyNearClipped)
+  {
+    // Do a precise divison to reduce error in depth plane. Note that the area computed here
+    // differs from the rasterized region if W < 0, so it can be very small for large covered screen regions.
+    invArea = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_blendv_ps(area0, area2, greaterArea));
+  }
+  else
+  {
+    invArea = _mm256_rcp_ps(_mm256_blendv_ps(area0, area2, greaterArea));
+  }
 
-    // If mode == Triangle0, replace edge 2 with edge 4; if mode == Triangle1, replace edge 0 with edge 4
-    edgeNormalsX2 = _mm256_blendv_ps(edgeNormalsX2, edgeNormalsX4, modeTriangle0);
-    edgeNormalsY2 = _mm256_blendv_ps(edgeNormalsY2, edgeNormalsY4, modeTriangle0);
-    edgeNormalsX0 = _mm256_blendv_ps(edgeNormalsX0, _mm256_xor_ps(minusZero256, edgeNormalsX4), modeTriangle1);
-    edgeNormalsY0 = _mm256_blendv_ps(edgeNormalsY0, _mm256_xor_ps(minusZero256, edgeNormalsY4), modeTriangle1);
+  __m256 z12 = _mm256_sub_ps(z1, z2);
+  __m256 z20 = _mm256_sub_ps(z2, z0);
+  __m256 z30 = _mm256_sub_ps(z3, z0);
 
-    // Flip edges if W < 0
-    __m256 edgeFlipMask0, edgeFlipMask1, edgeFlipMask2, edgeFlipMask3;
-    if (possiblyNearClipped)
-    {
-      edgeFlipMask0 = _mm256_xor_ps(wSign0, _mm256_blendv_ps(wSign1, wSign2, modeTriangle1));
-      edgeFlipMask1 = _mm256_xor_ps(wSign1, wSign2);
-      edgeFlipMask2 = _mm256_xor_ps(wSign2, _mm256_blendv_ps(wSign3, wSign0, modeTriangle0));
-      edgeFlipMask3 = _mm256_xor_ps(wSign0, wSign3);
-    }
-    else
-    {
-      edgeFlipMask0 = _mm256_setzero_ps();
-      edgeFlipMask1 = _mm256_setzero_ps();
-      edgeFlipMask2 = _mm256_setzero_ps();
-      edgeFlipMask3 = _mm256_setzero_ps();
-    }
 
-    // Normalize edge equations for lookup
-    normalizeEdge<possiblyNearClipped>(edgeNormalsX0, edgeNormalsY0, edgeFlipMask0);
-    normalizeEdge<possiblyNearClipped>(edgeNormalsX1, edgeNormalsY1, edgeFlipMask1);
-    normalizeEdge<possiblyNearClipped>(edgeNormalsX2, edgeNormalsY2, edgeFlipMask2);
-    normalizeEdge<possiblyNearClipped>(edgeNormalsX3, edgeNormalsY3, edgeFlipMask3);
+  __m256 edgeNormalsX4 = _mm256_sub_ps(y0, y2);
+  __m256 edgeNormalsY4 = _mm256_sub_ps(x2, x0);
 
-    const float maxOffset = -minEdgeOffset;
-    __m256 add256 = _mm256_set1_ps(0.5f - minEdgeOffset * (OFFSET_QUANTIZATION_FACTOR - 1) / (maxOffset - minEdgeOffset));
-    __m256 edgeOffsets0, edgeOffsets1, edgeOffsets2, edgeOffsets3;
+  __m256 depthPlane0, depthPlane1, depthPlane2;
+  depthPlane1 = _mm256_mul_ps(invArea, _mm256_blendv_ps(_mm256_fmsub_ps(z20, edgeNormalsX1, _mm256_mul_ps(z12, edgeNormalsX4)), _mm256_fnmadd_ps(z20, edgeNormalsX3, _mm256_mul_ps(z30, edgeNormalsX4)), greaterArea));
+  depthPlane2 = _mm256_mul_ps(invArea, _mm256_blendv_ps(_mm256_fmsub_ps(z20, edgeNormalsY1, _mm256_mul_ps(z12, edgeNormalsY4)), _mm256_fnmadd_ps(z20, edgeNormalsY3, _mm256_mul_ps(z30, edgeNormalsY4)), greaterArea));
 
-    edgeOffsets0 = _mm256_fnmadd_ps(x0, edgeNormalsX0, _mm256_fnmadd_ps(y0, edgeNormalsY0, add256));
-    edgeOffsets1 = _mm256_fnmadd_ps(x1, edgeNormalsX1, _mm256_fnmadd_ps(y1, edgeNormalsY1, add256));
-    edgeOffsets2 = _mm256_fnmadd_ps(x2, edgeNormalsX2, _mm256_fnmadd_ps(y2, edgeNormalsY2, add256));
-    edgeOffsets3 = _mm256_fnmadd_ps(x3, edgeNormalsX3, _mm256_fnmadd_ps(y3, edgeNormalsY3, add256));
+  x0 = _mm256_sub_ps(x0, _mm256_cvtepi32_ps(minX));
+  y0 = _mm256_sub_ps(y0, _mm256_cvtepi32_ps(minY));
 
-    edgeOffsets1 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(minX), edgeNormalsX1, edgeOffsets1);
-    edgeOffsets2 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(minX), edgeNormalsX2, edgeOffsets2);
-    edgeOffsets3 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(minX), edgeNormalsX3, edgeOffsets3);
+  depthPlane0 = _mm256_fnmadd_ps(x0, depthPlane1, _mm256_fnmadd_ps(y0, depthPlane2, z0));
 
-    edgeOffsets1 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(minY), edgeNormalsY1, edgeOffsets1);
-    edgeOffsets2 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(minY), edgeNormalsY2, edgeOffsets2);
-    edgeOffsets3 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(minY), edgeNormalsY3, edgeOffsets3);
+  // If mode == Triangle0, replace edge 2 with edge 4; if mode == Triangle1, replace edge 0 with edge 4
+  edgeNormalsX2 = _mm256_blendv_ps(edgeNormalsX2, edgeNormalsX4, modeTriangle0);
+  edgeNormalsY2 = _mm256_blendv_ps(edgeNormalsY2, edgeNormalsY4, modeTriangle0);
+  edgeNormalsX0 = _mm256_blendv_ps(edgeNormalsX0, _mm256_xor_ps(minusZero256, edgeNormalsX4), modeTriangle1);
+  edgeNormalsY0 = _mm256_blendv_ps(edgeNormalsY0, _mm256_xor_ps(minusZero256, edgeNormalsY4), modeTriangle1);
 
-    // Quantize slopes
-    __m256i slopeLookups0, slopeLookups1, slopeLookups2, slopeLookups3;
-    slopeLookups0 = quantizeSlopeLookup(edgeNormalsX0, edgeNormalsY0);
-    slopeLookups1 = quantizeSlopeLookup(edgeNormalsX1, edgeNormalsY1);
-    slopeLookups2 = quantizeSlopeLookup(edgeNormalsX2, edgeNormalsY2);
-    slopeLookups3 = quantizeSlopeLookup(edgeNormalsX3, edgeNormalsY3);
+  // Flip edges if W < 0
+  __m256 edgeFlipMask0, edgeFlipMask1, edgeFlipMask2, edgeFlipMask3;
+  if (possiblyNearClipped)
+  {
+    edgeFlipMask0 = _mm256_xor_ps(wSign0, _mm256_blendv_ps(wSign1, wSign2, modeTriangle1));
+    edgeFlipMask1 = _mm256_xor_ps(wSign1, wSign2);
+    edgeFlipMask2 = _mm256_xor_ps(wSign2, _mm256_blendv_ps(wSign3, wSign0, modeTriangle0));
+    edgeFlipMask3 = _mm256_xor_ps(wSign0, wSign3);
+  }
+  else
+  {
+    edgeFlipMask0 = _mm256_setzero_ps();
+    edgeFlipMask1 = _mm256_setzero_ps();
+    edgeFlipMask2 = _mm256_setzero_ps();
+    edgeFlipMask3 = _mm256_setzero_ps();
+  }
 
-    __m256i firstBlockIdx = _mm256_add_epi32(_mm256_mullo_epi16(minY, _mm256_set1_epi32(m_blocksX)), minX);
+  // Normalize edge equations for lookup
+  normalizeEdge<possiblyNearClipped>(edgeNormalsX0, edgeNormalsY0, edgeFlipMask0);
+  normalizeEdge<possiblyNearClipped>(edgeNormalsX1, edgeNormalsY1, edgeFlipMask1);
+  normalizeEdge<possiblyNearClipped>(edgeNormalsX2, edgeNormalsY2, edgeFlipMask2);
+  normalizeEdge<possiblyNearClipped>(edgeNormalsX3, edgeNormalsY3, edgeFlipMask3);
 
-    uint32_t firstBlocks[8];
-    _mm256_storeu_si256(reinterpret_cast<__m256i*>(firstBlocks), firstBlockIdx);
+  const float maxOffset = -minEdgeOffset;
+  __m256 add256 = _mm256_set1_ps(0.5f - minEdgeOffset * (OFFSET_QUANTIZATION_FACTOR - 1) / (maxOffset - minEdgeOffset));
+  __m256 edgeOffsets0, edgeOffsets1, edgeOffsets2, edgeOffsets3;
 
-    uint32_t rangesX[8];
-    _mm256_storeu_si256(reinterpret_cast<__m256i*>(rangesX), rangeX);
+  edgeOffsets0 = _mm256_fnmadd_ps(x0, edgeNormalsX0, _mm256_fnmadd_ps(y0, edgeNormalsY0, add256));
+  edgeOffsets1 = _mm256_fnmadd_ps(x1, edgeNormalsX1, _mm256_fnmadd_ps(y1, edgeNormalsY1, add256));
+  edgeOffsets2 = _mm256_fnmadd_ps(x2, edgeNormalsX2, _mm256_fnmadd_ps(y2, edgeNormalsY2, add256));
+  edgeOffsets3 = _mm256_fnmadd_ps(x3, edgeNormalsX3, _mm256_fnmadd_ps(y3, edgeNormalsY3, add256));
 
-    uint32_t rangesY[8];
-    _mm256_storeu_si256(reinterpret_cast<__m256i*>(rangesY), rangeY);
+  edgeOffsets1 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(minX), edgeNormalsX1, edgeOffsets1);
+  edgeOffsets2 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(minX), edgeNormalsX2, edgeOffsets2);
+  edgeOffsets3 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(minX), edgeNormalsX3, edgeOffsets3);
 
-    // Transpose into AoS
-    __m128 depthPlane[8];
-    transpose256(depthPlane0, depthPlane1, depthPlane2, _mm256_setzero_ps(), depthPlane);
+  edgeOffsets1 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(minY), edgeNormalsY1, edgeOffsets1);
+  edgeOffsets2 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(minY), edgeNormalsY2, edgeOffsets2);
+  edgeOffsets3 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(minY), edgeNormalsY3, edgeOffsets3);
 
-    __m128 edgeNormalsX[8];
-    transpose256(edgeNormalsX0, edgeNormalsX1, edgeNormalsX2, edgeNormalsX3, edgeNormalsX);
+  // Quantize slopes
+  __m256i slopeLookups0, slopeLookups1, slopeLookups2, slopeLookups3;
+  slopeLookups0 = quantizeSlopeLookup(edgeNormalsX0, edgeNormalsY0);
+  slopeLookups1 = quantizeSlopeLookup(edgeNormalsX1, edgeNormalsY1);
+  slopeLookups2 = quantizeSlopeLookup(edgeNormalsX2, edgeNormalsY2);
+  slopeLookups3 = quantizeSlopeLookup(edgeNormalsX3, edgeNormalsY3);
 
-    __m128 edgeNormalsY[8];
-    transpose256(edgeNormalsY0, edgeNormalsY1, edgeNormalsY2, edgeNormalsY3, edgeNormalsY);
+  uint32_t minsX[8];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(minsX), minX);
 
-    __m128 edgeOffsets[8];
-    transpose256(edgeOffsets0, edgeOffsets1, edgeOffsets2, edgeOffsets3, edgeOffsets);
+  uint32_t minsY[8];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(minsY), minY);
 
-    __m128i slopeLookups[8];
-    transpose256i(slopeLookups0, slopeLookups1, slopeLookups2, slopeLookups3, slopeLookups);
+  uint32_t rangesX[8];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(rangesX), rangeX);
 
-    uint32_t validMask = _mm256_movemask_ps(_mm256_castsi256_ps(primitiveValid));
+  uint32_t rangesY[8];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(rangesY), rangeY);
 
-    // Fetch data pointers since we'll manually strength-reduce memory arithmetic
-    const int64_t* pTable = &*m_precomputedRasterTables.begin();
-    uint16_t* pHiZBuffer = &*m_hiZ.begin();
-    __m128i* pDepthBuffer = &*m_depthBuffer.begin();
+  // Transpose into AoS
+  __m128 depthPlane[8];
+  transpose256(depthPlane0, depthPlane1, depthPlane2, _mm256_setzero_ps(), depthPlane);
 
-    // Loop over set bits
-    unsigned long primitiveIdx;
-    while (_BitScanForward(&primitiveIdx, validMask))
-    {
-      // Clear lowest set bit in mask
-      validMask &= validMask - 1;
+  __m128 edgeNormalsX[8];
+  transpose256(edgeNormalsX0, edgeNormalsX1, edgeNormalsX2, edgeNormalsX3, edgeNormalsX);
+
+  __m128 edgeNormalsY[8];
+  transpose256(edgeNormalsY0, edgeNormalsY1, edgeNormalsY2, edgeNormalsY3, edgeNormalsY);
+
+  __m128 edgeOffsets[8];
+  transpose256(edgeOffsets0, edgeOffsets1, edgeOffsets2, edgeOffsets3, edgeOffsets);
+
+  __m128i slopeLookups[8];
+  transpose256i(slopeLookups0, slopeLookups1, slopeLookups2, slopeLookups3, slopeLookups);
+
+  uint32_t validMask = _mm256_movemask_ps(_mm256_castsi256_ps(primitiveValid));
+
+  // Loop over set bits
+  uint32_t numPrimitives = 0;
+  unsigned long primitiveIdx;
+  while (_BitScanForward(&primitiveIdx, validMask))
+  {
+    // Clear lowest set bit in mask
+    validMask &= validMask - 1;
+
+    uint32_t primitiveIdxTransposed = ((primitiveIdx << 1) & 7) | (primitiveIdx >> 2);
+
+    Primitive& primitive = primitives[numPrimitives++];
+    primitive.m_depthPlane = depthPlane[primitiveIdxTransposed];
+    primitive.m_edgeNormalX = edgeNormalsX[primitiveIdxTransposed];
+    primitive.m_edgeNormalY = edgeNormalsY[primitiveIdxTransposed];
+    primitive.m_edgeOffset = edgeOffsets[primitiveIdxTransposed];
+    primitive.m_slopeLookup = slopeLookups[primitiveIdxTransposed];
+    primitive.m_blockMinX = minsX[primitiveIdx];
+    primitive.m_blockMinY = minsY[primitiveIdx];
+    primitive.m_blockRangeX = rangesX[primitiveIdx];
+    primitive.m_blockRangeY = rangesY[primitiveIdx];
+    primitive.m_mode = primModes[primitiveIdx];
+    primitive.m_maxZ = depthBounds[primitiveIdx];
+  }
 
-      uint32_t primitiveIdxTransposed = ((primitiveIdx << 1) & 7) | (primitiveIdx >> 2);
+  return numPrimitives;
+}
+
+template <bool possiblyNearClipped>
+void Rasterizer::rasterizePrimitive(const Primitive& primitive, uint32_t blockMinY, uint32_t blockMaxY)
+{
+  // Only the block rows of the primitive that lie within [blockMinY, blockMaxY) are rasterized
+  const uint32_t primitiveMinY = std::max(primitive.m_blockMinY, blockMinY);
+  const uint32_t primitiveMaxY = std::min(primitive.m_blockMinY + primitive.m_blockRangeY, blockMaxY);
+  if (primitiveMinY >= primitiveMaxY)
+  {
+    return;
+  }
+
+  const __m128 skippedRows = _mm_set1_ps(float(primitiveMinY - primitive.m_blockMinY));
 
-      // Extract and prepare per-primitive data
-      uint16_t primitiveMaxZ = depthBounds[primitiveIdx];
+  // Fetch data pointers since we'll manually strength-reduce memory arithmetic
+  const int64_t* pTable = &*m_precomputedRasterTables.begin();
+  uint16_t* pHiZBuffer = &*m_hiZ.begin();
+  __m128i* pDepthBuffer = &*m_depthBuffer.begin();
 
-      __m256 depthDx = _mm256_broadcastss_ps(_mm_permute_ps(depthPlane[primitiveIdxTransposed], _MM_SHUFFLE(1, 1, 1, 1)));
-      __m256 depthDy = _mm256_broadcastss_ps(_mm_permute_ps(depthPlane[primitiveIdxTransposed], _MM_SHUFFLE(2, 2, 2, 2)));
+  // Extract and prepare per-primitive data
+  uint16_t primitiveMaxZ = primitive.m_maxZ;
 
-      const float depthSamplePos = -0.5f + 1.0f / 16.0f;
-      __m256 lineDepth =
-        _mm256_fmadd_ps(depthDx, _mm256_setr_ps(depthSamplePos + 0.0f, depthSamplePos + 0.125f, depthSamplePos + 0.25f, depthSamplePos + 0.375f, depthSamplePos + 0.0f, depthSamplePos + 0.125f, depthSamplePos + 0.25f, depthSamplePos + 0.375f),
-          _mm256_fmadd_ps(depthDy, _mm256_setr_ps(depthSamplePos + 0.0f, depthSamplePos + 0.0f, depthSamplePos + 0.0f, depthSamplePos + 0.0f, depthSamplePos + 0.125f, depthSamplePos + 0.125f, depthSamplePos + 0.125f, depthSamplePos + 0.125f),
-            _mm256_broadcastss_ps(depthPlane[primitiveIdxTransposed])));
+  __m256 depthDx = _mm256_broadcastss_ps(_mm_permute_ps(primitive.m_depthPlane, _MM_SHUFFLE(1, 1, 1, 1)));
+  __m256 depthDy = _mm256_broadcastss_ps(_mm_permute_ps(primitive.m_depthPlane, _MM_SHUFFLE(2, 2, 2, 2)));
 
-      __m128i slopeLookup = slopeLookups[primitiveIdxTransposed];
-      __m128 edgeNormalX = edgeNormalsX[primitiveIdxTransposed];
-      __m128 edgeNormalY = edgeNormalsY[primitiveIdxTransposed];
-      __m128 lineOffset = edgeOffsets[primitiveIdxTransposed];
+  const float depthSamplePos = -0.5f + 1.0f / 16.0f;
+  __m256 lineDepth =
+    _mm256_fmadd_ps(depthDx, _mm256_setr_ps(depthSamplePos + 0.0f, depthSamplePos + 0.125f, depthSamplePos + 0.25f, depthSamplePos + 0.375f, depthSamplePos + 0.0f, depthSamplePos + 0.125f, depthSamplePos + 0.25f, depthSamplePos + 0.375f),
+      _mm256_fmadd_ps(depthDy, _mm256_setr_ps(depthSamplePos + 0.0f, depthSamplePos + 0.0f, depthSamplePos + 0.0f, depthSamplePos + 0.0f, depthSamplePos + 0.125f, depthSamplePos + 0.125f, depthSamplePos + 0.125f, depthSamplePos + 0.125f),
+        _mm256_broadcastss_ps(primitive.m_depthPlane)));
 
-      const uint32_t blocksX = m_blocksX;
+  __m128i slopeLookup = primitive.m_slopeLookup;
+  __m128 edgeNormalX = primitive.m_edgeNormalX;
+  __m128 edgeNormalY = primitive.m_edgeNormalY;
+  __m128 lineOffset = primitive.m_edgeOffset;
 
-      const uint32_t firstBlock = firstBlocks[primitiveIdx];
-      const uint32_t blockRangeX = rangesX[primitiveIdx];
-      const uint32_t blockRangeY = rangesY[primitiveIdx];
+  // Advance the depth and the edge offsets to the first rasterized block row
+  lineDepth = _mm256_fmadd_ps(depthDy, _mm256_set_m128(skippedRows, skippedRows), lineDepth);
+  lineOffset = _mm_fmadd_ps(edgeNormalY, skippedRows, lineOffset);
 
-      uint16_t* pPrimitiveHiZ = pHiZBuffer + firstBlock;
-      __m256i* pPrimitiveOut = reinterpret_cast<__m256i*>(pDepthBuffer) + 4 * firstBlock;
+  const uint32_t blocksX = m_blocksX;
 
-      uint32_t primitiveMode = primModes[primitiveIdx];
+  const uint32_t firstBlock = primitiveMinY * blocksX + primitive.m_blockMinX;
+  const uint32_t blockRangeX = primitive.m_blockRangeX;
+  const uint32_t blockRangeY = primitiveMaxY - primitiveMinY;
 
-      for (uint32_t blockY = 0;
-           blockY < blockRangeY;
-           ++blockY,
-                    pPrimitiveHiZ += blocksX,
-                    pPrimitiveOut += 4 * blocksX,
-                    lineDepth = _mm256_add_ps(lineDepth, depthDy),
-                    lineOffset = _mm_add_ps(lineOffset, edgeNormalY))
+  uint16_t* pPrimitiveHiZ = pHiZBuffer + firstBlock;
+  __m256i* pPrimitiveOut = reinterpret_cast<__m256i*>(pDepthBuffer) + 4 * firstBlock;
+
+  uint32_t primitiveMode = primitive.m_mode;
+
+  for (uint32_t blockY = 0;
+       blockY < blockRangeY;
+       ++blockY,
+                pPrimitiveHiZ += blocksX,
+                pPrimitiveOut += 4 * blocksX,
+                lineDepth = _mm256_add_ps(lineDepth, depthDy),
+                lineOffset = _mm_add_ps(lineOffset, edgeNormalY))
+  {
+    uint16_t* pBlockRowHiZ = pPrimitiveHiZ;
+    __m256i* out = pPrimitiveOut;
+
+    __m128 offset = lineOffset;
+    __m256 depth = lineDepth;
+
+    bool anyBlockHit = false;
+    for (uint32_t blockX = 0;
+         blockX < blockRangeX;
+         ++blockX,
+                  pBlockRowHiZ += 1,
+                  out += 4,
+                  depth = _mm256_add_ps(depthDx, depth),
+                  offset = _mm_add_ps(edgeNormalX, offset))
+    {
+      uint16_t hiZ = *pBlockRowHiZ;
+      if (hiZ >= primitiveMaxZ)
       {
-        uint16_t* pBlockRowHiZ = pPrimitiveHiZ;
-        __m256i* out = pPrimitiveOut;
-
-        __m128 offset = lineOffset;
-        __m256 depth = lineDepth;
-
-        bool anyBlockHit = false;
-        for (uint32_t blockX = 0;
-             blockX < blockRangeX;
-             ++blockX,
-                      pBlockRowHiZ += 1,
-                      out += 4,
-                      depth = _mm256_add_ps(depthDx, depth),
-                      offset = _mm_add_ps(edgeNormalX, offset))
+        continue;
+      }
+
+      uint64_t blockMask;
+      if (primitiveMode == Convex) // 83-97%
+      {
+        // Simplified conservative test: combined block mask will be zero if any offset is outside of range
+        __m128 anyOffsetOutsideMask = _mm_cmpge_ps(offset, _mm_set1_ps(OFFSET_QUANTIZATION_FACTOR - 1));
+        if (!_mm_testz_ps(anyOffsetOutsideMask, anyOffsetOutsideMask))
         {
-          uint16_t hiZ = *pBlockRowHiZ;
-          if (hiZ >= primitiveMaxZ)
+          if (anyBlockHit)
           {
-            continue;
+            // Convexity implies we won't hit another block in this row and can skip to the next line.
+            break;
           }
+          continue;
+        }
 
-          uint64_t blockMask;
-          if (primitiveMode == Convex) // 83-97%
-          {
-            // Simplified conservative test: combined block mask will be zero if any offset is outside of range
-            __m128 anyOffsetOutsideMask = _mm_cmpge_ps(offset, _mm_set1_ps(OFFSET_QUANTIZATION_FACTOR - 1));
-            if (!_mm_testz_ps(anyOffsetOutsideMask, anyOffsetOutsideMask))
-            {
-              if (anyBlockHit)
-              {
-                // Convexity implies we won't hit another block in this row and can skip to the next line.
-                break;
-              }
-              continue;
-            }
+        anyBlockHit = true;
 
-            anyBlockHit = true;
+        __m128i offsetClamped = _mm_max_epi32(_mm_cvttps_epi32(offset), _mm_setzero_si128());
 
-            __m128i offsetClamped = _mm_max_epi32(_mm_cvttps_epi32(offset), _mm_setzero_si128());
+        static uint64_t totalBlocks = 0;
+        static uint64_t containedBlocks = 0;
 
-            static uint64_t totalBlocks = 0;
-            static uint64_t containedBlocks = 0;
+        __m128i lookup = _mm_or_si128(slopeLookup, offsetClamped);
 
-            __m128i lookup = _mm_or_si128(slopeLookup, offsetClamped);
+        // Generate block mask
+        uint64_t A = pTable[uint32_t(_mm_cvtsi128_si32(lookup))];
+        uint64_t B = pTable[uint32_t(_mm_extract_epi32(lookup, 1))];
+        uint64_t C = pTable[uint32_t(_mm_extract_epi32(lookup, 2))];
+        uint64_t D = pTable[uint32_t(_mm_extract_epi32(lookup, 3))];
 
-            // Generate block mask
-            uint64_t A = pTable[uint32_t(_mm_cvtsi128_si32(lookup))];
-            uint64_t B = pTable[uint32_t(_mm_extract_epi32(lookup, 1))];
-            uint64_t C = pTable[uint32_t(_mm_extract_epi32(lookup, 2))];
-            uint64_t D = pTable[uint32_t(_mm_extract_epi32(lookup, 3))];
+        blockMask = (A & B) & (C & D);
 
-            blockMask = (A & B) & (C & D);
+        // It is possible but very unlikely that blockMask == 0 if all A,B,C,D != 0 according to the conservative test above, so we skip the additional branch here.
+      }
+      else
+      {
+        __m128i offsetClamped = _mm_min_epi32(_mm_max_epi32(_mm_cvttps_epi32(offset), _mm_setzero_si128()), _mm_set1_epi32(OFFSET_QUANTIZATION_FACTOR - 1));
+        __m128i lookup = _mm_or_si128(slopeLookup, offsetClamped);
+
+        // Generate block mask
+        uint64_t A = pTable[uint32_t(_mm_cvtsi128_si32(lookup))];
+        uint64_t B = pTable[uint32_t(_mm_extract_epi32(lookup, 1))];
+        uint64_t C = pTable[uint32_t(_mm_extract_epi32(lookup, 2))];
+        uint64_t D = pTable[uint32_t(_mm_extract_epi32(lookup, 3))];
+
+        // Switch over primitive mode. MSVC compiles this as a "sub eax, 1; jz label;" ladder, so the mode enum is ordered by descending frequency of occurence
+        // to optimize branch efficiency. By ensuring we have a default case that falls through to the last possible value (ConcaveLeft if not near clipped,
+        // ConcaveCenter otherwise) we avoid the last branch in the ladder.
+        switch (primitiveMode)
+        {
+          case Triangle0: // 2.3-11%
+            blockMask = A & B & C;
+            break;
 
-            // It is possible but very unlikely that blockMask == 0 if all A,B,C,D != 0 according to the conservative test above, so we skip the additional branch here.
-          }
-          else
-          {
-            __m128i offsetClamped = _mm_min_epi32(_mm_max_epi32(_mm_cvttps_epi32(offset), _mm_setzero_si128()), _mm_set1_epi32(OFFSET_QUANTIZATION_FACTOR - 1));
-            __m128i lookup = _mm_or_si128(slopeLookup, offsetClamped);
-
-            // Generate block mask
-            uint64_t A = pTable[uint32_t(_mm_cvtsi128_si32(lookup))];
-            uint64_t B = pTable[uint32_t(_mm_extract_epi32(lookup, 1))];
-            uint64_t C = pTable[uint32_t(_mm_extract_epi32(lookup, 2))];
-            uint64_t D = pTable[uint32_t(_mm_extract_epi32(lookup, 3))];
-
-            // Switch over primitive mode. MSVC compiles this as a "sub eax, 1; jz label;" ladder, so the mode enum is ordered by descending frequency of occurence
-            // to optimize branch efficiency. By ensuring we have a default case that falls through to the last possible value (ConcaveLeft if not near clipped,
-            // ConcaveCenter otherwise) we avoid the last branch in the ladder.
-            switch (primitiveMode)
+          case Triangle1: // 0.1-4%
+            blockMask = A & C & D;
+            break;
+
+          case ConcaveRight: // 0.01-0.9%
+            blockMask = (A | D) & (B & C);
+            break;
+
+          default:
+            // Case ConcaveCenter can only occur if any W < 0
+            if (possiblyNearClipped)
             {
-              case Triangle0: // 2.3-11%
-                blockMask = A & B & C;
-                break;
-
-              case Triangle1: // 0.1-4%
-                blockMask = A & C & D;
-                break;
-
-              case ConcaveRight: // 0.01-0.9%
-                blockMask = (A | D) & (B & C);
-                break;
-
-              default:
-                // Case ConcaveCenter can only occur if any W < 0
-                if (possiblyNearClipped)
-                {
-                  // case ConcaveCenter:			// < 1e-6%
-                  blockMask = (A & B) | (C & D);
-                  break;
-                }
-                else
-                {
-                  // Fall-through
-                }
-
-              case ConcaveLeft: // 0.01-0.6%
-                blockMask = (A & D) & (B | C);
-                break;
+              // case ConcaveCenter:			// < 1e-6%
+              blockMask = (A & B) | (C & D);
+              break;
             }
-
-            // No pixels covered => skip block
-            if (!blockMask)
+            else
             {
-              continue;
+              // Fall-through
             }
-          }
-
-          // Generate depth values around block
-          __m256 depth0 = depth;
-          __m256 depth1 = _mm256_fmadd_ps(depthDx, _mm256_set1_ps(0.5f), depth0);
-          __m256 depth8 = _mm256_add_ps(depthDy, depth0);
-          __m256 depth9 = _mm256_add_ps(depthDy, depth1);
 
-          // Pack depth
-          __m256i d0 = packDepthPremultiplied(depth0, depth1);
-          __m256i d4 = packDepthPremultiplied(depth8, depth9);
+          case ConcaveLeft: // 0.01-0.6%
+            blockMask = (A & D) & (B | C);
+            break;
+        }
 
-          // Interpolate remaining values in packed space
-          __m256i d2 = _mm256_avg_epu16(d0, d4);
-          __m256i d1 = _mm256_avg_epu16(d0, d2);
-          __m256i d3 = _mm256_avg_epu16(d2, d4);
+        // No pixels covered => skip block
+        if (!blockMask)
+        {
+          continue;
+        }
+      }
 
-          // Not all pixels covered - mask depth
-          if (blockMask != -1)
-          {
-            __m128i A = _mm_cvtsi64x_si128(blockMask);
-            __m128i B = _mm_slli_epi64(A, 4);
-            __m256i C = _mm256_inserti128_si256(_mm256_castsi128_si256(A), B, 1);
-            __m256i rowMask = _mm256_unpacklo_epi8(C, C);
-
-            d0 = _mm256_blendv_epi8(_mm256_setzero_si256(), d0, _mm256_slli_epi16(rowMask, 3));
-            d1 = _mm256_blendv_epi8(_mm256_setzero_si256(), d1, _mm256_slli_epi16(rowMask, 2));
-            d2 = _mm256_blendv_epi8(_mm256_setzero_si256(), d2, _mm256_add_epi16(rowMask, rowMask));
-            d3 = _mm256_blendv_epi8(_mm256_setzero_si256(), d3, rowMask);
-          }
+      // Generate depth values around block
+      __m256 depth0 = depth;
+      __m256 depth1 = _mm256_fmadd_ps(depthDx, _mm256_set1_ps(0.5f), depth0);
+      __m256 depth8 = _mm256_add_ps(depthDy, depth0);
+      __m256 depth9 = _mm256_add_ps(depthDy, depth1);
 
-          // Test fast clear flag
-          if (hiZ != 1)
-          {
-            // Merge depth values
-            d0 = _mm256_max_epu16(_mm256_load_si256(out + 0), d0);
-            d1 = _mm256_max_epu16(_mm256_load_si256(out + 1), d1);
-            d2 = _mm256_max_epu16(_mm256_load_si256(out + 2), d2);
-            d3 = _mm256_max_epu16(_mm256_load_si256(out + 3), d3);
-          }
+      // Pack depth
+      __m256i d0 = packDepthPremultiplied(depth0, depth1);
+      __m256i d4 = packDepthPremultiplied(depth8, depth9);
 
-          // Store back new depth
-          _mm256_store_si256(out + 0, d0);
-          _mm256_store_si256(out + 1, d1);
-          _mm256_store_si256(out + 2, d2);
-          _mm256_store_si256(out + 3, d3);
+      // Interpolate remaining values in packed space
+      __m256i d2 = _mm256_avg_epu16(d0, d4);
+      __m256i d1 = _mm256_avg_epu16(d0, d2);
+      __m256i d3 = _mm256_avg_epu16(d2, d4);
 
-          // Update HiZ
-          __m256i newMinZ = _mm256_min_epu16(_mm256_min_epu16(d0, d1), _mm256_min_epu16(d2, d3));
-          __m128i newMinZ16 = _mm_minpos_epu16(_mm_min_epu16(_mm256_castsi256_si128(newMinZ), _mm256_extracti128_si256(newMinZ, 1)));
+      // Not all pixels covered - mask depth
+      if (blockMask != -1)
+      {
+        __m128i A = _mm_cvtsi64x_si128(blockMask);
+        __m128i B = _mm_slli_epi64(A, 4);
+        __m256i C = _mm256_inserti128_si256(_mm256_castsi128_si256(A), B, 1);
+        __m256i rowMask = _mm256_unpacklo_epi8(C, C);
+
+        d0 = _mm256_blendv_epi8(_mm256_setzero_si256(), d0, _mm256_slli_epi16(rowMask, 3));
+        d1 = _mm256_blendv_epi8(_mm256_setzero_si256(), d1, _mm256_slli_epi16(rowMask, 2));
+        d2 = _mm256_blendv_epi8(_mm256_setzero_si256(), d2, _mm256_add_epi16(rowMask, rowMask));
+        d3 = _mm256_blendv_epi8(_mm256_setzero_si256(), d3, rowMask);
+      }
 
-          *pBlockRowHiZ = uint16_t(uint32_t(_mm_cvtsi128_si32(newMinZ16)));
-        }
+      // Test fast clear flag
+      if (hiZ != 1)
+      {
+        // Merge depth values
+        d0 = _mm256_max_epu16(_mm256_load_si256(out + 0), d0);
+        d1 = _mm256_max_epu16(_mm256_load_si256(out + 1), d1);
+        d2 = _mm256_max_epu16(_mm256_load_si256(out + 2), d2);
+        d3 = _mm256_max_epu16(_mm256_load_si256(out + 3), d3);
       }
+
+      // Store back new depth
+      _mm256_store_si256(out + 0, d0);
+      _mm256_store_si256(out + 1, d1);
+      _mm256_store_si256(out + 2, d2);
+      _mm256_store_si256(out + 3, d3);
+
+      // Update HiZ
+      __m256i newMinZ = _mm256_min_epu16(_mm256_min_epu16(d0, d1), _mm256_min_epu16(d2, d3));
+      __m128i newMinZ16 = _mm_minpos_epu16(_mm_min_epu16(_mm256_castsi256_si128(newMinZ), _mm256_extracti128_si256(newMinZ, 1)));
+
+      *pBlockRowHiZ = uint16_t(uint32_t(_mm_cvtsi128_si32(newMinZ16)));
     }
   }
 }
 
+template <bool possiblyNearClipped>
+void Rasterizer::rasterize(const Occluder& occluder)
+{
+  OccluderTransform transform;
+  prepareOccluderTransform(occluder, m_modelViewProjection, transform);
+
+  Primitive primitives[8];
+
+  for (uint32_t packetIdx = 0; packetIdx < occluder.m_packetCount; packetIdx += 4)
+  {
+    const uint32_t numPrimitives = setupPacket<possiblyNearClipped>(occluder.m_vertexData + packetIdx, transform, primitives);
+
+    for (uint32_t i = 0; i < numPrimitives; ++i)
+    {
+      rasterizePrimitive<possiblyNearClipped>(primitives[i], 0, m_blocksY);
+    }
+  }
+}
+
+uint32_t Rasterizer::getMaxPrimitiveCount(const Occluder& occluder)
+{
+  // every packet of four vertex registers holds eight quads
+  return occluder.m_packetCount * 2;
+}
+
+template <bool possiblyNearClipped>
+uint32_t Rasterizer::setupPrimitives(const Occluder& occluder, const float* bakedMatrix, Primitive* primitives) const
+{
+  OccluderTransform transform;
+  prepareOccluderTransform(occluder, bakedMatrix, transform);
+
+  uint32_t numPrimitives = 0;
+
+  for (uint32_t packetIdx = 0; packetIdx < occluder.m_packetCount; packetIdx += 4)
+  {
+    numPrimitives += setupPacket<possiblyNearClipped>(occluder.m_vertexData + packetIdx, transform, primitives + numPrimitives);
+  }
+
+  return numPrimitives;
+}
+
+template <bool possiblyNearClipped>
+void Rasterizer::rasterizePrimitives(const Primitive* primitives, const uint32_t* indices, uint32_t count, uint32_t blockMinY, uint32_t blockMaxY)
+{
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    rasterizePrimitive<possiblyNearClipped>(primitives[indices[i]], blockMinY, blockMaxY);
+  }
+}
+
 // Force template instantiations
 template void Rasterizer::rasterize<true>(const Occluder& occluder);
 template void Rasterizer::rasterize<false>(const Occluder& occluder);
+template uint32_t Rasterizer::setupPrimitives<true>(const Occluder& occluder, const float* bakedMatrix, Primitive* primitives) const;
+template uint32_t Rasterizer::setupPrimitives<false>(const Occluder& occluder, const float* bakedMatrix, Primitive* primitives) const;
+template void Rasterizer::rasterizePrimitives<true>(const Primitive* primitives, const uint32_t* indices, uint32_t count, uint32_t blockMinY, uint32_t blockMaxY);
+template void Rasterizer::rasterizePrimitives<false>(const Primitive* primitives, const uint32_t* indices, uint32_t count, uint32_t blockMinY, uint32_t blockMaxY);
 
 #endif
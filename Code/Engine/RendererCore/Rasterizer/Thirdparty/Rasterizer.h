@@ -17,14 +17,59 @@ public:
   void setModelViewProjection(const float* matrix);
   void clear();
 
+  // Bakes the viewport transform into a column major model view projection matrix.
+  // The result can be passed to the functions below that take a baked matrix, which don't modify the rasterizer state.
+  void bakeModelViewProjection(const float* matrix, float* bakedMatrix) const;
+
   template <bool possiblyNearClipped>
   void rasterize(const Occluder& occluder);
 
-  bool queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping);
+  // A quad or triangle in screen space, ready to be rasterized.
+  struct Primitive
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    __m128 m_depthPlane; // depth at the first block, depth delta per block in x and y
+    __m128 m_edgeNormalX;
+    __m128 m_edgeNormalY;
+    __m128 m_edgeOffset;
+    __m128i m_slopeLookup;
+    uint32_t m_blockMinX;
+    uint32_t m_blockMinY;
+    uint32_t m_blockRangeX;
+    uint32_t m_blockRangeY;
+    uint32_t m_mode;
+    uint16_t m_maxZ;
+  };
+
+  // The maximum number of primitives that setupPrimitives() writes for the occluder.
+  static uint32_t getMaxPrimitiveCount(const Occluder& occluder);
+
+  // Transforms the occluder with a baked matrix and sets up all of its visible primitives. Returns the number of primitives written.
+  // Doesn't modify the rasterizer state, so occluders can be set up in parallel.
+  template <bool possiblyNearClipped>
+  uint32_t setupPrimitives(const Occluder& occluder, const float* bakedMatrix, Primitive* primitives) const;
+
+  // Rasterizes primitives[indices[i]] for all i < count. Only writes to the block rows [blockMinY, blockMaxY),
+  // so calls for disjoint block row ranges can run in parallel.
+  template <bool possiblyNearClipped>
+  void rasterizePrimitives(const Primitive* primitives, const uint32_t* indices, uint32_t count, uint32_t blockMinY, uint32_t blockMaxY);
+
+  bool queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping) const;
+
+  // Same as queryVisibility() for up to 32 boxes. Returns a mask in which bit i is set if box i is visible.
+  uint32_t queryVisibilityBatch(const __m128* boundsMin, const __m128* boundsMax, uint32_t count) const;
+
+  // Projects the box to the screen. Returns false if it is outside the screen. Otherwise screenBounds receives minX, maxX, minY, maxY
+  // in pixels and maxZ the depth of the closest point, unless needsClipping is set, in which case the screen bounds are unknown.
+  bool projectBounds(const float* bakedMatrix, __m128 boundsMin, __m128 boundsMax, bool& needsClipping, uint32_t* screenBounds, uint16_t& maxZ) const;
 
   bool query2D(uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t maxY, uint32_t maxZ) const;
 
   void readBackDepth(void* target) const;
+
+  uint32_t getBlocksX() const { return m_blocksX; }
+  uint32_t getBlocksY() const { return m_blocksY; }
 #else
   Rasterizer(uint32_t width, uint32_t height)
   {
@@ -33,26 +78,60 @@ public:
   void setModelViewProjection(const float* pMatrix) {}
   void clear() {}
 
+  void bakeModelViewProjection(const float* pMatrix, float* pBakedMatrix) const {}
+
   template <bool possiblyNearClipped>
   void rasterize(const Occluder& occluder)
   {
   }
 
-  bool queryVisibility(...)
+  bool queryVisibility(...) const
   {
     return true;
   }
 
+  uint32_t queryVisibilityBatch(...) const
+  {
+    return 0xFFFFFFFF;
+  }
+
+  bool projectBounds(...) const
+  {
+    return false;
+  }
+
   bool query2D(uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t maxY, uint32_t maxZ) const
   {
     return true;
   }
 
   void readBackDepth(void* pTarget) const {}
+
+  uint32_t getBlocksX() const { return 0; }
+  uint32_t getBlocksY() const { return 0; }
 #endif
 
 private:
 #if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+  // The baked matrix of an occluder, adjusted to transform its packed vertex data.
+  struct OccluderTransform
+  {
+    __m128 m_mat0;
+    __m128 m_mat1;
+    __m128 m_mat3;
+    float m_c0;
+    float m_c1;
+  };
+
+  static void prepareOccluderTransform(const Occluder& occluder, const float* bakedMatrix, OccluderTransform& transform);
+
+  // Sets up the up to eight primitives of one packet of four vertex registers. Returns the number of primitives written.
+  template <bool possiblyNearClipped>
+  uint32_t setupPacket(const __m256i* packet, const OccluderTransform& transform, Primitive* primitives) const;
+
+  template <bool possiblyNearClipped>
+  void rasterizePrimitive(const Primitive& primitive, uint32_t blockMinY, uint32_t blockMaxY);
+
   static float decompressFloat(uint16_t depth);
 
   // these functions don't always work in MSVC debug builds
@@ -5,6 +5,7 @@
 #include <Foundation/Application/Application.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/Deque.h>
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Utilities/DGMLWriter.h>
 #include <RendererCore/Pipeline/RenderPipeline.h>
@@ -63,11 +64,40 @@ namespace
   static ezHashTable<ezComponentHandle, CachedRenderDataPerComponent> s_CachedRenderData;
   static ezDynamicArray<const ezRenderData*> s_DeletedRenderData;
 
+  struct DeletedCacheOwner
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezGameObjectHandle m_hOwner;
+    ezUInt64 m_uiFrame;
+  };
+
+  // Owners whose cached render data was deleted, so that anything that keeps pointers to it across frames can drop exactly those.
+  // The first entry has the change index s_uiDeletedCacheOwnersStartIndex.
+  static ezDeque<DeletedCacheOwner> s_DeletedCacheOwners;
+  static ezUInt64 s_uiDeletedCacheOwnersStartIndex = 0;
+
   enum
   {
-    MaxNumNewCacheEntries = 32
+    MaxNumNewCacheEntries = 32,
+    MaxDeletedCacheOwnerFrames = 8,   ///< Views that weren't extracted for longer than this have to drop all cached render data.
+    MaxNumDeletedCacheOwners = 16384, ///< Beyond this it is cheaper to drop all cached render data than to remove every owner.
   };
 
+  void AddDeletedCacheOwner(const ezGameObjectHandle& hOwner, ezUInt64 uiFrame)
+  {
+    auto& deletedOwner = s_DeletedCacheOwners.ExpandAndGetRef();
+    deletedOwner.m_hOwner = hOwner;
+    deletedOwner.m_uiFrame = uiFrame;
+  }
+
+  void InvalidateAllDeletedCacheOwners()
+  {
+    // skip one change index, so that every user with an older index is told to drop everything
+    s_uiDeletedCacheOwnersStartIndex += s_DeletedCacheOwners.GetCount() + 1;
+    s_DeletedCacheOwners.Clear();
+  }
+
   static bool s_bWriteRenderPipelineDgml = false;
   static ezConsoleFunction<void()> s_ConFunc_WriteRenderPipelineDgml("WriteRenderPipelineDgml", "()", []()
     { s_bWriteRenderPipelineDgml = true; });
@@ -307,6 +337,8 @@ void ezRenderWorld::DeleteAllCachedRenderData()
 
       cachedRenderDataPerComponent.Clear();
     }
+
+    InvalidateAllDeletedCacheOwners();
   }
 }
 
@@ -327,6 +359,7 @@ void ezRenderWorld::DeleteCachedRenderData(const ezGameObjectHandle& hOwnerObjec
     }
 
     s_CachedRenderData.Remove(hOwnerComponent);
+    AddDeletedCacheOwner(hOwnerObject, s_uiFrameCounter);
   }
 }
 
@@ -352,6 +385,8 @@ void ezRenderWorld::DeleteCachedRenderDataForObject(const ezGameObject* pOwnerOb
 
   EZ_LOCK(s_CachedRenderDataMutex);
 
+  bool bDeletedAny = false;
+
   auto components = pOwnerObject->GetComponents();
   for (auto pComponent : components)
   {
@@ -366,8 +401,14 @@ void ezRenderWorld::DeleteCachedRenderDataForObject(const ezGameObject* pOwnerOb
       }
 
       s_CachedRenderData.Remove(hComponent);
+      bDeletedAny = true;
     }
   }
+
+  if (bDeletedAny)
+  {
+    AddDeletedCacheOwner(pOwnerObject->GetHandle(), s_uiFrameCounter);
+  }
 }
 
 void ezRenderWorld::DeleteCachedRenderDataForObjectRecursive(const ezGameObject* pOwnerObject)
@@ -399,6 +440,26 @@ ezArrayPtr<const ezInternal::RenderDataCacheEntry> ezRenderWorld::GetCachedRende
   return ezArrayPtr<const ezInternal::RenderDataCacheEntry>();
 }
 
+bool ezRenderWorld::GetDeletedCachedRenderDataOwners(ezUInt64& inout_uiChangeIndex, ezDynamicArray<ezGameObjectHandle>& out_owners)
+{
+  EZ_LOCK(s_CachedRenderDataMutex);
+
+  const ezUInt64 uiEndIndex = s_uiDeletedCacheOwnersStartIndex + s_DeletedCacheOwners.GetCount();
+  if (inout_uiChangeIndex < s_uiDeletedCacheOwnersStartIndex || inout_uiChangeIndex > uiEndIndex)
+  {
+    inout_uiChangeIndex = uiEndIndex;
+    return false;
+  }
+
+  for (ezUInt64 i = inout_uiChangeIndex; i < uiEndIndex; ++i)
+  {
+    out_owners.PushBack(s_DeletedCacheOwners[static_cast<ezUInt32>(i - s_uiDeletedCacheOwnersStartIndex)].m_hOwner);
+  }
+
+  inout_uiChangeIndex = uiEndIndex;
+  return true;
+}
+
 void ezRenderWorld::AddViewToRender(const ezViewHandle& hView)
 {
   ezView* pView = nullptr;
@@ -688,6 +749,19 @@ void ezRenderWorld::ClearRenderDataCache()
   }
 
   s_DeletedRenderData.Clear();
+
+  EZ_LOCK(s_CachedRenderDataMutex);
+
+  if (s_DeletedCacheOwners.GetCount() > MaxNumDeletedCacheOwners)
+  {
+    InvalidateAllDeletedCacheOwners();
+  }
+
+  while (!s_DeletedCacheOwners.IsEmpty() && s_DeletedCacheOwners.PeekFront().m_uiFrame + MaxDeletedCacheOwnerFrames < s_uiFrameCounter)
+  {
+    s_DeletedCacheOwners.PopFront();
+    ++s_uiDeletedCacheOwnersStartIndex;
+  }
 }
 
 void ezRenderWorld::UpdateRenderDataCache()
@@ -823,6 +897,7 @@ void ezRenderWorld::OnEngineShutdown()
 #endif
 
   ClearRenderDataCache();
+  s_DeletedCacheOwners.Clear();
 
   EZ_DEFAULT_DELETE(s_pCacheAllocator);
 
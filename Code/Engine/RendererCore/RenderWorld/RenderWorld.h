@@ -61,6 +61,13 @@ public:
   static void ResetRenderDataCache(ezView& ref_view);
   static ezArrayPtr<const ezInternal::RenderDataCacheEntry> GetCachedRenderData(const ezView& view, const ezGameObjectHandle& hOwner, ezUInt16 uiComponentVersion);
 
+  /// \brief Appends the owner objects whose cached render data was deleted since inout_uiChangeIndex to out_owners and advances the index.
+  ///
+  /// Anything that keeps pointers to cached render data across frames needs to drop the pointers of these owners before it uses the others
+  /// again. Returns false if the deletions since the given index aren't known anymore, e.g. because all cached render data was deleted or
+  /// the index is several frames old. In that case all pointers to cached render data have to be dropped.
+  static bool GetDeletedCachedRenderDataOwners(ezUInt64& inout_uiChangeIndex, ezDynamicArray<ezGameObjectHandle>& out_owners);
+
   static void AddViewToRender(const ezViewHandle& hView);
 
   static void ExtractMainViews();
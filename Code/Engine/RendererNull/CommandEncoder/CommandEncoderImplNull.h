@@ -0,0 +1,158 @@
+#pragma once
+
+#include <Foundation/Strings/String.h>
+#include <Foundation/Time/Time.h>
+#include <RendererFoundation/CommandEncoder/CommandEncoderPlatformInterface.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class ezGALDeviceNull;
+
+/// \brief The commands that were recorded by the null device since the statistics were last reset.
+struct EZ_RENDERERNULL_DLL ezGALCommandStatisticsNull
+{
+  /// \brief Commands that were recorded between a top-level PushMarker / PopMarker pair, usually a render pipeline pass.
+  ///
+  /// Sections with the same name are merged, so m_uiCount is how often the section was entered.
+  struct Section
+  {
+    ezString m_sName;
+    ezUInt32 m_uiCount = 0;
+    ezTime m_CPUTime;
+    ezUInt32 m_uiDrawCalls = 0;
+    ezUInt32 m_uiDispatches = 0;
+  };
+
+  void Reset();
+
+  ezUInt32 m_uiDrawCalls = 0;
+  ezUInt32 m_uiDispatches = 0;
+  ezUInt64 m_uiVertices = 0;          ///< Vertices or indices multiplied by the instance count. Indirect draws are not counted.
+  ezUInt32 m_uiShaderChanges = 0;
+  ezUInt32 m_uiResourceBindings = 0;  ///< Constant buffers, samplers, resource views, UAVs and push constants.
+  ezUInt32 m_uiStateChanges = 0;      ///< Blend, depth stencil and rasterizer states, vertex declarations, topology, viewports and scissor rects.
+  ezUInt32 m_uiBufferBindings = 0;    ///< Vertex and index buffers.
+  ezUInt32 m_uiBufferUpdates = 0;     ///< Buffer updates and copies.
+  ezUInt64 m_uiBufferUpdateBytes = 0; ///< Bytes uploaded through UpdateBuffer.
+  ezUInt32 m_uiTextureUpdates = 0;    ///< Texture updates, copies, resolves and mip map generation.
+  ezUInt32 m_uiRenderingPasses = 0;   ///< Number of BeginRendering calls.
+  ezUInt32 m_uiComputePasses = 0;     ///< Number of BeginCompute calls.
+
+  ezDynamicArray<Section> m_Sections;
+};
+
+/// \brief Accepts all commands without executing them and only counts them in an ezGALCommandStatisticsNull.
+class EZ_RENDERERNULL_DLL ezGALCommandEncoderImplNull final : public ezGALCommandEncoderCommonPlatformInterface
+{
+public:
+  ezGALCommandEncoderImplNull(ezGALDeviceNull& ref_deviceNull);
+  ~ezGALCommandEncoderImplNull();
+
+  const ezGALCommandStatisticsNull& GetStatistics() const { return m_Statistics; }
+  void ResetStatistics();
+
+  // ezGALCommandEncoderCommonPlatformInterface
+  // State setting functions
+
+  virtual void SetShaderPlatform(const ezGALShader* pShader) override;
+
+  virtual void SetConstantBufferPlatform(const ezShaderResourceBinding& binding, const ezGALBuffer* pBuffer) override;
+  virtual void SetSamplerStatePlatform(const ezShaderResourceBinding& binding, const ezGALSamplerState* pSamplerState) override;
+  virtual void SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureResourceView* pResourceView) override;
+  virtual void SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferResourceView* pResourceView) override;
+  virtual void SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureUnorderedAccessView* pUnorderedAccessView) override;
+  virtual void SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferUnorderedAccessView* pUnorderedAccessView) override;
+  virtual void SetPushConstantsPlatform(ezArrayPtr<const ezUInt8> data) override;
+
+  // GPU -> CPU query functions
+
+  virtual ezGALTimestampHandle InsertTimestampPlatform() override;
+  virtual ezGALOcclusionHandle BeginOcclusionQueryPlatform(ezEnum<ezGALQueryType> type) override;
+  virtual void EndOcclusionQueryPlatform(ezGALOcclusionHandle hOcclusion) override;
+  virtual ezGALFenceHandle InsertFencePlatform() override;
+
+  // Resource update functions
+
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues) override;
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues) override;
+
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues) override;
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues) override;
+
+  virtual void CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource) override;
+  virtual void CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount) override;
+
+  virtual void UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> sourceData, ezGALUpdateMode::Enum updateMode) override;
+
+  virtual void CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource) override;
+  virtual void CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezVec3U32& vDestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource, const ezBoundingBoxu32& box) override;
+
+  virtual void UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource,
+    const ezBoundingBoxu32& destinationBox, const ezGALSystemMemoryDescription& sourceData) override;
+
+  virtual void ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource,
+    const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource) override;
+
+  virtual void ReadbackTexturePlatform(const ezGALTexture* pTexture) override;
+
+  virtual void CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, ezArrayPtr<ezGALTextureSubresource> sourceSubResource, ezArrayPtr<ezGALSystemMemoryDescription> targetData) override;
+
+  virtual void GenerateMipMapsPlatform(const ezGALTextureResourceView* pResourceView) override;
+
+  // Misc
+
+  virtual void FlushPlatform() override;
+
+  // Debug helper functions
+
+  virtual void PushMarkerPlatform(const char* szMarker) override;
+  virtual void PopMarkerPlatform() override;
+  virtual void InsertEventMarkerPlatform(const char* szMarker) override;
+
+  // ezGALCommandEncoderComputePlatformInterface
+  // Dispatch
+  virtual void BeginComputePlatform() override;
+  virtual void EndComputePlatform() override;
+
+  virtual ezResult DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ) override;
+  virtual ezResult DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+  // ezGALCommandEncoderRenderPlatformInterface
+  virtual void BeginRenderingPlatform(const ezGALRenderingSetup& renderingSetup) override;
+  virtual void EndRenderingPlatform() override;
+
+  // Draw functions
+
+  virtual void ClearPlatform(const ezColor& clearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear) override;
+
+  virtual ezResult DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex) override;
+  virtual ezResult DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex) override;
+  virtual ezResult DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex) override;
+  virtual ezResult DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+  virtual ezResult DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex) override;
+  virtual ezResult DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+  // State functions
+
+  virtual void SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer) override;
+  virtual void SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer) override;
+  virtual void SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration) override;
+  virtual void SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum topology) override;
+
+  virtual void SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& blendFactor, ezUInt32 uiSampleMask) override;
+  virtual void SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue) override;
+  virtual void SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState) override;
+
+  virtual void SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth) override;
+  virtual void SetScissorRectPlatform(const ezRectU32& rect) override;
+
+private:
+  void AddDraw(ezUInt64 uiVertices);
+
+  ezGALDeviceNull& m_GALDeviceNull;
+
+  ezGALCommandStatisticsNull m_Statistics;
+
+  ezUInt32 m_uiMarkerDepth = 0;
+  ezUInt32 m_uiCurrentSection = ezInvalidIndex;
+  ezTime m_SectionStartTime;
+};
@@ -0,0 +1,453 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <Foundation/Memory/MemoryUtils.h>
+#include <RendererNull/CommandEncoder/CommandEncoderImplNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+void ezGALCommandStatisticsNull::Reset()
+{
+  *this = ezGALCommandStatisticsNull();
+}
+
+ezGALCommandEncoderImplNull::ezGALCommandEncoderImplNull(ezGALDeviceNull& ref_deviceNull)
+  : m_GALDeviceNull(ref_deviceNull)
+{
+}
+
+ezGALCommandEncoderImplNull::~ezGALCommandEncoderImplNull() = default;
+
+void ezGALCommandEncoderImplNull::ResetStatistics()
+{
+  m_Statistics.Reset();
+
+  // a section that is currently open is not recorded anymore, but the marker depth is kept so that the next PopMarker still matches
+  m_uiCurrentSection = ezInvalidIndex;
+}
+
+void ezGALCommandEncoderImplNull::AddDraw(ezUInt64 uiVertices)
+{
+  ++m_Statistics.m_uiDrawCalls;
+  m_Statistics.m_uiVertices += uiVertices;
+
+  if (m_uiCurrentSection != ezInvalidIndex)
+  {
+    ++m_Statistics.m_Sections[m_uiCurrentSection].m_uiDrawCalls;
+  }
+}
+
+// State setting functions
+
+void ezGALCommandEncoderImplNull::SetShaderPlatform(const ezGALShader* pShader)
+{
+  EZ_IGNORE_UNUSED(pShader);
+  ++m_Statistics.m_uiShaderChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetConstantBufferPlatform(const ezShaderResourceBinding& binding, const ezGALBuffer* pBuffer)
+{
+  EZ_IGNORE_UNUSED(binding);
+  EZ_IGNORE_UNUSED(pBuffer);
+  ++m_Statistics.m_uiResourceBindings;
+}
+
+void ezGALCommandEncoderImplNull::SetSamplerStatePlatform(const ezShaderResourceBinding& binding, const ezGALSamplerState* pSamplerState)
+{
+  EZ_IGNORE_UNUSED(binding);
+  EZ_IGNORE_UNUSED(pSamplerState);
+  ++m_Statistics.m_uiResourceBindings;
+}
+
+void ezGALCommandEncoderImplNull::SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureResourceView* pResourceView)
+{
+  EZ_IGNORE_UNUSED(binding);
+  EZ_IGNORE_UNUSED(pResourceView);
+  ++m_Statistics.m_uiResourceBindings;
+}
+
+void ezGALCommandEncoderImplNull::SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferResourceView* pResourceView)
+{
+  EZ_IGNORE_UNUSED(binding);
+  EZ_IGNORE_UNUSED(pResourceView);
+  ++m_Statistics.m_uiResourceBindings;
+}
+
+void ezGALCommandEncoderImplNull::SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureUnorderedAccessView* pUnorderedAccessView)
+{
+  EZ_IGNORE_UNUSED(binding);
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  ++m_Statistics.m_uiResourceBindings;
+}
+
+void ezGALCommandEncoderImplNull::SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferUnorderedAccessView* pUnorderedAccessView)
+{
+  EZ_IGNORE_UNUSED(binding);
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  ++m_Statistics.m_uiResourceBindings;
+}
+
+void ezGALCommandEncoderImplNull::SetPushConstantsPlatform(ezArrayPtr<const ezUInt8> data)
+{
+  EZ_IGNORE_UNUSED(data);
+  ++m_Statistics.m_uiResourceBindings;
+}
+
+// GPU -> CPU query functions
+
+ezGALTimestampHandle ezGALCommandEncoderImplNull::InsertTimestampPlatform()
+{
+  return m_GALDeviceNull.InsertTimestamp();
+}
+
+ezGALOcclusionHandle ezGALCommandEncoderImplNull::BeginOcclusionQueryPlatform(ezEnum<ezGALQueryType> type)
+{
+  EZ_IGNORE_UNUSED(type);
+  return m_GALDeviceNull.BeginOcclusionQuery();
+}
+
+void ezGALCommandEncoderImplNull::EndOcclusionQueryPlatform(ezGALOcclusionHandle hOcclusion)
+{
+  EZ_IGNORE_UNUSED(hOcclusion);
+}
+
+ezGALFenceHandle ezGALCommandEncoderImplNull::InsertFencePlatform()
+{
+  return m_GALDeviceNull.InsertFence();
+}
+
+// Resource update functions
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues)
+{
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  EZ_IGNORE_UNUSED(vClearValues);
+  ++m_Statistics.m_uiTextureUpdates;
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues)
+{
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  EZ_IGNORE_UNUSED(vClearValues);
+  ++m_Statistics.m_uiBufferUpdates;
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues)
+{
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  EZ_IGNORE_UNUSED(vClearValues);
+  ++m_Statistics.m_uiTextureUpdates;
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues)
+{
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  EZ_IGNORE_UNUSED(vClearValues);
+  ++m_Statistics.m_uiBufferUpdates;
+}
+
+void ezGALCommandEncoderImplNull::CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(pSource);
+  ++m_Statistics.m_uiBufferUpdates;
+}
+
+void ezGALCommandEncoderImplNull::CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(uiDestOffset);
+  EZ_IGNORE_UNUSED(pSource);
+  EZ_IGNORE_UNUSED(uiSourceOffset);
+  EZ_IGNORE_UNUSED(uiByteCount);
+  ++m_Statistics.m_uiBufferUpdates;
+}
+
+void ezGALCommandEncoderImplNull::UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> sourceData, ezGALUpdateMode::Enum updateMode)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(uiDestOffset);
+  EZ_IGNORE_UNUSED(updateMode);
+  ++m_Statistics.m_uiBufferUpdates;
+  m_Statistics.m_uiBufferUpdateBytes += sourceData.GetCount();
+}
+
+void ezGALCommandEncoderImplNull::CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(pSource);
+  ++m_Statistics.m_uiTextureUpdates;
+}
+
+void ezGALCommandEncoderImplNull::CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezVec3U32& vDestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource, const ezBoundingBoxu32& box)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(destinationSubResource);
+  EZ_IGNORE_UNUSED(vDestinationPoint);
+  EZ_IGNORE_UNUSED(pSource);
+  EZ_IGNORE_UNUSED(sourceSubResource);
+  EZ_IGNORE_UNUSED(box);
+  ++m_Statistics.m_uiTextureUpdates;
+}
+
+void ezGALCommandEncoderImplNull::UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezBoundingBoxu32& destinationBox, const ezGALSystemMemoryDescription& sourceData)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(destinationSubResource);
+  EZ_IGNORE_UNUSED(destinationBox);
+  EZ_IGNORE_UNUSED(sourceData);
+  ++m_Statistics.m_uiTextureUpdates;
+}
+
+void ezGALCommandEncoderImplNull::ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(destinationSubResource);
+  EZ_IGNORE_UNUSED(pSource);
+  EZ_IGNORE_UNUSED(sourceSubResource);
+  ++m_Statistics.m_uiTextureUpdates;
+}
+
+void ezGALCommandEncoderImplNull::ReadbackTexturePlatform(const ezGALTexture* pTexture)
+{
+  EZ_IGNORE_UNUSED(pTexture);
+}
+
+void ezGALCommandEncoderImplNull::CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, ezArrayPtr<ezGALTextureSubresource> sourceSubResource, ezArrayPtr<ezGALSystemMemoryDescription> targetData)
+{
+  EZ_IGNORE_UNUSED(pTexture);
+  EZ_IGNORE_UNUSED(sourceSubResource);
+
+  // there is no texture content, so the readback result is always black
+  for (const ezGALSystemMemoryDescription& target : targetData)
+  {
+    if (target.m_pData != nullptr)
+    {
+      ezMemoryUtils::ZeroFill(static_cast<ezUInt8*>(target.m_pData), target.m_uiSlicePitch);
+    }
+  }
+}
+
+void ezGALCommandEncoderImplNull::GenerateMipMapsPlatform(const ezGALTextureResourceView* pResourceView)
+{
+  EZ_IGNORE_UNUSED(pResourceView);
+  ++m_Statistics.m_uiTextureUpdates;
+}
+
+// Misc
+
+void ezGALCommandEncoderImplNull::FlushPlatform()
+{
+}
+
+// Debug helper functions
+
+void ezGALCommandEncoderImplNull::PushMarkerPlatform(const char* szMarker)
+{
+  ++m_uiMarkerDepth;
+  if (m_uiMarkerDepth > 1)
+    return;
+
+  ezStringView sMarker = szMarker;
+
+  m_uiCurrentSection = ezInvalidIndex;
+  for (ezUInt32 i = 0; i < m_Statistics.m_Sections.GetCount(); ++i)
+  {
+    if (m_Statistics.m_Sections[i].m_sName == sMarker)
+    {
+      m_uiCurrentSection = i;
+      break;
+    }
+  }
+
+  if (m_uiCurrentSection == ezInvalidIndex)
+  {
+    m_uiCurrentSection = m_Statistics.m_Sections.GetCount();
+    m_Statistics.m_Sections.ExpandAndGetRef().m_sName = sMarker;
+  }
+
+  ++m_Statistics.m_Sections[m_uiCurrentSection].m_uiCount;
+  m_SectionStartTime = ezTime::Now();
+}
+
+void ezGALCommandEncoderImplNull::PopMarkerPlatform()
+{
+  if (m_uiMarkerDepth == 0)
+    return;
+
+  --m_uiMarkerDepth;
+  if (m_uiMarkerDepth > 0)
+    return;
+
+  if (m_uiCurrentSection != ezInvalidIndex)
+  {
+    m_Statistics.m_Sections[m_uiCurrentSection].m_CPUTime += ezTime::Now() - m_SectionStartTime;
+    m_uiCurrentSection = ezInvalidIndex;
+  }
+}
+
+void ezGALCommandEncoderImplNull::InsertEventMarkerPlatform(const char* szMarker)
+{
+  EZ_IGNORE_UNUSED(szMarker);
+}
+
+// Dispatch
+
+void ezGALCommandEncoderImplNull::BeginComputePlatform()
+{
+  ++m_Statistics.m_uiComputePasses;
+}
+
+void ezGALCommandEncoderImplNull::EndComputePlatform()
+{
+}
+
+ezResult ezGALCommandEncoderImplNull::DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ)
+{
+  EZ_IGNORE_UNUSED(uiThreadGroupCountX);
+  EZ_IGNORE_UNUSED(uiThreadGroupCountY);
+  EZ_IGNORE_UNUSED(uiThreadGroupCountZ);
+
+  ++m_Statistics.m_uiDispatches;
+  if (m_uiCurrentSection != ezInvalidIndex)
+  {
+    ++m_Statistics.m_Sections[m_uiCurrentSection].m_uiDispatches;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  EZ_IGNORE_UNUSED(pIndirectArgumentBuffer);
+  EZ_IGNORE_UNUSED(uiArgumentOffsetInBytes);
+  return DispatchPlatform(0, 0, 0);
+}
+
+// Rendering
+
+void ezGALCommandEncoderImplNull::BeginRenderingPlatform(const ezGALRenderingSetup& renderingSetup)
+{
+  EZ_IGNORE_UNUSED(renderingSetup);
+  ++m_Statistics.m_uiRenderingPasses;
+}
+
+void ezGALCommandEncoderImplNull::EndRenderingPlatform()
+{
+}
+
+// Draw functions
+
+void ezGALCommandEncoderImplNull::ClearPlatform(const ezColor& clearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear)
+{
+  EZ_IGNORE_UNUSED(clearColor);
+  EZ_IGNORE_UNUSED(uiRenderTargetClearMask);
+  EZ_IGNORE_UNUSED(bClearDepth);
+  EZ_IGNORE_UNUSED(bClearStencil);
+  EZ_IGNORE_UNUSED(fDepthClear);
+  EZ_IGNORE_UNUSED(uiStencilClear);
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex)
+{
+  EZ_IGNORE_UNUSED(uiStartVertex);
+  AddDraw(uiVertexCount);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex)
+{
+  EZ_IGNORE_UNUSED(uiStartIndex);
+  AddDraw(uiIndexCount);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex)
+{
+  EZ_IGNORE_UNUSED(uiStartIndex);
+  AddDraw(static_cast<ezUInt64>(uiIndexCountPerInstance) * uiInstanceCount);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  EZ_IGNORE_UNUSED(pIndirectArgumentBuffer);
+  EZ_IGNORE_UNUSED(uiArgumentOffsetInBytes);
+  AddDraw(0);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex)
+{
+  EZ_IGNORE_UNUSED(uiStartVertex);
+  AddDraw(static_cast<ezUInt64>(uiVertexCountPerInstance) * uiInstanceCount);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  EZ_IGNORE_UNUSED(pIndirectArgumentBuffer);
+  EZ_IGNORE_UNUSED(uiArgumentOffsetInBytes);
+  AddDraw(0);
+  return EZ_SUCCESS;
+}
+
+// State functions
+
+void ezGALCommandEncoderImplNull::SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer)
+{
+  EZ_IGNORE_UNUSED(pIndexBuffer);
+  ++m_Statistics.m_uiBufferBindings;
+}
+
+void ezGALCommandEncoderImplNull::SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer)
+{
+  EZ_IGNORE_UNUSED(uiSlot);
+  EZ_IGNORE_UNUSED(pVertexBuffer);
+  ++m_Statistics.m_uiBufferBindings;
+}
+
+void ezGALCommandEncoderImplNull::SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration)
+{
+  EZ_IGNORE_UNUSED(pVertexDeclaration);
+  ++m_Statistics.m_uiStateChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum topology)
+{
+  EZ_IGNORE_UNUSED(topology);
+  ++m_Statistics.m_uiStateChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& blendFactor, ezUInt32 uiSampleMask)
+{
+  EZ_IGNORE_UNUSED(pBlendState);
+  EZ_IGNORE_UNUSED(blendFactor);
+  EZ_IGNORE_UNUSED(uiSampleMask);
+  ++m_Statistics.m_uiStateChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue)
+{
+  EZ_IGNORE_UNUSED(pDepthStencilState);
+  EZ_IGNORE_UNUSED(uiStencilRefValue);
+  ++m_Statistics.m_uiStateChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState)
+{
+  EZ_IGNORE_UNUSED(pRasterizerState);
+  ++m_Statistics.m_uiStateChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth)
+{
+  EZ_IGNORE_UNUSED(rect);
+  EZ_IGNORE_UNUSED(fMinDepth);
+  EZ_IGNORE_UNUSED(fMaxDepth);
+  ++m_Statistics.m_uiStateChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetScissorRectPlatform(const ezRectU32& rect)
+{
+  EZ_IGNORE_UNUSED(rect);
+  ++m_Statistics.m_uiStateChanges;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <Foundation/Types/UniquePtr.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/CommandEncoder/CommandEncoderImplNull.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief A graphics device that doesn't talk to any GPU.
+///
+/// All resources are fake objects that only store their creation description, all commands are accepted without doing anything and
+/// all queries and fences are immediately ready. Since no driver is involved, this allows to measure the CPU side of rendering
+/// (render pipelines, render contexts, the GAL itself) without any window or graphics hardware.
+///
+/// The command encoder counts all commands in an ezGALCommandStatisticsNull, see GetStatistics().
+///
+/// The device uses the shaders of the Vulkan shader platform (or HLSL where Vulkan isn't available), so that shader reflection data
+/// is available for the resource bindings. The shader byte code itself is never looked at.
+class EZ_RENDERERNULL_DLL ezGALDeviceNull : public ezGALDevice
+{
+public:
+  ezGALDeviceNull(const ezGALDeviceCreationDescription& Description);
+  virtual ~ezGALDeviceNull();
+
+  /// \brief Returns the commands that were recorded since the last call to ResetStatistics().
+  const ezGALCommandStatisticsNull& GetStatistics() const;
+
+  /// \brief Resets all command counters and sections.
+  void ResetStatistics();
+
+protected:
+  virtual ezStringView GetRendererPlatform() override;
+  virtual ezResult InitPlatform() override;
+  virtual ezResult ShutdownPlatform() override;
+
+  // Command encoder functions
+
+  virtual ezGALCommandEncoder* BeginCommandsPlatform(const char* szName) override;
+  virtual void EndCommandsPlatform(ezGALCommandEncoder* pPass) override;
+
+  virtual void FlushPlatform() override;
+
+
+  // State creation functions
+
+  virtual ezGALBlendState* CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description) override;
+  virtual void DestroyBlendStatePlatform(ezGALBlendState* pBlendState) override;
+
+  virtual ezGALDepthStencilState* CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description) override;
+  virtual void DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState) override;
+
+  virtual ezGALRasterizerState* CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description) override;
+  virtual void DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState) override;
+
+  virtual ezGALSamplerState* CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description) override;
+  virtual void DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState) override;
+
+
+  // Resource creation functions
+
+  virtual ezGALShader* CreateShaderPlatform(const ezGALShaderCreationDescription& Description) override;
+  virtual void DestroyShaderPlatform(ezGALShader* pShader) override;
+
+  virtual ezGALBuffer* CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData) override;
+  virtual void DestroyBufferPlatform(ezGALBuffer* pBuffer) override;
+
+  virtual ezGALTexture* CreateTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override;
+  virtual void DestroyTexturePlatform(ezGALTexture* pTexture) override;
+
+  virtual ezGALTexture* CreateSharedTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData, ezEnum<ezGALSharedTextureType> sharedType, ezGALPlatformSharedHandle handle) override;
+  virtual void DestroySharedTexturePlatform(ezGALTexture* pTexture) override;
+
+  virtual ezGALTextureResourceView* CreateResourceViewPlatform(ezGALTexture* pResource, const ezGALTextureResourceViewCreationDescription& Description) override;
+  virtual void DestroyResourceViewPlatform(ezGALTextureResourceView* pResourceView) override;
+
+  virtual ezGALBufferResourceView* CreateResourceViewPlatform(ezGALBuffer* pResource, const ezGALBufferResourceViewCreationDescription& Description) override;
+  virtual void DestroyResourceViewPlatform(ezGALBufferResourceView* pResourceView) override;
+
+  virtual ezGALRenderTargetView* CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description) override;
+  virtual void DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView) override;
+
+  virtual ezGALTextureUnorderedAccessView* CreateUnorderedAccessViewPlatform(ezGALTexture* pResource, const ezGALTextureUnorderedAccessViewCreationDescription& Description) override;
+  virtual void DestroyUnorderedAccessViewPlatform(ezGALTextureUnorderedAccessView* pUnorderedAccessView) override;
+
+  virtual ezGALBufferUnorderedAccessView* CreateUnorderedAccessViewPlatform(ezGALBuffer* pResource, const ezGALBufferUnorderedAccessViewCreationDescription& Description) override;
+  virtual void DestroyUnorderedAccessViewPlatform(ezGALBufferUnorderedAccessView* pUnorderedAccessView) override;
+
+  // Other rendering creation functions
+
+  virtual ezGALVertexDeclaration* CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description) override;
+  virtual void DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration) override;
+
+  // GPU -> CPU query functions
+
+  virtual ezEnum<ezGALAsyncResult> GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& out_result) override;
+  virtual ezEnum<ezGALAsyncResult> GetOcclusionResultPlatform(ezGALOcclusionHandle hOcclusion, ezUInt64& out_uiResult) override;
+  virtual ezEnum<ezGALAsyncResult> GetFenceResultPlatform(ezGALFenceHandle hFence, ezTime timeout) override;
+
+  // Misc functions
+
+  virtual void BeginFramePlatform(ezArrayPtr<ezGALSwapChain*> swapchains, const ezUInt64 uiAppFrame) override;
+  virtual void EndFramePlatform(ezArrayPtr<ezGALSwapChain*> swapchains) override;
+  virtual ezUInt64 GetCurrentFramePlatform() const override;
+  virtual ezUInt64 GetSafeFramePlatform() const override;
+
+  virtual void FillCapabilitiesPlatform() override;
+
+  virtual void WaitIdlePlatform() override;
+
+public:
+  virtual const ezGALSharedTexture* GetSharedTexture(ezGALTextureHandle hTexture) const override;
+
+private:
+  friend class ezGALCommandEncoderImplNull;
+
+  ezGALTimestampHandle InsertTimestamp();
+  ezGALOcclusionHandle BeginOcclusionQuery();
+  ezGALFenceHandle InsertFence();
+
+  ezUniquePtr<ezGALCommandEncoder> m_pCommandEncoder;
+  ezUniquePtr<ezGALCommandEncoderImplNull> m_pCommandEncoderImpl;
+
+  ezUInt64 m_uiFrameCounter = 0;
+
+  /// Timestamps are 'resolved' immediately when they are inserted. The handle is an index into this ring buffer.
+  static constexpr ezUInt32 s_uiNumTimestamps = 4096;
+  ezDynamicArray<ezTime> m_Timestamps;
+  ezUInt32 m_uiNextTimestamp = 0;
+
+  ezUInt32 m_uiNextOcclusionQuery = 0;
+  ezGALFenceHandle m_uiNextFence = 1;
+};
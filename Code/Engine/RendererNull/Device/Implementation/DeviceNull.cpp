@@ -0,0 +1,521 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <RendererFoundation/CommandEncoder/CommandEncoder.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Device/SwapChainNull.h>
+#include <RendererNull/Resources/ResourcesNull.h>
+#include <RendererNull/Shader/ShaderNull.h>
+#include <RendererNull/State/StateNull.h>
+
+ezInternal::NewInstance<ezGALDevice> CreateNullDevice(ezAllocator* pAllocator, const ezGALDeviceCreationDescription& description)
+{
+  return EZ_NEW(pAllocator, ezGALDeviceNull, description);
+}
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(RendererNull, DeviceFactory)
+
+ON_CORESYSTEMS_STARTUP
+{
+  // The null device only needs the reflection data of the shaders, so it uses whichever shader platform is available.
+#ifdef BUILDSYSTEM_ENABLE_VULKAN_SUPPORT
+  ezGALDeviceFactory::RegisterCreatorFunc("Null", &CreateNullDevice, "VULKAN", "ezShaderCompilerVulkan");
+#else
+  ezGALDeviceFactory::RegisterCreatorFunc("Null", &CreateNullDevice, "DX11_SM50", "ezShaderCompilerHLSL");
+#endif
+}
+
+ON_CORESYSTEMS_SHUTDOWN
+{
+  ezGALDeviceFactory::UnregisterCreatorFunc("Null");
+}
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+ezGALDeviceNull::ezGALDeviceNull(const ezGALDeviceCreationDescription& Description)
+  : ezGALDevice(Description)
+{
+}
+
+ezGALDeviceNull::~ezGALDeviceNull() = default;
+
+const ezGALCommandStatisticsNull& ezGALDeviceNull::GetStatistics() const
+{
+  return m_pCommandEncoderImpl->GetStatistics();
+}
+
+void ezGALDeviceNull::ResetStatistics()
+{
+  m_pCommandEncoderImpl->ResetStatistics();
+}
+
+// Init & shutdown functions
+
+ezStringView ezGALDeviceNull::GetRendererPlatform()
+{
+  return "Null";
+}
+
+ezResult ezGALDeviceNull::InitPlatform()
+{
+  m_Timestamps.SetCount(s_uiNumTimestamps);
+
+  ezGALWindowSwapChain::SetFactoryMethod([this](const ezGALWindowSwapChainCreationDescription& desc) -> ezGALSwapChainHandle
+    { return CreateSwapChain([&desc](ezAllocator* pAllocator) -> ezGALSwapChain*
+        { return EZ_NEW(pAllocator, ezGALSwapChainNull, desc); }); });
+
+  m_pCommandEncoderImpl = EZ_DEFAULT_NEW(ezGALCommandEncoderImplNull, *this);
+  m_pCommandEncoder = EZ_DEFAULT_NEW(ezGALCommandEncoder, *this, *m_pCommandEncoderImpl);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDeviceNull::ShutdownPlatform()
+{
+  m_pCommandEncoder = nullptr;
+  m_pCommandEncoderImpl = nullptr;
+
+  return EZ_SUCCESS;
+}
+
+// Command encoder functions
+
+ezGALCommandEncoder* ezGALDeviceNull::BeginCommandsPlatform(const char* szName)
+{
+  EZ_IGNORE_UNUSED(szName);
+  return m_pCommandEncoder.Borrow();
+}
+
+void ezGALDeviceNull::EndCommandsPlatform(ezGALCommandEncoder* pPass)
+{
+  EZ_ASSERT_DEV(m_pCommandEncoder.Borrow() == pPass, "Invalid pass");
+  EZ_IGNORE_UNUSED(pPass);
+}
+
+void ezGALDeviceNull::FlushPlatform()
+{
+}
+
+// State creation functions
+
+ezGALBlendState* ezGALDeviceNull::CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description)
+{
+  ezGALBlendStateNull* pObject = EZ_NEW(&m_Allocator, ezGALBlendStateNull, Description);
+
+  if (pObject->InitPlatform(this).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroyBlendStatePlatform(ezGALBlendState* pBlendState)
+{
+  ezGALBlendStateNull* pObject = static_cast<ezGALBlendStateNull*>(pBlendState);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+ezGALDepthStencilState* ezGALDeviceNull::CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description)
+{
+  ezGALDepthStencilStateNull* pObject = EZ_NEW(&m_Allocator, ezGALDepthStencilStateNull, Description);
+
+  if (pObject->InitPlatform(this).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState)
+{
+  ezGALDepthStencilStateNull* pObject = static_cast<ezGALDepthStencilStateNull*>(pDepthStencilState);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+ezGALRasterizerState* ezGALDeviceNull::CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description)
+{
+  ezGALRasterizerStateNull* pObject = EZ_NEW(&m_Allocator, ezGALRasterizerStateNull, Description);
+
+  if (pObject->InitPlatform(this).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState)
+{
+  ezGALRasterizerStateNull* pObject = static_cast<ezGALRasterizerStateNull*>(pRasterizerState);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+ezGALSamplerState* ezGALDeviceNull::CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description)
+{
+  ezGALSamplerStateNull* pObject = EZ_NEW(&m_Allocator, ezGALSamplerStateNull, Description);
+
+  if (pObject->InitPlatform(this).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState)
+{
+  ezGALSamplerStateNull* pObject = static_cast<ezGALSamplerStateNull*>(pSamplerState);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+// Resource creation functions
+
+ezGALShader* ezGALDeviceNull::CreateShaderPlatform(const ezGALShaderCreationDescription& Description)
+{
+  ezGALShaderNull* pObject = EZ_NEW(&m_Allocator, ezGALShaderNull, Description);
+
+  if (pObject->InitPlatform(this).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroyShaderPlatform(ezGALShader* pShader)
+{
+  ezGALShaderNull* pObject = static_cast<ezGALShaderNull*>(pShader);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+ezGALBuffer* ezGALDeviceNull::CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  ezGALBufferNull* pObject = EZ_NEW(&m_Allocator, ezGALBufferNull, Description);
+
+  if (pObject->InitPlatform(this, pInitialData).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroyBufferPlatform(ezGALBuffer* pBuffer)
+{
+  ezGALBufferNull* pObject = static_cast<ezGALBufferNull*>(pBuffer);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  ezGALTextureNull* pObject = EZ_NEW(&m_Allocator, ezGALTextureNull, Description);
+
+  if (pObject->InitPlatform(this, pInitialData).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroyTexturePlatform(ezGALTexture* pTexture)
+{
+  ezGALTextureNull* pObject = static_cast<ezGALTextureNull*>(pTexture);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateSharedTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData, ezEnum<ezGALSharedTextureType> sharedType, ezGALPlatformSharedHandle handle)
+{
+  ezGALSharedTextureNull* pObject = EZ_NEW(&m_Allocator, ezGALSharedTextureNull, Description, sharedType, handle);
+
+  if (pObject->InitPlatform(this, pInitialData).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroySharedTexturePlatform(ezGALTexture* pTexture)
+{
+  ezGALSharedTextureNull* pObject = static_cast<ezGALSharedTextureNull*>(pTexture);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+ezGALTextureResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALTexture* pResource, const ezGALTextureResourceViewCreationDescription& Description)
+{
+  ezGALTextureResourceViewNull* pObject = EZ_NEW(&m_Allocator, ezGALTextureResourceViewNull, pResource, Description);
+
+  if (pObject->InitPlatform(this).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALTextureResourceView* pResourceView)
+{
+  ezGALTextureResourceViewNull* pObject = static_cast<ezGALTextureResourceViewNull*>(pResourceView);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+ezGALBufferResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALBuffer* pResource, const ezGALBufferResourceViewCreationDescription& Description)
+{
+  ezGALBufferResourceViewNull* pObject = EZ_NEW(&m_Allocator, ezGALBufferResourceViewNull, pResource, Description);
+
+  if (pObject->InitPlatform(this).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALBufferResourceView* pResourceView)
+{
+  ezGALBufferResourceViewNull* pObject = static_cast<ezGALBufferResourceViewNull*>(pResourceView);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+ezGALRenderTargetView* ezGALDeviceNull::CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+{
+  ezGALRenderTargetViewNull* pObject = EZ_NEW(&m_Allocator, ezGALRenderTargetViewNull, pTexture, Description);
+
+  if (pObject->InitPlatform(this).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView)
+{
+  ezGALRenderTargetViewNull* pObject = static_cast<ezGALRenderTargetViewNull*>(pRenderTargetView);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+ezGALTextureUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(ezGALTexture* pResource, const ezGALTextureUnorderedAccessViewCreationDescription& Description)
+{
+  ezGALTextureUnorderedAccessViewNull* pObject = EZ_NEW(&m_Allocator, ezGALTextureUnorderedAccessViewNull, pResource, Description);
+
+  if (pObject->InitPlatform(this).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALTextureUnorderedAccessView* pUnorderedAccessView)
+{
+  ezGALTextureUnorderedAccessViewNull* pObject = static_cast<ezGALTextureUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+ezGALBufferUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(ezGALBuffer* pResource, const ezGALBufferUnorderedAccessViewCreationDescription& Description)
+{
+  ezGALBufferUnorderedAccessViewNull* pObject = EZ_NEW(&m_Allocator, ezGALBufferUnorderedAccessViewNull, pResource, Description);
+
+  if (pObject->InitPlatform(this).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALBufferUnorderedAccessView* pUnorderedAccessView)
+{
+  ezGALBufferUnorderedAccessViewNull* pObject = static_cast<ezGALBufferUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+// Other rendering creation functions
+
+ezGALVertexDeclaration* ezGALDeviceNull::CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description)
+{
+  ezGALVertexDeclarationNull* pObject = EZ_NEW(&m_Allocator, ezGALVertexDeclarationNull, Description);
+
+  if (pObject->InitPlatform(this).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pObject);
+    return nullptr;
+  }
+
+  return pObject;
+}
+
+void ezGALDeviceNull::DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration)
+{
+  ezGALVertexDeclarationNull* pObject = static_cast<ezGALVertexDeclarationNull*>(pVertexDeclaration);
+  pObject->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pObject);
+}
+
+// GPU -> CPU query functions
+
+ezGALTimestampHandle ezGALDeviceNull::InsertTimestamp()
+{
+  const ezUInt32 uiIndex = m_uiNextTimestamp;
+  m_uiNextTimestamp = (m_uiNextTimestamp + 1) % s_uiNumTimestamps;
+
+  m_Timestamps[uiIndex] = ezTime::Now();
+  return ezGALTimestampHandle(uiIndex, 0);
+}
+
+ezGALOcclusionHandle ezGALDeviceNull::BeginOcclusionQuery()
+{
+  return ezGALOcclusionHandle(m_uiNextOcclusionQuery++, 0);
+}
+
+ezGALFenceHandle ezGALDeviceNull::InsertFence()
+{
+  return m_uiNextFence++;
+}
+
+ezEnum<ezGALAsyncResult> ezGALDeviceNull::GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& out_result)
+{
+  out_result = m_Timestamps[static_cast<ezUInt32>(hTimestamp.m_InstanceIndex) % s_uiNumTimestamps];
+  return ezGALAsyncResult::Ready;
+}
+
+ezEnum<ezGALAsyncResult> ezGALDeviceNull::GetOcclusionResultPlatform(ezGALOcclusionHandle hOcclusion, ezUInt64& out_uiResult)
+{
+  EZ_IGNORE_UNUSED(hOcclusion);
+
+  // nothing is ever rendered, so report everything as visible to not influence any culling
+  out_uiResult = 1;
+  return ezGALAsyncResult::Ready;
+}
+
+ezEnum<ezGALAsyncResult> ezGALDeviceNull::GetFenceResultPlatform(ezGALFenceHandle hFence, ezTime timeout)
+{
+  EZ_IGNORE_UNUSED(hFence);
+  EZ_IGNORE_UNUSED(timeout);
+  return ezGALAsyncResult::Ready;
+}
+
+// Misc functions
+
+void ezGALDeviceNull::BeginFramePlatform(ezArrayPtr<ezGALSwapChain*> swapchains, const ezUInt64 uiAppFrame)
+{
+  EZ_IGNORE_UNUSED(uiAppFrame);
+
+  for (ezGALSwapChain* pSwapChain : swapchains)
+  {
+    pSwapChain->AcquireNextRenderTarget(this);
+  }
+}
+
+void ezGALDeviceNull::EndFramePlatform(ezArrayPtr<ezGALSwapChain*> swapchains)
+{
+  for (ezGALSwapChain* pSwapChain : swapchains)
+  {
+    pSwapChain->PresentRenderTarget(this);
+  }
+
+  ++m_uiFrameCounter;
+}
+
+ezUInt64 ezGALDeviceNull::GetCurrentFramePlatform() const
+{
+  return m_uiFrameCounter;
+}
+
+ezUInt64 ezGALDeviceNull::GetSafeFramePlatform() const
+{
+  // nothing is in flight, every frame is finished as soon as it was submitted
+  return m_uiFrameCounter;
+}
+
+void ezGALDeviceNull::FillCapabilitiesPlatform()
+{
+  m_Capabilities.m_sAdapterName = "Null Device";
+  m_Capabilities.m_bHardwareAccelerated = false;
+
+  m_Capabilities.m_bMultithreadedResourceCreation = true;
+  m_Capabilities.m_bNoOverwriteBufferUpdate = true;
+
+  for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    m_Capabilities.m_bShaderStageSupported[stage] = true;
+  }
+
+  m_Capabilities.m_bInstancing = true;
+  m_Capabilities.m_b32BitIndices = true;
+  m_Capabilities.m_bIndirectDraw = true;
+  m_Capabilities.m_uiMaxConstantBuffers = 16;
+  m_Capabilities.m_uiMaxPushConstantsSize = 128;
+  m_Capabilities.m_bTextureArrays = true;
+  m_Capabilities.m_bCubemapArrays = true;
+  m_Capabilities.m_bSharedTextures = false;
+  m_Capabilities.m_uiMaxTextureDimension = 16384;
+  m_Capabilities.m_uiMaxCubemapDimension = 16384;
+  m_Capabilities.m_uiMax3DTextureDimension = 2048;
+  m_Capabilities.m_uiMaxAnisotropy = 16;
+  m_Capabilities.m_uiMaxRendertargets = EZ_GAL_MAX_RENDERTARGET_COUNT;
+  m_Capabilities.m_uiUAVCount = 64;
+  m_Capabilities.m_bAlphaToCoverage = true;
+  m_Capabilities.m_bVertexShaderRenderTargetArrayIndex = true;
+  m_Capabilities.m_bConservativeRasterization = true;
+
+  const ezBitflags<ezGALResourceFormatSupport> allSupport = ezGALResourceFormatSupport::Texture | ezGALResourceFormatSupport::RenderTarget | ezGALResourceFormatSupport::TextureRW | ezGALResourceFormatSupport::MSAA2x | ezGALResourceFormatSupport::MSAA4x | ezGALResourceFormatSupport::MSAA8x | ezGALResourceFormatSupport::VertexAttribute;
+
+  m_Capabilities.m_FormatSupport.SetCount(ezGALResourceFormat::ENUM_COUNT);
+  for (ezUInt32 i = 0; i < ezGALResourceFormat::ENUM_COUNT; ++i)
+  {
+    m_Capabilities.m_FormatSupport[i] = allSupport;
+  }
+}
+
+void ezGALDeviceNull::WaitIdlePlatform()
+{
+  DestroyDeadObjects();
+}
+
+const ezGALSharedTexture* ezGALDeviceNull::GetSharedTexture(ezGALTextureHandle hTexture) const
+{
+  auto pTexture = GetTexture(hTexture);
+  if (pTexture == nullptr)
+  {
+    return nullptr;
+  }
+
+  // Resolve proxy texture if any
+  return static_cast<const ezGALSharedTextureNull*>(pTexture->GetParentResource());
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_DeviceNull);
@@ -0,0 +1,68 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <Core/System/Window.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/Device/SwapChainNull.h>
+
+void ezGALSwapChainNull::AcquireNextRenderTarget(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+}
+
+void ezGALSwapChainNull::PresentRenderTarget(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+}
+
+ezResult ezGALSwapChainNull::UpdateSwapChain(ezGALDevice* pDevice, ezEnum<ezGALPresentMode> newPresentMode)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  EZ_IGNORE_UNUSED(newPresentMode);
+  return EZ_SUCCESS;
+}
+
+ezGALSwapChainNull::ezGALSwapChainNull(const ezGALWindowSwapChainCreationDescription& Description)
+  : ezGALWindowSwapChain(Description)
+{
+}
+
+ezGALSwapChainNull::~ezGALSwapChainNull() = default;
+
+ezResult ezGALSwapChainNull::InitPlatform(ezGALDevice* pDevice)
+{
+  ezGALTextureCreationDescription texDesc;
+  if (m_WindowDesc.m_pWindow)
+  {
+    texDesc.m_uiWidth = m_WindowDesc.m_pWindow->GetClientAreaSize().width;
+    texDesc.m_uiHeight = m_WindowDesc.m_pWindow->GetClientAreaSize().height;
+  }
+  else
+  {
+    texDesc.m_uiWidth = 1024;
+    texDesc.m_uiHeight = 768;
+  }
+  texDesc.m_Format = m_WindowDesc.m_BackBufferFormat;
+  texDesc.m_SampleCount = m_WindowDesc.m_SampleCount;
+  texDesc.m_bCreateRenderTarget = true;
+  texDesc.m_ResourceAccess.m_bReadBack = m_WindowDesc.m_bAllowScreenshots;
+
+  m_hBackBufferTexture = pDevice->CreateTexture(texDesc);
+  if (m_hBackBufferTexture.IsInvalidated())
+    return EZ_FAILURE;
+
+  m_RenderTargets.m_hRTs[0] = m_hBackBufferTexture;
+  m_CurrentSize = ezSizeU32(texDesc.m_uiWidth, texDesc.m_uiHeight);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALSwapChainNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  if (!m_hBackBufferTexture.IsInvalidated())
+  {
+    pDevice->DestroyTexture(m_hBackBufferTexture);
+    m_hBackBufferTexture.Invalidate();
+  }
+
+  m_RenderTargets.m_hRTs[0].Invalidate();
+  return EZ_SUCCESS;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <RendererFoundation/Device/SwapChain.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief A swap chain without a window surface. The back buffer is a regular (fake) render target texture.
+///
+/// The back buffer has the size of the window's client area, or 1024x768 if no window is given.
+class EZ_RENDERERNULL_DLL ezGALSwapChainNull : public ezGALWindowSwapChain
+{
+public:
+  virtual void AcquireNextRenderTarget(ezGALDevice* pDevice) override;
+  virtual void PresentRenderTarget(ezGALDevice* pDevice) override;
+  virtual ezResult UpdateSwapChain(ezGALDevice* pDevice, ezEnum<ezGALPresentMode> newPresentMode) override;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALSwapChainNull(const ezGALWindowSwapChainCreationDescription& Description);
+  virtual ~ezGALSwapChainNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  ezGALTextureHandle m_hBackBufferTexture;
+};
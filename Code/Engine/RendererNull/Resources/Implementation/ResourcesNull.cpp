@@ -0,0 +1,188 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Resources/ResourcesNull.h>
+
+//////////////////////////////////////////////////////////////////////////
+// ezGALBufferNull
+//////////////////////////////////////////////////////////////////////////
+
+ezGALBufferNull::ezGALBufferNull(const ezGALBufferCreationDescription& Description)
+  : ezGALBuffer(Description)
+{
+}
+
+ezGALBufferNull::~ezGALBufferNull() = default;
+
+ezResult ezGALBufferNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  EZ_IGNORE_UNUSED(pInitialData);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+void ezGALBufferNull::SetDebugNamePlatform(const char* szName) const
+{
+  EZ_IGNORE_UNUSED(szName);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ezGALTextureNull
+//////////////////////////////////////////////////////////////////////////
+
+ezGALTextureNull::ezGALTextureNull(const ezGALTextureCreationDescription& Description)
+  : ezGALTexture(Description)
+{
+}
+
+ezGALTextureNull::~ezGALTextureNull() = default;
+
+ezResult ezGALTextureNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  EZ_IGNORE_UNUSED(pInitialData);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+void ezGALTextureNull::SetDebugNamePlatform(const char* szName) const
+{
+  EZ_IGNORE_UNUSED(szName);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ezGALSharedTextureNull
+//////////////////////////////////////////////////////////////////////////
+
+ezGALSharedTextureNull::ezGALSharedTextureNull(const ezGALTextureCreationDescription& Description, ezEnum<ezGALSharedTextureType> sharedType, ezGALPlatformSharedHandle hSharedHandle)
+  : ezGALTextureNull(Description)
+  , m_hSharedHandle(hSharedHandle)
+{
+  EZ_IGNORE_UNUSED(sharedType);
+}
+
+ezGALSharedTextureNull::~ezGALSharedTextureNull() = default;
+
+ezGALPlatformSharedHandle ezGALSharedTextureNull::GetSharedHandle() const
+{
+  return m_hSharedHandle;
+}
+
+void ezGALSharedTextureNull::WaitSemaphoreGPU(ezUInt64 uiValue) const
+{
+  EZ_IGNORE_UNUSED(uiValue);
+}
+
+void ezGALSharedTextureNull::SignalSemaphoreGPU(ezUInt64 uiValue) const
+{
+  EZ_IGNORE_UNUSED(uiValue);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Views
+//////////////////////////////////////////////////////////////////////////
+
+ezGALTextureResourceViewNull::ezGALTextureResourceViewNull(ezGALTexture* pResource, const ezGALTextureResourceViewCreationDescription& Description)
+  : ezGALTextureResourceView(pResource, Description)
+{
+}
+
+ezGALTextureResourceViewNull::~ezGALTextureResourceViewNull() = default;
+
+ezResult ezGALTextureResourceViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureResourceViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezGALBufferResourceViewNull::ezGALBufferResourceViewNull(ezGALBuffer* pResource, const ezGALBufferResourceViewCreationDescription& Description)
+  : ezGALBufferResourceView(pResource, Description)
+{
+}
+
+ezGALBufferResourceViewNull::~ezGALBufferResourceViewNull() = default;
+
+ezResult ezGALBufferResourceViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferResourceViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezGALRenderTargetViewNull::ezGALRenderTargetViewNull(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+  : ezGALRenderTargetView(pTexture, Description)
+{
+}
+
+ezGALRenderTargetViewNull::~ezGALRenderTargetViewNull() = default;
+
+ezResult ezGALRenderTargetViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALRenderTargetViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezGALTextureUnorderedAccessViewNull::ezGALTextureUnorderedAccessViewNull(ezGALTexture* pResource, const ezGALTextureUnorderedAccessViewCreationDescription& Description)
+  : ezGALTextureUnorderedAccessView(pResource, Description)
+{
+}
+
+ezGALTextureUnorderedAccessViewNull::~ezGALTextureUnorderedAccessViewNull() = default;
+
+ezResult ezGALTextureUnorderedAccessViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureUnorderedAccessViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezGALBufferUnorderedAccessViewNull::ezGALBufferUnorderedAccessViewNull(ezGALBuffer* pResource, const ezGALBufferUnorderedAccessViewCreationDescription& Description)
+  : ezGALBufferUnorderedAccessView(pResource, Description)
+{
+}
+
+ezGALBufferUnorderedAccessViewNull::~ezGALBufferUnorderedAccessViewNull() = default;
+
+ezResult ezGALBufferUnorderedAccessViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferUnorderedAccessViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <RendererFoundation/Resources/Buffer.h>
+#include <RendererFoundation/Resources/RenderTargetView.h>
+#include <RendererFoundation/Resources/ResourceView.h>
+#include <RendererFoundation/Resources/Texture.h>
+#include <RendererFoundation/Resources/UnorderedAccesView.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class EZ_RENDERERNULL_DLL ezGALBufferNull : public ezGALBuffer
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALBufferNull(const ezGALBufferCreationDescription& Description);
+  virtual ~ezGALBufferNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALTextureNull : public ezGALTexture
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALTextureNull(const ezGALTextureCreationDescription& Description);
+  virtual ~ezGALTextureNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALSharedTextureNull : public ezGALTextureNull, public ezGALSharedTexture
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALSharedTextureNull(const ezGALTextureCreationDescription& Description, ezEnum<ezGALSharedTextureType> sharedType, ezGALPlatformSharedHandle hSharedHandle);
+  virtual ~ezGALSharedTextureNull();
+
+  virtual ezGALPlatformSharedHandle GetSharedHandle() const override;
+  virtual void WaitSemaphoreGPU(ezUInt64 uiValue) const override;
+  virtual void SignalSemaphoreGPU(ezUInt64 uiValue) const override;
+
+  ezGALPlatformSharedHandle m_hSharedHandle;
+};
+
+class EZ_RENDERERNULL_DLL ezGALTextureResourceViewNull : public ezGALTextureResourceView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALTextureResourceViewNull(ezGALTexture* pResource, const ezGALTextureResourceViewCreationDescription& Description);
+  virtual ~ezGALTextureResourceViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALBufferResourceViewNull : public ezGALBufferResourceView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALBufferResourceViewNull(ezGALBuffer* pResource, const ezGALBufferResourceViewCreationDescription& Description);
+  virtual ~ezGALBufferResourceViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALRenderTargetViewNull : public ezGALRenderTargetView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALRenderTargetViewNull(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description);
+  virtual ~ezGALRenderTargetViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALTextureUnorderedAccessViewNull : public ezGALTextureUnorderedAccessView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALTextureUnorderedAccessViewNull(ezGALTexture* pResource, const ezGALTextureUnorderedAccessViewCreationDescription& Description);
+  virtual ~ezGALTextureUnorderedAccessViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALBufferUnorderedAccessViewNull : public ezGALBufferUnorderedAccessView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALBufferUnorderedAccessViewNull(ezGALBuffer* pResource, const ezGALBufferUnorderedAccessViewCreationDescription& Description);
+  virtual ~ezGALBufferUnorderedAccessViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
@@ -0,0 +1,50 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Shader/ShaderNull.h>
+
+ezGALShaderNull::ezGALShaderNull(const ezGALShaderCreationDescription& Description)
+  : ezGALShader(Description)
+{
+}
+
+ezGALShaderNull::~ezGALShaderNull() = default;
+
+void ezGALShaderNull::SetDebugName(ezStringView sName) const
+{
+  EZ_IGNORE_UNUSED(sName);
+}
+
+ezResult ezGALShaderNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+
+  // the byte code is never used, only the reflection data is needed to map the resource bindings
+  return CreateBindingMapping(true);
+}
+
+ezResult ezGALShaderNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+
+  DestroyBindingMapping();
+  return EZ_SUCCESS;
+}
+
+ezGALVertexDeclarationNull::ezGALVertexDeclarationNull(const ezGALVertexDeclarationCreationDescription& Description)
+  : ezGALVertexDeclaration(Description)
+{
+}
+
+ezGALVertexDeclarationNull::~ezGALVertexDeclarationNull() = default;
+
+ezResult ezGALVertexDeclarationNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALVertexDeclarationNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
@@ -0,0 +1,87 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/State/StateNull.h>
+
+// Blend state
+
+ezGALBlendStateNull::ezGALBlendStateNull(const ezGALBlendStateCreationDescription& Description)
+  : ezGALBlendState(Description)
+{
+}
+
+ezGALBlendStateNull::~ezGALBlendStateNull() = default;
+
+ezResult ezGALBlendStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBlendStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+// Depth stencil state
+
+ezGALDepthStencilStateNull::ezGALDepthStencilStateNull(const ezGALDepthStencilStateCreationDescription& Description)
+  : ezGALDepthStencilState(Description)
+{
+}
+
+ezGALDepthStencilStateNull::~ezGALDepthStencilStateNull() = default;
+
+ezResult ezGALDepthStencilStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDepthStencilStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+// Rasterizer state
+
+ezGALRasterizerStateNull::ezGALRasterizerStateNull(const ezGALRasterizerStateCreationDescription& Description)
+  : ezGALRasterizerState(Description)
+{
+}
+
+ezGALRasterizerStateNull::~ezGALRasterizerStateNull() = default;
+
+ezResult ezGALRasterizerStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALRasterizerStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+// Sampler state
+
+ezGALSamplerStateNull::ezGALSamplerStateNull(const ezGALSamplerStateCreationDescription& Description)
+  : ezGALSamplerState(Description)
+{
+}
+
+ezGALSamplerStateNull::~ezGALSamplerStateNull() = default;
+
+ezResult ezGALSamplerStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALSamplerStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
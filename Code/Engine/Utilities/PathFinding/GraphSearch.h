@@ -1,9 +1,40 @@
 #pragma once
 
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Math/Math.h>
 #include <Utilities/PathFinding/PathState.h>
 #include <Utilities/UtilitiesDLL.h>
 
+/// \brief A binary min-heap of node indices sorted by their costs, used as the open list of path searches.
+///
+/// When a node is reached through a cheaper path, it is usually pushed again instead of updating its entry in the heap.
+/// The caller has to skip such outdated entries when they are popped.
+template <typename IndexType>
+class ezPathSearchOpenList
+{
+public:
+  struct Entry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fCosts;
+    IndexType m_Index;
+  };
+
+  void Clear() { m_Heap.Clear(); }
+  bool IsEmpty() const { return m_Heap.IsEmpty(); }
+
+  /// \brief Adds a node with the given costs.
+  void Push(IndexType index, float fCosts);
+
+  /// \brief Removes and returns the entry with the lowest costs. The open list must not be empty.
+  Entry Pop();
+
+private:
+  ezDynamicArray<Entry> m_Heap;
+};
+
 /// \brief Implements a directed breadth-first search through a graph (A*).
 ///
 /// You can search for a path to a specific location using FindPath() or to the closest node that fulfills some arbitrary criteria
@@ -33,6 +64,16 @@ public:
   /// \brief Sets the ezPathStateGenerator that should be used by this ezPathSearch object.
   void SetPathStateGenerator(ezPathStateGenerator<PathStateType>* pStateGenerator) { m_pStateGenerator = pStateGenerator; }
 
+  /// \brief Tells the path search that all node indices are in the range [0; uiNumNodes).
+  ///
+  /// The per-node search state is then kept in an array that is indexed directly by the node index and that is reused by all following
+  /// searches, instead of in a hash table that has to be filled anew for every search. This is much faster for large graphs with dense node
+  /// indices, such as grids, but needs memory for all nodes, even if a search only visits a few of them.
+  ///
+  /// Calling this again with a different count keeps the state of the nodes that are still in range, so it is cheap to grow the range
+  /// when nodes are added to the graph. Pass 0 to go back to storing the state of the visited nodes in a hash table, which is the default.
+  void SetNodeIndexRange(ezUInt32 uiNumNodes);
+
   /// \brief Searches for a path that starts at the graph node \a iStartNodeIndex with the start state \a StartState and shall terminate
   /// when the graph node \a iTargetNodeIndex was reached.
   ///
@@ -57,15 +98,27 @@ public:
   void AddPathNode(ezInt64 iNodeIndex, const PathStateType& NewState);
 
 private:
-  void ClearPathStates();
-  ezInt64 FindBestNodeToExpand(PathStateType*& out_pPathState);
+  struct NodeData
+  {
+    PathStateType m_State;
+    ezUInt32 m_uiSearchID = 0; ///< The node data is only valid during the search with this ID, which makes resetting the dense node array unnecessary.
+    bool m_bExpanded = false;
+  };
+
+  void StartNewSearch();
+  NodeData* FindNode(ezInt64 iNodeIndex);
+  NodeData& CreateNode(ezInt64 iNodeIndex);
+  NodeData* PopBestNodeToExpand(ezInt64& out_iNodeIndex);
   void FillOutPathResult(ezInt64 iEndNodeIndex, ezDeque<PathResultData>& out_Path);
 
-  ezPathStateGenerator<PathStateType>* m_pStateGenerator;
+  ezPathStateGenerator<PathStateType>* m_pStateGenerator = nullptr;
 
-  ezHashTable<ezInt64, PathStateType> m_PathStates;
+  ezUInt32 m_uiSearchID = 0;
+  ezDynamicArray<NodeData> m_DenseNodes;
+  ezHashTable<ezInt64, NodeData> m_SparseNodes;
 
-  ezDeque<ezInt64> m_StateQueue;
+  /// The nodes that still need to be expanded, sorted by the estimated costs.
+  ezPathSearchOpenList<ezInt64> m_OpenList;
 
   ezInt64 m_iCurNodeIndex;
   PathStateType m_CurState;
@@ -47,9 +47,24 @@ public:
   void CreateFromGrid(
     const ezGameGrid<CellData>& grid, CellComparator isSameCellType, void* pPassThroughSame, CellBlocked isCellBlocked, void* pPassThroughBlocked);
 
+  /// \brief Rebuilds the navmesh in the given region after cells of the grid have changed.
+  ///
+  /// All convex areas that overlap \a region are removed and the region is enlarged until it covers them entirely. Then new areas are created
+  /// for the enlarged region and the edges of the new areas and of their neighbors are recreated.
+  /// The indices of all areas outside the region stay the same. The indices of removed areas are reused for new areas, unused ones keep
+  /// an empty rectangle and no edges.
+  ///
+  /// Returns the enlarged region. Pass it to ezGridNavmeshHierarchy::UpdateRegion(), if a hierarchy was built for this navmesh.
+  template <class CellData>
+  ezRectU32 UpdateCells(const ezGameGrid<CellData>& grid, ezRectU32 region, CellComparator isSameCellType, void* pPassThroughSame,
+    CellBlocked isCellBlocked, void* pPassThroughBlocked);
+
   /// \brief Returns the index of the ConvexArea at the given cell coordinates. Negative, if the cell is blocked.
   ezInt32 GetAreaAt(const ezVec2I32& vCoord) const { return m_NodesGrid.GetCell(vCoord); }
 
+  /// \brief Returns the size of the underlying grid in cells.
+  ezVec2U32 GetGridSize() const { return ezVec2U32(m_NodesGrid.GetGridSizeX(), m_NodesGrid.GetGridSizeY()); }
+
   /// \brief Returns the number of convex areas that this navmesh consists of.
   ezUInt32 GetNumConvexAreas() const { return m_ConvexAreas.GetCount(); }
 
@@ -63,6 +78,7 @@ public:
   const AreaEdge& GetAreaEdge(ezInt32 iAreaEdge) const { return m_GraphEdges[iAreaEdge]; }
 
 private:
+  ezRectU32 RebuildRegion(ezRectU32 region, CellComparator IsSameCellType, void* pPassThrough1, CellBlocked IsCellBlocked, void* pPassThrough2);
   void UpdateRegion(ezRectU32 region, CellComparator IsSameCellType, void* pPassThrough1, CellBlocked IsCellBlocked, void* pPassThrough2);
 
   void Optimize(ezRectU32 region, CellComparator IsSameCellType, void* pPassThrough);
@@ -84,6 +100,10 @@ private:
   ezGameGrid<ezInt32> m_NodesGrid;
   ezDynamicArray<ConvexArea> m_ConvexAreas;
   ezDeque<AreaEdge> m_GraphEdges;
+
+  ezDynamicArray<ezInt32> m_FreeAreas;    ///< Indices of areas that were removed by UpdateCells() and can be reused.
+  ezDynamicArray<ezInt32> m_CreatedAreas; ///< The areas that were created by the last call to CreateNodes().
+  ezUInt32 m_uiNumUnusedEdges = 0;        ///< Edges of recreated areas that are still in m_GraphEdges but not referenced anymore.
 };
 
 #include <Utilities/PathFinding/Implementation/GridNavmesh_inl.h>
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <Utilities/PathFinding/GraphSearch.h>
+#include <Utilities/PathFinding/GridNavmesh.h>
+
+/// \brief A hierarchical abstraction (HPA*) of an ezGridNavmesh, which allows to find long paths much faster than a search through all
+/// convex areas.
+///
+/// The grid is divided into square clusters. Every convex area belongs to the cluster that contains its top left cell.
+/// Areas that have an edge to an area in another cluster are the 'entrances' of their cluster. For every cluster the shortest paths
+/// between all its entrances are precomputed, when only moving through areas of the same cluster.
+///
+/// A path search then only needs to search the small graph of entrances, which are connected through the precomputed paths inside
+/// the clusters and through the area edges between clusters. Finally the path is refined to the full sequence of convex areas.
+///
+/// The costs of moving from one area to the next are the distance between the centers of the two areas.
+///
+/// When cells of the grid change, call ezGridNavmesh::UpdateCells() and pass the returned region to UpdateRegion(),
+/// which only rebuilds the affected clusters.
+///
+/// An ezGridNavmeshHierarchy keeps state for the path searches, so it must not be used by multiple threads at the same time.
+class EZ_UTILITIES_DLL ezGridNavmeshHierarchy : private ezPathStateGenerator<ezPathState>
+{
+public:
+  ezGridNavmeshHierarchy();
+  ~ezGridNavmeshHierarchy();
+
+  /// \brief Builds the hierarchy for the given navmesh, which must stay alive as long as the hierarchy is used.
+  ///
+  /// \a uiClusterSize is the number of cells along each side of a cluster. Larger clusters mean fewer entrances to search through,
+  /// but more expensive searches inside the start and target cluster.
+  void Build(const ezGridNavmesh& navmesh, ezUInt32 uiClusterSize = 32);
+
+  /// \brief Rebuilds all clusters that are affected by a change of the navmesh in the given region.
+  ///
+  /// \a region should be the return value of ezGridNavmesh::UpdateCells().
+  void UpdateRegion(const ezRectU32& region);
+
+  /// \brief Searches for the shortest path from the cell \a vStartCell to the cell \a vTargetCell.
+  ///
+  /// On success \a out_areas contains the indices of all convex areas along the path, including the ones of the start and target cell.
+  /// Returns EZ_FAILURE if either cell is blocked or if there is no path between them.
+  ezResult FindPath(const ezVec2I32& vStartCell, const ezVec2I32& vTargetCell, ezDynamicArray<ezInt32>& out_areas);
+
+  /// \brief Returns the number of clusters along the X and Y axis.
+  ezVec2U32 GetNumClusters() const { return ezVec2U32(m_uiNumClustersX, m_uiNumClustersY); }
+
+  /// \brief Returns the number of entrance areas over all clusters. These are the nodes of the abstract graph.
+  ezUInt32 GetNumEntrances() const;
+
+private:
+  struct Cluster
+  {
+    /// All areas that belong to this cluster.
+    ezDynamicArray<ezInt32> m_Areas;
+
+    /// Indices into m_Areas of the areas that have edges to areas in other clusters.
+    ezDynamicArray<ezUInt32> m_Entrances;
+
+    /// For every pair of entrances the costs of the shortest path between them, inside the cluster. Infinity if there is no path.
+    ezDynamicArray<float> m_EntranceCosts;
+
+    /// For every entrance and every area of the cluster the area (as index into m_Areas) through which it is reached on the
+    /// shortest path from that entrance.
+    ezDynamicArray<ezUInt32> m_EntrancePathPredecessors;
+  };
+
+  /// \brief Where in the hierarchy a convex area is stored.
+  struct AreaInfo
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiCluster = ezInvalidIndex;
+    ezUInt32 m_uiIndexInCluster = ezInvalidIndex;
+    ezUInt32 m_uiEntranceIndex = ezInvalidIndex; ///< Index into Cluster::m_Entrances, or invalid if the area isn't an entrance.
+  };
+
+  /// \brief The results of a search from one area to all other areas of its cluster.
+  struct ClusterSearch
+  {
+    ezDynamicArray<float> m_Costs;
+    ezDynamicArray<ezUInt32> m_Predecessors;
+  };
+
+  ezUInt32 GetClusterOfArea(ezInt32 iArea) const;
+  ezVec2 GetAreaCenter(ezInt32 iArea) const;
+  float GetCosts(ezInt32 iArea1, ezInt32 iArea2) const;
+
+  void RebuildCluster(ezUInt32 uiCluster);
+  void SearchInsideCluster(ezUInt32 uiCluster, ezUInt32 uiStartIndex, float* pCosts, ezUInt32* pPredecessors);
+  void AppendClusterPath(const Cluster& cluster, const ezUInt32* pPredecessors, ezUInt32 uiFromIndex, bool bReverse, ezDynamicArray<ezInt32>& inout_areas) const;
+
+  // ezPathStateGenerator
+  virtual void StartSearch(ezInt64 iStartNodeIndex, const ezPathState* pStartState, ezInt64 iTargetNodeIndex) override;
+  virtual void GenerateAdjacentStates(ezInt64 iNodeIndex, const ezPathState& startState, ezPathSearch<ezPathState>* pPathSearch) override;
+  void AddAdjacentState(ezInt32 iArea, float fCosts, const ezPathState& startState, ezPathSearch<ezPathState>* pPathSearch) const;
+
+  const ezGridNavmesh* m_pNavmesh = nullptr;
+  ezUInt32 m_uiClusterSize = 0;
+  ezUInt32 m_uiNumClustersX = 0;
+  ezUInt32 m_uiNumClustersY = 0;
+
+  ezDynamicArray<Cluster> m_Clusters;
+  ezDynamicArray<AreaInfo> m_AreaInfos;
+
+  // state of the current path search
+  ezPathSearch<ezPathState> m_AbstractSearch;
+  ezInt32 m_iStartArea = -1;
+  ezInt32 m_iTargetArea = -1;
+  ezVec2 m_vTargetCenter;
+  ClusterSearch m_StartSearch;
+  ClusterSearch m_TargetSearch;
+  ezDeque<ezPathSearch<ezPathState>::PathResultData> m_AbstractPath;
+
+  // temp data for (re-)building clusters and searches inside clusters
+  ezDynamicArray<ezUInt32> m_ClustersToRebuild;
+
+  ezPathSearchOpenList<ezUInt32> m_OpenAreas;
+};
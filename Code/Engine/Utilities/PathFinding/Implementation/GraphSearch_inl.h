@@ -1,39 +1,163 @@
 #pragma once
 
-template <typename PathStateType>
-void ezPathSearch<PathStateType>::ClearPathStates()
+template <typename IndexType>
+void ezPathSearchOpenList<IndexType>::Push(IndexType index, float fCosts)
 {
-  m_PathStates.Clear();
-  m_StateQueue.Clear();
+  ezUInt32 uiIndex = m_Heap.GetCount();
+  m_Heap.ExpandAndGetRef();
+
+  // sift up
+  while (uiIndex > 0)
+  {
+    const ezUInt32 uiParent = (uiIndex - 1) / 2;
+
+    if (m_Heap[uiParent].m_fCosts <= fCosts)
+      break;
+
+    m_Heap[uiIndex] = m_Heap[uiParent];
+    uiIndex = uiParent;
+  }
+
+  m_Heap[uiIndex].m_fCosts = fCosts;
+  m_Heap[uiIndex].m_Index = index;
+}
+
+template <typename IndexType>
+typename ezPathSearchOpenList<IndexType>::Entry ezPathSearchOpenList<IndexType>::Pop()
+{
+  EZ_ASSERT_DEBUG(!m_Heap.IsEmpty(), "The open list is empty");
+
+  const Entry best = m_Heap[0];
+
+  // move the last entry to the top and sift it down
+  const Entry last = m_Heap.PeekBack();
+  m_Heap.PopBack();
+
+  const ezUInt32 uiCount = m_Heap.GetCount();
+  if (uiCount > 0)
+  {
+    ezUInt32 uiIndex = 0;
+
+    while (true)
+    {
+      ezUInt32 uiChild = uiIndex * 2 + 1;
+      if (uiChild >= uiCount)
+        break;
+
+      if (uiChild + 1 < uiCount && m_Heap[uiChild + 1].m_fCosts < m_Heap[uiChild].m_fCosts)
+        ++uiChild;
+
+      if (last.m_fCosts <= m_Heap[uiChild].m_fCosts)
+        break;
+
+      m_Heap[uiIndex] = m_Heap[uiChild];
+      uiIndex = uiChild;
+    }
+
+    m_Heap[uiIndex] = last;
+  }
+
+  return best;
 }
 
 template <typename PathStateType>
-ezInt64 ezPathSearch<PathStateType>::FindBestNodeToExpand(PathStateType*& out_pPathState)
+void ezPathSearch<PathStateType>::SetNodeIndexRange(ezUInt32 uiNumNodes)
 {
-  float fLowestEstimation = ezMath::Infinity<float>();
-  out_pPathState = nullptr;
-  ezUInt32 iBestInQueue = 0;
+  if (uiNumNodes == m_DenseNodes.GetCount())
+    return;
+
+  // the state of the nodes that are still in range stays as it is, new nodes get search ID 0, which is never the ID of a search
+  m_DenseNodes.SetCount(uiNumNodes);
 
-  for (ezUInt32 i = 0; i < m_StateQueue.GetCount(); ++i)
+  if (uiNumNodes == 0)
   {
-    const ezInt64 iNodeIndex = m_StateQueue[i];
+    m_DenseNodes.Compact();
+  }
+}
 
-    PathStateType* pState = &m_PathStates[iNodeIndex];
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::StartNewSearch()
+{
+  m_OpenList.Clear();
+  m_SparseNodes.Clear();
 
-    if (pState->m_fEstimatedCostToTarget < fLowestEstimation)
+  ++m_uiSearchID;
+
+  if (m_uiSearchID == 0)
+  {
+    // the search ID wrapped around, the data of very old searches would become valid again
+    for (NodeData& node : m_DenseNodes)
     {
-      fLowestEstimation = pState->m_fEstimatedCostToTarget;
-      out_pPathState = pState;
-      iBestInQueue = i;
+      node.m_uiSearchID = 0;
     }
+
+    m_uiSearchID = 1;
+  }
+
+  if (m_DenseNodes.IsEmpty())
+  {
+    m_SparseNodes.Reserve(10000);
   }
+}
+
+template <typename PathStateType>
+typename ezPathSearch<PathStateType>::NodeData* ezPathSearch<PathStateType>::FindNode(ezInt64 iNodeIndex)
+{
+  if (!m_DenseNodes.IsEmpty())
+  {
+    EZ_ASSERT_DEBUG(iNodeIndex >= 0 && iNodeIndex < m_DenseNodes.GetCount(), "Node index {} is outside the range given to SetNodeIndexRange()", iNodeIndex);
+
+    NodeData& node = m_DenseNodes[static_cast<ezUInt32>(iNodeIndex)];
+    return node.m_uiSearchID == m_uiSearchID ? &node : nullptr;
+  }
+
+  NodeData* pNode = nullptr;
+  m_SparseNodes.TryGetValue(iNodeIndex, pNode);
+  return pNode;
+}
 
-  EZ_ASSERT_DEV(out_pPathState != nullptr, "Implementation Error");
+template <typename PathStateType>
+typename ezPathSearch<PathStateType>::NodeData& ezPathSearch<PathStateType>::CreateNode(ezInt64 iNodeIndex)
+{
+  NodeData* pNode;
 
-  const ezInt64 iBestNodeIndex = m_StateQueue[iBestInQueue];
-  m_StateQueue.RemoveAtAndSwap(iBestInQueue);
+  if (!m_DenseNodes.IsEmpty())
+  {
+    EZ_ASSERT_DEBUG(iNodeIndex >= 0 && iNodeIndex < m_DenseNodes.GetCount(), "Node index {} is outside the range given to SetNodeIndexRange()", iNodeIndex);
 
-  return iBestNodeIndex;
+    pNode = &m_DenseNodes[static_cast<ezUInt32>(iNodeIndex)];
+  }
+  else
+  {
+    pNode = &m_SparseNodes[iNodeIndex];
+  }
+
+  pNode->m_uiSearchID = m_uiSearchID;
+  pNode->m_bExpanded = false;
+  return *pNode;
+}
+
+template <typename PathStateType>
+typename ezPathSearch<PathStateType>::NodeData* ezPathSearch<PathStateType>::PopBestNodeToExpand(ezInt64& out_iNodeIndex)
+{
+  while (!m_OpenList.IsEmpty())
+  {
+    const auto best = m_OpenList.Pop();
+
+    NodeData* pNode = FindNode(best.m_Index);
+    EZ_ASSERT_DEBUG(pNode != nullptr, "Implementation Error");
+
+    // when a node is reached through a cheaper path, it is queued again instead of updating its entry in the heap
+    // the outdated entries are skipped here
+    if (pNode->m_bExpanded || pNode->m_State.m_fEstimatedCostToTarget != best.m_fCosts)
+      continue;
+
+    pNode->m_bExpanded = true;
+    out_iNodeIndex = best.m_Index;
+    return pNode;
+  }
+
+  return nullptr;
 }
 
 template <typename PathStateType>
@@ -43,7 +167,7 @@ void ezPathSearch<PathStateType>::FillOutPathResult(ezInt64 iEndNodeIndex, ezDeq
 
   while (true)
   {
-    const PathStateType* pCurState = &m_PathStates[iEndNodeIndex];
+    const PathStateType* pCurState = &FindNode(iEndNodeIndex)->m_State;
 
     PathResultData r;
     r.m_iNodeIndex = iEndNodeIndex;
@@ -69,28 +193,32 @@ void ezPathSearch<PathStateType>::AddPathNode(ezInt64 iNodeIndex, const PathStat
   // ezArgF(m_pCurPathState->m_fEstimatedCostToTarget, 2), ezArgF(NewState.m_fEstimatedCostToTarget, 2));
   EZ_ASSERT_DEV(NewState.m_fEstimatedCostToTarget >= NewState.m_fCostToNode, "Unrealistic expectations will get you nowhere.");
 
-  PathStateType* pExistingState;
-
-  if (m_PathStates.TryGetValue(iNodeIndex, pExistingState))
+  if (NodeData* pExistingNode = FindNode(iNodeIndex))
   {
-    // state already exists in the hash table, and has a lower cost -> ignore the new state
-    if (pExistingState->m_fCostToNode <= NewState.m_fCostToNode)
+    // state already exists, and has a lower cost -> ignore the new state
+    if (pExistingNode->m_State.m_fCostToNode <= NewState.m_fCostToNode)
       return;
 
     // incoming state is better than the existing state -> update existing state
-    *pExistingState = NewState;
-    pExistingState->m_iReachedThroughNode = m_iCurNodeIndex;
+    pExistingNode->m_State = NewState;
+    pExistingNode->m_State.m_iReachedThroughNode = m_iCurNodeIndex;
+
+    // nodes that were expanded already are not expanded a second time
+    if (!pExistingNode->m_bExpanded)
+    {
+      m_OpenList.Push(iNodeIndex, NewState.m_fEstimatedCostToTarget);
+    }
+
     return;
   }
 
   // the state has not been reached before -> insert it
-  pExistingState = &m_PathStates[iNodeIndex];
-
-  *pExistingState = NewState;
-  pExistingState->m_iReachedThroughNode = m_iCurNodeIndex;
+  NodeData& newNode = CreateNode(iNodeIndex);
+  newNode.m_State = NewState;
+  newNode.m_State.m_iReachedThroughNode = m_iCurNodeIndex;
 
   // put it into the queue of states that still need to be expanded
-  m_StateQueue.PushBack(iNodeIndex);
+  m_OpenList.Push(iNodeIndex, NewState.m_fEstimatedCostToTarget);
 }
 
 template <typename PathStateType>
@@ -99,17 +227,16 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
 {
   EZ_ASSERT_DEV(m_pStateGenerator != nullptr, "No Path State Generator is set.");
 
-  ClearPathStates();
+  StartNewSearch();
 
   if (iStartNodeIndex == iTargetNodeIndex)
   {
-    m_PathStates.Reserve(1);
-
-    m_PathStates[iTargetNodeIndex] = StartState;
+    NodeData& targetNode = CreateNode(iTargetNodeIndex);
+    targetNode.m_State = StartState;
 
     PathResultData r;
     r.m_iNodeIndex = iTargetNodeIndex;
-    r.m_pPathState = &m_PathStates[iTargetNodeIndex];
+    r.m_pPathState = &targetNode.m_State;
 
     out_Path.Clear();
     out_Path.PushBack(r);
@@ -117,9 +244,7 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
     return EZ_SUCCESS;
   }
 
-  m_PathStates.Reserve(10000);
-
-  PathStateType& FirstState = m_PathStates[iStartNodeIndex];
+  PathStateType& FirstState = CreateNode(iStartNodeIndex).m_State;
 
   m_pStateGenerator->StartSearch(iStartNodeIndex, &FirstState, iTargetNodeIndex);
 
@@ -128,13 +253,12 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
   FirstState.m_iReachedThroughNode = iStartNodeIndex;
 
   // put the start state into the to-be-expanded queue
-  m_StateQueue.PushBack(iStartNodeIndex);
+  m_OpenList.Push(iStartNodeIndex, FirstState.m_fEstimatedCostToTarget);
 
   // while the queue is not empty, expand the next node and see where that gets us
-  while (!m_StateQueue.IsEmpty())
+  while (NodeData* pCurNode = PopBestNodeToExpand(m_iCurNodeIndex))
   {
-    PathStateType* pCurState;
-    m_iCurNodeIndex = FindBestNodeToExpand(pCurState);
+    const PathStateType* pCurState = &pCurNode->m_State;
 
     // we have reached the target node, generate the final path result
     if (m_iCurNodeIndex == iTargetNodeIndex)
@@ -170,11 +294,9 @@ ezResult ezPathSearch<PathStateType>::FindClosest(
 {
   EZ_ASSERT_DEV(m_pStateGenerator != nullptr, "No Path State Generator is set.");
 
-  ClearPathStates();
-
-  m_PathStates.Reserve(10000);
+  StartNewSearch();
 
-  PathStateType& FirstState = m_PathStates[iStartNodeIndex];
+  PathStateType& FirstState = CreateNode(iStartNodeIndex).m_State;
 
   m_pStateGenerator->StartSearchForClosest(iStartNodeIndex, &FirstState);
 
@@ -183,13 +305,12 @@ ezResult ezPathSearch<PathStateType>::FindClosest(
   FirstState.m_iReachedThroughNode = iStartNodeIndex;
 
   // put the start state into the to-be-expanded queue
-  m_StateQueue.PushBack(iStartNodeIndex);
+  m_OpenList.Push(iStartNodeIndex, FirstState.m_fEstimatedCostToTarget);
 
   // while the queue is not empty, expand the next node and see where that gets us
-  while (!m_StateQueue.IsEmpty())
+  while (NodeData* pCurNode = PopBestNodeToExpand(m_iCurNodeIndex))
   {
-    PathStateType* pCurState;
-    m_iCurNodeIndex = FindBestNodeToExpand(pCurState);
+    const PathStateType* pCurState = &pCurNode->m_State;
 
     // we have reached the target node, generate the final path result
     if (Callback(m_iCurNodeIndex, *pCurState))
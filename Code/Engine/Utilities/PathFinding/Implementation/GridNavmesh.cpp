@@ -2,9 +2,110 @@
 
 #include <Utilities/PathFinding/GridNavmesh.h>
 
+ezRectU32 ezGridNavmesh::RebuildRegion(ezRectU32 region, CellComparator IsSameCellType, void* pPassThrough1, CellBlocked IsCellBlocked, void* pPassThrough2)
+{
+  region.Clip(ezRectU32(m_NodesGrid.GetGridSizeX(), m_NodesGrid.GetGridSizeY()));
+
+  if (!region.HasNonZeroArea())
+    return region;
+
+  // enlarge the region until it contains all areas that overlap it entirely
+  bool bGrown = true;
+  while (bGrown)
+  {
+    bGrown = false;
+
+    for (ezUInt32 y = region.y; y < region.y + region.height; ++y)
+    {
+      for (ezUInt32 x = region.x; x < region.x + region.width; ++x)
+      {
+        const ezInt32 iArea = m_NodesGrid.GetCell(ezVec2I32(x, y));
+
+        if (iArea >= 0 && !region.Contains(m_ConvexAreas[iArea].m_Rect))
+        {
+          region.ExpandToInclude(m_ConvexAreas[iArea].m_Rect);
+          bGrown = true;
+        }
+      }
+    }
+  }
+
+  // remove all areas in the region, their indices get reused by CreateNodes()
+  for (ezUInt32 y = region.y; y < region.y + region.height; ++y)
+  {
+    for (ezUInt32 x = region.x; x < region.x + region.width; ++x)
+    {
+      const ezInt32 iArea = m_NodesGrid.GetCell(ezVec2I32(x, y));
+
+      // only handle each area once, at its top left cell
+      if (iArea < 0 || m_ConvexAreas[iArea].m_Rect.x != x || m_ConvexAreas[iArea].m_Rect.y != y)
+        continue;
+
+      ConvexArea& area = m_ConvexAreas[iArea];
+      m_uiNumUnusedEdges += area.m_uiNumEdges;
+      area.m_Rect = ezRectU32(0, 0);
+      area.m_uiFirstEdge = 0;
+      area.m_uiNumEdges = 0;
+
+      m_FreeAreas.PushBack(iArea);
+    }
+  }
+
+  UpdateRegion(region, IsSameCellType, pPassThrough1, IsCellBlocked, pPassThrough2);
+
+  // the new areas and all areas directly around the region need new edges
+  for (ezInt32 iArea : m_CreatedAreas)
+  {
+    CreateGraphEdges(m_ConvexAreas[iArea]);
+  }
+
+  // the edges of the areas directly around the region may lead to removed areas
+  {
+    const ezUInt32 uiMinX = region.x > 0 ? region.x - 1 : 0;
+    const ezUInt32 uiMinY = region.y > 0 ? region.y - 1 : 0;
+    const ezUInt32 uiMaxX = ezMath::Min<ezUInt32>(region.x + region.width + 1, m_NodesGrid.GetGridSizeX());
+    const ezUInt32 uiMaxY = ezMath::Min<ezUInt32>(region.y + region.height + 1, m_NodesGrid.GetGridSizeY());
+
+    ezHybridArray<ezInt32, 64> neighborAreas;
+
+    for (ezUInt32 y = uiMinY; y < uiMaxY; ++y)
+    {
+      for (ezUInt32 x = uiMinX; x < uiMaxX; ++x)
+      {
+        const bool bInsideRegion = x >= region.x && x < region.x + region.width && y >= region.y && y < region.y + region.height;
+        if (bInsideRegion)
+          continue;
+
+        const ezInt32 iArea = m_NodesGrid.GetCell(ezVec2I32(x, y));
+
+        // areas usually touch the region at several cells
+        if (iArea >= 0 && !neighborAreas.Contains(iArea))
+        {
+          neighborAreas.PushBack(iArea);
+        }
+      }
+    }
+
+    for (ezInt32 iArea : neighborAreas)
+    {
+      m_uiNumUnusedEdges += m_ConvexAreas[iArea].m_uiNumEdges;
+      CreateGraphEdges(m_ConvexAreas[iArea]);
+    }
+  }
+
+  // don't let the edge array grow forever
+  if (m_uiNumUnusedEdges > m_GraphEdges.GetCount() / 2)
+  {
+    CreateGraphEdges();
+  }
+
+  return region;
+}
+
 void ezGridNavmesh::UpdateRegion(ezRectU32 region, CellComparator IsSameCellType, void* pPassThrough1, CellBlocked IsCellBlocked, void* pPassThrough2)
 {
-  ezInt32 iInvalidNode = -(ezInt32)m_ConvexAreas.GetCount();
+  // -1 marks blocked cells, which may be adjacent to the region, so the temporary IDs have to start below that
+  ezInt32 iInvalidNode = -(ezInt32)m_ConvexAreas.GetCount() - 1;
 
   // initialize with 'invalid'
   for (ezUInt32 y = region.y; y < region.y + region.height; ++y)
@@ -85,6 +186,8 @@ void ezGridNavmesh::Merge(const ezRectU32& rect)
 
 void ezGridNavmesh::CreateNodes(ezRectU32 region, CellBlocked IsCellBlocked, void* pPassThrough)
 {
+  m_CreatedAreas.Clear();
+
   for (ezUInt32 y = region.y; y < region.y + region.height; ++y)
   {
     for (ezUInt32 x = region.x; x < region.x + region.width; ++x)
@@ -102,9 +205,24 @@ void ezGridNavmesh::CreateNodes(ezRectU32 region, CellBlocked IsCellBlocked, voi
 
       ConvexArea a;
       a.m_Rect = GetCellBBox(x, y);
+      a.m_uiFirstEdge = 0;
+      a.m_uiNumEdges = 0;
 
-      m_NodesGrid.GetCell(ezVec2I32(a.m_Rect.x, a.m_Rect.y)) = m_ConvexAreas.GetCount();
-      m_ConvexAreas.PushBack(a);
+      ezInt32 iNewArea;
+      if (!m_FreeAreas.IsEmpty())
+      {
+        iNewArea = m_FreeAreas.PeekBack();
+        m_FreeAreas.PopBack();
+        m_ConvexAreas[iNewArea] = a;
+      }
+      else
+      {
+        iNewArea = m_ConvexAreas.GetCount();
+        m_ConvexAreas.PushBack(a);
+      }
+
+      m_CreatedAreas.PushBack(iNewArea);
+      m_NodesGrid.GetCell(ezVec2I32(a.m_Rect.x, a.m_Rect.y)) = iNewArea;
 
       Merge(a.m_Rect);
     }
@@ -242,6 +360,10 @@ bool ezGridNavmesh::OptimizeBoxes(ezRectU32 region, CellComparator IsSameCellTyp
       NewArea.width = uiWidth;
       NewArea.height = uiHeight;
 
+      // when only a part of the navmesh is updated, the areas outside the region must stay untouched
+      if (!region.Contains(NewArea))
+        continue;
+
       if (CanCreateArea(NewArea, IsSameCellType, pPassThrough))
       {
         bMergedAny = true;
@@ -338,6 +460,10 @@ bool ezGridNavmesh::MergeBestFit(ezRectU32 region, CellComparator IsSameCellType
           bRR = true;
       }
 
+      // when only a part of the navmesh is updated, the areas outside the region must stay untouched
+      bRD = bRD && region.Contains(rd);
+      bRR = bRR && region.Contains(rr);
+
       if (bRR && bRD)
       {
         const float fRatioRR = (float)ezMath::Max(rr.width, rr.height) / (float)ezMath::Min(rr.width, rr.height);
@@ -373,6 +499,7 @@ bool ezGridNavmesh::MergeBestFit(ezRectU32 region, CellComparator IsSameCellType
 void ezGridNavmesh::CreateGraphEdges()
 {
   m_GraphEdges.Clear();
+  m_uiNumUnusedEdges = 0;
 
   for (ezUInt32 i = 0; i < m_ConvexAreas.GetCount(); ++i)
     CreateGraphEdges(m_ConvexAreas[i]);
@@ -383,6 +510,10 @@ void ezGridNavmesh::CreateGraphEdges(ConvexArea& Area)
   Area.m_uiFirstEdge = m_GraphEdges.GetCount();
   Area.m_uiNumEdges = 0;
 
+  // removed by UpdateCells()
+  if (!Area.m_Rect.HasNonZeroArea())
+    return;
+
   if (Area.m_Rect.y > 0)
   {
     AreaEdge e;
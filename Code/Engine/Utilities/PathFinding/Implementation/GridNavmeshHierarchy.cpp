@@ -0,0 +1,489 @@
+#include <Utilities/UtilitiesPCH.h>
+
+#include <Utilities/PathFinding/GridNavmeshHierarchy.h>
+
+ezGridNavmeshHierarchy::ezGridNavmeshHierarchy()
+{
+  m_AbstractSearch.SetPathStateGenerator(this);
+}
+
+ezGridNavmeshHierarchy::~ezGridNavmeshHierarchy() = default;
+
+void ezGridNavmeshHierarchy::Build(const ezGridNavmesh& navmesh, ezUInt32 uiClusterSize)
+{
+  EZ_ASSERT_DEV(uiClusterSize > 0, "Invalid cluster size");
+
+  m_pNavmesh = &navmesh;
+  m_uiClusterSize = uiClusterSize;
+
+  const ezVec2U32 vGridSize = navmesh.GetGridSize();
+  m_uiNumClustersX = (vGridSize.x + uiClusterSize - 1) / uiClusterSize;
+  m_uiNumClustersY = (vGridSize.y + uiClusterSize - 1) / uiClusterSize;
+
+  m_Clusters.Clear();
+  m_Clusters.SetCount(m_uiNumClustersX * m_uiNumClustersY);
+
+  m_AreaInfos.Clear();
+  m_AreaInfos.SetCount(navmesh.GetNumConvexAreas());
+
+  m_AbstractSearch.SetNodeIndexRange(navmesh.GetNumConvexAreas());
+
+  // all area infos are set before the first cluster is built, which is needed to detect the entrances
+  for (ezUInt32 uiCluster = 0; uiCluster < m_Clusters.GetCount(); ++uiCluster)
+  {
+    const ezUInt32 uiClusterX = uiCluster % m_uiNumClustersX;
+    const ezUInt32 uiClusterY = uiCluster / m_uiNumClustersX;
+
+    const ezUInt32 uiMaxX = ezMath::Min((uiClusterX + 1) * uiClusterSize, vGridSize.x);
+    const ezUInt32 uiMaxY = ezMath::Min((uiClusterY + 1) * uiClusterSize, vGridSize.y);
+
+    for (ezUInt32 y = uiClusterY * uiClusterSize; y < uiMaxY; ++y)
+    {
+      for (ezUInt32 x = uiClusterX * uiClusterSize; x < uiMaxX; ++x)
+      {
+        const ezInt32 iArea = navmesh.GetAreaAt(ezVec2I32(x, y));
+        if (iArea < 0)
+          continue;
+
+        // every area is only added by its top left cell
+        const ezRectU32& rect = navmesh.GetConvexArea(iArea).m_Rect;
+        if (rect.x != x || rect.y != y)
+          continue;
+
+        Cluster& cluster = m_Clusters[uiCluster];
+        m_AreaInfos[iArea].m_uiCluster = uiCluster;
+        m_AreaInfos[iArea].m_uiIndexInCluster = cluster.m_Areas.GetCount();
+        cluster.m_Areas.PushBack(iArea);
+      }
+    }
+  }
+
+  for (ezUInt32 uiCluster = 0; uiCluster < m_Clusters.GetCount(); ++uiCluster)
+  {
+    RebuildCluster(uiCluster);
+  }
+}
+
+void ezGridNavmeshHierarchy::UpdateRegion(const ezRectU32& region)
+{
+  EZ_ASSERT_DEV(m_pNavmesh != nullptr, "The hierarchy has not been built yet.");
+
+  if (!region.HasNonZeroArea())
+    return;
+
+  const ezVec2U32 vGridSize = m_pNavmesh->GetGridSize();
+
+  // new areas may have been added to the navmesh
+  const ezUInt32 uiNumAreas = m_pNavmesh->GetNumConvexAreas();
+  if (uiNumAreas != m_AreaInfos.GetCount())
+  {
+    m_AreaInfos.SetCount(uiNumAreas);
+    m_AbstractSearch.SetNodeIndexRange(uiNumAreas);
+  }
+
+  // the region plus a ring of one cell around it, that contains all areas whose edges may have changed
+  const ezUInt32 uiMinX = region.x > 0 ? region.x - 1 : 0;
+  const ezUInt32 uiMinY = region.y > 0 ? region.y - 1 : 0;
+  const ezUInt32 uiMaxX = ezMath::Min(region.Right() + 1, vGridSize.x);
+  const ezUInt32 uiMaxY = ezMath::Min(region.Bottom() + 1, vGridSize.y);
+
+  m_ClustersToRebuild.Clear();
+
+  // all clusters that overlap the region
+  for (ezUInt32 cy = uiMinY / m_uiClusterSize; cy <= (uiMaxY - 1) / m_uiClusterSize; ++cy)
+  {
+    for (ezUInt32 cx = uiMinX / m_uiClusterSize; cx <= (uiMaxX - 1) / m_uiClusterSize; ++cx)
+    {
+      m_ClustersToRebuild.PushBack(cy * m_uiNumClustersX + cx);
+    }
+  }
+
+  // large areas in the ring may belong to clusters that are further away
+  for (ezUInt32 y = uiMinY; y < uiMaxY; ++y)
+  {
+    for (ezUInt32 x = uiMinX; x < uiMaxX; ++x)
+    {
+      // skip the inside of the region
+      if (x >= region.x && x < region.Right() && y >= region.y && y < region.Bottom())
+        x = region.Right();
+
+      if (x >= uiMaxX)
+        break;
+
+      const ezInt32 iArea = m_pNavmesh->GetAreaAt(ezVec2I32(x, y));
+      if (iArea < 0)
+        continue;
+
+      const ezUInt32 uiCluster = GetClusterOfArea(iArea);
+      if (!m_ClustersToRebuild.Contains(uiCluster))
+      {
+        m_ClustersToRebuild.PushBack(uiCluster);
+      }
+    }
+  }
+
+  // first remove all areas from the affected clusters, since removed area indices may be reused in another cluster
+  for (ezUInt32 uiCluster : m_ClustersToRebuild)
+  {
+    Cluster& cluster = m_Clusters[uiCluster];
+
+    for (ezInt32 iArea : cluster.m_Areas)
+    {
+      m_AreaInfos[iArea] = AreaInfo();
+    }
+
+    cluster.m_Areas.Clear();
+  }
+
+  for (ezUInt32 uiCluster : m_ClustersToRebuild)
+  {
+    const ezUInt32 uiClusterX = uiCluster % m_uiNumClustersX;
+    const ezUInt32 uiClusterY = uiCluster / m_uiNumClustersX;
+
+    const ezUInt32 uiClusterMaxX = ezMath::Min((uiClusterX + 1) * m_uiClusterSize, vGridSize.x);
+    const ezUInt32 uiClusterMaxY = ezMath::Min((uiClusterY + 1) * m_uiClusterSize, vGridSize.y);
+
+    Cluster& cluster = m_Clusters[uiCluster];
+
+    for (ezUInt32 y = uiClusterY * m_uiClusterSize; y < uiClusterMaxY; ++y)
+    {
+      for (ezUInt32 x = uiClusterX * m_uiClusterSize; x < uiClusterMaxX; ++x)
+      {
+        const ezInt32 iArea = m_pNavmesh->GetAreaAt(ezVec2I32(x, y));
+        if (iArea < 0)
+          continue;
+
+        const ezRectU32& rect = m_pNavmesh->GetConvexArea(iArea).m_Rect;
+        if (rect.x != x || rect.y != y)
+          continue;
+
+        m_AreaInfos[iArea].m_uiCluster = uiCluster;
+        m_AreaInfos[iArea].m_uiIndexInCluster = cluster.m_Areas.GetCount();
+        cluster.m_Areas.PushBack(iArea);
+      }
+    }
+  }
+
+  for (ezUInt32 uiCluster : m_ClustersToRebuild)
+  {
+    RebuildCluster(uiCluster);
+  }
+}
+
+ezUInt32 ezGridNavmeshHierarchy::GetNumEntrances() const
+{
+  ezUInt32 uiNumEntrances = 0;
+
+  for (const Cluster& cluster : m_Clusters)
+  {
+    uiNumEntrances += cluster.m_Entrances.GetCount();
+  }
+
+  return uiNumEntrances;
+}
+
+ezUInt32 ezGridNavmeshHierarchy::GetClusterOfArea(ezInt32 iArea) const
+{
+  const ezRectU32& rect = m_pNavmesh->GetConvexArea(iArea).m_Rect;
+  return (rect.y / m_uiClusterSize) * m_uiNumClustersX + (rect.x / m_uiClusterSize);
+}
+
+ezVec2 ezGridNavmeshHierarchy::GetAreaCenter(ezInt32 iArea) const
+{
+  const ezRectU32& rect = m_pNavmesh->GetConvexArea(iArea).m_Rect;
+  return ezVec2(rect.x + rect.width * 0.5f, rect.y + rect.height * 0.5f);
+}
+
+float ezGridNavmeshHierarchy::GetCosts(ezInt32 iArea1, ezInt32 iArea2) const
+{
+  // the path search requires non-zero costs
+  return ezMath::Max((GetAreaCenter(iArea1) - GetAreaCenter(iArea2)).GetLength(), 0.01f);
+}
+
+void ezGridNavmeshHierarchy::RebuildCluster(ezUInt32 uiCluster)
+{
+  Cluster& cluster = m_Clusters[uiCluster];
+  const ezUInt32 uiNumAreas = cluster.m_Areas.GetCount();
+
+  cluster.m_Entrances.Clear();
+
+  for (ezUInt32 i = 0; i < uiNumAreas; ++i)
+  {
+    const ezInt32 iArea = cluster.m_Areas[i];
+    const ezGridNavmesh::ConvexArea& area = m_pNavmesh->GetConvexArea(iArea);
+
+    m_AreaInfos[iArea].m_uiEntranceIndex = ezInvalidIndex;
+
+    for (ezUInt32 e = 0; e < area.m_uiNumEdges; ++e)
+    {
+      const ezInt32 iNeighbor = m_pNavmesh->GetAreaEdge(area.m_uiFirstEdge + e).m_iNeighborArea;
+
+      if (GetClusterOfArea(iNeighbor) != uiCluster)
+      {
+        m_AreaInfos[iArea].m_uiEntranceIndex = cluster.m_Entrances.GetCount();
+        cluster.m_Entrances.PushBack(i);
+        break;
+      }
+    }
+  }
+
+  const ezUInt32 uiNumEntrances = cluster.m_Entrances.GetCount();
+
+  cluster.m_EntranceCosts.SetCountUninitialized(uiNumEntrances * uiNumEntrances);
+  cluster.m_EntrancePathPredecessors.SetCountUninitialized(uiNumEntrances * uiNumAreas);
+
+  // the start search is only needed during FindPath(), so its costs array can be used as temp storage
+  ezDynamicArray<float>& costs = m_StartSearch.m_Costs;
+  costs.SetCountUninitialized(uiNumAreas);
+
+  for (ezUInt32 e = 0; e < uiNumEntrances; ++e)
+  {
+    SearchInsideCluster(uiCluster, cluster.m_Entrances[e], costs.GetData(), cluster.m_EntrancePathPredecessors.GetData() + e * uiNumAreas);
+
+    for (ezUInt32 e2 = 0; e2 < uiNumEntrances; ++e2)
+    {
+      cluster.m_EntranceCosts[e * uiNumEntrances + e2] = costs[cluster.m_Entrances[e2]];
+    }
+  }
+}
+
+void ezGridNavmeshHierarchy::SearchInsideCluster(ezUInt32 uiCluster, ezUInt32 uiStartIndex, float* pCosts, ezUInt32* pPredecessors)
+{
+  const Cluster& cluster = m_Clusters[uiCluster];
+  const ezUInt32 uiNumAreas = cluster.m_Areas.GetCount();
+
+  for (ezUInt32 i = 0; i < uiNumAreas; ++i)
+  {
+    pCosts[i] = ezMath::Infinity<float>();
+    pPredecessors[i] = ezInvalidIndex;
+  }
+
+  pCosts[uiStartIndex] = 0.0f;
+  pPredecessors[uiStartIndex] = uiStartIndex;
+
+  // Dijkstra with a binary heap, outdated entries are skipped when they are popped
+  m_OpenAreas.Clear();
+  m_OpenAreas.Push(uiStartIndex, 0.0f);
+
+  while (!m_OpenAreas.IsEmpty())
+  {
+    const auto best = m_OpenAreas.Pop();
+
+    if (best.m_fCosts > pCosts[best.m_Index])
+      continue;
+
+    const ezInt32 iArea = cluster.m_Areas[best.m_Index];
+    const ezGridNavmesh::ConvexArea& area = m_pNavmesh->GetConvexArea(iArea);
+
+    for (ezUInt32 e = 0; e < area.m_uiNumEdges; ++e)
+    {
+      const ezInt32 iNeighbor = m_pNavmesh->GetAreaEdge(area.m_uiFirstEdge + e).m_iNeighborArea;
+
+      if (m_AreaInfos[iNeighbor].m_uiCluster != uiCluster)
+        continue;
+
+      const ezUInt32 uiNeighborIndex = m_AreaInfos[iNeighbor].m_uiIndexInCluster;
+      const float fCosts = best.m_fCosts + GetCosts(iArea, iNeighbor);
+
+      if (fCosts >= pCosts[uiNeighborIndex])
+        continue;
+
+      pCosts[uiNeighborIndex] = fCosts;
+      pPredecessors[uiNeighborIndex] = best.m_Index;
+
+      m_OpenAreas.Push(uiNeighborIndex, fCosts);
+    }
+  }
+}
+
+void ezGridNavmeshHierarchy::AppendClusterPath(const Cluster& cluster, const ezUInt32* pPredecessors, ezUInt32 uiFromIndex, bool bReverse, ezDynamicArray<ezInt32>& inout_areas) const
+{
+  // Follows the predecessors from uiFromIndex to the start of the search that computed them.
+  // Without bReverse the areas after uiFromIndex up to and including the start are appended,
+  // with bReverse the areas from the start (excluded) to uiFromIndex (included) are appended.
+
+  const ezUInt32 uiFirstNew = inout_areas.GetCount();
+
+  ezUInt32 uiIndex = uiFromIndex;
+  if (!bReverse)
+  {
+    uiIndex = pPredecessors[uiIndex];
+    inout_areas.PushBack(cluster.m_Areas[uiIndex]);
+  }
+
+  while (pPredecessors[uiIndex] != uiIndex)
+  {
+    if (bReverse)
+      inout_areas.PushBack(cluster.m_Areas[uiIndex]);
+
+    uiIndex = pPredecessors[uiIndex];
+
+    if (!bReverse)
+      inout_areas.PushBack(cluster.m_Areas[uiIndex]);
+  }
+
+  if (bReverse)
+  {
+    for (ezUInt32 i = uiFirstNew, j = inout_areas.GetCount() - 1; i < j; ++i, --j)
+    {
+      ezMath::Swap(inout_areas[i], inout_areas[j]);
+    }
+  }
+}
+
+ezResult ezGridNavmeshHierarchy::FindPath(const ezVec2I32& vStartCell, const ezVec2I32& vTargetCell, ezDynamicArray<ezInt32>& out_areas)
+{
+  EZ_ASSERT_DEV(m_pNavmesh != nullptr, "The hierarchy has not been built yet.");
+
+  out_areas.Clear();
+
+  const ezVec2U32 vGridSize = m_pNavmesh->GetGridSize();
+  if (vStartCell.x < 0 || vStartCell.y < 0 || vStartCell.x >= (ezInt32)vGridSize.x || vStartCell.y >= (ezInt32)vGridSize.y ||
+      vTargetCell.x < 0 || vTargetCell.y < 0 || vTargetCell.x >= (ezInt32)vGridSize.x || vTargetCell.y >= (ezInt32)vGridSize.y)
+    return EZ_FAILURE;
+
+  m_iStartArea = m_pNavmesh->GetAreaAt(vStartCell);
+  m_iTargetArea = m_pNavmesh->GetAreaAt(vTargetCell);
+
+  if (m_iStartArea < 0 || m_iTargetArea < 0)
+    return EZ_FAILURE;
+
+  if (m_iStartArea == m_iTargetArea)
+  {
+    out_areas.PushBack(m_iStartArea);
+    return EZ_SUCCESS;
+  }
+
+  m_vTargetCenter = GetAreaCenter(m_iTargetArea);
+
+  // paths from the start to all entrances of its cluster and from the target to all entrances of its cluster
+  const AreaInfo& startInfo = m_AreaInfos[m_iStartArea];
+  const AreaInfo& targetInfo = m_AreaInfos[m_iTargetArea];
+
+  const ezUInt32 uiNumStartAreas = m_Clusters[startInfo.m_uiCluster].m_Areas.GetCount();
+  m_StartSearch.m_Costs.SetCountUninitialized(uiNumStartAreas);
+  m_StartSearch.m_Predecessors.SetCountUninitialized(uiNumStartAreas);
+  SearchInsideCluster(startInfo.m_uiCluster, startInfo.m_uiIndexInCluster, m_StartSearch.m_Costs.GetData(), m_StartSearch.m_Predecessors.GetData());
+
+  const ezUInt32 uiNumTargetAreas = m_Clusters[targetInfo.m_uiCluster].m_Areas.GetCount();
+  m_TargetSearch.m_Costs.SetCountUninitialized(uiNumTargetAreas);
+  m_TargetSearch.m_Predecessors.SetCountUninitialized(uiNumTargetAreas);
+  SearchInsideCluster(targetInfo.m_uiCluster, targetInfo.m_uiIndexInCluster, m_TargetSearch.m_Costs.GetData(), m_TargetSearch.m_Predecessors.GetData());
+
+  // search through the abstract graph
+  if (m_AbstractSearch.FindPath(m_iStartArea, ezPathState(), m_iTargetArea, m_AbstractPath).Failed())
+    return EZ_FAILURE;
+
+  // refine the abstract path to the full sequence of areas
+  out_areas.PushBack(m_iStartArea);
+
+  for (ezUInt32 i = 1; i < m_AbstractPath.GetCount(); ++i)
+  {
+    const ezInt32 iFrom = static_cast<ezInt32>(m_AbstractPath[i - 1].m_iNodeIndex);
+    const ezInt32 iTo = static_cast<ezInt32>(m_AbstractPath[i].m_iNodeIndex);
+
+    const AreaInfo& fromInfo = m_AreaInfos[iFrom];
+    const AreaInfo& toInfo = m_AreaInfos[iTo];
+    const Cluster& cluster = m_Clusters[fromInfo.m_uiCluster];
+
+    if (fromInfo.m_uiCluster != toInfo.m_uiCluster)
+    {
+      // an edge between two clusters
+      out_areas.PushBack(iTo);
+    }
+    else if (iTo == m_iTargetArea)
+    {
+      AppendClusterPath(cluster, m_TargetSearch.m_Predecessors.GetData(), fromInfo.m_uiIndexInCluster, false, out_areas);
+    }
+    else if (iFrom == m_iStartArea)
+    {
+      AppendClusterPath(cluster, m_StartSearch.m_Predecessors.GetData(), toInfo.m_uiIndexInCluster, true, out_areas);
+    }
+    else
+    {
+      const ezUInt32* pPredecessors = cluster.m_EntrancePathPredecessors.GetData() + fromInfo.m_uiEntranceIndex * cluster.m_Areas.GetCount();
+      AppendClusterPath(cluster, pPredecessors, toInfo.m_uiIndexInCluster, true, out_areas);
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezGridNavmeshHierarchy::StartSearch(ezInt64 iStartNodeIndex, const ezPathState* pStartState, ezInt64 iTargetNodeIndex)
+{
+  EZ_IGNORE_UNUSED(iStartNodeIndex);
+  EZ_IGNORE_UNUSED(pStartState);
+  EZ_IGNORE_UNUSED(iTargetNodeIndex);
+}
+
+void ezGridNavmeshHierarchy::AddAdjacentState(ezInt32 iArea, float fCosts, const ezPathState& startState, ezPathSearch<ezPathState>* pPathSearch) const
+{
+  ezPathState state;
+  state.m_fCostToNode = startState.m_fCostToNode + fCosts;
+  state.m_fEstimatedCostToTarget = state.m_fCostToNode + (GetAreaCenter(iArea) - m_vTargetCenter).GetLength();
+
+  pPathSearch->AddPathNode(iArea, state);
+}
+
+void ezGridNavmeshHierarchy::GenerateAdjacentStates(ezInt64 iNodeIndex, const ezPathState& startState, ezPathSearch<ezPathState>* pPathSearch)
+{
+  // The nodes of the abstract graph are the start area, the target area and all entrances.
+  const ezInt32 iArea = static_cast<ezInt32>(iNodeIndex);
+  const AreaInfo& info = m_AreaInfos[iArea];
+  const Cluster& cluster = m_Clusters[info.m_uiCluster];
+  const ezUInt32 uiNumEntrances = cluster.m_Entrances.GetCount();
+
+  if (iArea == m_iStartArea)
+  {
+    // to all entrances of the start cluster
+    for (ezUInt32 e = 0; e < uiNumEntrances; ++e)
+    {
+      const float fCosts = m_StartSearch.m_Costs[cluster.m_Entrances[e]];
+
+      if (e != info.m_uiEntranceIndex && fCosts < ezMath::Infinity<float>())
+      {
+        AddAdjacentState(cluster.m_Areas[cluster.m_Entrances[e]], fCosts, startState, pPathSearch);
+      }
+    }
+  }
+  else if (info.m_uiEntranceIndex != ezInvalidIndex)
+  {
+    // to all other entrances of the same cluster
+    const float* pCosts = cluster.m_EntranceCosts.GetData() + info.m_uiEntranceIndex * uiNumEntrances;
+
+    for (ezUInt32 e = 0; e < uiNumEntrances; ++e)
+    {
+      if (e != info.m_uiEntranceIndex && pCosts[e] < ezMath::Infinity<float>())
+      {
+        AddAdjacentState(cluster.m_Areas[cluster.m_Entrances[e]], pCosts[e], startState, pPathSearch);
+      }
+    }
+  }
+
+  if (info.m_uiEntranceIndex != ezInvalidIndex)
+  {
+    // to the entrances of the neighboring clusters
+    const ezGridNavmesh::ConvexArea& area = m_pNavmesh->GetConvexArea(iArea);
+
+    for (ezUInt32 e = 0; e < area.m_uiNumEdges; ++e)
+    {
+      const ezInt32 iNeighbor = m_pNavmesh->GetAreaEdge(area.m_uiFirstEdge + e).m_iNeighborArea;
+
+      if (m_AreaInfos[iNeighbor].m_uiCluster != info.m_uiCluster)
+      {
+        AddAdjacentState(iNeighbor, GetCosts(iArea, iNeighbor), startState, pPathSearch);
+      }
+    }
+  }
+
+  if (info.m_uiCluster == m_AreaInfos[m_iTargetArea].m_uiCluster)
+  {
+    // to the target, all costs are symmetric
+    const float fCosts = m_TargetSearch.m_Costs[info.m_uiIndexInCluster];
+
+    if (fCosts < ezMath::Infinity<float>())
+    {
+      AddAdjacentState(m_iTargetArea, fCosts, startState, pPathSearch);
+    }
+  }
+}
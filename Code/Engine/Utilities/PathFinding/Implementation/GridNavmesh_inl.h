@@ -5,8 +5,19 @@ void ezGridNavmesh::CreateFromGrid(
   const ezGameGrid<CellData>& grid, CellComparator isSameCellType, void* pPassThrough, CellBlocked isCellBlocked, void* pPassThrough2)
 {
   m_NodesGrid.CreateGrid(grid.GetGridSizeX(), grid.GetGridSizeY());
+  m_ConvexAreas.Clear();
+  m_FreeAreas.Clear();
 
   UpdateRegion(ezRectU32(grid.GetGridSizeX(), grid.GetGridSizeY()), isSameCellType, pPassThrough, isCellBlocked, pPassThrough2);
 
   CreateGraphEdges();
 }
+
+template <class CellData>
+ezRectU32 ezGridNavmesh::UpdateCells(
+  const ezGameGrid<CellData>& grid, ezRectU32 region, CellComparator isSameCellType, void* pPassThrough, CellBlocked isCellBlocked, void* pPassThrough2)
+{
+  EZ_ASSERT_DEV(grid.GetGridSizeX() == m_NodesGrid.GetGridSizeX() && grid.GetGridSizeY() == m_NodesGrid.GetGridSizeY(), "The grid size has changed, the navmesh must be recreated.");
+
+  return RebuildRegion(region, isSameCellType, pPassThrough, isCellBlocked, pPassThrough2);
+}
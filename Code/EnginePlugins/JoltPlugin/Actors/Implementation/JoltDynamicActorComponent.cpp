@@ -4,6 +4,7 @@
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
 #include <Jolt/Physics/Collision/Shape/SphereShape.h>
 #include <Jolt/Physics/PhysicsSystem.h>
@@ -30,28 +31,53 @@ void ezJoltDynamicActorComponentManager::UpdateDynamicActors()
   ezJoltWorldModule* pModule = GetWorld()->GetOrCreateModule<ezJoltWorldModule>();
   auto* pSystem = pModule->GetJoltSystem();
 
+  m_ActorsToUpdate.Clear();
+  m_ChildActorsToUpdate.Clear();
+
   for (auto itActor : pModule->GetActiveActors())
   {
-    ezJoltDynamicActorComponent* pActor = itActor;
+    // setting the global transform of an object with a parent reads the parent's transform,
+    // which another task may write at the same time, so those objects are updated afterwards
+    if (itActor->GetOwner()->GetParent() == nullptr)
+      m_ActorsToUpdate.PushBack(itActor);
+    else
+      m_ChildActorsToUpdate.PushBack(itActor);
+  }
 
-    JPH::BodyID bodyId(pActor->GetJoltBodyID());
+  // the simulation step has finished, nothing modifies the bodies now, so they can be read without locking
+  const JPH::BodyLockInterface* pLockInterface = &pSystem->GetBodyLockInterfaceNoLock();
 
-    JPH::BodyLockRead bodyLock(pSystem->GetBodyLockInterface(), bodyId);
-    if (!bodyLock.Succeeded())
-      continue;
+  auto updateActors = [pLockInterface](ezArrayPtr<ezJoltDynamicActorComponent*> actors)
+  {
+    for (ezJoltDynamicActorComponent* pActor : actors)
+    {
+      JPH::BodyID bodyId(pActor->GetJoltBodyID());
 
-    const JPH::Body& body = bodyLock.GetBody();
+      JPH::BodyLockRead bodyLock(*pLockInterface, bodyId);
+      if (!bodyLock.Succeeded())
+        continue;
 
-    if (!body.IsDynamic())
-      continue;
+      const JPH::Body& body = bodyLock.GetBody();
 
-    ezSimdTransform trans = pActor->GetOwner()->GetGlobalTransformSimd();
+      if (!body.IsDynamic())
+        continue;
 
-    trans.m_Position = ezJoltConversionUtils::ToSimdVec3(body.GetPosition());
-    trans.m_Rotation = ezJoltConversionUtils::ToSimdQuat(body.GetRotation());
+      ezSimdTransform trans = pActor->GetOwner()->GetGlobalTransformSimd();
 
-    pActor->GetOwner()->SetGlobalTransform(trans);
-  }
+      trans.m_Position = ezJoltConversionUtils::ToSimdVec3(body.GetPosition());
+      trans.m_Rotation = ezJoltConversionUtils::ToSimdQuat(body.GetRotation());
+
+      pActor->GetOwner()->SetGlobalTransform(trans);
+    }
+  };
+
+  ezParallelForParams params;
+  params.m_uiBinSize = 512;
+  params.m_uiMaxTasksPerThread = 1;
+
+  ezTaskSystem::ParallelFor(m_ActorsToUpdate.GetArrayPtr(), updateActors, "UpdateDynamicActors", params);
+
+  updateActors(m_ChildActorsToUpdate.GetArrayPtr());
 }
 
 void ezJoltDynamicActorComponentManager::UpdateKinematicActors(ezTime deltaTime)
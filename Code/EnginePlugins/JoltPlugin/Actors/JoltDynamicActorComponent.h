@@ -18,6 +18,8 @@ private:
   void UpdateDynamicActors();
 
   ezDynamicArray<ezJoltDynamicActorComponent*> m_KinematicActorComponents;
+  ezDynamicArray<ezJoltDynamicActorComponent*> m_ActorsToUpdate;      ///< Scratch array for UpdateDynamicActors().
+  ezDynamicArray<ezJoltDynamicActorComponent*> m_ChildActorsToUpdate; ///< Scratch array for UpdateDynamicActors().
 };
 
 //////////////////////////////////////////////////////////////////////////
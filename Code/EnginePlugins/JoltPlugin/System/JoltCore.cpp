@@ -4,7 +4,6 @@
 #include <Core/Physics/SurfaceResource.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Jolt/Core/IssueReporting.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/RegisterTypes.h>
 #include <JoltPlugin/Declarations.h>
@@ -12,6 +11,7 @@
 #include <JoltPlugin/Shapes/Implementation/JoltCustomShapeInfo.h>
 #include <JoltPlugin/System/JoltCore.h>
 #include <JoltPlugin/System/JoltDebugRenderer.h>
+#include <JoltPlugin/System/JoltJobSystem.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <stdarg.h>
 
@@ -35,7 +35,7 @@ EZ_END_STATIC_REFLECTED_BITFLAGS;
 // clang-format on
 
 ezJoltMaterial* ezJoltCore::s_pDefaultMaterial = nullptr;
-std::unique_ptr<JPH::JobSystem> ezJoltCore::s_pJobSystem;
+std::unique_ptr<ezJoltJobSystem> ezJoltCore::s_pJobSystem;
 ezUniquePtr<ezProxyAllocator> ezJoltCore::s_pAllocator;
 ezUniquePtr<ezProxyAllocator> ezJoltCore::s_pAllocatorAligned;
 
@@ -128,8 +128,7 @@ void ezJoltCore::Startup()
 
   ezJoltCustomShapeInfo::sRegister();
 
-  // TODO: custom job system
-  s_pJobSystem = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1);
+  s_pJobSystem = std::make_unique<ezJoltJobSystem>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
 
   s_pDefaultMaterial = new ezJoltMaterial;
   s_pDefaultMaterial->AddRef();
@@ -8,17 +8,13 @@
 class ezJoltMaterial;
 struct ezSurfaceResourceEvent;
 class ezJoltDebugRenderer;
+class ezJoltJobSystem;
 class ezWorld;
 
-namespace JPH
-{
-  class JobSystem;
-}
-
 class EZ_JOLTPLUGIN_DLL ezJoltCore
 {
 public:
-  static JPH::JobSystem* GetJoltJobSystem() { return s_pJobSystem.get(); }
+  static ezJoltJobSystem* GetJoltJobSystem() { return s_pJobSystem.get(); }
   static const ezJoltMaterial* GetDefaultMaterial() { return s_pDefaultMaterial; }
 
   static void DebugDraw(ezWorld* pWorld);
@@ -42,7 +38,7 @@ private:
   static void JoltAlignedFree(void* inBlock);
 
   static ezJoltMaterial* s_pDefaultMaterial;
-  static std::unique_ptr<JPH::JobSystem> s_pJobSystem;
+  static std::unique_ptr<ezJoltJobSystem> s_pJobSystem;
 
   static ezUniquePtr<ezProxyAllocator> s_pAllocator;
   static ezUniquePtr<ezProxyAllocator> s_pAllocatorAligned;
@@ -0,0 +1,230 @@
+#include <JoltPlugin/JoltPluginPCH.h>
+
+#include <JoltPlugin/System/JoltJobSystem.h>
+
+class ezJoltJobSystem::JobTask final : public ezTask
+{
+public:
+  void SetJob(Job* pJob, ezOnTaskFinishedCallback onFinished)
+  {
+    m_pJob = pJob;
+
+#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+    ConfigureTask(pJob->GetName(), ezTaskNesting::Never, onFinished);
+#else
+    ConfigureTask("Jolt Job", ezTaskNesting::Never, onFinished);
+#endif
+  }
+
+  virtual void Execute() override
+  {
+    m_pJob->Execute();
+
+    // release the reference that was added when the job was queued
+    m_pJob->Release();
+    m_pJob = nullptr;
+  }
+
+private:
+  Job* m_pJob = nullptr;
+};
+
+class ezJoltJobSystem::TaskBarrier final : public JPH::JobSystem::Barrier
+{
+public:
+  ~TaskBarrier()
+  {
+    EZ_ASSERT_DEV(m_iNumPendingJobs == 0, "Jolt job barrier is destroyed while jobs are still pending.");
+  }
+
+  virtual void AddJob(const JPH::JobHandle& hJob) override
+  {
+    m_iNumPendingJobs.Increment();
+
+    if (!hJob.GetPtr()->SetBarrier(this))
+    {
+      // the job already finished
+      m_iNumPendingJobs.Decrement();
+      return;
+    }
+
+    EZ_LOCK(m_Mutex);
+    m_Jobs.PushBack(hJob);
+  }
+
+  virtual void AddJobs(const JPH::JobHandle* pHandles, JPH::uint uiNumHandles) override
+  {
+    for (JPH::uint i = 0; i < uiNumHandles; ++i)
+    {
+      AddJob(pHandles[i]);
+    }
+  }
+
+  void Wait()
+  {
+    // executes other tasks while waiting, the jobs of this barrier are among them
+    ezTaskSystem::WaitForCondition([this]()
+      { return m_iNumPendingJobs == 0; });
+
+    EZ_LOCK(m_Mutex);
+    m_Jobs.Clear();
+  }
+
+protected:
+  virtual void OnJobFinished(Job* pJob) override
+  {
+    EZ_IGNORE_UNUSED(pJob);
+    m_iNumPendingJobs.Decrement();
+  }
+
+private:
+  ezAtomicInteger32 m_iNumPendingJobs;
+  ezMutex m_Mutex;
+  ezDynamicArray<JPH::JobHandle> m_Jobs; ///< Keeps the jobs alive until the barrier was waited for.
+};
+
+ezJoltJobSystem::ezJoltJobSystem(ezUInt32 uiMaxJobs, ezUInt32 uiMaxBarriers)
+{
+  m_Jobs.Init(uiMaxJobs, uiMaxJobs);
+  m_uiMaxBarriers = uiMaxBarriers;
+}
+
+ezJoltJobSystem::~ezJoltJobSystem()
+{
+  // a task is returned to the pool after its job was executed, which may be after the last barrier was already waited for
+  ezTaskSystem::WaitForCondition([this]()
+    {
+      EZ_LOCK(m_JobTaskMutex);
+      return m_FreeJobTasks.GetCount() == m_uiNumJobTasks;
+    });
+
+  EZ_ASSERT_DEV(m_FreeBarriers.GetCount() == m_Barriers.GetCount(), "Not all Jolt job barriers have been destroyed.");
+
+  for (TaskBarrier* pBarrier : m_Barriers)
+  {
+    delete pBarrier;
+  }
+}
+
+int ezJoltJobSystem::GetMaxConcurrency() const
+{
+  // the thread that waits for a barrier helps executing the jobs
+  return (int)ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) + 1;
+}
+
+JPH::JobHandle ezJoltJobSystem::CreateJob(const char* szName, JPH::ColorArg color, const JobFunction& jobFunction, JPH::uint32 uiNumDependencies)
+{
+  JPH::uint32 uiIndex;
+  while (true)
+  {
+    uiIndex = m_Jobs.ConstructObject(szName, color, this, jobFunction, uiNumDependencies);
+
+    if (uiIndex != JPH::FixedSizeFreeList<Job>::cInvalidObjectIndex)
+      break;
+
+    EZ_ASSERT_DEBUG(false, "No Jolt jobs available, increase the maximum number of jobs.");
+    ezThreadUtils::YieldTimeSlice();
+  }
+
+  Job* pJob = &m_Jobs.Get(uiIndex);
+
+  // the handle keeps a reference, the job is queued below and may finish immediately
+  JPH::JobHandle hJob(pJob);
+
+  if (uiNumDependencies == 0)
+  {
+    QueueJob(pJob);
+  }
+
+  return hJob;
+}
+
+JPH::JobSystem::Barrier* ezJoltJobSystem::CreateBarrier()
+{
+  EZ_LOCK(m_BarrierMutex);
+
+  if (m_FreeBarriers.IsEmpty())
+  {
+    EZ_ASSERT_DEV(m_Barriers.GetCount() < m_uiMaxBarriers, "Too many Jolt job barriers are in use at the same time.");
+
+    // Jolt types use Jolt's allocator
+    m_Barriers.PushBack(new TaskBarrier());
+    return m_Barriers.PeekBack();
+  }
+
+  TaskBarrier* pBarrier = m_FreeBarriers.PeekBack();
+  m_FreeBarriers.PopBack();
+  return pBarrier;
+}
+
+void ezJoltJobSystem::DestroyBarrier(Barrier* pBarrier)
+{
+  EZ_LOCK(m_BarrierMutex);
+  m_FreeBarriers.PushBack(static_cast<TaskBarrier*>(pBarrier));
+}
+
+void ezJoltJobSystem::WaitForJobs(Barrier* pBarrier)
+{
+  static_cast<TaskBarrier*>(pBarrier)->Wait();
+}
+
+ezSharedPtr<ezTask> ezJoltJobSystem::CreateJobTask(Job* pJob)
+{
+  // the task holds a reference until the job was executed
+  pJob->AddRef();
+
+  ezSharedPtr<ezTask> pTask;
+
+  {
+    EZ_LOCK(m_JobTaskMutex);
+
+    if (m_FreeJobTasks.IsEmpty())
+    {
+      pTask = EZ_DEFAULT_NEW(JobTask);
+      ++m_uiNumJobTasks;
+    }
+    else
+    {
+      pTask = std::move(m_FreeJobTasks.PeekBack());
+      m_FreeJobTasks.PopBack();
+    }
+  }
+
+  static_cast<JobTask*>(pTask.Borrow())->SetJob(pJob, ezMakeDelegate(&ezJoltJobSystem::JobTaskFinished, this));
+  return pTask;
+}
+
+void ezJoltJobSystem::JobTaskFinished(const ezSharedPtr<ezTask>& pTask)
+{
+  EZ_LOCK(m_JobTaskMutex);
+  m_FreeJobTasks.PushBack(pTask);
+}
+
+void ezJoltJobSystem::QueueJob(Job* pJob)
+{
+  ezTaskSystem::StartSingleTask(CreateJobTask(pJob), m_TaskPriority);
+}
+
+void ezJoltJobSystem::QueueJobs(Job** pJobs, JPH::uint uiNumJobs)
+{
+  if (uiNumJobs == 1)
+  {
+    QueueJob(pJobs[0]);
+    return;
+  }
+
+  // a single group is cheaper to schedule than one group per task
+  const ezTaskGroupID groupId = ezTaskSystem::CreateTaskGroup(m_TaskPriority);
+
+  for (JPH::uint i = 0; i < uiNumJobs; ++i)
+  {
+    ezTaskSystem::AddTaskToGroup(groupId, CreateJobTask(pJobs[i]));
+  }
+
+  ezTaskSystem::StartTaskGroup(groupId);
+}
+
+void ezJoltJobSystem::FreeJob(Job* pJob)
+{
+  m_Jobs.DestructObject(pJob);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystem.h>
+#include <JoltPlugin/JoltPluginDLL.h>
+
+/// \brief Executes Jolt's jobs as ezTask's on the worker threads of the ezTaskSystem.
+///
+/// Jolt's own JPH::JobSystemThreadPool creates its own threads, which compete with the ezTaskSystem's workers for the CPU.
+/// This implementation instead turns every Jolt job into a task, so that physics and all other engine work share the same threads.
+///
+/// Threads that wait for a barrier use ezTaskSystem::WaitForCondition(), so they help executing tasks while waiting.
+/// Thus the task that calls JPH::PhysicsSystem::Update() must allow nested tasks (ie. not use ezTaskNesting::Never).
+///
+/// The tasks are pooled and reused for later jobs, so that queuing a job doesn't allocate.
+class EZ_JOLTPLUGIN_DLL ezJoltJobSystem final : public JPH::JobSystem
+{
+public:
+  ezJoltJobSystem(ezUInt32 uiMaxJobs, ezUInt32 uiMaxBarriers);
+  ~ezJoltJobSystem();
+
+  /// \brief Sets the priority with which the tasks for all Jolt jobs are scheduled. The default is ezTaskPriority::EarlyThisFrame.
+  ///
+  /// Should match the priority of the task that runs the physics update, so that physics jobs don't get delayed by less important work.
+  void SetTaskPriority(ezTaskPriority::Enum priority) { m_TaskPriority = priority; }
+  ezTaskPriority::Enum GetTaskPriority() const { return m_TaskPriority; }
+
+  virtual int GetMaxConcurrency() const override;
+  virtual JPH::JobHandle CreateJob(const char* szName, JPH::ColorArg color, const JobFunction& jobFunction, JPH::uint32 uiNumDependencies = 0) override;
+  virtual Barrier* CreateBarrier() override;
+  virtual void DestroyBarrier(Barrier* pBarrier) override;
+  virtual void WaitForJobs(Barrier* pBarrier) override;
+
+protected:
+  virtual void QueueJob(Job* pJob) override;
+  virtual void QueueJobs(Job** pJobs, JPH::uint uiNumJobs) override;
+  virtual void FreeJob(Job* pJob) override;
+
+private:
+  class JobTask;
+  class TaskBarrier;
+
+  ezSharedPtr<ezTask> CreateJobTask(Job* pJob);
+  void JobTaskFinished(const ezSharedPtr<ezTask>& pTask);
+
+  JPH::FixedSizeFreeList<Job> m_Jobs;
+  ezTaskPriority::Enum m_TaskPriority = ezTaskPriority::EarlyThisFrame;
+
+  ezMutex m_JobTaskMutex;
+  ezDynamicArray<ezSharedPtr<ezTask>> m_FreeJobTasks;
+  ezUInt32 m_uiNumJobTasks = 0;
+
+  ezMutex m_BarrierMutex;
+  ezDynamicArray<TaskBarrier*> m_Barriers;
+  ezDynamicArray<TaskBarrier*> m_FreeBarriers;
+  ezUInt32 m_uiMaxBarriers = 0;
+};
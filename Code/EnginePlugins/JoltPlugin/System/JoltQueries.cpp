@@ -1,10 +1,12 @@
 #include <JoltPlugin/JoltPluginPCH.h>
 
+#include <Foundation/Threading/TaskSystem.h>
 #include <JoltPlugin/Actors/JoltActorComponent.h>
 #include <JoltPlugin/Resources/JoltMaterial.h>
 #include <JoltPlugin/Shapes/JoltShapeComponent.h>
 #include <JoltPlugin/System/JoltWorldModule.h>
 #include <JoltPlugin/Utilities/JoltUserData.h>
+#include <Geometry/RayAABox.h>
 #include <Physics/Collision/CollisionCollectorImpl.h>
 
 void FillCastResult(ezPhysicsCastResult& ref_result, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const JPH::BodyID& bodyId, const JPH::SubShapeID& subShapeId, const JPH::BodyLockInterface& lockInterface, const JPH::BodyInterface& bodyInterface, const ezJoltWorldModule* pModule)
@@ -157,6 +159,238 @@ bool ezJoltWorldModule::RaycastAll(ezPhysicsCastResultArray& out_results, const
   return true;
 }
 
+// A single query is too cheap to be worth a task, so batches are only split into tasks of at least this many queries.
+static constexpr ezUInt32 s_uiShapeQueryBatchBinSize = 32;
+
+// Raycasts are sorted spatially and every bin of nearby rays shares one broadphase query.
+static constexpr ezUInt32 s_uiRaycastBinSize = 64;
+static constexpr ezUInt32 s_uiRaycastBinsPerTask = 2;
+
+// With more candidate bodies than this, testing every ray of a bin against every candidate is slower than
+// a broadphase query per ray, e.g. for long rays or bins that are spread out.
+static constexpr ezUInt32 s_uiMaxRaycastBinCandidates = 64;
+
+static ezParallelForParams GetBatchQueryParams(ezUInt32 uiBinSize)
+{
+  ezParallelForParams params;
+  params.m_uiBinSize = uiBinSize;
+  // query costs vary a lot depending on what is hit, smaller slices balance better
+  params.m_uiMaxTasksPerThread = 4;
+  return params;
+}
+
+/// \brief Inserts two zero bits in front of each of the lower 10 bits of the given value.
+static ezUInt32 SpreadBitsBy3(ezUInt32 x)
+{
+  x &= 0x3FF;
+  x = (x | (x << 16)) & 0x030000FF;
+  x = (x | (x << 8)) & 0x0300F00F;
+  x = (x | (x << 4)) & 0x030C30C3;
+  x = (x | (x << 2)) & 0x09249249;
+  return x;
+}
+
+class ezJoltRaycastBinCollector : public JPH::CollideShapeBodyCollector
+{
+public:
+  ezHybridArray<JPH::BodyID, s_uiMaxRaycastBinCandidates + 1> m_Bodies;
+
+  virtual void AddHit(const JPH::BodyID& bodyId) override
+  {
+    m_Bodies.PushBack(bodyId);
+
+    // the bin is handled with per-ray queries anyway, no need to collect the remaining bodies
+    if (m_Bodies.GetCount() > s_uiMaxRaycastBinCandidates)
+    {
+      ForceEarlyOut();
+    }
+  }
+};
+
+ezUInt32 ezJoltWorldModule::RaycastBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsRay> rays, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection /*= ezPhysicsHitCollection::Closest*/) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() == rays.GetCount() && out_hits.GetCount() == rays.GetCount(), "Number of results ({}) and hits ({}) must match the number of rays ({})", out_results.GetCount(), out_hits.GetCount(), rays.GetCount());
+
+  // Instead of doing a broadphase query per ray, the rays are sorted along a Morton curve through the bounds of all rays and split into bins.
+  // Every bin gathers the bodies that overlap its bounds once and then only tests its rays against those bodies.
+  struct SortedRay
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiKey;
+    ezUInt32 m_uiIndex;
+
+    EZ_ALWAYS_INLINE bool operator<(const SortedRay& other) const { return m_uiKey < other.m_uiKey; }
+  };
+
+  ezDynamicArray<SortedRay> sortedRays(ezFrameAllocator::GetCurrentAllocator());
+  sortedRays.Reserve(rays.GetCount());
+
+  ezBoundingBox batchBounds = ezBoundingBox::MakeInvalid();
+  for (ezUInt32 i = 0; i < rays.GetCount(); ++i)
+  {
+    out_hits[i] = false;
+
+    const ezPhysicsRay& ray = rays[i];
+    if (ray.m_fDistance <= 0.001f || ray.m_vDir.IsZero())
+      continue;
+
+    batchBounds.ExpandToInclude(ray.m_vStart + ray.m_vDir * (ray.m_fDistance * 0.5f));
+    sortedRays.PushBack({0, i});
+  }
+
+  if (sortedRays.IsEmpty())
+    return 0;
+
+  {
+    const ezVec3 vMin = batchBounds.m_vMin;
+    const ezVec3 vExtents = batchBounds.GetExtents();
+    const ezVec3 vScale(vExtents.x > 0.0f ? 1023.0f / vExtents.x : 0.0f, vExtents.y > 0.0f ? 1023.0f / vExtents.y : 0.0f, vExtents.z > 0.0f ? 1023.0f / vExtents.z : 0.0f);
+
+    for (SortedRay& sortedRay : sortedRays)
+    {
+      const ezPhysicsRay& ray = rays[sortedRay.m_uiIndex];
+      const ezVec3 vCell = (ray.m_vStart + ray.m_vDir * (ray.m_fDistance * 0.5f) - vMin).CompMul(vScale);
+
+      sortedRay.m_uiKey = SpreadBitsBy3(static_cast<ezUInt32>(vCell.x)) | (SpreadBitsBy3(static_cast<ezUInt32>(vCell.y)) << 1) | (SpreadBitsBy3(static_cast<ezUInt32>(vCell.z)) << 2);
+    }
+
+    sortedRays.Sort();
+  }
+
+  ezJoltBroadPhaseLayerFilter broadphaseFilter(params.m_ShapeTypes);
+  ezJoltBodyFilter bodyFilter(params.m_uiIgnoreObjectFilterID);
+  ezJoltObjectLayerFilter objectFilter(params.m_uiCollisionLayer);
+
+  JPH::RayCastSettings opt;
+  opt.mBackFaceMode = JPH::EBackFaceMode::IgnoreBackFaces;
+  opt.mTreatConvexAsSolid = false;
+
+  const bool bAnyHit = collection == ezPhysicsHitCollection::Any;
+  const JPH::BodyLockInterface& lockInterface = m_pSystem->GetBodyLockInterface();
+  const JPH::BodyLockInterface& lockInterfaceNoLock = m_pSystem->GetBodyLockInterfaceNoLock();
+  const JPH::BodyInterface& bodyInterfaceNoLock = m_pSystem->GetBodyInterfaceNoLock();
+
+  struct CandidateShape
+  {
+    JPH::TransformedShape m_Shape;
+    JPH::AABox m_Bounds;
+  };
+
+  const ezUInt32 uiNumRays = sortedRays.GetCount();
+  const ezUInt32 uiNumBins = (uiNumRays + s_uiRaycastBinSize - 1) / s_uiRaycastBinSize;
+
+  ezAtomicInteger32 iNumHits = 0;
+
+  auto castBins = [&](ezUInt32 uiStartBin, ezUInt32 uiEndBin)
+  {
+    ezInt32 iNumSliceHits = 0;
+    ezHybridArray<CandidateShape, s_uiMaxRaycastBinCandidates> candidates;
+
+    for (ezUInt32 uiBin = uiStartBin; uiBin < uiEndBin; ++uiBin)
+    {
+      const ezUInt32 uiFirstRay = uiBin * s_uiRaycastBinSize;
+      const ezArrayPtr<const SortedRay> binRays = sortedRays.GetArrayPtr().GetSubArray(uiFirstRay, ezMath::Min(s_uiRaycastBinSize, uiNumRays - uiFirstRay));
+
+      JPH::AABox binBounds;
+      for (const SortedRay& sortedRay : binRays)
+      {
+        const ezPhysicsRay& ray = rays[sortedRay.m_uiIndex];
+        binBounds.Encapsulate(ezJoltConversionUtils::ToVec3(ray.m_vStart));
+        binBounds.Encapsulate(ezJoltConversionUtils::ToVec3(ray.m_vStart + ray.m_vDir * ray.m_fDistance));
+      }
+
+      ezJoltRaycastBinCollector bodyCollector;
+      m_pSystem->GetBroadPhaseQuery().CollideAABox(binBounds, bodyCollector, broadphaseFilter, objectFilter);
+
+      if (bodyCollector.m_Bodies.IsEmpty())
+        continue;
+
+      if (bodyCollector.m_Bodies.GetCount() > s_uiMaxRaycastBinCandidates)
+      {
+        for (const SortedRay& sortedRay : binRays)
+        {
+          const ezPhysicsRay& ray = rays[sortedRay.m_uiIndex];
+          if (Raycast(out_results[sortedRay.m_uiIndex], ray.m_vStart, ray.m_vDir, ray.m_fDistance, params, collection))
+          {
+            out_hits[sortedRay.m_uiIndex] = true;
+            ++iNumSliceHits;
+          }
+        }
+
+        continue;
+      }
+
+      candidates.Clear();
+
+      for (const JPH::BodyID& bodyId : bodyCollector.m_Bodies)
+      {
+        if (!bodyFilter.ShouldCollide(bodyId))
+          continue;
+
+        JPH::BodyLockRead bodyLock(lockInterface, bodyId);
+        if (!bodyLock.SucceededAndIsInBroadPhase() || !bodyFilter.ShouldCollideLocked(bodyLock.GetBody()))
+          continue;
+
+        auto& candidate = candidates.ExpandAndGetRef();
+        candidate.m_Shape = bodyLock.GetBody().GetTransformedShape();
+        candidate.m_Bounds = candidate.m_Shape.GetWorldSpaceBounds();
+      }
+
+      for (const SortedRay& sortedRay : binRays)
+      {
+        const ezPhysicsRay& ray = rays[sortedRay.m_uiIndex];
+
+        JPH::RRayCast joltRay;
+        joltRay.mOrigin = ezJoltConversionUtils::ToVec3(ray.m_vStart);
+        joltRay.mDirection = ezJoltConversionUtils::ToVec3(ray.m_vDir * ray.m_fDistance);
+
+        const JPH::RayInvDirection invDirection(joltRay.mDirection);
+
+        ezRayCastCollector collector;
+        collector.m_bAnyHit = bAnyHit;
+
+        for (const CandidateShape& candidate : candidates)
+        {
+          // the bounds test also rejects bodies that can't produce a closer hit than the one we already have
+          if (JPH::RayAABox(joltRay.mOrigin, invDirection, candidate.m_Bounds.mMin, candidate.m_Bounds.mMax) >= collector.m_Result.mFraction)
+            continue;
+
+          if (params.m_bIgnoreInitialOverlap)
+          {
+            candidate.m_Shape.CastRay(joltRay, opt, collector);
+          }
+          else if (candidate.m_Shape.CastRay(joltRay, collector.m_Result))
+          {
+            collector.m_bFoundAny = true;
+          }
+
+          if (collector.m_bFoundAny && bAnyHit)
+            break;
+        }
+
+        if (!collector.m_bFoundAny)
+          continue;
+
+        ezPhysicsCastResult& result = out_results[sortedRay.m_uiIndex];
+        result.m_fDistance = collector.m_Result.mFraction * ray.m_fDistance;
+        result.m_vPosition = ray.m_vStart + ray.m_fDistance * collector.m_Result.mFraction * ray.m_vDir;
+
+        FillCastResult(result, ray.m_vStart, ray.m_vDir, ray.m_fDistance, collector.m_Result.mBodyID, collector.m_Result.mSubShapeID2, lockInterfaceNoLock, bodyInterfaceNoLock, this);
+
+        out_hits[sortedRay.m_uiIndex] = true;
+        ++iNumSliceHits;
+      }
+    }
+
+    iNumHits.Add(iNumSliceHits);
+  };
+
+  ezTaskSystem::ParallelForIndexed(0u, uiNumBins, castBins, "Jolt RaycastBatch", ezTaskNesting::Never, GetBatchQueryParams(s_uiRaycastBinsPerTask));
+
+  return static_cast<ezUInt32>(iNumHits);
+}
+
 class ezJoltShapeCastCollector : public JPH::CastShapeCollector
 {
 public:
@@ -367,6 +601,112 @@ void ezJoltWorldModule::QueryShapesInSphere(ezPhysicsOverlapResultArray& out_res
   }
 }
 
+ezUInt32 ezJoltWorldModule::SweepTestBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsSweep> sweeps, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection /*= ezPhysicsHitCollection::Closest*/) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() == sweeps.GetCount() && out_hits.GetCount() == sweeps.GetCount(), "Number of results ({}) and hits ({}) must match the number of sweeps ({})", out_results.GetCount(), out_hits.GetCount(), sweeps.GetCount());
+
+  ezAtomicInteger32 iNumHits = 0;
+
+  auto sweepShapes = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+  {
+    ezInt32 iNumSliceHits = 0;
+
+    for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+    {
+      const ezPhysicsSweep& sweep = sweeps[i];
+      const ezPhysicsQueryShape& shape = sweep.m_Shape;
+
+      switch (shape.m_Type)
+      {
+        case ezPhysicsQueryShape::Type::Sphere:
+          out_hits[i] = SweepTestSphere(out_results[i], shape.m_fRadius, sweep.m_Transform.m_vPosition, sweep.m_vDir, sweep.m_fDistance, params, collection);
+          break;
+
+        case ezPhysicsQueryShape::Type::Box:
+          out_hits[i] = SweepTestBox(out_results[i], shape.m_vBoxExtents, sweep.m_Transform, sweep.m_vDir, sweep.m_fDistance, params, collection);
+          break;
+
+        case ezPhysicsQueryShape::Type::Capsule:
+          out_hits[i] = SweepTestCapsule(out_results[i], shape.m_fRadius, shape.m_fCapsuleHeight, sweep.m_Transform, sweep.m_vDir, sweep.m_fDistance, params, collection);
+          break;
+
+          EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
+      }
+
+      iNumSliceHits += out_hits[i] ? 1 : 0;
+    }
+
+    iNumHits.Add(iNumSliceHits);
+  };
+
+  ezTaskSystem::ParallelForIndexed(0u, sweeps.GetCount(), sweepShapes, "Jolt SweepTestBatch", ezTaskNesting::Never, GetBatchQueryParams(s_uiShapeQueryBatchBinSize));
+
+  return static_cast<ezUInt32>(iNumHits);
+}
+
+ezUInt32 ezJoltWorldModule::OverlapTestBatch(ezArrayPtr<bool> out_overlaps, ezArrayPtr<const ezPhysicsOverlap> overlaps, const ezPhysicsQueryParameters& params) const
+{
+  EZ_ASSERT_DEV(out_overlaps.GetCount() == overlaps.GetCount(), "Number of results ({}) must match the number of overlap tests ({})", out_overlaps.GetCount(), overlaps.GetCount());
+
+  ezAtomicInteger32 iNumOverlaps = 0;
+
+  auto overlapShapes = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+  {
+    ezInt32 iNumSliceOverlaps = 0;
+
+    for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+    {
+      const ezPhysicsOverlap& overlap = overlaps[i];
+      const ezPhysicsQueryShape& shape = overlap.m_Shape;
+
+      switch (shape.m_Type)
+      {
+        case ezPhysicsQueryShape::Type::Sphere:
+          out_overlaps[i] = OverlapTestSphere(shape.m_fRadius, overlap.m_Transform.m_vPosition, params);
+          break;
+
+        case ezPhysicsQueryShape::Type::Box:
+        {
+          const JPH::BoxShape box(ezJoltConversionUtils::ToVec3(shape.m_vBoxExtents * 0.5f));
+          const JPH::Mat44 trans = JPH::Mat44::sRotationTranslation(ezJoltConversionUtils::ToQuat(overlap.m_Transform.m_qRotation), ezJoltConversionUtils::ToVec3(overlap.m_Transform.m_vPosition));
+
+          out_overlaps[i] = OverlapTest(box, trans, params);
+          break;
+        }
+
+        case ezPhysicsQueryShape::Type::Capsule:
+          out_overlaps[i] = OverlapTestCapsule(shape.m_fRadius, shape.m_fCapsuleHeight, overlap.m_Transform, params);
+          break;
+
+          EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
+      }
+
+      iNumSliceOverlaps += out_overlaps[i] ? 1 : 0;
+    }
+
+    iNumOverlaps.Add(iNumSliceOverlaps);
+  };
+
+  ezTaskSystem::ParallelForIndexed(0u, overlaps.GetCount(), overlapShapes, "Jolt OverlapTestBatch", ezTaskNesting::Never, GetBatchQueryParams(s_uiShapeQueryBatchBinSize));
+
+  return static_cast<ezUInt32>(iNumOverlaps);
+}
+
+void ezJoltWorldModule::QueryShapesInSphereBatch(ezArrayPtr<ezPhysicsOverlapResultArray> out_results, ezArrayPtr<const ezBoundingSphere> spheres, const ezPhysicsQueryParameters& params) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() == spheres.GetCount(), "Number of results ({}) must match the number of spheres ({})", out_results.GetCount(), spheres.GetCount());
+
+  auto queryShapes = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+  {
+    for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+    {
+      QueryShapesInSphere(out_results[i], spheres[i].m_fRadius, spheres[i].m_vCenter, params);
+    }
+  };
+
+  ezTaskSystem::ParallelForIndexed(0u, spheres.GetCount(), queryShapes, "Jolt QueryShapesInSphereBatch", ezTaskNesting::Never, GetBatchQueryParams(s_uiShapeQueryBatchBinSize));
+}
+
 void ezJoltWorldModule::QueryGeometryInBox(const ezPhysicsQueryParameters& params, ezBoundingBox box, ezDynamicArray<ezNavmeshTriangle>& out_triangles) const
 {
   JPH::AABox aabb;
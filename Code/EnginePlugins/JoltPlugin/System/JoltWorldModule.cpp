@@ -14,6 +14,7 @@
 #include <JoltPlugin/System/JoltContacts.h>
 #include <JoltPlugin/System/JoltCore.h>
 #include <JoltPlugin/System/JoltDebugRenderer.h>
+#include <JoltPlugin/System/JoltJobSystem.h>
 #include <JoltPlugin/System/JoltWorldModule.h>
 #include <Physics/Collision/CollisionCollectorImpl.h>
 #include <Physics/Collision/Shape/Shape.h>
@@ -624,7 +625,11 @@ void ezJoltWorldModule::StartSimulation(const ezWorldModule::UpdateContext& cont
 
   UpdateConstraints();
 
-  m_SimulateTaskGroupId = ezTaskSystem::StartSingleTask(m_pSimulateTask, ezTaskPriority::EarlyThisFrame);
+  // the Jolt jobs are scheduled with the priority of the simulate task that waits for them, so that less important work can't delay them
+  const ezTaskPriority::Enum simulatePriority = ezTaskPriority::EarlyThisFrame;
+  ezJoltCore::GetJoltJobSystem()->SetTaskPriority(simulatePriority);
+
+  m_SimulateTaskGroupId = ezTaskSystem::StartSingleTask(m_pSimulateTask, simulatePriority);
 }
 
 void ezJoltWorldModule::FetchResults(const ezWorldModule::UpdateContext& context)
@@ -62,6 +62,8 @@ public:
 
   virtual bool RaycastAll(ezPhysicsCastResultArray& out_results, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params) const override;
 
+  virtual ezUInt32 RaycastBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsRay> rays, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const override;
+
   virtual bool SweepTestSphere(ezPhysicsCastResult& out_result, float fSphereRadius, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const override;
 
   virtual bool SweepTestBox(ezPhysicsCastResult& out_result, ezVec3 vBoxExtends, const ezTransform& transform, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const override;
@@ -74,6 +76,12 @@ public:
 
   virtual void QueryShapesInSphere(ezPhysicsOverlapResultArray& out_results, float fSphereRadius, const ezVec3& vPosition, const ezPhysicsQueryParameters& params) const override;
 
+  virtual ezUInt32 SweepTestBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsSweep> sweeps, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const override;
+
+  virtual ezUInt32 OverlapTestBatch(ezArrayPtr<bool> out_overlaps, ezArrayPtr<const ezPhysicsOverlap> overlaps, const ezPhysicsQueryParameters& params) const override;
+
+  virtual void QueryShapesInSphereBatch(ezArrayPtr<ezPhysicsOverlapResultArray> out_results, ezArrayPtr<const ezBoundingSphere> spheres, const ezPhysicsQueryParameters& params) const override;
+
   virtual void AddStaticCollisionBox(ezGameObject* pObject, ezVec3 vBoxSize) override;
 
   virtual void AddFixedJointComponent(ezGameObject* pOwner, const ezPhysicsWorldModuleInterface::FixedJointConfig& cfg) override;
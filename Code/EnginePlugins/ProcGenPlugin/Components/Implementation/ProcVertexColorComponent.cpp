@@ -190,7 +190,7 @@ void ezProcVertexColorComponentManager::UpdateComponentVertexColors(ezProcVertex
 
   ezStringBuilder taskName = "VertexColor ";
   taskName.Append(pCpuMesh->GetResourceDescription().GetView());
-  pUpdateTask->ConfigureTask(taskName, ezTaskNesting::Never);
+  pUpdateTask->ConfigureTask(taskName, ezTaskNesting::Maybe);
 
   pUpdateTask->Prepare(*GetWorld(), mbDesc, pComponent->GetOwner()->GetGlobalTransform(), pComponent->m_Outputs, outputMappings, m_VertexColorData.GetArrayPtr().GetSubArray(uiBufferOffset, uiVertexColorCount));
 
@@ -32,6 +32,9 @@ void PlacementTask::Clear()
   m_OutputTransforms.Clear();
   m_Density.Clear();
   m_ValidPoints.Clear();
+  m_Rays.Clear();
+  m_HitResults.Clear();
+  m_Hits.Clear();
 }
 
 void PlacementTask::Execute()
@@ -65,23 +68,49 @@ void PlacementTask::FindPlacementPoints()
   ezUInt32 uiCollisionLayer = pOutput->m_uiCollisionLayer;
 
   auto& patternPoints = pOutput->m_pPattern->m_Points;
+  const ezUInt32 uiNumPatternPoints = patternPoints.GetCount();
 
-  for (ezUInt32 i = 0; i < patternPoints.GetCount(); ++i)
+  const bool bRaycast = m_pData->m_pPhysicsModule != nullptr && m_pData->m_pOutput->m_Mode == ezProcPlacementMode::Raycast;
+  if (bRaycast)
+  {
+    // Cast the rays for the whole tile at once
+    m_Rays.SetCountUninitialized(uiNumPatternPoints);
+    for (ezUInt32 i = 0; i < uiNumPatternPoints; ++i)
+    {
+      auto& patternPoint = patternPoints[i];
+      ezSimdVec4f patternCoords = ezSimdVec4f(patternPoint.x, patternPoint.y, 0.0f);
+
+      ezSimdVec4f rayStart = (vXY + patternCoords * pOutput->m_fFootprint);
+      rayStart += ezSimdRandom::FloatMinMax(ezSimdVec4i(i), vMinOffset, vMaxOffset, seed);
+      rayStart.SetZ(fZStart);
+
+      auto& ray = m_Rays[i];
+      ray.m_vStart = ezSimdConversion::ToVec3(rayStart);
+      ray.m_vDir = rayDir;
+      ray.m_fDistance = fZRange;
+    }
+
+    m_HitResults.SetCount(uiNumPatternPoints);
+    m_Hits.SetCount(uiNumPatternPoints);
+
+    if (m_pData->m_pPhysicsModule->RaycastBatch(m_HitResults, m_Hits, m_Rays, ezPhysicsQueryParameters(uiCollisionLayer, ezPhysicsShapeType::Static)) == 0)
+      return;
+  }
+
+  for (ezUInt32 i = 0; i < uiNumPatternPoints; ++i)
   {
     auto& patternPoint = patternPoints[i];
     ezSimdVec4f patternCoords = ezSimdVec4f(patternPoint.x, patternPoint.y, 0.0f);
 
     ezPhysicsCastResult hitResult;
 
-    if (m_pData->m_pPhysicsModule != nullptr && m_pData->m_pOutput->m_Mode == ezProcPlacementMode::Raycast)
+    if (bRaycast)
     {
-      ezSimdVec4f rayStart = (vXY + patternCoords * pOutput->m_fFootprint);
-      rayStart += ezSimdRandom::FloatMinMax(ezSimdVec4i(i), vMinOffset, vMaxOffset, seed);
-      rayStart.SetZ(fZStart);
-
-      if (!m_pData->m_pPhysicsModule->Raycast(hitResult, ezSimdConversion::ToVec3(rayStart), rayDir, fZRange, ezPhysicsQueryParameters(uiCollisionLayer, ezPhysicsShapeType::Static)))
+      if (!m_Hits[i])
         continue;
 
+      hitResult = m_HitResults[i];
+
       if (pOutput->m_hSurface.IsValid())
       {
         if (!hitResult.m_hSurface.IsValid())
@@ -165,7 +194,7 @@ void PlacementTask::ExecuteVM()
     }
 
     // Execute expression bytecode
-    if (m_VM.Execute(*(pOutput->m_pByteCode), inputs, outputs, uiNumInstances, m_pData->m_GlobalData, ezExpressionVM::Flags::BestPerformance).Failed())
+    if (m_VM.ExecuteParallel(*(pOutput->m_pByteCode), inputs, outputs, uiNumInstances, m_pData->m_GlobalData, ezExpressionVM::Flags::BestPerformance).Failed())
     {
       return;
     }
@@ -188,7 +188,7 @@ void VertexColorTask::Execute()
     }
 
     // Execute expression bytecode
-    if (m_VM.Execute(*(pOutput->m_pByteCode), inputs, outputs, uiNumVertices, m_GlobalData, ezExpressionVM::Flags::BestPerformance).Failed())
+    if (m_VM.ExecuteParallel(*(pOutput->m_pByteCode), inputs, outputs, uiNumVertices, m_GlobalData, ezExpressionVM::Flags::BestPerformance).Failed())
     {
       continue;
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Core/Interfaces/PhysicsQuery.h>
 #include <Foundation/CodeUtils/Expression/ExpressionVM.h>
 #include <Foundation/Threading/TaskSystem.h>
 #include <ProcGenPlugin/Declarations.h>
@@ -38,6 +39,10 @@ namespace ezProcGenInternal
 
     PlacementData* m_pData = nullptr;
 
+    ezDynamicArray<ezPhysicsRay> m_Rays;
+    ezDynamicArray<ezPhysicsCastResult> m_HitResults;
+    ezDynamicArray<bool> m_Hits;
+
     ezDynamicArray<PlacementPoint, ezAlignedAllocatorWrapper> m_InputPoints;
     ezDynamicArray<PlacementTransform, ezAlignedAllocatorWrapper> m_OutputTransforms;
     ezDynamicArray<float> m_Density;
@@ -244,6 +244,8 @@ ezResult ezVisualScriptGraphDescription::Deserialize(ezStreamReader& inout_strea
 
   m_Nodes = nodes;
 
+  EZ_SUCCEED_OR_RETURN(FlattenNodes());
+
   ezSharedPtr<ezVisualScriptDataDescription> pLocalDataDesc = EZ_SCRIPT_NEW(ezVisualScriptDataDescription);
   EZ_SUCCEED_OR_RETURN(pLocalDataDesc->Deserialize(inout_stream));
   m_pLocalDataDesc = pLocalDataDesc;
@@ -251,6 +253,171 @@ ezResult ezVisualScriptGraphDescription::Deserialize(ezStreamReader& inout_strea
   return EZ_SUCCESS;
 }
 
+// static
+ezVisualScriptGraphDescription::Opcode::Enum ezVisualScriptGraphDescription::Opcode::FromNode(const Node& node)
+{
+  using NodeType = ezVisualScriptNodeDescription::Type;
+
+  auto HasOperands = [&](ezVisualScriptDataType::Enum dataType, ezUInt32 uiNumInputs, ezUInt32 uiNumOutputs)
+  {
+    if (node.m_NumInputDataOffsets != uiNumInputs || node.m_NumOutputDataOffsets != uiNumOutputs)
+      return false;
+
+    for (ezUInt32 i = 0; i < uiNumInputs; ++i)
+    {
+      auto dataOffset = node.GetInputDataOffset(i);
+      if (dataOffset.IsValid() == false || dataOffset.GetType() != dataType)
+        return false;
+    }
+
+    // Unconnected outputs have an invalid offset, the data accessors skip them
+    for (ezUInt32 i = 0; i < uiNumOutputs; ++i)
+    {
+      auto dataOffset = node.GetOutputDataOffset(i);
+      if (dataOffset.IsValid() && dataOffset.GetType() != (node.m_Type == NodeType::Builtin_Compare ? ezVisualScriptDataType::Bool : dataType))
+        return false;
+    }
+
+    return true;
+  };
+
+  auto FromDataType = [&](ezUInt32 uiNumInputs, Enum intOpcode, Enum floatOpcode)
+  {
+    if (node.m_DeductedDataType == ezVisualScriptDataType::Int && intOpcode != Call && HasOperands(ezVisualScriptDataType::Int, uiNumInputs, 1))
+      return intOpcode;
+
+    if (node.m_DeductedDataType == ezVisualScriptDataType::Float && floatOpcode != Call && HasOperands(ezVisualScriptDataType::Float, uiNumInputs, 1))
+      return floatOpcode;
+
+    return Call;
+  };
+
+  switch (node.m_Type)
+  {
+    case NodeType::Builtin_Branch:
+      return HasOperands(ezVisualScriptDataType::Bool, 1, 0) ? Branch : Call;
+    case NodeType::Builtin_And:
+      return HasOperands(ezVisualScriptDataType::Bool, 2, 1) ? And : Call;
+    case NodeType::Builtin_Or:
+      return HasOperands(ezVisualScriptDataType::Bool, 2, 1) ? Or : Call;
+    case NodeType::Builtin_Not:
+      return HasOperands(ezVisualScriptDataType::Bool, 1, 1) ? Not : Call;
+
+    case NodeType::Builtin_SetVariable:
+      if (node.m_DeductedDataType == ezVisualScriptDataType::Bool && HasOperands(ezVisualScriptDataType::Bool, 1, 1))
+        return Copy_Bool;
+      return FromDataType(1, Copy_Int, Copy_Float);
+    case NodeType::Builtin_IncVariable:
+      return FromDataType(1, Inc_Int, Inc_Float);
+    case NodeType::Builtin_DecVariable:
+      return FromDataType(1, Dec_Int, Dec_Float);
+
+    case NodeType::Builtin_Add:
+      return FromDataType(2, Add_Int, Add_Float);
+    case NodeType::Builtin_Subtract:
+      return FromDataType(2, Sub_Int, Sub_Float);
+    case NodeType::Builtin_Multiply:
+      return FromDataType(2, Mul_Int, Mul_Float);
+    case NodeType::Builtin_Divide:
+      // Integer division by zero is left to the node function
+      return FromDataType(2, Call, Div_Float);
+    case NodeType::Builtin_Compare:
+      return FromDataType(2, Compare_Int, Compare_Float);
+
+    default:
+      return Call;
+  }
+}
+
+ezResult ezVisualScriptGraphDescription::FlattenNodes()
+{
+  m_Instructions.Clear();
+  m_Successors.Clear();
+
+  if (m_Nodes.IsEmpty())
+    return EZ_SUCCESS;
+
+  const ezUInt32 uiNumNodes = m_Nodes.GetCount();
+
+  ezDynamicArray<ezUInt32> nodeToInstruction;
+  nodeToInstruction.SetCount(uiNumNodes, ezInvalidIndex);
+
+  // Emit the nodes depth first along execution slot 0 so that chains of nodes end up next to each other.
+  // Other slots are visited once the current chain ends. Nodes that can't be reached from the entry node are dropped.
+  ezHybridArray<ezUInt32, 32> nodesToVisit;
+  nodesToVisit.PushBack(0);
+
+  while (nodesToVisit.IsEmpty() == false)
+  {
+    ezUInt32 uiNodeIndex = nodesToVisit.PeekBack();
+    nodesToVisit.PopBack();
+
+    while (uiNodeIndex < uiNumNodes && nodeToInstruction[uiNodeIndex] == ezInvalidIndex)
+    {
+      const Node& node = m_Nodes[uiNodeIndex];
+
+      nodeToInstruction[uiNodeIndex] = m_Instructions.GetCount();
+      auto& instruction = m_Instructions.ExpandAndGetRef();
+      instruction.m_Function = node.m_Function;
+      instruction.m_pNode = &node;
+      instruction.m_Opcode = Opcode::FromNode(node);
+
+      if (instruction.m_Opcode != Opcode::Call)
+      {
+        instruction.m_InputA = node.GetInputDataOffset(0);
+        instruction.m_InputB = node.GetInputDataOffset(1);
+        instruction.m_Output = node.GetOutputDataOffset(0);
+
+        if (node.m_Type == ezVisualScriptNodeDescription::Type::Builtin_Compare)
+        {
+          instruction.m_ComparisonOperator = node.GetUserData<NodeUserData_Comparison>().m_ComparisonOperator;
+        }
+      }
+
+      for (ezUInt32 uiSlot = node.m_NumExecutionIndices; uiSlot-- > 1;)
+      {
+        nodesToVisit.PushBack(node.GetExecutionIndex(uiSlot));
+      }
+
+      uiNodeIndex = node.GetExecutionIndex(0);
+    }
+  }
+
+  auto GetInstructionIndex = [&](ezUInt32 uiNodeIndex)
+  {
+    return uiNodeIndex < uiNumNodes ? nodeToInstruction[uiNodeIndex] : ezInvalidIndex;
+  };
+
+  for (auto& instruction : m_Instructions)
+  {
+    const Node& node = *instruction.m_pNode;
+    instruction.m_uiNextInstruction = GetInstructionIndex(node.GetExecutionIndex(0));
+
+    if (node.m_NumExecutionIndices > 1)
+    {
+      if (m_Successors.GetCount() + node.m_NumExecutionIndices > ezMath::MaxValue<ezUInt16>())
+      {
+        ezLog::Error("Visual script graph has too many execution connections");
+        return EZ_FAILURE;
+      }
+
+      instruction.m_uiFirstSuccessor = static_cast<ezUInt16>(m_Successors.GetCount());
+      instruction.m_uiNumSuccessors = node.m_NumExecutionIndices;
+
+      for (ezUInt32 uiSlot = 0; uiSlot < node.m_NumExecutionIndices; ++uiSlot)
+      {
+        m_Successors.PushBack(GetInstructionIndex(node.GetExecutionIndex(uiSlot)));
+      }
+    }
+    else
+    {
+      instruction.m_uiNumSuccessors = node.m_NumExecutionIndices;
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
 ezScriptMessageDesc ezVisualScriptGraphDescription::GetMessageDesc() const
 {
   auto pEntryNode = GetNode(0);
@@ -290,7 +457,13 @@ void ezVisualScriptExecutionContext::Initialize(ezVisualScriptInstance& inout_in
   m_DataStorage[DataOffset::Source::Instance] = inout_instance.GetInstanceDataStorage();
   m_DataStorage[DataOffset::Source::Constant] = inout_instance.GetConstantDataStorage();
 
-  auto pNode = m_pDesc->GetNode(0);
+  for (ezUInt32 i = 0; i < DataOffset::Source::Count; ++i)
+  {
+    m_Data[i] = m_DataStorage[i] != nullptr ? m_DataStorage[i]->GetByteBlobPtr() : ezByteBlobPtr();
+  }
+
+  auto pEntryInstruction = m_pDesc->GetInstruction(0);
+  auto pNode = pEntryInstruction->m_pNode;
   EZ_ASSERT_DEV(ezVisualScriptNodeDescription::Type::IsEntry(pNode->m_Type), "Invalid entry node");
 
   for (ezUInt32 i = 0; i < arguments.GetCount(); ++i)
@@ -298,7 +471,7 @@ void ezVisualScriptExecutionContext::Initialize(ezVisualScriptInstance& inout_in
     SetDataFromVariant(pNode->GetOutputDataOffset(i), arguments[i]);
   }
 
-  m_uiCurrentNode = pNode->GetExecutionIndex(0);
+  m_uiCurrentInstruction = m_pDesc->GetNextInstruction(*pEntryInstruction, 0);
 }
 
 void ezVisualScriptExecutionContext::Deinitialize()
@@ -322,13 +495,89 @@ ezVisualScriptExecutionContext::ExecResult ezVisualScriptExecutionContext::Execu
   ezUInt32 uiCounter = 0;
 #endif
 
-  auto pNode = m_pDesc->GetNode(m_uiCurrentNode);
-  while (pNode != nullptr)
+  using Opcode = ezVisualScriptGraphDescription::Opcode;
+
+  auto pInstruction = m_pDesc->GetInstruction(m_uiCurrentInstruction);
+  while (pInstruction != nullptr)
   {
-    ExecResult result = pNode->m_Function(*this, *pNode);
-    if (result.m_NextExecAndState < ExecResult::State::Completed)
+    const ezVisualScriptGraphDescription::Instruction& instruction = *pInstruction;
+
+    ExecResult result;
+    switch (instruction.m_Opcode)
     {
-      return result;
+      case Opcode::Call:
+        result = instruction.m_Function(*this, *instruction.m_pNode);
+        if (result.m_NextExecAndState < ExecResult::State::Completed)
+        {
+          return result;
+        }
+        break;
+
+      case Opcode::Branch:
+        result = ExecResult::RunNext(GetData<bool>(instruction.m_InputA) ? 0 : 1);
+        break;
+      case Opcode::And:
+        SetData(instruction.m_Output, GetData<bool>(instruction.m_InputA) && GetData<bool>(instruction.m_InputB));
+        break;
+      case Opcode::Or:
+        SetData(instruction.m_Output, GetData<bool>(instruction.m_InputA) || GetData<bool>(instruction.m_InputB));
+        break;
+      case Opcode::Not:
+        SetData(instruction.m_Output, !GetData<bool>(instruction.m_InputA));
+        break;
+
+      case Opcode::Copy_Bool:
+        SetData(instruction.m_Output, GetData<bool>(instruction.m_InputA));
+        break;
+      case Opcode::Copy_Int:
+        SetData(instruction.m_Output, GetData<ezInt32>(instruction.m_InputA));
+        break;
+      case Opcode::Copy_Float:
+        SetData(instruction.m_Output, GetData<float>(instruction.m_InputA));
+        break;
+      case Opcode::Inc_Int:
+        SetData(instruction.m_Output, GetData<ezInt32>(instruction.m_InputA) + 1);
+        break;
+      case Opcode::Inc_Float:
+        SetData(instruction.m_Output, GetData<float>(instruction.m_InputA) + 1.0f);
+        break;
+      case Opcode::Dec_Int:
+        SetData(instruction.m_Output, GetData<ezInt32>(instruction.m_InputA) - 1);
+        break;
+      case Opcode::Dec_Float:
+        SetData(instruction.m_Output, GetData<float>(instruction.m_InputA) - 1.0f);
+        break;
+
+      case Opcode::Add_Int:
+        SetData(instruction.m_Output, ezInt32(GetData<ezInt32>(instruction.m_InputA) + GetData<ezInt32>(instruction.m_InputB)));
+        break;
+      case Opcode::Add_Float:
+        SetData(instruction.m_Output, GetData<float>(instruction.m_InputA) + GetData<float>(instruction.m_InputB));
+        break;
+      case Opcode::Sub_Int:
+        SetData(instruction.m_Output, ezInt32(GetData<ezInt32>(instruction.m_InputA) - GetData<ezInt32>(instruction.m_InputB)));
+        break;
+      case Opcode::Sub_Float:
+        SetData(instruction.m_Output, GetData<float>(instruction.m_InputA) - GetData<float>(instruction.m_InputB));
+        break;
+      case Opcode::Mul_Int:
+        SetData(instruction.m_Output, ezInt32(GetData<ezInt32>(instruction.m_InputA) * GetData<ezInt32>(instruction.m_InputB)));
+        break;
+      case Opcode::Mul_Float:
+        SetData(instruction.m_Output, GetData<float>(instruction.m_InputA) * GetData<float>(instruction.m_InputB));
+        break;
+      case Opcode::Div_Float:
+        SetData(instruction.m_Output, GetData<float>(instruction.m_InputA) / GetData<float>(instruction.m_InputB));
+        break;
+
+      case Opcode::Compare_Int:
+        SetData(instruction.m_Output, ezComparisonOperator::Compare(instruction.m_ComparisonOperator, GetData<ezInt32>(instruction.m_InputA), GetData<ezInt32>(instruction.m_InputB)));
+        break;
+      case Opcode::Compare_Float:
+        SetData(instruction.m_Output, ezComparisonOperator::Compare(instruction.m_ComparisonOperator, GetData<float>(instruction.m_InputA), GetData<float>(instruction.m_InputB)));
+        break;
+
+        EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
     }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -340,10 +589,10 @@ ezVisualScriptExecutionContext::ExecResult ezVisualScriptExecutionContext::Execu
     }
 #endif
 
-    m_uiCurrentNode = pNode->GetExecutionIndex(result.m_NextExecAndState);
+    m_uiCurrentInstruction = m_pDesc->GetNextInstruction(instruction, result.m_NextExecAndState);
     m_pCurrentCoroutine = nullptr;
 
-    pNode = m_pDesc->GetNode(m_uiCurrentNode);
+    pInstruction = m_pDesc->GetInstruction(m_uiCurrentInstruction);
   }
 
   return ExecResult::RunNext(0);
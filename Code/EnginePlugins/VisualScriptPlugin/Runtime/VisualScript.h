@@ -217,15 +217,82 @@ public:
 
   const Node* GetNode(ezUInt32 uiIndex) const;
 
+  /// \brief Operations that are executed directly by the execution loop instead of calling the node's execute function.
+  ///
+  /// Only the most common control flow, logic and arithmetic nodes on bool, int and float data have their own opcode.
+  /// Everything else is executed through Call.
+  struct Opcode
+  {
+    using StorageType = ezUInt8;
+
+    enum Enum
+    {
+      Call, ///< Calls the execute function of the node
+      Branch,
+      And,
+      Or,
+      Not,
+      Copy_Bool,
+      Copy_Int,
+      Copy_Float,
+      Inc_Int,
+      Inc_Float,
+      Dec_Int,
+      Dec_Float,
+      Add_Int,
+      Add_Float,
+      Sub_Int,
+      Sub_Float,
+      Mul_Int,
+      Mul_Float,
+      Div_Float,
+      Compare_Int,
+      Compare_Float,
+
+      Default = Call
+    };
+
+    static Enum FromNode(const Node& node);
+  };
+
+  /// \brief A node in the linear instruction stream that is built from the node graph at load time.
+  ///
+  /// Instructions are laid out along the execution chains starting at the entry node, so that in most cases the next
+  /// instruction directly follows the current one in memory. The successor for execution slot 0 is stored inline.
+  /// Instructions with an opcode other than Call carry their operands, so they don't need to look at the node at all.
+  struct Instruction
+  {
+    ExecuteFunction m_Function = nullptr;
+    const Node* m_pNode = nullptr;
+    ezUInt32 m_uiNextInstruction = ezInvalidIndex;
+    ezUInt16 m_uiFirstSuccessor = 0;
+    ezUInt16 m_uiNumSuccessors = 0;
+
+    ezEnum<Opcode> m_Opcode;
+    ezEnum<ezComparisonOperator> m_ComparisonOperator;
+
+    DataOffset m_InputA;
+    DataOffset m_InputB;
+    DataOffset m_Output;
+  };
+
+  const Instruction* GetInstruction(ezUInt32 uiIndex) const;
+  ezUInt32 GetNextInstruction(const Instruction& instruction, ezUInt32 uiSlot) const;
+
   bool IsCoroutine() const;
   ezScriptMessageDesc GetMessageDesc() const;
 
   const ezSharedPtr<const ezVisualScriptDataDescription>& GetLocalDataDesc() const;
 
 private:
+  ezResult FlattenNodes();
+
   ezArrayPtr<const Node> m_Nodes;
   ezBlob m_Storage;
 
+  ezDynamicArray<Instruction> m_Instructions;
+  ezDynamicArray<ezUInt32> m_Successors;
+
   ezSharedPtr<const ezVisualScriptDataDescription> m_pLocalDataDesc;
 };
 
@@ -255,6 +322,9 @@ public:
   template <typename T>
   void SetData(DataOffset dataOffset, const T& value);
 
+  const void* GetRawData(DataOffset dataOffset) const;
+  void* GetWritableRawData(DataOffset dataOffset);
+
   ezTypedPointer GetPointerData(DataOffset dataOffset);
 
   template <typename T>
@@ -271,12 +341,15 @@ public:
 private:
   ezSharedPtr<const ezVisualScriptGraphDescription> m_pDesc;
   ezVisualScriptInstance* m_pInstance = nullptr;
-  ezUInt32 m_uiCurrentNode = 0;
+  ezUInt32 m_uiCurrentInstruction = 0;
   ezUInt32 m_uiExecutionCounter = 0;
   ezTime m_DeltaTimeSinceLastExecution;
 
   ezVisualScriptDataStorage* m_DataStorage[DataOffset::Source::Count] = {};
 
+  // The raw storage of m_DataStorage, resolved once in Initialize so plain data access doesn't need to go through the storage objects.
+  ezByteBlobPtr m_Data[DataOffset::Source::Count];
+
   ezScriptCoroutine* m_pCurrentCoroutine = nullptr;
 };
 
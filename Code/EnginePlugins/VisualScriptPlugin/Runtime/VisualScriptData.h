@@ -100,6 +100,11 @@ public:
   ezResult Serialize(ezStreamWriter& inout_stream) const;
   ezResult Deserialize(ezStreamReader& inout_stream);
 
+  const ezVisualScriptDataDescription& GetDesc() const { return *m_pDesc; }
+
+  /// \brief Returns the whole raw storage. Only valid until the storage is allocated or deallocated again.
+  ezByteBlobPtr GetByteBlobPtr() { return m_Storage.GetByteBlobPtr(); }
+
   using DataOffset = ezVisualScriptDataDescription::DataOffset;
 
   template <typename T>
@@ -111,6 +116,15 @@ public:
   template <typename T>
   void SetData(DataOffset dataOffset, const T& value);
 
+  /// \brief Writes the value into the given raw storage and converts handles and string views to their storage type.
+  /// Offsets outside of the storage, e.g. of unconnected outputs, are skipped.
+  template <typename T>
+  static void StoreData(ezByteBlobPtr storage, const ezVisualScriptDataDescription& desc, DataOffset dataOffset, const T& value);
+
+  /// \brief Returns a pointer to the raw storage at the given offset. The storage holds an instance of ezVisualScriptDataType::GetRtti(dataOffset.GetType()).
+  const void* GetRawData(DataOffset dataOffset) const;
+  void* GetWritableRawData(DataOffset dataOffset);
+
   ezTypedPointer GetPointerData(DataOffset dataOffset, ezUInt32 uiExecutionCounter) const;
 
   template <typename T>
@@ -55,16 +55,37 @@ T& ezVisualScriptDataStorage::GetWritableData(DataOffset dataOffset)
   return *reinterpret_cast<T*>(m_Storage.GetByteBlobPtr().GetPtr() + dataOffset.m_uiByteOffset);
 }
 
+EZ_FORCE_INLINE const void* ezVisualScriptDataStorage::GetRawData(DataOffset dataOffset) const
+{
+  m_pDesc->CheckOffset(dataOffset, nullptr);
+
+  return m_Storage.GetByteBlobPtr().GetPtr() + dataOffset.m_uiByteOffset;
+}
+
+EZ_FORCE_INLINE void* ezVisualScriptDataStorage::GetWritableRawData(DataOffset dataOffset)
+{
+  m_pDesc->CheckOffset(dataOffset, nullptr);
+
+  return m_Storage.GetByteBlobPtr().GetPtr() + dataOffset.m_uiByteOffset;
+}
+
 template <typename T>
-void ezVisualScriptDataStorage::SetData(DataOffset dataOffset, const T& value)
+EZ_FORCE_INLINE void ezVisualScriptDataStorage::SetData(DataOffset dataOffset, const T& value)
+{
+  StoreData(m_Storage.GetByteBlobPtr(), *m_pDesc, dataOffset, value);
+}
+
+// static
+template <typename T>
+EZ_FORCE_INLINE void ezVisualScriptDataStorage::StoreData(ezByteBlobPtr storage, const ezVisualScriptDataDescription& desc, DataOffset dataOffset, const T& value)
 {
   static_assert(!std::is_pointer<T>::value, "Use SetPointerData instead");
 
-  if (dataOffset.m_uiByteOffset < m_Storage.GetByteBlobPtr().GetCount())
+  if (dataOffset.m_uiByteOffset < storage.GetCount())
   {
-    m_pDesc->CheckOffset(dataOffset, ezGetStaticRTTI<T>());
+    desc.CheckOffset(dataOffset, ezGetStaticRTTI<T>());
 
-    auto pData = m_Storage.GetByteBlobPtr().GetPtr() + dataOffset.m_uiByteOffset;
+    auto pData = storage.GetPtr() + dataOffset.m_uiByteOffset;
 
     if constexpr (std::is_same<T, ezGameObjectHandle>::value)
     {
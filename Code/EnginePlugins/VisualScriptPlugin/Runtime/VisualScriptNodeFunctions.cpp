@@ -77,6 +77,44 @@ namespace
     return EZ_SUCCESS;
   }
 
+  static EZ_FORCE_INLINE bool IsTypedDataCompatible(ezVisualScriptExecutionContext::DataOffset dataOffset, const ezRTTI* pType)
+  {
+    const auto dataType = dataOffset.GetType();
+    return ezVisualScriptDataType::IsPointer(dataType) == false && ezVisualScriptDataType::GetRtti(dataType) == pType;
+  }
+
+  /// \brief Collects pointers directly into the data storage if every argument is stored as exactly the type the function expects.
+  /// Returns false if the function has to be called through the variant path instead.
+  static EZ_FORCE_INLINE bool FillTypedFunctionArgs(ezVisualScriptExecutionContext& inout_context, const ezVisualScriptGraphDescription::Node& node, const ezAbstractFunctionProperty* pFunction, ezUInt32 uiStartSlot, ezDynamicArray<const void*>& out_args)
+  {
+    if (pFunction->SupportsTypedExecution() == false)
+      return false;
+
+    const ezUInt32 uiArgCount = pFunction->GetArgumentCount();
+    if (uiArgCount != node.m_NumInputDataOffsets - uiStartSlot)
+      return false;
+
+    for (ezUInt32 i = 0; i < uiArgCount; ++i)
+    {
+      auto dataOffset = node.GetInputDataOffset(uiStartSlot + i);
+      if (dataOffset.IsValid() == false || IsTypedDataCompatible(dataOffset, pFunction->GetArgumentType(i)) == false)
+        return false;
+
+      out_args.PushBack(inout_context.GetRawData(dataOffset));
+    }
+
+    return true;
+  }
+
+  /// \brief Member properties that are stored as exactly their type can be copied from and to the data storage without going through ezVariant.
+  static EZ_FORCE_INLINE bool IsTypedMemberProperty(const ezAbstractProperty* pProp, ezVisualScriptExecutionContext::DataOffset dataOffset)
+  {
+    if (pProp->GetCategory() != ezPropertyCategory::Member || pProp->GetFlags().IsAnySet(ezPropertyFlags::Pointer | ezPropertyFlags::IsEnum | ezPropertyFlags::Bitflags))
+      return false;
+
+    return dataOffset.IsValid() && IsTypedDataCompatible(dataOffset, pProp->GetSpecificType());
+  }
+
   static EZ_FORCE_INLINE ezScriptWorldModule* GetScriptModule(ezVisualScriptExecutionContext& inout_context)
   {
     ezWorld* pWorld = inout_context.GetInstance().GetWorld();
@@ -116,6 +154,26 @@ namespace
       ++uiSlot;
     }
 
+    auto dataOffsetR = node.GetOutputDataOffset(0);
+
+    // Call directly on the data storage if possible to avoid the conversion from and to ezVariant
+    {
+      ezHybridArray<const void*, 8> typedArgs;
+      if (FillTypedFunctionArgs(inout_context, node, pFunction, uiSlot, typedArgs))
+      {
+        if (dataOffsetR.IsValid() == false)
+        {
+          pFunction->ExecuteTyped(pInstance.m_pObject, typedArgs, nullptr);
+          return ExecResult::RunNext(0);
+        }
+        else if (IsTypedDataCompatible(dataOffsetR, pFunction->GetReturnType()))
+        {
+          pFunction->ExecuteTyped(pInstance.m_pObject, typedArgs, inout_context.GetWritableRawData(dataOffsetR));
+          return ExecResult::RunNext(0);
+        }
+      }
+    }
+
     ezHybridArray<ezVariant, 8> args;
     if (FillFunctionArgs(inout_context, node, pFunction, uiSlot, args).Failed())
     {
@@ -125,7 +183,6 @@ namespace
     ezVariant returnValue;
     pFunction->Execute(pInstance.m_pObject, args, returnValue);
 
-    auto dataOffsetR = node.GetOutputDataOffset(0);
     if (dataOffsetR.IsValid())
     {
       inout_context.SetDataFromVariant(dataOffsetR, returnValue);
@@ -322,10 +379,18 @@ namespace
     {
       auto pProp = userData.m_Properties[i];
       const ezRTTI* pPropType = pProp->GetSpecificType();
-      ezVariant value = inout_context.GetDataAsVariant(node.GetInputDataOffset(uiStartSlot + i), pPropType);
+      auto dataOffset = node.GetInputDataOffset(uiStartSlot + i);
 
-      if (pProp->GetCategory() == ezPropertyCategory::Member)
+      if (IsTypedMemberProperty(pProp, dataOffset))
+      {
+        if (pProp->GetFlags().IsSet(ezPropertyFlags::ReadOnly) == false)
+        {
+          static_cast<const ezAbstractMemberProperty*>(pProp)->SetValuePtr(pMessage.Borrow(), inout_context.GetRawData(dataOffset));
+        }
+      }
+      else if (pProp->GetCategory() == ezPropertyCategory::Member)
       {
+        ezVariant value = inout_context.GetDataAsVariant(dataOffset, pPropType);
         ezReflectionUtils::SetMemberPropertyValue(static_cast<const ezAbstractMemberProperty*>(pProp), pMessage.Borrow(), value);
       }
       else
@@ -377,6 +442,12 @@ namespace
           continue;
 
         auto pProp = userData.m_Properties[i];
+        if (IsTypedMemberProperty(pProp, dataOffset))
+        {
+          static_cast<const ezAbstractMemberProperty*>(pProp)->GetValuePtr(pMessage.Borrow(), inout_context.GetWritableRawData(dataOffset));
+          continue;
+        }
+
         ezVariant value;
 
         if (pProp->GetCategory() == ezPropertyCategory::Member)
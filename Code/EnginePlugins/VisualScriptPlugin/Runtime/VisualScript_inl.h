@@ -112,6 +112,19 @@ EZ_ALWAYS_INLINE const ezVisualScriptGraphDescription::Node* ezVisualScriptGraph
   return uiIndex < m_Nodes.GetCount() ? &m_Nodes.GetPtr()[uiIndex] : nullptr;
 }
 
+EZ_ALWAYS_INLINE const ezVisualScriptGraphDescription::Instruction* ezVisualScriptGraphDescription::GetInstruction(ezUInt32 uiIndex) const
+{
+  return uiIndex < m_Instructions.GetCount() ? &m_Instructions.GetData()[uiIndex] : nullptr;
+}
+
+EZ_ALWAYS_INLINE ezUInt32 ezVisualScriptGraphDescription::GetNextInstruction(const Instruction& instruction, ezUInt32 uiSlot) const
+{
+  if (uiSlot == 0)
+    return instruction.m_uiNextInstruction;
+
+  return uiSlot < instruction.m_uiNumSuccessors ? m_Successors.GetData()[instruction.m_uiFirstSuccessor + uiSlot] : ezInvalidIndex;
+}
+
 EZ_ALWAYS_INLINE bool ezVisualScriptGraphDescription::IsCoroutine() const
 {
   auto entryNodeType = GetNode(0)->m_Type;
@@ -128,21 +141,43 @@ EZ_ALWAYS_INLINE const ezSharedPtr<const ezVisualScriptDataDescription>& ezVisua
 template <typename T>
 EZ_FORCE_INLINE const T& ezVisualScriptExecutionContext::GetData(DataOffset dataOffset) const
 {
-  return m_DataStorage[dataOffset.m_uiSource]->GetData<T>(dataOffset);
+  static_assert(!std::is_pointer<T>::value && !std::is_same<T, ezTypedPointer>::value, "Use GetPointerData instead");
+
+  m_DataStorage[dataOffset.m_uiSource]->GetDesc().CheckOffset(dataOffset, ezGetStaticRTTI<T>());
+  return *reinterpret_cast<const T*>(m_Data[dataOffset.m_uiSource].GetPtr() + dataOffset.m_uiByteOffset);
 }
 
 template <typename T>
 EZ_FORCE_INLINE T& ezVisualScriptExecutionContext::GetWritableData(DataOffset dataOffset)
 {
+  static_assert(!std::is_pointer<T>::value && !std::is_same<T, ezTypedPointer>::value, "Use GetPointerData instead");
   EZ_ASSERT_DEBUG(dataOffset.IsConstant() == false, "Can't write to constant data");
-  return m_DataStorage[dataOffset.m_uiSource]->GetWritableData<T>(dataOffset);
+
+  m_DataStorage[dataOffset.m_uiSource]->GetDesc().CheckOffset(dataOffset, ezGetStaticRTTI<T>());
+  return *reinterpret_cast<T*>(m_Data[dataOffset.m_uiSource].GetPtr() + dataOffset.m_uiByteOffset);
 }
 
 template <typename T>
 EZ_FORCE_INLINE void ezVisualScriptExecutionContext::SetData(DataOffset dataOffset, const T& value)
 {
   EZ_ASSERT_DEBUG(dataOffset.IsConstant() == false, "Outputs can't set constant data");
-  return m_DataStorage[dataOffset.m_uiSource]->SetData<T>(dataOffset, value);
+
+  const ezUInt32 uiSource = dataOffset.m_uiSource;
+  ezVisualScriptDataStorage::StoreData(m_Data[uiSource], m_DataStorage[uiSource]->GetDesc(), dataOffset, value);
+}
+
+EZ_FORCE_INLINE const void* ezVisualScriptExecutionContext::GetRawData(DataOffset dataOffset) const
+{
+  m_DataStorage[dataOffset.m_uiSource]->GetDesc().CheckOffset(dataOffset, nullptr);
+  return m_Data[dataOffset.m_uiSource].GetPtr() + dataOffset.m_uiByteOffset;
+}
+
+EZ_FORCE_INLINE void* ezVisualScriptExecutionContext::GetWritableRawData(DataOffset dataOffset)
+{
+  EZ_ASSERT_DEBUG(dataOffset.IsConstant() == false, "Can't write to constant data");
+
+  m_DataStorage[dataOffset.m_uiSource]->GetDesc().CheckOffset(dataOffset, nullptr);
+  return m_Data[dataOffset.m_uiSource].GetPtr() + dataOffset.m_uiByteOffset;
 }
 
 EZ_FORCE_INLINE ezTypedPointer ezVisualScriptExecutionContext::GetPointerData(DataOffset dataOffset)
@@ -36,6 +36,15 @@
     Example:
       -pack "path/to/folder" "path/to/another/folder"
 
+-blocks
+    Stores compressed files as independently compressed blocks, which allows partial reads.
+
+-dict
+    Compresses small files with a shared compression dictionary that is stored in the archive.
+
+-benchmark
+    After packing, reports the compression ratio, the packing throughput and the throughput of reading back all files.
+
 Description:
     -pack and -unpack can take multiple inputs to either aggregate multiple folders into one archive (pack)
     or to unpack multiple archives at the same time.
@@ -69,6 +78,27 @@ If no -out is specified, it is determined to be where the input file is located.
 ",
   "");
 
+ezCommandLineOptionBool opt_Blocks("_ArchiveTool", "-blocks", "\
+Stores compressed files as independently compressed blocks.\n\
+\n\
+Block compressed files can be read partially and seeked in without decompressing everything in front.\n\
+Only used for packing. Has to come after the inputs.\n\
+", false);
+
+ezCommandLineOptionBool opt_Dict("_ArchiveTool", "-dict", "\
+Compresses small files with a shared compression dictionary.\n\
+\n\
+The dictionary is assembled from the small files themselves and stored in the archive.\n\
+This greatly improves the compression of many small, similar files, such as materials and prefabs.\n\
+Only used for packing. Has to come after the inputs.\n\
+", false);
+
+ezCommandLineOptionBool opt_Benchmark("_ArchiveTool", "-benchmark", "\
+Reports the compression ratio, the packing throughput and the throughput of reading back all files.\n\
+\n\
+Only used for packing. Has to come after the inputs.\n\
+", false);
+
 ezCommandLineOptionDoc opt_Unpack("_ArchiveTool", "-unpack", "<paths>", "\
 One or multiple paths to ezArchive files that shall be extracted.\n\
 \n\
@@ -102,6 +132,12 @@ ezArchiveTool.exe \"C:/Stuff\"\n\
 ezArchiveTool.exe \"C:/Stuff\" -out \"C:/MyStuff.ezArchive\"\n\
   Packs all data in \"C:/Stuff\" into \"C:/MyStuff.ezArchive\"\n\
 \n\
+ezArchiveTool.exe \"C:/Stuff\" -blocks\n\
+  Packs all data in \"C:/Stuff\" into \"C:/Stuff.ezArchive\" with block compressed files\n\
+\n\
+ezArchiveTool.exe \"C:/Stuff\" -dict -benchmark\n\
+  Packs all data in \"C:/Stuff\" with a compression dictionary and reports the compression and read performance\n\
+\n\
 ezArchiveTool.exe \"C:/Stuff.ezArchive\"\n\
   Unpacks all data from the archive into \"C:/Stuff\"\n\
 \n\
@@ -154,6 +190,7 @@ public:
 
   ezDynamicArray<ezString> m_sInputs;
   ezString m_sOutput;
+  ezTime m_PackDuration;
 
   ezArchiveTool()
     : ezApplication("ArchiveTool")
@@ -227,7 +264,7 @@ public:
       {
         const ezStringView sArg = GetArgument(a);
 
-        if (sArg.IsEqual_NoCase("-out"))
+        if (sArg.IsEqual_NoCase("-out") || sArg.IsEqual_NoCase("-blocks") || sArg.IsEqual_NoCase("-dict") || sArg.IsEqual_NoCase("-benchmark"))
           break;
 
         m_sInputs.PushBack(ezOSFile::MakePathAbsoluteWithCWD(sArg));
@@ -308,9 +345,13 @@ public:
   {
     ezArchiveBuilderImpl archive;
 
+    const ezArchiveCompressionMode compression = opt_Blocks.GetOptionValue(ezCommandLineOption::LogMode::Always) ? ezArchiveCompressionMode::Compressed_zstd_blocks : ezArchiveCompressionMode::Compressed_zstd;
+
+    archive.m_bUseCompressionDictionary = opt_Dict.GetOptionValue(ezCommandLineOption::LogMode::Always);
+
     for (const auto& folder : m_sInputs)
     {
-      archive.AddFolder(folder, ezArchiveCompressionMode::Compressed_zstd, PackFileCallback);
+      archive.AddFolder(folder, compression, PackFileCallback);
     }
 
     if (m_sOutput.IsEmpty())
@@ -324,6 +365,9 @@ public:
     m_sOutput = ezOSFile::MakePathAbsoluteWithCWD(m_sOutput);
 
     ezLog::Info("Writing archive to '{}'", m_sOutput);
+
+    ezStopwatch sw;
+
     if (archive.WriteArchive(m_sOutput).Failed())
     {
       ezLog::Error("Failed to write the ezArchive");
@@ -331,6 +375,67 @@ public:
       return EZ_FAILURE;
     }
 
+    m_PackDuration = sw.GetRunningTotal();
+
+    return EZ_SUCCESS;
+  }
+
+  static double GetThroughput(ezUInt64 uiBytes, ezTime duration)
+  {
+    return (duration.GetSeconds() > 0.0) ? (uiBytes / (1024.0 * 1024.0)) / duration.GetSeconds() : 0.0;
+  }
+
+  ezResult Benchmark()
+  {
+    ezArchiveReader reader;
+    EZ_SUCCEED_OR_RETURN(reader.OpenArchive(m_sOutput));
+
+    const ezArchiveTOC& toc = reader.GetArchiveTOC();
+
+    ezUInt64 uiUncompressedSize = 0;
+    ezUInt64 uiStoredSize = 0;
+    ezUInt32 uiNumDictEntries = 0;
+
+    for (const auto& entry : toc.m_Entries)
+    {
+      uiUncompressedSize += entry.m_uiUncompressedDataSize;
+      uiStoredSize += entry.m_uiStoredDataSize;
+
+      if (entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_dict)
+        ++uiNumDictEntries;
+    }
+
+    ezDynamicArray<ezUInt8> buffer;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < toc.m_Entries.GetCount(); ++i)
+    {
+      const ezUInt64 uiSize = toc.m_Entries[i].m_uiUncompressedDataSize;
+
+      if (uiSize > ezMath::MaxValue<ezUInt32>())
+      {
+        ezLog::Warning("Skipping '{}' in the read benchmark, it is too large.", toc.GetEntryPathString(i));
+        continue;
+      }
+
+      buffer.SetCountUninitialized(static_cast<ezUInt32>(uiSize));
+
+      if (reader.ReadEntryData(i, 0, buffer.GetArrayPtr()) != uiSize)
+      {
+        ezLog::Error("Failed to read '{}'", toc.GetEntryPathString(i));
+        return EZ_FAILURE;
+      }
+    }
+
+    const ezTime readDuration = sw.GetRunningTotal();
+
+    ezLog::Info("Benchmark results:");
+    ezLog::Info("  Files: {} ({} compressed with the dictionary, dictionary size {})", toc.m_Entries.GetCount(), uiNumDictEntries, ezArgFileSize(toc.m_CompressionDictionary.GetCount()));
+    ezLog::Info("  Size: {} -> {} (ratio {})", ezArgFileSize(uiUncompressedSize), ezArgFileSize(uiStoredSize), ezArgF(uiStoredSize > 0 ? static_cast<double>(uiUncompressedSize) / uiStoredSize : 0.0, 2));
+    ezLog::Info("  Packing: {} ({} MB/s)", m_PackDuration, ezArgF(GetThroughput(uiUncompressedSize, m_PackDuration), 1));
+    ezLog::Info("  Reading: {} ({} MB/s)", readDuration, ezArgF(GetThroughput(uiUncompressedSize, readDuration), 1));
+
     return EZ_SUCCESS;
   }
 
@@ -394,6 +499,11 @@ public:
         ezLog::Error("Packaging files failed");
         SetReturnCode(2);
       }
+      else if (opt_Benchmark.GetOptionValue(ezCommandLineOption::LogMode::Always) && Benchmark().Failed())
+      {
+        ezLog::Error("Benchmarking the archive failed");
+        SetReturnCode(4);
+      }
 
       ezLog::Success("Finished packing archive in {}", sw.GetRunningTotal());
       return ezApplication::Execution::Quit;
@@ -0,0 +1,254 @@
+#include <CoreTest/CoreTestPCH.h>
+
+#include <Core/Interfaces/PhysicsWorldModule.h>
+#include <Core/World/World.h>
+#include <Foundation/Configuration/Plugin.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiGridSize = 32;
+  constexpr float s_fGridSpacing = 5.0f;
+  constexpr ezUInt32 s_uiNumQueries = 10000;
+
+  void CreateStaticGeometry(ezWorld& ref_world, ezPhysicsWorldModuleInterface* pPhysics)
+  {
+    ezRandom rnd;
+    rnd.Initialize(0x5eed);
+
+    ezGameObjectDesc gd;
+
+    for (ezUInt32 y = 0; y < s_uiGridSize; ++y)
+    {
+      for (ezUInt32 x = 0; x < s_uiGridSize; ++x)
+      {
+        const float fHeight = (float)rnd.DoubleMinMax(1.0, 8.0);
+
+        gd.m_LocalPosition.Set(x * s_fGridSpacing, y * s_fGridSpacing, fHeight * 0.5f);
+
+        ezGameObject* pObj;
+        ref_world.CreateObject(gd, pObj);
+
+        pPhysics->AddStaticCollisionBox(pObj, ezVec3(4.0f, 4.0f, fHeight));
+      }
+    }
+
+    // initializes the components and thus creates the physics bodies
+    ref_world.Update();
+  }
+
+  ezVec3 GetRandomPosition(ezRandom& ref_rnd, float fHeight)
+  {
+    const double fExtent = s_uiGridSize * s_fGridSpacing;
+    return ezVec3((float)ref_rnd.DoubleMinMax(0.0, fExtent), (float)ref_rnd.DoubleMinMax(0.0, fExtent), fHeight);
+  }
+
+  void OutputQueriesPerSecond(const char* szQueryType, const char* szMode, ezTime duration)
+  {
+    ezTestFramework::Output(ezTestOutput::Duration, "%u %s (%s): %.2fms, %.0f queries/sec", s_uiNumQueries, szQueryType, szMode, duration.GetMilliseconds(), s_uiNumQueries / ezMath::Max(duration.GetSeconds(), 0.000001));
+  }
+} // namespace
+
+class ezPhysicsQueryPerformanceTest : public ezTestBaseClass
+{
+public:
+  virtual const char* GetTestName() const override { return "Profile_PhysicsQueries"; }
+
+private:
+  enum SubTest
+  {
+    BatchedQueries,
+  };
+
+  virtual void SetupSubTests() override
+  {
+#if EZ_DISABLED(EZ_COMPILE_FOR_DEBUG)
+    AddSubTest("Batched Queries", SubTest::BatchedQueries);
+#endif
+  }
+
+  virtual ezResult InitializeTest() override
+  {
+    // the physics integration is a plugin, without it there is nothing to measure
+    m_bPluginLoaded = ezPlugin::LoadPlugin("ezJoltPlugin", ezPluginLoadFlags::PluginIsOptional).Succeeded();
+    return EZ_SUCCESS;
+  }
+
+  virtual ezResult DeInitializeTest() override
+  {
+    // don't let the physics plugin leak into the tests that run after this one
+    if (m_bPluginLoaded)
+    {
+      ezPlugin::UnloadAllPlugins();
+      m_bPluginLoaded = false;
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override
+  {
+    if (!m_bPluginLoaded)
+    {
+      ezTestFramework::Output(ezTestOutput::Message, "No physics plugin available, skipping physics query benchmark.");
+      return ezTestAppRun::Quit;
+    }
+
+    if (iIdentifier == SubTest::BatchedQueries)
+    {
+      RunBatchedQueries();
+    }
+
+    return ezTestAppRun::Quit;
+  }
+
+  void RunBatchedQueries();
+
+  bool m_bPluginLoaded = false;
+};
+
+static ezPhysicsQueryPerformanceTest s_PhysicsQueryPerformanceTest;
+
+void ezPhysicsQueryPerformanceTest::RunBatchedQueries()
+{
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+
+  EZ_LOCK(world.GetWriteMarker());
+
+  ezPhysicsWorldModuleInterface* pPhysics = world.GetOrCreateModule<ezPhysicsWorldModuleInterface>();
+  if (!EZ_TEST_BOOL(pPhysics != nullptr))
+    return;
+
+  CreateStaticGeometry(world, pPhysics);
+
+  const ezPhysicsQueryParameters params(0);
+
+  ezRandom rnd;
+  rnd.Initialize(0xba7c4);
+
+  ezDynamicArray<ezPhysicsRay> rays;
+  ezDynamicArray<ezPhysicsSweep> sweeps;
+  ezDynamicArray<ezPhysicsOverlap> overlaps;
+  ezDynamicArray<ezBoundingSphere> spheres;
+
+  for (ezUInt32 i = 0; i < s_uiNumQueries; ++i)
+  {
+    auto& ray = rays.ExpandAndGetRef();
+    ray.m_vStart = GetRandomPosition(rnd, 20.0f);
+    ray.m_vDir = ezVec3(0, 0, -1);
+    ray.m_fDistance = 30.0f;
+
+    auto& sweep = sweeps.ExpandAndGetRef();
+    sweep.m_Shape = (i % 2 == 0) ? ezPhysicsQueryShape::MakeSphere(0.5f) : ezPhysicsQueryShape::MakeCapsule(0.3f, 1.0f);
+    sweep.m_Transform = ezTransform(GetRandomPosition(rnd, 1.0f));
+    sweep.m_vDir = ezVec3(1, 0, 0);
+    sweep.m_fDistance = 10.0f;
+
+    auto& overlap = overlaps.ExpandAndGetRef();
+    overlap.m_Shape = ezPhysicsQueryShape::MakeSphere(1.0f);
+    overlap.m_Transform = ezTransform(GetRandomPosition(rnd, 1.0f));
+
+    spheres.PushBack(ezBoundingSphere::MakeFromCenterAndRadius(GetRandomPosition(rnd, 1.0f), 4.0f));
+  }
+
+  ezDynamicArray<ezPhysicsCastResult> results;
+  results.SetCount(s_uiNumQueries);
+
+  ezDynamicArray<bool> hits;
+  hits.SetCount(s_uiNumQueries);
+
+  ezDynamicArray<ezPhysicsOverlapResultArray> overlapResults;
+  overlapResults.SetCount(s_uiNumQueries);
+
+  // Raycasts
+  {
+    ezStopwatch sw;
+
+    ezUInt32 uiNumHits = 0;
+    for (const ezPhysicsRay& ray : rays)
+    {
+      ezPhysicsCastResult result;
+      uiNumHits += pPhysics->Raycast(result, ray.m_vStart, ray.m_vDir, ray.m_fDistance, params) ? 1 : 0;
+    }
+
+    OutputQueriesPerSecond("raycasts", "single", sw.Checkpoint());
+
+    const ezUInt32 uiNumBatchHits = pPhysics->RaycastBatch(results, hits, rays, params);
+
+    OutputQueriesPerSecond("raycasts", "batch", sw.Checkpoint());
+
+    EZ_TEST_INT(uiNumBatchHits, uiNumHits);
+  }
+
+  // Sweeps
+  {
+    ezStopwatch sw;
+
+    ezUInt32 uiNumHits = 0;
+    for (const ezPhysicsSweep& sweep : sweeps)
+    {
+      ezPhysicsCastResult result;
+
+      if (sweep.m_Shape.m_Type == ezPhysicsQueryShape::Type::Sphere)
+        uiNumHits += pPhysics->SweepTestSphere(result, sweep.m_Shape.m_fRadius, sweep.m_Transform.m_vPosition, sweep.m_vDir, sweep.m_fDistance, params) ? 1 : 0;
+      else
+        uiNumHits += pPhysics->SweepTestCapsule(result, sweep.m_Shape.m_fRadius, sweep.m_Shape.m_fCapsuleHeight, sweep.m_Transform, sweep.m_vDir, sweep.m_fDistance, params) ? 1 : 0;
+    }
+
+    OutputQueriesPerSecond("sweeps", "single", sw.Checkpoint());
+
+    const ezUInt32 uiNumBatchHits = pPhysics->SweepTestBatch(results, hits, sweeps, params);
+
+    OutputQueriesPerSecond("sweeps", "batch", sw.Checkpoint());
+
+    EZ_TEST_INT(uiNumBatchHits, uiNumHits);
+  }
+
+  // Overlaps
+  {
+    ezStopwatch sw;
+
+    ezUInt32 uiNumOverlaps = 0;
+    for (const ezPhysicsOverlap& overlap : overlaps)
+    {
+      uiNumOverlaps += pPhysics->OverlapTestSphere(overlap.m_Shape.m_fRadius, overlap.m_Transform.m_vPosition, params) ? 1 : 0;
+    }
+
+    OutputQueriesPerSecond("overlap tests", "single", sw.Checkpoint());
+
+    const ezUInt32 uiNumBatchOverlaps = pPhysics->OverlapTestBatch(hits, overlaps, params);
+
+    OutputQueriesPerSecond("overlap tests", "batch", sw.Checkpoint());
+
+    EZ_TEST_INT(uiNumBatchOverlaps, uiNumOverlaps);
+  }
+
+  // Shape queries
+  {
+    ezStopwatch sw;
+
+    ezUInt32 uiNumShapes = 0;
+    ezPhysicsOverlapResultArray result;
+    for (const ezBoundingSphere& sphere : spheres)
+    {
+      pPhysics->QueryShapesInSphere(result, sphere.m_fRadius, sphere.m_vCenter, params);
+      uiNumShapes += result.m_Results.GetCount();
+    }
+
+    OutputQueriesPerSecond("shape queries", "single", sw.Checkpoint());
+
+    pPhysics->QueryShapesInSphereBatch(overlapResults, spheres, params);
+
+    OutputQueriesPerSecond("shape queries", "batch", sw.Checkpoint());
+
+    ezUInt32 uiNumBatchShapes = 0;
+    for (const ezPhysicsOverlapResultArray& batchResult : overlapResults)
+    {
+      uiNumBatchShapes += batchResult.m_Results.GetCount();
+    }
+
+    EZ_TEST_INT(uiNumBatchShapes, uiNumShapes);
+  }
+}
@@ -0,0 +1,74 @@
+#include <CoreTest/CoreTestPCH.h>
+
+#include <Core/Interfaces/PhysicsWorldModule.h>
+#include <Core/World/World.h>
+#include <Foundation/Configuration/Plugin.h>
+#include <Foundation/Types/ScopeExit.h>
+
+EZ_CREATE_SIMPLE_TEST(World, PhysicsSimulation)
+{
+  // the physics integration is a plugin, without it there is nothing to simulate
+  if (ezPlugin::LoadPlugin("ezJoltPlugin", ezPluginLoadFlags::PluginIsOptional).Failed())
+  {
+    ezTestFramework::Output(ezTestOutput::Message, "No physics plugin available, skipping physics simulation test.");
+    return;
+  }
+
+  // don't let the physics plugin leak into the tests that run after this one
+  EZ_SCOPE_EXIT(ezPlugin::UnloadAllPlugins());
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Falling Bodies")
+  {
+    ezWorldDesc worldDesc("PhysicsSimulation");
+    ezWorld world(worldDesc);
+    world.GetClock().SetFixedTimeStep(ezTime::MakeFromSeconds(1.0 / 60.0));
+
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezPhysicsWorldModuleInterface* pPhysics = world.GetOrCreateModule<ezPhysicsWorldModuleInterface>();
+    const ezRTTI* pDynamicActorType = ezRTTI::FindTypeByName("ezJoltDynamicActorComponent");
+    const ezRTTI* pSphereShapeType = ezRTTI::FindTypeByName("ezJoltShapeSphereComponent");
+
+    if (!EZ_TEST_BOOL(pPhysics != nullptr && pDynamicActorType != nullptr && pSphereShapeType != nullptr))
+      return;
+
+    ezGameObjectDesc gd;
+
+    ezGameObject* pGround;
+    world.CreateObject(gd, pGround);
+    pPhysics->AddStaticCollisionBox(pGround, ezVec3(100.0f, 100.0f, 1.0f));
+
+    // enough bodies, so that every step is split into many Jolt jobs which run as tasks
+    ezDynamicArray<ezGameObjectHandle> spheres;
+
+    for (ezInt32 y = -4; y < 4; ++y)
+    {
+      for (ezInt32 x = -4; x < 4; ++x)
+      {
+        gd.m_LocalPosition.Set(x * 2.0f, y * 2.0f, 10.0f);
+
+        ezGameObject* pSphere;
+        spheres.PushBack(world.CreateObject(gd, pSphere));
+
+        world.GetOrCreateManagerForComponentType(pDynamicActorType)->CreateComponent(pSphere);
+        world.GetOrCreateManagerForComponentType(pSphereShapeType)->CreateComponent(pSphere);
+      }
+    }
+
+    // three seconds are enough for the spheres to fall down and come to rest on the ground
+    for (ezUInt32 i = 0; i < 180; ++i)
+    {
+      world.Update();
+    }
+
+    for (ezGameObjectHandle hSphere : spheres)
+    {
+      ezGameObject* pSphere;
+      if (!EZ_TEST_BOOL(world.TryGetObject(hSphere, pSphere)))
+        continue;
+
+      // the ground's top is at 0.5, the spheres have a radius of 0.5
+      EZ_TEST_FLOAT(pSphere->GetGlobalPosition().z, 1.0f, 0.1f);
+    }
+  }
+}
@@ -1110,6 +1110,170 @@ EZ_CREATE_SIMPLE_TEST(CodeUtils, Expression)
     EZ_TEST_INT(Execute(testByteCode, 2, 4, 8), 64);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Fused instructions")
+  {
+    {
+      ezStringView testCode = "output = a * b + c";
+
+      ezExpressionByteCode testByteCode;
+      Compile<float>(testCode, testByteCode);
+      EZ_TEST_INT(testByteCode.GetNumInstructions(), 5); // LoadF x3, MulAddF, StoreF
+      EZ_TEST_FLOAT(Execute(testByteCode, 2.0f, 3.0f, 4.0f), 10.0f, ezMath::DefaultEpsilon<float>());
+    }
+
+    {
+      ezStringView testCode = "output = c + a * b";
+
+      ezExpressionByteCode testByteCode;
+      Compile<float>(testCode, testByteCode);
+      EZ_TEST_INT(testByteCode.GetNumInstructions(), 5); // LoadF x3, MulAddF, StoreF
+      EZ_TEST_FLOAT(Execute(testByteCode, 2.0f, 3.0f, 4.0f), 10.0f, ezMath::DefaultEpsilon<float>());
+    }
+
+    {
+      ezStringView testCode = "output = a * b - c";
+
+      ezExpressionByteCode testByteCode;
+      Compile<float>(testCode, testByteCode);
+      EZ_TEST_INT(testByteCode.GetNumInstructions(), 5); // LoadF x3, MulSubF, StoreF
+      EZ_TEST_FLOAT(Execute(testByteCode, 2.0f, 3.0f, 4.0f), 2.0f, ezMath::DefaultEpsilon<float>());
+    }
+
+    {
+      ezStringView testCode = "output = saturate(a) + clamp(b, 0, 1)";
+
+      ezExpressionByteCode testByteCode;
+      Compile<float>(testCode, testByteCode);
+      EZ_TEST_INT(testByteCode.GetNumInstructions(), 6); // LoadF x2, SatF x2, AddF, StoreF
+      EZ_TEST_FLOAT(Execute(testByteCode, 2.0f, 0.25f, 0.0f), 1.25f, ezMath::DefaultEpsilon<float>());
+      EZ_TEST_FLOAT(Execute(testByteCode, -2.0f, -0.25f, 0.0f), 0.0f, ezMath::DefaultEpsilon<float>());
+    }
+
+    {
+      ezStringView testCode = "output = lerp(a, b, c)";
+
+      ezExpressionByteCode testByteCode;
+      Compile<float>(testCode, testByteCode);
+      EZ_TEST_INT(testByteCode.GetNumInstructions(), 5); // LoadF x3, LerpF, StoreF
+      EZ_TEST_FLOAT(Execute(testByteCode, 2.0f, 6.0f, 0.25f), 3.0f, ezMath::DefaultEpsilon<float>());
+    }
+
+    // Integer math must not be fused
+    {
+      ezStringView testCode = "output = a * b + c";
+
+      ezExpressionByteCode testByteCode;
+      Compile<int>(testCode, testByteCode);
+      EZ_TEST_INT(testByteCode.GetNumInstructions(), 6); // LoadI x3, MulI, AddI, StoreI
+      EZ_TEST_INT(Execute(testByteCode, 2, 3, 4), 10);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel execution")
+  {
+    ezStringView testCode = "output = a * b + sqrt(a) - c";
+
+    ezExpressionByteCode testByteCode;
+    Compile<float>(testCode, testByteCode);
+
+    // Odd instance count so the last task has to deal with remainder instances
+    constexpr ezUInt32 uiCount = 10001;
+    ezDynamicArray<float> a;
+    ezDynamicArray<float> b;
+    ezDynamicArray<float> o;
+    ezDynamicArray<float> expectedOutput;
+    a.SetCountUninitialized(uiCount);
+    b.SetCountUninitialized(uiCount);
+    o.SetCount(uiCount);
+    expectedOutput.SetCount(uiCount);
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      a[i] = 0.5f * i;
+      b[i] = 0.25f * i;
+    }
+
+    ezProcessingStream inputs[] = {
+      ezProcessingStream(s_sA, a.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+      ezProcessingStream(s_sB, b.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+      ezProcessingStream(s_sC, b.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+      ezProcessingStream(s_sD, a.GetByteArrayPtr(), ezProcessingStream::DataType::Float), // Dummy stream, not actually used
+    };
+
+    ezProcessingStream referenceOutputs[] = {
+      ezProcessingStream(s_sOutput, expectedOutput.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+    };
+
+    ezProcessingStream outputs[] = {
+      ezProcessingStream(s_sOutput, o.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+    };
+
+    EZ_TEST_BOOL(s_pVM->Execute(testByteCode, inputs, referenceOutputs, uiCount).Succeeded());
+    EZ_TEST_BOOL(s_pVM->ExecuteParallel(testByteCode, inputs, outputs, uiCount, ezExpression::GlobalData(), ezExpressionVM::Flags::Default, 64).Succeeded());
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      EZ_TEST_FLOAT(o[i], expectedOutput[i], 0.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Simd4 and AVX2 execution")
+  {
+    // The same byte code executed with and without AVX2 has to produce the same results.
+    // On CPUs without AVX2 both executions use the Simd4 implementation.
+    ezStringView testCode = "var x = a * b + c; var y = x > d ? sqrt(abs(x)) : min(a, d) - max(b, c); output = floor(y * 0.5) + clamp(x, -10, 10) / (abs(d) + 1) - a * c + lerp(a, d, saturate(b))";
+
+    ezExpressionByteCode testByteCode;
+    Compile<float>(testCode, testByteCode);
+
+    // Odd instance count so the AVX2 path has to deal with a padding register
+    constexpr ezUInt32 uiCount = 1001;
+    ezDynamicArray<float> a;
+    ezDynamicArray<float> b;
+    ezDynamicArray<float> c;
+    ezDynamicArray<float> d;
+    ezDynamicArray<float> simd4Output;
+    ezDynamicArray<float> avx2Output;
+    a.SetCountUninitialized(uiCount);
+    b.SetCountUninitialized(uiCount);
+    c.SetCountUninitialized(uiCount);
+    d.SetCountUninitialized(uiCount);
+    simd4Output.SetCount(uiCount);
+    avx2Output.SetCount(uiCount);
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      a[i] = 0.37f * i - 100.0f;
+      b[i] = 0.11f * (i % 17) - 0.9f;
+      c[i] = 3.0f - 0.05f * i;
+      d[i] = 0.2f * (i % 31) - 2.5f;
+    }
+
+    ezProcessingStream inputs[] = {
+      ezProcessingStream(s_sA, a.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+      ezProcessingStream(s_sB, b.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+      ezProcessingStream(s_sC, c.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+      ezProcessingStream(s_sD, d.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+    };
+
+    ezProcessingStream simd4Outputs[] = {
+      ezProcessingStream(s_sOutput, simd4Output.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+    };
+
+    ezProcessingStream avx2Outputs[] = {
+      ezProcessingStream(s_sOutput, avx2Output.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+    };
+
+    EZ_TEST_BOOL(s_pVM->Execute(testByteCode, inputs, simd4Outputs, uiCount, ezExpression::GlobalData(), ezExpressionVM::Flags::Default | ezExpressionVM::Flags::DisableAvx2).Succeeded());
+    EZ_TEST_BOOL(s_pVM->Execute(testByteCode, inputs, avx2Outputs, uiCount, ezExpression::GlobalData(), ezExpressionVM::Flags::Default).Succeeded());
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      // fused multiply-add is only exact on the AVX2 path, so the results may differ in the last bits
+      EZ_TEST_FLOAT(avx2Output[i], simd4Output[i], ezMath::Max(ezMath::Abs(simd4Output[i]) * 1e-5f, 1e-5f));
+    }
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Vector constructors")
   {
     {
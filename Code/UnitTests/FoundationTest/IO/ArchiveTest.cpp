@@ -1,7 +1,11 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveReader.h>
+#include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/Archive/DataDirTypeArchive.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
@@ -159,3 +163,325 @@ EZ_CREATE_SIMPLE_TEST(IO, Archive)
 }
 
 #endif
+
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveBlocks)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveBlocksTest");
+  sOutputFolder.MakeCleanPath();
+
+  // make sure it is empty
+  ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+  ezOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+  if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "Clear", "output", ezDataDirUsage::AllowWrites).Succeeded()))
+    return;
+
+  const ezStringBuilder sSourceFile(sOutputFolder, "/Values.bin");
+  const ezStringBuilder sArchiveFile(sOutputFolder, "/Blocks.ezArchive");
+
+  // spans several blocks, with a partially filled last block
+  const ezUInt32 uiNumValues = 100000;
+  const ezUInt32 uiDataSize = uiNumValues * sizeof(ezUInt32);
+
+  ezDynamicArray<ezUInt32> values;
+  values.SetCountUninitialized(uiNumValues);
+  for (ezUInt32 i = 0; i < uiNumValues; ++i)
+  {
+    values[i] = i;
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Write Archive")
+  {
+    ezOSFile file;
+    if (!EZ_TEST_BOOL(file.Open(sSourceFile, ezFileOpenMode::Write).Succeeded()))
+      return;
+
+    EZ_TEST_BOOL(file.Write(values.GetData(), uiDataSize).Succeeded());
+    file.Close();
+
+    ezArchiveBuilder builder;
+    auto& entry = builder.m_Entries.ExpandAndGetRef();
+    entry.m_sAbsSourcePath = sSourceFile;
+    entry.m_sRelTargetPath = "Data/Values.bin";
+    entry.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd_blocks;
+
+    auto& rawEntry = builder.m_Entries.ExpandAndGetRef();
+    rawEntry.m_sAbsSourcePath = sSourceFile;
+    rawEntry.m_sRelTargetPath = "Data/Raw.bin";
+    rawEntry.m_CompressionMode = ezArchiveCompressionMode::Uncompressed;
+
+    EZ_TEST_BOOL(builder.WriteArchive(sArchiveFile).Succeeded());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Random Access")
+  {
+    ezArchiveReader reader;
+    if (!EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded()))
+      return;
+
+    const ezUInt32 uiEntryIdx = reader.GetArchiveTOC().FindEntry("Data/Values.bin");
+    if (!EZ_TEST_BOOL(uiEntryIdx != ezInvalidIndex))
+      return;
+
+    const ezArchiveEntry& entry = reader.GetArchiveTOC().m_Entries[uiEntryIdx];
+    EZ_TEST_INT(entry.m_uiUncompressedDataSize, uiDataSize);
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    EZ_TEST_BOOL(entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_blocks);
+    EZ_TEST_BOOL(entry.m_uiStoredDataSize < entry.m_uiUncompressedDataSize);
+#  endif
+
+    const ezUInt32 uiBlockSize = ezArchiveUtils::ArchiveBlockSize;
+
+    // offset and size in bytes: inside one block, across a block border, exactly one block, many blocks and the end of the data
+    const ezUInt32 ranges[][2] = {
+      {0, 16},
+      {1000, 4},
+      {uiBlockSize - 8, 16},
+      {uiBlockSize, uiBlockSize},
+      {100, uiDataSize - 200},
+      {uiDataSize - 20, 20},
+    };
+
+    ezDynamicArray<ezUInt32> result;
+
+    for (ezUInt32 r = 0; r < EZ_ARRAY_SIZE(ranges); ++r)
+    {
+      const ezUInt32 uiOffset = ranges[r][0];
+      const ezUInt32 uiSize = ranges[r][1];
+
+      result.SetCount(uiSize / sizeof(ezUInt32));
+      EZ_TEST_INT(reader.ReadEntryData(uiEntryIdx, uiOffset, result.GetByteArrayPtr()), uiSize);
+
+      bool bEqual = true;
+      for (ezUInt32 i = 0; i < result.GetCount(); ++i)
+      {
+        bEqual &= (result[i] == values[uiOffset / sizeof(ezUInt32) + i]);
+      }
+
+      EZ_TEST_BOOL_MSG(bEqual, "Data mismatch for range {} ({} bytes at offset {})", r, uiSize, uiOffset);
+    }
+
+    // reads past the end are clamped
+    result.SetCount(16);
+    EZ_TEST_INT(reader.ReadEntryData(uiEntryIdx, uiDataSize - 8, result.GetByteArrayPtr()), 8);
+    EZ_TEST_INT(result[0], uiNumValues - 2);
+    EZ_TEST_INT(result[1], uiNumValues - 1);
+    EZ_TEST_INT(reader.ReadEntryData(uiEntryIdx, uiDataSize, result.GetByteArrayPtr()), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Mount as Data Dir")
+  {
+    if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchiveFile, "Clear", "blocks", ezDataDirUsage::ReadOnly) == EZ_SUCCESS))
+      return;
+
+    ezFileReader file;
+    if (!EZ_TEST_BOOL(file.Open(":blocks/Data/Values.bin").Succeeded()))
+      return;
+
+    EZ_TEST_INT(file.GetFileSize(), uiDataSize);
+
+    // skip into the middle of a block
+    const ezUInt32 uiSkipValues = 50001;
+    EZ_TEST_INT(file.SkipBytes(uiSkipValues * sizeof(ezUInt32)), uiSkipValues * sizeof(ezUInt32));
+
+    ezUInt32 uiValue = 0;
+    ezUInt32 uiNumMismatches = 0;
+    for (ezUInt32 i = uiSkipValues; i < uiNumValues; ++i)
+    {
+      file >> uiValue;
+      uiNumMismatches += (uiValue != values[i]) ? 1 : 0;
+    }
+
+    EZ_TEST_INT(uiNumMismatches, 0);
+    EZ_TEST_INT(file.ReadBytes(&uiValue, sizeof(ezUInt32)), 0);
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    // compressed data can't be accessed without copying
+    EZ_TEST_BOOL(!file.SupportsZeroCopyReads());
+#  endif
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Zero-Copy Reads")
+  {
+    ezFileReader file;
+    if (!EZ_TEST_BOOL(file.Open(":blocks/Data/Raw.bin").Succeeded()))
+      return;
+
+    if (!EZ_TEST_BOOL(file.SupportsZeroCopyReads()))
+      return;
+
+    ezUInt32 uiFirstValue = 1;
+    file >> uiFirstValue;
+    EZ_TEST_INT(uiFirstValue, 0);
+
+    ezConstByteArrayPtr data = file.ReadBytesZeroCopy(16 * sizeof(ezUInt32));
+    EZ_TEST_INT(data.GetCount(), 16 * sizeof(ezUInt32));
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(data.GetPtr(), reinterpret_cast<const ezUInt8*>(values.GetData() + 1), data.GetCount()));
+
+    // the remaining data is returned in one piece
+    data = file.ReadBytesZeroCopy(uiDataSize);
+    EZ_TEST_INT(data.GetCount(), uiDataSize - 17 * sizeof(ezUInt32));
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(data.GetPtr(), reinterpret_cast<const ezUInt8*>(values.GetData() + 17), data.GetCount()));
+    EZ_TEST_BOOL(file.IsEOF());
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("Clear");
+}
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveDictionary)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveDictionaryTest");
+  sOutputFolder.MakeCleanPath();
+
+  // make sure it is empty
+  ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+  ezOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+  if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "Clear", "output", ezDataDirUsage::AllowWrites).Succeeded()))
+    return;
+
+  const ezStringBuilder sDictArchiveFile(sOutputFolder, "/Dict.ezArchive");
+  const ezStringBuilder sPlainArchiveFile(sOutputFolder, "/Plain.ezArchive");
+
+  // many small, similar files and one file that is too large for the dictionary
+  const ezUInt32 uiNumSmallFiles = 200;
+  ezDynamicArray<ezStringBuilder> contents;
+  contents.SetCount(uiNumSmallFiles + 1);
+
+  for (ezUInt32 i = 0; i < uiNumSmallFiles; ++i)
+  {
+    contents[i].SetFormat("ShaderPermutations = BLEND_MODE_OPAQUE\nBaseTexture = {}\nRoughnessValue = {}\nMetallicValue = {}\nTwoSided = false\n", ezArgU(i * 7919, 8, true, 16), i % 10, i % 3);
+  }
+
+  for (ezUInt32 i = 0; i < 4000; ++i)
+  {
+    contents[uiNumSmallFiles].AppendFormat("Line {} of a large file.\n", i);
+  }
+
+  ezArchiveBuilder dictBuilder;
+  dictBuilder.m_bUseCompressionDictionary = true;
+
+  ezArchiveBuilder plainBuilder;
+
+  for (ezUInt32 i = 0; i < contents.GetCount(); ++i)
+  {
+    ezStringBuilder sFile;
+    sFile.SetFormat("{}/File{}.ezMaterial", sOutputFolder, i);
+
+    ezOSFile file;
+    if (!EZ_TEST_BOOL(file.Open(sFile, ezFileOpenMode::Write).Succeeded()))
+      return;
+
+    EZ_TEST_BOOL(file.Write(contents[i].GetData(), contents[i].GetElementCount()).Succeeded());
+    file.Close();
+
+    for (ezArchiveBuilder* pBuilder : {&dictBuilder, &plainBuilder})
+    {
+      auto& entry = pBuilder->m_Entries.ExpandAndGetRef();
+      entry.m_sAbsSourcePath = sFile;
+      entry.m_sRelTargetPath = ezPathUtils::GetFileNameAndExtension(sFile);
+      entry.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd;
+      entry.m_iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::Average);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Write Archives")
+  {
+    EZ_TEST_BOOL(dictBuilder.WriteArchive(sDictArchiveFile).Succeeded());
+    EZ_TEST_BOOL(plainBuilder.WriteArchive(sPlainArchiveFile).Succeeded());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compression Ratio")
+  {
+    ezArchiveReader dictReader;
+    ezArchiveReader plainReader;
+    if (!EZ_TEST_BOOL(dictReader.OpenArchive(sDictArchiveFile).Succeeded() && plainReader.OpenArchive(sPlainArchiveFile).Succeeded()))
+      return;
+
+    EZ_TEST_BOOL(!dictReader.GetArchiveTOC().m_CompressionDictionary.IsEmpty());
+    EZ_TEST_BOOL(plainReader.GetArchiveTOC().m_CompressionDictionary.IsEmpty());
+
+    ezUInt64 uiDictStoredSize = 0;
+    ezUInt64 uiPlainStoredSize = 0;
+    ezUInt32 uiNumDictEntries = 0;
+
+    for (ezUInt32 i = 0; i < uiNumSmallFiles; ++i)
+    {
+      const ezArchiveEntry& dictEntry = dictReader.GetArchiveTOC().m_Entries[i];
+      uiDictStoredSize += dictEntry.m_uiStoredDataSize;
+      uiNumDictEntries += (dictEntry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_dict) ? 1 : 0;
+
+      uiPlainStoredSize += plainReader.GetArchiveTOC().m_Entries[i].m_uiStoredDataSize;
+    }
+
+    EZ_TEST_INT(uiNumDictEntries, uiNumSmallFiles);
+    EZ_TEST_BOOL(dictReader.GetArchiveTOC().m_Entries[uiNumSmallFiles].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd);
+
+    // the dictionary itself is stored in the TOC
+    EZ_TEST_BOOL(uiDictStoredSize * 2 < uiPlainStoredSize);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read Entries")
+  {
+    ezArchiveReader reader;
+    if (!EZ_TEST_BOOL(reader.OpenArchive(sDictArchiveFile).Succeeded()))
+      return;
+
+    ezDynamicArray<ezUInt8> buffer;
+
+    for (ezUInt32 i = 0; i < contents.GetCount(); ++i)
+    {
+      ezStringBuilder sEntry;
+      sEntry.SetFormat("File{}.ezMaterial", i);
+
+      const ezUInt32 uiEntryIdx = reader.GetArchiveTOC().FindEntry(sEntry);
+      if (!EZ_TEST_BOOL(uiEntryIdx != ezInvalidIndex))
+        return;
+
+      // entries are stored in the original order, even though they were compressed in parallel
+      EZ_TEST_INT(uiEntryIdx, i);
+
+      const ezUInt32 uiSize = contents[i].GetElementCount();
+      buffer.SetCount(uiSize);
+      EZ_TEST_INT(reader.ReadEntryData(uiEntryIdx, 0, buffer.GetArrayPtr()), uiSize);
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(buffer.GetData(), reinterpret_cast<const ezUInt8*>(contents[i].GetData()), uiSize));
+
+      // partial read
+      EZ_TEST_INT(reader.ReadEntryData(uiEntryIdx, 10, buffer.GetArrayPtr().GetSubArray(0, 8)), 8);
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(buffer.GetData(), reinterpret_cast<const ezUInt8*>(contents[i].GetData()) + 10, 8));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Mount as Data Dir")
+  {
+    if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sDictArchiveFile, "Clear", "dict", ezDataDirUsage::ReadOnly) == EZ_SUCCESS))
+      return;
+
+    ezFileReader file;
+    if (!EZ_TEST_BOOL(file.Open(":dict/File42.ezMaterial").Succeeded()))
+      return;
+
+    EZ_TEST_INT(file.GetFileSize(), contents[42].GetElementCount());
+
+    // the decompressed data is kept by the data directory reader and can be accessed without another copy
+    EZ_TEST_BOOL(file.SupportsZeroCopyReads());
+
+    ezConstByteArrayPtr data = file.ReadBytesZeroCopy(contents[42].GetElementCount());
+    EZ_TEST_INT(data.GetCount(), contents[42].GetElementCount());
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(data.GetPtr(), reinterpret_cast<const ezUInt8*>(contents[42].GetData()), data.GetCount()));
+
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("Clear");
+}
+
+#  endif
+
+#endif
@@ -4,6 +4,7 @@
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 #if EZ_ENABLED(EZ_SUPPORTS_LONG_PATHS)
 #  define LongPath                                                                                                                                   \
@@ -205,6 +206,100 @@ Only concrete and clocks.\n\
     }
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Exists File (External Changes)")
+  {
+    // files that are added or removed without going through the file system must be found right away, e.g. the output of another process
+    ezStringBuilder sAbs = sOutputFolder1Resolved;
+    sAbs.AppendPath("ExternalFile.txt");
+
+    ezStringBuilder sResolved;
+
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":output1/ExternalFile.txt"));
+    EZ_TEST_BOOL(ezFileSystem::ResolvePath("ExternalFile.txt", &sResolved, nullptr).Failed());
+
+    {
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sAbs, ezFileOpenMode::Write).Succeeded());
+      file.Close();
+    }
+
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile(":output1/ExternalFile.txt"));
+    EZ_TEST_BOOL(ezFileSystem::ResolvePath("ExternalFile.txt", &sResolved, nullptr).Succeeded());
+    EZ_TEST_STRING(sResolved, sAbs);
+
+    ezUInt32 uiNumFound = 0;
+    ezMutex resultMutex;
+    auto lookup = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        const bool bFound = ezFileSystem::ExistsFile("ExternalFile.txt") && !ezFileSystem::ExistsFile("DoesNotExist.txt");
+
+        EZ_LOCK(resultMutex);
+        uiNumFound += bFound ? 1 : 0;
+      }
+    };
+    ezTaskSystem::ParallelForIndexed(0u, 100u, lookup, "ExistsFile");
+    EZ_TEST_INT(uiNumFound, 100);
+
+    EZ_TEST_BOOL(ezOSFile::DeleteFile(sAbs).Succeeded());
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":output1/ExternalFile.txt"));
+    EZ_TEST_BOOL(ezFileSystem::ResolvePath("ExternalFile.txt", &sResolved, nullptr).Failed());
+  }
+
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Exists File (File Cache)")
+  {
+    ezDataDirectory::FolderType::s_bCacheExistingFiles = true;
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder1, "FileCache", "cached", ezDataDirUsage::AllowWrites) == EZ_SUCCESS);
+    ezDataDirectory::FolderType::s_bCacheExistingFiles = false;
+
+    ezStringBuilder sAbs = sOutputFolder1Resolved;
+    sAbs.AppendPath("CachedFile.txt");
+
+    // with the cache, misses are remembered and the directory watcher reports external changes asynchronously, so give it some time
+    auto WaitForExistsFile = [](ezStringView sFile, bool bExpected) -> bool
+    {
+      const ezTime tTimeout = ezTime::Now() + ezTime::MakeFromSeconds(5);
+
+      while (ezFileSystem::ExistsFile(sFile) != bExpected)
+      {
+        if (ezTime::Now() > tTimeout)
+          return false;
+
+        ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(10));
+      }
+
+      return true;
+    };
+
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":cached/CachedFile.txt"));
+
+    {
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sAbs, ezFileOpenMode::Write).Succeeded());
+      file.Close();
+    }
+
+    EZ_TEST_BOOL(WaitForExistsFile(":cached/CachedFile.txt", true));
+
+    EZ_TEST_BOOL(ezOSFile::DeleteFile(sAbs).Succeeded());
+    EZ_TEST_BOOL(WaitForExistsFile(":cached/CachedFile.txt", false));
+
+    // changes made through the data directory update the cache immediately
+    {
+      ezFileWriter file;
+      EZ_TEST_BOOL(file.Open(":cached/CachedFile.txt") == EZ_SUCCESS);
+    }
+
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile(":cached/CachedFile.txt"));
+    ezFileSystem::DeleteFile(":cached/CachedFile.txt");
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":cached/CachedFile.txt"));
+
+    EZ_TEST_INT(ezFileSystem::RemoveDataDirectoryGroup("FileCache"), 1);
+  }
+#endif
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetFileStats")
   {
     const char* szPath = ":output1/" LongPath "/FileSystemTest.txt";
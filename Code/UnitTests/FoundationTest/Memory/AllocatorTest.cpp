@@ -1,8 +1,11 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Memory/LargeBlockAllocator.h>
 #include <Foundation/Memory/LinearAllocator.h>
+#include <Foundation/Memory/MemoryTracker.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 struct alignas(EZ_ALIGNMENT_MINIMUM) NonAlignedVector
 {
@@ -242,4 +245,67 @@ EZ_CREATE_SIMPLE_TEST(Memory, Allocator)
 
     EZ_TEST_BOOL(ezConstructionCounter::HasDestructed(50));
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Sampling")
+  {
+    ezAllocatorWithPolicy<ezAllocPolicyHeap, ezAllocatorTrackingMode::Sampling> allocator("TestSamplingAllocator", ezFoundation::GetDefaultAllocator());
+
+    // sample practically every allocation
+    const ezUInt32 uiPrevInterval = ezMemoryTracker::GetSamplingInterval();
+    ezMemoryTracker::SetSamplingInterval(1);
+
+    const ezMemoryTracker::SamplingStats statsBefore = ezMemoryTracker::GetSamplingStats();
+
+    ezDynamicArray<void*> allocations;
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      allocations.PushBack(allocator.Allocate(1024, 16));
+    }
+
+    const ezMemoryTracker::SamplingStats statsAllocated = ezMemoryTracker::GetSamplingStats();
+    EZ_TEST_INT(statsAllocated.m_uiNumLiveSamples - statsBefore.m_uiNumLiveSamples, 1000);
+    EZ_TEST_INT(statsAllocated.m_uiSampledLiveBytes - statsBefore.m_uiSampledLiveBytes, 1000 * 1024);
+    EZ_TEST_BOOL(statsAllocated.m_uiEstimatedLiveBytes >= statsAllocated.m_uiSampledLiveBytes);
+    EZ_TEST_BOOL(statsAllocated.m_uiNumDistinctStackTraces > 0);
+
+    // free half of the allocations on other threads
+    auto freeAllocations = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        allocator.Deallocate(allocations[i]);
+      }
+    };
+
+    ezTaskSystem::ParallelForIndexed(0u, 500u, freeAllocations, "FreeSampledAllocations");
+
+    const ezMemoryTracker::SamplingStats statsFreed = ezMemoryTracker::GetSamplingStats();
+    EZ_TEST_INT(statsFreed.m_uiNumLiveSamples - statsBefore.m_uiNumLiveSamples, 500);
+
+    ezDefaultMemoryStreamStorage storage;
+    {
+      ezMemoryStreamWriter writer(&storage);
+      EZ_TEST_BOOL(ezMemoryTracker::WriteHeapProfile(writer).Succeeded());
+    }
+
+    ezStringBuilder sProfile;
+    {
+      ezMemoryStreamReader reader(&storage);
+      sProfile.ReadAll(reader);
+    }
+
+    EZ_TEST_BOOL(sProfile.StartsWith("heap profile: "));
+    EZ_TEST_BOOL(sProfile.FindSubString("@ heap_v2/1\n") != nullptr);
+    EZ_TEST_BOOL(sProfile.FindSubString("MAPPED_LIBRARIES:") != nullptr);
+
+    for (ezUInt32 i = 500; i < allocations.GetCount(); ++i)
+    {
+      allocator.Deallocate(allocations[i]);
+    }
+
+    const ezMemoryTracker::SamplingStats statsAfter = ezMemoryTracker::GetSamplingStats();
+    EZ_TEST_INT(statsAfter.m_uiNumLiveSamples, statsBefore.m_uiNumLiveSamples);
+
+    ezMemoryTracker::SetSamplingInterval(uiPrevInterval);
+  }
 }
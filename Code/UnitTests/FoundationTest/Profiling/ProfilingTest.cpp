@@ -1,9 +1,17 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Profiling/ProfilingStream.h>
+#include <Foundation/Profiling/ProfilingUtils.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Time/Stopwatch.h>
 
 namespace
 {
@@ -21,6 +29,54 @@ namespace
       ezLog::Info("Profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
     }
   }
+
+  class ContendingThread : public ezThread
+  {
+  public:
+    ContendingThread()
+      : ezThread("Contending Thread")
+    {
+    }
+
+    ezMutex* m_pMutex = nullptr;
+    ezAtomicBool m_bStarted;
+    ezAtomicBool m_bLocked;
+    ezAtomicBool m_bExit;
+
+    virtual ezUInt32 Run() override
+    {
+      m_bStarted = true;
+
+      {
+        EZ_LOCK(*m_pMutex);
+      }
+
+      m_bLocked = true;
+
+      // the wait must be reported at the end of the frame, without this thread recording anything else
+      while (!m_bExit)
+      {
+        ezThreadUtils::YieldTimeSlice();
+      }
+
+      return 0;
+    }
+  };
+
+  class ShortLivedThread : public ezThread
+  {
+  public:
+    ShortLivedThread()
+      : ezThread("Short Lived Thread")
+    {
+    }
+
+    virtual ezUInt32 Run() override
+    {
+      EZ_PROFILE_SCOPE("Short lived scope");
+      return 0;
+    }
+  };
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Profiling);
@@ -52,4 +108,196 @@ EZ_CREATE_SIMPLE_TEST(Profiling, Profiling)
 
     WriteOutProfilingCapture(":output/profilingScopes.json");
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Streaming capture")
+  {
+    ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(outputPath.GetData(), "test", "output", ezDataDirUsage::AllowWrites) == EZ_SUCCESS);
+
+    // record every scope, no matter how short
+    ezProfilingSystem::SetDiscardThreshold(ezTime::MakeZero());
+
+    constexpr ezUInt32 uiNumScopes = 100000;
+
+    auto recordScopes = []()
+    {
+      for (ezUInt32 i = 0; i < uiNumScopes; ++i)
+      {
+        EZ_PROFILE_SCOPE("Streamed scope");
+      }
+    };
+
+    ezStopwatch sw;
+    recordScopes();
+    const ezTime tWithoutStream = sw.Checkpoint();
+
+    EZ_TEST_BOOL(ezProfilingStream::StartCapture(":output/profilingStream.ezProfStream").Succeeded());
+    EZ_TEST_BOOL(ezProfilingStream::IsCapturing());
+
+    // only one capture at a time
+    EZ_TEST_BOOL(ezProfilingStream::StartCapture(":output/profilingStream2.ezProfStream").Failed());
+
+    sw.Checkpoint();
+    recordScopes();
+    const ezTime tWithStream = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u scopes without streaming: %.2fms, with streaming: %.2fms", uiNumScopes, tWithoutStream.GetMilliseconds(), tWithStream.GetMilliseconds());
+
+    ezProfilingSystem::StartNewFrame();
+
+    // events from many threads, with names that only exist for a moment
+    auto recordDynamicScopes = [](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      ezStringBuilder sName;
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        sName.SetFormat("Dynamic scope {}", i % 10);
+        EZ_PROFILE_SCOPE(sName);
+      }
+    };
+
+    ezTaskSystem::ParallelForIndexed(0u, 1000u, recordDynamicScopes, "RecordDynamicScopes");
+
+    // the events of threads that exit during the capture are handed over when they exit
+    {
+      ShortLivedThread thread;
+      thread.Start();
+      thread.Join();
+    }
+
+    ezProfilingSystem::StartNewFrame();
+
+    EZ_TEST_BOOL(ezProfilingStream::StopCapture().Succeeded());
+    EZ_TEST_BOOL(!ezProfilingStream::IsCapturing());
+
+    const ezProfilingStream::Stats stats = ezProfilingStream::GetStats();
+    EZ_TEST_BOOL(stats.m_uiNumEvents >= uiNumScopes + 1000 + 2);
+    EZ_TEST_BOOL(stats.m_uiNumNames >= 11);
+    EZ_TEST_BOOL(stats.m_uiNumBytes < stats.m_uiNumEvents * sizeof(ezProfilingSystem::CPUScope) / 4);
+
+    ezProfilingSystem::SetDiscardThreshold(ezTime::MakeFromMilliseconds(0.1));
+
+    EZ_TEST_BOOL(ezProfilingUtils::ConvertStreamingCapture(":output/profilingStream.ezProfStream", ":output/profilingStream.json").Succeeded());
+
+    ezStringBuilder sJson;
+    {
+      ezFileReader reader;
+      EZ_TEST_BOOL(reader.Open(":output/profilingStream.json").Succeeded());
+      sJson.ReadAll(reader);
+    }
+
+    EZ_TEST_BOOL(sJson.StartsWith("{\"traceEvents\":["));
+    EZ_TEST_BOOL(sJson.FindSubString("\"Streamed scope\"") != nullptr);
+    EZ_TEST_BOOL(sJson.FindSubString("\"Dynamic scope 9\"") != nullptr);
+    EZ_TEST_BOOL(sJson.FindSubString("\"Short lived scope\"") != nullptr);
+    EZ_TEST_BOOL(sJson.FindSubString("\"Frame ") != nullptr);
+    EZ_TEST_BOOL(sJson.FindSubString("\"Main Thread\"") != nullptr);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Counters, memory and mutex events")
+  {
+    ezCVarBool* pMutexWaits = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("Profiling.MutexWaits"));
+    ezCVarBool* pMemoryCounters = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("Profiling.MemoryCounters"));
+    if (!EZ_TEST_BOOL(pMutexWaits != nullptr && pMemoryCounters != nullptr))
+      return;
+
+    *pMutexWaits = true;
+    *pMemoryCounters = true;
+
+    ezProfilingSystem::Clear();
+
+    EZ_PROFILE_COUNTER("Test Counter", 42);
+    ezProfilingSystem::SetCounter("Test Bytes", 1024.0, ezProfilingSystem::CounterType::Bytes);
+
+    {
+      // large enough to be recorded as a memory event with the default threshold
+      ezDynamicArray<ezUInt8> largeAllocation;
+      largeAllocation.SetCountUninitialized(4 * 1024 * 1024);
+    }
+
+    ezProfilingSystem::ProfilingData profilingData;
+
+    {
+      ezMutex mutex;
+      ContendingThread thread;
+      thread.m_pMutex = &mutex;
+
+      {
+        EZ_LOCK(mutex);
+        thread.Start();
+
+        while (!thread.m_bStarted)
+        {
+          ezThreadUtils::YieldTimeSlice();
+        }
+
+        ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(10));
+      }
+
+      while (!thread.m_bLocked)
+      {
+        ezThreadUtils::YieldTimeSlice();
+      }
+
+      ezProfilingSystem::StartNewFrame();
+      ezProfilingSystem::Capture(profilingData);
+
+      thread.m_bExit = true;
+      thread.Join();
+    }
+
+    bool bFoundCounter = false;
+    bool bFoundMutexCounter = false;
+    for (const ezProfilingSystem::Counter& counter : profilingData.m_Counters)
+    {
+      if (ezStringUtils::IsEqual(counter.m_szName, "Test Counter"))
+      {
+        bFoundCounter = true;
+        EZ_TEST_DOUBLE(counter.m_fValue, 42.0, 0.0);
+        EZ_TEST_BOOL(counter.m_Type == ezProfilingSystem::CounterType::Value);
+      }
+      else if (ezStringUtils::IsEqual(counter.m_szName, "Mutex Wait Time"))
+      {
+        bFoundMutexCounter = true;
+        EZ_TEST_BOOL(counter.m_Type == ezProfilingSystem::CounterType::Milliseconds);
+      }
+    }
+
+    EZ_TEST_BOOL(bFoundCounter);
+    EZ_TEST_BOOL(bFoundMutexCounter);
+
+    bool bFoundAllocation = false;
+    bool bFoundDeallocation = false;
+    for (const ezProfilingSystem::MemoryEvent& e : profilingData.m_MemoryEvents)
+    {
+      if (e.m_uiSize >= 4 * 1024 * 1024)
+      {
+        bFoundAllocation |= e.m_bAllocation;
+        bFoundDeallocation |= !e.m_bAllocation;
+      }
+    }
+
+    EZ_TEST_BOOL(bFoundAllocation);
+    EZ_TEST_BOOL(bFoundDeallocation);
+
+    ezDefaultMemoryStreamStorage storage;
+    {
+      ezMemoryStreamWriter writer(&storage);
+      EZ_TEST_BOOL(profilingData.Write(writer).Succeeded());
+    }
+
+    ezStringBuilder sJson;
+    {
+      ezMemoryStreamReader reader(&storage);
+      sJson.ReadAll(reader);
+    }
+
+    EZ_TEST_BOOL(sJson.FindSubString("\"ph\":\"C\"") != nullptr);
+    EZ_TEST_BOOL(sJson.FindSubString("\"Test Bytes\"") != nullptr);
+    EZ_TEST_BOOL(sJson.FindSubString("\"Mutex Wait\"") != nullptr);
+    EZ_TEST_BOOL(sJson.FindSubString("\"Allocation\"") != nullptr);
+
+    *pMutexWaits = false;
+    *pMemoryCounters = false;
+  }
 }
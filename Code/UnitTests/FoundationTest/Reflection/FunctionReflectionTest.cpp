@@ -288,6 +288,14 @@ struct FunctionTest
 
   static int StaticFunction2() { return 42; }
 
+  ezVec3 TypedFunction(float f, const ezVec3& v, ezString s) const
+  {
+    EZ_TEST_STRING(s, "Typed");
+    return v * f;
+  }
+
+  void TypedVoidFunction(ezInt32 i) { m_values.PushBack(i); }
+
   bool m_bPtrAreNull = false;
   ezDynamicArray<ezVariant> m_values;
 };
@@ -813,6 +821,48 @@ EZ_CREATE_SIMPLE_TEST(Reflection, Functions)
     EZ_TEST_BOOL(ret == 42);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Typed Execution")
+  {
+    FunctionTest test;
+
+    ezFunctionProperty<decltype(&FunctionTest::StandardTypeFunction)> outArgsFunc("", &FunctionTest::StandardTypeFunction);
+    EZ_TEST_BOOL(!outArgsFunc.SupportsTypedExecution());
+
+    ezFunctionProperty<decltype(&FunctionTest::TypedFunction)> funccall("", &FunctionTest::TypedFunction);
+    EZ_TEST_BOOL(funccall.SupportsTypedExecution());
+    {
+      float f = 2.0f;
+      ezVec3 v(1, 2, 3);
+      ezString s = "Typed";
+      const void* args[] = {&f, &v, &s};
+
+      ezVec3 ret = ezVec3::MakeZero();
+      funccall.ExecuteTyped(&test, args, &ret);
+      EZ_TEST_VEC3(ret, ezVec3(2, 4, 6), 0.0f);
+
+      // The return value may be discarded
+      funccall.ExecuteTyped(&test, args, nullptr);
+    }
+
+    ezFunctionProperty<decltype(&FunctionTest::TypedVoidFunction)> funccall2("", &FunctionTest::TypedVoidFunction);
+    EZ_TEST_BOOL(funccall2.SupportsTypedExecution());
+    {
+      ezInt32 i = 7;
+      const void* args[] = {&i};
+      funccall2.ExecuteTyped(&test, args, nullptr);
+      EZ_TEST_INT(test.m_values.GetCount(), 1);
+      EZ_TEST_BOOL(test.m_values[0] == 7);
+    }
+
+    ezFunctionProperty<decltype(&FunctionTest::StaticFunction2)> funccall3("", &FunctionTest::StaticFunction2);
+    EZ_TEST_BOOL(funccall3.SupportsTypedExecution());
+    {
+      int ret = 0;
+      funccall3.ExecuteTyped(nullptr, {}, &ret);
+      EZ_TEST_INT(ret, 42);
+    }
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Constructor Functions - StandardTypes")
   {
     ezConstructorFunctionProperty<ezVec4, float, float, float, float> funccall;
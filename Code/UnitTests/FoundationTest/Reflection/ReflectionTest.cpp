@@ -2,8 +2,13 @@
 
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Reflection/ReflectionUtils.h>
+#include <Foundation/Serialization/BinarySerializer.h>
+#include <Foundation/Serialization/GraphPatch.h>
+#include <Foundation/Serialization/ReflectionLayout.h>
 #include <Foundation/Serialization/ReflectionSerializer.h>
+#include <Foundation/Serialization/RttiConverter.h>
 #include <FoundationTest/Reflection/ReflectionTestClasses.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
 
 
 template <typename T>
@@ -44,37 +49,40 @@ void TestSerialization(const T& source)
     }
   }
 
-  ezDefaultMemoryStreamStorage StreamStorageBinary;
-  EZ_TEST_BLOCK(ezTestBlock::Enabled, "WriteObjectToBinary")
+  for (ezReflectionSerializer::BinaryFormat format : {ezReflectionSerializer::BinaryFormat::Portable, ezReflectionSerializer::BinaryFormat::Compiled})
   {
-    ezMemoryStreamWriter FileOut(&StreamStorageBinary);
+    ezDefaultMemoryStreamStorage StreamStorageBinary;
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "WriteObjectToBinary")
+    {
+      ezMemoryStreamWriter FileOut(&StreamStorageBinary);
 
-    ezReflectionSerializer::WriteObjectToBinary(FileOut, ezGetStaticRTTI<T>(), &source);
-  }
+      ezReflectionSerializer::WriteObjectToBinary(FileOut, ezGetStaticRTTI<T>(), &source, format);
+    }
 
-  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReadObjectPropertiesFromBinary")
-  {
-    ezMemoryStreamReader FileIn(&StreamStorageBinary);
-    T data;
-    ezReflectionSerializer::ReadObjectPropertiesFromBinary(FileIn, *ezGetStaticRTTI<T>(), &data);
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReadObjectPropertiesFromBinary")
+    {
+      ezMemoryStreamReader FileIn(&StreamStorageBinary);
+      T data;
+      ezReflectionSerializer::ReadObjectPropertiesFromBinary(FileIn, *ezGetStaticRTTI<T>(), &data);
 
-    EZ_TEST_BOOL(data == source);
-  }
+      EZ_TEST_BOOL(data == source);
+    }
 
-  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReadObjectFromBinary")
-  {
-    ezMemoryStreamReader FileIn(&StreamStorageBinary);
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReadObjectFromBinary")
+    {
+      ezMemoryStreamReader FileIn(&StreamStorageBinary);
 
-    const ezRTTI* pRtti;
-    void* pObject = ezReflectionSerializer::ReadObjectFromBinary(FileIn, pRtti);
+      const ezRTTI* pRtti;
+      void* pObject = ezReflectionSerializer::ReadObjectFromBinary(FileIn, pRtti);
 
-    T& c2 = *((T*)pObject);
+      T& c2 = *((T*)pObject);
 
-    EZ_TEST_BOOL(c2 == source);
+      EZ_TEST_BOOL(c2 == source);
 
-    if (pObject)
-    {
-      pRtti->GetAllocator()->Deallocate(pObject);
+      if (pObject)
+      {
+        pRtti->GetAllocator()->Deallocate(pObject);
+      }
     }
   }
 
@@ -237,6 +245,47 @@ EZ_CREATE_SIMPLE_TEST(Reflection, Types)
     EZ_TEST_BOOL(pClass == pClass2);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindTypeByName - All Types")
+  {
+    ezUInt32 uiNumTypes = 0;
+    ezUInt32 uiNumFound = 0;
+
+    ezRTTI::ForEachType([&](const ezRTTI* pRtti)
+      {
+        ++uiNumTypes;
+
+        if (ezRTTI::FindTypeByNameHash(pRtti->GetTypeNameHash()) == pRtti && ezRTTI::FindTypeByName(pRtti->GetTypeName()) == pRtti)
+          ++uiNumFound;
+      });
+
+    EZ_TEST_INT(uiNumFound, uiNumTypes);
+    EZ_TEST_BOOL(ezRTTI::FindTypeByName("ezTypeThatDoesNotExist") == nullptr);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindTypeByName - Dynamic Types")
+  {
+    EZ_TEST_BOOL(ezRTTI::FindTypeByName("ezDynamicLookupTestType") == nullptr);
+
+    {
+      ezRTTI dynamicType("ezDynamicLookupTestType", nullptr, 0, 1, ezVariantType::Invalid, ezTypeFlags::Class, nullptr, {}, {}, {}, {}, {}, nullptr);
+
+      EZ_TEST_BOOL(ezRTTI::FindTypeByName("ezDynamicLookupTestType") == &dynamicType);
+      EZ_TEST_BOOL(ezRTTI::FindTypeByName("ezTestStruct") == ezGetStaticRTTI<ezTestStruct>());
+
+      // while plugins change, lookups don't rebuild the lookup table, but still find every type
+      ezPlugin::BeginPluginChanges();
+      EZ_TEST_BOOL(ezRTTI::FindTypeByName("ezDynamicLookupTestType") == &dynamicType);
+      EZ_TEST_BOOL(ezRTTI::FindTypeByName("ezTestStruct") == ezGetStaticRTTI<ezTestStruct>());
+      ezPlugin::EndPluginChanges();
+
+      EZ_TEST_BOOL(ezRTTI::FindTypeByName("ezDynamicLookupTestType") == &dynamicType);
+      EZ_TEST_BOOL(ezRTTI::FindTypeByName("ezTestStruct") == ezGetStaticRTTI<ezTestStruct>());
+    }
+
+    EZ_TEST_BOOL(ezRTTI::FindTypeByName("ezDynamicLookupTestType") == nullptr);
+    EZ_TEST_BOOL(ezRTTI::FindTypeByName("ezTestStruct") == ezGetStaticRTTI<ezTestStruct>());
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetProperties")
   {
     {
@@ -594,6 +643,223 @@ EZ_CREATE_SIMPLE_TEST(Reflection, MemberProperties)
   }
 }
 
+namespace
+{
+  /// Converts the length from centimeters to meters.
+  class ezTestVersionedStructPatch_1_2 : public ezGraphPatch
+  {
+  public:
+    ezTestVersionedStructPatch_1_2()
+      : ezGraphPatch("ezTestVersionedStruct", 2)
+    {
+    }
+
+    virtual void Patch(ezGraphPatchContext& ref_context, ezAbstractObjectGraph* pGraph, ezAbstractObjectNode* pNode) const override
+    {
+      if (auto* pLength = pNode->FindProperty("Length"))
+      {
+        pNode->ChangeProperty("Length", pLength->m_Value.ConvertTo<float>() * 0.01f);
+      }
+    }
+  };
+
+  ezTestVersionedStructPatch_1_2 g_TestVersionedStructPatch_1_2;
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Reflection, Layout)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Build")
+  {
+    ezTestStruct data;
+    const ezReflectionLayout* pLayout = ezReflectionLayout::GetLayout(ezGetStaticRTTI<ezTestStruct>(), &data);
+
+    EZ_TEST_BOOL(pLayout == ezReflectionLayout::GetLayout(ezGetStaticRTTI<ezTestStruct>(), &data));
+    EZ_TEST_BOOL(pLayout->CanSerialize());
+
+    // the read-only "Vector" property is not part of the layout
+    EZ_TEST_INT(pLayout->GetFields().GetCount(), 8);
+
+    // "Float" and "UInt8" directly follow each other in memory and are copied together
+    const ezReflectionLayout::Operation& firstOp = pLayout->GetOperations()[0];
+    EZ_TEST_BOOL(firstOp.m_Type == ezReflectionLayout::FieldType::PlainData);
+    EZ_TEST_INT(firstOp.m_uiNumFields, 2);
+    EZ_TEST_INT(firstOp.m_uiSize, sizeof(float) + sizeof(ezUInt8));
+    EZ_TEST_BOOL(pLayout->GetOperations().GetCount() < pLayout->GetFields().GetCount());
+
+    ezTestClass1 class1;
+    const ezReflectionLayout* pClassLayout = ezReflectionLayout::GetLayout(ezGetStaticRTTI<ezTestClass1>(), &class1);
+    EZ_TEST_BOOL(pClassLayout->CanSerialize());
+    EZ_TEST_BOOL(pClassLayout->GetFields()[0].m_Type == ezReflectionLayout::FieldType::Nested);
+    EZ_TEST_BOOL(pClassLayout->GetFields()[0].m_pNestedLayout == pLayout);
+
+    // owned pointers are only supported by Clone()
+    ezTestPtr ptr;
+    EZ_TEST_BOOL(!ezReflectionLayout::GetLayout(ezGetStaticRTTI<ezTestPtr>(), &ptr)->CanSerialize());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Different Schema")
+  {
+    ezTestStruct data;
+    data.m_fFloat1 = 5.5f;
+    data.m_UInt8 = 42;
+
+    ezDefaultMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezReflectionSerializer::WriteObjectToBinary(writer, ezGetStaticRTTI<ezTestStruct>(), &data, ezReflectionSerializer::BinaryFormat::Compiled);
+
+    // the data of another root type isn't read directly, matching properties are converted to the types of ezTestStruct3, unknown ones are skipped
+    ezTestStruct3 data3;
+    ezMemoryStreamReader reader(&storage);
+    ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *ezGetStaticRTTI<ezTestStruct3>(), &data3);
+
+    EZ_TEST_DOUBLE(data3.m_fFloat1, 5.5, 0.0);
+    EZ_TEST_INT(data3.m_UInt8, 42);
+    EZ_TEST_INT(data3.GetIntPublic(), 2);
+    EZ_TEST_BOOL(reader.GetReadPosition() == storage.GetStorageSize64());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Outdated Type Version")
+  {
+    ezTestVersionedStruct data;
+    data.m_fLength = 150.0f;
+    data.m_iCount = 3;
+
+    ezDefaultMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezReflectionSerializer::WriteObjectToBinary(writer, ezGetStaticRTTI<ezTestVersionedStruct>(), &data, ezReflectionSerializer::BinaryFormat::Compiled);
+
+    {
+      ezTestVersionedStruct data2;
+      ezMemoryStreamReader reader(&storage);
+      ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *ezGetStaticRTTI<ezTestVersionedStruct>(), &data2);
+
+      EZ_TEST_FLOAT(data2.m_fLength, 150.0f, 0.0f);
+      EZ_TEST_INT(data2.m_iCount, 3);
+    }
+
+    // pretend the data was written with version 1 of the type, the stored type version directly follows the type name
+    {
+      const ezStringView sTypeName = ezGetStaticRTTI<ezTestVersionedStruct>()->GetTypeName();
+      ezArrayPtr<ezUInt8> bytes = storage.GetContiguousMemoryRange(0);
+
+      ezUInt32 uiVersionOffset = ezInvalidIndex;
+      for (ezUInt32 i = 0; i + sTypeName.GetElementCount() + sizeof(ezUInt32) <= bytes.GetCount(); ++i)
+      {
+        if (ezMemoryUtils::RawByteCompare(bytes.GetPtr() + i, sTypeName.GetStartPointer(), sTypeName.GetElementCount()) == 0)
+        {
+          uiVersionOffset = i + sTypeName.GetElementCount();
+          break;
+        }
+      }
+
+      if (!EZ_TEST_BOOL(uiVersionOffset != ezInvalidIndex))
+        return;
+
+      const ezUInt32 uiOldVersion = 1;
+      ezMemoryUtils::RawByteCopy(bytes.GetPtr() + uiVersionOffset, &uiOldVersion, sizeof(uiOldVersion));
+    }
+
+    // outdated data goes through the object graph, so that the graph patches are applied
+    {
+      ezTestVersionedStruct data2;
+      ezMemoryStreamReader reader(&storage);
+      ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *ezGetStaticRTTI<ezTestVersionedStruct>(), &data2);
+
+      EZ_TEST_FLOAT(data2.m_fLength, 1.5f, 0.0001f);
+      EZ_TEST_INT(data2.m_iCount, 3);
+      EZ_TEST_BOOL(reader.GetReadPosition() == storage.GetStorageSize64());
+    }
+
+    {
+      ezMemoryStreamReader reader(&storage);
+      const ezRTTI* pRtti = nullptr;
+      ezTestVersionedStruct* pObject = static_cast<ezTestVersionedStruct*>(ezReflectionSerializer::ReadObjectFromBinary(reader, pRtti));
+
+      EZ_TEST_BOOL(pRtti == ezGetStaticRTTI<ezTestVersionedStruct>());
+      if (EZ_TEST_BOOL(pObject != nullptr))
+      {
+        EZ_TEST_FLOAT(pObject->m_fLength, 1.5f, 0.0001f);
+        EZ_TEST_INT(pObject->m_iCount, 3);
+        pRtti->GetAllocator()->Deallocate(pObject);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Different Platform")
+  {
+    ezTestStruct data;
+    data.m_fFloat1 = 5.5f;
+
+    ezDefaultMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezReflectionSerializer::WriteObjectToBinary(writer, ezGetStaticRTTI<ezTestStruct>(), &data, ezReflectionSerializer::BinaryFormat::Compiled);
+
+    // the platform byte follows the format tag and version, data of another platform is rejected instead of being copied into the object
+    ezArrayPtr<ezUInt8> bytes = storage.GetContiguousMemoryRange(0);
+    bytes[5] ^= 0x80;
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("different memory layout", ezLogMsgType::ErrorMsg);
+
+    ezMemoryStreamReader reader(&storage);
+    const ezRTTI* pRtti = nullptr;
+    EZ_TEST_BOOL(ezReflectionSerializer::ReadObjectFromBinary(reader, pRtti) == nullptr);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Portable Format")
+  {
+    ezTestClass1 data;
+    data.m_Color = ezColor::Crimson;
+    data.m_Struct.m_UInt8 = 17;
+
+    // by default the layout independent object graph format is written, even if the type supports the compiled format
+    ezDefaultMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezReflectionSerializer::WriteObjectToBinary(writer, ezGetStaticRTTI<ezTestClass1>(), &data);
+
+    ezArrayPtr<ezUInt8> bytes = storage.GetContiguousMemoryRange(0);
+    EZ_TEST_BOOL(bytes.GetCount() < 4 || ezMemoryUtils::RawByteCompare(bytes.GetPtr(), "EZRL", 4) != 0);
+
+    ezTestClass1 data2;
+    ezMemoryStreamReader reader(&storage);
+    ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *ezGetStaticRTTI<ezTestClass1>(), &data2);
+    EZ_TEST_BOOL(data2 == data);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Object Graph Data")
+  {
+    ezTestClass1 data;
+    data.m_Color = ezColor::Crimson;
+    data.m_Struct.m_UInt8 = 17;
+
+    // data written in the object graph format can still be read
+    ezDefaultMemoryStreamStorage storage;
+    {
+      ezAbstractObjectGraph graph;
+      ezRttiConverterContext context;
+      ezRttiConverterWriter conv(&graph, &context, false, true);
+
+      context.RegisterObject(ezUuid::MakeUuid(), ezGetStaticRTTI<ezTestClass1>(), &data);
+      conv.AddObjectToGraph(ezGetStaticRTTI<ezTestClass1>(), &data, "root");
+
+      ezMemoryStreamWriter writer(&storage);
+      ezAbstractGraphBinarySerializer::Write(writer, &graph);
+    }
+
+    ezMemoryStreamReader reader(&storage);
+    const ezRTTI* pRtti = nullptr;
+    ezTestClass1* pObject = static_cast<ezTestClass1*>(ezReflectionSerializer::ReadObjectFromBinary(reader, pRtti));
+
+    EZ_TEST_BOOL(pRtti == ezGetStaticRTTI<ezTestClass1>());
+    if (EZ_TEST_BOOL(pObject != nullptr))
+    {
+      EZ_TEST_BOOL(*pObject == data);
+      pRtti->GetAllocator()->Deallocate(pObject);
+    }
+  }
+}
+
 
 EZ_CREATE_SIMPLE_TEST(Reflection, Enum)
 {
@@ -58,6 +58,17 @@ EZ_BEGIN_STATIC_REFLECTED_TYPE(ezTestStruct3, ezNoBase, 71, ezRTTIDefaultAllocat
 }
 EZ_END_STATIC_REFLECTED_TYPE;
 
+EZ_BEGIN_STATIC_REFLECTED_TYPE(ezTestVersionedStruct, ezNoBase, 2, ezRTTIDefaultAllocator<ezTestVersionedStruct>)
+{
+  EZ_BEGIN_PROPERTIES
+  {
+    EZ_MEMBER_PROPERTY("Length", m_fLength),
+    EZ_MEMBER_PROPERTY("Count", m_iCount),
+  }
+  EZ_END_PROPERTIES;
+}
+EZ_END_STATIC_REFLECTED_TYPE;
+
 EZ_BEGIN_STATIC_REFLECTED_TYPE(ezTypedObjectStruct, ezNoBase, 1, ezRTTIDefaultAllocator<ezTypedObjectStruct>)
 {
   EZ_BEGIN_PROPERTIES
@@ -151,6 +151,14 @@ private:
 
 EZ_DECLARE_REFLECTABLE_TYPE(EZ_NO_LINKAGE, ezTestStruct3);
 
+struct ezTestVersionedStruct
+{
+  float m_fLength = 0.0f; ///< In meters since version 2, in centimeters before.
+  ezInt32 m_iCount = 0;
+};
+
+EZ_DECLARE_REFLECTABLE_TYPE(EZ_NO_LINKAGE, ezTestVersionedStruct);
+
 struct ezTypedObjectStruct
 {
   EZ_ALLOW_PRIVATE_PROPERTIES(ezTypedObjectStruct);
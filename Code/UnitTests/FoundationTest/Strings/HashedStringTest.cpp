@@ -1,6 +1,8 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
 
 EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
 {
@@ -185,6 +187,65 @@ EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
     EZ_TEST_STRING(s3.GetString().GetData(), "tut");
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Concurrent Interning")
+  {
+    // enough strings that the lock-free index of every shard has to grow several times while other threads read from it
+    constexpr ezUInt32 uiNumStrings = 20000;
+    constexpr ezUInt32 uiNumAssignments = 200000;
+
+    struct TestData
+    {
+      ezDynamicArray<ezString> m_Strings;
+      ezDynamicArray<ezHashedString> m_Expected;
+      ezAtomicInteger32 m_iNumMismatches;
+    };
+
+    TestData data;
+    data.m_Strings.SetCount(uiNumStrings);
+
+    ezStringBuilder tmp;
+    for (ezUInt32 i = 0; i < uiNumStrings; ++i)
+    {
+      tmp.SetFormat("ConcurrentInterning_{}", i);
+      data.m_Strings[i] = tmp;
+    }
+
+    auto assignStrings = [pData = &data](ezUInt32 uiStart, ezUInt32 uiEnd) {
+      ezHashedString s;
+      for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+      {
+        const ezUInt32 uiString = i % pData->m_Strings.GetCount();
+        s.Assign(pData->m_Strings[uiString]);
+
+        if (!pData->m_Expected.IsEmpty() && s != pData->m_Expected[uiString])
+        {
+          pData->m_iNumMismatches.Increment();
+        }
+      }
+    };
+
+    // the first round adds the strings from many threads at the same time
+    ezTaskSystem::ParallelForIndexed(0, uiNumStrings, assignStrings, "AddHashedStrings");
+
+    data.m_Expected.SetCount(uiNumStrings);
+    for (ezUInt32 i = 0; i < uiNumStrings; ++i)
+    {
+      data.m_Expected[i].Assign(data.m_Strings[i]);
+      EZ_TEST_BOOL(data.m_Expected[i].GetView() == data.m_Strings[i].GetView());
+    }
+
+    ezStopwatch sw;
+    assignStrings(0, uiNumAssignments);
+    const ezTime tSingle = sw.Checkpoint();
+
+    ezTaskSystem::ParallelForIndexed(0, uiNumAssignments, assignStrings, "InternHashedStrings");
+    const ezTime tParallel = sw.Checkpoint();
+
+    EZ_TEST_INT(data.m_iNumMismatches, 0);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Interning %u existing strings: %.2fms single threaded, %.2fms on %u worker threads", uiNumAssignments, tSingle.GetMilliseconds(), tParallel.GetMilliseconds(), ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks));
+  }
+
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "ClearUnusedStrings")
   {
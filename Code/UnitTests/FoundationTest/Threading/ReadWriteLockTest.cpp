@@ -0,0 +1,152 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Threading/ReadWriteLock.h>
+
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  class ReaderThread : public ezThread
+  {
+  public:
+    ReaderThread()
+      : ezThread("Reader Thread")
+    {
+    }
+
+    ezReadWriteLock* m_pLock = nullptr;
+    ezAtomicInteger32* m_pNumReaders = nullptr;
+    ezInt32 m_iNumThreads = 0;
+    bool m_bAllReadersEntered = false;
+
+    virtual ezUInt32 Run()
+    {
+      EZ_LOCK_SHARED(*m_pLock);
+
+      m_pNumReaders->Increment();
+
+      // all readers must be able to hold the lock at the same time
+      const ezTime tTimeout = ezTime::Now() + ezTime::MakeFromSeconds(10);
+      while (*m_pNumReaders < m_iNumThreads && ezTime::Now() < tTimeout)
+      {
+        ezThreadUtils::YieldTimeSlice();
+      }
+
+      m_bAllReadersEntered = *m_pNumReaders >= m_iNumThreads;
+      return 0;
+    }
+  };
+
+  class WriterThread : public ezThread
+  {
+  public:
+    WriterThread()
+      : ezThread("Writer Thread")
+    {
+    }
+
+    ezReadWriteLock* m_pLock = nullptr;
+    ezInt32* m_pValue = nullptr;
+    bool m_bConsistent = true;
+
+    virtual ezUInt32 Run()
+    {
+      for (ezUInt32 i = 0; i < 1000; ++i)
+      {
+        {
+          EZ_LOCK(*m_pLock);
+
+          // no other thread may see the intermediate value
+          *m_pValue += 1;
+          ezThreadUtils::YieldTimeSlice();
+          *m_pValue += 1;
+        }
+
+        {
+          EZ_LOCK_SHARED(*m_pLock);
+
+          if (*m_pValue % 2 != 0)
+            m_bConsistent = false;
+        }
+      }
+
+      return 0;
+    }
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Threading, ReadWriteLock)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Recursive Locking")
+  {
+    ezReadWriteLock lock;
+
+    {
+      EZ_LOCK_SHARED(lock);
+      EZ_LOCK_SHARED(lock);
+    }
+
+    {
+      EZ_LOCK(lock);
+      EZ_LOCK(lock);
+
+      // the writer may also read
+      EZ_LOCK_SHARED(lock);
+    }
+
+    // everything was released again
+    {
+      EZ_LOCK(lock);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel Readers")
+  {
+    constexpr ezUInt32 uiNumThreads = 4;
+
+    ezReadWriteLock lock;
+    ezAtomicInteger32 iNumReaders = 0;
+    ezUniquePtr<ReaderThread> threads[uiNumThreads];
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads[i] = EZ_DEFAULT_NEW(ReaderThread);
+      threads[i]->m_pLock = &lock;
+      threads[i]->m_pNumReaders = &iNumReaders;
+      threads[i]->m_iNumThreads = uiNumThreads;
+      threads[i]->Start();
+    }
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads[i]->Join();
+      EZ_TEST_BOOL(threads[i]->m_bAllReadersEntered);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Exclusive Writers")
+  {
+    constexpr ezUInt32 uiNumThreads = 4;
+
+    ezReadWriteLock lock;
+    ezInt32 iValue = 0;
+    ezUniquePtr<WriterThread> threads[uiNumThreads];
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads[i] = EZ_DEFAULT_NEW(WriterThread);
+      threads[i]->m_pLock = &lock;
+      threads[i]->m_pValue = &iValue;
+      threads[i]->Start();
+    }
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads[i]->Join();
+      EZ_TEST_BOOL(threads[i]->m_bConsistent);
+    }
+
+    EZ_TEST_INT(iValue, uiNumThreads * 1000 * 2);
+  }
+}
@@ -0,0 +1,372 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Utilities/PathFinding/GridNavmeshHierarchy.h>
+
+namespace
+{
+  using TestGrid = ezGameGrid<ezUInt8>;
+
+  bool IsSameCellType(ezUInt32 uiCell1, ezUInt32 uiCell2, void* pPassThrough)
+  {
+    const TestGrid* pGrid = static_cast<const TestGrid*>(pPassThrough);
+    return pGrid->GetCell(uiCell1) == pGrid->GetCell(uiCell2);
+  }
+
+  bool IsCellBlocked(ezUInt32 uiCell, void* pPassThrough)
+  {
+    const TestGrid* pGrid = static_cast<const TestGrid*>(pPassThrough);
+    return pGrid->GetCell(uiCell) == 1;
+  }
+
+  void FillRect(TestGrid& ref_grid, const ezRectU32& rect, ezUInt8 uiValue)
+  {
+    for (ezUInt32 y = rect.y; y < ezMath::Min<ezUInt32>(rect.Bottom(), ref_grid.GetGridSizeY()); ++y)
+    {
+      for (ezUInt32 x = rect.x; x < ezMath::Min<ezUInt32>(rect.Right(), ref_grid.GetGridSizeX()); ++x)
+      {
+        ref_grid.GetCell(ezVec2I32(x, y)) = uiValue;
+      }
+    }
+  }
+
+  /// Creates a grid with randomly placed blocked rectangles (1) and a few rectangles of a different walkable terrain type (2).
+  void CreateTestGrid(TestGrid& ref_grid, ezUInt16 uiSize, ezUInt32 uiNumObstacles, ezUInt32 uiSeed)
+  {
+    ezRandom rnd;
+    rnd.Initialize(uiSeed);
+
+    ref_grid.CreateGrid(uiSize, uiSize);
+    FillRect(ref_grid, ezRectU32(uiSize, uiSize), 0);
+
+    for (ezUInt32 i = 0; i < uiNumObstacles; ++i)
+    {
+      const ezRectU32 rect(rnd.UIntInRange(uiSize), rnd.UIntInRange(uiSize), 1 + rnd.UIntInRange(12), 1 + rnd.UIntInRange(12));
+      FillRect(ref_grid, rect, (i % 8 == 0) ? 2 : 1);
+    }
+  }
+
+  ezVec2 GetAreaCenter(const ezGridNavmesh& navmesh, ezInt64 iArea)
+  {
+    const ezRectU32& rect = navmesh.GetConvexArea(static_cast<ezInt32>(iArea)).m_Rect;
+    return ezVec2(rect.x + rect.width * 0.5f, rect.y + rect.height * 0.5f);
+  }
+
+  float GetCosts(const ezGridNavmesh& navmesh, ezInt64 iArea1, ezInt64 iArea2)
+  {
+    return ezMath::Max((GetAreaCenter(navmesh, iArea1) - GetAreaCenter(navmesh, iArea2)).GetLength(), 0.01f);
+  }
+
+  /// A search through all convex areas of the navmesh, with the same costs as ezGridNavmeshHierarchy uses.
+  class AreaStateGenerator : public ezPathStateGenerator<ezPathState>
+  {
+  public:
+    AreaStateGenerator(const ezGridNavmesh& navmesh)
+      : m_Navmesh(navmesh)
+    {
+    }
+
+    virtual void StartSearch(ezInt64 iStartNodeIndex, const ezPathState* pStartState, ezInt64 iTargetNodeIndex) override
+    {
+      EZ_IGNORE_UNUSED(iStartNodeIndex);
+      EZ_IGNORE_UNUSED(pStartState);
+      m_vTargetCenter = GetAreaCenter(m_Navmesh, iTargetNodeIndex);
+    }
+
+    virtual void GenerateAdjacentStates(ezInt64 iNodeIndex, const ezPathState& startState, ezPathSearch<ezPathState>* pPathSearch) override
+    {
+      const ezGridNavmesh::ConvexArea& area = m_Navmesh.GetConvexArea(static_cast<ezInt32>(iNodeIndex));
+
+      for (ezUInt32 e = 0; e < area.m_uiNumEdges; ++e)
+      {
+        const ezInt32 iNeighbor = m_Navmesh.GetAreaEdge(area.m_uiFirstEdge + e).m_iNeighborArea;
+
+        ezPathState state;
+        state.m_fCostToNode = startState.m_fCostToNode + GetCosts(m_Navmesh, iNodeIndex, iNeighbor);
+        state.m_fEstimatedCostToTarget = state.m_fCostToNode + (GetAreaCenter(m_Navmesh, iNeighbor) - m_vTargetCenter).GetLength();
+
+        pPathSearch->AddPathNode(iNeighbor, state);
+      }
+    }
+
+    const ezGridNavmesh& m_Navmesh;
+    ezVec2 m_vTargetCenter;
+  };
+
+  bool AreNeighbors(const ezGridNavmesh& navmesh, ezInt32 iArea1, ezInt32 iArea2)
+  {
+    const ezGridNavmesh::ConvexArea& area = navmesh.GetConvexArea(iArea1);
+
+    for (ezUInt32 e = 0; e < area.m_uiNumEdges; ++e)
+    {
+      if (navmesh.GetAreaEdge(area.m_uiFirstEdge + e).m_iNeighborArea == iArea2)
+        return true;
+    }
+
+    return false;
+  }
+
+  void TestNavmeshMatchesGrid(const ezGridNavmesh& navmesh, const TestGrid& grid)
+  {
+    ezUInt32 uiNumErrors = 0;
+
+    for (ezUInt32 y = 0; y < grid.GetGridSizeY(); ++y)
+    {
+      for (ezUInt32 x = 0; x < grid.GetGridSizeX(); ++x)
+      {
+        const ezVec2I32 vCell(x, y);
+        const ezInt32 iArea = navmesh.GetAreaAt(vCell);
+
+        if (grid.GetCell(vCell) == 1)
+        {
+          uiNumErrors += (iArea < 0) ? 0 : 1;
+          continue;
+        }
+
+        if (iArea < 0)
+        {
+          ++uiNumErrors;
+          continue;
+        }
+
+        // areas only contain cells of the same type
+        const ezRectU32& rect = navmesh.GetConvexArea(iArea).m_Rect;
+        uiNumErrors += (x >= rect.x && x < rect.Right() && y >= rect.y && y < rect.Bottom()) ? 0 : 1;
+        uiNumErrors += (grid.GetCell(vCell) == grid.GetCell(ezVec2I32(rect.x, rect.y))) ? 0 : 1;
+      }
+    }
+
+    EZ_TEST_INT(uiNumErrors, 0);
+  }
+
+  void TestFindPath(const ezGridNavmesh& navmesh, ezGridNavmeshHierarchy& ref_hierarchy, ezUInt32 uiSeed)
+  {
+    AreaStateGenerator generator(navmesh);
+
+    ezPathSearch<ezPathState> flatSearch;
+    flatSearch.SetPathStateGenerator(&generator);
+
+    ezRandom rnd;
+    rnd.Initialize(uiSeed);
+
+    const ezVec2U32 vGridSize = navmesh.GetGridSize();
+
+    ezDeque<ezPathSearch<ezPathState>::PathResultData> flatPath;
+    ezDynamicArray<ezInt32> path;
+
+    ezUInt32 uiNumFound = 0;
+
+    for (ezUInt32 i = 0; i < 50; ++i)
+    {
+      const ezVec2I32 vStart(rnd.UIntInRange(vGridSize.x), rnd.UIntInRange(vGridSize.y));
+      const ezVec2I32 vTarget(rnd.UIntInRange(vGridSize.x), rnd.UIntInRange(vGridSize.y));
+
+      const ezInt32 iStartArea = navmesh.GetAreaAt(vStart);
+      const ezInt32 iTargetArea = navmesh.GetAreaAt(vTarget);
+
+      const ezResult res = ref_hierarchy.FindPath(vStart, vTarget, path);
+
+      if (iStartArea < 0 || iTargetArea < 0)
+      {
+        EZ_TEST_BOOL(res.Failed());
+        continue;
+      }
+
+      if (flatSearch.FindPath(iStartArea, ezPathState(), iTargetArea, flatPath).Failed())
+      {
+        EZ_TEST_BOOL(res.Failed());
+        continue;
+      }
+
+      if (!EZ_TEST_BOOL(res.Succeeded()))
+        continue;
+
+      ++uiNumFound;
+
+      EZ_TEST_INT(path[0], iStartArea);
+      EZ_TEST_INT(path.PeekBack(), iTargetArea);
+
+      float fCosts = 0.0f;
+      bool bConnected = true;
+
+      for (ezUInt32 a = 1; a < path.GetCount(); ++a)
+      {
+        bConnected &= AreNeighbors(navmesh, path[a - 1], path[a]);
+        fCosts += GetCosts(navmesh, path[a - 1], path[a]);
+      }
+
+      EZ_TEST_BOOL(bConnected);
+
+      // the entrance graph contains all shortest paths, so the result is as short as the one of a search through all areas
+      EZ_TEST_FLOAT(fCosts, flatPath.PeekBack().m_pPathState->m_fCostToNode, ezMath::Max(0.01f, fCosts * 0.0001f));
+    }
+
+    EZ_TEST_BOOL(uiNumFound > 0);
+  }
+} // namespace
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableHierarchyProfileInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableHierarchyProfileInRelease = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(PathFinding, GridNavmeshHierarchy)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindPath")
+  {
+    TestGrid grid;
+    CreateTestGrid(grid, 128, 400, 1);
+
+    ezGridNavmesh navmesh;
+    navmesh.CreateFromGrid(grid, IsSameCellType, &grid, IsCellBlocked, &grid);
+    TestNavmeshMatchesGrid(navmesh, grid);
+
+    for (ezUInt32 uiClusterSize : {8, 16, 50})
+    {
+      ezGridNavmeshHierarchy hierarchy;
+      hierarchy.Build(navmesh, uiClusterSize);
+
+      EZ_TEST_INT(hierarchy.GetNumClusters().x, (128 + uiClusterSize - 1) / uiClusterSize);
+      EZ_TEST_BOOL(hierarchy.GetNumEntrances() > 0);
+
+      TestFindPath(navmesh, hierarchy, 42);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindPath (blocked cells)")
+  {
+    TestGrid grid;
+    grid.CreateGrid(16, 16);
+    FillRect(grid, ezRectU32(16, 16), 0);
+
+    // a wall that separates the left from the right half
+    FillRect(grid, ezRectU32(8, 0, 1, 16), 1);
+
+    ezGridNavmesh navmesh;
+    navmesh.CreateFromGrid(grid, IsSameCellType, &grid, IsCellBlocked, &grid);
+
+    ezGridNavmeshHierarchy hierarchy;
+    hierarchy.Build(navmesh, 4);
+
+    ezDynamicArray<ezInt32> path;
+    EZ_TEST_BOOL(hierarchy.FindPath(ezVec2I32(1, 1), ezVec2I32(8, 1), path).Failed());
+    EZ_TEST_BOOL(hierarchy.FindPath(ezVec2I32(1, 1), ezVec2I32(12, 1), path).Failed());
+    EZ_TEST_BOOL(hierarchy.FindPath(ezVec2I32(1, 1), ezVec2I32(16, 1), path).Failed());
+    EZ_TEST_BOOL(hierarchy.FindPath(ezVec2I32(1, 1), ezVec2I32(6, 14), path).Succeeded());
+
+    EZ_TEST_BOOL(hierarchy.FindPath(ezVec2I32(1, 1), ezVec2I32(1, 1), path).Succeeded());
+    EZ_TEST_INT(path.GetCount(), 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "UpdateCells")
+  {
+    TestGrid grid;
+    CreateTestGrid(grid, 128, 400, 3);
+
+    ezGridNavmesh navmesh;
+    navmesh.CreateFromGrid(grid, IsSameCellType, &grid, IsCellBlocked, &grid);
+
+    ezGridNavmeshHierarchy hierarchy;
+    hierarchy.Build(navmesh, 16);
+
+    ezRandom rnd;
+    rnd.Initialize(7);
+
+    for (ezUInt32 i = 0; i < 20; ++i)
+    {
+      // open up or block a random part of the grid
+      const ezRectU32 rect(rnd.UIntInRange(120), rnd.UIntInRange(120), 1 + rnd.UIntInRange(24), 1 + rnd.UIntInRange(24));
+      FillRect(grid, rect, static_cast<ezUInt8>(i % 3));
+
+      const ezRectU32 updatedRegion = navmesh.UpdateCells(grid, rect, IsSameCellType, &grid, IsCellBlocked, &grid);
+      EZ_TEST_BOOL(updatedRegion.Contains(ezRectU32(rect.x, rect.y, ezMath::Min(rect.width, 128u - rect.x), ezMath::Min(rect.height, 128u - rect.y))));
+
+      hierarchy.UpdateRegion(updatedRegion);
+
+      TestNavmeshMatchesGrid(navmesh, grid);
+      TestFindPath(navmesh, hierarchy, i);
+    }
+  }
+
+  EZ_TEST_BLOCK(EnableHierarchyProfileInRelease, "Profile big grid")
+  {
+    constexpr ezUInt16 uiGridSize = 2048;
+    constexpr ezUInt32 uiNumSearches = 20;
+
+    TestGrid grid;
+    CreateTestGrid(grid, uiGridSize, 60000, 11);
+
+    // searches from one corner to the other
+    FillRect(grid, ezRectU32(0, 0, 4, 4), 0);
+    FillRect(grid, ezRectU32(uiGridSize - 4, uiGridSize - 4, 4, 4), 0);
+
+    const ezVec2I32 vStart(0, 0);
+    const ezVec2I32 vTarget(uiGridSize - 1, uiGridSize - 1);
+
+    ezStopwatch sw;
+
+    ezGridNavmesh navmesh;
+    navmesh.CreateFromGrid(grid, IsSameCellType, &grid, IsCellBlocked, &grid);
+
+    const ezTime tNavmesh = sw.Checkpoint();
+
+    ezGridNavmeshHierarchy hierarchy;
+    hierarchy.Build(navmesh);
+
+    const ezTime tHierarchy = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%ux%u grid: navmesh with %u areas in %.2fms, hierarchy with %u entrances in %.2fms", uiGridSize, uiGridSize, navmesh.GetNumConvexAreas(), tNavmesh.GetMilliseconds(), hierarchy.GetNumEntrances(), tHierarchy.GetMilliseconds());
+
+    // flat search through all areas
+    {
+      AreaStateGenerator generator(navmesh);
+
+      ezPathSearch<ezPathState> flatSearch;
+      flatSearch.SetPathStateGenerator(&generator);
+      flatSearch.SetNodeIndexRange(navmesh.GetNumConvexAreas());
+
+      ezDeque<ezPathSearch<ezPathState>::PathResultData> flatPath;
+
+      sw.Checkpoint();
+
+      for (ezUInt32 i = 0; i < uiNumSearches; ++i)
+      {
+        flatSearch.FindPath(navmesh.GetAreaAt(vStart), ezPathState(), navmesh.GetAreaAt(vTarget), flatPath).IgnoreResult();
+      }
+
+      const ezTime tDiff = sw.Checkpoint();
+      ezTestFramework::Output(ezTestOutput::Duration, "Flat search: %.3fms per search, %u areas", tDiff.GetMilliseconds() / uiNumSearches, flatPath.GetCount());
+    }
+
+    // hierarchical search
+    {
+      ezDynamicArray<ezInt32> path;
+
+      sw.Checkpoint();
+
+      for (ezUInt32 i = 0; i < uiNumSearches; ++i)
+      {
+        hierarchy.FindPath(vStart, vTarget, path).IgnoreResult();
+      }
+
+      const ezTime tDiff = sw.Checkpoint();
+      ezTestFramework::Output(ezTestOutput::Duration, "Hierarchical search: %.3fms per search, %u areas", tDiff.GetMilliseconds() / uiNumSearches, path.GetCount());
+    }
+
+    // incremental update
+    {
+      const ezRectU32 rect(1000, 1000, 16, 16);
+      FillRect(grid, rect, 1);
+
+      sw.Checkpoint();
+
+      const ezRectU32 updatedRegion = navmesh.UpdateCells(grid, rect, IsSameCellType, &grid, IsCellBlocked, &grid);
+      hierarchy.UpdateRegion(updatedRegion);
+
+      const ezTime tDiff = sw.Checkpoint();
+      ezTestFramework::Output(ezTestOutput::Duration, "Updating %ux%u cells: %.3fms", rect.width, rect.height, tDiff.GetMilliseconds());
+    }
+  }
+}
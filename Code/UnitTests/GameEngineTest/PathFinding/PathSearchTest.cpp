@@ -0,0 +1,271 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Utilities/PathFinding/GraphSearch.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(PathFinding);
+
+namespace
+{
+  /// Expands the 4 direct neighbors of a cell in a grid with blocked cells. Every step costs 1.
+  class GridStateGenerator : public ezPathStateGenerator<ezPathState>
+  {
+  public:
+    GridStateGenerator(ezUInt32 uiWidth, ezUInt32 uiHeight, float fBlockedRatio, ezUInt32 uiSeed)
+      : m_uiWidth(uiWidth)
+      , m_uiHeight(uiHeight)
+    {
+      ezRandom rnd;
+      rnd.Initialize(uiSeed);
+
+      m_Blocked.SetCount(uiWidth * uiHeight);
+      for (ezUInt32 i = 0; i < m_Blocked.GetCount(); ++i)
+      {
+        m_Blocked[i] = rnd.DoubleZeroToOneExclusive() < fBlockedRatio;
+      }
+    }
+
+    virtual void StartSearch(ezInt64 iStartNodeIndex, const ezPathState* pStartState, ezInt64 iTargetNodeIndex) override
+    {
+      EZ_IGNORE_UNUSED(iStartNodeIndex);
+      EZ_IGNORE_UNUSED(pStartState);
+      m_iTargetNodeIndex = iTargetNodeIndex;
+    }
+
+    virtual void GenerateAdjacentStates(ezInt64 iNodeIndex, const ezPathState& startState, ezPathSearch<ezPathState>* pPathSearch) override
+    {
+      const ezInt32 x = static_cast<ezInt32>(iNodeIndex % m_uiWidth);
+      const ezInt32 y = static_cast<ezInt32>(iNodeIndex / m_uiWidth);
+
+      const ezInt32 offsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+      for (ezUInt32 i = 0; i < 4; ++i)
+      {
+        const ezInt32 nx = x + offsets[i][0];
+        const ezInt32 ny = y + offsets[i][1];
+
+        if (nx < 0 || ny < 0 || nx >= (ezInt32)m_uiWidth || ny >= (ezInt32)m_uiHeight)
+          continue;
+
+        const ezInt64 iAdjacentIndex = GetNodeIndex(nx, ny);
+        if (m_Blocked[static_cast<ezUInt32>(iAdjacentIndex)])
+          continue;
+
+        ezPathState state;
+        state.m_fCostToNode = startState.m_fCostToNode + 1.0f;
+        state.m_fEstimatedCostToTarget = state.m_fCostToNode + EstimateCosts(iAdjacentIndex);
+
+        pPathSearch->AddPathNode(iAdjacentIndex, state);
+      }
+    }
+
+    ezInt64 GetNodeIndex(ezUInt32 x, ezUInt32 y) const { return static_cast<ezInt64>(y) * m_uiWidth + x; }
+
+    float EstimateCosts(ezInt64 iNodeIndex) const
+    {
+      if (m_iTargetNodeIndex < 0)
+        return 0.0f;
+
+      const ezInt64 dx = ezMath::Abs(iNodeIndex % m_uiWidth - m_iTargetNodeIndex % m_uiWidth);
+      const ezInt64 dy = ezMath::Abs(iNodeIndex / m_uiWidth - m_iTargetNodeIndex / m_uiWidth);
+      return static_cast<float>(dx + dy);
+    }
+
+    /// Computes the exact number of steps from the start to every cell with a breadth-first search.
+    void ComputeReferenceDistances(ezInt64 iStartNodeIndex, ezDynamicArray<ezInt32>& out_distances) const
+    {
+      out_distances.Clear();
+      out_distances.SetCount(m_Blocked.GetCount(), -1);
+
+      ezDeque<ezInt64> queue;
+      queue.PushBack(iStartNodeIndex);
+      out_distances[static_cast<ezUInt32>(iStartNodeIndex)] = 0;
+
+      const ezInt32 offsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+      while (!queue.IsEmpty())
+      {
+        const ezInt64 iNodeIndex = queue.PeekFront();
+        queue.PopFront();
+
+        const ezInt32 x = static_cast<ezInt32>(iNodeIndex % m_uiWidth);
+        const ezInt32 y = static_cast<ezInt32>(iNodeIndex / m_uiWidth);
+
+        for (ezUInt32 i = 0; i < 4; ++i)
+        {
+          const ezInt32 nx = x + offsets[i][0];
+          const ezInt32 ny = y + offsets[i][1];
+
+          if (nx < 0 || ny < 0 || nx >= (ezInt32)m_uiWidth || ny >= (ezInt32)m_uiHeight)
+            continue;
+
+          const ezUInt32 uiAdjacentIndex = static_cast<ezUInt32>(GetNodeIndex(nx, ny));
+          if (m_Blocked[uiAdjacentIndex] || out_distances[uiAdjacentIndex] >= 0)
+            continue;
+
+          out_distances[uiAdjacentIndex] = out_distances[static_cast<ezUInt32>(iNodeIndex)] + 1;
+          queue.PushBack(uiAdjacentIndex);
+        }
+      }
+    }
+
+    ezUInt32 m_uiWidth = 0;
+    ezUInt32 m_uiHeight = 0;
+    ezDynamicArray<bool> m_Blocked;
+    ezInt64 m_iTargetNodeIndex = -1;
+  };
+
+  ezInt64 s_iClosestSearchTarget = 0;
+
+  bool IsClosestSearchTarget(ezInt64 iNodeIndex, const ezPathState& state)
+  {
+    EZ_IGNORE_UNUSED(state);
+    return iNodeIndex == s_iClosestSearchTarget;
+  }
+
+  void TestFindPath(ezPathSearch<ezPathState>& ref_search, GridStateGenerator& ref_generator)
+  {
+    ezRandom rnd;
+    rnd.Initialize(42);
+
+    ezDynamicArray<ezInt32> distances;
+    ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+
+    for (ezUInt32 i = 0; i < 20; ++i)
+    {
+      const ezInt64 iStart = ref_generator.GetNodeIndex(rnd.UIntInRange(ref_generator.m_uiWidth), rnd.UIntInRange(ref_generator.m_uiHeight));
+      const ezInt64 iTarget = ref_generator.GetNodeIndex(rnd.UIntInRange(ref_generator.m_uiWidth), rnd.UIntInRange(ref_generator.m_uiHeight));
+
+      ref_generator.m_Blocked[static_cast<ezUInt32>(iStart)] = false;
+      ref_generator.m_Blocked[static_cast<ezUInt32>(iTarget)] = false;
+
+      ref_generator.ComputeReferenceDistances(iStart, distances);
+      const ezInt32 iExpectedSteps = distances[static_cast<ezUInt32>(iTarget)];
+
+      const ezResult res = ref_search.FindPath(iStart, ezPathState(), iTarget, path);
+
+      if (iExpectedSteps < 0)
+      {
+        EZ_TEST_BOOL(res.Failed());
+        continue;
+      }
+
+      if (!EZ_TEST_BOOL(res.Succeeded()))
+        continue;
+
+      // the heuristic is optimistic, so the path must be a shortest one
+      EZ_TEST_INT(path.GetCount(), iExpectedSteps + 1);
+      EZ_TEST_BOOL(path.PeekFront().m_iNodeIndex == iStart);
+      EZ_TEST_BOOL(path.PeekBack().m_iNodeIndex == iTarget);
+      EZ_TEST_FLOAT(path.PeekBack().m_pPathState->m_fCostToNode, (float)iExpectedSteps, 0.0f);
+    }
+  }
+} // namespace
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(PathFinding, PathSearch)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindPath")
+  {
+    GridStateGenerator generator(64, 64, 0.3f, 1);
+
+    ezPathSearch<ezPathState> search;
+    search.SetPathStateGenerator(&generator);
+
+    TestFindPath(search, generator);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindPath (SetNodeIndexRange)")
+  {
+    GridStateGenerator generator(64, 64, 0.3f, 1);
+
+    ezPathSearch<ezPathState> search;
+    search.SetPathStateGenerator(&generator);
+    search.SetNodeIndexRange(64 * 64);
+
+    // the node data is reused by all searches
+    TestFindPath(search, generator);
+
+    // growing the range keeps the existing node data, which must not leak into the following searches
+    search.SetNodeIndexRange(64 * 64 + 100);
+    TestFindPath(search, generator);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindPath (start is target)")
+  {
+    GridStateGenerator generator(8, 8, 0.0f, 1);
+
+    ezPathSearch<ezPathState> search;
+    search.SetPathStateGenerator(&generator);
+
+    ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+    EZ_TEST_BOOL(search.FindPath(9, ezPathState(), 9, path).Succeeded());
+    EZ_TEST_INT(path.GetCount(), 1);
+    EZ_TEST_INT(path[0].m_iNodeIndex, 9);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindClosest")
+  {
+    GridStateGenerator generator(32, 32, 0.0f, 1);
+
+    ezPathSearch<ezPathState> search;
+    search.SetPathStateGenerator(&generator);
+    search.SetNodeIndexRange(32 * 32);
+
+    s_iClosestSearchTarget = generator.GetNodeIndex(20, 5);
+
+    ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+    EZ_TEST_BOOL(search.FindClosest(generator.GetNodeIndex(2, 3), ezPathState(), IsClosestSearchTarget, path).Succeeded());
+    EZ_TEST_INT(path.GetCount(), 18 + 2 + 1);
+    EZ_TEST_BOOL(path.PeekBack().m_iNodeIndex == s_iClosestSearchTarget);
+
+    // the cost limit is reached before the target
+    EZ_TEST_BOOL(search.FindClosest(generator.GetNodeIndex(2, 3), ezPathState(), IsClosestSearchTarget, path, 10.0f).Failed());
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Profile big grid")
+  {
+    constexpr ezUInt32 uiGridSize = 1024;
+    constexpr ezUInt32 uiNumSearches = 10;
+
+    GridStateGenerator generator(uiGridSize, uiGridSize, 0.2f, 7);
+
+    // diagonal searches through the whole grid
+    const ezInt64 iStart = generator.GetNodeIndex(0, 0);
+    const ezInt64 iTarget = generator.GetNodeIndex(uiGridSize - 1, uiGridSize - 1);
+    generator.m_Blocked[static_cast<ezUInt32>(iStart)] = false;
+    generator.m_Blocked[static_cast<ezUInt32>(iTarget)] = false;
+
+    ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+
+    for (ezUInt32 uiDense = 0; uiDense < 2; ++uiDense)
+    {
+      ezPathSearch<ezPathState> search;
+      search.SetPathStateGenerator(&generator);
+
+      if (uiDense)
+      {
+        search.SetNodeIndexRange(uiGridSize * uiGridSize);
+      }
+
+      ezUInt32 uiNumFound = 0;
+
+      ezStopwatch sw;
+
+      for (ezUInt32 i = 0; i < uiNumSearches; ++i)
+      {
+        uiNumFound += search.FindPath(iStart, ezPathState(), iTarget, path).Succeeded() ? 1 : 0;
+      }
+
+      const ezTime tDiff = sw.Checkpoint();
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%u path searches on a %ux%u grid (%s node states): %.2fms per search, path length %u", uiNumSearches, uiGridSize, uiGridSize, uiDense ? "dense" : "hashed", tDiff.GetMilliseconds() / uiNumSearches, uiNumFound > 0 ? path.GetCount() : 0u);
+    }
+  }
+}
@@ -0,0 +1,205 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <VisualScriptPlugin/Runtime/VisualScriptFunctionProperty.h>
+#include <VisualScriptPlugin/Runtime/VisualScriptInstance.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(VisualScript);
+
+namespace
+{
+  using DataOffset = ezVisualScriptDataDescription::DataOffset;
+  using NodeType = ezVisualScriptNodeDescription::Type;
+
+  constexpr float s_fAdd = 1.0f;
+  constexpr float s_fMul = 2.0f;
+  constexpr float s_fLimit = 100.0f;
+
+  ezVisualScriptNodeDescription& AddNode(ezDynamicArray<ezVisualScriptNodeDescription>& inout_nodes, NodeType::Enum type, ezVisualScriptDataType::Enum deductedDataType = ezVisualScriptDataType::Invalid)
+  {
+    auto& node = inout_nodes.ExpandAndGetRef();
+    node.m_Type = type;
+    node.m_DeductedDataType = deductedDataType;
+    return node;
+  }
+
+  /// Builds the graph for 'A = (A + 1) * 2; if (A >= 100) A = 0;' where A is an instance variable.
+  ezSharedPtr<ezVisualScriptGraphDescription> CreateGraph(const ezVisualScriptDataDescription& constantDesc, const ezVisualScriptDataDescription& instanceDesc)
+  {
+    ezVisualScriptDataDescription localDesc;
+    localDesc.m_PerTypeInfo[ezVisualScriptDataType::Float].m_uiCount = 2;
+    localDesc.m_PerTypeInfo[ezVisualScriptDataType::Bool].m_uiCount = 1;
+    localDesc.CalculatePerTypeStartOffsets();
+
+    const DataOffset a = instanceDesc.GetOffset(ezVisualScriptDataType::Float, 0, DataOffset::Source::Instance);
+    const DataOffset add = constantDesc.GetOffset(ezVisualScriptDataType::Float, 0, DataOffset::Source::Constant);
+    const DataOffset mul = constantDesc.GetOffset(ezVisualScriptDataType::Float, 1, DataOffset::Source::Constant);
+    const DataOffset limit = constantDesc.GetOffset(ezVisualScriptDataType::Float, 2, DataOffset::Source::Constant);
+    const DataOffset zero = constantDesc.GetOffset(ezVisualScriptDataType::Float, 3, DataOffset::Source::Constant);
+    const DataOffset tmp0 = localDesc.GetOffset(ezVisualScriptDataType::Float, 0, DataOffset::Source::Local);
+    const DataOffset tmp1 = localDesc.GetOffset(ezVisualScriptDataType::Float, 1, DataOffset::Source::Local);
+    const DataOffset cond = localDesc.GetOffset(ezVisualScriptDataType::Bool, 0, DataOffset::Source::Local);
+
+    ezDynamicArray<ezVisualScriptNodeDescription> nodes;
+
+    // 0
+    AddNode(nodes, NodeType::EntryCall).m_ExecutionIndices.PushBack(1);
+
+    // 1
+    {
+      auto& node = AddNode(nodes, NodeType::Builtin_Add, ezVisualScriptDataType::Float);
+      node.m_ExecutionIndices.PushBack(2);
+      node.m_InputDataOffsets.PushBack(a);
+      node.m_InputDataOffsets.PushBack(add);
+      node.m_OutputDataOffsets.PushBack(tmp0);
+    }
+
+    // 2
+    {
+      auto& node = AddNode(nodes, NodeType::Builtin_Multiply, ezVisualScriptDataType::Float);
+      node.m_ExecutionIndices.PushBack(3);
+      node.m_InputDataOffsets.PushBack(tmp0);
+      node.m_InputDataOffsets.PushBack(mul);
+      node.m_OutputDataOffsets.PushBack(tmp1);
+    }
+
+    // 3
+    {
+      auto& node = AddNode(nodes, NodeType::Builtin_Compare, ezVisualScriptDataType::Float);
+      node.m_Value = ezInt64(ezComparisonOperator::Less);
+      node.m_ExecutionIndices.PushBack(4);
+      node.m_InputDataOffsets.PushBack(tmp1);
+      node.m_InputDataOffsets.PushBack(limit);
+      node.m_OutputDataOffsets.PushBack(cond);
+    }
+
+    // 4
+    {
+      auto& node = AddNode(nodes, NodeType::Builtin_Branch);
+      node.m_ExecutionIndices.PushBack(5);
+      node.m_ExecutionIndices.PushBack(6);
+      node.m_InputDataOffsets.PushBack(cond);
+    }
+
+    // 5
+    {
+      auto& node = AddNode(nodes, NodeType::Builtin_SetVariable, ezVisualScriptDataType::Float);
+      node.m_InputDataOffsets.PushBack(tmp1);
+      node.m_OutputDataOffsets.PushBack(a);
+    }
+
+    // 6
+    {
+      auto& node = AddNode(nodes, NodeType::Builtin_SetVariable, ezVisualScriptDataType::Float);
+      node.m_InputDataOffsets.PushBack(zero);
+      node.m_OutputDataOffsets.PushBack(a);
+    }
+
+    ezDefaultMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    if (ezVisualScriptGraphDescription::Serialize(nodes, localDesc, writer).Failed())
+      return nullptr;
+
+    ezSharedPtr<ezVisualScriptGraphDescription> pDesc = EZ_DEFAULT_NEW(ezVisualScriptGraphDescription);
+
+    ezMemoryStreamReader reader(&storage);
+    if (pDesc->Deserialize(reader).Failed())
+      return nullptr;
+
+    return pDesc;
+  }
+
+  float ExecuteReference(float a)
+  {
+    a = (a + s_fAdd) * s_fMul;
+    return a < s_fLimit ? a : 0.0f;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(VisualScript, Benchmark)
+{
+  constexpr ezUInt32 uiNumInstances = 10000;
+  constexpr ezUInt32 uiNumFrames = 10;
+
+  ezSharedPtr<ezVisualScriptDataDescription> pConstantDesc = EZ_DEFAULT_NEW(ezVisualScriptDataDescription);
+  pConstantDesc->m_PerTypeInfo[ezVisualScriptDataType::Float].m_uiCount = 4;
+  pConstantDesc->CalculatePerTypeStartOffsets();
+
+  ezSharedPtr<ezVisualScriptDataStorage> pConstantStorage = EZ_DEFAULT_NEW(ezVisualScriptDataStorage, pConstantDesc);
+  pConstantStorage->AllocateStorage();
+  pConstantStorage->SetData(pConstantDesc->GetOffset(ezVisualScriptDataType::Float, 0, DataOffset::Source::Constant), s_fAdd);
+  pConstantStorage->SetData(pConstantDesc->GetOffset(ezVisualScriptDataType::Float, 1, DataOffset::Source::Constant), s_fMul);
+  pConstantStorage->SetData(pConstantDesc->GetOffset(ezVisualScriptDataType::Float, 2, DataOffset::Source::Constant), s_fLimit);
+  pConstantStorage->SetData(pConstantDesc->GetOffset(ezVisualScriptDataType::Float, 3, DataOffset::Source::Constant), 0.0f);
+
+  ezSharedPtr<ezVisualScriptDataDescription> pInstanceDesc = EZ_DEFAULT_NEW(ezVisualScriptDataDescription);
+  pInstanceDesc->m_PerTypeInfo[ezVisualScriptDataType::Float].m_uiCount = 1;
+  pInstanceDesc->CalculatePerTypeStartOffsets();
+
+  const ezHashedString sVarName = ezMakeHashedString("A");
+
+  ezSharedPtr<ezVisualScriptInstanceDataMapping> pInstanceDataMapping = EZ_DEFAULT_NEW(ezVisualScriptInstanceDataMapping);
+  {
+    ezVisualScriptInstanceData instanceData;
+    instanceData.m_DataOffset = pInstanceDesc->GetOffset(ezVisualScriptDataType::Float, 0, DataOffset::Source::Instance);
+    instanceData.m_DefaultValue = 0.0f;
+    pInstanceDataMapping->m_Content.Insert(sVarName, instanceData);
+  }
+
+  ezSharedPtr<ezVisualScriptGraphDescription> pDesc = CreateGraph(*pConstantDesc, *pInstanceDesc);
+  if (!EZ_TEST_BOOL(pDesc != nullptr))
+    return;
+
+  ezVisualScriptFunctionProperty function("Update", pDesc);
+
+  ezDynamicArray<ezReflectedClass> owners;
+  owners.SetCount(uiNumInstances);
+
+  ezDynamicArray<ezUniquePtr<ezVisualScriptInstance>> instances;
+  ezDynamicArray<float> expectedValues;
+  instances.Reserve(uiNumInstances);
+  expectedValues.Reserve(uiNumInstances);
+
+  for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+  {
+    auto pInstance = EZ_DEFAULT_NEW(ezVisualScriptInstance, owners[i], nullptr, pConstantStorage, pInstanceDesc, pInstanceDataMapping);
+
+    const float fStartValue = static_cast<float>(i % 50);
+    pInstance->SetInstanceVariable(sVarName, fStartValue);
+
+    instances.PushBack(pInstance);
+    expectedValues.PushBack(fStartValue);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Execute 10k instances")
+  {
+    ezStopwatch sw;
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      for (auto& pInstance : instances)
+      {
+        ezVariant returnValue;
+        function.Execute(pInstance.Borrow(), ezArrayPtr<ezVariant>(), returnValue);
+      }
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Executing %u script instances %u times: %.2fms (%.1fns per execution)", uiNumInstances, uiNumFrames, tDiff.GetMilliseconds(), tDiff.GetNanoseconds() / (uiNumInstances * uiNumFrames));
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      for (auto& fValue : expectedValues)
+      {
+        fValue = ExecuteReference(fValue);
+      }
+    }
+
+    for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+    {
+      EZ_TEST_FLOAT(instances[i]->GetInstanceVariable(sVarName).Get<float>(), expectedValues[i], 0.0f);
+    }
+  }
+}
@@ -0,0 +1,480 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Reflection/ReflectionUtils.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <RendererCore/Meshes/MeshComponent.h>
+#include <RendererCore/Pipeline/Extractor.h>
+#include <RendererCore/Pipeline/Passes/DepthOnlyPass.h>
+#include <RendererCore/Pipeline/Passes/OpaqueForwardRenderPass.h>
+#include <RendererCore/Pipeline/Passes/SourcePass.h>
+#include <RendererCore/Pipeline/Passes/TargetPass.h>
+#include <RendererCore/Pipeline/Passes/TransparentForwardRenderPass.h>
+#include <RendererCore/Pipeline/RenderPipeline.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererTest/Advanced/HeadlessBenchmark.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiResolutionX = 1280;
+  constexpr ezUInt32 s_uiResolutionY = 720;
+  constexpr ezUInt32 s_uiNumObjects = 2000;
+  constexpr ezUInt32 s_uiNumMeshes = 32;
+
+  constexpr ezUInt32 s_uiNumProps = 10000;
+  constexpr ezUInt32 s_uiNumPropMeshes = 40; ///< Different meshes or LODs of the props.
+  constexpr ezUInt32 s_uiNumPropMaterials = 4;
+
+  // the first frames compile shaders and load resources
+  constexpr ezUInt32 s_uiNumWarmupFrames = 5;
+  constexpr ezUInt32 s_uiNumMeasuredFrames = 50;
+
+  constexpr const char* s_szOpaquePassName = "Opaque";
+
+  void SetPassProperty(ezRenderPipelinePass* pPass, const char* szPropertyName, const ezVariant& value)
+  {
+    const ezAbstractProperty* pProp = pPass->GetDynamicRTTI()->FindPropertyByName(szPropertyName);
+    EZ_ASSERT_DEV(pProp != nullptr && pProp->GetCategory() == ezPropertyCategory::Member, "Render pass property '{}' doesn't exist", szPropertyName);
+
+    ezReflectionUtils::SetMemberPropertyValue(static_cast<const ezAbstractMemberProperty*>(pProp), pPass, value);
+  }
+
+  ezUInt32 GetSectionDrawCalls(const ezGALCommandStatisticsNull& stats, ezStringView sSectionName)
+  {
+    for (const ezGALCommandStatisticsNull::Section& section : stats.m_Sections)
+    {
+      if (section.m_sName == sSectionName)
+        return section.m_uiDrawCalls;
+    }
+
+    return 0;
+  }
+} // namespace
+
+void ezRendererTestHeadlessBenchmark::SetupSubTests()
+{
+  // this is a benchmark, the numbers are meaningless in debug builds
+#if EZ_DISABLED(EZ_COMPILE_FOR_DEBUG)
+  AddSubTest("01 - ManyObjects", SubTests::ST_ManyObjects);
+  AddSubTest("02 - ManyMeshes", SubTests::ST_ManyMeshes);
+  AddSubTest("03 - AutoInstancing", SubTests::ST_AutoInstancing);
+#endif
+}
+
+ezResult ezRendererTestHeadlessBenchmark::InitializeSubTest(ezInt32 iIdentifier)
+{
+  m_iFrame = -1;
+  m_bCaptureImage = false;
+  m_ImgCompFrames.Clear();
+  m_TotalExtractionTime = ezTime::MakeZero();
+  m_TotalFrameTime = ezTime::MakeZero();
+
+  // don't call the base class, the benchmark always runs on the null device and never opens a window
+  ezStartup::StartupCoreSystems();
+  EZ_SUCCEED_OR_RETURN(SetupRenderer("Null"));
+
+  {
+    ezGALTextureCreationDescription texDesc;
+    texDesc.SetAsRenderTarget(s_uiResolutionX, s_uiResolutionY, ezGALResourceFormat::RGBAUByteNormalizedsRGB);
+    m_hColorTarget = m_pDevice->CreateTexture(texDesc);
+
+    texDesc.SetAsRenderTarget(s_uiResolutionX, s_uiResolutionY, ezGALResourceFormat::D24S8);
+    m_hDepthTarget = m_pDevice->CreateTexture(texDesc);
+
+    if (m_hColorTarget.IsInvalidated() || m_hDepthTarget.IsInvalidated())
+      return EZ_FAILURE;
+  }
+
+  {
+    ezWorldDesc worldDesc("HeadlessBenchmark");
+    m_pWorld = EZ_DEFAULT_NEW(ezWorld, worldDesc);
+  }
+
+  m_Camera.LookAt(ezVec3::MakeZero(), ezVec3(1, 0, 0), ezVec3(0, 0, 1));
+  m_Camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 60.0f, 0.1f, 1000.0f);
+
+  {
+    ezView* pView = nullptr;
+    m_hView = ezRenderWorld::CreateView("HeadlessBenchmark", pView);
+
+    pView->SetCameraUsageHint(ezCameraUsageHint::MainView);
+    pView->SetWorld(m_pWorld.Borrow());
+    pView->SetCamera(&m_Camera);
+    pView->SetViewport(ezRectFloat(0.0f, 0.0f, (float)s_uiResolutionX, (float)s_uiResolutionY));
+    pView->SetRenderPipelineResource(CreateRenderPipeline());
+
+    ezGALRenderTargets renderTargets;
+    renderTargets.m_hRTs[0] = m_hColorTarget;
+    renderTargets.m_hDSTarget = m_hDepthTarget;
+    pView->SetRenderTargets(renderTargets);
+
+    ezRenderWorld::AddMainView(m_hView);
+  }
+
+  ezRandom rnd;
+  rnd.Initialize(0xbe7c);
+
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  if (iIdentifier == ST_AutoInstancing)
+  {
+    for (ezUInt32 i = 0; i < s_uiNumPropMaterials; ++i)
+    {
+      ezStringBuilder sName;
+      sName.SetFormat("HeadlessBenchmarkPropMaterial_{}", i);
+      m_Materials.PushBack(CreateMaterial(sName, "BLEND_MODE_OPAQUE", ezColor::MakeHSV(i * 360.0f / s_uiNumPropMaterials, 0.5f, 1.0f)));
+    }
+
+    for (ezUInt32 i = 0; i < s_uiNumPropMeshes; ++i)
+    {
+      const float fSize = 0.5f + i * 0.05f;
+
+      ezGeometry geom;
+      geom.AddBox(ezVec3(fSize, fSize, fSize * 2.0f), false);
+
+      ezStringBuilder sName;
+      sName.SetFormat("HeadlessBenchmarkPropMesh_{}", i);
+      m_Meshes.PushBack(CreateMeshResource(geom, sName));
+    }
+
+    // the props are ordinary static mesh components, so their sorting keys and batch ids are computed by ezMeshComponentBase
+    for (ezUInt32 i = 0; i < s_uiNumProps; ++i)
+    {
+      const ezUInt32 uiMesh = rnd.UIntInRange(s_uiNumPropMeshes);
+      const ezVec3 vPos((float)rnd.DoubleMinMax(5.0, 500.0), (float)rnd.DoubleMinMax(-200.0, 200.0), 0.0f);
+
+      CreateMeshObject(vPos, m_Meshes[uiMesh], m_Materials[uiMesh % s_uiNumPropMaterials]);
+    }
+  }
+  else
+  {
+    if (iIdentifier == ST_ManyObjects)
+    {
+      ezGeometry geom;
+      geom.AddGeodesicSphere(0.5f, 2);
+      m_Meshes.PushBack(CreateMeshResource(geom, "HeadlessBenchmarkSphere"));
+    }
+    else if (iIdentifier == ST_ManyMeshes)
+    {
+      for (ezUInt32 i = 0; i < s_uiNumMeshes; ++i)
+      {
+        const float fSize = 0.5f + i * 0.1f;
+
+        ezGeometry geom;
+        if (i % 2 == 0)
+          geom.AddBox(ezVec3(fSize), false);
+        else
+          geom.AddTorus(fSize * 0.5f, fSize, static_cast<ezUInt16>(8 + i), static_cast<ezUInt16>(8 + i), true);
+
+        ezStringBuilder sName;
+        sName.SetFormat("HeadlessBenchmarkMesh_{}", i);
+        m_Meshes.PushBack(CreateMeshResource(geom, sName));
+      }
+    }
+
+    const ezMaterialResourceHandle hOpaqueMaterial = CreateMaterial("HeadlessBenchmarkOpaqueMaterial", "BLEND_MODE_OPAQUE", ezColor::White);
+    const ezMaterialResourceHandle hTransparentMaterial = CreateMaterial("HeadlessBenchmarkTransparentMaterial", "BLEND_MODE_TRANSPARENT", ezColor::White.WithAlpha(0.5f));
+    m_Materials.PushBack(hOpaqueMaterial);
+    m_Materials.PushBack(hTransparentMaterial);
+
+    for (ezUInt32 i = 0; i < s_uiNumObjects; ++i)
+    {
+      const ezVec3 vPos((float)rnd.DoubleMinMax(5.0, 50.0), (float)rnd.DoubleMinMax(-20.0, 20.0), (float)rnd.DoubleMinMax(-20.0, 20.0));
+
+      // a quarter of the objects is rendered in the transparent pass
+      const bool bTransparent = i >= s_uiNumObjects / 2 && i < s_uiNumObjects / 2 + s_uiNumObjects / 4;
+
+      CreateMeshObject(vPos, m_Meshes[i % m_Meshes.GetCount()], bTransparent ? hTransparentMaterial : hOpaqueMaterial);
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRendererTestHeadlessBenchmark::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  if (!m_hView.IsInvalidated())
+  {
+    ezRenderWorld::DeleteView(m_hView);
+    m_hView.Invalidate();
+  }
+
+  m_pWorld.Clear();
+
+  m_Meshes.Clear();
+  m_Materials.Clear();
+
+  if (!m_hColorTarget.IsInvalidated())
+  {
+    m_pDevice->DestroyTexture(m_hColorTarget);
+    m_hColorTarget.Invalidate();
+  }
+
+  if (!m_hDepthTarget.IsInvalidated())
+  {
+    m_pDevice->DestroyTexture(m_hDepthTarget);
+    m_hDepthTarget.Invalidate();
+  }
+
+  m_pDevice->WaitIdle();
+
+  return SUPER::DeInitializeSubTest(iIdentifier);
+}
+
+ezTestAppRun ezRendererTestHeadlessBenchmark::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
+{
+  if (iIdentifier == ST_AutoInstancing)
+  {
+    RunAutoInstancingBenchmark();
+    return ezTestAppRun::Quit;
+  }
+
+  m_iFrame = uiInvocationCount;
+
+  if (uiInvocationCount == s_uiNumWarmupFrames)
+  {
+    static_cast<ezGALDeviceNull*>(m_pDevice)->ResetStatistics();
+  }
+
+  ezTime extractionTime;
+  ezTime frameTime;
+  RenderFrame(extractionTime, frameTime);
+
+  if (uiInvocationCount >= s_uiNumWarmupFrames)
+  {
+    m_TotalExtractionTime += extractionTime;
+    m_TotalFrameTime += frameTime;
+  }
+
+  if (uiInvocationCount + 1 < s_uiNumWarmupFrames + s_uiNumMeasuredFrames)
+    return ezTestAppRun::Continue;
+
+  OutputStatistics();
+  return ezTestAppRun::Quit;
+}
+
+ezRenderPipelineResourceHandle ezRendererTestHeadlessBenchmark::CreateRenderPipeline()
+{
+  ezUniquePtr<ezRenderPipeline> pRenderPipeline = EZ_DEFAULT_NEW(ezRenderPipeline);
+
+  ezSourcePass* pColorSourcePass = nullptr;
+  {
+    ezUniquePtr<ezSourcePass> pPass = EZ_DEFAULT_NEW(ezSourcePass, "ColorSource");
+    pColorSourcePass = pPass.Borrow();
+    SetPassProperty(pColorSourcePass, "Clear", true);
+    SetPassProperty(pColorSourcePass, "ClearColor", ezColor::CornflowerBlue);
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  ezSourcePass* pDepthSourcePass = nullptr;
+  {
+    ezUniquePtr<ezSourcePass> pPass = EZ_DEFAULT_NEW(ezSourcePass, "DepthStencil");
+    pDepthSourcePass = pPass.Borrow();
+    SetPassProperty(pDepthSourcePass, "Format", (ezInt64)ezSourceFormat::Depth24BitStencil8Bit);
+    SetPassProperty(pDepthSourcePass, "Clear", true);
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  ezDepthOnlyPass* pDepthPrePass = nullptr;
+  {
+    ezUniquePtr<ezDepthOnlyPass> pPass = EZ_DEFAULT_NEW(ezDepthOnlyPass, "DepthPrePass");
+    pDepthPrePass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  ezOpaqueForwardRenderPass* pOpaquePass = nullptr;
+  {
+    ezUniquePtr<ezOpaqueForwardRenderPass> pPass = EZ_DEFAULT_NEW(ezOpaqueForwardRenderPass, s_szOpaquePassName);
+    pOpaquePass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  ezTransparentForwardRenderPass* pTransparentPass = nullptr;
+  {
+    ezUniquePtr<ezTransparentForwardRenderPass> pPass = EZ_DEFAULT_NEW(ezTransparentForwardRenderPass, "Transparent");
+    pTransparentPass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  ezTargetPass* pTargetPass = nullptr;
+  {
+    ezUniquePtr<ezTargetPass> pPass = EZ_DEFAULT_NEW(ezTargetPass);
+    pTargetPass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  {
+    ezUniquePtr<ezVisibleObjectsExtractor> pExtractor = EZ_DEFAULT_NEW(ezVisibleObjectsExtractor);
+    pRenderPipeline->AddExtractor(std::move(pExtractor));
+  }
+
+  EZ_VERIFY(pRenderPipeline->Connect(pDepthSourcePass, "Output", pDepthPrePass, "DepthStencil"), "Connect failed!");
+  EZ_VERIFY(pRenderPipeline->Connect(pColorSourcePass, "Output", pOpaquePass, "Color"), "Connect failed!");
+  EZ_VERIFY(pRenderPipeline->Connect(pDepthPrePass, "DepthStencil", pOpaquePass, "DepthStencil"), "Connect failed!");
+  EZ_VERIFY(pRenderPipeline->Connect(pOpaquePass, "Color", pTransparentPass, "Color"), "Connect failed!");
+  EZ_VERIFY(pRenderPipeline->Connect(pOpaquePass, "DepthStencil", pTransparentPass, "DepthStencil"), "Connect failed!");
+  EZ_VERIFY(pRenderPipeline->Connect(pTransparentPass, "Color", pTargetPass, "Color0"), "Connect failed!");
+  EZ_VERIFY(pRenderPipeline->Connect(pTransparentPass, "DepthStencil", pTargetPass, "DepthStencil"), "Connect failed!");
+
+  ezRenderPipelineResourceDescriptor desc;
+  desc.CreateFromRenderPipeline(pRenderPipeline.Borrow());
+
+  return ezResourceManager::GetOrCreateResource<ezRenderPipelineResource>("HeadlessBenchmarkRenderPipeline", std::move(desc), "HeadlessBenchmarkRenderPipeline");
+}
+
+ezMaterialResourceHandle ezRendererTestHeadlessBenchmark::CreateMaterial(const char* szName, const char* szBlendMode, const ezColor& color)
+{
+  ezMaterialResourceDescriptor md;
+  md.m_hShader = ezResourceManager::LoadResource<ezShaderResource>("Shaders/Materials/DefaultMaterial.ezShader");
+
+  // the render data category is derived from the blend mode
+  auto& blendMode = md.m_PermutationVars.ExpandAndGetRef();
+  blendMode.m_sName.Assign("BLEND_MODE");
+  blendMode.m_sValue.Assign(szBlendMode);
+
+  auto& baseColor = md.m_Parameters.ExpandAndGetRef();
+  baseColor.m_Name.Assign("BaseColor");
+  baseColor.m_Value = color;
+
+  return ezResourceManager::GetOrCreateResource<ezMaterialResource>(szName, std::move(md), szName);
+}
+
+ezMeshResourceHandle ezRendererTestHeadlessBenchmark::CreateMeshResource(ezGeometry& ref_geom, const char* szName)
+{
+  ref_geom.ComputeTangents();
+
+  ezStringBuilder sMeshBufferName(szName, "_Buffer");
+
+  ezMeshBufferResourceDescriptor desc;
+  desc.AddCommonStreams();
+  desc.AllocateStreamsFromGeometry(ref_geom, ezGALPrimitiveTopology::Triangles);
+
+  ezMeshBufferResourceHandle hMeshBuffer = ezResourceManager::GetOrCreateResource<ezMeshBufferResource>(sMeshBufferName, std::move(desc), sMeshBufferName);
+
+  ezResourceLock<ezMeshBufferResource> pMeshBuffer(hMeshBuffer, ezResourceAcquireMode::BlockTillLoaded);
+
+  // the material is set on the components
+  ezMeshResourceDescriptor md;
+  md.UseExistingMeshBuffer(hMeshBuffer);
+  md.AddSubMesh(pMeshBuffer->GetPrimitiveCount(), 0, 0);
+  md.SetMaterial(0, "");
+  md.ComputeBounds();
+
+  return ezResourceManager::GetOrCreateResource<ezMeshResource>(szName, std::move(md), szName);
+}
+
+void ezRendererTestHeadlessBenchmark::CreateMeshObject(const ezVec3& vPosition, const ezMeshResourceHandle& hMesh, const ezMaterialResourceHandle& hMaterial)
+{
+  ezGameObjectDesc gd;
+  gd.m_LocalPosition = vPosition;
+
+  ezGameObject* pObject = nullptr;
+  m_pWorld->CreateObject(gd, pObject);
+
+  ezMeshComponent* pMeshComponent = nullptr;
+  ezMeshComponent::CreateComponent(pObject, pMeshComponent);
+  pMeshComponent->SetMesh(hMesh);
+  pMeshComponent->SetMaterial(0, hMaterial);
+}
+
+void ezRendererTestHeadlessBenchmark::RenderFrame(ezTime& out_extractionTime, ezTime& out_frameTime)
+{
+  // the same order as ezGameApplication without multi-threaded rendering
+  ezStopwatch sw;
+
+  {
+    EZ_LOCK(m_pWorld->GetWriteMarker());
+    m_pWorld->Update();
+  }
+
+  ezRenderWorld::ExtractMainViews();
+
+  out_extractionTime = sw.GetRunningTotal();
+
+  ezRenderWorld::BeginFrame();
+  ezRenderWorld::Render(ezRenderContext::GetDefaultInstance());
+  ezRenderWorld::EndFrame();
+
+  ezTaskSystem::FinishFrameTasks();
+
+  out_frameTime = sw.GetRunningTotal();
+}
+
+void ezRendererTestHeadlessBenchmark::OutputStatistics()
+{
+  const ezGALCommandStatisticsNull& stats = static_cast<ezGALDeviceNull*>(m_pDevice)->GetStatistics();
+
+  // the objects are instanced, so there are far fewer draw calls than objects, but every pass has to draw something
+  EZ_TEST_BOOL(GetSectionDrawCalls(stats, "DepthPrePass") > 0);
+  EZ_TEST_BOOL(GetSectionDrawCalls(stats, s_szOpaquePassName) > 0);
+  EZ_TEST_BOOL(GetSectionDrawCalls(stats, "Transparent") > 0);
+
+  const double fFrames = s_uiNumMeasuredFrames;
+  const double fDrawCallsPerFrame = stats.m_uiDrawCalls / fFrames;
+
+  ezTestFramework::Output(ezTestOutput::Duration, "%u frames, %u objects, %u meshes: %.3fms per frame (%.3fms update and extraction), %.0f draw calls per frame, %.3fus per draw call", s_uiNumMeasuredFrames, s_uiNumObjects, m_Meshes.GetCount(), m_TotalFrameTime.GetMilliseconds() / fFrames, m_TotalExtractionTime.GetMilliseconds() / fFrames, fDrawCallsPerFrame, m_TotalFrameTime.GetMicroseconds() / ezMath::Max<double>(stats.m_uiDrawCalls, 1));
+
+  for (const ezGALCommandStatisticsNull::Section& section : stats.m_Sections)
+  {
+    ezTestFramework::Output(ezTestOutput::Duration, "  %s: %.3fms per frame, %.0f draw calls per frame, %.3fus per draw call", section.m_sName.GetData(), section.m_CPUTime.GetMilliseconds() / fFrames, section.m_uiDrawCalls / fFrames, section.m_CPUTime.GetMicroseconds() / ezMath::Max<double>(section.m_uiDrawCalls, 1));
+  }
+
+  ezTestFramework::Output(ezTestOutput::Message, "Per frame: %.0f shader changes, %.0f state changes, %.0f resource bindings, %.0f buffer bindings, %.0f buffer updates (%.1fKB)", stats.m_uiShaderChanges / fFrames, stats.m_uiStateChanges / fFrames, stats.m_uiResourceBindings / fFrames, stats.m_uiBufferBindings / fFrames, stats.m_uiBufferUpdates / fFrames, stats.m_uiBufferUpdateBytes / fFrames / 1024.0);
+}
+
+void ezRendererTestHeadlessBenchmark::RunAutoInstancingBenchmark()
+{
+  ezCVarBool* pAutoInstancing = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("Rendering.AutoInstancing"));
+  if (!EZ_TEST_BOOL(pAutoInstancing != nullptr))
+    return;
+
+  const bool bWasEnabled = *pAutoInstancing;
+
+  ezGALDeviceNull* pNullDevice = static_cast<ezGALDeviceNull*>(m_pDevice);
+
+  auto Measure = [&](bool bAutoInstancing, ezUInt32& out_uiDrawCalls) -> ezTime
+  {
+    *pAutoInstancing = bAutoInstancing;
+
+    ezTime totalExtractionTime = ezTime::MakeZero();
+    for (ezUInt32 uiFrame = 0; uiFrame < s_uiNumWarmupFrames + s_uiNumMeasuredFrames; ++uiFrame)
+    {
+      if (uiFrame == s_uiNumWarmupFrames)
+      {
+        pNullDevice->ResetStatistics();
+      }
+
+      ezTime extractionTime;
+      ezTime frameTime;
+      RenderFrame(extractionTime, frameTime);
+
+      if (uiFrame >= s_uiNumWarmupFrames)
+      {
+        totalExtractionTime += extractionTime;
+      }
+    }
+
+    // every batch of the opaque pass is one instanced mesh draw call, unless it is larger than the instance buffer
+    out_uiDrawCalls = GetSectionDrawCalls(pNullDevice->GetStatistics(), s_szOpaquePassName) / s_uiNumMeasuredFrames;
+    return totalExtractionTime / (double)s_uiNumMeasuredFrames;
+  };
+
+  ezUInt32 uiNumDrawCalls = 0;
+  ezUInt32 uiNumInstancedDrawCalls = 0;
+  const ezTime time = Measure(false, uiNumDrawCalls);
+  const ezTime instancedTime = Measure(true, uiNumInstancedDrawCalls);
+
+  *pAutoInstancing = bWasEnabled;
+
+  // the props use one material per mesh, so there can't be fewer draw calls than meshes
+  EZ_TEST_BOOL(uiNumInstancedDrawCalls >= s_uiNumPropMeshes);
+  EZ_TEST_BOOL(uiNumInstancedDrawCalls <= uiNumDrawCalls);
+
+  ezTestFramework::Output(ezTestOutput::Duration, "%u props, %u meshes, %u materials: %u opaque draw calls without and %u with automatic instancing (%.1f%% fewer), update and extraction %.3fms and %.3fms", s_uiNumProps, s_uiNumPropMeshes, s_uiNumPropMaterials, uiNumDrawCalls, uiNumInstancedDrawCalls, 100.0 * (uiNumDrawCalls - uiNumInstancedDrawCalls) / ezMath::Max(uiNumDrawCalls, 1u), time.GetMilliseconds(), instancedTime.GetMilliseconds());
+}
+
+static ezRendererTestHeadlessBenchmark g_HeadlessBenchmarkTest;
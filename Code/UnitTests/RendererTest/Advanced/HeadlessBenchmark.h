@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../TestClass/TestClass.h"
+#include <Core/Graphics/Camera.h>
+#include <Core/World/World.h>
+#include <RendererCore/Material/MaterialResource.h>
+#include <RendererCore/Pipeline/RenderPipelineResource.h>
+
+/// \brief Measures the CPU cost of rendering on the null device, without a window or GPU.
+///
+/// Every frame updates a world with many mesh components and renders it through an ezView with a render pipeline that has a depth
+/// pre-pass, an opaque and a transparent forward pass. So the measured time contains the extraction, SortAndBatch and the mesh renderer,
+/// just like in a game. The null device records how many commands were issued and how much CPU time every pass took, which is reported
+/// per pass and per draw call once all frames are done.
+///
+/// The AutoInstancing sub-test renders many repeated props and compares how many instanced mesh draw calls the opaque pass issues with
+/// and without automatic instancing. The sorting keys and batch ids of the props come from ezMeshComponentBase, so the reported
+/// reduction is the one real scenes get.
+class ezRendererTestHeadlessBenchmark : public ezGraphicsTest
+{
+  using SUPER = ezGraphicsTest;
+
+public:
+  virtual const char* GetTestName() const override { return "HeadlessBenchmark"; }
+
+private:
+  enum SubTests
+  {
+    ST_ManyObjects,
+    ST_ManyMeshes,
+    ST_AutoInstancing,
+  };
+
+  virtual void SetupSubTests() override;
+
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override;
+
+  ezRenderPipelineResourceHandle CreateRenderPipeline();
+  ezMaterialResourceHandle CreateMaterial(const char* szName, const char* szBlendMode, const ezColor& color);
+  ezMeshResourceHandle CreateMeshResource(ezGeometry& ref_geom, const char* szName);
+  void CreateMeshObject(const ezVec3& vPosition, const ezMeshResourceHandle& hMesh, const ezMaterialResourceHandle& hMaterial);
+
+  void RenderFrame(ezTime& out_extractionTime, ezTime& out_frameTime);
+  void OutputStatistics();
+  void RunAutoInstancingBenchmark();
+
+  ezGALTextureHandle m_hColorTarget;
+  ezGALTextureHandle m_hDepthTarget;
+
+  ezUniquePtr<ezWorld> m_pWorld;
+  ezCamera m_Camera;
+  ezViewHandle m_hView;
+
+  ezDynamicArray<ezMeshResourceHandle> m_Meshes;
+  ezDynamicArray<ezMaterialResourceHandle> m_Materials;
+
+  ezTime m_TotalExtractionTime;
+  ezTime m_TotalFrameTime;
+};
@@ -0,0 +1,110 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/Graphics/Camera.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/SimdMath/SimdBBox.h>
+#include <RendererCore/Rasterizer/RasterizerObject.h>
+#include <RendererCore/Rasterizer/RasterizerView.h>
+
+namespace
+{
+  /// Adds a grid of boxes at different depths with gaps in between, so that the depth buffer has plenty of edges.
+  void AddOccluders(ezRasterizerView& ref_view)
+  {
+    ezSharedPtr<const ezRasterizerObject> pBox = ezRasterizerObject::CreateBox(ezVec3(1.0f, 2.0f, 2.0f));
+
+    for (ezInt32 y = -2; y <= 2; ++y)
+    {
+      for (ezInt32 z = -2; z <= 2; ++z)
+      {
+        const float fDepth = static_cast<float>((y + z + 4) % 3);
+        ref_view.AddObject(pBox.Borrow(), ezTransform(ezVec3(fDepth, y * 3.0f, z * 3.0f)));
+      }
+    }
+  }
+
+  void RasterizeScene(ezRasterizerView& ref_view, bool bMultithreaded, ezDynamicArray<ezColorLinearUB>& out_depth)
+  {
+    ezCVarBool* pMultithreaded = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("Spatial.Occlusion.Multithreaded"));
+    const bool bPrevMultithreaded = *pMultithreaded;
+    *pMultithreaded = bMultithreaded;
+
+    ref_view.BeginScene();
+    AddOccluders(ref_view);
+    ref_view.EndScene();
+
+    *pMultithreaded = bPrevMultithreaded;
+
+    out_depth.SetCount(ref_view.GetResolutionX() * ref_view.GetResolutionY());
+    ref_view.ReadBackFrame(out_depth);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Pipeline, OcclusionRasterizer)
+{
+  if (!EZ_TEST_BOOL(ezCVar::FindCVarByName("Spatial.Occlusion.Multithreaded") != nullptr))
+    return;
+
+  ezCamera camera;
+  camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, 90.0f, 0.1f, 100.0f);
+  camera.LookAt(ezVec3(-10, 0, 0), ezVec3::MakeZero(), ezVec3(0, 0, 1));
+
+  ezRasterizerView view;
+  view.SetResolution(256, 192, 0.0f);
+  view.SetCamera(&camera);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Banded vs Serial")
+  {
+    ezDynamicArray<ezColorLinearUB> serialDepth;
+    RasterizeScene(view, false, serialDepth);
+
+    ezDynamicArray<ezColorLinearUB> bandedDepth;
+    RasterizeScene(view, true, bandedDepth);
+
+    // every band only rasterizes the occluders that overlap it, the result has to be the same as rasterizing the whole screen at once
+    EZ_TEST_BOOL(serialDepth == bandedDepth);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Batched Queries")
+  {
+    ezDynamicArray<ezColorLinearUB> depth;
+    RasterizeScene(view, true, depth);
+
+    // boxes in front of, between and behind the occluders, some of them straddle the gaps
+    ezDynamicArray<ezSimdBBox> boxes;
+    for (float x : {-4.0f, 1.5f, 6.0f})
+    {
+      for (ezInt32 y = -4; y <= 4; ++y)
+      {
+        for (ezInt32 z = -4; z <= 4; ++z)
+        {
+          const float fSize = 0.25f + 0.25f * ((y + z + 8) % 4);
+          boxes.PushBack(ezSimdBBox::MakeFromCenterAndHalfExtents(ezSimdVec4f(x, y * 1.5f, z * 1.5f), ezSimdVec4f(fSize)));
+        }
+      }
+    }
+
+    ezUInt32 uiNumOccluded = 0;
+
+    for (ezUInt32 uiFirstBox = 0; uiFirstBox < boxes.GetCount(); uiFirstBox += 32)
+    {
+      const ezUInt32 uiNumBoxes = ezMath::Min(boxes.GetCount() - uiFirstBox, 32u);
+      const ezUInt32 uiOccludedMask = view.ComputeOccludedMask(boxes.GetArrayPtr().GetSubArray(uiFirstBox, uiNumBoxes));
+
+      for (ezUInt32 i = 0; i < uiNumBoxes; ++i)
+      {
+        const bool bOccluded = (uiOccludedMask & EZ_BIT(i)) != 0;
+        EZ_TEST_BOOL(bOccluded == !view.IsVisible(boxes[uiFirstBox + i]));
+
+        uiNumOccluded += bOccluded ? 1 : 0;
+      }
+    }
+
+    if (view.HasRasterizedAnyOccluders())
+    {
+      // the boxes in front of the occluders are always visible, many of the ones behind them are hidden
+      EZ_TEST_BOOL(uiNumOccluded > 0);
+      EZ_TEST_BOOL(uiNumOccluded < boxes.GetCount() * 2 / 3);
+    }
+  }
+}
@@ -0,0 +1,160 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Pipeline);
+
+namespace
+{
+  void CollectSortingKeys(const ezExtractedRenderData& extractedRenderData, ezRenderData::Category category, ezDynamicArray<ezUInt32>& out_sortingKeys)
+  {
+    out_sortingKeys.Clear();
+
+    ezRenderDataBatchList batchList = extractedRenderData.GetRenderDataBatchesWithCategory(category);
+    for (ezUInt32 uiBatch = 0; uiBatch < batchList.GetBatchCount(); ++uiBatch)
+    {
+      const ezRenderDataBatch batch = batchList.GetBatch(uiBatch);
+      for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid(); ++it)
+      {
+        out_sortingKeys.PushBack(it->m_uiSortingKey);
+      }
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Pipeline, StaticRenderDataList)
+{
+  const ezRenderData::Category category = ezDefaultRenderDataCategories::SimpleOpaque;
+
+  ezCamera camera;
+  camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, 90.0f, 0.1f, 100.0f);
+  camera.LookAt(ezVec3(-10, 0, 0), ezVec3::MakeZero(), ezVec3(0, 0, 1));
+
+  // The sorting key dominates the category sorting, every render data gets its own batch.
+  ezRenderData renderData[8];
+  for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(renderData); ++i)
+  {
+    renderData[i].m_uiSortingKey = i;
+    renderData[i].m_uiBatchId = i + 1;
+  }
+
+  const ezGameObjectHandle hOwnerA(ezGameObjectId(1, 1));
+  const ezGameObjectHandle hOwnerB(ezGameObjectId(2, 1));
+  const ezGameObjectHandle hOwnerC(ezGameObjectId(3, 1));
+
+  ezStaticRenderDataList staticList;
+  ezDynamicArray<ezGameObjectHandle> deletedOwners;
+  staticList.RemoveDeletedCachedRenderData(deletedOwners);
+
+  ezExtractedRenderData extractedRenderData;
+  ezDynamicArray<ezUInt32> sortingKeys;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Add")
+  {
+    staticList.AddRenderData(hOwnerA, &renderData[5], category);
+    staticList.AddRenderData(hOwnerB, &renderData[3], category);
+    staticList.AddRenderData(hOwnerA, &renderData[1], category);
+    EZ_TEST_INT(staticList.GetCount(), 0);
+
+    staticList.Update(camera);
+    EZ_TEST_INT(staticList.GetCount(), 3);
+
+    // data added to an already sorted list is merged into it
+    staticList.AddRenderData(hOwnerC, &renderData[6], category);
+    staticList.Update(camera);
+    EZ_TEST_INT(staticList.GetCount(), 4);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Merge with dynamic data")
+  {
+    extractedRenderData.Clear();
+    extractedRenderData.SetCamera(camera);
+    extractedRenderData.AddRenderData(&renderData[4], category);
+    extractedRenderData.AddRenderData(&renderData[2], category);
+    extractedRenderData.SetStaticRenderData(&staticList);
+    extractedRenderData.SortAndBatch();
+
+    CollectSortingKeys(extractedRenderData, category, sortingKeys);
+
+    const ezUInt32 expected[] = {1, 2, 3, 4, 5, 6};
+    if (EZ_TEST_INT(sortingKeys.GetCount(), EZ_ARRAY_SIZE(expected)))
+    {
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(expected); ++i)
+      {
+        EZ_TEST_INT(sortingKeys[i], expected[i]);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove")
+  {
+    // removals only apply to data that was added before, the new data of the same owner is kept
+    staticList.RemoveRenderData(hOwnerA);
+    staticList.AddRenderData(hOwnerA, &renderData[0], category);
+    staticList.Update(camera);
+    EZ_TEST_INT(staticList.GetCount(), 3);
+
+    extractedRenderData.Clear();
+    extractedRenderData.SetCamera(camera);
+    extractedRenderData.AddRenderData(&renderData[7], category);
+    extractedRenderData.SetStaticRenderData(&staticList);
+    extractedRenderData.SortAndBatch();
+
+    CollectSortingKeys(extractedRenderData, category, sortingKeys);
+
+    const ezUInt32 expected[] = {0, 3, 6, 7};
+    if (EZ_TEST_INT(sortingKeys.GetCount(), EZ_ARRAY_SIZE(expected)))
+    {
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(expected); ++i)
+      {
+        EZ_TEST_INT(sortingKeys[i], expected[i]);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Camera change")
+  {
+    // a different camera recomputes all sorting keys and sorts again, the order only depends on the sorting key here
+    ezCamera otherCamera = camera;
+    otherCamera.LookAt(ezVec3(10, 5, 0), ezVec3::MakeZero(), ezVec3(0, 0, 1));
+
+    staticList.Update(otherCamera);
+    EZ_TEST_INT(staticList.GetCount(), 3);
+
+    extractedRenderData.Clear();
+    extractedRenderData.SetCamera(otherCamera);
+    extractedRenderData.SetStaticRenderData(&staticList);
+    extractedRenderData.SortAndBatch();
+
+    CollectSortingKeys(extractedRenderData, category, sortingKeys);
+
+    const ezUInt32 expected[] = {0, 3, 6};
+    if (EZ_TEST_INT(sortingKeys.GetCount(), EZ_ARRAY_SIZE(expected)))
+    {
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(expected); ++i)
+      {
+        EZ_TEST_INT(sortingKeys[i], expected[i]);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Deleted cached render data")
+  {
+    EZ_TEST_BOOL(staticList.RemoveDeletedCachedRenderData(deletedOwners));
+    EZ_TEST_BOOL(deletedOwners.IsEmpty());
+    EZ_TEST_INT(staticList.GetCount(), 3);
+
+    // the list points to cached render data, after all cached data was deleted the individual owners aren't known and the whole list is cleared
+    ezRenderWorld::DeleteAllCachedRenderData();
+
+    EZ_TEST_BOOL(!staticList.RemoveDeletedCachedRenderData(deletedOwners));
+    EZ_TEST_BOOL(deletedOwners.IsEmpty());
+    EZ_TEST_INT(staticList.GetCount(), 0);
+    EZ_TEST_BOOL(staticList.RemoveDeletedCachedRenderData(deletedOwners));
+
+    staticList.AddRenderData(hOwnerB, &renderData[3], category);
+    staticList.Update(camera);
+    EZ_TEST_INT(staticList.GetCount(), 1);
+  }
+}
@@ -61,7 +61,7 @@ ezSizeU32 ezGraphicsTest::GetResolution() const
 }
 
 
-ezResult ezGraphicsTest::CreateRenderer(ezGALDevice*& out_pDevice)
+ezResult ezGraphicsTest::CreateRenderer(ezGALDevice*& out_pDevice, ezStringView sRendererName)
 {
   {
     ezFileSystem::SetSpecialDirectory("testout", ezTestFramework::GetInstance()->GetAbsOutputPath());
@@ -88,7 +88,11 @@ ezResult ezGraphicsTest::CreateRenderer(ezGALDevice*& out_pDevice)
   constexpr const char* szDefaultRenderer = "DX11";
 #endif
 
-  ezStringView sRendererName = ezCommandLineUtils::GetGlobalInstance()->GetStringOption("-renderer", 0, szDefaultRenderer);
+  if (sRendererName.IsEmpty())
+  {
+    sRendererName = ezCommandLineUtils::GetGlobalInstance()->GetStringOption("-renderer", 0, szDefaultRenderer);
+  }
+
   const char* szShaderModel = "";
   const char* szShaderCompiler = "";
   ezGALDeviceFactory::GetShaderModelAndCompiler(sRendererName, szShaderModel, szShaderCompiler);
@@ -150,9 +154,9 @@ ezResult ezGraphicsTest::CreateRenderer(ezGALDevice*& out_pDevice)
   return EZ_SUCCESS;
 }
 
-ezResult ezGraphicsTest::SetupRenderer()
+ezResult ezGraphicsTest::SetupRenderer(ezStringView sRendererName)
 {
-  EZ_SUCCEED_OR_RETURN(ezGraphicsTest::CreateRenderer(m_pDevice));
+  EZ_SUCCEED_OR_RETURN(ezGraphicsTest::CreateRenderer(m_pDevice, sRendererName));
 
   m_hObjectTransformCB = ezRenderContext::CreateConstantBufferStorage<ObjectCB>();
   m_hShader = ezResourceManager::LoadResource<ezShaderResource>("RendererTest/Shaders/Default.ezShader");
@@ -22,7 +22,8 @@ struct ObjectCB
 class ezGraphicsTest : public ezTestBaseClass
 {
 public:
-  static ezResult CreateRenderer(ezGALDevice*& out_pDevice);
+  /// \brief Creates the device given by \a sRendererName, or by the '-renderer' command line option if no name is given.
+  static ezResult CreateRenderer(ezGALDevice*& out_pDevice, ezStringView sRendererName = {});
   static void SetClipSpace();
 
 public:
@@ -42,7 +43,7 @@ protected:
   ezSizeU32 GetResolution() const;
 
 protected:
-  ezResult SetupRenderer();
+  ezResult SetupRenderer(ezStringView sRendererName = {});
   void ShutdownRenderer();
 
   ezResult CreateWindow(ezUInt32 uiResolutionX = 960, ezUInt32 uiResolutionY = 540);
@@ -3,6 +3,7 @@
 ..\Output\Bin\WinVs2022Debug64\ezStaticLinkUtil.exe ..\Code\Engine\GameEngine
 ..\Output\Bin\WinVs2022Debug64\ezStaticLinkUtil.exe ..\Code\Engine\RendererCore
 ..\Output\Bin\WinVs2022Debug64\ezStaticLinkUtil.exe ..\Code\Engine\RendererFoundation
+..\Output\Bin\WinVs2022Debug64\ezStaticLinkUtil.exe ..\Code\Engine\RendererNull
 ..\Output\Bin\WinVs2022Debug64\ezStaticLinkUtil.exe ..\Code\Engine\RendererVulkan
 ..\Output\Bin\WinVs2022Debug64\ezStaticLinkUtil.exe ..\Code\Engine\RendererDX11
 ..\Output\Bin\WinVs2022Debug64\ezStaticLinkUtil.exe ..\Code\Engine\Texture